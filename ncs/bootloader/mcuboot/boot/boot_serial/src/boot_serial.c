@@ -55,7 +55,8 @@
 #include "boot_serial/boot_serial.h"
 #include "boot_serial_priv.h"
 
-#ifdef CONFIG_BOOT_ERASE_PROGRESSIVELY
+#if defined(CONFIG_BOOT_ERASE_PROGRESSIVELY) || \
+    defined(MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE)
 #include "bootutil_priv.h"
 #endif
 
@@ -300,6 +301,9 @@ bs_upload(char *buf, int len)
         if (data_len > fap->fa_size) {
             goto out_invalid_data;
         }
+#ifdef MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE
+        (void)boot_revoke_validated(fap);
+#endif
 #ifndef CONFIG_BOOT_ERASE_PROGRESSIVELY
         rc = flash_area_erase(fap, 0, fap->fa_size);
         if (rc) {
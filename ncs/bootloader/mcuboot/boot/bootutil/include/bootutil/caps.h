@@ -46,6 +46,8 @@ uint32_t bootutil_get_caps(void);
 #define BOOTUTIL_CAP_SWAP_USING_MOVE        (1<<11)
 #define BOOTUTIL_CAP_DOWNGRADE_PREVENTION   (1<<12)
 #define BOOTUTIL_CAP_ENC_X25519             (1<<13)
+#define BOOTUTIL_CAP_VALIDATE_PRIMARY_SLOT_ONCE (1<<14)
+#define BOOTUTIL_CAP_PIPELINED_READ         (1<<15)
 
 /*
  * Query the number of images this bootloader is configured for.  This
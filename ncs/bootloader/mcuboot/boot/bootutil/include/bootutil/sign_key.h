@@ -61,6 +61,20 @@ int boot_retrieve_public_key_hash(uint8_t image_index,
 
 extern const int bootutil_key_cnt;
 
+/**
+ * Retrieve the device-unique secret the validated-image record of the
+ * primary slot is authenticated with, only used with
+ * MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE.  It must not be readable by anything
+ * but the boot loader.
+ *
+ * @param[out]     key              Buffer to store the key in.
+ * @param[in,out]  key_len          As input the size of the buffer (64
+ *                                  bytes). As output the actual key length.
+ *
+ * @return                          0 on success; nonzero on failure.
+ */
+int boot_retrieve_validated_key(uint8_t *key, size_t *key_len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -170,6 +170,10 @@ boot_trailer_sz(uint32_t min_write_sz)
 #  else
            BOOT_ENC_KEY_SIZE * 2                  +
 #  endif
+#endif
+#ifdef MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE
+           /* validated-image record */
+           BOOT_VALIDATED_SZ                      +
 #endif
            /* swap_type + copy_done + image_ok + swap_size */
            BOOT_MAX_ALIGN * 4                     +
@@ -248,6 +252,18 @@ boot_enc_key_off(const struct flash_area *fap, uint8_t slot)
 }
 #endif
 
+#ifdef MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE
+static inline uint32_t
+boot_validated_off(const struct flash_area *fap)
+{
+#ifdef MCUBOOT_ENC_IMAGES
+    return boot_enc_key_off(fap, BOOT_NUM_SLOTS - 1) - BOOT_VALIDATED_SZ;
+#else
+    return boot_swap_size_off(fap) - BOOT_VALIDATED_SZ;
+#endif
+}
+#endif
+
 int
 boot_read_swap_state(const struct flash_area *fap,
                      struct boot_swap_state *state)
@@ -580,6 +596,146 @@ boot_write_enc_key(const struct flash_area *fap, uint8_t slot,
 }
 #endif
 
+#ifdef MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE
+/**
+ * Reads the validated-image record of a slot.
+ *
+ * @returns 0 if a committed record was read, nonzero if there is none, it
+ *          was revoked or it can't be read.
+ */
+int
+boot_read_validated(const struct flash_area *fap, uint8_t *hash,
+                    uint8_t *mac)
+{
+    uint8_t revoke[BOOT_MAX_ALIGN];
+    uint32_t off;
+    uint32_t commit;
+    int rc;
+
+    off = boot_validated_off(fap);
+    rc = flash_area_read(fap, off + BOOT_VALIDATED_HASH_SZ * 2, &commit,
+                         sizeof commit);
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+    if (commit != BOOT_VALIDATED_COMMIT) {
+        return 1;
+    }
+
+    /* Anything but an erased revoke word, even a partly written one,
+     * revokes the record.
+     */
+    rc = flash_area_read_is_empty(fap,
+            off + BOOT_VALIDATED_HASH_SZ * 2 + BOOT_MAX_ALIGN, revoke,
+            sizeof revoke);
+    if (rc < 0) {
+        return BOOT_EFLASH;
+    }
+    if (rc == 0) {
+        return 1;
+    }
+
+    rc = flash_area_read(fap, off, hash, BOOT_VALIDATED_HASH_SZ);
+    if (rc == 0) {
+        rc = flash_area_read(fap, off + BOOT_VALIDATED_HASH_SZ, mac,
+                             BOOT_VALIDATED_HASH_SZ);
+    }
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
+    return 0;
+}
+
+/**
+ * Writes the validated-image record of a slot.  The record is only written
+ * to an erased area, the commit word last, so that an interrupted write never
+ * leaves a record behind.
+ *
+ * @returns 0 on success, 1 if the record area is not erased, or BOOT_EFLASH
+ *          on error.
+ */
+int
+boot_write_validated(const struct flash_area *fap, const uint8_t *hash,
+                     const uint8_t *mac)
+{
+    uint8_t buf[BOOT_VALIDATED_SZ];
+    uint32_t commit;
+    uint32_t off;
+    int rc;
+
+    off = boot_validated_off(fap);
+    rc = flash_area_read_is_empty(fap, off, buf, sizeof buf);
+    if (rc < 0) {
+        return BOOT_EFLASH;
+    }
+    if (rc == 0) {
+        return 1;
+    }
+
+    BOOT_LOG_DBG("writing validated-image record; fa_id=%d off=0x%lx (0x%lx)",
+                 fap->fa_id, (unsigned long)off,
+                 (unsigned long)(fap->fa_off + off));
+    rc = flash_area_write(fap, off, hash, BOOT_VALIDATED_HASH_SZ);
+    if (rc == 0) {
+        rc = flash_area_write(fap, off + BOOT_VALIDATED_HASH_SZ, mac,
+                              BOOT_VALIDATED_HASH_SZ);
+    }
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
+    commit = BOOT_VALIDATED_COMMIT;
+    return boot_write_trailer(fap, off + BOOT_VALIDATED_HASH_SZ * 2,
+                              (const uint8_t *)&commit, sizeof commit);
+}
+
+/**
+ * Revokes the validated-image record of a slot, if it has one.  Done before
+ * the boot loader writes to the slot, so that the record never vouches for
+ * an image that is only partly installed.
+ *
+ * @returns 0 on success, or BOOT_EFLASH on error.
+ */
+int
+boot_revoke_validated(const struct flash_area *fap)
+{
+    uint8_t buf[BOOT_MAX_ALIGN];
+    uint32_t commit;
+    uint32_t revoke;
+    uint32_t off;
+    int rc;
+
+    off = boot_validated_off(fap);
+    rc = flash_area_read(fap, off + BOOT_VALIDATED_HASH_SZ * 2, &commit,
+                         sizeof commit);
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+    if (commit != BOOT_VALIDATED_COMMIT) {
+        return 0;
+    }
+
+    rc = flash_area_read_is_empty(fap,
+            off + BOOT_VALIDATED_HASH_SZ * 2 + BOOT_MAX_ALIGN, buf,
+            sizeof buf);
+    if (rc < 0) {
+        return BOOT_EFLASH;
+    }
+    if (rc == 0) {
+        return 0;
+    }
+
+    BOOT_LOG_DBG("revoking validated-image record; fa_id=%d off=0x%lx (0x%lx)",
+                 fap->fa_id, (unsigned long)off,
+                 (unsigned long)(fap->fa_off + off));
+    revoke = BOOT_VALIDATED_REVOKE;
+    return boot_write_trailer(fap,
+            off + BOOT_VALIDATED_HASH_SZ * 2 + BOOT_MAX_ALIGN,
+            (const uint8_t *)&revoke, sizeof revoke);
+}
+#endif
+
 int
 boot_swap_type_multi(int image_index)
 {
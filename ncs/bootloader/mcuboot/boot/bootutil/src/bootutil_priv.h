@@ -61,7 +61,12 @@ struct flash_area;
 #define BOOT_EBADARGS    7
 #define BOOT_EBADVERSION 8
 
+#ifdef MCUBOOT_PIPELINED_READ
+/* Two halves: one being read into while the other is hashed. */
+#define BOOT_TMPBUF_SZ  512
+#else
 #define BOOT_TMPBUF_SZ  256
+#endif
 
 /** Number of image slots in flash; currently limited to two. */
 #define BOOT_NUM_SLOTS                  2
@@ -126,6 +131,16 @@ struct boot_status {
  *  ~    Swap status (BOOT_MAX_IMG_SECTORS * min-write-size * 3)    ~
  *  ~                                                               ~
  *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *  |             Validated image hash (32 octets) [**]             |
+ *  |                                                               |
+ *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *  |             Validated image MAC (32 octets) [**]              |
+ *  |                                                               |
+ *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *  |     Validated commit [**]     |    0xff padding (4 octets)    |
+ *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *  |     Validated revoke [**]     |    0xff padding (4 octets)    |
+ *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
  *  |                 Encryption key 0 (16 octets) [*]              |
  *  |                                                               |
  *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -146,6 +161,8 @@ struct boot_status {
  *
  * [*]: Only present if the encryption option is enabled
  *      (`MCUBOOT_ENC_IMAGES`).
+ * [**]: Only present if the validated-image record is enabled
+ *       (`MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE`).
  */
 
 extern const uint32_t boot_img_magic[4];
@@ -168,6 +185,23 @@ _Static_assert(BOOT_IMAGE_NUMBER > 0, "Invalid value for BOOT_IMAGE_NUMBER");
 
 #define BOOT_MAX_IMG_SECTORS       MCUBOOT_MAX_IMG_SECTORS
 
+#if defined(MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE) && \
+    !defined(MCUBOOT_VALIDATE_PRIMARY_SLOT)
+#error "MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE requires MCUBOOT_VALIDATE_PRIMARY_SLOT"
+#endif
+
+/*
+ * Validated-image record: the hash computed when the image was last fully
+ * validated, a MAC binding it to the slot contents and their write
+ * generation, a commit word written last, and a revoke word written before
+ * the boot loader changes the slot.
+ */
+#define BOOT_VALIDATED_HASH_SZ     32
+#define BOOT_VALIDATED_COMMIT      0x7d4b9e21
+#define BOOT_VALIDATED_REVOKE      0x0b52e6c4
+#define BOOT_VALIDATED_SZ          (BOOT_VALIDATED_HASH_SZ * 2 + \
+                                    BOOT_MAX_ALIGN * 2)
+
 /*
  * Extract the swap type and image number from image trailers's swap_info
  * filed.
@@ -292,6 +326,21 @@ int boot_write_enc_key(const struct flash_area *fap, uint8_t slot,
 int boot_read_enc_key(int image_index, uint8_t slot, struct boot_status *bs);
 #endif
 
+#ifdef MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE
+int boot_read_validated(const struct flash_area *fap, uint8_t *hash,
+                        uint8_t *mac);
+int boot_write_validated(const struct flash_area *fap, const uint8_t *hash,
+                         const uint8_t *mac);
+int boot_revoke_validated(const struct flash_area *fap);
+int bootutil_img_validated_check(int image_index, struct image_header *hdr,
+                                 const struct flash_area *fap,
+                                 uint8_t *tmp_buf, uint32_t tmp_buf_sz);
+int bootutil_img_validated_save(int image_index, struct image_header *hdr,
+                                const struct flash_area *fap,
+                                uint8_t *tmp_buf, uint32_t tmp_buf_sz,
+                                const uint8_t *hash);
+#endif
+
 /**
  * Safe (non-overflowing) uint32_t addition.  Returns true, and stores
  * the result in *dest if it can be done without overflow.  Otherwise,
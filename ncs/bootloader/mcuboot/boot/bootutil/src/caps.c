@@ -65,6 +65,12 @@ uint32_t bootutil_get_caps(void)
 #if defined(MCUBOOT_DOWNGRADE_PREVENTION)
     res |= BOOTUTIL_CAP_DOWNGRADE_PREVENTION;
 #endif
+#if defined(MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE)
+    res |= BOOTUTIL_CAP_VALIDATE_PRIMARY_SLOT_ONCE;
+#endif
+#if defined(MCUBOOT_PIPELINED_READ)
+    res |= BOOTUTIL_CAP_PIPELINED_READ;
+#endif
 
     return res;
 }
@@ -52,8 +52,44 @@
 
 #include "bootutil_priv.h"
 
+/*
+ * Size of the block of the image to hash at off, at most max bytes.  With
+ * encrypted images, a block never straddles the end of the header or of the
+ * payload, only the payload is to be decrypted.
+ */
+static uint32_t
+bootutil_img_hash_blk_sz(uint32_t off, uint32_t size, uint32_t max,
+                         uint32_t hdr_size, uint32_t tlv_off)
+{
+    uint32_t blk_sz;
+
+    blk_sz = size - off;
+    if (blk_sz > max) {
+        blk_sz = max;
+    }
+#ifdef MCUBOOT_ENC_IMAGES
+    if ((off < hdr_size) && ((off + blk_sz) > hdr_size)) {
+        /* read only the header */
+        blk_sz = hdr_size - off;
+    }
+    if ((off < tlv_off) && ((off + blk_sz) > tlv_off)) {
+        /* read only up to the end of the image payload */
+        blk_sz = tlv_off - off;
+    }
+#else
+    (void)hdr_size;
+    (void)tlv_off;
+#endif
+
+    return blk_sz;
+}
+
 /*
  * Compute SHA256 over the image.
+ *
+ * With MCUBOOT_PIPELINED_READ, tmp_buf is used as two buffers: the next
+ * block is read into one of them while the block in the other is decrypted
+ * and hashed.
  */
 static int
 bootutil_img_hash(struct enc_key_data *enc_state, int image_index,
@@ -69,6 +105,11 @@ bootutil_img_hash(struct enc_key_data *enc_state, int image_index,
     int rc;
     uint32_t blk_off;
     uint32_t tlv_off;
+    uint8_t *blk;
+#ifdef MCUBOOT_PIPELINED_READ
+    uint8_t *next;
+    uint32_t next_sz;
+#endif
 
 #if (BOOT_IMAGE_NUMBER == 1) || !defined(MCUBOOT_ENC_IMAGES)
     (void)enc_state;
@@ -102,39 +143,58 @@ bootutil_img_hash(struct enc_key_data *enc_state, int image_index,
     /* If protected TLVs are present they are also hashed. */
     size += hdr->ih_protect_tlv_size;
 
-    for (off = 0; off < size; off += blk_sz) {
-        blk_sz = size - off;
-        if (blk_sz > tmp_buf_sz) {
-            blk_sz = tmp_buf_sz;
+#ifdef MCUBOOT_PIPELINED_READ
+    tmp_buf_sz /= 2;
+    if (size > 0) {
+        rc = flash_area_read_start(fap, 0, tmp_buf,
+                bootutil_img_hash_blk_sz(0, size, tmp_buf_sz, hdr_size,
+                                         tlv_off));
+        if (rc) {
+            (void)flash_area_read_wait(fap);
+            return rc;
         }
-#ifdef MCUBOOT_ENC_IMAGES
-        /* The only data that is encrypted in an image is the payload;
-         * both header and TLVs (when protected) are not.
-         */
-        if ((off < hdr_size) && ((off + blk_sz) > hdr_size)) {
-            /* read only the header */
-            blk_sz = hdr_size - off;
+    }
+#endif
+
+    blk = tmp_buf;
+    for (off = 0; off < size; off += blk_sz) {
+        blk_sz = bootutil_img_hash_blk_sz(off, size, tmp_buf_sz, hdr_size,
+                                          tlv_off);
+#ifdef MCUBOOT_PIPELINED_READ
+        rc = flash_area_read_wait(fap);
+        if (rc) {
+            return rc;
         }
-        if ((off < tlv_off) && ((off + blk_sz) > tlv_off)) {
-            /* read only up to the end of the image payload */
-            blk_sz = tlv_off - off;
+        next = (blk == tmp_buf) ? tmp_buf + tmp_buf_sz : tmp_buf;
+        if (off + blk_sz < size) {
+            next_sz = bootutil_img_hash_blk_sz(off + blk_sz, size, tmp_buf_sz,
+                                               hdr_size, tlv_off);
+            rc = flash_area_read_start(fap, off + blk_sz, next, next_sz);
+            if (rc) {
+                (void)flash_area_read_wait(fap);
+                return rc;
+            }
         }
-#endif
-        rc = flash_area_read(fap, off, tmp_buf, blk_sz);
+#else
+        rc = flash_area_read(fap, off, blk, blk_sz);
         if (rc) {
             return rc;
         }
+#endif
 #ifdef MCUBOOT_ENC_IMAGES
         if (MUST_DECRYPT(fap, image_index, hdr)) {
             /* Only payload is encrypted (area between header and TLVs) */
             if (off >= hdr_size && off < tlv_off) {
                 blk_off = (off - hdr_size) & 0xf;
                 boot_encrypt(enc_state, image_index, fap, off - hdr_size,
-                        blk_sz, blk_off, tmp_buf);
+                        blk_sz, blk_off, blk);
             }
         }
 #endif
-        bootutil_sha256_update(&sha256_ctx, tmp_buf, blk_sz);
+        bootutil_sha256_update(&sha256_ctx, blk, blk_sz);
+#ifdef MCUBOOT_PIPELINED_READ
+        blk = next;
+#endif
     }
     bootutil_sha256_finish(&sha256_ctx, hash_result);
 
@@ -298,14 +358,13 @@ bootutil_get_img_security_cnt(struct image_header *hdr,
 #endif /* MCUBOOT_HW_ROLLBACK_PROT */
 
 /*
- * Verify the integrity of the image.
- * Return non-zero if image could not be validated/does not validate.
+ * Check the TLVs of an image against its hash: the SHA256 TLV, the
+ * signature and the security counter.
+ * Return non-zero if the TLVs do not vouch for the image.
  */
-int
-bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
-                      struct image_header *hdr, const struct flash_area *fap,
-                      uint8_t *tmp_buf, uint32_t tmp_buf_sz, uint8_t *seed,
-                      int seed_len, uint8_t *out_hash)
+static int
+bootutil_img_check_tlvs(int image_index, struct image_header *hdr,
+                        const struct flash_area *fap, uint8_t *hash)
 {
     uint32_t off;
     uint16_t len;
@@ -321,7 +380,6 @@ bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
 #endif /* EXPECTED_SIG_TLV */
     struct image_tlv_iter it;
     uint8_t buf[SIG_BUF_SIZE];
-    uint8_t hash[32];
     int rc;
 #ifdef MCUBOOT_HW_ROLLBACK_PROT
     uint32_t security_cnt = UINT32_MAX;
@@ -329,16 +387,6 @@ bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
     int32_t security_counter_valid = 0;
 #endif
 
-    rc = bootutil_img_hash(enc_state, image_index, hdr, fap, tmp_buf,
-            tmp_buf_sz, hash, seed, seed_len);
-    if (rc) {
-        return rc;
-    }
-
-    if (out_hash) {
-        memcpy(out_hash, hash, 32);
-    }
-
     rc = bootutil_tlv_iter_begin(&it, hdr, fap, IMAGE_TLV_ANY, false);
     if (rc) {
         return rc;
@@ -361,14 +409,14 @@ bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
              * Verify the SHA256 image hash.  This must always be
              * present.
              */
-            if (len != sizeof(hash)) {
+            if (len != 32) {
                 return -1;
             }
-            rc = flash_area_read(fap, off, buf, sizeof hash);
+            rc = flash_area_read(fap, off, buf, 32);
             if (rc) {
                 return rc;
             }
-            if (memcmp(hash, buf, sizeof(hash))) {
+            if (memcmp(hash, buf, 32)) {
                 return -1;
             }
 
@@ -422,7 +470,7 @@ bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
             if (rc) {
                 return -1;
             }
-            rc = bootutil_verify_sig(hash, sizeof(hash), buf, len, key_id);
+            rc = bootutil_verify_sig(hash, 32, buf, len, key_id);
             if (rc == 0) {
                 valid_signature = 1;
             }
@@ -477,3 +525,229 @@ bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
 
     return 0;
 }
+
+/*
+ * Verify the integrity of the image.
+ * Return non-zero if image could not be validated/does not validate.
+ */
+int
+bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
+                      struct image_header *hdr, const struct flash_area *fap,
+                      uint8_t *tmp_buf, uint32_t tmp_buf_sz, uint8_t *seed,
+                      int seed_len, uint8_t *out_hash)
+{
+    uint8_t hash[32];
+    int rc;
+
+    rc = bootutil_img_hash(enc_state, image_index, hdr, fap, tmp_buf,
+            tmp_buf_sz, hash, seed, seed_len);
+    if (rc) {
+        return rc;
+    }
+
+    if (out_hash) {
+        memcpy(out_hash, hash, 32);
+    }
+
+    return bootutil_img_check_tlvs(image_index, hdr, fap, hash);
+}
+
+#ifdef MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE
+#define BOOT_HMAC_BLOCK_SZ 64
+
+/*
+ * Start the inner (pad 0x36) or outer (pad 0x5c) hash of an HMAC-SHA256.
+ */
+static void
+bootutil_hmac_sha256_start(bootutil_sha256_context *ctx, const uint8_t *key,
+                           size_t key_len, uint8_t pad)
+{
+    uint8_t block[BOOT_HMAC_BLOCK_SZ];
+    size_t i;
+
+    for (i = 0; i < sizeof(block); i++) {
+        block[i] = (i < key_len ? key[i] : 0) ^ pad;
+    }
+    bootutil_sha256_init(ctx);
+    bootutil_sha256_update(ctx, block, sizeof(block));
+    memset(block, 0, sizeof(block));
+}
+
+/*
+ * Compute the MAC of the validated-image record of the image in a slot:
+ * HMAC-SHA256, keyed with the device-unique key, over the slot location, the
+ * image header, the whole TLV area, the image hash and the write generation
+ * of the flash holding the image.  Also return the contents of the image's
+ * SHA256 TLV.
+ */
+static int
+bootutil_img_validated_mac(struct image_header *hdr,
+                           const struct flash_area *fap, uint8_t *tmp_buf,
+                           uint32_t tmp_buf_sz, const uint8_t *hash,
+                           uint8_t *tlv_hash, uint8_t *mac)
+{
+    bootutil_sha256_context sha256_ctx;
+    struct image_tlv_iter it;
+    uint8_t key[BOOT_HMAC_BLOCK_SZ];
+    size_t key_len = sizeof(key);
+    uint32_t slot[3];
+    uint32_t gen;
+    uint32_t blk_sz;
+    uint32_t off;
+    uint16_t len;
+    int rc;
+
+    rc = bootutil_tlv_iter_begin(&it, hdr, fap, IMAGE_TLV_SHA256, false);
+    if (rc) {
+        return rc;
+    }
+
+    /* The record lives in the trailer, never trust it for an image that
+     * reaches into it.
+     */
+    if (it.tlv_end > boot_status_off(fap)) {
+        return -1;
+    }
+
+    /* Changes with any write to the image, whoever does it. */
+    rc = flash_area_get_write_gen(fap, 0, it.tlv_end, &gen);
+    if (rc) {
+        return rc;
+    }
+
+    rc = boot_retrieve_validated_key(key, &key_len);
+    if (rc || key_len > sizeof(key)) {
+        rc = -1;
+        goto out;
+    }
+
+    bootutil_hmac_sha256_start(&sha256_ctx, key, key_len, 0x36);
+
+    slot[0] = fap->fa_device_id;
+    slot[1] = fap->fa_off;
+    slot[2] = fap->fa_size;
+    bootutil_sha256_update(&sha256_ctx, slot, sizeof(slot));
+    bootutil_sha256_update(&sha256_ctx, hdr, sizeof(*hdr));
+
+    for (off = BOOT_TLV_OFF(hdr); off < it.tlv_end; off += blk_sz) {
+        blk_sz = it.tlv_end - off;
+        if (blk_sz > tmp_buf_sz) {
+            blk_sz = tmp_buf_sz;
+        }
+        rc = flash_area_read(fap, off, tmp_buf, blk_sz);
+        if (rc) {
+            goto out;
+        }
+        bootutil_sha256_update(&sha256_ctx, tmp_buf, blk_sz);
+    }
+
+    bootutil_sha256_update(&sha256_ctx, hash, BOOT_VALIDATED_HASH_SZ);
+    bootutil_sha256_update(&sha256_ctx, &gen, sizeof(gen));
+    bootutil_sha256_finish(&sha256_ctx, mac);
+
+    bootutil_hmac_sha256_start(&sha256_ctx, key, key_len, 0x5c);
+    bootutil_sha256_update(&sha256_ctx, mac, BOOT_VALIDATED_HASH_SZ);
+    bootutil_sha256_finish(&sha256_ctx, mac);
+
+    rc = bootutil_tlv_iter_next(&it, &off, &len, NULL);
+    if (rc || len != BOOT_VALIDATED_HASH_SZ) {
+        rc = -1;
+        goto out;
+    }
+
+    rc = flash_area_read(fap, off, tlv_hash, BOOT_VALIDATED_HASH_SZ);
+
+out:
+    memset(key, 0, sizeof(key));
+    return rc;
+}
+
+/*
+ * Compare two MACs in constant time.
+ */
+static int
+bootutil_mac_differs(const uint8_t *a, const uint8_t *b)
+{
+    uint8_t diff = 0;
+    int i;
+
+    for (i = 0; i < BOOT_VALIDATED_HASH_SZ; i++) {
+        diff |= a[i] ^ b[i];
+    }
+
+    return diff != 0;
+}
+
+/*
+ * Check the image in a slot against the slot's validated-image record.
+ * Return zero if the record and the image's TLVs vouch for the image, which
+ * then doesn't need to be hashed again, non-zero if it must be fully
+ * validated.
+ */
+int
+bootutil_img_validated_check(int image_index, struct image_header *hdr,
+                             const struct flash_area *fap,
+                             uint8_t *tmp_buf, uint32_t tmp_buf_sz)
+{
+    uint8_t tlv_hash[BOOT_VALIDATED_HASH_SZ];
+    uint8_t mac[BOOT_VALIDATED_HASH_SZ];
+    uint8_t rec_hash[BOOT_VALIDATED_HASH_SZ];
+    uint8_t rec_mac[BOOT_VALIDATED_HASH_SZ];
+    int rc;
+
+    rc = boot_read_validated(fap, rec_hash, rec_mac);
+    if (rc) {
+        return rc;
+    }
+
+    rc = bootutil_img_validated_mac(hdr, fap, tmp_buf, tmp_buf_sz, rec_hash,
+                                    tlv_hash, mac);
+    if (rc) {
+        return rc;
+    }
+
+    /* The hash computed at validation time must still be the one the image
+     * claims, and neither the header, the TLVs nor anything else in the
+     * image may have been written since.
+     */
+    if (memcmp(tlv_hash, rec_hash, sizeof(tlv_hash)) ||
+        bootutil_mac_differs(mac, rec_mac)) {
+        return -1;
+    }
+
+    /* Only the payload hashing is skipped, the signature still has to
+     * match the recorded hash and the security counter has to be accepted.
+     */
+    return bootutil_img_check_tlvs(image_index, hdr, fap, rec_hash);
+}
+
+/*
+ * Record that the image in a slot was fully validated, hash being the hash
+ * computed over it.  Only done once per image: the record is kept until the
+ * boot loader revokes it, before writing to the slot.
+ */
+int
+bootutil_img_validated_save(int image_index, struct image_header *hdr,
+                            const struct flash_area *fap,
+                            uint8_t *tmp_buf, uint32_t tmp_buf_sz,
+                            const uint8_t *hash)
+{
+    uint8_t tlv_hash[BOOT_VALIDATED_HASH_SZ];
+    uint8_t mac[BOOT_VALIDATED_HASH_SZ];
+    int rc;
+
+    (void)image_index;
+
+    rc = bootutil_img_validated_mac(hdr, fap, tmp_buf, tmp_buf_sz, hash,
+                                    tlv_hash, mac);
+    if (rc) {
+        return rc;
+    }
+
+    if (memcmp(hash, tlv_hash, sizeof(tlv_hash))) {
+        return -1;
+    }
+
+    return boot_write_validated(fap, hash, mac);
+}
+#endif /* MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE */
@@ -396,6 +396,9 @@ boot_image_check(struct boot_loader_state *state, struct image_header *hdr,
                  const struct flash_area *fap, struct boot_status *bs)
 {
     TARGET_STATIC uint8_t tmpbuf[BOOT_TMPBUF_SZ];
+#ifdef MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE
+    uint8_t hash[BOOT_VALIDATED_HASH_SZ];
+#endif
     uint8_t image_index;
     int rc;
 
@@ -408,6 +411,28 @@ boot_image_check(struct boot_loader_state *state, struct image_header *hdr,
 
     image_index = BOOT_CURR_IMG(state);
 
+#ifdef MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE
+    if (fap->fa_id == FLASH_AREA_IMAGE_PRIMARY(image_index)) {
+        if (bootutil_img_validated_check(image_index, hdr, fap, tmpbuf,
+                                         BOOT_TMPBUF_SZ) == 0) {
+            BOOT_LOG_DBG("Image %d validated on a previous boot", image_index);
+            return 0;
+        }
+
+        if (bootutil_img_validate(BOOT_CURR_ENC(state), image_index, hdr, fap,
+                                  tmpbuf, BOOT_TMPBUF_SZ, NULL, 0, hash)) {
+            return BOOT_EBADIMAGE;
+        }
+
+        /* Not being able to save the record only costs a full validation on
+         * the next boot.
+         */
+        (void)bootutil_img_validated_save(image_index, hdr, fap, tmpbuf,
+                                          BOOT_TMPBUF_SZ, hash);
+        return 0;
+    }
+#endif
+
 #ifdef MCUBOOT_ENC_IMAGES
     if (MUST_DECRYPT(fap, image_index, hdr)) {
         rc = boot_enc_load(BOOT_CURR_ENC(state), image_index, hdr, fap, bs);
@@ -764,6 +789,9 @@ boot_erase_region(const struct flash_area *fap, uint32_t off, uint32_t sz)
  * Copies the contents of one flash region to another.  You must erase the
  * destination region prior to calling this function.
  *
+ * With MCUBOOT_PIPELINED_READ, the next chunk is read into a second buffer
+ * while the current one is decrypted and written.
+ *
  * @param flash_area_id_src     The ID of the source flash area.
  * @param flash_area_id_dst     The ID of the destination flash area.
  * @param off_src               The offset within the source flash area to
@@ -783,6 +811,10 @@ boot_copy_region(struct boot_loader_state *state,
     uint32_t bytes_copied;
     int chunk_sz;
     int rc;
+    uint8_t *buf;
+#ifdef MCUBOOT_PIPELINED_READ
+    uint32_t next_sz;
+#endif
 #ifdef MCUBOOT_ENC_IMAGES
     uint32_t off;
     uint32_t tlv_off;
@@ -793,24 +825,61 @@ boot_copy_region(struct boot_loader_state *state,
     uint8_t image_index;
 #endif
 
-    TARGET_STATIC uint8_t buf[1024];
+#ifdef MCUBOOT_PIPELINED_READ
+    TARGET_STATIC uint8_t bufs[2][1024];
+#else
+    TARGET_STATIC uint8_t bufs[1][1024];
+#endif
 
 #if !defined(MCUBOOT_ENC_IMAGES)
     (void)state;
 #endif
 
+#ifdef MCUBOOT_PIPELINED_READ
+    if (sz > 0) {
+        chunk_sz = (sz > sizeof bufs[0]) ? sizeof bufs[0] : sz;
+        rc = flash_area_read_start(fap_src, off_src, bufs[0], chunk_sz);
+        if (rc != 0) {
+            (void)flash_area_read_wait(fap_src);
+            return BOOT_EFLASH;
+        }
+    }
+#endif
+
     bytes_copied = 0;
     while (bytes_copied < sz) {
-        if (sz - bytes_copied > sizeof buf) {
-            chunk_sz = sizeof buf;
+        if (sz - bytes_copied > sizeof bufs[0]) {
+            chunk_sz = sizeof bufs[0];
         } else {
             chunk_sz = sz - bytes_copied;
         }
 
+#ifdef MCUBOOT_PIPELINED_READ
+        /* Every chunk but the last is a full buffer, alternate them. */
+        buf = bufs[(bytes_copied / sizeof bufs[0]) & 1];
+        rc = flash_area_read_wait(fap_src);
+        if (rc != 0) {
+            return BOOT_EFLASH;
+        }
+        next_sz = sz - bytes_copied - chunk_sz;
+        if (next_sz > 0) {
+            if (next_sz > sizeof bufs[0]) {
+                next_sz = sizeof bufs[0];
+            }
+            rc = flash_area_read_start(fap_src, off_src + bytes_copied +
+                    chunk_sz, buf == bufs[0] ? bufs[1] : bufs[0], next_sz);
+            if (rc != 0) {
+                (void)flash_area_read_wait(fap_src);
+                return BOOT_EFLASH;
+            }
+        }
+#else
+        buf = bufs[0];
         rc = flash_area_read(fap_src, off_src + bytes_copied, buf, chunk_sz);
         if (rc != 0) {
             return BOOT_EFLASH;
         }
+#endif
 
 #ifdef MCUBOOT_ENC_IMAGES
         image_index = BOOT_CURR_IMG(state);
@@ -862,6 +931,12 @@ boot_copy_region(struct boot_loader_state *state,
 
         rc = flash_area_write(fap_dst, off_dst + bytes_copied, buf, chunk_sz);
         if (rc != 0) {
+#ifdef MCUBOOT_PIPELINED_READ
+            if (next_sz > 0) {
+                /* Don't leave a read in flight into bufs. */
+                (void)flash_area_read_wait(fap_src);
+            }
+#endif
             return BOOT_EFLASH;
         }
 
@@ -899,6 +974,11 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
     const struct flash_area *fap_primary_slot;
     const struct flash_area *fap_secondary_slot;
     uint8_t image_index;
+#if defined(MCUBOOT_OVERWRITE_ONLY_FAST) && \
+    defined(MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE)
+    uint32_t trailer_sz;
+    uint32_t off;
+#endif
 
     (void)bs;
 
@@ -936,6 +1016,27 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
 #endif
     }
 
+#if defined(MCUBOOT_OVERWRITE_ONLY_FAST) && \
+    defined(MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE)
+    /* The sectors past the new image were kept; erase the ones holding the
+     * trailer as well so no validated-image record of the old image is left.
+     */
+    trailer_sz = boot_trailer_sz(BOOT_WRITE_SZ(state));
+    for (sect = sect_count - 1; sect > 0; sect--) {
+        off = boot_img_sector_off(state, BOOT_PRIMARY_SLOT, sect);
+        if (off < size) {
+            break;
+        }
+        rc = boot_erase_region(fap_primary_slot, off,
+                               boot_img_sector_size(state, BOOT_PRIMARY_SLOT,
+                                                    sect));
+        assert(rc == 0);
+        if (fap_primary_slot->fa_size - off >= trailer_sz) {
+            break;
+        }
+    }
+#endif
+
 #ifdef MCUBOOT_ENC_IMAGES
     if (IS_ENCRYPTED(boot_img_hdr(state, BOOT_SECONDARY_SLOT))) {
         rc = boot_enc_load(BOOT_CURR_ENC(state), image_index,
@@ -1303,6 +1404,15 @@ boot_perform_update(struct boot_loader_state *state, struct boot_status *bs)
     uint8_t swap_type;
 #endif
 
+#ifdef MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE
+    /* Upgrades and reverts both rewrite the primary slot: drop its
+     * validated-image record first, an interrupted update may leave the
+     * trailer in place.  Failing to only leaves the write generation to
+     * invalidate the record.
+     */
+    (void)boot_revoke_validated(BOOT_IMG_AREA(state, BOOT_PRIMARY_SLOT));
+#endif
+
     /* At this point there are no aborted swaps. */
 #if defined(MCUBOOT_OVERWRITE_ONLY)
     rc = boot_copy_image(state, bs);
@@ -32,6 +32,9 @@
 #if MYNEWT_VAL(BOOTUTIL_VALIDATE_SLOT0)
 #define MCUBOOT_VALIDATE_PRIMARY_SLOT 1
 #endif
+#if MYNEWT_VAL(BOOTUTIL_VALIDATE_SLOT0_ONCE)
+#define MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE 1
+#endif
 #if MYNEWT_VAL(BOOTUTIL_USE_MBED_TLS)
 #define MCUBOOT_USE_MBED_TLS 1
 #endif
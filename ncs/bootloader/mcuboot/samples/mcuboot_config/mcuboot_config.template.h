@@ -71,6 +71,14 @@
  */
 #define MCUBOOT_VALIDATE_PRIMARY_SLOT
 
+/*
+ * Uncomment to only fully validate the image in the primary slot once, and
+ * then check it against a record kept in its trailer on later boots. The
+ * port must provide boot_retrieve_validated_key() and
+ * flash_area_get_write_gen(), see docs/PORTING.md.
+ */
+/* #define MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE */
+
 /*
  * Flash abstraction
  */
@@ -79,6 +87,12 @@
  * See the flash APIs for more details. */
 /* #define MCUBOOT_USE_FLASH_AREA_GET_SECTORS */
 
+/* Uncomment to read the next block of an image while the current one is
+ * hashed or decrypted.  Your flash map API must then also provide
+ * flash_area_read_start() and flash_area_read_wait(), see docs/PORTING.md.
+ * Costs an extra 1280 bytes of RAM for the second buffers. */
+/* #define MCUBOOT_PIPELINED_READ */
+
 /* Default maximum number of flash sectors per image slot; change
  * as desirable. */
 #define MCUBOOT_MAX_IMG_SECTORS 128
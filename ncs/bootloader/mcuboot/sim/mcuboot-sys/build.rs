@@ -24,6 +24,9 @@ fn main() {
     let bootstrap = env::var("CARGO_FEATURE_BOOTSTRAP").is_ok();
     let multiimage = env::var("CARGO_FEATURE_MULTIIMAGE").is_ok();
     let downgrade_prevention = env::var("CARGO_FEATURE_DOWNGRADE_PREVENTION").is_ok();
+    let validate_primary_slot_once =
+                  env::var("CARGO_FEATURE_VALIDATE_PRIMARY_SLOT_ONCE").is_ok();
+    let pipelined_read = env::var("CARGO_FEATURE_PIPELINED_READ").is_ok();
 
     let mut conf = cc::Build::new();
     conf.define("__BOOTSIM__", None);
@@ -45,6 +48,14 @@ fn main() {
         conf.define("MCUBOOT_VALIDATE_PRIMARY_SLOT", None);
     }
 
+    if validate_primary_slot_once {
+        conf.define("MCUBOOT_VALIDATE_PRIMARY_SLOT_ONCE", None);
+    }
+
+    if pipelined_read {
+        conf.define("MCUBOOT_PIPELINED_READ", None);
+    }
+
     if downgrade_prevention {
         conf.define("MCUBOOT_DOWNGRADE_PREVENTION", None);
     }
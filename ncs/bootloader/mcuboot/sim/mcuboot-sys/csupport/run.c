@@ -7,6 +7,7 @@
 #include <string.h>
 #include <bootutil/bootutil.h>
 #include <bootutil/image.h>
+#include <bootutil/sign_key.h>
 
 #include <flash_map_backend/flash_map_backend.h>
 
@@ -40,6 +41,11 @@ extern void sim_reset_context(void);
 extern int sim_flash_erase(uint8_t flash_id, uint32_t offset, uint32_t size);
 extern int sim_flash_read(uint8_t flash_id, uint32_t offset, uint8_t *dest,
         uint32_t size);
+extern int sim_flash_read_start(uint8_t flash_id, uint32_t offset,
+        uint8_t *dest, uint32_t size);
+extern int sim_flash_read_wait(uint8_t flash_id);
+extern int sim_flash_write_gen(uint8_t flash_id, uint32_t offset,
+        uint32_t size, uint32_t *gen);
 extern int sim_flash_write(uint8_t flash_id, uint32_t offset, const uint8_t *src,
         uint32_t size);
 extern uint8_t sim_flash_align(uint8_t flash_id);
@@ -309,6 +315,47 @@ int flash_area_read(const struct flash_area *area, uint32_t off, void *dst,
     return sim_flash_read(area->fa_device_id, area->fa_off + off, dst, len);
 }
 
+int flash_area_read_start(const struct flash_area *area, uint32_t off,
+                          void *dst, uint32_t len)
+{
+    BOOT_LOG_SIM("%s: area=%d, off=%x, len=%x",
+                 __func__, area->fa_id, off, len);
+    return sim_flash_read_start(area->fa_device_id, area->fa_off + off, dst,
+                                len);
+}
+
+int flash_area_read_wait(const struct flash_area *area)
+{
+    return sim_flash_read_wait(area->fa_device_id);
+}
+
+int flash_area_get_write_gen(const struct flash_area *area, uint32_t off,
+                             uint32_t len, uint32_t *gen)
+{
+    return sim_flash_write_gen(area->fa_device_id, area->fa_off + off, len,
+                               gen);
+}
+
+/*
+ * The simulated devices all share the same secret.
+ */
+int boot_retrieve_validated_key(uint8_t *key, size_t *key_len)
+{
+    static const uint8_t sim_validated_key[32] = {
+        0x3b, 0x91, 0x0e, 0xc7, 0x54, 0x2a, 0xf8, 0x66,
+        0xd1, 0x0f, 0x83, 0x4e, 0xb9, 0x27, 0x6c, 0x15,
+        0xa0, 0x5d, 0xe2, 0x39, 0x7f, 0xc4, 0x18, 0x8b,
+        0x62, 0xf3, 0x0a, 0x9e, 0x45, 0xd7, 0x2c, 0xb0,
+    };
+
+    if (*key_len < sizeof(sim_validated_key)) {
+        return -1;
+    }
+    memcpy(key, sim_validated_key, sizeof(sim_validated_key));
+    *key_len = sizeof(sim_validated_key);
+    return 0;
+}
+
 int flash_area_write(const struct flash_area *area, uint32_t off, const void *src,
                      uint32_t len)
 {
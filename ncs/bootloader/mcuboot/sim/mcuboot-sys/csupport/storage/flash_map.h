@@ -138,6 +138,23 @@ uint8_t flash_area_erased_val(const struct flash_area *);
 int flash_area_read_is_empty(const struct flash_area *fa, uint32_t off,
         void *dst, uint32_t len);
 
+/*
+ * Starts reading len bytes from off without waiting for the data, which is
+ * only valid once flash_area_read_wait() returned 0.  Only one read is in
+ * flight at a time, and every read started, even one that failed to start,
+ * is waited for.
+ */
+int flash_area_read_start(const struct flash_area *, uint32_t off, void *dst,
+  uint32_t len);
+int flash_area_read_wait(const struct flash_area *);
+
+/*
+ * Returns a value that changes whenever any of len bytes from off is written
+ * or erased.
+ */
+int flash_area_get_write_gen(const struct flash_area *, uint32_t off,
+  uint32_t len, uint32_t *gen);
+
 /*
  * Given flash area ID, return info about sectors within the area.
  */
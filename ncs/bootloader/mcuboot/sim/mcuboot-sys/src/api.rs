@@ -10,7 +10,7 @@ use libc;
 use log::{Level, log_enabled, warn};
 use simflash::{Result, Flash, FlashPtr};
 use std::{
-    cell::RefCell,
+    cell::{Cell, RefCell},
     collections::HashMap,
     mem,
     ptr,
@@ -72,9 +72,131 @@ impl CSimContextPtr {
     }
 }
 
+/// Flash reads done by the bootloader, used to compare boot times.
+#[derive(Clone, Copy, Debug, Default)]
+pub struct ReadStats {
+    pub reads: usize,
+    pub bytes: usize,
+}
+
+// Boot time model: a serial NOR flash behind a DMA capable controller, and a
+// CPU that hashes or decrypts every byte read from it.  Times are in ns.
+const READ_SETUP_NS: u64 = 5_000;
+const READ_BYTE_NS: u64 = 125;
+const WRITE_SETUP_NS: u64 = 5_000;
+const WRITE_BYTE_NS: u64 = 2_700;
+const ERASE_BYTE_NS: u64 = 11_000;
+const CPU_BYTE_NS: u64 = 800;
+
+/// Modeled time of the flash operations done by the bootloader, in ns.
+/// `time` lets the reads started by sim_flash_read_start run while the CPU
+/// works, `serial` is the time of the same operations done back to back.
+#[derive(Clone, Copy, Debug, Default)]
+pub struct FlashTime {
+    pub time: u64,
+    pub serial: u64,
+}
+
+/// A read running in the background: device, end time and result, and the
+/// data read, kept back from the destination buffer until the read is waited
+/// for.
+struct InFlightRead {
+    dev_id: u8,
+    done: u64,
+    rc: libc::c_int,
+    dest: *mut u8,
+    data: Vec<u8>,
+}
+
+#[derive(Default)]
+pub struct TimeModel {
+    now: u64,
+    serial: u64,
+    // Processing of the data last read, done before the next CPU wait.
+    pending: u64,
+    // End of the last operation started on each device.
+    busy: HashMap<u8, u64>,
+    inflight: Option<InFlightRead>,
+}
+
+impl TimeModel {
+    fn device_op(&mut self, dev_id: u8, cost: u64) {
+        self.now += self.pending;
+        self.pending = 0;
+        let start = self.now.max(*self.busy.get(&dev_id).unwrap_or(&0));
+        self.now = start + cost;
+        self.busy.insert(dev_id, self.now);
+        self.serial += cost;
+    }
+
+    fn process(&mut self, size: u32) {
+        self.pending = size as u64 * CPU_BYTE_NS;
+        self.serial += self.pending;
+    }
+
+    fn read(&mut self, dev_id: u8, size: u32) {
+        self.device_op(dev_id, READ_SETUP_NS + size as u64 * READ_BYTE_NS);
+        self.process(size);
+    }
+
+    fn read_start(&mut self, dev_id: u8, dest: *mut u8, data: Vec<u8>,
+                  rc: libc::c_int) -> libc::c_int {
+        if self.inflight.is_some() {
+            warn!("Starting a read while another one is in flight");
+            return -1;
+        }
+        let cost = READ_SETUP_NS + data.len() as u64 * READ_BYTE_NS;
+        let start = self.now.max(*self.busy.get(&dev_id).unwrap_or(&0));
+        self.busy.insert(dev_id, start + cost);
+        self.serial += cost;
+        self.inflight = Some(InFlightRead { dev_id, done: start + cost, rc, dest, data });
+        0
+    }
+
+    fn read_wait(&mut self, dev_id: u8) -> libc::c_int {
+        match self.inflight.take() {
+            Some(ref read) if read.dev_id == dev_id => {
+                unsafe {
+                    ptr::copy_nonoverlapping(read.data.as_ptr(), read.dest, read.data.len());
+                }
+                self.now = (self.now + self.pending).max(read.done);
+                self.process(read.data.len() as u32);
+                read.rc
+            },
+            _ => {
+                warn!("Waiting for a read that wasn't started");
+                -1
+            },
+        }
+    }
+
+    fn write(&mut self, dev_id: u8, size: u32) {
+        self.device_op(dev_id, WRITE_SETUP_NS + size as u64 * WRITE_BYTE_NS);
+    }
+
+    fn erase(&mut self, dev_id: u8, size: u32) {
+        self.device_op(dev_id, size as u64 * ERASE_BYTE_NS);
+    }
+
+    /// Return the time since the last call, and start over.
+    pub fn take(&mut self) -> FlashTime {
+        if self.inflight.is_some() {
+            warn!("Read left in flight");
+        }
+        let time = FlashTime {
+            time: self.now + self.pending,
+            serial: self.serial,
+        };
+        *self = TimeModel::default();
+        time
+    }
+}
+
 thread_local! {
     pub static THREAD_CTX: RefCell<FlashContext> = RefCell::new(FlashContext::new());
     pub static SIM_CTX: RefCell<CSimContextPtr> = RefCell::new(CSimContextPtr::new());
+    pub static READ_STATS: Cell<ReadStats> = Cell::new(ReadStats::default());
+    pub static TIME_MODEL: RefCell<TimeModel> = RefCell::new(TimeModel::default());
 }
 
 // Set the flash device to be used by the simulation.  The pointer is unsafely stashed away.
@@ -149,11 +271,11 @@ pub extern fn sim_flash_erase(dev_id: u8, offset: u32, size: u32) -> libc::c_int
             rc = map_err(dev.erase(offset as usize, size as usize));
         }
     });
+    TIME_MODEL.with(|model| model.borrow_mut().erase(dev_id, size));
     rc
 }
 
-#[no_mangle]
-pub extern fn sim_flash_read(dev_id: u8, offset: u32, dest: *mut u8, size: u32) -> libc::c_int {
+fn flash_read(dev_id: u8, offset: u32, dest: *mut u8, size: u32) -> libc::c_int {
     let mut rc: libc::c_int = -19;
     THREAD_CTX.with(|ctx| {
         if let Some(flash) = ctx.borrow().flash_map.get(&dev_id) {
@@ -162,9 +284,40 @@ pub extern fn sim_flash_read(dev_id: u8, offset: u32, dest: *mut u8, size: u32)
             rc = map_err(dev.read(offset as usize, &mut buf));
         }
     });
+    READ_STATS.with(|stats| {
+        let mut s = stats.get();
+        s.reads += 1;
+        s.bytes += size as usize;
+        stats.set(s);
+    });
     rc
 }
 
+#[no_mangle]
+pub extern fn sim_flash_read(dev_id: u8, offset: u32, dest: *mut u8, size: u32) -> libc::c_int {
+    TIME_MODEL.with(|model| model.borrow_mut().read(dev_id, size));
+    flash_read(dev_id, offset, dest, size)
+}
+
+/// The data is read into a buffer of the simulator, and only copied to `dest`
+/// by sim_flash_read_wait.  Until then `dest` holds a poison pattern, so that
+/// a buffer used before its read was waited for, or a read started into a
+/// buffer still being processed, gets the image check to fail.
+#[no_mangle]
+pub extern fn sim_flash_read_start(dev_id: u8, offset: u32, dest: *mut u8, size: u32) -> libc::c_int {
+    let mut data = vec![0u8; size as usize];
+    let rc = flash_read(dev_id, offset, data.as_mut_ptr(), size);
+    unsafe {
+        ptr::write_bytes(dest, 0xa5, size as usize);
+    }
+    TIME_MODEL.with(|model| model.borrow_mut().read_start(dev_id, dest, data, rc))
+}
+
+#[no_mangle]
+pub extern fn sim_flash_read_wait(dev_id: u8) -> libc::c_int {
+    TIME_MODEL.with(|model| model.borrow_mut().read_wait(dev_id))
+}
+
 #[no_mangle]
 pub extern fn sim_flash_write(dev_id: u8, offset: u32, src: *const u8, size: u32) -> libc::c_int {
     let mut rc: libc::c_int = -19;
@@ -175,6 +328,28 @@ pub extern fn sim_flash_write(dev_id: u8, offset: u32, src: *const u8, size: u32
             rc = map_err(dev.write(offset as usize, &buf));
         }
     });
+    TIME_MODEL.with(|model| model.borrow_mut().write(dev_id, size));
+    rc
+}
+
+#[no_mangle]
+pub extern fn sim_flash_write_gen(dev_id: u8, offset: u32, size: u32, gen: *mut u32) -> libc::c_int {
+    let mut rc: libc::c_int = -19;
+    THREAD_CTX.with(|ctx| {
+        if let Some(flash) = ctx.borrow().flash_map.get(&dev_id) {
+            let dev = unsafe { &*(flash.ptr) };
+            rc = match dev.write_gen(offset as usize, size as usize) {
+                Ok(g) => {
+                    unsafe { *gen = g; }
+                    0
+                },
+                Err(e) => {
+                    warn!("{}", e);
+                    -1
+                },
+            };
+        }
+    });
     rc
 }
 
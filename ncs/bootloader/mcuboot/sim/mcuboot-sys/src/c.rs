@@ -42,6 +42,16 @@ pub fn boot_go(multiflash: &mut SimMultiFlash, areadesc: &AreaDesc,
     (result, asserts)
 }
 
+/// Return the flash reads done by the bootloader since the last call.
+pub fn take_read_stats() -> api::ReadStats {
+    api::READ_STATS.with(|stats| stats.replace(api::ReadStats::default()))
+}
+
+/// Return the modeled time of the flash operations since the last call.
+pub fn take_flash_time() -> api::FlashTime {
+    api::TIME_MODEL.with(|model| model.borrow_mut().take())
+}
+
 pub fn boot_trailer_sz(align: u32) -> u32 {
     unsafe { raw::boot_trailer_sz(align) }
 }
@@ -60,6 +60,7 @@ pub trait Flash {
     fn erase(&mut self, offset: usize, len: usize) -> Result<()>;
     fn write(&mut self, offset: usize, payload: &[u8]) -> Result<()>;
     fn read(&self, offset: usize, data: &mut [u8]) -> Result<()>;
+    fn write_gen(&self, offset: usize, len: usize) -> Result<u32>;
 
     fn add_bad_region(&mut self, offset: usize, len: usize, rate: f32) -> Result<()>;
     fn reset_bad_regions(&mut self);
@@ -93,6 +94,8 @@ fn esimulatedwrite<T: AsRef<str>>(message: T) -> FlashError {
 pub struct SimFlash {
     data: Vec<u8>,
     write_safe: Vec<bool>,
+    // Number of times each byte was written or erased.
+    write_count: Vec<u32>,
     sectors: Vec<usize>,
     bad_region: Vec<(usize, usize, f32)>,
     // Alignment required for writes.
@@ -112,6 +115,7 @@ impl SimFlash {
         SimFlash {
             data: vec![erased_val; total],
             write_safe: vec![true; total],
+            write_count: vec![0; total],
             sectors: sectors,
             bad_region: Vec::new(),
             align: align,
@@ -173,6 +177,10 @@ impl Flash for SimFlash {
             *x = true;
         }
 
+        for x in &mut self.write_count[offset .. offset + len] {
+            *x = x.wrapping_add(1);
+        }
+
         Ok(())
     }
 
@@ -216,6 +224,10 @@ impl Flash for SimFlash {
             *x = false;
         }
 
+        for x in &mut self.write_count[offset .. offset + payload.len()] {
+            *x = x.wrapping_add(1);
+        }
+
         let sub = &mut self.data[offset .. offset + payload.len()];
         sub.copy_from_slice(payload);
         Ok(())
@@ -232,6 +244,17 @@ impl Flash for SimFlash {
         Ok(())
     }
 
+    /// The write generation of a range changes with every write or erase
+    /// touching it, including the writes of the tests themselves.
+    fn write_gen(&self, offset: usize, len: usize) -> Result<u32> {
+        if offset + len > self.data.len() {
+            bail!(ebounds("Write generation outside of device"));
+        }
+
+        Ok(self.write_count[offset .. offset + len].iter()
+           .fold(0u32, |gen, &x| gen.wrapping_add(x)))
+    }
+
     /// Adds a new flash bad region. Writes to this area fail with a chance
     /// given by `rate`.
     fn add_bad_region(&mut self, offset: usize, len: usize, rate: f32) -> Result<()> {
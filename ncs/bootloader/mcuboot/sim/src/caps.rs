@@ -24,6 +24,8 @@ pub enum Caps {
     SwapUsingMove        = (1 << 11),
     DowngradePrevention  = (1 << 12),
     EncX25519            = (1 << 13),
+    ValidatePrimarySlotOnce = (1 << 14),
+    PipelinedRead        = (1 << 15),
 }
 
 impl Caps {
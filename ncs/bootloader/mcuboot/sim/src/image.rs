@@ -34,7 +34,7 @@ use aes_ctr::{
 };
 
 use simflash::{Flash, SimFlash, SimMultiFlash};
-use mcuboot_sys::{c, AreaDesc, FlashId};
+use mcuboot_sys::{api, c, AreaDesc, FlashId};
 use crate::{
     ALL_DEVICES,
     DeviceName,
@@ -601,6 +601,161 @@ impl Images {
         fails > 0
     }
 
+    /// Boot an unchanged primary slot a few times.  The first boot has to
+    /// validate the images in full, the following ones can rely on the
+    /// validated-image record and should read far less of the flash.  Any
+    /// write to an image behind the bootloader's back, to its header or its
+    /// payload, must get it validated in full again, even when the written
+    /// value is the one that was already there.
+    pub fn run_validated_boot(&self) -> bool {
+        if !Caps::ValidatePrimarySlotOnce.present() {
+            return false;
+        }
+
+        let mut flash = self.flash.clone();
+        let mut fails = 0;
+
+        info!("Try booting an already validated primary slot");
+
+        let mut stats = vec![];
+        for _ in 0..3 {
+            c::take_read_stats();
+            let (result, _) = c::boot_go(&mut flash, &self.areadesc, None, false);
+            if result != 0 {
+                warn!("Failed boot of an unchanged primary slot");
+                fails += 1;
+            }
+            stats.push(c::take_read_stats());
+        }
+
+        // Rough boot time model: each read costs a fixed setup time, and
+        // every byte read is also hashed, at 1 byte per microsecond.
+        let boot_us = |s: &api::ReadStats| s.reads * 10 + s.bytes;
+        info!("Boot reads: full validation {} bytes in {} reads (~{} us), \
+               with the record {} bytes in {} reads (~{} us)",
+              stats[0].bytes, stats[0].reads, boot_us(&stats[0]),
+              stats[1].bytes, stats[1].reads, boot_us(&stats[1]));
+
+        if stats[1].bytes * 4 > stats[0].bytes ||
+           stats[2].bytes != stats[1].bytes {
+            warn!("Validated-image record not used on later boots");
+            fails += 1;
+        }
+
+        if !self.verify_images(&flash, 0, 0) {
+            warn!("Failed image verification");
+            fails += 1;
+        }
+
+        let plain = &self.images[0].primaries.plain;
+        let hdr_size = (plain[8] as usize) | ((plain[9] as usize) << 8);
+        let img_size = (plain[12] as usize) | ((plain[13] as usize) << 8) |
+            ((plain[14] as usize) << 16) | ((plain[15] as usize) << 24);
+        let slot = &self.images[0].slots[0];
+
+        // Validating the first image in full reads its whole payload, which
+        // the record lets the bootloader skip.
+        let revalidated = |s: &api::ReadStats| s.bytes > stats[1].bytes + img_size / 2;
+
+        // Bump the version in the first image header, then flip a byte of
+        // its payload, leaving the trailer and its record untouched.
+        for &(off, what) in &[(20, "header"), (hdr_size + 1, "payload")] {
+            let mut flash = flash.clone();
+            rewrite_byte(&mut flash, slot, off, |b| b ^ 1);
+
+            c::take_read_stats();
+            let (result, _) = c::boot_go(&mut flash, &self.areadesc, None, false);
+            let s = c::take_read_stats();
+            let mut byte = [0u8; 1];
+            flash.get(&slot.dev_id).unwrap().read(slot.base_off + off, &mut byte).unwrap();
+            if result == 0 && byte[0] != plain[off] {
+                warn!("Booted a primary slot with its {} changed after its validation", what);
+                fails += 1;
+            }
+            if !revalidated(&s) {
+                warn!("Primary slot with a changed {} not validated in full", what);
+                fails += 1;
+            }
+        }
+
+        // Writing a payload byte with the value it already has leaves a
+        // valid image, which must be validated in full on every boot now,
+        // the record not being rewritten until the next update.
+        let mut flash = flash.clone();
+        rewrite_byte(&mut flash, slot, hdr_size + 1, |b| b);
+        for _ in 0..2 {
+            c::take_read_stats();
+            let (result, _) = c::boot_go(&mut flash, &self.areadesc, None, false);
+            let s = c::take_read_stats();
+            if result != 0 {
+                warn!("Failed boot of a rewritten but unchanged primary slot");
+                fails += 1;
+            }
+            if !revalidated(&s) {
+                warn!("Rewritten primary slot not validated in full");
+                fails += 1;
+            }
+        }
+
+        if fails > 0 {
+            error!("Error booting an already validated primary slot");
+        }
+
+        fails > 0
+    }
+
+    /// Upgrade, then boot the new image, timing both with the flash time
+    /// model of the simulator.  Reading the next block of an image while the
+    /// current one is hashed, decrypted or written must save time over doing
+    /// the same operations back to back.
+    pub fn run_pipelined_read(&self) -> bool {
+        if !Caps::PipelinedRead.present() {
+            return false;
+        }
+
+        let mut flash = self.flash.clone();
+        let mut fails = 0;
+
+        info!("Try an upgrade and a boot with pipelined reads");
+
+        let mut times = vec![];
+        for _ in 0..2 {
+            c::take_flash_time();
+            let (result, _) = c::boot_go(&mut flash, &self.areadesc, None, false);
+            if result != 0 {
+                warn!("Failed boot with pipelined reads");
+                fails += 1;
+            }
+            times.push(c::take_flash_time());
+        }
+
+        for (name, t) in ["Upgrade", "Boot"].iter().zip(times.iter()) {
+            info!("{}: {} us, {} us with serial reads, {:.1}% saved",
+                  name, t.time / 1000, t.serial / 1000,
+                  t.serial.saturating_sub(t.time) as f64 * 100.0 /
+                  t.serial.max(1) as f64);
+        }
+
+        // Without validation of the primary slot, a boot hardly reads it.
+        if times[0].time >= times[0].serial ||
+           (Caps::ValidatePrimarySlot.present() &&
+            times[1].time >= times[1].serial) {
+            warn!("Pipelined reads didn't overlap with the processing");
+            fails += 1;
+        }
+
+        if !self.verify_images(&flash, 0, 1) {
+            warn!("Primary slot image verification FAIL");
+            fails += 1;
+        }
+
+        if fails > 0 {
+            error!("Error upgrading with pipelined reads");
+        }
+
+        fails > 0
+    }
+
     // Tests a new image written to the primary slot that already has magic and
     // image_ok set while there is no image on the secondary slot, so no revert
     // should ever happen...
@@ -1568,6 +1723,21 @@ fn mark_permanent_upgrade(flash: &mut SimMultiFlash, slot: &SlotInfo) {
     dev.write(off, &ok[..align]).unwrap();
 }
 
+/// Rewrite the byte at `off` in a slot with `f` of its value, the way a
+/// debugger or a rogue application could, bypassing the erase rules.
+fn rewrite_byte<F: Fn(u8) -> u8>(flash: &mut SimMultiFlash, slot: &SlotInfo, off: usize, f: F) {
+    let dev = flash.get_mut(&slot.dev_id).unwrap();
+    let align = dev.align();
+    let off = slot.base_off + off;
+    let base = off - (off % align);
+    let mut buf = vec![0u8; align];
+    dev.read(base, &mut buf).unwrap();
+    buf[off - base] = f(buf[off - base]);
+    dev.set_verify_writes(false);
+    dev.write(base, &buf).unwrap();
+    dev.set_verify_writes(true);
+}
+
 // Drop some pseudo-random gibberish onto the data.
 fn splat(data: &mut [u8], seed: usize) {
     let seed_block = [0x135782ea, 0x92184728, data.len() as u32, seed as u32];
@@ -56,6 +56,8 @@ sim_test!(norevert, make_image(&NO_DEPS, true), run_norevert());
 sim_test!(status_write_fails_complete, make_image(&NO_DEPS, true), run_with_status_fails_complete());
 sim_test!(status_write_fails_with_reset, make_image(&NO_DEPS, true), run_with_status_fails_with_reset());
 sim_test!(downgrade_prevention, make_image(&REV_DEPS, true), run_nodowngrade());
+sim_test!(validated_boot, make_no_upgrade_image(&NO_DEPS), run_validated_boot());
+sim_test!(pipelined_read, make_image(&NO_DEPS, true), run_pipelined_read());
 
 // Test various combinations of incorrect dependencies.
 test_shell!(dependency_combos, r, {
@@ -81,6 +81,22 @@ int mbedtls_aesni_crypt_ecb( mbedtls_aes_context *ctx,
                              const unsigned char input[16],
                              unsigned char output[16] );
 
+/**
+ * \brief          Internal AES-NI AES-CTR encryption of 8 blocks
+ *
+ * \note           This function is only for internal use by other library
+ *                 functions; you must not call it directly.
+ *
+ * \param ctx      AES context set up for encryption
+ * \param counters 8 counter blocks, one per block
+ * \param input    128-byte input
+ * \param output   128-byte output, may overlap with the input
+ */
+void mbedtls_aesni_crypt_ctr8( mbedtls_aes_context *ctx,
+                               const unsigned char counters[128],
+                               const unsigned char input[128],
+                               unsigned char output[128] );
+
 /**
  * \brief          Internal GCM multiplication: c = a * b in GF(2^128)
  *
@@ -98,6 +114,36 @@ void mbedtls_aesni_gcm_mult( unsigned char c[16],
                              const unsigned char a[16],
                              const unsigned char b[16] );
 
+/**
+ * \brief          Internal computation of the powers of H used by
+ *                 mbedtls_aesni_gcm_ghash()
+ *
+ * \note           This function is only for internal use by other library
+ *                 functions; you must not call it directly.
+ *
+ * \param hpow     H^4, H^3, H^2 and H, in an internal representation
+ * \param h        The GCM hash subkey H
+ */
+void mbedtls_aesni_gcm_hpow( unsigned char hpow[64],
+                             const unsigned char h[16] );
+
+/**
+ * \brief          Internal GHASH of whole blocks: for each block b,
+ *                 x = ( x + b ) * H in GF(2^128)
+ *
+ * \note           This function is only for internal use by other library
+ *                 functions; you must not call it directly.
+ *
+ * \param x        GHASH state, updated
+ * \param hpow     Powers of H from mbedtls_aesni_gcm_hpow()
+ * \param input    Blocks to hash
+ * \param blocks   Number of 16-byte blocks
+ */
+void mbedtls_aesni_gcm_ghash( unsigned char x[16],
+                              const unsigned char hpow[64],
+                              const unsigned char *input,
+                              size_t blocks );
+
 /**
  * \brief           Internal round key inversion. This function computes
  *                  decryption round keys from the encryption round keys.
@@ -115,6 +115,7 @@
       defined(MBEDTLS_ECDSA_VERIFY_ALT)        || \
       defined(MBEDTLS_ECDSA_GENKEY_ALT)        || \
       defined(MBEDTLS_ECP_INTERNAL_ALT)        || \
+      defined(MBEDTLS_ECP_P256_FIXED_LIMBS)    || \
       defined(MBEDTLS_ECP_ALT) )
 #error "MBEDTLS_ECP_RESTARTABLE defined, but it cannot coexist with an alternative ECP implementation"
 #endif
@@ -177,6 +178,14 @@
 #error "MBEDTLS_GCM_C defined, but not all prerequisites"
 #endif
 
+#if defined(MBEDTLS_ECP_P256_FIXED_LIMBS) &&                \
+    ( !defined(MBEDTLS_ECP_C) ||                            \
+      !defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED) ||         \
+      defined(MBEDTLS_ECP_INTERNAL_ALT) ||                  \
+      defined(MBEDTLS_ECP_ALT) )
+#error "MBEDTLS_ECP_P256_FIXED_LIMBS defined, but not all prerequisites"
+#endif
+
 #if defined(MBEDTLS_ECP_RANDOMIZE_JAC_ALT) && !defined(MBEDTLS_ECP_INTERNAL_ALT)
 #error "MBEDTLS_ECP_RANDOMIZE_JAC_ALT defined, but not all prerequisites"
 #endif
@@ -289,6 +298,11 @@
 #error "MBEDTLS_MEMORY_DEBUG defined, but not all prerequesites"
 #endif
 
+#if defined(MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB) &&                       \
+    !defined(MBEDTLS_MEMORY_BUFFER_ALLOC_C)
+#error "MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB defined, but not all prerequisites"
+#endif
+
 #if defined(MBEDTLS_PADLOCK_C) && !defined(MBEDTLS_HAVE_ASM)
 #error "MBEDTLS_PADLOCK_C defined, but not all prerequisites"
 #endif
@@ -521,6 +535,11 @@
 #error "MBEDTLS_RSA_C defined, but none of the PKCS1 versions enabled"
 #endif
 
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE) &&                          \
+    ( !defined(MBEDTLS_X509_CRT_PARSE_C) || !defined(MBEDTLS_SHA256_C) )
+#error "MBEDTLS_X509_CRT_VERIFY_CACHE defined, but not all prerequisites"
+#endif
+
 #if defined(MBEDTLS_X509_RSASSA_PSS_SUPPORT) &&                        \
     ( !defined(MBEDTLS_RSA_C) || !defined(MBEDTLS_PKCS1_V21) )
 #error "MBEDTLS_X509_RSASSA_PSS_SUPPORT defined, but not all prerequisites"
@@ -780,6 +780,29 @@
  */
 #define MBEDTLS_ECP_NIST_OPTIM
 
+/**
+ * \def MBEDTLS_ECP_P256_FIXED_LIMBS
+ *
+ * Use fixed-size limb arithmetic for the point operations on secp256r1.
+ *
+ * Field elements are 4 (64-bit) or 8 (32-bit) limbs on the stack, multiplied
+ * in constant time with Montgomery multiplication, instead of heap-allocated
+ * bignums. This makes ECDSA and ECDH on secp256r1 faster, and removes their
+ * heap allocations for the intermediate values of the point operations.
+ *
+ * The arithmetic is plugged in through the MBEDTLS_ECP_XXX_ALT hooks of
+ * MBEDTLS_ECP_INTERNAL_ALT, which it defines: the other curves use the
+ * generic implementation. It cannot be combined with a user-provided
+ * MBEDTLS_ECP_INTERNAL_ALT, MBEDTLS_ECP_ALT or MBEDTLS_ECP_RESTARTABLE.
+ *
+ * Module:  library/ecp_p256.c
+ *
+ * Requires: MBEDTLS_ECP_C, MBEDTLS_ECP_DP_SECP256R1_ENABLED
+ *
+ * Uncomment this macro to enable the fixed-limb secp256r1 arithmetic.
+ */
+//#define MBEDTLS_ECP_P256_FIXED_LIMBS
+
 /**
  * \def MBEDTLS_ECP_RESTARTABLE
  *
@@ -1231,6 +1254,24 @@
  */
 //#define MBEDTLS_MEMORY_BACKTRACE
 
+/**
+ * \def MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB
+ *
+ * Serve small allocations of the buffer allocator from size-class slabs.
+ *
+ * Requests up to 256 bytes are rounded up to one of a few size classes and
+ * taken from slabs of MBEDTLS_MEMORY_SLAB_SIZE bytes carved out of the
+ * buffer, instead of walking the list of all blocks. This avoids the
+ * fragmentation caused by the many short-lived bignum limbs of a handshake.
+ * With MBEDTLS_THREADING_PTHREAD each thread also keeps a small cache of
+ * free objects that it uses without taking the heap mutex.
+ *
+ * Requires: MBEDTLS_MEMORY_BUFFER_ALLOC_C
+ *
+ * Uncomment this macro to use slabs for small allocations.
+ */
+//#define MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB
+
 /**
  * \def MBEDTLS_PK_RSA_ALT_SUPPORT
  *
@@ -1757,6 +1798,26 @@
  */
 #define MBEDTLS_X509_RSASSA_PSS_SUPPORT
 
+/**
+ * \def MBEDTLS_X509_CRT_VERIFY_CACHE
+ *
+ * Enable a cache of the certificate and CRL signatures found valid during
+ * certificate verification, see mbedtls_x509_crt_verify_with_cache() and
+ * mbedtls_ssl_conf_verify_cache().
+ *
+ * Peers presenting the same chains again then skip the public key
+ * operations of the issuer links already verified. The other checks
+ * (validity periods, revocation, profile, key usage, names) are still done
+ * on every verification.
+ *
+ * Module:  library/x509_crt.c
+ *
+ * Requires: MBEDTLS_X509_CRT_PARSE_C, MBEDTLS_SHA256_C
+ *
+ * Uncomment this macro to enable the verification cache.
+ */
+//#define MBEDTLS_X509_CRT_VERIFY_CACHE
+
 /**
  * \def MBEDTLS_ZLIB_SUPPORT
  *
@@ -3071,6 +3132,7 @@
 
 /* Memory buffer allocator options */
 //#define MBEDTLS_MEMORY_ALIGN_MULTIPLE      4 /**< Align on multiples of this value */
+//#define MBEDTLS_MEMORY_SLAB_SIZE        1024 /**< Size of the slabs of MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB, 1024 to 65535 */
 
 /* Platform options */
 //#define MBEDTLS_PLATFORM_STD_MEM_HDR   <stdlib.h> /**< Header to include if MBEDTLS_PLATFORM_NO_STD_FUNCTIONS is defined. Don't define if no header is needed. */
@@ -3141,6 +3203,7 @@
 /* SSL Cache options */
 //#define MBEDTLS_SSL_CACHE_DEFAULT_TIMEOUT       86400 /**< 1 day  */
 //#define MBEDTLS_SSL_CACHE_DEFAULT_MAX_ENTRIES      50 /**< Maximum entries in cache */
+//#define MBEDTLS_SSL_CACHE_SHARDS                    8 /**< Independently locked parts of the cache, 1 without MBEDTLS_THREADING_C */
 
 /* SSL options */
 
@@ -3257,6 +3320,7 @@
 /* X509 options */
 //#define MBEDTLS_X509_MAX_INTERMEDIATE_CA   8   /**< Maximum number of intermediate CAs in a verification chain. */
 //#define MBEDTLS_X509_MAX_FILE_PATH_LEN     512 /**< Maximum length of a path/filename string in bytes including the null terminator character ('\0'). */
+//#define MBEDTLS_X509_CRT_VERIFY_CACHE_DEFAULT_MAX_ENTRIES 64 /**< Maximum signatures in a verification cache */
 
 /**
  * Allow SHA-1 in the default TLS configuration for certificate signing.
@@ -67,6 +67,18 @@
 #include MBEDTLS_CONFIG_FILE
 #endif
 
+/*
+ * The fixed-limb secp256r1 arithmetic of ecp_p256.c is an implementation of
+ * the hooks below: it enables them without a user-provided alternative.
+ */
+#if defined(MBEDTLS_ECP_P256_FIXED_LIMBS)
+#define MBEDTLS_ECP_INTERNAL_ALT
+#define MBEDTLS_ECP_ADD_MIXED_ALT
+#define MBEDTLS_ECP_DOUBLE_JAC_ALT
+#define MBEDTLS_ECP_NORMALIZE_JAC_ALT
+#define MBEDTLS_ECP_NORMALIZE_JAC_MANY_ALT
+#endif /* MBEDTLS_ECP_P256_FIXED_LIMBS */
+
 #if defined(MBEDTLS_ECP_INTERNAL_ALT)
 
 /**
@@ -44,6 +44,14 @@
 #define MBEDTLS_MEMORY_ALIGN_MULTIPLE       4 /**< Align on multiples of this value */
 #endif
 
+#if !defined(MBEDTLS_MEMORY_SLAB_SIZE)
+#define MBEDTLS_MEMORY_SLAB_SIZE         1024 /**< Size of the slabs of MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB */
+#endif
+
+#if MBEDTLS_MEMORY_SLAB_SIZE < 1024 || MBEDTLS_MEMORY_SLAB_SIZE > 65535
+#error "MBEDTLS_MEMORY_SLAB_SIZE must be between 1024 and 65535"
+#endif
+
 /* \} name SECTION: Module settings */
 
 #define MBEDTLS_MEMORY_VERIFY_NONE         0
@@ -64,8 +72,11 @@ extern "C" {
  *          (Provided mbedtls_calloc() and mbedtls_free() are thread-safe if
  *           MBEDTLS_THREADING_C is defined)
  *
- * \note    This code is not optimized and provides a straight-forward
- *          implementation of a stack-based memory allocator.
+ * \note    Without MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB, this code is not
+ *          optimized and provides a straight-forward implementation of a
+ *          stack-based memory allocator. With it, small allocations come
+ *          from size-class slabs, and fall back to the block list when no
+ *          slab fits in the buffer any more.
  *
  * \param buf   buffer to use as heap
  * \param len   size of the buffer
@@ -93,6 +104,11 @@ void mbedtls_memory_buffer_set_verify( int verify );
  *          after a program should have de-allocated all memory)
  *          Prints out a list of 'still allocated' blocks and their stack
  *          trace if MBEDTLS_MEMORY_BACKTRACE is defined.
+ *
+ * \note    With MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB, the blocks include the
+ *          slabs, which stay allocated while one of their objects is in
+ *          use, in a thread cache, or is the last free slab of its class.
+ *          The objects in use are listed per size class.
  */
 void mbedtls_memory_buffer_alloc_status( void );
 
@@ -103,6 +119,9 @@ void mbedtls_memory_buffer_alloc_status( void );
  *                      includes bytes in allocated blocks too small to split
  *                      into smaller blocks but larger than the requested size.
  * \param max_blocks    Peak number of blocks in use, including free and used
+ *
+ * \note                With MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB, a slab counts
+ *                      as one block committed in full.
  */
 void mbedtls_memory_buffer_alloc_max_get( size_t *max_used, size_t *max_blocks );
 
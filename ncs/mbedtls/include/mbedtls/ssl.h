@@ -897,6 +897,9 @@ struct mbedtls_ssl_config
     mbedtls_ssl_key_cert *key_cert; /*!< own certificate/key pair(s)        */
     mbedtls_x509_crt *ca_chain;     /*!< trusted CAs                        */
     mbedtls_x509_crl *ca_crl;       /*!< trusted CAs CRLs                   */
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE)
+    mbedtls_x509_crt_verify_cache *verify_cache; /*!< verification cache   */
+#endif
 #endif /* MBEDTLS_X509_CRT_PARSE_C */
 
 #if defined(MBEDTLS_SSL_ASYNC_PRIVATE)
@@ -2022,6 +2025,24 @@ void mbedtls_ssl_conf_ca_chain( mbedtls_ssl_config *conf,
                                mbedtls_x509_crt *ca_chain,
                                mbedtls_x509_crl *ca_crl );
 
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE)
+/**
+ * \brief          Set the cache of peer certificate signatures found valid,
+ *                 to skip them in the next handshakes
+ *                 (Default: NULL, no cache)
+ *
+ * \note           The cache can be shared by several configurations and
+ *                 used from several threads if MBEDTLS_THREADING_C is
+ *                 enabled. It is not used by restartable ECC handshakes.
+ *                 See \c mbedtls_x509_crt_verify_with_cache().
+ *
+ * \param conf     SSL configuration
+ * \param cache    verification cache, or NULL to disable
+ */
+void mbedtls_ssl_conf_verify_cache( mbedtls_ssl_config *conf,
+                                    mbedtls_x509_crt_verify_cache *cache );
+#endif /* MBEDTLS_X509_CRT_VERIFY_CACHE */
+
 /**
  * \brief          Set own certificate chain and private key
  *
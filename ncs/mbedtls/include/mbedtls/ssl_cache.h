@@ -52,6 +52,18 @@
 #define MBEDTLS_SSL_CACHE_DEFAULT_MAX_ENTRIES      50   /*!< Maximum entries in cache */
 #endif
 
+#if !defined(MBEDTLS_SSL_CACHE_SHARDS)
+#if defined(MBEDTLS_THREADING_C)
+#define MBEDTLS_SSL_CACHE_SHARDS                    8   /*!< Independently locked parts of the cache */
+#else
+#define MBEDTLS_SSL_CACHE_SHARDS                    1   /*!< Independently locked parts of the cache */
+#endif
+#endif
+
+#if MBEDTLS_SSL_CACHE_SHARDS < 1
+#error "MBEDTLS_SSL_CACHE_SHARDS must be at least 1"
+#endif
+
 /* \} name SECTION: Module settings */
 
 #ifdef __cplusplus
@@ -60,6 +72,8 @@ extern "C" {
 
 typedef struct mbedtls_ssl_cache_context mbedtls_ssl_cache_context;
 typedef struct mbedtls_ssl_cache_entry mbedtls_ssl_cache_entry;
+typedef struct mbedtls_ssl_cache_shard mbedtls_ssl_cache_shard;
+typedef struct mbedtls_ssl_cache_stats mbedtls_ssl_cache_stats;
 
 /**
  * \brief   This structure is used for storing cache entries
@@ -73,7 +87,41 @@ struct mbedtls_ssl_cache_entry
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
     mbedtls_x509_buf peer_cert;         /*!< entry peer_cert    */
 #endif
-    mbedtls_ssl_cache_entry *next;      /*!< chain pointer      */
+    mbedtls_ssl_cache_entry *next;      /*!< hash bucket chain  */
+    mbedtls_ssl_cache_entry *lru_prev;  /*!< more recently used */
+    mbedtls_ssl_cache_entry *lru_next;  /*!< less recently used */
+    mbedtls_ssl_cache_entry *age_prev;  /*!< stored earlier     */
+    mbedtls_ssl_cache_entry *age_next;  /*!< stored later       */
+};
+
+/**
+ * \brief   Cache statistics
+ */
+struct mbedtls_ssl_cache_stats
+{
+    unsigned long hits;         /*!< sessions found by get      */
+    unsigned long misses;       /*!< sessions not found by get  */
+    unsigned long evictions;    /*!< entries reused when full   */
+    unsigned long expirations;  /*!< entries dropped on timeout */
+};
+
+/**
+ * \brief   Part of the cache selected by the session ID hash, with its own
+ *          hash table, LRU list, list by timestamp and lock
+ */
+struct mbedtls_ssl_cache_shard
+{
+    mbedtls_ssl_cache_entry **buckets;  /*!< hash table             */
+    unsigned int bucket_mask;           /*!< hash table size - 1    */
+    int count;                          /*!< entries in the shard   */
+    mbedtls_ssl_cache_entry *lru_head;  /*!< most recently used     */
+    mbedtls_ssl_cache_entry *lru_tail;  /*!< least recently used    */
+    mbedtls_ssl_cache_entry *age_head;  /*!< oldest timestamp       */
+    mbedtls_ssl_cache_entry *age_tail;  /*!< newest timestamp       */
+    mbedtls_ssl_cache_stats stats;      /*!< shard statistics       */
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_threading_mutex_t mutex;    /*!< mutex                  */
+#endif
 };
 
 /**
@@ -81,12 +129,9 @@ struct mbedtls_ssl_cache_entry
  */
 struct mbedtls_ssl_cache_context
 {
-    mbedtls_ssl_cache_entry *chain;     /*!< start of the chain     */
+    mbedtls_ssl_cache_shard shards[MBEDTLS_SSL_CACHE_SHARDS]; /*!< shards */
     int timeout;                /*!< cache entry timeout    */
     int max_entries;            /*!< maximum entries        */
-#if defined(MBEDTLS_THREADING_C)
-    mbedtls_threading_mutex_t mutex;    /*!< mutex                  */
-#endif
 };
 
 /**
@@ -121,6 +166,10 @@ int mbedtls_ssl_cache_set( void *data, const mbedtls_ssl_session *session );
  *
  *                 A timeout of 0 indicates no timeout.
  *
+ * \note           The timeout counts from the first time a session ID is
+ *                 stored. Expired entries are freed when they are looked up,
+ *                 or when a new session is stored in the same shard.
+ *
  * \param cache    SSL cache context
  * \param timeout  cache entry timeout in seconds
  */
@@ -131,11 +180,28 @@ void mbedtls_ssl_cache_set_timeout( mbedtls_ssl_cache_context *cache, int timeou
  * \brief          Set the maximum number of cache entries
  *                 (Default: MBEDTLS_SSL_CACHE_DEFAULT_MAX_ENTRIES (50))
  *
+ * \note           The entries are spread over MBEDTLS_SSL_CACHE_SHARDS
+ *                 shards, each holding max / MBEDTLS_SSL_CACHE_SHARDS
+ *                 entries rounded up. When a shard is full its least
+ *                 recently used entry is replaced.
+ *
+ * \note           Call this before the cache is used: the hash table of a
+ *                 shard is sized when its first entry is stored.
+ *
  * \param cache    SSL cache context
  * \param max      cache entry maximum
  */
 void mbedtls_ssl_cache_set_max_entries( mbedtls_ssl_cache_context *cache, int max );
 
+/**
+ * \brief          Get the cache statistics, summed over the shards
+ *
+ * \param cache    SSL cache context
+ * \param stats    statistics
+ */
+void mbedtls_ssl_cache_get_stats( mbedtls_ssl_cache_context *cache,
+                                  mbedtls_ssl_cache_stats *stats );
+
 /**
  * \brief          Free referenced items in a cache context and clear memory
  *
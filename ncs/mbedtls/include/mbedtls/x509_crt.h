@@ -33,6 +33,10 @@
 #include "x509.h"
 #include "x509_crl.h"
 
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE) && defined(MBEDTLS_THREADING_C)
+#include "threading.h"
+#endif
+
 /**
  * \addtogroup x509_module
  * \{
@@ -125,6 +129,10 @@ mbedtls_x509_crt_profile;
 #define MBEDTLS_X509_MAX_FILE_PATH_LEN 512
 #endif
 
+#if !defined( MBEDTLS_X509_CRT_VERIFY_CACHE_DEFAULT_MAX_ENTRIES )
+#define MBEDTLS_X509_CRT_VERIFY_CACHE_DEFAULT_MAX_ENTRIES 64
+#endif
+
 /**
  * Container for writing a certificate (CRT)
  */
@@ -200,6 +208,55 @@ typedef void mbedtls_x509_crt_restart_ctx;
 
 #endif /* MBEDTLS_ECDSA_C && MBEDTLS_ECP_RESTARTABLE */
 
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE)
+
+/**
+ * \brief       Signature found valid by a verification
+ */
+typedef struct
+{
+    unsigned char key[32];      /**< SHA-256 of the signature check inputs  */
+    mbedtls_x509_time valid_to; /**< end of validity of signer and signed   */
+    unsigned long last_use;     /**< use counter value, 0 if the entry is free */
+}
+mbedtls_x509_crt_verify_cache_entry;
+
+/**
+ * \brief       Verification cache statistics
+ */
+typedef struct
+{
+    unsigned long hits;         /**< signature checks skipped       */
+    unsigned long misses;       /**< signature checks done          */
+    unsigned long evictions;    /**< entries reused when full       */
+    unsigned long expirations;  /**< entries dropped after validity */
+}
+mbedtls_x509_crt_verify_cache_stats;
+
+/**
+ * \brief       Cache of the signatures found valid by certificate
+ *              verifications, shared by the verifications using it
+ */
+typedef struct
+{
+    mbedtls_x509_crt_verify_cache_entry *entries; /**< sets of entries  */
+    unsigned int sets;          /**< number of sets, 0 before first use */
+    int max_entries;            /**< maximum entries                    */
+    unsigned long use_count;    /**< use counter, for LRU replacement   */
+    mbedtls_x509_crt_verify_cache_stats stats; /**< statistics          */
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_threading_mutex_t mutex;    /**< mutex                      */
+#endif
+}
+mbedtls_x509_crt_verify_cache;
+
+#else /* MBEDTLS_X509_CRT_VERIFY_CACHE */
+
+/* Now we can declare functions that take a pointer to that */
+typedef void mbedtls_x509_crt_verify_cache;
+
+#endif /* MBEDTLS_X509_CRT_VERIFY_CACHE */
+
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
 /**
  * Default security profile. Should provide a good balance between security
@@ -456,6 +513,52 @@ int mbedtls_x509_crt_verify_restartable( mbedtls_x509_crt *crt,
                      void *p_vrfy,
                      mbedtls_x509_crt_restart_ctx *rs_ctx );
 
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE)
+/**
+ * \brief          Version of \c mbedtls_crt_verify_with_profile() that
+ *                 skips the signature checks found valid by previous
+ *                 verifications using the same cache
+ *                 (Thread-safe if MBEDTLS_THREADING_C is enabled)
+ *
+ * \note           The cache holds the signatures of certificates by their
+ *                 issuer, and of CRLs by their CA, that were found valid.
+ *                 An entry covers the exact signed data, signature and
+ *                 issuer certificate, and expires at the end of the
+ *                 validity period of the signer or the signed certificate,
+ *                 whichever comes first (or the next update of a CRL).
+ *
+ * \note           Only the public key operations are skipped. Validity
+ *                 periods, revocation by the current \p ca_crl, profile,
+ *                 key usage and names are checked on every call, so new
+ *                 CRLs or trusted CAs take effect immediately without
+ *                 flushing the cache. A changed CRL is verified again as
+ *                 its content differs. Use
+ *                 \c mbedtls_x509_crt_verify_cache_flush() to drop the
+ *                 entries anyway, for example when a CA key is compromised.
+ *
+ * \param crt      a certificate (chain) to be verified
+ * \param trust_ca the list of trusted CAs
+ * \param ca_crl   the list of CRLs for trusted CAs
+ * \param profile  security profile for verification
+ * \param cn       expected Common Name (can be set to
+ *                 NULL if the CN must not be verified)
+ * \param flags    result of the verification
+ * \param f_vrfy   verification function
+ * \param p_vrfy   verification parameter
+ * \param cache    verification cache
+ *
+ * \return         See \c mbedtls_crt_verify_with_profile().
+ */
+int mbedtls_x509_crt_verify_with_cache( mbedtls_x509_crt *crt,
+                     mbedtls_x509_crt *trust_ca,
+                     mbedtls_x509_crl *ca_crl,
+                     const mbedtls_x509_crt_profile *profile,
+                     const char *cn, uint32_t *flags,
+                     int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
+                     void *p_vrfy,
+                     mbedtls_x509_crt_verify_cache *cache );
+#endif /* MBEDTLS_X509_CRT_VERIFY_CACHE */
+
 #if defined(MBEDTLS_X509_CHECK_KEY_USAGE)
 /**
  * \brief          Check usage of certificate against keyUsage extension.
@@ -539,6 +642,56 @@ void mbedtls_x509_crt_restart_init( mbedtls_x509_crt_restart_ctx *ctx );
  */
 void mbedtls_x509_crt_restart_free( mbedtls_x509_crt_restart_ctx *ctx );
 #endif /* MBEDTLS_ECDSA_C && MBEDTLS_ECP_RESTARTABLE */
+
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE)
+/**
+ * \brief          Initialize a verification cache
+ *
+ * \param cache    verification cache
+ */
+void mbedtls_x509_crt_verify_cache_init( mbedtls_x509_crt_verify_cache *cache );
+
+/**
+ * \brief          Set the maximum number of cache entries
+ *                 (Default: MBEDTLS_X509_CRT_VERIFY_CACHE_DEFAULT_MAX_ENTRIES
+ *                 (64)). A maximum of 0 disables the cache.
+ *
+ * \note           Each issuer link of a chain and each CRL takes one entry.
+ *                 The entries are kept in sets of 4, indexed by their key:
+ *                 when a set is full its least recently used entry is
+ *                 replaced. Changing the maximum flushes the cache.
+ *
+ * \param cache    verification cache
+ * \param max      cache entry maximum
+ */
+void mbedtls_x509_crt_verify_cache_set_max_entries(
+                                    mbedtls_x509_crt_verify_cache *cache,
+                                    int max );
+
+/**
+ * \brief          Drop all the entries of a verification cache
+ *
+ * \param cache    verification cache
+ */
+void mbedtls_x509_crt_verify_cache_flush( mbedtls_x509_crt_verify_cache *cache );
+
+/**
+ * \brief          Get the cache statistics
+ *
+ * \param cache    verification cache
+ * \param stats    statistics
+ */
+void mbedtls_x509_crt_verify_cache_get_stats(
+                                    mbedtls_x509_crt_verify_cache *cache,
+                                    mbedtls_x509_crt_verify_cache_stats *stats );
+
+/**
+ * \brief          Free the entries of a verification cache and clear memory
+ *
+ * \param cache    verification cache
+ */
+void mbedtls_x509_crt_verify_cache_free( mbedtls_x509_crt_verify_cache *cache );
+#endif /* MBEDTLS_X509_CRT_VERIFY_CACHE */
 #endif /* MBEDTLS_X509_CRT_PARSE_C */
 
 /* \} name */
@@ -1470,6 +1470,34 @@ int mbedtls_aes_crypt_ctr( mbedtls_aes_context *ctx,
     if ( n > 0x0F )
         return( MBEDTLS_ERR_AES_BAD_INPUT_DATA );
 
+#if defined(MBEDTLS_AESNI_C) && defined(MBEDTLS_HAVE_X86_64)
+    /* Whole chunks of 8 blocks, with their rounds interleaved */
+    if( n == 0 && length >= 128 &&
+        mbedtls_aesni_has_support( MBEDTLS_AESNI_AES ) )
+    {
+        unsigned char counters[128];
+        int j;
+
+        while( length >= 128 )
+        {
+            for( j = 0; j < 128; j += 16 )
+            {
+                memcpy( counters + j, nonce_counter, 16 );
+
+                for( i = 16; i > 0; i-- )
+                    if( ++nonce_counter[i - 1] != 0 )
+                        break;
+            }
+
+            mbedtls_aesni_crypt_ctr8( ctx, counters, input, output );
+
+            length -= 128;
+            input += 128;
+            output += 128;
+        }
+    }
+#endif
+
     while( length-- )
     {
         if( n == 0 ) {
@@ -95,6 +95,22 @@ int mbedtls_aesni_has_support( unsigned int what )
 #define xmm1_xmm0   "0xC1"
 #define xmm1_xmm2   "0xD1"
 
+/*
+ * Same instructions with the source operand in xmm8 (REX.B prefix), for the
+ * multi-block kernels which use xmm0 to xmm7 for the blocks.
+ */
+#define AESENC_X8       ".byte 0x66,0x41,0x0F,0x38,0xDC,"
+#define AESENCLAST_X8   ".byte 0x66,0x41,0x0F,0x38,0xDD,"
+
+#define xmm8_xmm0   "0xC0"
+#define xmm8_xmm1   "0xC8"
+#define xmm8_xmm2   "0xD0"
+#define xmm8_xmm3   "0xD8"
+#define xmm8_xmm4   "0xE0"
+#define xmm8_xmm5   "0xE8"
+#define xmm8_xmm6   "0xF0"
+#define xmm8_xmm7   "0xF8"
+
 /*
  * AES-NI AES-ECB block en(de)cryption
  */
@@ -140,6 +156,93 @@ int mbedtls_aesni_crypt_ecb( mbedtls_aes_context *ctx,
     return( 0 );
 }
 
+/*
+ * AES-NI AES-CTR encryption of 8 blocks, the rounds of the 8 blocks are
+ * interleaved so that their latencies overlap
+ */
+void mbedtls_aesni_crypt_ctr8( mbedtls_aes_context *ctx,
+                       const unsigned char counters[128],
+                       const unsigned char input[128],
+                       unsigned char output[128] )
+{
+    const unsigned char *rk = (const unsigned char *) ctx->rk;
+    int nr = ctx->nr;
+
+    asm volatile( "movdqu    (%1), %%xmm8        \n\t" // load round key 0
+         "movdqu      (%2), %%xmm0      \n\t" // load counters
+         "movdqu    16(%2), %%xmm1      \n\t"
+         "movdqu    32(%2), %%xmm2      \n\t"
+         "movdqu    48(%2), %%xmm3      \n\t"
+         "movdqu    64(%2), %%xmm4      \n\t"
+         "movdqu    80(%2), %%xmm5      \n\t"
+         "movdqu    96(%2), %%xmm6      \n\t"
+         "movdqu   112(%2), %%xmm7      \n\t"
+         "pxor      %%xmm8, %%xmm0      \n\t" // round 0
+         "pxor      %%xmm8, %%xmm1      \n\t"
+         "pxor      %%xmm8, %%xmm2      \n\t"
+         "pxor      %%xmm8, %%xmm3      \n\t"
+         "pxor      %%xmm8, %%xmm4      \n\t"
+         "pxor      %%xmm8, %%xmm5      \n\t"
+         "pxor      %%xmm8, %%xmm6      \n\t"
+         "pxor      %%xmm8, %%xmm7      \n\t"
+         "add       $16, %1             \n\t" // point to next round key
+         "subl      $1, %0              \n\t" // normal rounds = nr - 1
+
+         "1:                            \n\t" // encryption loop
+         "movdqu    (%1), %%xmm8        \n\t" // load round key
+         AESENC_X8  xmm8_xmm0          "\n\t" // do round on each block
+         AESENC_X8  xmm8_xmm1          "\n\t"
+         AESENC_X8  xmm8_xmm2          "\n\t"
+         AESENC_X8  xmm8_xmm3          "\n\t"
+         AESENC_X8  xmm8_xmm4          "\n\t"
+         AESENC_X8  xmm8_xmm5          "\n\t"
+         AESENC_X8  xmm8_xmm6          "\n\t"
+         AESENC_X8  xmm8_xmm7          "\n\t"
+         "add       $16, %1             \n\t" // point to next round key
+         "subl      $1, %0              \n\t" // loop
+         "jnz       1b                  \n\t"
+         "movdqu    (%1), %%xmm8        \n\t" // load round key
+         AESENCLAST_X8 xmm8_xmm0       "\n\t" // last round
+         AESENCLAST_X8 xmm8_xmm1       "\n\t"
+         AESENCLAST_X8 xmm8_xmm2       "\n\t"
+         AESENCLAST_X8 xmm8_xmm3       "\n\t"
+         AESENCLAST_X8 xmm8_xmm4       "\n\t"
+         AESENCLAST_X8 xmm8_xmm5       "\n\t"
+         AESENCLAST_X8 xmm8_xmm6       "\n\t"
+         AESENCLAST_X8 xmm8_xmm7       "\n\t"
+
+         // Load all of the input before storing any output, the buffers
+         // may overlap
+         "movdqu      (%3), %%xmm8      \n\t" // xor input
+         "pxor      %%xmm8, %%xmm0      \n\t"
+         "movdqu    16(%3), %%xmm8      \n\t"
+         "pxor      %%xmm8, %%xmm1      \n\t"
+         "movdqu    32(%3), %%xmm8      \n\t"
+         "pxor      %%xmm8, %%xmm2      \n\t"
+         "movdqu    48(%3), %%xmm8      \n\t"
+         "pxor      %%xmm8, %%xmm3      \n\t"
+         "movdqu    64(%3), %%xmm8      \n\t"
+         "pxor      %%xmm8, %%xmm4      \n\t"
+         "movdqu    80(%3), %%xmm8      \n\t"
+         "pxor      %%xmm8, %%xmm5      \n\t"
+         "movdqu    96(%3), %%xmm8      \n\t"
+         "pxor      %%xmm8, %%xmm6      \n\t"
+         "movdqu   112(%3), %%xmm8      \n\t"
+         "pxor      %%xmm8, %%xmm7      \n\t"
+         "movdqu    %%xmm0,   (%4)      \n\t" // export output
+         "movdqu    %%xmm1, 16(%4)      \n\t"
+         "movdqu    %%xmm2, 32(%4)      \n\t"
+         "movdqu    %%xmm3, 48(%4)      \n\t"
+         "movdqu    %%xmm4, 64(%4)      \n\t"
+         "movdqu    %%xmm5, 80(%4)      \n\t"
+         "movdqu    %%xmm6, 96(%4)      \n\t"
+         "movdqu    %%xmm7, 112(%4)     \n\t"
+         : "+r" (nr), "+r" (rk)
+         : "r" (counters), "r" (input), "r" (output)
+         : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+           "xmm6", "xmm7", "xmm8" );
+}
+
 /*
  * GCM multiplication: c = a times b in GF(2^128)
  * Based on [CLMUL-WP] algorithms 1 (with equation 27) and 5.
@@ -252,6 +355,170 @@ void mbedtls_aesni_gcm_mult( unsigned char c[16],
     return;
 }
 
+/*
+ * Byte reversal mask for pshufb
+ */
+static const unsigned char aesni_bswap_mask[16] =
+    { 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 };
+
+/*
+ * Powers of H for mbedtls_aesni_gcm_ghash()
+ */
+void mbedtls_aesni_gcm_hpow( unsigned char hpow[64],
+                     const unsigned char h[16] )
+{
+    unsigned char hk[16];
+    size_t i, k;
+
+    memcpy( hk, h, 16 );
+
+    for( k = 1; k <= 4; k++ )
+    {
+        if( k > 1 )
+            mbedtls_aesni_gcm_mult( hk, hk, h );
+
+        /* Stored byte-reversed, as loaded by the multiplication */
+        for( i = 0; i < 16; i++ )
+            hpow[16 * ( 4 - k ) + i] = hk[15 - i];
+    }
+}
+
+/*
+ * GHASH of groups of k blocks: x = ( x + b1 ) * H^k + b2 * H^(k-1) + ...
+ * + bk * H, using [CLMUL-WP] algorithm 1 for the products and a single
+ * shift and reduction per group ([CLMUL-WP] aggregated reduction).
+ */
+static void aesni_gcm_ghash_groups( unsigned char x[16],
+                                    const unsigned char *hpow,
+                                    const unsigned char *input,
+                                    size_t groups, size_t k )
+{
+    const unsigned char *hp;
+    size_t i;
+
+    asm volatile( "movdqu (%7), %%xmm9               \n\t" // byte reversal mask
+         "movdqu (%2), %%xmm8               \n\t" // x
+         "pshufb %%xmm9, %%xmm8             \n\t"
+
+         "1:                                \n\t" // group loop
+         "pxor %%xmm10, %%xmm10             \n\t" // low products
+         "pxor %%xmm11, %%xmm11             \n\t" // high products
+         "pxor %%xmm12, %%xmm12             \n\t" // middle products
+         "mov %5, %0                        \n\t" // first power of H
+         "mov %6, %1                        \n\t" // blocks in the group
+         "movdqu (%3), %%xmm0               \n\t" // a1:a0 = x + b1
+         "pshufb %%xmm9, %%xmm0             \n\t"
+         "pxor %%xmm8, %%xmm0               \n\t"
+         "jmp 3f                            \n\t"
+
+         "2:                                \n\t" // block loop
+         "movdqu (%3), %%xmm0               \n\t" // a1:a0 = bi
+         "pshufb %%xmm9, %%xmm0             \n\t"
+
+         "3:                                \n\t"
+         "movdqu (%0), %%xmm1               \n\t" // b1:b0 = H^j
+         "movdqa %%xmm1, %%xmm2             \n\t" // same
+         "movdqa %%xmm1, %%xmm3             \n\t" // same
+         "movdqa %%xmm1, %%xmm4             \n\t" // same
+         PCLMULQDQ xmm0_xmm1 ",0x00         \n\t" // a0*b0 = c1:c0
+         PCLMULQDQ xmm0_xmm2 ",0x11         \n\t" // a1*b1 = d1:d0
+         PCLMULQDQ xmm0_xmm3 ",0x10         \n\t" // a0*b1 = e1:e0
+         PCLMULQDQ xmm0_xmm4 ",0x01         \n\t" // a1*b0 = f1:f0
+         "pxor %%xmm3, %%xmm4               \n\t" // e1+f1:e0+f0
+         "pxor %%xmm1, %%xmm10              \n\t" // sum the products
+         "pxor %%xmm2, %%xmm11              \n\t"
+         "pxor %%xmm4, %%xmm12              \n\t"
+         "add $16, %3                       \n\t" // next block
+         "add $16, %0                       \n\t" // next power of H
+         "sub $1, %1                        \n\t"
+         "jnz 2b                            \n\t"
+
+         "movdqa %%xmm12, %%xmm3            \n\t" // middle products
+         "psrldq $8, %%xmm12                \n\t" // 0:e1+f1
+         "pslldq $8, %%xmm3                 \n\t" // e0+f0:0
+         "pxor %%xmm12, %%xmm11             \n\t" // d1:d0+e1+f1
+         "pxor %%xmm3, %%xmm10              \n\t" // c1+e0+f1:c0
+         "movdqa %%xmm10, %%xmm1            \n\t"
+         "movdqa %%xmm11, %%xmm2            \n\t"
+
+         /*
+          * Shift and reduction as in mbedtls_aesni_gcm_mult()
+          */
+         "movdqa %%xmm1, %%xmm3             \n\t" // r1:r0
+         "movdqa %%xmm2, %%xmm4             \n\t" // r3:r2
+         "psllq $1, %%xmm1                  \n\t" // r1<<1:r0<<1
+         "psllq $1, %%xmm2                  \n\t" // r3<<1:r2<<1
+         "psrlq $63, %%xmm3                 \n\t" // r1>>63:r0>>63
+         "psrlq $63, %%xmm4                 \n\t" // r3>>63:r2>>63
+         "movdqa %%xmm3, %%xmm5             \n\t" // r1>>63:r0>>63
+         "pslldq $8, %%xmm3                 \n\t" // r0>>63:0
+         "pslldq $8, %%xmm4                 \n\t" // r2>>63:0
+         "psrldq $8, %%xmm5                 \n\t" // 0:r1>>63
+         "por %%xmm3, %%xmm1                \n\t" // r1<<1|r0>>63:r0<<1
+         "por %%xmm4, %%xmm2                \n\t" // r3<<1|r2>>62:r2<<1
+         "por %%xmm5, %%xmm2                \n\t" // r3<<1|r2>>62:r2<<1|r1>>63
+
+         "movdqa %%xmm1, %%xmm3             \n\t" // x1:x0
+         "movdqa %%xmm1, %%xmm4             \n\t" // same
+         "movdqa %%xmm1, %%xmm5             \n\t" // same
+         "psllq $63, %%xmm3                 \n\t" // x1<<63:x0<<63 = stuff:a
+         "psllq $62, %%xmm4                 \n\t" // x1<<62:x0<<62 = stuff:b
+         "psllq $57, %%xmm5                 \n\t" // x1<<57:x0<<57 = stuff:c
+         "pxor %%xmm4, %%xmm3               \n\t" // stuff:a+b
+         "pxor %%xmm5, %%xmm3               \n\t" // stuff:a+b+c
+         "pslldq $8, %%xmm3                 \n\t" // a+b+c:0
+         "pxor %%xmm3, %%xmm1               \n\t" // x1+a+b+c:x0 = d:x0
+
+         "movdqa %%xmm1,%%xmm0              \n\t" // d:x0
+         "movdqa %%xmm1,%%xmm4              \n\t" // same
+         "movdqa %%xmm1,%%xmm5              \n\t" // same
+         "psrlq $1, %%xmm0                  \n\t" // e1:x0>>1 = e1:e0'
+         "psrlq $2, %%xmm4                  \n\t" // f1:x0>>2 = f1:f0'
+         "psrlq $7, %%xmm5                  \n\t" // g1:x0>>7 = g1:g0'
+         "pxor %%xmm4, %%xmm0               \n\t" // e1+f1:e0'+f0'
+         "pxor %%xmm5, %%xmm0               \n\t" // e1+f1+g1:e0'+f0'+g0'
+         "movdqa %%xmm1,%%xmm3              \n\t" // d:x0
+         "movdqa %%xmm1,%%xmm4              \n\t" // same
+         "movdqa %%xmm1,%%xmm5              \n\t" // same
+         "psllq $63, %%xmm3                 \n\t" // d<<63:stuff
+         "psllq $62, %%xmm4                 \n\t" // d<<62:stuff
+         "psllq $57, %%xmm5                 \n\t" // d<<57:stuff
+         "pxor %%xmm4, %%xmm3               \n\t" // d<<63+d<<62:stuff
+         "pxor %%xmm5, %%xmm3               \n\t" // missing bits of d:stuff
+         "psrldq $8, %%xmm3                 \n\t" // 0:missing bits of d
+         "pxor %%xmm3, %%xmm0               \n\t" // e1+f1+g1:e0+f0+g0
+         "pxor %%xmm1, %%xmm0               \n\t" // h1:h0
+         "pxor %%xmm2, %%xmm0               \n\t" // x3+h1:x2+h0
+         "movdqa %%xmm0, %%xmm8             \n\t" // new x
+
+         "sub $1, %4                        \n\t" // next group
+         "jnz 1b                            \n\t"
+
+         "pshufb %%xmm9, %%xmm8             \n\t"
+         "movdqu %%xmm8, (%2)               \n\t" // export x
+         : "=&r" (hp), "=&r" (i), "+r" (x), "+r" (input), "+r" (groups)
+         : "r" (hpow), "r" (k), "r" (aesni_bswap_mask)
+         : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+           "xmm8", "xmm9", "xmm10", "xmm11", "xmm12" );
+}
+
+/*
+ * GHASH of whole blocks, four blocks per reduction
+ */
+void mbedtls_aesni_gcm_ghash( unsigned char x[16],
+                      const unsigned char hpow[64],
+                      const unsigned char *input,
+                      size_t blocks )
+{
+    if( blocks >= 4 )
+        aesni_gcm_ghash_groups( x, hpow, input, blocks / 4, 4 );
+
+    if( blocks % 4 != 0 )
+        aesni_gcm_ghash_groups( x, hpow + 16 * ( 4 - blocks % 4 ),
+                                input + 16 * ( blocks - blocks % 4 ),
+                                1, blocks % 4 );
+}
+
 /*
  * Compute decryption round keys from encryption round keys
  */
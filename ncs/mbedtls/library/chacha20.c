@@ -37,6 +37,15 @@
 #include <stddef.h>
 #include <string.h>
 
+/*
+ * Multi-block keystream generation with SSE2 (4 blocks) and AVX2 (8 blocks)
+ */
+#if defined(MBEDTLS_HAVE_ASM) && defined(__GNUC__) && defined(__x86_64__) && \
+    !defined(MBEDTLS_CHACHA20_ALT)
+#define MBEDTLS_CHACHA20_X86_64
+#include <immintrin.h>
+#endif
+
 #if defined(MBEDTLS_SELF_TEST)
 #if defined(MBEDTLS_PLATFORM_C)
 #include "mbedtls/platform.h"
@@ -185,6 +194,271 @@ static void chacha20_block( const uint32_t initial_state[16],
     mbedtls_platform_zeroize( working_state, sizeof( working_state ) );
 }
 
+#if defined(MBEDTLS_CHACHA20_X86_64)
+
+#ifndef asm
+#define asm __asm
+#endif
+
+/*
+ * AVX2 support detection: the CPU must support AVX2 and the OS must save the
+ * YMM registers
+ */
+static int chacha20_has_avx2( void )
+{
+    static int done = 0;
+    static int avx2 = 0;
+
+    if( ! done )
+    {
+        unsigned int b, c, xcr0;
+
+        asm( "movl  $1, %%eax   \n\t"
+             "cpuid             \n\t"
+             : "=c" (c)
+             :
+             : "eax", "ebx", "edx" );
+
+        /* OSXSAVE and AVX */
+        if( ( c & 0x18000000U ) == 0x18000000U )
+        {
+            asm( "xorl  %%ecx, %%ecx    \n\t"
+                 ".byte 0x0F,0x01,0xD0  \n\t" /* xgetbv */
+                 : "=a" (xcr0)
+                 :
+                 : "ecx", "edx" );
+
+            asm( "movl  $7, %%eax       \n\t"
+                 "xorl  %%ecx, %%ecx    \n\t"
+                 "cpuid                 \n\t"
+                 : "=b" (b)
+                 :
+                 : "eax", "ecx", "edx" );
+
+            /* XMM and YMM state, AVX2 */
+            avx2 = ( xcr0 & 6U ) == 6U && ( b & 0x20U ) != 0;
+        }
+
+        done = 1;
+    }
+
+    return( avx2 );
+}
+
+#define ROTL32_SSE2( v, n )                                                 \
+    _mm_or_si128( _mm_slli_epi32( v, n ), _mm_srli_epi32( v, 32 - ( n ) ) )
+
+#define QUARTER_ROUND_SSE2( a, b, c, d )                                    \
+    do                                                                      \
+    {                                                                       \
+        a = _mm_add_epi32( a, b ); d = _mm_xor_si128( d, a );               \
+        d = ROTL32_SSE2( d, 16 );                                           \
+        c = _mm_add_epi32( c, d ); b = _mm_xor_si128( b, c );               \
+        b = ROTL32_SSE2( b, 12 );                                           \
+        a = _mm_add_epi32( a, b ); d = _mm_xor_si128( d, a );               \
+        d = ROTL32_SSE2( d, 8 );                                            \
+        c = _mm_add_epi32( c, d ); b = _mm_xor_si128( b, c );               \
+        b = ROTL32_SSE2( b, 7 );                                            \
+    }                                                                       \
+    while( 0 )
+
+/*
+ * Transpose the words a, b, c, d of 4 blocks and XOR them into 16 bytes of
+ * each of the 4 blocks.
+ */
+#define XOR_WORDS_SSE2( a, b, c, d, offset )                                \
+    do                                                                      \
+    {                                                                       \
+        __m128i t0 = _mm_unpacklo_epi32( a, b );                            \
+        __m128i t1 = _mm_unpacklo_epi32( c, d );                            \
+        __m128i t2 = _mm_unpackhi_epi32( a, b );                            \
+        __m128i t3 = _mm_unpackhi_epi32( c, d );                            \
+        a = _mm_unpacklo_epi64( t0, t1 );                                   \
+        b = _mm_unpackhi_epi64( t0, t1 );                                   \
+        c = _mm_unpacklo_epi64( t2, t3 );                                   \
+        d = _mm_unpackhi_epi64( t2, t3 );                                   \
+        XOR_BLOCK_SSE2( a, ( offset ) );                                    \
+        XOR_BLOCK_SSE2( b, ( offset ) + 64 );                               \
+        XOR_BLOCK_SSE2( c, ( offset ) + 128 );                              \
+        XOR_BLOCK_SSE2( d, ( offset ) + 192 );                              \
+    }                                                                       \
+    while( 0 )
+
+#define XOR_BLOCK_SSE2( v, offset )                                         \
+    _mm_storeu_si128( (__m128i *) ( output + ( offset ) ),                  \
+        _mm_xor_si128( v, _mm_loadu_si128(                                  \
+                              (const __m128i *) ( input + ( offset ) ) ) ) )
+
+/**
+ * \brief               Encrypts 4 blocks with the SSE2 instructions. Each
+ *                      vector holds the same state word of the 4 blocks.
+ *
+ * \param initial_state The initial ChaCha20 state, its counter is the
+ *                      counter of the first block.
+ * \param input         The 256-byte input.
+ * \param output        The 256-byte output, may be the input.
+ */
+static void chacha20_xor_blocks4( const uint32_t initial_state[16],
+                                  const unsigned char *input,
+                                  unsigned char *output )
+{
+    __m128i x[16], s[16];
+    size_t i;
+
+    for( i = 0U; i < 16U; i++ )
+        s[i] = _mm_set1_epi32( (int) initial_state[i] );
+    s[12] = _mm_add_epi32( s[12], _mm_set_epi32( 3, 2, 1, 0 ) );
+
+    for( i = 0U; i < 16U; i++ )
+        x[i] = s[i];
+
+    for( i = 0U; i < 10U; i++ )
+    {
+        QUARTER_ROUND_SSE2( x[0], x[4], x[8],  x[12] );
+        QUARTER_ROUND_SSE2( x[1], x[5], x[9],  x[13] );
+        QUARTER_ROUND_SSE2( x[2], x[6], x[10], x[14] );
+        QUARTER_ROUND_SSE2( x[3], x[7], x[11], x[15] );
+
+        QUARTER_ROUND_SSE2( x[0], x[5], x[10], x[15] );
+        QUARTER_ROUND_SSE2( x[1], x[6], x[11], x[12] );
+        QUARTER_ROUND_SSE2( x[2], x[7], x[8],  x[13] );
+        QUARTER_ROUND_SSE2( x[3], x[4], x[9],  x[14] );
+    }
+
+    for( i = 0U; i < 16U; i++ )
+        x[i] = _mm_add_epi32( x[i], s[i] );
+
+    XOR_WORDS_SSE2( x[0],  x[1],  x[2],  x[3],  0  );
+    XOR_WORDS_SSE2( x[4],  x[5],  x[6],  x[7],  16 );
+    XOR_WORDS_SSE2( x[8],  x[9],  x[10], x[11], 32 );
+    XOR_WORDS_SSE2( x[12], x[13], x[14], x[15], 48 );
+
+    mbedtls_platform_zeroize( x, sizeof( x ) );
+    mbedtls_platform_zeroize( s, sizeof( s ) );
+}
+
+#define ROTL32_AVX2( v, n )                                                 \
+    _mm256_or_si256( _mm256_slli_epi32( v, n ),                             \
+                     _mm256_srli_epi32( v, 32 - ( n ) ) )
+
+#define QUARTER_ROUND_AVX2( a, b, c, d )                                    \
+    do                                                                      \
+    {                                                                       \
+        a = _mm256_add_epi32( a, b ); d = _mm256_xor_si256( d, a );         \
+        d = _mm256_shuffle_epi8( d, rot16 );                                \
+        c = _mm256_add_epi32( c, d ); b = _mm256_xor_si256( b, c );         \
+        b = ROTL32_AVX2( b, 12 );                                           \
+        a = _mm256_add_epi32( a, b ); d = _mm256_xor_si256( d, a );         \
+        d = _mm256_shuffle_epi8( d, rot8 );                                 \
+        c = _mm256_add_epi32( c, d ); b = _mm256_xor_si256( b, c );         \
+        b = ROTL32_AVX2( b, 7 );                                            \
+    }                                                                       \
+    while( 0 )
+
+/*
+ * Transpose the words a, b, c, d of 8 blocks within each 128-bit lane: the
+ * low lane of a then holds the 4 words of block 0, its high lane those of
+ * block 4, and so on.
+ */
+#define TRANSPOSE_AVX2( a, b, c, d )                                        \
+    do                                                                      \
+    {                                                                       \
+        __m256i t0 = _mm256_unpacklo_epi32( a, b );                         \
+        __m256i t1 = _mm256_unpacklo_epi32( c, d );                         \
+        __m256i t2 = _mm256_unpackhi_epi32( a, b );                         \
+        __m256i t3 = _mm256_unpackhi_epi32( c, d );                         \
+        a = _mm256_unpacklo_epi64( t0, t1 );                                \
+        b = _mm256_unpackhi_epi64( t0, t1 );                                \
+        c = _mm256_unpacklo_epi64( t2, t3 );                                \
+        d = _mm256_unpackhi_epi64( t2, t3 );                                \
+    }                                                                       \
+    while( 0 )
+
+/*
+ * XOR 32 bytes of blocks n and n + 4 from the transposed words lo (first
+ * 16 bytes) and hi (next 16 bytes)
+ */
+#define XOR_BLOCKS_AVX2( lo, hi, n, offset )                                \
+    do                                                                      \
+    {                                                                       \
+        XOR_BLOCK_AVX2( _mm256_permute2x128_si256( lo, hi, 0x20 ),          \
+                        64 * ( n ) + ( offset ) );                          \
+        XOR_BLOCK_AVX2( _mm256_permute2x128_si256( lo, hi, 0x31 ),          \
+                        64 * ( ( n ) + 4 ) + ( offset ) );                  \
+    }                                                                       \
+    while( 0 )
+
+#define XOR_BLOCK_AVX2( v, offset )                                         \
+    _mm256_storeu_si256( (__m256i *) ( output + ( offset ) ),               \
+        _mm256_xor_si256( v, _mm256_loadu_si256(                            \
+                              (const __m256i *) ( input + ( offset ) ) ) ) )
+
+/**
+ * \brief               Encrypts 8 blocks with the AVX2 instructions. Each
+ *                      vector holds the same state word of the 8 blocks.
+ *
+ * \param initial_state The initial ChaCha20 state, its counter is the
+ *                      counter of the first block.
+ * \param input         The 512-byte input.
+ * \param output        The 512-byte output, may be the input.
+ */
+__attribute__((target("avx2")))
+static void chacha20_xor_blocks8( const uint32_t initial_state[16],
+                                  const unsigned char *input,
+                                  unsigned char *output )
+{
+    __m256i x[16], s[16];
+    const __m256i rot16 = _mm256_set_epi8( 13, 12, 15, 14, 9, 8, 11, 10,
+                                           5, 4, 7, 6, 1, 0, 3, 2,
+                                           13, 12, 15, 14, 9, 8, 11, 10,
+                                           5, 4, 7, 6, 1, 0, 3, 2 );
+    const __m256i rot8 = _mm256_set_epi8( 14, 13, 12, 15, 10, 9, 8, 11,
+                                          6, 5, 4, 7, 2, 1, 0, 3,
+                                          14, 13, 12, 15, 10, 9, 8, 11,
+                                          6, 5, 4, 7, 2, 1, 0, 3 );
+    size_t i;
+
+    for( i = 0U; i < 16U; i++ )
+        s[i] = _mm256_set1_epi32( (int) initial_state[i] );
+    s[12] = _mm256_add_epi32( s[12], _mm256_set_epi32( 7, 6, 5, 4,
+                                                       3, 2, 1, 0 ) );
+
+    for( i = 0U; i < 16U; i++ )
+        x[i] = s[i];
+
+    for( i = 0U; i < 10U; i++ )
+    {
+        QUARTER_ROUND_AVX2( x[0], x[4], x[8],  x[12] );
+        QUARTER_ROUND_AVX2( x[1], x[5], x[9],  x[13] );
+        QUARTER_ROUND_AVX2( x[2], x[6], x[10], x[14] );
+        QUARTER_ROUND_AVX2( x[3], x[7], x[11], x[15] );
+
+        QUARTER_ROUND_AVX2( x[0], x[5], x[10], x[15] );
+        QUARTER_ROUND_AVX2( x[1], x[6], x[11], x[12] );
+        QUARTER_ROUND_AVX2( x[2], x[7], x[8],  x[13] );
+        QUARTER_ROUND_AVX2( x[3], x[4], x[9],  x[14] );
+    }
+
+    for( i = 0U; i < 16U; i++ )
+        x[i] = _mm256_add_epi32( x[i], s[i] );
+
+    TRANSPOSE_AVX2( x[0],  x[1],  x[2],  x[3]  );
+    TRANSPOSE_AVX2( x[4],  x[5],  x[6],  x[7]  );
+    TRANSPOSE_AVX2( x[8],  x[9],  x[10], x[11] );
+    TRANSPOSE_AVX2( x[12], x[13], x[14], x[15] );
+
+    for( i = 0U; i < 4U; i++ )
+    {
+        XOR_BLOCKS_AVX2( x[i],     x[i + 4],  i, 0  );
+        XOR_BLOCKS_AVX2( x[i + 8], x[i + 12], i, 32 );
+    }
+
+    mbedtls_platform_zeroize( x, sizeof( x ) );
+    mbedtls_platform_zeroize( s, sizeof( s ) );
+}
+
+#endif /* MBEDTLS_CHACHA20_X86_64 */
+
 void mbedtls_chacha20_init( mbedtls_chacha20_context *ctx )
 {
     CHACHA20_VALIDATE( ctx != NULL );
@@ -275,6 +549,30 @@ int mbedtls_chacha20_update( mbedtls_chacha20_context *ctx,
         size--;
     }
 
+#if defined(MBEDTLS_CHACHA20_X86_64)
+    /* Process groups of 8 or 4 full blocks */
+    if( size >= 8U * CHACHA20_BLOCK_SIZE_BYTES && chacha20_has_avx2() )
+    {
+        while( size >= 8U * CHACHA20_BLOCK_SIZE_BYTES )
+        {
+            chacha20_xor_blocks8( ctx->state, input + offset, output + offset );
+            ctx->state[CHACHA20_CTR_INDEX] += 8U;
+
+            offset += 8U * CHACHA20_BLOCK_SIZE_BYTES;
+            size   -= 8U * CHACHA20_BLOCK_SIZE_BYTES;
+        }
+    }
+
+    while( size >= 4U * CHACHA20_BLOCK_SIZE_BYTES )
+    {
+        chacha20_xor_blocks4( ctx->state, input + offset, output + offset );
+        ctx->state[CHACHA20_CTR_INDEX] += 4U;
+
+        offset += 4U * CHACHA20_BLOCK_SIZE_BYTES;
+        size   -= 4U * CHACHA20_BLOCK_SIZE_BYTES;
+    }
+#endif /* MBEDTLS_CHACHA20_X86_64 */
+
     /* Process full blocks */
     while( size >= CHACHA20_BLOCK_SIZE_BYTES )
     {
@@ -102,8 +102,6 @@
 #define mbedtls_free       free
 #endif
 
-#include "mbedtls/ecp_internal.h"
-
 #if ( defined(__ARMCC_VERSION) || defined(_MSC_VER) ) && \
     !defined(inline) && !defined(__cplusplus)
 #define inline __inline
@@ -363,6 +361,9 @@ int mbedtls_ecp_check_budget( const mbedtls_ecp_group *grp,
 #define ECP_MONTGOMERY
 #endif
 
+/* Needs ECP_SHORTWEIERSTRASS and ECP_MONTGOMERY for the hook prototypes */
+#include "mbedtls/ecp_internal.h"
+
 /*
  * Curve types: internal for now, might be exposed later
  */
@@ -0,0 +1,720 @@
+/*
+ *  Elliptic curves over GF(p): fixed-size limb arithmetic for secp256r1
+ *
+ *  Copyright (C) 2006-2015, ARM Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+
+/*
+ * This module implements the MBEDTLS_ECP_XXX_ALT hooks of ecp_internal.h for
+ * secp256r1 only. Field elements are arrays of 4 (64-bit) or 8 (32-bit)
+ * limbs in Montgomery representation, with R = 2^256, and live on the stack:
+ * the hooks convert the coordinates of their input points, work on the
+ * limbs and convert the result back, without any heap allocation.
+ *
+ * The field operations run in constant time: there is no branch or memory
+ * access that depends on the value of the operands. The point operations
+ * keep the special cases of the generic code in ecp.c, which cannot happen
+ * with secret data (see ecp_add_mixed()).
+ *
+ * References:
+ *
+ * [1] KOC, Cetin Kaya, ACAR, Tolga, KALISKI, Burton S. Analyzing and
+ *     comparing Montgomery multiplication algorithms. IEEE Micro, 1996.
+ * [2] GUERON, Shay, KRASNOV, Vlad. Fast prime field elliptic-curve
+ *     cryptography with 256-bit primes. Journal of Cryptographic
+ *     Engineering, 2015.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_ECP_P256_FIXED_LIMBS)
+
+#include "mbedtls/ecp.h"
+#include "mbedtls/platform_util.h"
+
+#include <string.h>
+
+#define ECP_SHORTWEIERSTRASS
+#include "mbedtls/ecp_internal.h"
+
+#if ( defined(__ARMCC_VERSION) || defined(_MSC_VER) ) && \
+    !defined(inline) && !defined(__cplusplus)
+#define inline __inline
+#endif
+
+#define ciL     ( sizeof( mbedtls_mpi_uint ) )  /* chars in limb  */
+#define biL     ( ciL << 3 )                    /* bits  in limb  */
+#define biH     ( ciL << 2 )                    /* half limb size */
+
+#define P256_LIMBS      ( 32 / ciL )
+
+/* Points normalized by a single inversion in normalize_jac_many() */
+#define P256_MAX_BATCH  ( 1 << ( MBEDTLS_ECP_WINDOW_SIZE - 1 ) )
+
+/*
+ * Conversion macros for embedded constants, as in ecp_curves.c
+ */
+#if defined(MBEDTLS_HAVE_INT32)
+
+#define BYTES_TO_T_UINT_4( a, b, c, d )                       \
+    ( (mbedtls_mpi_uint) (a) <<  0 ) |                        \
+    ( (mbedtls_mpi_uint) (b) <<  8 ) |                        \
+    ( (mbedtls_mpi_uint) (c) << 16 ) |                        \
+    ( (mbedtls_mpi_uint) (d) << 24 )
+
+#define BYTES_TO_T_UINT_8( a, b, c, d, e, f, g, h ) \
+    BYTES_TO_T_UINT_4( a, b, c, d ),                \
+    BYTES_TO_T_UINT_4( e, f, g, h )
+
+#else /* 64-bits */
+
+#define BYTES_TO_T_UINT_8( a, b, c, d, e, f, g, h ) \
+    ( (mbedtls_mpi_uint) (a) <<  0 ) |                        \
+    ( (mbedtls_mpi_uint) (b) <<  8 ) |                        \
+    ( (mbedtls_mpi_uint) (c) << 16 ) |                        \
+    ( (mbedtls_mpi_uint) (d) << 24 ) |                        \
+    ( (mbedtls_mpi_uint) (e) << 32 ) |                        \
+    ( (mbedtls_mpi_uint) (f) << 40 ) |                        \
+    ( (mbedtls_mpi_uint) (g) << 48 ) |                        \
+    ( (mbedtls_mpi_uint) (h) << 56 )
+
+#endif /* bits in mbedtls_mpi_uint */
+
+/*
+ * p = 2^256 - 2^224 + 2^192 + 2^96 - 1, little-endian
+ */
+static const mbedtls_mpi_uint p256_p[P256_LIMBS] = {
+    BYTES_TO_T_UINT_8( 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF ),
+    BYTES_TO_T_UINT_8( 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00 ),
+    BYTES_TO_T_UINT_8( 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 ),
+    BYTES_TO_T_UINT_8( 0x01, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF ),
+};
+
+/*
+ * R^2 mod p, to enter the Montgomery representation
+ */
+static const mbedtls_mpi_uint p256_rr[P256_LIMBS] = {
+    BYTES_TO_T_UINT_8( 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 ),
+    BYTES_TO_T_UINT_8( 0xFF, 0xFF, 0xFF, 0xFF, 0xFB, 0xFF, 0xFF, 0xFF ),
+    BYTES_TO_T_UINT_8( 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF ),
+    BYTES_TO_T_UINT_8( 0xFD, 0xFF, 0xFF, 0xFF, 0x04, 0x00, 0x00, 0x00 ),
+};
+
+/*
+ * 1, to leave the Montgomery representation
+ */
+static const mbedtls_mpi_uint p256_one[P256_LIMBS] = {
+    BYTES_TO_T_UINT_8( 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 ),
+};
+
+/*
+ * Point in Jacobian coordinates, Montgomery representation
+ */
+typedef struct
+{
+    mbedtls_mpi_uint X[P256_LIMBS];
+    mbedtls_mpi_uint Y[P256_LIMBS];
+    mbedtls_mpi_uint Z[P256_LIMBS];
+}
+p256_point;
+
+/*
+ * Return the low limb of a * b + c + d, and its high limb in *hi.
+ * The result always fits in two limbs.
+ */
+static inline mbedtls_mpi_uint p256_mla( mbedtls_mpi_uint a,
+                                         mbedtls_mpi_uint b,
+                                         mbedtls_mpi_uint c,
+                                         mbedtls_mpi_uint d,
+                                         mbedtls_mpi_uint *hi )
+{
+#if defined(MBEDTLS_HAVE_UDBL)
+    mbedtls_t_udbl r = (mbedtls_t_udbl) a * b + c + d;
+
+    *hi = (mbedtls_mpi_uint)( r >> biL );
+    return( (mbedtls_mpi_uint) r );
+#else
+    const mbedtls_mpi_uint mask = ( (mbedtls_mpi_uint) 1 << biH ) - 1;
+    mbedtls_mpi_uint al = a & mask, ah = a >> biH;
+    mbedtls_mpi_uint bl = b & mask, bh = b >> biH;
+    mbedtls_mpi_uint ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+    mbedtls_mpi_uint mid, lo, h;
+
+    mid = ( ll >> biH ) + ( lh & mask ) + ( hl & mask );
+    lo  = ( ll & mask ) | ( mid << biH );
+    h   = hh + ( lh >> biH ) + ( hl >> biH ) + ( mid >> biH );
+
+    lo += c; h += ( lo < c );
+    lo += d; h += ( lo < d );
+
+    *hi = h;
+    return( lo );
+#endif /* MBEDTLS_HAVE_UDBL */
+}
+
+/*
+ * z = t - p if t + carry * 2^256 >= p, t otherwise, for t + carry * 2^256
+ * less than 2p
+ */
+static void p256_reduce_once( mbedtls_mpi_uint z[P256_LIMBS],
+                              const mbedtls_mpi_uint t[P256_LIMBS],
+                              mbedtls_mpi_uint carry )
+{
+    mbedtls_mpi_uint d[P256_LIMBS], borrow = 0, b1, mask;
+    size_t i;
+
+    for( i = 0; i < P256_LIMBS; i++ )
+    {
+        b1 = ( t[i] < p256_p[i] );
+        d[i] = t[i] - p256_p[i];
+        b1 |= ( d[i] < borrow );
+        d[i] -= borrow;
+        borrow = b1;
+    }
+
+    /* keep t only if the subtraction borrowed from a zero carry */
+    mask = (mbedtls_mpi_uint) 0 - ( borrow & ( carry ^ 1 ) );
+
+    for( i = 0; i < P256_LIMBS; i++ )
+        z[i] = ( t[i] & mask ) | ( d[i] & ~mask );
+}
+
+/*
+ * z = a + b mod p
+ */
+static void p256_add( mbedtls_mpi_uint z[P256_LIMBS],
+                      const mbedtls_mpi_uint a[P256_LIMBS],
+                      const mbedtls_mpi_uint b[P256_LIMBS] )
+{
+    mbedtls_mpi_uint t[P256_LIMBS], c = 0;
+    size_t i;
+
+    for( i = 0; i < P256_LIMBS; i++ )
+    {
+        t[i] = a[i] + c; c  = ( t[i] < c );
+        t[i] += b[i];    c += ( t[i] < b[i] );
+    }
+
+    p256_reduce_once( z, t, c );
+}
+
+/*
+ * z = a - b mod p
+ */
+static void p256_sub( mbedtls_mpi_uint z[P256_LIMBS],
+                      const mbedtls_mpi_uint a[P256_LIMBS],
+                      const mbedtls_mpi_uint b[P256_LIMBS] )
+{
+    mbedtls_mpi_uint t[P256_LIMBS], borrow = 0, b1, c = 0, mask, r;
+    size_t i;
+
+    for( i = 0; i < P256_LIMBS; i++ )
+    {
+        b1 = ( a[i] < b[i] );
+        t[i] = a[i] - b[i];
+        b1 |= ( t[i] < borrow );
+        t[i] -= borrow;
+        borrow = b1;
+    }
+
+    /* add p back if the subtraction borrowed */
+    mask = (mbedtls_mpi_uint) 0 - borrow;
+
+    for( i = 0; i < P256_LIMBS; i++ )
+    {
+        r = p256_p[i] & mask;
+        z[i] = t[i] + c;  c  = ( z[i] < c );
+        z[i] += r;        c += ( z[i] < r );
+    }
+}
+
+/*
+ * z = a * b / R mod p, coarsely integrated operand scanning [1]
+ *
+ * As p = -1 mod 2^biL, the Montgomery factor -p^-1 mod 2^biL is 1 and the
+ * multiple of p to add at each step is just the low limb of the sum.
+ * The result is less than 2p for a * b < R * p, which holds for any a < R
+ * when b < p: p256_from_mpi() relies on this.
+ */
+static void p256_mul( mbedtls_mpi_uint z[P256_LIMBS],
+                      const mbedtls_mpi_uint a[P256_LIMBS],
+                      const mbedtls_mpi_uint b[P256_LIMBS] )
+{
+    mbedtls_mpi_uint t[P256_LIMBS + 2], c, m;
+    size_t i, j;
+
+    memset( t, 0, sizeof( t ) );
+
+    for( i = 0; i < P256_LIMBS; i++ )
+    {
+        /* t += a * b[i] */
+        c = 0;
+        for( j = 0; j < P256_LIMBS; j++ )
+            t[j] = p256_mla( a[j], b[i], t[j], c, &c );
+        t[P256_LIMBS] += c;
+        t[P256_LIMBS + 1] = ( t[P256_LIMBS] < c );
+
+        /* t = ( t + m * p ) / 2^biL */
+        m = t[0];
+        (void) p256_mla( m, p256_p[0], t[0], 0, &c );
+        for( j = 1; j < P256_LIMBS; j++ )
+            t[j - 1] = p256_mla( m, p256_p[j], t[j], c, &c );
+        t[P256_LIMBS - 1] = t[P256_LIMBS] + c;
+        t[P256_LIMBS] = t[P256_LIMBS + 1] + ( t[P256_LIMBS - 1] < c );
+    }
+
+    p256_reduce_once( z, t, t[P256_LIMBS] );
+}
+
+/*
+ * z = a^(2^n) / R^(2^n - 1) mod p, i.e. n squarings
+ */
+static void p256_sqr_n( mbedtls_mpi_uint z[P256_LIMBS],
+                        const mbedtls_mpi_uint a[P256_LIMBS], unsigned n )
+{
+    p256_mul( z, a, a );
+    while( --n > 0 )
+        p256_mul( z, z, z );
+}
+
+/*
+ * z = 1 / a mod p = a^(p - 2) mod p, with a fixed addition chain [2]
+ * p - 2 = ffffffff 00000001 00000000 00000000
+ *         00000000 ffffffff ffffffff fffffffd
+ * x_k below stands for a^(2^k - 1). The inverse of zero is zero.
+ */
+static void p256_inv( mbedtls_mpi_uint z[P256_LIMBS],
+                      const mbedtls_mpi_uint a[P256_LIMBS] )
+{
+    mbedtls_mpi_uint x2[P256_LIMBS], x3[P256_LIMBS], x6[P256_LIMBS];
+    mbedtls_mpi_uint x12[P256_LIMBS], x15[P256_LIMBS], x30[P256_LIMBS];
+    mbedtls_mpi_uint x32[P256_LIMBS], t[P256_LIMBS];
+
+    p256_sqr_n( t, a, 1 );      p256_mul( x2, t, a );
+    p256_sqr_n( t, x2, 1 );     p256_mul( x3, t, a );
+    p256_sqr_n( t, x3, 3 );     p256_mul( x6, t, x3 );
+    p256_sqr_n( t, x6, 6 );     p256_mul( x12, t, x6 );
+    p256_sqr_n( t, x12, 3 );    p256_mul( x15, t, x3 );
+    p256_sqr_n( t, x15, 15 );   p256_mul( x30, t, x15 );
+    p256_sqr_n( t, x30, 2 );    p256_mul( x32, t, x2 );
+
+    p256_sqr_n( t, x32, 32 );   p256_mul( t, t, a );
+    p256_sqr_n( t, t, 128 );    p256_mul( t, t, x32 );
+    p256_sqr_n( t, t, 32 );     p256_mul( t, t, x32 );
+    p256_sqr_n( t, t, 30 );     p256_mul( t, t, x30 );
+    p256_sqr_n( t, t, 2 );      p256_mul( z, t, a );
+
+    mbedtls_platform_zeroize( x2, sizeof( x2 ) );
+    mbedtls_platform_zeroize( x3, sizeof( x3 ) );
+    mbedtls_platform_zeroize( x6, sizeof( x6 ) );
+    mbedtls_platform_zeroize( x12, sizeof( x12 ) );
+    mbedtls_platform_zeroize( x15, sizeof( x15 ) );
+    mbedtls_platform_zeroize( x30, sizeof( x30 ) );
+    mbedtls_platform_zeroize( x32, sizeof( x32 ) );
+    mbedtls_platform_zeroize( t, sizeof( t ) );
+}
+
+/*
+ * Non-zero if a == 0 mod p (zero is also zero in Montgomery representation)
+ */
+static int p256_is_zero( const mbedtls_mpi_uint a[P256_LIMBS] )
+{
+    mbedtls_mpi_uint acc = 0;
+    size_t i;
+
+    for( i = 0; i < P256_LIMBS; i++ )
+        acc |= a[i];
+
+    return( acc == 0 );
+}
+
+/*
+ * Load a coordinate, entering the Montgomery representation.
+ * The values in ecp.c are reduced mod p: the limbs above 256 bits are zero.
+ */
+static int p256_from_mpi( mbedtls_mpi_uint z[P256_LIMBS], const mbedtls_mpi *X )
+{
+    mbedtls_mpi_uint t[P256_LIMBS];
+    size_t i;
+
+    if( X->s < 0 )
+        return( MBEDTLS_ERR_ECP_BAD_INPUT_DATA );
+
+    for( i = 0; i < P256_LIMBS; i++ )
+        t[i] = i < X->n ? X->p[i] : 0;
+
+    for( ; i < X->n; i++ )
+        if( X->p[i] != 0 )
+            return( MBEDTLS_ERR_ECP_BAD_INPUT_DATA );
+
+    p256_mul( z, t, p256_rr );
+
+    return( 0 );
+}
+
+/*
+ * Store a coordinate, leaving the Montgomery representation
+ */
+static int p256_to_mpi( mbedtls_mpi *X, const mbedtls_mpi_uint a[P256_LIMBS] )
+{
+    int ret;
+
+    MBEDTLS_MPI_CHK( mbedtls_mpi_grow( X, P256_LIMBS ) );
+
+    p256_mul( X->p, a, p256_one );
+    memset( X->p + P256_LIMBS, 0, ( X->n - P256_LIMBS ) * ciL );
+    X->s = 1;
+
+cleanup:
+    return( ret );
+}
+
+static int p256_point_from_mpi( p256_point *R, const mbedtls_ecp_point *P )
+{
+    int ret;
+
+    MBEDTLS_MPI_CHK( p256_from_mpi( R->X, &P->X ) );
+    MBEDTLS_MPI_CHK( p256_from_mpi( R->Y, &P->Y ) );
+    MBEDTLS_MPI_CHK( p256_from_mpi( R->Z, &P->Z ) );
+
+cleanup:
+    return( ret );
+}
+
+static int p256_point_to_mpi( mbedtls_ecp_point *R, const p256_point *P )
+{
+    int ret;
+
+    MBEDTLS_MPI_CHK( p256_to_mpi( &R->X, P->X ) );
+    MBEDTLS_MPI_CHK( p256_to_mpi( &R->Y, P->Y ) );
+    MBEDTLS_MPI_CHK( p256_to_mpi( &R->Z, P->Z ) );
+
+cleanup:
+    return( ret );
+}
+
+/*
+ * Point doubling R = 2 P, same formula as ecp_double_jac() with A = -3.
+ * R and P may alias.
+ */
+static void p256_double( p256_point *R, const p256_point *P )
+{
+    mbedtls_mpi_uint M[P256_LIMBS], S[P256_LIMBS];
+    mbedtls_mpi_uint T[P256_LIMBS], U[P256_LIMBS];
+
+    /* M = 3(X + Z^2)(X - Z^2) */
+    p256_mul( S, P->Z, P->Z );
+    p256_add( T, P->X, S );
+    p256_sub( U, P->X, S );
+    p256_mul( S, T, U );
+    p256_add( M, S, S );
+    p256_add( M, M, S );
+
+    /* S = 4.X.Y^2 */
+    p256_mul( T, P->Y, P->Y );
+    p256_add( T, T, T );
+    p256_mul( S, P->X, T );
+    p256_add( S, S, S );
+
+    /* U = 8.Y^4 */
+    p256_mul( U, T, T );
+    p256_add( U, U, U );
+
+    /* Z = 2.Y.Z, before the other coordinates are overwritten */
+    p256_mul( R->Z, P->Y, P->Z );
+    p256_add( R->Z, R->Z, R->Z );
+
+    /* X = M^2 - 2.S */
+    p256_mul( T, M, M );
+    p256_sub( T, T, S );
+    p256_sub( R->X, T, S );
+
+    /* Y = M(S - X) - U */
+    p256_sub( S, S, R->X );
+    p256_mul( S, S, M );
+    p256_sub( R->Y, S, U );
+
+    mbedtls_platform_zeroize( M, sizeof( M ) );
+    mbedtls_platform_zeroize( S, sizeof( S ) );
+    mbedtls_platform_zeroize( T, sizeof( T ) );
+    mbedtls_platform_zeroize( U, sizeof( U ) );
+}
+
+unsigned char mbedtls_internal_ecp_grp_capable( const mbedtls_ecp_group *grp )
+{
+    return( grp->id == MBEDTLS_ECP_DP_SECP256R1 );
+}
+
+int mbedtls_internal_ecp_init( const mbedtls_ecp_group *grp )
+{
+    (void) grp;
+    return( 0 );
+}
+
+void mbedtls_internal_ecp_free( const mbedtls_ecp_group *grp )
+{
+    (void) grp;
+}
+
+/*
+ * Point doubling R = 2 P, Jacobian coordinates
+ */
+int mbedtls_internal_ecp_double_jac( const mbedtls_ecp_group *grp,
+        mbedtls_ecp_point *R, const mbedtls_ecp_point *P )
+{
+    int ret;
+    p256_point T;
+
+    (void) grp;
+
+    MBEDTLS_MPI_CHK( p256_point_from_mpi( &T, P ) );
+    p256_double( &T, &T );
+    MBEDTLS_MPI_CHK( p256_point_to_mpi( R, &T ) );
+
+cleanup:
+    mbedtls_platform_zeroize( &T, sizeof( T ) );
+
+    return( ret );
+}
+
+/*
+ * Addition: R = P + Q, mixed affine-Jacobian coordinates, same formula and
+ * special cases as ecp_add_mixed()
+ */
+int mbedtls_internal_ecp_add_mixed( const mbedtls_ecp_group *grp,
+        mbedtls_ecp_point *R, const mbedtls_ecp_point *P,
+        const mbedtls_ecp_point *Q )
+{
+    int ret;
+    p256_point A;
+    mbedtls_mpi_uint QX[P256_LIMBS], QY[P256_LIMBS];
+    mbedtls_mpi_uint T1[P256_LIMBS], T2[P256_LIMBS];
+    mbedtls_mpi_uint T3[P256_LIMBS], T4[P256_LIMBS];
+
+    (void) grp;
+
+    /*
+     * Trivial cases: P == 0 or Q == 0
+     */
+    if( mbedtls_mpi_cmp_int( &P->Z, 0 ) == 0 )
+        return( mbedtls_ecp_copy( R, Q ) );
+
+    if( Q->Z.p != NULL && mbedtls_mpi_cmp_int( &Q->Z, 0 ) == 0 )
+        return( mbedtls_ecp_copy( R, P ) );
+
+    /*
+     * Make sure Q coordinates are normalized
+     */
+    if( Q->Z.p != NULL && mbedtls_mpi_cmp_int( &Q->Z, 1 ) != 0 )
+        return( MBEDTLS_ERR_ECP_BAD_INPUT_DATA );
+
+    /* Load everything before writing R, which may alias P or Q */
+    MBEDTLS_MPI_CHK( p256_point_from_mpi( &A, P ) );
+    MBEDTLS_MPI_CHK( p256_from_mpi( QX, &Q->X ) );
+    MBEDTLS_MPI_CHK( p256_from_mpi( QY, &Q->Y ) );
+
+    p256_mul( T1, A.Z, A.Z );
+    p256_mul( T2, T1, A.Z );
+    p256_mul( T1, T1, QX );
+    p256_mul( T2, T2, QY );
+    p256_sub( T1, T1, A.X );
+    p256_sub( T2, T2, A.Y );
+
+    /* Special cases: P == Q or R == 0 */
+    if( p256_is_zero( T1 ) )
+    {
+        if( p256_is_zero( T2 ) )
+        {
+            p256_double( &A, &A );
+            ret = p256_point_to_mpi( R, &A );
+        }
+        else
+            ret = mbedtls_ecp_set_zero( R );
+
+        goto cleanup;
+    }
+
+    p256_mul( A.Z, A.Z, T1 );
+    p256_mul( T3, T1, T1 );
+    p256_mul( T4, T3, T1 );
+    p256_mul( T3, T3, A.X );
+    p256_add( T1, T3, T3 );
+    p256_mul( A.X, T2, T2 );
+    p256_sub( A.X, A.X, T1 );
+    p256_sub( A.X, A.X, T4 );
+    p256_sub( T3, T3, A.X );
+    p256_mul( T3, T3, T2 );
+    p256_mul( T4, T4, A.Y );
+    p256_sub( A.Y, T3, T4 );
+
+    MBEDTLS_MPI_CHK( p256_point_to_mpi( R, &A ) );
+
+cleanup:
+    mbedtls_platform_zeroize( &A, sizeof( A ) );
+    mbedtls_platform_zeroize( QX, sizeof( QX ) );
+    mbedtls_platform_zeroize( QY, sizeof( QY ) );
+    mbedtls_platform_zeroize( T1, sizeof( T1 ) );
+    mbedtls_platform_zeroize( T2, sizeof( T2 ) );
+    mbedtls_platform_zeroize( T3, sizeof( T3 ) );
+    mbedtls_platform_zeroize( T4, sizeof( T4 ) );
+
+    return( ret );
+}
+
+/*
+ * Normalize jacobian coordinates so that Z == 1, Z being non-zero
+ */
+int mbedtls_internal_ecp_normalize_jac( const mbedtls_ecp_group *grp,
+        mbedtls_ecp_point *pt )
+{
+    int ret;
+    p256_point A;
+    mbedtls_mpi_uint Zi[P256_LIMBS], ZZi[P256_LIMBS];
+
+    (void) grp;
+
+    MBEDTLS_MPI_CHK( p256_point_from_mpi( &A, pt ) );
+
+    p256_inv( Zi, A.Z );
+    p256_mul( ZZi, Zi, Zi );
+    p256_mul( A.X, A.X, ZZi );
+    p256_mul( A.Y, A.Y, ZZi );
+    p256_mul( A.Y, A.Y, Zi );
+
+    MBEDTLS_MPI_CHK( p256_to_mpi( &pt->X, A.X ) );
+    MBEDTLS_MPI_CHK( p256_to_mpi( &pt->Y, A.Y ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_lset( &pt->Z, 1 ) );
+
+cleanup:
+    mbedtls_platform_zeroize( &A, sizeof( A ) );
+    mbedtls_platform_zeroize( Zi, sizeof( Zi ) );
+    mbedtls_platform_zeroize( ZZi, sizeof( ZZi ) );
+
+    return( ret );
+}
+
+/*
+ * Normalize jacobian coordinates of up to P256_MAX_BATCH points with one
+ * inversion (Montgomery's trick, as ecp_normalize_jac_many()), keeping the
+ * partial products on the stack
+ */
+static int p256_normalize_batch( mbedtls_ecp_point *T[], size_t t_len )
+{
+    int ret = 0;
+    size_t i;
+    mbedtls_mpi_uint c[P256_MAX_BATCH][P256_LIMBS];
+    mbedtls_mpi_uint u[P256_LIMBS], Z[P256_LIMBS];
+    mbedtls_mpi_uint Zi[P256_LIMBS], ZZi[P256_LIMBS];
+    mbedtls_mpi_uint X[P256_LIMBS], Y[P256_LIMBS];
+
+    /*
+     * c[i] = Z_0 * ... * Z_i
+     */
+    MBEDTLS_MPI_CHK( p256_from_mpi( c[0], &T[0]->Z ) );
+    for( i = 1; i < t_len; i++ )
+    {
+        MBEDTLS_MPI_CHK( p256_from_mpi( Z, &T[i]->Z ) );
+        p256_mul( c[i], c[i-1], Z );
+    }
+
+    /* Same error as mbedtls_mpi_inv_mod() if one of the points is zero */
+    if( p256_is_zero( c[t_len - 1] ) )
+    {
+        ret = MBEDTLS_ERR_MPI_NOT_ACCEPTABLE;
+        goto cleanup;
+    }
+
+    /*
+     * u = 1 / (Z_0 * ... * Z_n) mod P
+     */
+    p256_inv( u, c[t_len - 1] );
+
+    for( i = t_len - 1; ; i-- )
+    {
+        /*
+         * Zi = 1 / Z_i mod p
+         * u = 1 / (Z_0 * ... * Z_i) mod P
+         */
+        if( i == 0 )
+            memcpy( Zi, u, sizeof( Zi ) );
+        else
+        {
+            MBEDTLS_MPI_CHK( p256_from_mpi( Z, &T[i]->Z ) );
+            p256_mul( Zi, u, c[i-1] );
+            p256_mul( u, u, Z );
+        }
+
+        MBEDTLS_MPI_CHK( p256_from_mpi( X, &T[i]->X ) );
+        MBEDTLS_MPI_CHK( p256_from_mpi( Y, &T[i]->Y ) );
+
+        p256_mul( ZZi, Zi, Zi );
+        p256_mul( X, X, ZZi );
+        p256_mul( Y, Y, ZZi );
+        p256_mul( Y, Y, Zi );
+
+        /* As ecp_normalize_jac_many(), do not store Z (always 1) */
+        MBEDTLS_MPI_CHK( p256_to_mpi( &T[i]->X, X ) );
+        MBEDTLS_MPI_CHK( p256_to_mpi( &T[i]->Y, Y ) );
+        mbedtls_mpi_free( &T[i]->Z );
+
+        if( i == 0 )
+            break;
+    }
+
+cleanup:
+    mbedtls_platform_zeroize( c, sizeof( c ) );
+    mbedtls_platform_zeroize( u, sizeof( u ) );
+    mbedtls_platform_zeroize( Z, sizeof( Z ) );
+    mbedtls_platform_zeroize( Zi, sizeof( Zi ) );
+    mbedtls_platform_zeroize( ZZi, sizeof( ZZi ) );
+    mbedtls_platform_zeroize( X, sizeof( X ) );
+    mbedtls_platform_zeroize( Y, sizeof( Y ) );
+
+    return( ret );
+}
+
+/*
+ * Normalize jacobian coordinates of an array of (pointers to) points
+ */
+int mbedtls_internal_ecp_normalize_jac_many( const mbedtls_ecp_group *grp,
+        mbedtls_ecp_point *T[], size_t t_len )
+{
+    int ret = 0;
+    size_t n;
+
+    (void) grp;
+
+    while( t_len > 0 )
+    {
+        n = t_len < P256_MAX_BATCH ? t_len : P256_MAX_BATCH;
+
+        MBEDTLS_MPI_CHK( p256_normalize_batch( T, n ) );
+
+        T += n;
+        t_len -= n;
+    }
+
+cleanup:
+    return( ret );
+}
+
+#endif /* MBEDTLS_ECP_P256_FIXED_LIMBS */
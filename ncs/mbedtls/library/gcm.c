@@ -46,6 +46,14 @@
 #include "mbedtls/aesni.h"
 #endif
 
+/*
+ * AES-GCM in chunks of 8 blocks with the AES-NI and CLMUL kernels
+ */
+#if defined(MBEDTLS_AESNI_C) && defined(MBEDTLS_HAVE_X86_64) && \
+    !defined(MBEDTLS_AES_ALT)
+#define MBEDTLS_GCM_AESNI_CHUNKS
+#endif
+
 #if defined(MBEDTLS_SELF_TEST) && defined(MBEDTLS_AES_C)
 #include "mbedtls/aes.h"
 #include "mbedtls/platform.h"
@@ -129,9 +137,13 @@ static int gcm_gen_table( mbedtls_gcm_context *ctx )
     ctx->HH[8] = vh;
 
 #if defined(MBEDTLS_AESNI_C) && defined(MBEDTLS_HAVE_X86_64)
-    /* With CLMUL support, we need only h, not the rest of the table */
+    /* With CLMUL support, we need only h, not the rest of the table.
+     * HL[0..7] holds the powers of h for mbedtls_aesni_gcm_ghash() instead. */
     if( mbedtls_aesni_has_support( MBEDTLS_AESNI_CLMUL ) )
+    {
+        mbedtls_aesni_gcm_hpow( (unsigned char *) ctx->HL, h );
         return( 0 );
+    }
 #endif
 
     /* 0 corresponds to 0 in GF(2^128) */
@@ -389,6 +401,46 @@ int mbedtls_gcm_update( mbedtls_gcm_context *ctx,
     ctx->len += length;
 
     p = input;
+
+#if defined(MBEDTLS_GCM_AESNI_CHUNKS)
+    if( length >= 128 &&
+        ( ctx->cipher_ctx.cipher_info->type == MBEDTLS_CIPHER_AES_128_ECB ||
+          ctx->cipher_ctx.cipher_info->type == MBEDTLS_CIPHER_AES_192_ECB ||
+          ctx->cipher_ctx.cipher_info->type == MBEDTLS_CIPHER_AES_256_ECB ) &&
+        mbedtls_aesni_has_support( MBEDTLS_AESNI_AES ) &&
+        mbedtls_aesni_has_support( MBEDTLS_AESNI_CLMUL ) )
+    {
+        unsigned char counters[128];
+        const unsigned char *hpow = (const unsigned char *) ctx->HL;
+        size_t j;
+
+        while( length >= 128 )
+        {
+            for( j = 0; j < 128; j += 16 )
+            {
+                for( i = 16; i > 12; i-- )
+                    if( ++ctx->y[i - 1] != 0 )
+                        break;
+
+                memcpy( counters + j, ctx->y, 16 );
+            }
+
+            if( ctx->mode == MBEDTLS_GCM_DECRYPT )
+                mbedtls_aesni_gcm_ghash( ctx->buf, hpow, p, 8 );
+
+            mbedtls_aesni_crypt_ctr8( ctx->cipher_ctx.cipher_ctx,
+                                      counters, p, out_p );
+
+            if( ctx->mode == MBEDTLS_GCM_ENCRYPT )
+                mbedtls_aesni_gcm_ghash( ctx->buf, hpow, out_p, 8 );
+
+            length -= 128;
+            p += 128;
+            out_p += 128;
+        }
+    }
+#endif /* MBEDTLS_GCM_AESNI_CHUNKS */
+
     while( length > 0 )
     {
         use_len = ( length < 16 ) ? length : 16;
@@ -45,6 +45,7 @@
 
 #define MAGIC1       0xFF00AA55
 #define MAGIC2       0xEE119966
+#define MAGIC_SLAB   0xDD5522AA
 #define MAX_BT 20
 
 typedef struct _memory_header memory_header;
@@ -64,6 +65,74 @@ struct _memory_header
     size_t          magic2;
 };
 
+#if defined(MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB)
+#if defined(MBEDTLS_THREADING_PTHREAD)
+#define MEMORY_SLAB_THREAD_CACHE
+#endif
+
+#define SLAB_CLASSES        8
+#define SLAB_MAX_OBJECT     256
+
+/* Objects a thread caches before it gives half of them back to the slabs */
+#define SLAB_CACHE_MAX      16
+
+#define SLAB_ALIGN( len )                                               \
+    ( ( ( len ) + MBEDTLS_MEMORY_ALIGN_MULTIPLE - 1 ) /                 \
+      MBEDTLS_MEMORY_ALIGN_MULTIPLE * MBEDTLS_MEMORY_ALIGN_MULTIPLE )
+
+/*
+ * Each object of a slab is preceded by a tag word holding the offset of
+ * the tag in the slab, the state of the object and its size class. The
+ * state byte never matches the one of MAGIC2, which ends the headers of
+ * the blocks.
+ */
+#define SLAB_TAG_ALLOC      0xA5
+#define SLAB_TAG_FREE       0x5A
+
+#define SLAB_TAG( offset, state, idx )                                  \
+    ( ( (size_t) ( offset ) << 16 ) | ( (size_t) ( state ) << 8 ) | ( idx ) )
+#define SLAB_TAG_SET( tag, state )                                      \
+    ( ( ( tag ) & ~(size_t) 0xFF00 ) | ( (size_t) ( state ) << 8 ) )
+#define SLAB_TAG_OFFSET( tag )  ( ( tag ) >> 16 )
+#define SLAB_TAG_STATE( tag )   ( ( ( tag ) >> 8 ) & 0xFF )
+#define SLAB_TAG_CLASS( tag )   ( ( tag ) & 0xFF )
+#define SLAB_TAG_PTR( p )                                               \
+    ( (size_t *) ( (unsigned char *) ( p ) - sizeof( size_t ) ) )
+
+#define SLAB_HDR            SLAB_ALIGN( sizeof( memory_slab ) )
+#define SLAB_OBJECT_HDR     SLAB_ALIGN( sizeof( size_t ) )
+#define SLAB_STRIDE( idx )  SLAB_ALIGN( SLAB_OBJECT_HDR + slab_class_size[idx] )
+
+typedef struct _memory_slab memory_slab;
+struct _memory_slab
+{
+    size_t          magic;
+    memory_slab     *prev;      /* slabs of the class with free objects */
+    memory_slab     *next;
+    unsigned char   *free;      /* linked through their first word      */
+    size_t          used;       /* including objects in thread caches   */
+    size_t          carved;     /* objects handed out at least once     */
+    size_t          capacity;
+    size_t          idx;
+};
+
+static const size_t slab_class_size[SLAB_CLASSES] =
+    { 16, 32, 48, 64, 96, 128, 192, 256 };
+
+/* Size class of a request of len bytes, indexed by ( len - 1 ) / 16 */
+static const unsigned char slab_class_of[SLAB_MAX_OBJECT / 16] =
+    { 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7 };
+
+#if defined(MEMORY_SLAB_THREAD_CACHE)
+typedef struct
+{
+    unsigned char   *objects[SLAB_CLASSES];
+    size_t          count[SLAB_CLASSES];
+}
+memory_slab_cache;
+#endif
+#endif /* MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB */
+
 typedef struct
 {
     unsigned char   *buf;
@@ -82,11 +151,26 @@ typedef struct
 #if defined(MBEDTLS_THREADING_C)
     mbedtls_threading_mutex_t   mutex;
 #endif
+#if defined(MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB)
+    memory_slab     *slabs[SLAB_CLASSES];
+#if defined(MBEDTLS_MEMORY_DEBUG)
+    size_t          slab_count[SLAB_CLASSES];
+    size_t          slab_used[SLAB_CLASSES];
+#endif
+#if defined(MEMORY_SLAB_THREAD_CACHE)
+    pthread_key_t   cache_key;
+    int             cache_key_set;
+#endif
+#endif
 }
 buffer_alloc_ctx;
 
 static buffer_alloc_ctx heap;
 
+#if defined(MEMORY_SLAB_THREAD_CACHE)
+static void slab_cache_drop_current( void );
+#endif
+
 #if defined(MBEDTLS_MEMORY_DEBUG)
 static void debug_header( memory_header *hdr )
 {
@@ -508,6 +592,11 @@ int mbedtls_memory_buffer_alloc_verify( void )
 #if defined(MBEDTLS_MEMORY_DEBUG)
 void mbedtls_memory_buffer_alloc_status( void )
 {
+#if defined(MEMORY_SLAB_THREAD_CACHE)
+    /* Objects cached by the other threads are still reported as used */
+    slab_cache_drop_current();
+#endif
+
     mbedtls_fprintf( stderr,
                       "Current use: %zu blocks / %zu bytes, max: %zu blocks / "
                       "%zu bytes (total %zu bytes), alloc / free: %zu / %zu\n",
@@ -517,6 +606,23 @@ void mbedtls_memory_buffer_alloc_status( void )
                       + heap.maximum_used,
                       heap.alloc_count, heap.free_count );
 
+#if defined(MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB)
+    {
+        size_t idx;
+
+        for( idx = 0; idx < SLAB_CLASSES; idx++ )
+        {
+            if( heap.slab_count[idx] == 0 )
+                continue;
+
+            mbedtls_fprintf( stderr, "Slabs of %3zu bytes: %zu slabs, "
+                              "%zu objects in use or cached\n",
+                              slab_class_size[idx], heap.slab_count[idx],
+                              heap.slab_used[idx] );
+        }
+    }
+#endif
+
     if( heap.first->next == NULL )
     {
         mbedtls_fprintf( stderr, "All memory de-allocated in stack buffer\n" );
@@ -570,12 +676,377 @@ static void buffer_alloc_free_mutexed( void *ptr )
 }
 #endif /* MBEDTLS_THREADING_C */
 
+#if defined(MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB)
+#if defined(MBEDTLS_THREADING_C)
+#define buffer_alloc_calloc_block   buffer_alloc_calloc_mutexed
+#define buffer_alloc_free_block     buffer_alloc_free_mutexed
+#else
+#define buffer_alloc_calloc_block   buffer_alloc_calloc
+#define buffer_alloc_free_block     buffer_alloc_free
+#endif
+
+static int slab_verify( unsigned char *p, size_t tag )
+{
+    memory_slab *slab;
+
+    if( SLAB_TAG_STATE( tag ) == SLAB_TAG_FREE )
+    {
+#if defined(MBEDTLS_MEMORY_DEBUG)
+        mbedtls_fprintf( stderr, "FATAL: mbedtls_free() on unallocated "
+                                  "data\n" );
+#endif
+        return( 1 );
+    }
+
+    if( SLAB_TAG_STATE( tag ) != SLAB_TAG_ALLOC ||
+        SLAB_TAG_CLASS( tag ) >= SLAB_CLASSES ||
+        SLAB_TAG_OFFSET( tag ) >= MBEDTLS_MEMORY_SLAB_SIZE ||
+        (size_t)( p - heap.buf ) < SLAB_TAG_OFFSET( tag ) + sizeof( size_t ) )
+    {
+#if defined(MBEDTLS_MEMORY_DEBUG)
+        mbedtls_fprintf( stderr, "FATAL: slab tag has illegal value\n" );
+#endif
+        return( 1 );
+    }
+
+    slab = (memory_slab *) ( (unsigned char *) SLAB_TAG_PTR( p )
+                             - SLAB_TAG_OFFSET( tag ) );
+
+    if( slab->magic != MAGIC_SLAB || slab->idx != SLAB_TAG_CLASS( tag ) )
+    {
+#if defined(MBEDTLS_MEMORY_DEBUG)
+        mbedtls_fprintf( stderr, "FATAL: MAGIC_SLAB mismatch\n" );
+#endif
+        return( 1 );
+    }
+
+    return( 0 );
+}
+
+/*
+ * Take an object of class idx from the first slab with free objects,
+ * carving a new slab out of the buffer if there is none.
+ * Called with the heap mutex held.
+ */
+static unsigned char *slab_get( size_t idx )
+{
+    memory_slab *slab = heap.slabs[idx];
+    size_t stride = SLAB_STRIDE( idx );
+    unsigned char *p;
+
+    if( slab == NULL )
+    {
+        slab = buffer_alloc_calloc( 1, MBEDTLS_MEMORY_SLAB_SIZE );
+        if( slab == NULL )
+            return( NULL );
+
+        slab->magic = MAGIC_SLAB;
+        slab->capacity = ( MBEDTLS_MEMORY_SLAB_SIZE - SLAB_HDR ) / stride;
+        slab->idx = idx;
+        heap.slabs[idx] = slab;
+#if defined(MBEDTLS_MEMORY_DEBUG)
+        heap.slab_count[idx]++;
+#endif
+    }
+
+    if( slab->free != NULL )
+    {
+        p = slab->free;
+        slab->free = *(unsigned char **) p;
+    }
+    else
+    {
+        p = (unsigned char *) slab + SLAB_HDR + slab->carved * stride
+            + SLAB_OBJECT_HDR;
+        slab->carved++;
+    }
+
+    *SLAB_TAG_PTR( p ) = SLAB_TAG( (unsigned char *) SLAB_TAG_PTR( p )
+                                   - (unsigned char *) slab,
+                                   SLAB_TAG_ALLOC, idx );
+
+    // Full slabs leave the list until one of their objects comes back
+    //
+    if( ++slab->used == slab->capacity )
+    {
+        heap.slabs[idx] = slab->next;
+        if( slab->next != NULL )
+            slab->next->prev = NULL;
+        slab->next = NULL;
+    }
+
+#if defined(MBEDTLS_MEMORY_DEBUG)
+    heap.slab_used[idx]++;
+#endif
+
+    return( p );
+}
+
+/*
+ * Give an object back to its slab, and the slab back to the buffer once
+ * empty unless it is the last one of its class.
+ * Called with the heap mutex held.
+ */
+static void slab_put( unsigned char *p )
+{
+    size_t tag = *SLAB_TAG_PTR( p );
+    size_t idx = SLAB_TAG_CLASS( tag );
+    memory_slab *slab = (memory_slab *) ( (unsigned char *) SLAB_TAG_PTR( p )
+                                          - SLAB_TAG_OFFSET( tag ) );
+
+    *SLAB_TAG_PTR( p ) = SLAB_TAG_SET( tag, SLAB_TAG_FREE );
+    *(unsigned char **) p = slab->free;
+    slab->free = p;
+
+    if( slab->used-- == slab->capacity )
+    {
+        slab->prev = NULL;
+        slab->next = heap.slabs[idx];
+        if( slab->next != NULL )
+            slab->next->prev = slab;
+        heap.slabs[idx] = slab;
+    }
+
+#if defined(MBEDTLS_MEMORY_DEBUG)
+    heap.slab_used[idx]--;
+#endif
+
+    if( slab->used != 0 || ( slab->prev == NULL && slab->next == NULL ) )
+        return;
+
+    if( slab->prev != NULL )
+        slab->prev->next = slab->next;
+    else
+        heap.slabs[idx] = slab->next;
+
+    if( slab->next != NULL )
+        slab->next->prev = slab->prev;
+
+    slab->magic = 0;
+    buffer_alloc_free( slab );
+#if defined(MBEDTLS_MEMORY_DEBUG)
+    heap.slab_count[idx]--;
+#endif
+}
+
+#if defined(MEMORY_SLAB_THREAD_CACHE)
+static void slab_cache_push( memory_slab_cache *cache, unsigned char *p )
+{
+    size_t tag = *SLAB_TAG_PTR( p );
+    size_t idx = SLAB_TAG_CLASS( tag );
+
+    *SLAB_TAG_PTR( p ) = SLAB_TAG_SET( tag, SLAB_TAG_FREE );
+    *(unsigned char **) p = cache->objects[idx];
+    cache->objects[idx] = p;
+    cache->count[idx]++;
+}
+
+static unsigned char *slab_cache_pop( memory_slab_cache *cache, size_t idx )
+{
+    unsigned char *p = cache->objects[idx];
+
+    if( p != NULL )
+    {
+        cache->objects[idx] = *(unsigned char **) p;
+        cache->count[idx]--;
+    }
+
+    return( p );
+}
+
+/*
+ * Called with the heap mutex held
+ */
+static void slab_cache_flush( memory_slab_cache *cache, size_t idx,
+                              size_t keep )
+{
+    while( cache->count[idx] > keep )
+        slab_put( slab_cache_pop( cache, idx ) );
+}
+
+/*
+ * Destructor of the thread caches, called when their thread exits
+ */
+static void slab_cache_release( void *data )
+{
+    memory_slab_cache *cache = (memory_slab_cache *) data;
+    size_t idx;
+
+    if( mbedtls_mutex_lock( &heap.mutex ) != 0 )
+        return;
+
+    for( idx = 0; idx < SLAB_CLASSES; idx++ )
+        slab_cache_flush( cache, idx, 0 );
+
+    buffer_alloc_free( cache );
+    (void) mbedtls_mutex_unlock( &heap.mutex );
+}
+
+/*
+ * Release the cache of the calling thread, which gets a new one with its
+ * next object from a slab
+ */
+static void slab_cache_drop_current( void )
+{
+    memory_slab_cache *cache;
+
+    if( !heap.cache_key_set )
+        return;
+
+    cache = (memory_slab_cache *) pthread_getspecific( heap.cache_key );
+    if( cache == NULL )
+        return;
+
+    (void) pthread_setspecific( heap.cache_key, NULL );
+    slab_cache_release( cache );
+}
+#endif /* MEMORY_SLAB_THREAD_CACHE */
+
+static void *buffer_alloc_calloc_slab( size_t n, size_t size )
+{
+    unsigned char *p = NULL;
+    size_t len = n * size, idx;
+#if defined(MEMORY_SLAB_THREAD_CACHE)
+    memory_slab_cache *cache = NULL;
+    unsigned char *q;
+#endif
+
+    if( heap.buf == NULL || heap.first == NULL )
+        return( NULL );
+
+    if( n == 0 || size == 0 || len / n != size || len > SLAB_MAX_OBJECT )
+        return( buffer_alloc_calloc_block( n, size ) );
+
+    idx = slab_class_of[( len - 1 ) / 16];
+
+#if defined(MEMORY_SLAB_THREAD_CACHE)
+    if( heap.cache_key_set )
+        cache = (memory_slab_cache *) pthread_getspecific( heap.cache_key );
+
+    if( cache != NULL )
+        p = slab_cache_pop( cache, idx );
+#endif
+
+    if( p == NULL )
+    {
+#if defined(MBEDTLS_THREADING_C)
+        if( mbedtls_mutex_lock( &heap.mutex ) != 0 )
+            return( NULL );
+#endif
+
+        p = slab_get( idx );
+
+#if defined(MEMORY_SLAB_THREAD_CACHE)
+        // The thread gets its cache with its first object from a slab, so
+        // that buffers too small for slabs are left alone
+        //
+        if( p != NULL && cache == NULL && heap.cache_key_set )
+        {
+            cache = buffer_alloc_calloc( 1, sizeof( memory_slab_cache ) );
+            if( cache != NULL &&
+                pthread_setspecific( heap.cache_key, cache ) != 0 )
+            {
+                buffer_alloc_free( cache );
+                cache = NULL;
+            }
+        }
+
+        while( p != NULL && cache != NULL &&
+               cache->count[idx] < SLAB_CACHE_MAX / 2 &&
+               ( q = slab_get( idx ) ) != NULL )
+        {
+            slab_cache_push( cache, q );
+        }
+#endif
+
+#if defined(MBEDTLS_THREADING_C)
+        if( mbedtls_mutex_unlock( &heap.mutex ) )
+            return( NULL );
+#endif
+
+        // No room left for a slab, try the blocks
+        //
+        if( p == NULL )
+            return( buffer_alloc_calloc_block( n, size ) );
+    }
+
+    *SLAB_TAG_PTR( p ) = SLAB_TAG_SET( *SLAB_TAG_PTR( p ), SLAB_TAG_ALLOC );
+    memset( p, 0, len );
+
+    return( p );
+}
+
+static void buffer_alloc_free_slab( void *ptr )
+{
+    unsigned char *p = (unsigned char *) ptr;
+    size_t tag;
+#if defined(MEMORY_SLAB_THREAD_CACHE)
+    memory_slab_cache *cache = NULL;
+    size_t idx;
+#endif
+
+    if( ptr == NULL || heap.buf == NULL || heap.first == NULL )
+        return;
+
+    // Blocks and pointers outside of the managed space
+    //
+    if( p < heap.buf + sizeof( memory_header ) || p >= heap.buf + heap.len ||
+        ( tag = *SLAB_TAG_PTR( p ) ) == MAGIC2 )
+    {
+        buffer_alloc_free_block( ptr );
+        return;
+    }
+
+    if( slab_verify( p, tag ) != 0 )
+        mbedtls_exit( 1 );
+
+#if defined(MEMORY_SLAB_THREAD_CACHE)
+    if( heap.cache_key_set )
+        cache = (memory_slab_cache *) pthread_getspecific( heap.cache_key );
+
+    if( cache != NULL )
+    {
+        idx = SLAB_TAG_CLASS( tag );
+        slab_cache_push( cache, p );
+
+        if( cache->count[idx] <= SLAB_CACHE_MAX )
+            return;
+
+        if( mbedtls_mutex_lock( &heap.mutex ) != 0 )
+            return;
+        slab_cache_flush( cache, idx, SLAB_CACHE_MAX / 2 );
+        (void) mbedtls_mutex_unlock( &heap.mutex );
+        return;
+    }
+#endif
+
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_lock( &heap.mutex ) )
+        return;
+#endif
+    slab_put( p );
+#if defined(MBEDTLS_THREADING_C)
+    (void) mbedtls_mutex_unlock( &heap.mutex );
+#endif
+}
+#endif /* MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB */
+
 void mbedtls_memory_buffer_alloc_init( unsigned char *buf, size_t len )
 {
     memset( &heap, 0, sizeof( buffer_alloc_ctx ) );
 
 #if defined(MBEDTLS_THREADING_C)
     mbedtls_mutex_init( &heap.mutex );
+#endif
+
+#if defined(MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB)
+#if defined(MEMORY_SLAB_THREAD_CACHE)
+    heap.cache_key_set = ( pthread_key_create( &heap.cache_key,
+                                               slab_cache_release ) == 0 );
+#endif
+    mbedtls_platform_set_calloc_free( buffer_alloc_calloc_slab,
+                                      buffer_alloc_free_slab );
+#elif defined(MBEDTLS_THREADING_C)
     mbedtls_platform_set_calloc_free( buffer_alloc_calloc_mutexed,
                               buffer_alloc_free_mutexed );
 #else
@@ -607,6 +1078,13 @@ void mbedtls_memory_buffer_alloc_init( unsigned char *buf, size_t len )
 
 void mbedtls_memory_buffer_alloc_free( void )
 {
+#if defined(MEMORY_SLAB_THREAD_CACHE)
+    if( heap.cache_key_set )
+    {
+        slab_cache_drop_current();
+        (void) pthread_key_delete( heap.cache_key );
+    }
+#endif
 #if defined(MBEDTLS_THREADING_C)
     mbedtls_mutex_free( &heap.mutex );
 #endif
@@ -654,6 +1132,9 @@ int mbedtls_memory_buffer_alloc_self_test( int verbose )
 {
     unsigned char buf[1024];
     unsigned char *p, *q, *r, *end;
+#if defined(MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB)
+    static unsigned char slab_buf[2 * MBEDTLS_MEMORY_SLAB_SIZE];
+#endif
     int ret = 0;
 
     if( verbose != 0 )
@@ -740,6 +1221,35 @@ int mbedtls_memory_buffer_alloc_self_test( int verbose )
     if( verbose != 0 )
         mbedtls_printf( "passed\n" );
 
+#if defined(MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB)
+    if( verbose != 0 )
+        mbedtls_printf( "  MBA test #4 (slab reuse): " );
+
+    mbedtls_memory_buffer_alloc_init( slab_buf, sizeof( slab_buf ) );
+
+    p = mbedtls_calloc( 1, 40 );
+    q = mbedtls_calloc( 1, SLAB_MAX_OBJECT + 1 );
+
+    TEST_ASSERT( check_pointer( p ) == 0 && check_pointer( q ) == 0 );
+    TEST_ASSERT( SLAB_TAG_STATE( *SLAB_TAG_PTR( p ) ) == SLAB_TAG_ALLOC &&
+                 *SLAB_TAG_PTR( q ) == MAGIC2 );
+
+    memset( p, 0xFF, 40 );
+    mbedtls_free( p );
+
+    r = mbedtls_calloc( 1, 33 );
+
+    TEST_ASSERT( r == p && r[0] == 0 && r[32] == 0 );
+
+    mbedtls_free( r );
+    mbedtls_free( q );
+
+    mbedtls_memory_buffer_alloc_free( );
+
+    if( verbose != 0 )
+        mbedtls_printf( "passed\n" );
+#endif /* MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB */
+
 cleanup:
     mbedtls_memory_buffer_alloc_free( );
 
@@ -91,6 +91,23 @@ static inline uint64_t mul64( uint32_t a, uint32_t b )
 }
 #endif
 
+/*
+ * On 64-bit platforms with a 64x64 -> 128 multiplier, use three limbs of 44,
+ * 44 and 42 bits instead: a block takes 9 multiplications instead of 20.
+ */
+#if !defined(MBEDTLS_NO_64BIT_MULTIPLICATION) && defined(__GNUC__) && \
+    defined(__SIZEOF_INT128__) && __SIZEOF_INT128__ == 16
+#define POLY1305_64BIT_LIMBS
+typedef unsigned int poly1305_uint128 __attribute__((mode(TI)));
+
+#define POLY1305_MASK44 ( 0xFFFFFFFFFFFULL )
+#define POLY1305_MASK42 ( 0x3FFFFFFFFFFULL )
+
+#define BYTES_TO_U64_LE( data, offset )                                 \
+    ( (uint64_t) BYTES_TO_U32_LE( data, offset )                        \
+          | (uint64_t) BYTES_TO_U32_LE( data, ( offset ) + 4 ) << 32 )
+#endif /* POLY1305_64BIT_LIMBS */
+
 
 /**
  * \brief                   Process blocks with Poly1305.
@@ -103,6 +120,85 @@ static inline uint64_t mul64( uint32_t a, uint32_t b )
  *                          applied to the input data before calling this
  *                          function.  Otherwise, set this parameter to 1.
  */
+#if defined(POLY1305_64BIT_LIMBS)
+static void poly1305_process( mbedtls_poly1305_context *ctx,
+                              size_t nblocks,
+                              const unsigned char *input,
+                              uint32_t needs_padding )
+{
+    poly1305_uint128 d0, d1, d2;
+    uint64_t h0, h1, h2;
+    uint64_t r0, r1, r2;
+    uint64_t s1, s2;
+    uint64_t t0, t1, c;
+    const uint64_t hibit = (uint64_t) needs_padding << 40;
+    size_t offset = 0U;
+    size_t i;
+
+    /* Split r and acc in 44, 44 and 42 bits limbs */
+    t0 = (uint64_t) ctx->r[0] | (uint64_t) ctx->r[1] << 32;
+    t1 = (uint64_t) ctx->r[2] | (uint64_t) ctx->r[3] << 32;
+    r0 = t0 & POLY1305_MASK44;
+    r1 = ( ( t0 >> 44 ) | ( t1 << 20 ) ) & POLY1305_MASK44;
+    r2 = t1 >> 24;
+
+    /* 2^132 = 4 * 5 (mod 2^130 - 5) */
+    s1 = r1 * ( 5U << 2 );
+    s2 = r2 * ( 5U << 2 );
+
+    t0 = (uint64_t) ctx->acc[0] | (uint64_t) ctx->acc[1] << 32;
+    t1 = (uint64_t) ctx->acc[2] | (uint64_t) ctx->acc[3] << 32;
+    h0 = t0 & POLY1305_MASK44;
+    h1 = ( ( t0 >> 44 ) | ( t1 << 20 ) ) & POLY1305_MASK44;
+    h2 = ( t1 >> 24 ) | (uint64_t) ctx->acc[4] << 40;
+
+    for( i = 0U; i < nblocks; i++ )
+    {
+        /* Compute: acc += (padded) block as a 130-bit integer */
+        t0 = BYTES_TO_U64_LE( input, offset );
+        t1 = BYTES_TO_U64_LE( input, offset + 8 );
+        h0 += t0 & POLY1305_MASK44;
+        h1 += ( ( t0 >> 44 ) | ( t1 << 20 ) ) & POLY1305_MASK44;
+        h2 += ( t1 >> 24 ) | hibit;
+
+        /* Compute: acc *= r */
+        d0 = (poly1305_uint128) h0 * r0 +
+             (poly1305_uint128) h1 * s2 +
+             (poly1305_uint128) h2 * s1;
+        d1 = (poly1305_uint128) h0 * r1 +
+             (poly1305_uint128) h1 * r0 +
+             (poly1305_uint128) h2 * s2;
+        d2 = (poly1305_uint128) h0 * r2 +
+             (poly1305_uint128) h1 * r1 +
+             (poly1305_uint128) h2 * r0;
+
+        /* Compute: acc %= (2^130 - 5) (partial remainder) */
+        c  = (uint64_t) ( d0 >> 44 );
+        h0 = (uint64_t) d0 & POLY1305_MASK44;
+        d1 += c;
+        c  = (uint64_t) ( d1 >> 44 );
+        h1 = (uint64_t) d1 & POLY1305_MASK44;
+        d2 += c;
+        c  = (uint64_t) ( d2 >> 42 );
+        h2 = (uint64_t) d2 & POLY1305_MASK42;
+        h0 += c * 5U;
+        c  = h0 >> 44;
+        h0 &= POLY1305_MASK44;
+        h1 += c;
+
+        offset += POLY1305_BLOCK_SIZE_BYTES;
+    }
+
+    /* Back to 32 bits words, h1 may exceed 44 bits */
+    d0 = (poly1305_uint128) h0 + ( (poly1305_uint128) h1 << 44 );
+    ctx->acc[0] = (uint32_t) d0;
+    ctx->acc[1] = (uint32_t) ( d0 >> 32 );
+    d0 = ( d0 >> 64 ) + ( (poly1305_uint128) h2 << 24 );
+    ctx->acc[2] = (uint32_t) d0;
+    ctx->acc[3] = (uint32_t) ( d0 >> 32 );
+    ctx->acc[4] = (uint32_t) ( d0 >> 64 );
+}
+#else
 static void poly1305_process( mbedtls_poly1305_context *ctx,
                               size_t nblocks,
                               const unsigned char *input,
@@ -203,6 +299,7 @@ static void poly1305_process( mbedtls_poly1305_context *ctx,
     ctx->acc[3] = acc3;
     ctx->acc[4] = acc4;
 }
+#endif /* POLY1305_64BIT_LIMBS */
 
 /**
  * \brief                   Compute the Poly1305 MAC
@@ -43,6 +43,162 @@
 
 #include <string.h>
 
+/*
+ * The cache is split in MBEDTLS_SSL_CACHE_SHARDS shards selected by a hash of
+ * the session ID. Each shard has its own lock, a hash table of its entries
+ * a list of the entries from the most to the least recently used, and a list
+ * of the entries in the order they were stored. An entry keeps its timestamp
+ * when its session is stored again, so the second list is ordered by
+ * timestamp and its head is the first entry to expire.
+ *
+ * An entry is unlinked when it is found expired by get. Before storing a new
+ * entry, set drops the expired entries from the head of the timestamp list,
+ * then reuses the least recently used entry if the shard is full. No
+ * operation walks all the entries.
+ */
+
+/*
+ * FNV-1a hash of a session ID
+ */
+static uint32_t ssl_cache_hash( const unsigned char *id, size_t len )
+{
+    uint32_t h = 0x811C9DC5;
+    size_t i;
+
+    for( i = 0; i < len; i++ )
+    {
+        h ^= id[i];
+        h *= 0x01000193;
+    }
+
+    return( h );
+}
+
+static mbedtls_ssl_cache_shard *ssl_cache_shard( mbedtls_ssl_cache_context *cache,
+                                                 uint32_t h )
+{
+    return( &cache->shards[h % MBEDTLS_SSL_CACHE_SHARDS] );
+}
+
+static mbedtls_ssl_cache_entry **ssl_cache_bucket( mbedtls_ssl_cache_shard *shard,
+                                                   uint32_t h )
+{
+    return( &shard->buckets[( h / MBEDTLS_SSL_CACHE_SHARDS ) &
+                            shard->bucket_mask] );
+}
+
+/*
+ * Maximum number of entries of a shard
+ */
+static int ssl_cache_shard_max( const mbedtls_ssl_cache_context *cache )
+{
+    return( ( cache->max_entries + MBEDTLS_SSL_CACHE_SHARDS - 1 ) /
+            MBEDTLS_SSL_CACHE_SHARDS );
+}
+
+#if defined(MBEDTLS_HAVE_TIME)
+static int ssl_cache_expired( const mbedtls_ssl_cache_context *cache,
+                              const mbedtls_ssl_cache_entry *entry,
+                              mbedtls_time_t t )
+{
+    return( cache->timeout != 0 &&
+            (int) ( t - entry->timestamp ) > cache->timeout );
+}
+#endif /* MBEDTLS_HAVE_TIME */
+
+static void ssl_cache_lru_unlink( mbedtls_ssl_cache_shard *shard,
+                                  mbedtls_ssl_cache_entry *entry )
+{
+    if( entry->lru_prev != NULL )
+        entry->lru_prev->lru_next = entry->lru_next;
+    else
+        shard->lru_head = entry->lru_next;
+
+    if( entry->lru_next != NULL )
+        entry->lru_next->lru_prev = entry->lru_prev;
+    else
+        shard->lru_tail = entry->lru_prev;
+
+    entry->lru_prev = NULL;
+    entry->lru_next = NULL;
+}
+
+static void ssl_cache_lru_push( mbedtls_ssl_cache_shard *shard,
+                                mbedtls_ssl_cache_entry *entry )
+{
+    entry->lru_prev = NULL;
+    entry->lru_next = shard->lru_head;
+
+    if( shard->lru_head != NULL )
+        shard->lru_head->lru_prev = entry;
+    else
+        shard->lru_tail = entry;
+
+    shard->lru_head = entry;
+}
+
+static void ssl_cache_age_unlink( mbedtls_ssl_cache_shard *shard,
+                                  mbedtls_ssl_cache_entry *entry )
+{
+    if( entry->age_prev != NULL )
+        entry->age_prev->age_next = entry->age_next;
+    else
+        shard->age_head = entry->age_next;
+
+    if( entry->age_next != NULL )
+        entry->age_next->age_prev = entry->age_prev;
+    else
+        shard->age_tail = entry->age_prev;
+
+    entry->age_prev = NULL;
+    entry->age_next = NULL;
+}
+
+static void ssl_cache_age_append( mbedtls_ssl_cache_shard *shard,
+                                  mbedtls_ssl_cache_entry *entry )
+{
+    entry->age_next = NULL;
+    entry->age_prev = shard->age_tail;
+
+    if( shard->age_tail != NULL )
+        shard->age_tail->age_next = entry;
+    else
+        shard->age_head = entry;
+
+    shard->age_tail = entry;
+}
+
+/*
+ * Unlink an entry from its bucket and from both lists
+ */
+static void ssl_cache_unlink( mbedtls_ssl_cache_shard *shard,
+                              mbedtls_ssl_cache_entry *entry )
+{
+    mbedtls_ssl_cache_entry **cur;
+
+    cur = ssl_cache_bucket( shard, ssl_cache_hash( entry->session.id,
+                                                   entry->session.id_len ) );
+    while( *cur != entry )
+        cur = &(*cur)->next;
+    *cur = entry->next;
+    entry->next = NULL;
+
+    ssl_cache_lru_unlink( shard, entry );
+    ssl_cache_age_unlink( shard, entry );
+    shard->count--;
+}
+
+static void ssl_cache_entry_free( mbedtls_ssl_cache_entry *entry )
+{
+    mbedtls_ssl_session_free( &entry->session );
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    mbedtls_free( entry->peer_cert.p );
+#endif /* MBEDTLS_X509_CRT_PARSE_C */
+
+    mbedtls_free( entry );
+}
+
 void mbedtls_ssl_cache_init( mbedtls_ssl_cache_context *cache )
 {
     memset( cache, 0, sizeof( mbedtls_ssl_cache_context ) );
@@ -51,7 +207,12 @@ void mbedtls_ssl_cache_init( mbedtls_ssl_cache_context *cache )
     cache->max_entries = MBEDTLS_SSL_CACHE_DEFAULT_MAX_ENTRIES;
 
 #if defined(MBEDTLS_THREADING_C)
-    mbedtls_mutex_init( &cache->mutex );
+    {
+        int i;
+
+        for( i = 0; i < MBEDTLS_SSL_CACHE_SHARDS; i++ )
+            mbedtls_mutex_init( &cache->shards[i].mutex );
+    }
 #endif
 }
 
@@ -62,72 +223,89 @@ int mbedtls_ssl_cache_get( void *data, mbedtls_ssl_session *session )
     mbedtls_time_t t = mbedtls_time( NULL );
 #endif
     mbedtls_ssl_cache_context *cache = (mbedtls_ssl_cache_context *) data;
-    mbedtls_ssl_cache_entry *cur, *entry;
+    mbedtls_ssl_cache_shard *shard;
+    mbedtls_ssl_cache_entry *entry;
+    uint32_t h;
+
+    h = ssl_cache_hash( session->id, session->id_len );
+    shard = ssl_cache_shard( cache, h );
 
 #if defined(MBEDTLS_THREADING_C)
-    if( mbedtls_mutex_lock( &cache->mutex ) != 0 )
+    if( mbedtls_mutex_lock( &shard->mutex ) != 0 )
         return( 1 );
 #endif
 
-    cur = cache->chain;
-    entry = NULL;
+    if( shard->buckets == NULL )
+    {
+        shard->stats.misses++;
+        goto exit;
+    }
 
-    while( cur != NULL )
+    for( entry = *ssl_cache_bucket( shard, h ); entry != NULL;
+         entry = entry->next )
     {
-        entry = cur;
-        cur = cur->next;
+        if( session->id_len == entry->session.id_len &&
+            memcmp( session->id, entry->session.id,
+                    entry->session.id_len ) == 0 )
+            break;
+    }
 
 #if defined(MBEDTLS_HAVE_TIME)
-        if( cache->timeout != 0 &&
-            (int) ( t - entry->timestamp ) > cache->timeout )
-            continue;
+    if( entry != NULL && ssl_cache_expired( cache, entry, t ) )
+    {
+        ssl_cache_unlink( shard, entry );
+        ssl_cache_entry_free( entry );
+        shard->stats.expirations++;
+        entry = NULL;
+    }
 #endif
 
-        if( session->ciphersuite != entry->session.ciphersuite ||
-            session->compression != entry->session.compression ||
-            session->id_len != entry->session.id_len )
-            continue;
-
-        if( memcmp( session->id, entry->session.id,
-                    entry->session.id_len ) != 0 )
-            continue;
+    if( entry == NULL ||
+        session->ciphersuite != entry->session.ciphersuite ||
+        session->compression != entry->session.compression )
+    {
+        shard->stats.misses++;
+        goto exit;
+    }
 
-        memcpy( session->master, entry->session.master, 48 );
+    memcpy( session->master, entry->session.master, 48 );
 
-        session->verify_result = entry->session.verify_result;
+    session->verify_result = entry->session.verify_result;
 
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
-        /*
-         * Restore peer certificate (without rest of the original chain)
-         */
-        if( entry->peer_cert.p != NULL )
+    /*
+     * Restore peer certificate (without rest of the original chain)
+     */
+    if( entry->peer_cert.p != NULL )
+    {
+        if( ( session->peer_cert = mbedtls_calloc( 1,
+                             sizeof(mbedtls_x509_crt) ) ) == NULL )
         {
-            if( ( session->peer_cert = mbedtls_calloc( 1,
-                                 sizeof(mbedtls_x509_crt) ) ) == NULL )
-            {
-                ret = 1;
-                goto exit;
-            }
+            ret = 1;
+            goto exit;
+        }
 
-            mbedtls_x509_crt_init( session->peer_cert );
-            if( mbedtls_x509_crt_parse( session->peer_cert, entry->peer_cert.p,
-                                entry->peer_cert.len ) != 0 )
-            {
-                mbedtls_free( session->peer_cert );
-                session->peer_cert = NULL;
-                ret = 1;
-                goto exit;
-            }
+        mbedtls_x509_crt_init( session->peer_cert );
+        if( mbedtls_x509_crt_parse( session->peer_cert, entry->peer_cert.p,
+                            entry->peer_cert.len ) != 0 )
+        {
+            mbedtls_free( session->peer_cert );
+            session->peer_cert = NULL;
+            ret = 1;
+            goto exit;
         }
+    }
 #endif /* MBEDTLS_X509_CRT_PARSE_C */
 
-        ret = 0;
-        goto exit;
-    }
+    ssl_cache_lru_unlink( shard, entry );
+    ssl_cache_lru_push( shard, entry );
+    shard->stats.hits++;
+
+    ret = 0;
 
 exit:
 #if defined(MBEDTLS_THREADING_C)
-    if( mbedtls_mutex_unlock( &cache->mutex ) != 0 )
+    if( mbedtls_mutex_unlock( &shard->mutex ) != 0 )
         ret = 1;
 #endif
 
@@ -138,84 +316,99 @@ int mbedtls_ssl_cache_set( void *data, const mbedtls_ssl_session *session )
 {
     int ret = 1;
 #if defined(MBEDTLS_HAVE_TIME)
-    mbedtls_time_t t = mbedtls_time( NULL ), oldest = 0;
-    mbedtls_ssl_cache_entry *old = NULL;
+    mbedtls_time_t t = mbedtls_time( NULL );
 #endif
     mbedtls_ssl_cache_context *cache = (mbedtls_ssl_cache_context *) data;
-    mbedtls_ssl_cache_entry *cur, *prv;
-    int count = 0;
+    mbedtls_ssl_cache_shard *shard;
+    mbedtls_ssl_cache_entry *cur, **bucket;
+    uint32_t h;
+
+    h = ssl_cache_hash( session->id, session->id_len );
+    shard = ssl_cache_shard( cache, h );
 
 #if defined(MBEDTLS_THREADING_C)
-    if( ( ret = mbedtls_mutex_lock( &cache->mutex ) ) != 0 )
+    if( ( ret = mbedtls_mutex_lock( &shard->mutex ) ) != 0 )
         return( ret );
 #endif
 
-    cur = cache->chain;
-    prv = NULL;
-
-    while( cur != NULL )
+    if( ssl_cache_shard_max( cache ) == 0 )
     {
-        count++;
+        ret = 1;
+        goto exit;
+    }
 
-#if defined(MBEDTLS_HAVE_TIME)
-        if( cache->timeout != 0 &&
-            (int) ( t - cur->timestamp ) > cache->timeout )
-        {
-            cur->timestamp = t;
-            break; /* expired, reuse this slot, update timestamp */
-        }
-#endif
+    /*
+     * Size the hash table for the maximum number of entries of the shard
+     */
+    if( shard->buckets == NULL )
+    {
+        unsigned int size = 1;
 
-        if( memcmp( session->id, cur->session.id, cur->session.id_len ) == 0 )
-            break; /* client reconnected, keep timestamp for session id */
+        while( size < (unsigned int) ssl_cache_shard_max( cache ) &&
+               size < 0x10000 )
+            size <<= 1;
 
-#if defined(MBEDTLS_HAVE_TIME)
-        if( oldest == 0 || cur->timestamp < oldest )
+        shard->buckets = mbedtls_calloc( size, sizeof( *shard->buckets ) );
+        if( shard->buckets == NULL )
         {
-            oldest = cur->timestamp;
-            old = cur;
+            ret = 1;
+            goto exit;
         }
-#endif
 
-        prv = cur;
-        cur = cur->next;
+        shard->bucket_mask = size - 1;
     }
 
-    if( cur == NULL )
+    for( cur = *ssl_cache_bucket( shard, h ); cur != NULL; cur = cur->next )
     {
+        if( session->id_len == cur->session.id_len &&
+            memcmp( session->id, cur->session.id, cur->session.id_len ) == 0 )
+            break;
+    }
+
+    if( cur != NULL )
+    {
+        /* client reconnected, keep timestamp for session id */
+        ssl_cache_lru_unlink( shard, cur );
+
 #if defined(MBEDTLS_HAVE_TIME)
         /*
-         * Reuse oldest entry if max_entries reached
+         * Unless it expired: then the entry is reused for a fresh session
+         * and moves to the end of the age list
          */
-        if( count >= cache->max_entries )
+        if( ssl_cache_expired( cache, cur, t ) )
         {
-            if( old == NULL )
-            {
-                ret = 1;
-                goto exit;
-            }
-
-            cur = old;
+            cur->timestamp = t;
+            ssl_cache_age_unlink( shard, cur );
+            ssl_cache_age_append( shard, cur );
         }
-#else /* MBEDTLS_HAVE_TIME */
+#endif
+    }
+    else
+    {
+#if defined(MBEDTLS_HAVE_TIME)
         /*
-         * Reuse first entry in chain if max_entries reached,
-         * but move to last place
+         * Drop the expired entries, oldest first. Entries used recently can
+         * be expired too, so this does not follow the LRU list.
          */
-        if( count >= cache->max_entries )
+        while( shard->age_head != NULL &&
+               ssl_cache_expired( cache, shard->age_head, t ) )
         {
-            if( cache->chain == NULL )
-            {
-                ret = 1;
-                goto exit;
-            }
+            cur = shard->age_head;
+            ssl_cache_unlink( shard, cur );
+            ssl_cache_entry_free( cur );
+            shard->stats.expirations++;
+        }
+#endif
 
-            cur = cache->chain;
-            cache->chain = cur->next;
-            cur->next = NULL;
-            prv->next = cur;
+        if( shard->count >= ssl_cache_shard_max( cache ) )
+        {
+            /*
+             * Reuse the least recently used entry if the shard is full
+             */
+            cur = shard->lru_tail;
+            ssl_cache_unlink( shard, cur );
+            shard->stats.evictions++;
         }
-#endif /* MBEDTLS_HAVE_TIME */
         else
         {
             /*
@@ -227,18 +420,22 @@ int mbedtls_ssl_cache_set( void *data, const mbedtls_ssl_session *session )
                 ret = 1;
                 goto exit;
             }
-
-            if( prv == NULL )
-                cache->chain = cur;
-            else
-                prv->next = cur;
         }
 
 #if defined(MBEDTLS_HAVE_TIME)
         cur->timestamp = t;
 #endif
+
+        bucket = ssl_cache_bucket( shard, h );
+        cur->next = *bucket;
+        *bucket = cur;
+        shard->count++;
+
+        ssl_cache_age_append( shard, cur );
     }
 
+    ssl_cache_lru_push( shard, cur );
+
     memcpy( &cur->session, session, sizeof( mbedtls_ssl_session ) );
 
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
@@ -275,7 +472,7 @@ int mbedtls_ssl_cache_set( void *data, const mbedtls_ssl_session *session )
 
 exit:
 #if defined(MBEDTLS_THREADING_C)
-    if( mbedtls_mutex_unlock( &cache->mutex ) != 0 )
+    if( mbedtls_mutex_unlock( &shard->mutex ) != 0 )
         ret = 1;
 #endif
 
@@ -298,30 +495,66 @@ void mbedtls_ssl_cache_set_max_entries( mbedtls_ssl_cache_context *cache, int ma
     cache->max_entries = max;
 }
 
-void mbedtls_ssl_cache_free( mbedtls_ssl_cache_context *cache )
+void mbedtls_ssl_cache_get_stats( mbedtls_ssl_cache_context *cache,
+                                  mbedtls_ssl_cache_stats *stats )
 {
-    mbedtls_ssl_cache_entry *cur, *prv;
+    mbedtls_ssl_cache_shard *shard;
+    int i;
 
-    cur = cache->chain;
+    memset( stats, 0, sizeof( mbedtls_ssl_cache_stats ) );
 
-    while( cur != NULL )
+    for( i = 0; i < MBEDTLS_SSL_CACHE_SHARDS; i++ )
     {
-        prv = cur;
-        cur = cur->next;
+        shard = &cache->shards[i];
 
-        mbedtls_ssl_session_free( &prv->session );
+#if defined(MBEDTLS_THREADING_C)
+        if( mbedtls_mutex_lock( &shard->mutex ) != 0 )
+            continue;
+#endif
 
-#if defined(MBEDTLS_X509_CRT_PARSE_C)
-        mbedtls_free( prv->peer_cert.p );
-#endif /* MBEDTLS_X509_CRT_PARSE_C */
+        stats->hits += shard->stats.hits;
+        stats->misses += shard->stats.misses;
+        stats->evictions += shard->stats.evictions;
+        stats->expirations += shard->stats.expirations;
 
-        mbedtls_free( prv );
+#if defined(MBEDTLS_THREADING_C)
+        mbedtls_mutex_unlock( &shard->mutex );
+#endif
     }
+}
+
+void mbedtls_ssl_cache_free( mbedtls_ssl_cache_context *cache )
+{
+    mbedtls_ssl_cache_shard *shard;
+    mbedtls_ssl_cache_entry *cur, *prv;
+    int i;
+
+    for( i = 0; i < MBEDTLS_SSL_CACHE_SHARDS; i++ )
+    {
+        shard = &cache->shards[i];
+        cur = shard->lru_head;
+
+        while( cur != NULL )
+        {
+            prv = cur;
+            cur = cur->lru_next;
+
+            ssl_cache_entry_free( prv );
+        }
+
+        mbedtls_free( shard->buckets );
 
 #if defined(MBEDTLS_THREADING_C)
-    mbedtls_mutex_free( &cache->mutex );
+        mbedtls_mutex_free( &shard->mutex );
 #endif
-    cache->chain = NULL;
+        shard->buckets = NULL;
+        shard->bucket_mask = 0;
+        shard->count = 0;
+        shard->lru_head = NULL;
+        shard->lru_tail = NULL;
+        shard->age_head = NULL;
+        shard->age_tail = NULL;
+    }
 }
 
 #endif /* MBEDTLS_SSL_CACHE_C */
@@ -5758,6 +5758,18 @@ crt_verify:
         /*
          * Main check: verify certificate
          */
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE)
+        if( ssl->conf->verify_cache != NULL && rs_ctx == NULL )
+            ret = mbedtls_x509_crt_verify_with_cache(
+                                ssl->session_negotiate->peer_cert,
+                                ca_chain, ca_crl,
+                                ssl->conf->cert_profile,
+                                ssl->hostname,
+                               &ssl->session_negotiate->verify_result,
+                                ssl->conf->f_vrfy, ssl->conf->p_vrfy,
+                                ssl->conf->verify_cache );
+        else
+#endif
         ret = mbedtls_x509_crt_verify_restartable(
                                 ssl->session_negotiate->peer_cert,
                                 ca_chain, ca_crl,
@@ -7290,6 +7302,14 @@ void mbedtls_ssl_conf_ca_chain( mbedtls_ssl_config *conf,
     conf->ca_chain   = ca_chain;
     conf->ca_crl     = ca_crl;
 }
+
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE)
+void mbedtls_ssl_conf_verify_cache( mbedtls_ssl_config *conf,
+                                    mbedtls_x509_crt_verify_cache *cache )
+{
+    conf->verify_cache = cache;
+}
+#endif /* MBEDTLS_X509_CRT_VERIFY_CACHE */
 #endif /* MBEDTLS_X509_CRT_PARSE_C */
 
 #if defined(MBEDTLS_SSL_SERVER_NAME_INDICATION)
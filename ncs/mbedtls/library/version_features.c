@@ -351,6 +351,9 @@ static const char *features[] = {
 #if defined(MBEDTLS_ECP_NIST_OPTIM)
     "MBEDTLS_ECP_NIST_OPTIM",
 #endif /* MBEDTLS_ECP_NIST_OPTIM */
+#if defined(MBEDTLS_ECP_P256_FIXED_LIMBS)
+    "MBEDTLS_ECP_P256_FIXED_LIMBS",
+#endif /* MBEDTLS_ECP_P256_FIXED_LIMBS */
 #if defined(MBEDTLS_ECP_RESTARTABLE)
     "MBEDTLS_ECP_RESTARTABLE",
 #endif /* MBEDTLS_ECP_RESTARTABLE */
@@ -420,6 +423,9 @@ static const char *features[] = {
 #if defined(MBEDTLS_MEMORY_BACKTRACE)
     "MBEDTLS_MEMORY_BACKTRACE",
 #endif /* MBEDTLS_MEMORY_BACKTRACE */
+#if defined(MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB)
+    "MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB",
+#endif /* MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB */
 #if defined(MBEDTLS_PK_RSA_ALT_SUPPORT)
     "MBEDTLS_PK_RSA_ALT_SUPPORT",
 #endif /* MBEDTLS_PK_RSA_ALT_SUPPORT */
@@ -543,6 +549,9 @@ static const char *features[] = {
 #if defined(MBEDTLS_X509_RSASSA_PSS_SUPPORT)
     "MBEDTLS_X509_RSASSA_PSS_SUPPORT",
 #endif /* MBEDTLS_X509_RSASSA_PSS_SUPPORT */
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE)
+    "MBEDTLS_X509_CRT_VERIFY_CACHE",
+#endif /* MBEDTLS_X509_CRT_VERIFY_CACHE */
 #if defined(MBEDTLS_ZLIB_SUPPORT)
     "MBEDTLS_ZLIB_SUPPORT",
 #endif /* MBEDTLS_ZLIB_SUPPORT */
@@ -63,6 +63,10 @@
 #include "mbedtls/threading.h"
 #endif
 
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE)
+#include "mbedtls/sha256.h"
+#endif
+
 #if defined(_WIN32) && !defined(EFIX64) && !defined(EFI32)
 #include <windows.h>
 #else
@@ -1772,6 +1776,353 @@ int mbedtls_x509_crt_check_extended_key_usage( const mbedtls_x509_crt *crt,
 }
 #endif /* MBEDTLS_X509_CHECK_EXTENDED_KEY_USAGE */
 
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE)
+/*
+ * Verification cache: signatures of certificates and CRLs found valid.
+ *
+ * An entry is keyed by a SHA-256 over everything the signature check
+ * depends on: the algorithms and options, the digest of the signed data,
+ * the signature and the signer's certificate. The entries are kept in sets
+ * of X509_VERIFY_CACHE_WAYS, selected by the first bytes of the key.
+ */
+#define X509_VERIFY_CACHE_WAYS  4
+
+void mbedtls_x509_crt_verify_cache_init( mbedtls_x509_crt_verify_cache *cache )
+{
+    memset( cache, 0, sizeof( mbedtls_x509_crt_verify_cache ) );
+
+    cache->max_entries = MBEDTLS_X509_CRT_VERIFY_CACHE_DEFAULT_MAX_ENTRIES;
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_init( &cache->mutex );
+#endif
+}
+
+/*
+ * Drop the entries, and the table itself when free_table is set.
+ * Must be called with the mutex held.
+ */
+static void x509_verify_cache_clear( mbedtls_x509_crt_verify_cache *cache,
+                                     int free_table )
+{
+    if( cache->entries == NULL )
+        return;
+
+    mbedtls_platform_zeroize( cache->entries, (size_t) cache->sets *
+                X509_VERIFY_CACHE_WAYS * sizeof( *cache->entries ) );
+
+    if( free_table )
+    {
+        mbedtls_free( cache->entries );
+        cache->entries = NULL;
+        cache->sets = 0;
+    }
+}
+
+void mbedtls_x509_crt_verify_cache_set_max_entries(
+                                    mbedtls_x509_crt_verify_cache *cache,
+                                    int max )
+{
+    if( max < 0 ) max = 0;
+
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_lock( &cache->mutex ) != 0 )
+        return;
+#endif
+
+    /* The table is sized again on next use */
+    x509_verify_cache_clear( cache, 1 );
+    cache->max_entries = max;
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_unlock( &cache->mutex );
+#endif
+}
+
+void mbedtls_x509_crt_verify_cache_flush( mbedtls_x509_crt_verify_cache *cache )
+{
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_lock( &cache->mutex ) != 0 )
+        return;
+#endif
+
+    x509_verify_cache_clear( cache, 0 );
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_unlock( &cache->mutex );
+#endif
+}
+
+void mbedtls_x509_crt_verify_cache_get_stats(
+                                    mbedtls_x509_crt_verify_cache *cache,
+                                    mbedtls_x509_crt_verify_cache_stats *stats )
+{
+    memset( stats, 0, sizeof( mbedtls_x509_crt_verify_cache_stats ) );
+
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_lock( &cache->mutex ) != 0 )
+        return;
+#endif
+
+    *stats = cache->stats;
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_unlock( &cache->mutex );
+#endif
+}
+
+void mbedtls_x509_crt_verify_cache_free( mbedtls_x509_crt_verify_cache *cache )
+{
+    if( cache == NULL )
+        return;
+
+    x509_verify_cache_clear( cache, 1 );
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_free( &cache->mutex );
+#endif
+
+    mbedtls_platform_zeroize( cache, sizeof( mbedtls_x509_crt_verify_cache ) );
+}
+
+/*
+ * Key of the check of signature sig, over the data with the given digest,
+ * by the public key of signer
+ */
+static int x509_verify_cache_key( unsigned char key[32],
+                                  mbedtls_pk_type_t sig_pk,
+                                  const void *sig_opts,
+                                  mbedtls_md_type_t sig_md,
+                                  const unsigned char *hash, size_t hash_len,
+                                  const mbedtls_x509_buf *sig,
+                                  const mbedtls_x509_crt *signer )
+{
+    int ret;
+    mbedtls_sha256_context sha256;
+    unsigned char algs[2];
+
+    algs[0] = (unsigned char) sig_pk;
+    algs[1] = (unsigned char) sig_md;
+
+    mbedtls_sha256_init( &sha256 );
+
+    if( ( ret = mbedtls_sha256_starts_ret( &sha256, 0 ) ) != 0 ||
+        ( ret = mbedtls_sha256_update_ret( &sha256, algs, 2 ) ) != 0 )
+        goto exit;
+
+#if defined(MBEDTLS_X509_RSASSA_PSS_SUPPORT)
+    if( sig_pk == MBEDTLS_PK_RSASSA_PSS && sig_opts != NULL )
+    {
+        const mbedtls_pk_rsassa_pss_options *pss_opts = sig_opts;
+        unsigned char opts[5];
+
+        opts[0] = (unsigned char) pss_opts->mgf1_hash_id;
+        opts[1] = (unsigned char)( pss_opts->expected_salt_len >> 24 );
+        opts[2] = (unsigned char)( pss_opts->expected_salt_len >> 16 );
+        opts[3] = (unsigned char)( pss_opts->expected_salt_len >>  8 );
+        opts[4] = (unsigned char)( pss_opts->expected_salt_len       );
+
+        if( ( ret = mbedtls_sha256_update_ret( &sha256, opts, 5 ) ) != 0 )
+            goto exit;
+    }
+#else
+    (void) sig_opts;
+#endif
+
+    if( ( ret = mbedtls_sha256_update_ret( &sha256, hash, hash_len ) ) != 0 ||
+        ( ret = mbedtls_sha256_update_ret( &sha256, sig->p, sig->len ) ) != 0 ||
+        ( ret = mbedtls_sha256_update_ret( &sha256, signer->raw.p,
+                                           signer->raw.len ) ) != 0 ||
+        ( ret = mbedtls_sha256_finish_ret( &sha256, key ) ) != 0 )
+        goto exit;
+
+exit:
+    mbedtls_sha256_free( &sha256 );
+
+    return( ret );
+}
+
+/*
+ * Earlier of two dates
+ */
+static const mbedtls_x509_time *x509_time_min( const mbedtls_x509_time *a,
+                                               const mbedtls_x509_time *b )
+{
+    if( a->year != b->year ) return( a->year < b->year ? a : b );
+    if( a->mon  != b->mon  ) return( a->mon  < b->mon  ? a : b );
+    if( a->day  != b->day  ) return( a->day  < b->day  ? a : b );
+    if( a->hour != b->hour ) return( a->hour < b->hour ? a : b );
+    if( a->min  != b->min  ) return( a->min  < b->min  ? a : b );
+    return( a->sec <= b->sec ? a : b );
+}
+
+static mbedtls_x509_crt_verify_cache_entry *x509_verify_cache_set_of(
+                                    mbedtls_x509_crt_verify_cache *cache,
+                                    const unsigned char key[32] )
+{
+    uint32_t h = ( (uint32_t) key[0] << 24 ) | ( (uint32_t) key[1] << 16 ) |
+                 ( (uint32_t) key[2] <<  8 ) | ( (uint32_t) key[3]       );
+
+    return( cache->entries + ( h % cache->sets ) * X509_VERIFY_CACHE_WAYS );
+}
+
+/*
+ * Return 0 if the signature with this key was found valid and is still
+ * within its validity period, -1 otherwise
+ */
+static int x509_verify_cache_get( mbedtls_x509_crt_verify_cache *cache,
+                                  const unsigned char key[32] )
+{
+    int ret = -1;
+    mbedtls_x509_crt_verify_cache_entry *set;
+    size_t i;
+
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_lock( &cache->mutex ) != 0 )
+        return( -1 );
+#endif
+
+    if( cache->entries == NULL )
+        goto exit;
+
+    set = x509_verify_cache_set_of( cache, key );
+
+    for( i = 0; i < X509_VERIFY_CACHE_WAYS; i++ )
+    {
+        if( set[i].last_use == 0 || memcmp( set[i].key, key, 32 ) != 0 )
+            continue;
+
+        if( mbedtls_x509_time_is_past( &set[i].valid_to ) )
+        {
+            set[i].last_use = 0;
+            cache->stats.expirations++;
+            break;
+        }
+
+        set[i].last_use = ++cache->use_count;
+        ret = 0;
+        break;
+    }
+
+exit:
+    if( ret == 0 )
+        cache->stats.hits++;
+    else
+        cache->stats.misses++;
+
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_unlock( &cache->mutex ) != 0 )
+        ret = -1;
+#endif
+
+    return( ret );
+}
+
+/*
+ * Remember a signature found valid, replacing the least recently used
+ * entry of its set if needed
+ */
+static void x509_verify_cache_set( mbedtls_x509_crt_verify_cache *cache,
+                                   const unsigned char key[32],
+                                   const mbedtls_x509_time *valid_to )
+{
+    mbedtls_x509_crt_verify_cache_entry *set, *cur = NULL;
+    size_t i;
+
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_lock( &cache->mutex ) != 0 )
+        return;
+#endif
+
+    if( cache->max_entries == 0 || mbedtls_x509_time_is_past( valid_to ) )
+        goto exit;
+
+    if( cache->entries == NULL )
+    {
+        unsigned int sets = ( (unsigned int) cache->max_entries +
+                              X509_VERIFY_CACHE_WAYS - 1 ) / X509_VERIFY_CACHE_WAYS;
+
+        cache->entries = mbedtls_calloc( (size_t) sets * X509_VERIFY_CACHE_WAYS,
+                                         sizeof( *cache->entries ) );
+        if( cache->entries == NULL )
+            goto exit;
+
+        cache->sets = sets;
+    }
+
+    set = x509_verify_cache_set_of( cache, key );
+
+    for( i = 0; i < X509_VERIFY_CACHE_WAYS; i++ )
+    {
+        /* Already there (verified concurrently), or a free entry */
+        if( set[i].last_use == 0 || memcmp( set[i].key, key, 32 ) == 0 )
+        {
+            cur = &set[i];
+            break;
+        }
+
+        if( cur == NULL || set[i].last_use < cur->last_use )
+            cur = &set[i];
+    }
+
+    if( i == X509_VERIFY_CACHE_WAYS )
+        cache->stats.evictions++;
+
+    memcpy( cur->key, key, 32 );
+    cur->valid_to = *valid_to;
+    cur->last_use = ++cache->use_count;
+
+exit:
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_unlock( &cache->mutex );
+#endif
+    return;
+}
+#endif /* MBEDTLS_X509_CRT_VERIFY_CACHE */
+
+/*
+ * Check a signature by the key of signer, or look it up in the cache.
+ * A valid signature is cached until valid_to or the end of validity of
+ * signer, whichever comes first.
+ */
+static int x509_crt_verify_sig( mbedtls_pk_type_t sig_pk, const void *sig_opts,
+                                mbedtls_x509_crt *signer,
+                                mbedtls_md_type_t sig_md,
+                                const unsigned char *hash, size_t hash_len,
+                                const mbedtls_x509_buf *sig,
+                                const mbedtls_x509_time *valid_to,
+                                mbedtls_x509_crt_verify_cache *cache )
+{
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE)
+    int ret;
+    unsigned char key[32];
+
+    if( cache != NULL &&
+        x509_verify_cache_key( key, sig_pk, sig_opts, sig_md, hash, hash_len,
+                               sig, signer ) == 0 )
+    {
+        if( x509_verify_cache_get( cache, key ) == 0 )
+            return( 0 );
+
+        ret = mbedtls_pk_verify_ext( sig_pk, sig_opts, &signer->pk, sig_md,
+                                     hash, hash_len, sig->p, sig->len );
+        if( ret == 0 )
+            x509_verify_cache_set( cache, key,
+                                   x509_time_min( valid_to, &signer->valid_to ) );
+
+        mbedtls_platform_zeroize( key, sizeof( key ) );
+
+        return( ret );
+    }
+#else
+    (void) valid_to;
+    (void) cache;
+#endif
+
+    return( mbedtls_pk_verify_ext( sig_pk, sig_opts, &signer->pk, sig_md,
+                                   hash, hash_len, sig->p, sig->len ) );
+}
+
 #if defined(MBEDTLS_X509_CRL_PARSE_C)
 /*
  * Return 1 if the certificate is revoked, or 0 otherwise.
@@ -1801,7 +2152,8 @@ int mbedtls_x509_crt_is_revoked( const mbedtls_x509_crt *crt, const mbedtls_x509
  */
 static int x509_crt_verifycrl( mbedtls_x509_crt *crt, mbedtls_x509_crt *ca,
                                mbedtls_x509_crl *crl_list,
-                               const mbedtls_x509_crt_profile *profile )
+                               const mbedtls_x509_crt_profile *profile,
+                               mbedtls_x509_crt_verify_cache *cache )
 {
     int flags = 0;
     unsigned char hash[MBEDTLS_MD_MAX_SIZE];
@@ -1851,9 +2203,11 @@ static int x509_crt_verifycrl( mbedtls_x509_crt *crt, mbedtls_x509_crt *ca,
         if( x509_profile_check_key( profile, &ca->pk ) != 0 )
             flags |= MBEDTLS_X509_BADCERT_BAD_KEY;
 
-        if( mbedtls_pk_verify_ext( crl_list->sig_pk, crl_list->sig_opts, &ca->pk,
+        if( x509_crt_verify_sig( crl_list->sig_pk, crl_list->sig_opts, ca,
                            crl_list->sig_md, hash, mbedtls_md_get_size( md_info ),
-                           crl_list->sig.p, crl_list->sig.len ) != 0 )
+                           &crl_list->sig, crl_list->next_update.year == 0 ?
+                           &ca->valid_to : &crl_list->next_update,
+                           cache ) != 0 )
         {
             flags |= MBEDTLS_X509_BADCRL_NOT_TRUSTED;
             break;
@@ -1889,7 +2243,8 @@ static int x509_crt_verifycrl( mbedtls_x509_crt *crt, mbedtls_x509_crt *ca,
  */
 static int x509_crt_check_signature( const mbedtls_x509_crt *child,
                                      mbedtls_x509_crt *parent,
-                                     mbedtls_x509_crt_restart_ctx *rs_ctx )
+                                     mbedtls_x509_crt_restart_ctx *rs_ctx,
+                                     mbedtls_x509_crt_verify_cache *cache )
 {
     const mbedtls_md_info_t *md_info;
     unsigned char hash[MBEDTLS_MD_MAX_SIZE];
@@ -1916,9 +2271,9 @@ static int x509_crt_check_signature( const mbedtls_x509_crt *child,
     (void) rs_ctx;
 #endif
 
-    return( mbedtls_pk_verify_ext( child->sig_pk, child->sig_opts, &parent->pk,
+    return( x509_crt_verify_sig( child->sig_pk, child->sig_opts, parent,
                 child->sig_md, hash, mbedtls_md_get_size( md_info ),
-                child->sig.p, child->sig.len ) );
+                &child->sig, &child->valid_to, cache ) );
 }
 
 /*
@@ -1996,6 +2351,7 @@ static int x509_crt_check_parent( const mbedtls_x509_crt *child,
  *  - [in] self_cnt: number of self-signed intermediates seen so far
  *         (will never be greater than path_cnt)
  *  - [in-out] rs_ctx: context for restarting operations
+ *  - [in-out] cache: verification cache, or NULL
  *
  * Return value:
  *  - 0 on success
@@ -2009,7 +2365,8 @@ static int x509_crt_find_parent_in(
                         int top,
                         unsigned path_cnt,
                         unsigned self_cnt,
-                        mbedtls_x509_crt_restart_ctx *rs_ctx )
+                        mbedtls_x509_crt_restart_ctx *rs_ctx,
+                        mbedtls_x509_crt_verify_cache *cache )
 {
     int ret;
     mbedtls_x509_crt *parent, *fallback_parent;
@@ -2054,7 +2411,7 @@ static int x509_crt_find_parent_in(
 #if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
 check_signature:
 #endif
-        ret = x509_crt_check_signature( child, parent, rs_ctx );
+        ret = x509_crt_check_signature( child, parent, rs_ctx, cache );
 
 #if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
         if( rs_ctx != NULL && ret == MBEDTLS_ERR_ECP_IN_PROGRESS )
@@ -2119,6 +2476,7 @@ check_signature:
  *  - [in] self_cnt: number of self-signed certs in the chain so far
  *         (will always be no greater than path_cnt)
  *  - [in-out] rs_ctx: context for restarting operations
+ *  - [in-out] cache: verification cache, or NULL
  *
  * Return value:
  *  - 0 on success
@@ -2132,7 +2490,8 @@ static int x509_crt_find_parent(
                         int *signature_is_good,
                         unsigned path_cnt,
                         unsigned self_cnt,
-                        mbedtls_x509_crt_restart_ctx *rs_ctx )
+                        mbedtls_x509_crt_restart_ctx *rs_ctx,
+                        mbedtls_x509_crt_verify_cache *cache )
 {
     int ret;
     mbedtls_x509_crt *search_list;
@@ -2154,7 +2513,7 @@ static int x509_crt_find_parent(
         ret = x509_crt_find_parent_in( child, search_list,
                                        parent, signature_is_good,
                                        *parent_is_trusted,
-                                       path_cnt, self_cnt, rs_ctx );
+                                       path_cnt, self_cnt, rs_ctx, cache );
 
 #if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
         if( rs_ctx != NULL && ret == MBEDTLS_ERR_ECP_IN_PROGRESS )
@@ -2249,6 +2608,7 @@ static int x509_crt_check_ee_locally_trusted(
  *      Only valid when return value is 0, may contain garbage otherwise!
  *      Restart note: need not be the same when calling again to resume.
  *  - [in-out] rs_ctx: context for restarting operations
+ *  - [in-out] cache: verification cache, or NULL
  *
  * Return value:
  *  - non-zero if the chain could not be fully built and examined
@@ -2261,7 +2621,8 @@ static int x509_crt_verify_chain(
                 mbedtls_x509_crl *ca_crl,
                 const mbedtls_x509_crt_profile *profile,
                 mbedtls_x509_crt_verify_chain *ver_chain,
-                mbedtls_x509_crt_restart_ctx *rs_ctx )
+                mbedtls_x509_crt_restart_ctx *rs_ctx,
+                mbedtls_x509_crt_verify_cache *cache )
 {
     /* Don't initialize any of those variables here, so that the compiler can
      * catch potential issues with jumping ahead when restarting */
@@ -2336,7 +2697,8 @@ find_parent:
         /* Look for a parent in trusted CAs or up the chain */
         ret = x509_crt_find_parent( child, trust_ca, &parent,
                                        &parent_is_trusted, &signature_is_good,
-                                       ver_chain->len - 1, self_cnt, rs_ctx );
+                                       ver_chain->len - 1, self_cnt, rs_ctx,
+                                       cache );
 
 #if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
         if( rs_ctx != NULL && ret == MBEDTLS_ERR_ECP_IN_PROGRESS )
@@ -2387,7 +2749,7 @@ find_parent:
 
 #if defined(MBEDTLS_X509_CRL_PARSE_C)
         /* Check trusted CA's CRL for the given crt */
-        *flags |= x509_crt_verifycrl( child, parent, ca_crl, profile );
+        *flags |= x509_crt_verifycrl( child, parent, ca_crl, profile, cache );
 #else
         (void) ca_crl;
 #endif
@@ -2520,7 +2882,7 @@ int mbedtls_x509_crt_verify_with_profile( mbedtls_x509_crt *crt,
 }
 
 /*
- * Verify the certificate validity, with profile, restartable version
+ * Verify the certificate validity, with profile, restartable and/or cached
  *
  * This function:
  *  - checks the requested CN (if any)
@@ -2529,14 +2891,15 @@ int mbedtls_x509_crt_verify_with_profile( mbedtls_x509_crt *crt,
  *  - builds and verifies the chain
  *  - then calls the callback and merges the flags
  */
-int mbedtls_x509_crt_verify_restartable( mbedtls_x509_crt *crt,
+static int x509_crt_verify_common( mbedtls_x509_crt *crt,
                      mbedtls_x509_crt *trust_ca,
                      mbedtls_x509_crl *ca_crl,
                      const mbedtls_x509_crt_profile *profile,
                      const char *cn, uint32_t *flags,
                      int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
                      void *p_vrfy,
-                     mbedtls_x509_crt_restart_ctx *rs_ctx )
+                     mbedtls_x509_crt_restart_ctx *rs_ctx,
+                     mbedtls_x509_crt_verify_cache *cache )
 {
     int ret;
     mbedtls_pk_type_t pk_type;
@@ -2568,7 +2931,7 @@ int mbedtls_x509_crt_verify_restartable( mbedtls_x509_crt *crt,
 
     /* Check the chain */
     ret = x509_crt_verify_chain( crt, trust_ca, ca_crl, profile,
-                                 &ver_chain, rs_ctx );
+                                 &ver_chain, rs_ctx, cache );
 
     if( ret != 0 )
         goto exit;
@@ -2603,6 +2966,40 @@ exit:
     return( 0 );
 }
 
+/*
+ * Verify the certificate validity, with profile, restartable version
+ */
+int mbedtls_x509_crt_verify_restartable( mbedtls_x509_crt *crt,
+                     mbedtls_x509_crt *trust_ca,
+                     mbedtls_x509_crl *ca_crl,
+                     const mbedtls_x509_crt_profile *profile,
+                     const char *cn, uint32_t *flags,
+                     int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
+                     void *p_vrfy,
+                     mbedtls_x509_crt_restart_ctx *rs_ctx )
+{
+    return( x509_crt_verify_common( crt, trust_ca, ca_crl, profile, cn, flags,
+                                    f_vrfy, p_vrfy, rs_ctx, NULL ) );
+}
+
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE)
+/*
+ * Verify the certificate validity, with profile, cached version
+ */
+int mbedtls_x509_crt_verify_with_cache( mbedtls_x509_crt *crt,
+                     mbedtls_x509_crt *trust_ca,
+                     mbedtls_x509_crl *ca_crl,
+                     const mbedtls_x509_crt_profile *profile,
+                     const char *cn, uint32_t *flags,
+                     int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
+                     void *p_vrfy,
+                     mbedtls_x509_crt_verify_cache *cache )
+{
+    return( x509_crt_verify_common( crt, trust_ca, ca_crl, profile, cn, flags,
+                                    f_vrfy, p_vrfy, NULL, cache ) );
+}
+#endif /* MBEDTLS_X509_CRT_VERIFY_CACHE */
+
 /*
  * Initialize a certificate chain
  */
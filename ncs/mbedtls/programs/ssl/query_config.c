@@ -978,6 +978,14 @@ int query_config( const char *config )
     }
 #endif /* MBEDTLS_ECP_NIST_OPTIM */
 
+#if defined(MBEDTLS_ECP_P256_FIXED_LIMBS)
+    if( strcmp( "MBEDTLS_ECP_P256_FIXED_LIMBS", config ) == 0 )
+    {
+        MACRO_EXPANSION_TO_STR( MBEDTLS_ECP_P256_FIXED_LIMBS );
+        return( 0 );
+    }
+#endif /* MBEDTLS_ECP_P256_FIXED_LIMBS */
+
 #if defined(MBEDTLS_ECP_RESTARTABLE)
     if( strcmp( "MBEDTLS_ECP_RESTARTABLE", config ) == 0 )
     {
@@ -1162,6 +1170,14 @@ int query_config( const char *config )
     }
 #endif /* MBEDTLS_MEMORY_BACKTRACE */
 
+#if defined(MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB)
+    if( strcmp( "MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB", config ) == 0 )
+    {
+        MACRO_EXPANSION_TO_STR( MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB );
+        return( 0 );
+    }
+#endif /* MBEDTLS_MEMORY_BUFFER_ALLOC_SLAB */
+
 #if defined(MBEDTLS_PK_RSA_ALT_SUPPORT)
     if( strcmp( "MBEDTLS_PK_RSA_ALT_SUPPORT", config ) == 0 )
     {
@@ -1490,6 +1506,14 @@ int query_config( const char *config )
     }
 #endif /* MBEDTLS_X509_RSASSA_PSS_SUPPORT */
 
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE)
+    if( strcmp( "MBEDTLS_X509_CRT_VERIFY_CACHE", config ) == 0 )
+    {
+        MACRO_EXPANSION_TO_STR( MBEDTLS_X509_CRT_VERIFY_CACHE );
+        return( 0 );
+    }
+#endif /* MBEDTLS_X509_CRT_VERIFY_CACHE */
+
 #if defined(MBEDTLS_ZLIB_SUPPORT)
     if( strcmp( "MBEDTLS_ZLIB_SUPPORT", config ) == 0 )
     {
@@ -2210,6 +2234,14 @@ int query_config( const char *config )
     }
 #endif /* MBEDTLS_MEMORY_ALIGN_MULTIPLE */
 
+#if defined(MBEDTLS_MEMORY_SLAB_SIZE)
+    if( strcmp( "MBEDTLS_MEMORY_SLAB_SIZE", config ) == 0 )
+    {
+        MACRO_EXPANSION_TO_STR( MBEDTLS_MEMORY_SLAB_SIZE );
+        return( 0 );
+    }
+#endif /* MBEDTLS_MEMORY_SLAB_SIZE */
+
 #if defined(MBEDTLS_PLATFORM_STD_MEM_HDR)
     if( strcmp( "MBEDTLS_PLATFORM_STD_MEM_HDR", config ) == 0 )
     {
@@ -2410,6 +2442,14 @@ int query_config( const char *config )
     }
 #endif /* MBEDTLS_SSL_CACHE_DEFAULT_MAX_ENTRIES */
 
+#if defined(MBEDTLS_SSL_CACHE_SHARDS)
+    if( strcmp( "MBEDTLS_SSL_CACHE_SHARDS", config ) == 0 )
+    {
+        MACRO_EXPANSION_TO_STR( MBEDTLS_SSL_CACHE_SHARDS );
+        return( 0 );
+    }
+#endif /* MBEDTLS_SSL_CACHE_SHARDS */
+
 #if defined(MBEDTLS_SSL_MAX_CONTENT_LEN)
     if( strcmp( "MBEDTLS_SSL_MAX_CONTENT_LEN", config ) == 0 )
     {
@@ -2482,6 +2522,14 @@ int query_config( const char *config )
     }
 #endif /* MBEDTLS_X509_MAX_FILE_PATH_LEN */
 
+#if defined(MBEDTLS_X509_CRT_VERIFY_CACHE_DEFAULT_MAX_ENTRIES)
+    if( strcmp( "MBEDTLS_X509_CRT_VERIFY_CACHE_DEFAULT_MAX_ENTRIES", config ) == 0 )
+    {
+        MACRO_EXPANSION_TO_STR( MBEDTLS_X509_CRT_VERIFY_CACHE_DEFAULT_MAX_ENTRIES );
+        return( 0 );
+    }
+#endif /* MBEDTLS_X509_CRT_VERIFY_CACHE_DEFAULT_MAX_ENTRIES */
+
 #if defined(MBEDTLS_TLS_DEFAULT_ALLOW_SHA1_IN_CERTIFICATES)
     if( strcmp( "MBEDTLS_TLS_DEFAULT_ALLOW_SHA1_IN_CERTIFICATES", config ) == 0 )
     {
@@ -0,0 +1,661 @@
+/*
+ *  Allocation benchmark driven by TLS handshakes: records the calloc/free
+ *  calls of a handshake, then replays them and runs real handshakes on the
+ *  buffer allocator, from several threads if available.
+ *
+ *  Copyright (C) 2006-2015, ARM Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdio.h>
+#include <stdlib.h>
+#define mbedtls_printf          printf
+#define MBEDTLS_EXIT_SUCCESS    EXIT_SUCCESS
+#define MBEDTLS_EXIT_FAILURE    EXIT_FAILURE
+#endif
+
+#if !defined(MBEDTLS_MEMORY_BUFFER_ALLOC_C) || !defined(MBEDTLS_CERTS_C) ||  \
+    !defined(MBEDTLS_ENTROPY_C) || !defined(MBEDTLS_CTR_DRBG_C) ||          \
+    !defined(MBEDTLS_SSL_CLI_C) || !defined(MBEDTLS_SSL_SRV_C) ||           \
+    !defined(MBEDTLS_X509_CRT_PARSE_C) || !defined(MBEDTLS_PEM_PARSE_C) ||  \
+    !defined(MBEDTLS_ECDSA_C) || !defined(MBEDTLS_TIMING_C)
+int main( void )
+{
+    mbedtls_printf("MBEDTLS_MEMORY_BUFFER_ALLOC_C and/or MBEDTLS_CERTS_C and/or "
+           "MBEDTLS_ENTROPY_C and/or MBEDTLS_CTR_DRBG_C and/or "
+           "MBEDTLS_SSL_CLI_C and/or MBEDTLS_SSL_SRV_C and/or "
+           "MBEDTLS_X509_CRT_PARSE_C and/or MBEDTLS_PEM_PARSE_C and/or "
+           "MBEDTLS_ECDSA_C and/or MBEDTLS_TIMING_C not defined.\n");
+    return( 0 );
+}
+#else
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mbedtls/memory_buffer_alloc.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/certs.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/timing.h"
+
+#if defined(MBEDTLS_THREADING_PTHREAD)
+#include <pthread.h>
+#define MAX_THREADS             16
+#else
+#define MAX_THREADS             1
+#endif
+
+#define MAX_HEAP_SIZE           ( 4 * 1024 * 1024 )
+#define MAX_EVENTS              1048576
+#define MAX_SLOTS               4096
+#define PIPE_SIZE               ( 2 * MBEDTLS_SSL_MAX_CONTENT_LEN )
+
+#define DFL_THREADS             1
+#define DFL_HANDSHAKES          100
+#define DFL_ROUNDS              2000
+#define DFL_HEAP_SIZE           ( 1024 * 1024 )
+
+#define USAGE \
+    "\n usage: ssl_alloc_bench param=<>...\n"                   \
+    "\n acceptable parameters:\n"                               \
+    "    threads=%%d           default: 1 (max %d)\n"           \
+    "    handshakes=%%d        default: 100\n"                  \
+    "    rounds=%%d            default: 2000\n"                 \
+    "                        replays of the handshake allocations\n" \
+    "    heap_size=%%d         default: 1048576 (max 4194304)\n" \
+    "\n"
+
+/*
+ * global options
+ */
+struct options
+{
+    int threads;                /* number of concurrent threads         */
+    int handshakes;             /* handshakes, all threads              */
+    int rounds;                 /* replays of the trace, all threads    */
+    int heap_size;              /* bytes of the buffer allocator        */
+} opt;
+
+/*
+ * Allocations of one handshake, in order. A free has a zero size, and
+ * releases the allocation recorded in the same slot.
+ */
+typedef struct
+{
+    size_t size;
+    int slot;
+} alloc_event_t;
+
+static alloc_event_t trace[MAX_EVENTS];
+static int trace_len;
+static int trace_slots;
+static int trace_overflow;
+static void *trace_live[MAX_SLOTS];
+static int tracing;
+
+static unsigned char alloc_buf[MAX_HEAP_SIZE];
+
+static void *trace_calloc( size_t n, size_t size )
+{
+    void *p = calloc( n, size );
+    int slot;
+
+    if( p == NULL || ! tracing )
+        return( p );
+
+    for( slot = 0; slot < MAX_SLOTS && trace_live[slot] != NULL; slot++ );
+
+    if( slot == MAX_SLOTS || trace_len == MAX_EVENTS )
+    {
+        trace_overflow = 1;
+        return( p );
+    }
+
+    trace_live[slot] = p;
+    trace[trace_len].size = n * size;
+    trace[trace_len].slot = slot;
+    trace_len++;
+
+    if( slot >= trace_slots )
+        trace_slots = slot + 1;
+
+    return( p );
+}
+
+static void trace_free( void *p )
+{
+    int slot;
+
+    if( p != NULL && tracing )
+    {
+        /* Frees of memory allocated before the trace are left out */
+        for( slot = 0; slot < trace_slots && trace_live[slot] != p; slot++ );
+
+        if( slot < trace_slots && trace_len < MAX_EVENTS )
+        {
+            trace_live[slot] = NULL;
+            trace[trace_len].size = 0;
+            trace[trace_len].slot = slot;
+            trace_len++;
+        }
+        else if( slot < trace_slots )
+            trace_overflow = 1;
+    }
+
+    free( p );
+}
+
+/*
+ * In-memory transport between the client and the server of a thread
+ */
+typedef struct
+{
+    unsigned char buf[PIPE_SIZE];
+    size_t start;
+    size_t end;
+} pipe_t;
+
+typedef struct
+{
+    pipe_t *in;
+    pipe_t *out;
+} endpoint_t;
+
+static int pipe_send( void *ctx, const unsigned char *buf, size_t len )
+{
+    pipe_t *out = ( (endpoint_t *) ctx )->out;
+
+    if( out->start == out->end )
+        out->start = out->end = 0;
+
+    if( len > PIPE_SIZE - out->end )
+        len = PIPE_SIZE - out->end;
+
+    if( len == 0 )
+        return( MBEDTLS_ERR_SSL_WANT_WRITE );
+
+    memcpy( out->buf + out->end, buf, len );
+    out->end += len;
+
+    return( (int) len );
+}
+
+static int pipe_recv( void *ctx, unsigned char *buf, size_t len )
+{
+    pipe_t *in = ( (endpoint_t *) ctx )->in;
+
+    if( in->start == in->end )
+        return( MBEDTLS_ERR_SSL_WANT_READ );
+
+    if( len > in->end - in->start )
+        len = in->end - in->start;
+
+    memcpy( buf, in->buf + in->start, len );
+    in->start += len;
+
+    return( (int) len );
+}
+
+/*
+ * The threads share the entropy source only: the EC keys and certificates
+ * cache precomputed points in their group, which is not thread-safe
+ */
+static mbedtls_entropy_context entropy;
+
+typedef struct
+{
+    mbedtls_ctr_drbg_context ctr_drbg;
+    mbedtls_x509_crt cacert;
+    mbedtls_x509_crt srvcert;
+    mbedtls_pk_context pkey;
+    mbedtls_ssl_config cli_conf;
+    mbedtls_ssl_config srv_conf;
+    int handshakes;
+    int rounds;
+    unsigned long failures;
+} thread_info_t;
+
+static thread_info_t info[MAX_THREADS];
+
+static int thread_setup( thread_info_t *ti, int i )
+{
+    int ret;
+    unsigned char pers[] = "ssl_alloc_bench_0";
+
+    mbedtls_ctr_drbg_init( &ti->ctr_drbg );
+    mbedtls_x509_crt_init( &ti->cacert );
+    mbedtls_x509_crt_init( &ti->srvcert );
+    mbedtls_pk_init( &ti->pkey );
+    mbedtls_ssl_config_init( &ti->cli_conf );
+    mbedtls_ssl_config_init( &ti->srv_conf );
+    ti->failures = 0;
+
+    pers[sizeof( pers ) - 2] += (unsigned char) i;
+
+    if( ( ret = mbedtls_ctr_drbg_seed( &ti->ctr_drbg, mbedtls_entropy_func,
+                                       &entropy, pers, sizeof( pers ) ) ) != 0 ||
+        ( ret = mbedtls_x509_crt_parse( &ti->cacert,
+                    (const unsigned char *) mbedtls_test_cas_pem,
+                    mbedtls_test_cas_pem_len ) ) != 0 ||
+        ( ret = mbedtls_x509_crt_parse( &ti->srvcert,
+                    (const unsigned char *) mbedtls_test_srv_crt_ec,
+                    mbedtls_test_srv_crt_ec_len ) ) != 0 ||
+        ( ret = mbedtls_pk_parse_key( &ti->pkey,
+                    (const unsigned char *) mbedtls_test_srv_key_ec,
+                    mbedtls_test_srv_key_ec_len, NULL, 0 ) ) != 0 ||
+        ( ret = mbedtls_ssl_config_defaults( &ti->cli_conf,
+                    MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+                    MBEDTLS_SSL_PRESET_DEFAULT ) ) != 0 ||
+        ( ret = mbedtls_ssl_config_defaults( &ti->srv_conf,
+                    MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_STREAM,
+                    MBEDTLS_SSL_PRESET_DEFAULT ) ) != 0 ||
+        ( ret = mbedtls_ssl_conf_own_cert( &ti->srv_conf, &ti->srvcert,
+                                           &ti->pkey ) ) != 0 )
+    {
+        mbedtls_printf( " failed\n  ! thread setup returned -0x%04x\n\n", -ret );
+        return( ret );
+    }
+
+    /* The chain is verified as by a real client, the test certificates may
+     * have expired though */
+    mbedtls_ssl_conf_authmode( &ti->cli_conf, MBEDTLS_SSL_VERIFY_OPTIONAL );
+    mbedtls_ssl_conf_ca_chain( &ti->cli_conf, &ti->cacert, NULL );
+    mbedtls_ssl_conf_rng( &ti->cli_conf, mbedtls_ctr_drbg_random, &ti->ctr_drbg );
+    mbedtls_ssl_conf_rng( &ti->srv_conf, mbedtls_ctr_drbg_random, &ti->ctr_drbg );
+
+    return( 0 );
+}
+
+static void thread_free( thread_info_t *ti )
+{
+    mbedtls_ssl_config_free( &ti->srv_conf );
+    mbedtls_ssl_config_free( &ti->cli_conf );
+    mbedtls_pk_free( &ti->pkey );
+    mbedtls_x509_crt_free( &ti->srvcert );
+    mbedtls_x509_crt_free( &ti->cacert );
+    mbedtls_ctr_drbg_free( &ti->ctr_drbg );
+}
+
+/*
+ * Full handshake between a client and a server of the thread, stepped in
+ * turn until both are done
+ */
+static int handshake( thread_info_t *ti, pipe_t pipes[2] )
+{
+    mbedtls_ssl_context cli, srv;
+    endpoint_t cli_end = { &pipes[1], &pipes[0] };
+    endpoint_t srv_end = { &pipes[0], &pipes[1] };
+    int cli_ret = MBEDTLS_ERR_SSL_WANT_READ;
+    int srv_ret = MBEDTLS_ERR_SSL_WANT_READ;
+    int steps, ret;
+
+    pipes[0].start = pipes[0].end = 0;
+    pipes[1].start = pipes[1].end = 0;
+
+    mbedtls_ssl_init( &cli );
+    mbedtls_ssl_init( &srv );
+
+    if( ( ret = mbedtls_ssl_setup( &cli, &ti->cli_conf ) ) != 0 ||
+        ( ret = mbedtls_ssl_setup( &srv, &ti->srv_conf ) ) != 0 ||
+        ( ret = mbedtls_ssl_set_hostname( &cli, "localhost" ) ) != 0 )
+    {
+        goto exit;
+    }
+
+    mbedtls_ssl_set_bio( &cli, &cli_end, pipe_send, pipe_recv, NULL );
+    mbedtls_ssl_set_bio( &srv, &srv_end, pipe_send, pipe_recv, NULL );
+
+    for( steps = 0; steps < 100 && ( cli_ret != 0 || srv_ret != 0 ); steps++ )
+    {
+        if( cli_ret != 0 )
+            cli_ret = mbedtls_ssl_handshake( &cli );
+        if( srv_ret != 0 )
+            srv_ret = mbedtls_ssl_handshake( &srv );
+
+        if( ( cli_ret != 0 && cli_ret != MBEDTLS_ERR_SSL_WANT_READ &&
+              cli_ret != MBEDTLS_ERR_SSL_WANT_WRITE ) ||
+            ( srv_ret != 0 && srv_ret != MBEDTLS_ERR_SSL_WANT_READ &&
+              srv_ret != MBEDTLS_ERR_SSL_WANT_WRITE ) )
+        {
+            break;
+        }
+    }
+
+    ret = ( cli_ret != 0 ) ? cli_ret : srv_ret;
+
+exit:
+    mbedtls_ssl_free( &srv );
+    mbedtls_ssl_free( &cli );
+
+    return( ret );
+}
+
+static void *handshake_worker( void *data )
+{
+    thread_info_t *ti = (thread_info_t *) data;
+    pipe_t *pipes;
+    int i;
+
+    /* The pipes are not part of the measured allocations */
+    pipes = calloc( 2, sizeof( pipe_t ) );
+    if( pipes == NULL )
+    {
+        ti->failures = ti->handshakes;
+        return( NULL );
+    }
+
+    for( i = 0; i < ti->handshakes; i++ )
+    {
+        if( handshake( ti, pipes ) != 0 )
+            ti->failures++;
+    }
+
+    free( pipes );
+
+    return( NULL );
+}
+
+static void *replay_worker( void *data )
+{
+    thread_info_t *ti = (thread_info_t *) data;
+    unsigned char **slots;
+    int i, r;
+
+    slots = calloc( trace_slots, sizeof( unsigned char * ) );
+    if( slots == NULL )
+    {
+        ti->failures = ti->rounds;
+        return( NULL );
+    }
+
+    for( r = 0; r < ti->rounds; r++ )
+    {
+        for( i = 0; i < trace_len; i++ )
+        {
+            if( trace[i].size != 0 )
+            {
+                slots[trace[i].slot] = mbedtls_calloc( 1, trace[i].size );
+                if( slots[trace[i].slot] == NULL )
+                    ti->failures++;
+                else
+                    slots[trace[i].slot][0] = (unsigned char) i;
+            }
+            else
+            {
+                mbedtls_free( slots[trace[i].slot] );
+                slots[trace[i].slot] = NULL;
+            }
+        }
+
+        /* Memory kept beyond the handshake goes at the end of the round */
+        for( i = 0; i < trace_slots; i++ )
+        {
+            mbedtls_free( slots[i] );
+            slots[i] = NULL;
+        }
+    }
+
+    free( slots );
+
+    return( NULL );
+}
+
+/*
+ * Run one of the workers on all the threads
+ */
+static unsigned long run_threads( void *(*worker)( void * ) )
+{
+    struct mbedtls_timing_hr_time timer;
+#if defined(MBEDTLS_THREADING_PTHREAD)
+    pthread_t threads[MAX_THREADS];
+    int i, started;
+#endif
+
+    (void) mbedtls_timing_get_timer( &timer, 1 );
+
+#if defined(MBEDTLS_THREADING_PTHREAD)
+    for( started = 0; started < opt.threads; started++ )
+    {
+        if( pthread_create( &threads[started], NULL, worker,
+                            &info[started] ) != 0 )
+        {
+            /* Run it here instead */
+            worker( &info[started] );
+            break;
+        }
+    }
+
+    for( i = 0; i < started; i++ )
+        pthread_join( threads[i], NULL );
+#else
+    worker( &info[0] );
+#endif
+
+    return( mbedtls_timing_get_timer( &timer, 0 ) );
+}
+
+int main( int argc, char *argv[] )
+{
+    int ret = 1;
+    int exit_code = MBEDTLS_EXIT_FAILURE;
+    int i, nb_setup = 0;
+    int nb_alloc = 0, nb_small = 0;
+    unsigned long failures, ms;
+    pipe_t *pipes = NULL;
+#if defined(MBEDTLS_MEMORY_DEBUG)
+    size_t max_used, max_blocks, cur_used, cur_blocks;
+#endif
+    char *p, *q;
+
+    opt.threads             = DFL_THREADS;
+    opt.handshakes          = DFL_HANDSHAKES;
+    opt.rounds              = DFL_ROUNDS;
+    opt.heap_size           = DFL_HEAP_SIZE;
+
+    for( i = 1; i < argc; i++ )
+    {
+        p = argv[i];
+        if( ( q = strchr( p, '=' ) ) == NULL )
+            goto usage;
+        *q++ = '\0';
+
+        if( strcmp( p, "threads" ) == 0 )
+        {
+            opt.threads = atoi( q );
+            if( opt.threads < 1 || opt.threads > MAX_THREADS )
+                goto usage;
+        }
+        else if( strcmp( p, "handshakes" ) == 0 )
+        {
+            opt.handshakes = atoi( q );
+            if( opt.handshakes < 0 )
+                goto usage;
+        }
+        else if( strcmp( p, "rounds" ) == 0 )
+        {
+            opt.rounds = atoi( q );
+            if( opt.rounds < 0 )
+                goto usage;
+        }
+        else if( strcmp( p, "heap_size" ) == 0 )
+        {
+            opt.heap_size = atoi( q );
+            if( opt.heap_size < 1024 || opt.heap_size > MAX_HEAP_SIZE )
+                goto usage;
+        }
+        else
+        {
+        usage:
+            mbedtls_printf( USAGE, MAX_THREADS );
+            return( exit_code );
+        }
+    }
+
+    /*
+     * 1. Record the allocations of a handshake, on the libc heap
+     */
+    mbedtls_printf( "\n  . Recording the allocations of a handshake..." );
+    fflush( stdout );
+
+    mbedtls_platform_set_calloc_free( trace_calloc, trace_free );
+
+    pipes = calloc( 2, sizeof( pipe_t ) );
+    if( pipes == NULL )
+    {
+        mbedtls_printf( " failed\n  ! out of memory\n\n" );
+        goto exit;
+    }
+
+    mbedtls_entropy_init( &entropy );
+
+    if( ( ret = thread_setup( &info[0], 0 ) ) != 0 )
+    {
+        nb_setup = 1;
+        goto exit;
+    }
+
+    tracing = 1;
+    ret = handshake( &info[0], pipes );
+    tracing = 0;
+
+    thread_free( &info[0] );
+    mbedtls_entropy_free( &entropy );
+
+    if( ret != 0 || trace_overflow )
+    {
+        mbedtls_printf( " failed\n  ! handshake returned -0x%04x%s\n\n", -ret,
+                        trace_overflow ? ", too many allocations" : "" );
+        goto exit;
+    }
+
+    for( i = 0; i < trace_len; i++ )
+    {
+        if( trace[i].size == 0 )
+            continue;
+
+        nb_alloc++;
+        if( trace[i].size <= 256 )
+            nb_small++;
+    }
+
+    mbedtls_printf( " ok (%d allocations, %d of them up to 256 bytes)\n",
+                    nb_alloc, nb_small );
+
+    /*
+     * 2. Switch to the buffer allocator
+     */
+    mbedtls_printf( "  . Setting up %d threads on a %d bytes heap...",
+                    opt.threads, opt.heap_size );
+    fflush( stdout );
+
+    mbedtls_memory_buffer_alloc_init( alloc_buf, opt.heap_size );
+
+    mbedtls_entropy_init( &entropy );
+
+    for( nb_setup = 0; nb_setup < opt.threads; nb_setup++ )
+    {
+        info[nb_setup].handshakes = opt.handshakes / opt.threads;
+        info[nb_setup].rounds = opt.rounds / opt.threads;
+
+        if( ( ret = thread_setup( &info[nb_setup], nb_setup ) ) != 0 )
+        {
+            nb_setup++;
+            goto exit;
+        }
+    }
+
+    mbedtls_printf( " ok\n" );
+
+    /*
+     * 3. Replay the handshake allocations
+     */
+    mbedtls_printf( "  . Replaying %d handshakes worth of allocations...",
+                    opt.threads * ( opt.rounds / opt.threads ) );
+    fflush( stdout );
+
+    ms = run_threads( replay_worker );
+
+    for( i = 0, failures = 0; i < opt.threads; i++ )
+        failures += info[i].failures;
+
+    mbedtls_printf( " ok\n  . %lu ms, %.0f allocations/s, %lu failed\n", ms,
+                    ms == 0 ? 0.0 : (double) opt.threads *
+                        ( opt.rounds / opt.threads ) * nb_alloc * 1000 / ms,
+                    failures );
+
+    /*
+     * 4. Run real handshakes
+     */
+    for( i = 0; i < opt.threads; i++ )
+        info[i].failures = 0;
+
+    mbedtls_printf( "  . Running %d handshakes...",
+                    opt.threads * ( opt.handshakes / opt.threads ) );
+    fflush( stdout );
+
+    ms = run_threads( handshake_worker );
+
+    for( i = 0, failures = 0; i < opt.threads; i++ )
+        failures += info[i].failures;
+
+    mbedtls_printf( " ok\n  . %lu ms, %.1f handshakes/s, %lu failed\n", ms,
+                    ms == 0 ? 0.0 : (double) opt.threads *
+                        ( opt.handshakes / opt.threads ) * 1000 / ms,
+                    failures );
+
+#if defined(MBEDTLS_MEMORY_DEBUG)
+    mbedtls_memory_buffer_alloc_max_get( &max_used, &max_blocks );
+    mbedtls_memory_buffer_alloc_cur_get( &cur_used, &cur_blocks );
+    mbedtls_printf( "  . heap peak %zu bytes in %zu blocks, now %zu bytes in %zu blocks\n",
+                    max_used, max_blocks, cur_used, cur_blocks );
+#endif
+
+    mbedtls_printf( "\n" );
+
+    if( failures == 0 )
+        exit_code = MBEDTLS_EXIT_SUCCESS;
+
+exit:
+    for( i = 0; i < nb_setup; i++ )
+        thread_free( &info[i] );
+    mbedtls_entropy_free( &entropy );
+    free( pipes );
+
+#if defined(_WIN32)
+    mbedtls_printf( "  + Press Enter to exit this program.\n" );
+    fflush( stdout ); getchar();
+#endif
+
+    return( exit_code );
+}
+
+#endif /* MBEDTLS_MEMORY_BUFFER_ALLOC_C && MBEDTLS_CERTS_C &&
+          MBEDTLS_ENTROPY_C && MBEDTLS_CTR_DRBG_C && MBEDTLS_SSL_CLI_C &&
+          MBEDTLS_SSL_SRV_C && MBEDTLS_X509_CRT_PARSE_C &&
+          MBEDTLS_PEM_PARSE_C && MBEDTLS_ECDSA_C && MBEDTLS_TIMING_C */
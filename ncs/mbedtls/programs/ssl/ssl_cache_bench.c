@@ -0,0 +1,338 @@
+/*
+ *  Session cache benchmark: several threads resuming and storing sessions
+ *  concurrently, as the ssl_cache callbacks of a multi-threaded server.
+ *
+ *  Copyright (C) 2006-2015, ARM Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdio.h>
+#include <stdlib.h>
+#define mbedtls_calloc          calloc
+#define mbedtls_free            free
+#define mbedtls_printf          printf
+#define mbedtls_exit            exit
+#define MBEDTLS_EXIT_SUCCESS    EXIT_SUCCESS
+#define MBEDTLS_EXIT_FAILURE    EXIT_FAILURE
+#endif
+
+#if !defined(MBEDTLS_SSL_CACHE_C) || !defined(MBEDTLS_SSL_SRV_C) ||        \
+    !defined(MBEDTLS_TIMING_C) || !defined(MBEDTLS_THREADING_C) ||        \
+    !defined(MBEDTLS_THREADING_PTHREAD)
+int main( void )
+{
+    mbedtls_printf("MBEDTLS_SSL_CACHE_C and/or MBEDTLS_SSL_SRV_C and/or "
+           "MBEDTLS_TIMING_C and/or MBEDTLS_THREADING_C and/or "
+           "MBEDTLS_THREADING_PTHREAD not defined.\n");
+    return( 0 );
+}
+#else
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "mbedtls/ssl.h"
+#include "mbedtls/ssl_cache.h"
+#include "mbedtls/timing.h"
+
+#define MAX_THREADS             64
+
+#define DFL_THREADS             4
+#define DFL_ENTRIES             10000
+#define DFL_OPERATIONS          2000000
+#define DFL_SET_PERCENT         10
+
+#define USAGE \
+    "\n usage: ssl_cache_bench param=<>...\n"                   \
+    "\n acceptable parameters:\n"                               \
+    "    threads=%%d           default: 4 (max 64)\n"           \
+    "    entries=%%d           default: 10000\n"                \
+    "    operations=%%d        default: 2000000\n"              \
+    "    set_percent=%%d       default: 10\n"                   \
+    "\n"
+
+/*
+ * global options
+ */
+struct options
+{
+    int threads;                /* number of concurrent threads         */
+    int entries;                /* cache size, split among the threads  */
+    int operations;             /* cache operations, all threads        */
+    int set_percent;            /* share of new sessions stored         */
+} opt;
+
+typedef struct
+{
+    mbedtls_ssl_cache_context *cache;
+    unsigned char (*ids)[32];   /* session IDs owned by the thread      */
+    int nb_ids;
+    int operations;
+    uint32_t seed;
+    unsigned char tag;          /* first byte of the session IDs        */
+    unsigned long failures;
+} thread_info_t;
+
+/*
+ * Session ID generator, cheap enough not to weigh on the measure
+ */
+static uint32_t xorshift32( uint32_t *state )
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return( x );
+}
+
+static void new_session_id( thread_info_t *info, unsigned char id[32] )
+{
+    size_t i;
+    uint32_t r;
+
+    for( i = 0; i < 32; i += 4 )
+    {
+        r = xorshift32( &info->seed );
+        memcpy( id + i, &r, 4 );
+    }
+
+    /* The threads draw from the same sequence, keep their IDs apart */
+    id[0] = info->tag;
+}
+
+static void session_setup( mbedtls_ssl_session *session,
+                           const unsigned char id[32] )
+{
+    mbedtls_ssl_session_init( session );
+    session->ciphersuite = MBEDTLS_TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256;
+    session->id_len = 32;
+    memcpy( session->id, id, 32 );
+}
+
+/*
+ * A resumed handshake looks the session up, a full handshake stores a new
+ * one in place of an older session of the thread.
+ */
+static void *cache_worker( void *data )
+{
+    thread_info_t *info = (thread_info_t *) data;
+    mbedtls_ssl_session session;
+    int i, k;
+
+    for( i = 0; i < info->operations; i++ )
+    {
+        k = (int) ( xorshift32( &info->seed ) % (uint32_t) info->nb_ids );
+
+        if( (int) ( xorshift32( &info->seed ) % 100 ) < opt.set_percent )
+        {
+            new_session_id( info, info->ids[k] );
+            session_setup( &session, info->ids[k] );
+            if( mbedtls_ssl_cache_set( info->cache, &session ) != 0 )
+                info->failures++;
+        }
+        else
+        {
+            session_setup( &session, info->ids[k] );
+            if( mbedtls_ssl_cache_get( info->cache, &session ) != 0 )
+                info->failures++;
+        }
+
+        mbedtls_ssl_session_free( &session );
+    }
+
+    return( NULL );
+}
+
+int main( int argc, char *argv[] )
+{
+    int ret = 1;
+    int exit_code = MBEDTLS_EXIT_FAILURE;
+    mbedtls_ssl_cache_context cache;
+    mbedtls_ssl_cache_stats stats;
+    mbedtls_ssl_session session;
+    struct mbedtls_timing_hr_time timer;
+    thread_info_t info[MAX_THREADS];
+    pthread_t threads[MAX_THREADS];
+    unsigned char (*ids)[32] = NULL;
+    unsigned long failures = 0;
+    unsigned long ms;
+    int i, j, per_thread;
+    char *p, *q;
+
+    mbedtls_ssl_cache_init( &cache );
+
+    opt.threads             = DFL_THREADS;
+    opt.entries             = DFL_ENTRIES;
+    opt.operations          = DFL_OPERATIONS;
+    opt.set_percent         = DFL_SET_PERCENT;
+
+    for( i = 1; i < argc; i++ )
+    {
+        p = argv[i];
+        if( ( q = strchr( p, '=' ) ) == NULL )
+            goto usage;
+        *q++ = '\0';
+
+        if( strcmp( p, "threads" ) == 0 )
+        {
+            opt.threads = atoi( q );
+            if( opt.threads < 1 || opt.threads > MAX_THREADS )
+                goto usage;
+        }
+        else if( strcmp( p, "entries" ) == 0 )
+        {
+            opt.entries = atoi( q );
+            if( opt.entries < 1 )
+                goto usage;
+        }
+        else if( strcmp( p, "operations" ) == 0 )
+        {
+            opt.operations = atoi( q );
+            if( opt.operations < 1 )
+                goto usage;
+        }
+        else if( strcmp( p, "set_percent" ) == 0 )
+        {
+            opt.set_percent = atoi( q );
+            if( opt.set_percent < 0 || opt.set_percent > 100 )
+                goto usage;
+        }
+        else
+            goto usage;
+    }
+
+    if( opt.entries < opt.threads )
+    {
+    usage:
+        mbedtls_printf( USAGE );
+        goto exit;
+    }
+
+    per_thread = opt.entries / opt.threads;
+
+    ids = mbedtls_calloc( (size_t) per_thread * opt.threads, 32 );
+    if( ids == NULL )
+    {
+        mbedtls_printf( " failed\n  ! out of memory\n" );
+        goto exit;
+    }
+
+    /*
+     * 1. Fill the cache
+     */
+    mbedtls_printf( "\n  . Storing %d sessions...", per_thread * opt.threads );
+    fflush( stdout );
+
+    mbedtls_ssl_cache_set_max_entries( &cache, opt.entries );
+
+    for( i = 0; i < opt.threads; i++ )
+    {
+        info[i].cache = &cache;
+        info[i].ids = ids + (size_t) i * per_thread;
+        info[i].nb_ids = per_thread;
+        info[i].operations = opt.operations / opt.threads;
+        info[i].seed = 0x9E3779B9U * (uint32_t) ( i + 1 );
+        info[i].tag = (unsigned char) i;
+        info[i].failures = 0;
+
+        for( j = 0; j < per_thread; j++ )
+        {
+            new_session_id( &info[i], info[i].ids[j] );
+            session_setup( &session, info[i].ids[j] );
+            ret = mbedtls_ssl_cache_set( &cache, &session );
+            mbedtls_ssl_session_free( &session );
+            if( ret != 0 )
+            {
+                mbedtls_printf( " failed\n  ! mbedtls_ssl_cache_set returned %d\n\n", ret );
+                goto exit;
+            }
+        }
+    }
+
+    mbedtls_printf( " ok\n" );
+
+    /*
+     * 2. Resume and store sessions from all the threads
+     */
+    mbedtls_printf( "  . Running %d operations on %d threads, %d%% stores...",
+                    opt.threads * ( opt.operations / opt.threads ),
+                    opt.threads, opt.set_percent );
+    fflush( stdout );
+
+    (void) mbedtls_timing_get_timer( &timer, 1 );
+
+    for( i = 0; i < opt.threads; i++ )
+    {
+        if( ( ret = pthread_create( &threads[i], NULL, cache_worker,
+                                    &info[i] ) ) != 0 )
+        {
+            mbedtls_printf( " failed\n  ! pthread_create returned %d\n\n", ret );
+            while( i-- > 0 )
+                pthread_join( threads[i], NULL );
+            goto exit;
+        }
+    }
+
+    for( i = 0; i < opt.threads; i++ )
+    {
+        pthread_join( threads[i], NULL );
+        failures += info[i].failures;
+    }
+
+    ms = mbedtls_timing_get_timer( &timer, 0 );
+
+    mbedtls_printf( " ok\n" );
+
+    mbedtls_ssl_cache_get_stats( &cache, &stats );
+
+    mbedtls_printf( "  . %lu ms, %.0f operations/s, %lu failed\n", ms,
+                    ms == 0 ? 0.0 : (double) opt.threads *
+                                    ( opt.operations / opt.threads ) * 1000 / ms,
+                    failures );
+    mbedtls_printf( "  . hits %lu, misses %lu, evictions %lu, expirations %lu\n\n",
+                    stats.hits, stats.misses, stats.evictions,
+                    stats.expirations );
+
+    exit_code = MBEDTLS_EXIT_SUCCESS;
+
+exit:
+    mbedtls_free( ids );
+    mbedtls_ssl_cache_free( &cache );
+
+#if defined(_WIN32)
+    mbedtls_printf( "  + Press Enter to exit this program.\n" );
+    fflush( stdout ); getchar();
+#endif
+
+    return( exit_code );
+}
+
+#endif /* MBEDTLS_SSL_CACHE_C && MBEDTLS_SSL_SRV_C && MBEDTLS_TIMING_C &&
+          MBEDTLS_THREADING_C && MBEDTLS_THREADING_PTHREAD */
@@ -0,0 +1,495 @@
+/*
+ *  Certificate verification cache benchmark: mutually authenticated
+ *  handshakes in memory, with and without a verification cache shared by
+ *  the servers of all the threads.
+ *
+ *  Copyright (C) 2006-2015, ARM Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdio.h>
+#include <stdlib.h>
+#define mbedtls_printf          printf
+#define MBEDTLS_EXIT_SUCCESS    EXIT_SUCCESS
+#define MBEDTLS_EXIT_FAILURE    EXIT_FAILURE
+#endif
+
+#if !defined(MBEDTLS_X509_CRT_VERIFY_CACHE) || !defined(MBEDTLS_CERTS_C) || \
+    !defined(MBEDTLS_ENTROPY_C) || !defined(MBEDTLS_CTR_DRBG_C) ||          \
+    !defined(MBEDTLS_SSL_CLI_C) || !defined(MBEDTLS_SSL_SRV_C) ||           \
+    !defined(MBEDTLS_PEM_PARSE_C) || !defined(MBEDTLS_ECDSA_C) ||           \
+    !defined(MBEDTLS_TIMING_C)
+int main( void )
+{
+    mbedtls_printf("MBEDTLS_X509_CRT_VERIFY_CACHE and/or MBEDTLS_CERTS_C and/or "
+           "MBEDTLS_ENTROPY_C and/or MBEDTLS_CTR_DRBG_C and/or "
+           "MBEDTLS_SSL_CLI_C and/or MBEDTLS_SSL_SRV_C and/or "
+           "MBEDTLS_PEM_PARSE_C and/or MBEDTLS_ECDSA_C and/or "
+           "MBEDTLS_TIMING_C not defined.\n");
+    return( 0 );
+}
+#else
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/certs.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/timing.h"
+
+#if defined(MBEDTLS_THREADING_PTHREAD)
+#include <pthread.h>
+#define MAX_THREADS             16
+#else
+#define MAX_THREADS             1
+#endif
+
+#define PIPE_SIZE               ( 2 * MBEDTLS_SSL_MAX_CONTENT_LEN )
+
+#define DFL_THREADS             1
+#define DFL_HANDSHAKES          100
+#define DFL_MAX_ENTRIES         MBEDTLS_X509_CRT_VERIFY_CACHE_DEFAULT_MAX_ENTRIES
+
+#define USAGE \
+    "\n usage: ssl_verify_bench param=<>...\n"                  \
+    "\n acceptable parameters:\n"                               \
+    "    threads=%%d           default: 1 (max %d)\n"           \
+    "    handshakes=%%d        default: 100, per run\n"         \
+    "    max_entries=%%d       default: %d\n"                   \
+    "\n"
+
+/*
+ * global options
+ */
+struct options
+{
+    int threads;                /* number of concurrent threads         */
+    int handshakes;             /* handshakes, all threads              */
+    int max_entries;            /* verification cache size              */
+} opt;
+
+/*
+ * In-memory transport between the client and the server of a thread
+ */
+typedef struct
+{
+    unsigned char buf[PIPE_SIZE];
+    size_t start;
+    size_t end;
+} pipe_t;
+
+typedef struct
+{
+    pipe_t *in;
+    pipe_t *out;
+} endpoint_t;
+
+static int pipe_send( void *ctx, const unsigned char *buf, size_t len )
+{
+    pipe_t *out = ( (endpoint_t *) ctx )->out;
+
+    if( out->start == out->end )
+        out->start = out->end = 0;
+
+    if( len > PIPE_SIZE - out->end )
+        len = PIPE_SIZE - out->end;
+
+    if( len == 0 )
+        return( MBEDTLS_ERR_SSL_WANT_WRITE );
+
+    memcpy( out->buf + out->end, buf, len );
+    out->end += len;
+
+    return( (int) len );
+}
+
+static int pipe_recv( void *ctx, unsigned char *buf, size_t len )
+{
+    pipe_t *in = ( (endpoint_t *) ctx )->in;
+
+    if( in->start == in->end )
+        return( MBEDTLS_ERR_SSL_WANT_READ );
+
+    if( len > in->end - in->start )
+        len = in->end - in->start;
+
+    memcpy( buf, in->buf + in->start, len );
+    in->start += len;
+
+    return( (int) len );
+}
+
+/*
+ * The threads share the entropy source and the verification cache only:
+ * the EC keys and certificates cache precomputed points in their group,
+ * which is not thread-safe
+ */
+static mbedtls_entropy_context entropy;
+static mbedtls_x509_crt_verify_cache cache;
+
+typedef struct
+{
+    mbedtls_ctr_drbg_context ctr_drbg;
+    mbedtls_x509_crt cacert;
+    mbedtls_x509_crt srvcert;
+    mbedtls_x509_crt clicert;
+    mbedtls_pk_context srvkey;
+    mbedtls_pk_context clikey;
+    mbedtls_ssl_config cli_conf;
+    mbedtls_ssl_config srv_conf;
+    int handshakes;
+    unsigned long failures;
+} thread_info_t;
+
+static thread_info_t info[MAX_THREADS];
+
+static int thread_setup( thread_info_t *ti, int i )
+{
+    int ret;
+    unsigned char pers[] = "ssl_verify_bench_0";
+
+    mbedtls_ctr_drbg_init( &ti->ctr_drbg );
+    mbedtls_x509_crt_init( &ti->cacert );
+    mbedtls_x509_crt_init( &ti->srvcert );
+    mbedtls_x509_crt_init( &ti->clicert );
+    mbedtls_pk_init( &ti->srvkey );
+    mbedtls_pk_init( &ti->clikey );
+    mbedtls_ssl_config_init( &ti->cli_conf );
+    mbedtls_ssl_config_init( &ti->srv_conf );
+    ti->failures = 0;
+
+    pers[sizeof( pers ) - 2] += (unsigned char) i;
+
+    if( ( ret = mbedtls_ctr_drbg_seed( &ti->ctr_drbg, mbedtls_entropy_func,
+                                       &entropy, pers, sizeof( pers ) ) ) != 0 ||
+        ( ret = mbedtls_x509_crt_parse( &ti->cacert,
+                    (const unsigned char *) mbedtls_test_cas_pem,
+                    mbedtls_test_cas_pem_len ) ) != 0 ||
+        ( ret = mbedtls_x509_crt_parse( &ti->srvcert,
+                    (const unsigned char *) mbedtls_test_srv_crt_ec,
+                    mbedtls_test_srv_crt_ec_len ) ) != 0 ||
+        ( ret = mbedtls_x509_crt_parse( &ti->clicert,
+                    (const unsigned char *) mbedtls_test_cli_crt_ec,
+                    mbedtls_test_cli_crt_ec_len ) ) != 0 ||
+        ( ret = mbedtls_pk_parse_key( &ti->srvkey,
+                    (const unsigned char *) mbedtls_test_srv_key_ec,
+                    mbedtls_test_srv_key_ec_len, NULL, 0 ) ) != 0 ||
+        ( ret = mbedtls_pk_parse_key( &ti->clikey,
+                    (const unsigned char *) mbedtls_test_cli_key_ec,
+                    mbedtls_test_cli_key_ec_len, NULL, 0 ) ) != 0 ||
+        ( ret = mbedtls_ssl_config_defaults( &ti->cli_conf,
+                    MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+                    MBEDTLS_SSL_PRESET_DEFAULT ) ) != 0 ||
+        ( ret = mbedtls_ssl_config_defaults( &ti->srv_conf,
+                    MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_STREAM,
+                    MBEDTLS_SSL_PRESET_DEFAULT ) ) != 0 ||
+        ( ret = mbedtls_ssl_conf_own_cert( &ti->cli_conf, &ti->clicert,
+                                           &ti->clikey ) ) != 0 ||
+        ( ret = mbedtls_ssl_conf_own_cert( &ti->srv_conf, &ti->srvcert,
+                                           &ti->srvkey ) ) != 0 )
+    {
+        mbedtls_printf( " failed\n  ! thread setup returned -0x%04x\n\n", -ret );
+        return( ret );
+    }
+
+    /* Both chains are verified as by real peers, the test certificates may
+     * have expired though */
+    mbedtls_ssl_conf_authmode( &ti->cli_conf, MBEDTLS_SSL_VERIFY_OPTIONAL );
+    mbedtls_ssl_conf_authmode( &ti->srv_conf, MBEDTLS_SSL_VERIFY_OPTIONAL );
+    mbedtls_ssl_conf_ca_chain( &ti->cli_conf, &ti->cacert, NULL );
+    mbedtls_ssl_conf_ca_chain( &ti->srv_conf, &ti->cacert, NULL );
+    mbedtls_ssl_conf_rng( &ti->cli_conf, mbedtls_ctr_drbg_random, &ti->ctr_drbg );
+    mbedtls_ssl_conf_rng( &ti->srv_conf, mbedtls_ctr_drbg_random, &ti->ctr_drbg );
+
+    return( 0 );
+}
+
+static void thread_free( thread_info_t *ti )
+{
+    mbedtls_ssl_config_free( &ti->srv_conf );
+    mbedtls_ssl_config_free( &ti->cli_conf );
+    mbedtls_pk_free( &ti->clikey );
+    mbedtls_pk_free( &ti->srvkey );
+    mbedtls_x509_crt_free( &ti->clicert );
+    mbedtls_x509_crt_free( &ti->srvcert );
+    mbedtls_x509_crt_free( &ti->cacert );
+    mbedtls_ctr_drbg_free( &ti->ctr_drbg );
+}
+
+/*
+ * Full handshake between a client and a server of the thread, stepped in
+ * turn until both are done
+ */
+static int handshake( thread_info_t *ti, pipe_t pipes[2] )
+{
+    mbedtls_ssl_context cli, srv;
+    endpoint_t cli_end = { &pipes[1], &pipes[0] };
+    endpoint_t srv_end = { &pipes[0], &pipes[1] };
+    int cli_ret = MBEDTLS_ERR_SSL_WANT_READ;
+    int srv_ret = MBEDTLS_ERR_SSL_WANT_READ;
+    int steps, ret;
+
+    pipes[0].start = pipes[0].end = 0;
+    pipes[1].start = pipes[1].end = 0;
+
+    mbedtls_ssl_init( &cli );
+    mbedtls_ssl_init( &srv );
+
+    if( ( ret = mbedtls_ssl_setup( &cli, &ti->cli_conf ) ) != 0 ||
+        ( ret = mbedtls_ssl_setup( &srv, &ti->srv_conf ) ) != 0 ||
+        ( ret = mbedtls_ssl_set_hostname( &cli, "localhost" ) ) != 0 )
+    {
+        goto exit;
+    }
+
+    mbedtls_ssl_set_bio( &cli, &cli_end, pipe_send, pipe_recv, NULL );
+    mbedtls_ssl_set_bio( &srv, &srv_end, pipe_send, pipe_recv, NULL );
+
+    for( steps = 0; steps < 100 && ( cli_ret != 0 || srv_ret != 0 ); steps++ )
+    {
+        if( cli_ret != 0 )
+            cli_ret = mbedtls_ssl_handshake( &cli );
+        if( srv_ret != 0 )
+            srv_ret = mbedtls_ssl_handshake( &srv );
+
+        if( ( cli_ret != 0 && cli_ret != MBEDTLS_ERR_SSL_WANT_READ &&
+              cli_ret != MBEDTLS_ERR_SSL_WANT_WRITE ) ||
+            ( srv_ret != 0 && srv_ret != MBEDTLS_ERR_SSL_WANT_READ &&
+              srv_ret != MBEDTLS_ERR_SSL_WANT_WRITE ) )
+        {
+            break;
+        }
+    }
+
+    ret = ( cli_ret != 0 ) ? cli_ret : srv_ret;
+
+    /* The peer chains must have been looked at, cached or not */
+    if( ret == 0 &&
+        ( mbedtls_ssl_get_peer_cert( &cli ) == NULL ||
+          mbedtls_ssl_get_peer_cert( &srv ) == NULL ) )
+    {
+        ret = MBEDTLS_ERR_SSL_NO_CLIENT_CERTIFICATE;
+    }
+
+exit:
+    mbedtls_ssl_free( &srv );
+    mbedtls_ssl_free( &cli );
+
+    return( ret );
+}
+
+static void *handshake_worker( void *data )
+{
+    thread_info_t *ti = (thread_info_t *) data;
+    pipe_t *pipes;
+    int i;
+
+    pipes = calloc( 2, sizeof( pipe_t ) );
+    if( pipes == NULL )
+    {
+        ti->failures = ti->handshakes;
+        return( NULL );
+    }
+
+    for( i = 0; i < ti->handshakes; i++ )
+    {
+        if( handshake( ti, pipes ) != 0 )
+            ti->failures++;
+    }
+
+    free( pipes );
+
+    return( NULL );
+}
+
+/*
+ * Run the handshakes on all the threads, with or without the cache
+ */
+static unsigned long run_handshakes( int use_cache, unsigned long *failures )
+{
+    struct mbedtls_timing_hr_time timer;
+    unsigned long ms;
+    int i;
+#if defined(MBEDTLS_THREADING_PTHREAD)
+    pthread_t threads[MAX_THREADS];
+    int started;
+#endif
+
+    for( i = 0; i < opt.threads; i++ )
+    {
+        info[i].failures = 0;
+        mbedtls_ssl_conf_verify_cache( &info[i].cli_conf,
+                                       use_cache ? &cache : NULL );
+        mbedtls_ssl_conf_verify_cache( &info[i].srv_conf,
+                                       use_cache ? &cache : NULL );
+    }
+
+    (void) mbedtls_timing_get_timer( &timer, 1 );
+
+#if defined(MBEDTLS_THREADING_PTHREAD)
+    for( started = 0; started < opt.threads; started++ )
+    {
+        if( pthread_create( &threads[started], NULL, handshake_worker,
+                            &info[started] ) != 0 )
+        {
+            /* Run it here instead */
+            handshake_worker( &info[started] );
+            break;
+        }
+    }
+
+    for( i = 0; i < started; i++ )
+        pthread_join( threads[i], NULL );
+#else
+    handshake_worker( &info[0] );
+#endif
+
+    ms = mbedtls_timing_get_timer( &timer, 0 );
+
+    for( i = 0, *failures = 0; i < opt.threads; i++ )
+        *failures += info[i].failures;
+
+    return( ms );
+}
+
+int main( int argc, char *argv[] )
+{
+    int ret = 1;
+    int exit_code = MBEDTLS_EXIT_FAILURE;
+    int i, run, nb_setup = 0;
+    unsigned long failures, total_failures = 0, ms;
+    mbedtls_x509_crt_verify_cache_stats stats;
+    char *p, *q;
+
+    mbedtls_entropy_init( &entropy );
+    mbedtls_x509_crt_verify_cache_init( &cache );
+
+    opt.threads             = DFL_THREADS;
+    opt.handshakes          = DFL_HANDSHAKES;
+    opt.max_entries         = DFL_MAX_ENTRIES;
+
+    for( i = 1; i < argc; i++ )
+    {
+        p = argv[i];
+        if( ( q = strchr( p, '=' ) ) == NULL )
+            goto usage;
+        *q++ = '\0';
+
+        if( strcmp( p, "threads" ) == 0 )
+        {
+            opt.threads = atoi( q );
+            if( opt.threads < 1 || opt.threads > MAX_THREADS )
+                goto usage;
+        }
+        else if( strcmp( p, "handshakes" ) == 0 )
+        {
+            opt.handshakes = atoi( q );
+            if( opt.handshakes < 0 )
+                goto usage;
+        }
+        else if( strcmp( p, "max_entries" ) == 0 )
+        {
+            opt.max_entries = atoi( q );
+            if( opt.max_entries < 0 )
+                goto usage;
+        }
+        else
+        {
+        usage:
+            mbedtls_printf( USAGE, MAX_THREADS, DFL_MAX_ENTRIES );
+            goto exit;
+        }
+    }
+
+    /*
+     * 1. Set up the peers of each thread
+     */
+    mbedtls_printf( "\n  . Setting up %d threads...", opt.threads );
+    fflush( stdout );
+
+    mbedtls_x509_crt_verify_cache_set_max_entries( &cache, opt.max_entries );
+
+    for( nb_setup = 0; nb_setup < opt.threads; nb_setup++ )
+    {
+        info[nb_setup].handshakes = opt.handshakes / opt.threads;
+
+        if( ( ret = thread_setup( &info[nb_setup], nb_setup ) ) != 0 )
+        {
+            nb_setup++;
+            goto exit;
+        }
+    }
+
+    mbedtls_printf( " ok\n" );
+
+    /*
+     * 2. Run the handshakes without, then with the cache
+     */
+    for( run = 0; run < 2; run++ )
+    {
+        mbedtls_printf( "  . Running %d handshakes %s the cache...",
+                        opt.threads * ( opt.handshakes / opt.threads ),
+                        run ? "with" : "without" );
+        fflush( stdout );
+
+        ms = run_handshakes( run, &failures );
+        total_failures += failures;
+
+        mbedtls_printf( " ok\n  . %lu ms, %.1f handshakes/s, %lu failed\n", ms,
+                        ms == 0 ? 0.0 : (double) opt.threads *
+                            ( opt.handshakes / opt.threads ) * 1000 / ms,
+                        failures );
+    }
+
+    mbedtls_x509_crt_verify_cache_get_stats( &cache, &stats );
+    mbedtls_printf( "  . hits %lu, misses %lu, evictions %lu, expirations %lu\n\n",
+                    stats.hits, stats.misses, stats.evictions,
+                    stats.expirations );
+
+    if( total_failures == 0 )
+        exit_code = MBEDTLS_EXIT_SUCCESS;
+
+exit:
+    for( i = 0; i < nb_setup; i++ )
+        thread_free( &info[i] );
+    mbedtls_x509_crt_verify_cache_free( &cache );
+    mbedtls_entropy_free( &entropy );
+
+#if defined(_WIN32)
+    mbedtls_printf( "  + Press Enter to exit this program.\n" );
+    fflush( stdout ); getchar();
+#endif
+
+    return( exit_code );
+}
+
+#endif /* MBEDTLS_X509_CRT_VERIFY_CACHE && MBEDTLS_CERTS_C &&
+          MBEDTLS_ENTROPY_C && MBEDTLS_CTR_DRBG_C && MBEDTLS_SSL_CLI_C &&
+          MBEDTLS_SSL_SRV_C && MBEDTLS_PEM_PARSE_C && MBEDTLS_ECDSA_C &&
+          MBEDTLS_TIMING_C */
@@ -106,10 +106,16 @@ int main( void )
 #define OPTIONS                                                         \
     "md4, md5, ripemd160, sha1, sha256, sha512,\n"                      \
     "arc4, des3, des, camellia, blowfish, chacha20,\n"                  \
-    "aes_cbc, aes_gcm, aes_ccm, aes_ctx, chachapoly,\n"                 \
+    "aes_cbc, aes_ctr, aes_gcm, aes_ccm, aes_ctx, chachapoly,\n"        \
     "aes_cmac, des3_cmac, poly1305\n"                                   \
     "havege, ctr_drbg, hmac_drbg\n"                                     \
-    "rsa, dhm, ecdsa, ecdh.\n"
+    "rsa, dhm, ecdsa, ecdh, p256.\n"
+
+#if defined(MBEDTLS_ECP_P256_FIXED_LIMBS)
+#define P256_ARITH      "fixed"
+#else
+#define P256_ARITH      "mpi"
+#endif
 
 #if defined(MBEDTLS_ERROR_C)
 #define PRINT_ERROR                                                     \
@@ -250,12 +256,12 @@ unsigned char buf[BUFSIZE];
 typedef struct {
     char md4, md5, ripemd160, sha1, sha256, sha512,
          arc4, des3, des,
-         aes_cbc, aes_gcm, aes_ccm, aes_xts, chachapoly,
+         aes_cbc, aes_ctr, aes_gcm, aes_ccm, aes_xts, chachapoly,
          aes_cmac, des3_cmac,
          aria, camellia, blowfish, chacha20,
          poly1305,
          havege, ctr_drbg, hmac_drbg,
-         rsa, dhm, ecdsa, ecdh;
+         rsa, dhm, ecdsa, ecdh, p256;
 } todo_list;
 
 
@@ -299,6 +305,8 @@ int main( int argc, char *argv[] )
                 todo.des = 1;
             else if( strcmp( argv[i], "aes_cbc" ) == 0 )
                 todo.aes_cbc = 1;
+            else if( strcmp( argv[i], "aes_ctr" ) == 0 )
+                todo.aes_ctr = 1;
             else if( strcmp( argv[i], "aes_xts" ) == 0 )
                 todo.aes_xts = 1;
             else if( strcmp( argv[i], "aes_gcm" ) == 0 )
@@ -335,6 +343,8 @@ int main( int argc, char *argv[] )
                 todo.ecdsa = 1;
             else if( strcmp( argv[i], "ecdh" ) == 0 )
                 todo.ecdh = 1;
+            else if( strcmp( argv[i], "p256" ) == 0 )
+                todo.p256 = 1;
             else
             {
                 mbedtls_printf( "Unrecognized option: %s\n", argv[i] );
@@ -454,6 +464,30 @@ int main( int argc, char *argv[] )
         mbedtls_aes_free( &aes );
     }
 #endif
+#if defined(MBEDTLS_CIPHER_MODE_CTR)
+    if( todo.aes_ctr )
+    {
+        int keysize;
+        size_t nc_off;
+        unsigned char stream_block[16];
+        mbedtls_aes_context aes;
+        mbedtls_aes_init( &aes );
+        for( keysize = 128; keysize <= 256; keysize += 64 )
+        {
+            mbedtls_snprintf( title, sizeof( title ), "AES-CTR-%d", keysize );
+
+            memset( buf, 0, sizeof( buf ) );
+            memset( tmp, 0, sizeof( tmp ) );
+            mbedtls_aes_setkey_enc( &aes, tmp, keysize );
+            nc_off = 0;
+
+            TIME_AND_TSC( title,
+                mbedtls_aes_crypt_ctr( &aes, BUFSIZE, &nc_off, tmp, stream_block,
+                                       buf, buf ) );
+        }
+        mbedtls_aes_free( &aes );
+    }
+#endif
 #if defined(MBEDTLS_CIPHER_MODE_XTS)
     if( todo.aes_xts )
     {
@@ -989,6 +1023,53 @@ int main( int argc, char *argv[] )
     }
 #endif
 
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECDH_C) && \
+    defined(MBEDTLS_SHA256_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+    if( todo.p256 )
+    {
+        mbedtls_ecdsa_context ecdsa;
+        mbedtls_ecp_group grp;
+        mbedtls_ecp_point Q;
+        mbedtls_mpi d, z;
+        size_t sig_len;
+
+        /*
+         * Operations per second with the arithmetic in use for secp256r1,
+         * see MBEDTLS_ECP_P256_FIXED_LIMBS
+         */
+        mbedtls_ecdsa_init( &ecdsa );
+        mbedtls_ecp_group_init( &grp );
+        mbedtls_ecp_point_init( &Q );
+        mbedtls_mpi_init( &d ); mbedtls_mpi_init( &z );
+
+        memset( buf, 0x2A, sizeof( buf ) );
+
+        if( mbedtls_ecdsa_genkey( &ecdsa, MBEDTLS_ECP_DP_SECP256R1, myrand, NULL ) != 0 ||
+            mbedtls_ecdsa_write_signature( &ecdsa, MBEDTLS_MD_SHA256, buf, 32,
+                                           tmp, &sig_len, myrand, NULL ) != 0 ||
+            mbedtls_ecp_group_load( &grp, MBEDTLS_ECP_DP_SECP256R1 ) != 0 ||
+            mbedtls_ecdh_gen_public( &grp, &d, &Q, myrand, NULL ) != 0 )
+        {
+            mbedtls_exit( 1 );
+        }
+
+        TIME_PUBLIC( "P-256 sign (" P256_ARITH ")", "ops",
+                ret = mbedtls_ecdsa_write_signature( &ecdsa, MBEDTLS_MD_SHA256, buf, 32,
+                                                     tmp, &sig_len, myrand, NULL ) );
+
+        TIME_PUBLIC( "P-256 verify (" P256_ARITH ")", "ops",
+                ret = mbedtls_ecdsa_read_signature( &ecdsa, buf, 32, tmp, sig_len ) );
+
+        TIME_PUBLIC( "P-256 ECDH (" P256_ARITH ")", "ops",
+                ret = mbedtls_ecdh_compute_shared( &grp, &z, &Q, &d, myrand, NULL ) );
+
+        mbedtls_ecdsa_free( &ecdsa );
+        mbedtls_ecp_group_free( &grp );
+        mbedtls_ecp_point_free( &Q );
+        mbedtls_mpi_free( &d ); mbedtls_mpi_free( &z );
+    }
+#endif
+
     mbedtls_printf( "\n" );
 
 #if defined(MBEDTLS_MEMORY_BUFFER_ALLOC_C)
@@ -12,6 +12,12 @@ SOURCES += \
     ../src/mod_lua.inl \
     ../src/mod_duktape.inl \
     ../src/timer.inl \
+    ../src/reactor.inl \
+    ../src/router.inl \
+    ../src/sockqueue.inl \
+    ../src/file_cache.inl \
+    ../src/ws_broadcast.inl \
+    ../src/access_log.inl \
     ../src/civetweb.c \
     ../src/main.c \
     ../src/mod_zlib.inl \
@@ -10,6 +10,12 @@ clang-format -i src/mod_lua_shared.inl
 clang-format -i src/mod_duktape.inl
 clang-format -i src/mod_zlib.inl
 clang-format -i src/timer.inl
+clang-format -i src/reactor.inl
+clang-format -i src/router.inl
+clang-format -i src/sockqueue.inl
+clang-format -i src/file_cache.inl
+clang-format -i src/ws_broadcast.inl
+clang-format -i src/access_log.inl
 clang-format -i src/handle_form.inl
 
 clang-format -i src/third_party/civetweb_lua.h
@@ -825,6 +825,72 @@ CIVETWEB_API int mg_websocket_client_write(struct mg_connection *conn,
                                            size_t data_len);
 
 
+/* Websocket broadcast group: a set of websocket server connections that
+   receive the same frames. A frame sent by mg_websocket_broadcast is
+   encoded once and queued for every connection in the group. A writer
+   thread of the group sends the frames, so a slow client does not delay
+   the caller or the other clients.
+   These functions are available when civetweb is compiled with
+   -DUSE_WEBSOCKET */
+struct mg_websocket_group;
+
+
+/* Create a websocket broadcast group.
+
+   Parameters:
+     ctx: server context
+     max_frames: maximum number of frames queued per connection
+     max_bytes: maximum number of bytes queued per connection
+
+   If a new frame exceeds one of the limits for a connection, the oldest
+   queued frames that have not been started yet are dropped for this
+   connection.
+
+   Return:
+     The group, or NULL on error. */
+CIVETWEB_API struct mg_websocket_group *
+mg_websocket_group_create(struct mg_context *ctx,
+                          unsigned max_frames,
+                          size_t max_bytes);
+
+
+/* Destroy a websocket broadcast group. Frames that have not been sent
+   are dropped. Groups that are not destroyed by the application are
+   destroyed by mg_stop. */
+CIVETWEB_API void mg_websocket_group_destroy(struct mg_websocket_group *group);
+
+
+/* Add a websocket connection to a group. Call this function from the
+   ready handler or the data handler of the connection. A connection
+   leaves all groups automatically when it is closed.
+
+   Return:
+     0 on success, -1 on error */
+CIVETWEB_API int mg_websocket_group_join(struct mg_websocket_group *group,
+                                         struct mg_connection *conn);
+
+
+/* Remove a websocket connection from a group. Frames that have not been
+   sent to this connection are dropped.
+
+   Return:
+     0 on success, -1 if the connection is not in the group */
+CIVETWEB_API int mg_websocket_group_leave(struct mg_websocket_group *group,
+                                          struct mg_connection *conn);
+
+
+/* Send data to all connections of a group wrapped in a websocket frame.
+   The function does not wait for the data to be sent.
+
+   Return:
+     -1  on error
+     >=0 number of connections the frame has been queued for */
+CIVETWEB_API int mg_websocket_broadcast(struct mg_websocket_group *group,
+                                        int opcode,
+                                        const char *data,
+                                        size_t data_len);
+
+
 /* Blocks until unique access is obtained to this connection. Intended for use
    with websockets only.
    Invoke this before mg_write or mg_printf when communicating with a
@@ -69,6 +69,12 @@ noifdef(path .. "src/mod_lua.inl")
 noifdef(path .. "src/mod_zlib.inl")
 noifdef(path .. "src/sha1.inl")
 noifdef(path .. "src/timer.inl")
+noifdef(path .. "src/reactor.inl")
+noifdef(path .. "src/router.inl")
+noifdef(path .. "src/sockqueue.inl")
+noifdef(path .. "src/file_cache.inl")
+noifdef(path .. "src/ws_broadcast.inl")
+noifdef(path .. "src/access_log.inl")
 noifdef(path .. "src/wolfssl_extras.inl")
 
 --PrintTab(usedlines)
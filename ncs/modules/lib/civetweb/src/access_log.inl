@@ -0,0 +1,404 @@
+/* This file is part of the CivetWeb web server.
+ * See https://github.com/civetweb/civetweb/
+ * (C) 2020 by the CivetWeb authors, MIT license.
+ */
+
+/* Buffered access log.
+ *
+ * Without a buffer, log_access() opens the access log file, writes and
+ * flushes one line and closes the file again for every request, so all
+ * workers wait for the disk in turn. With "access_log_buffer_size", every
+ * worker thread appends its lines to a ring buffer of its own, and the log
+ * thread writes the rings of all workers to the log files in batches:
+ * every "access_log_flush_interval_ms", or earlier if a ring holds more
+ * than "access_log_flush_size" bytes.
+ *
+ * The mutex of a ring is shared only by its worker and the log thread, and
+ * the log thread holds it just to copy the ring. If a ring is full, the line
+ * is dropped and counted (see mg_get_context_info, "accessLog").
+ * The log_access callback is still called by the worker thread.
+ */
+
+#if !defined(ACCESS_LOG_MIN_BUFFER_SIZE)
+#define ACCESS_LOG_MIN_BUFFER_SIZE (8192)
+#endif
+
+
+/* Header of every line in a ring */
+struct mg_access_log_record {
+	const struct mg_domain_context *dom; /* Log file of this domain */
+	size_t len;                          /* Length of the line with '\n' */
+};
+
+
+struct mg_access_log_ring {
+	pthread_mutex_t mutex; /* Protects all members */
+	char *buf;             /* mg_access_log.size bytes */
+	size_t head;           /* Position of the first record */
+	size_t used;           /* Bytes in use */
+	int64_t records;       /* Lines added to the ring */
+	int64_t dropped;       /* Lines dropped, because the ring was full */
+};
+
+
+struct mg_access_log {
+	pthread_t threadid;               /* Log thread ID */
+	pthread_mutex_t mutex;            /* Protects wakeup, stop and counters */
+	pthread_cond_t cond;              /* Signals wakeup and stop */
+	int wakeup;                       /* A ring reached flush_size */
+	int stop;                         /* Write all rings and exit */
+	struct mg_access_log_ring *rings; /* One ring per worker thread */
+	unsigned num_rings;
+	size_t size;                /* Size of every ring */
+	size_t flush_size;          /* "access_log_flush_size" */
+	unsigned flush_interval_ms; /* "access_log_flush_interval_ms" */
+	char *batch;                /* Log thread: copy of one ring */
+	int64_t flushes;            /* Number of write cycles with data */
+	int64_t write_errors;       /* Number of failed writes */
+};
+
+
+/* Returns the ring of the worker thread of conn, or NULL if the access log
+ * is not buffered. */
+static struct mg_access_log_ring *
+access_log_ring(const struct mg_connection *conn)
+{
+	struct mg_context *ctx = conn->phys_ctx;
+	ptrdiff_t idx;
+
+	if (ctx->access_log == NULL) {
+		return NULL;
+	}
+	idx = conn - ctx->worker_connections;
+	if ((idx < 0) || ((size_t)idx >= ctx->access_log->num_rings)) {
+		/* Not a worker connection */
+		return NULL;
+	}
+	return &ctx->access_log->rings[idx];
+}
+
+
+/* Must be called with ring->mutex locked. */
+static void
+access_log_ring_put(struct mg_access_log *log,
+                    struct mg_access_log_ring *ring,
+                    const void *data,
+                    size_t len)
+{
+	size_t pos = (ring->head + ring->used) % log->size;
+	size_t part = log->size - pos;
+
+	if (part > len) {
+		part = len;
+	}
+	memcpy(ring->buf + pos, data, part);
+	memcpy(ring->buf, (const char *)data + part, len - part);
+	ring->used += len;
+}
+
+
+/* Called by a worker thread instead of writing the log file. */
+static void
+access_log_append(const struct mg_connection *conn,
+                  struct mg_access_log_ring *ring,
+                  const char *line)
+{
+	struct mg_access_log *log = conn->phys_ctx->access_log;
+	struct mg_access_log_record rec;
+	size_t len = strlen(line);
+	int wakeup;
+
+	rec.dom = conn->dom_ctx;
+	rec.len = len + 1;
+
+	pthread_mutex_lock(&ring->mutex);
+	if (ring->used + sizeof(rec) + rec.len > log->size) {
+		ring->dropped++;
+		pthread_mutex_unlock(&ring->mutex);
+		return;
+	}
+	wakeup = (ring->used < log->flush_size);
+	access_log_ring_put(log, ring, &rec, sizeof(rec));
+	access_log_ring_put(log, ring, line, len);
+	access_log_ring_put(log, ring, "\n", 1);
+	ring->records++;
+	wakeup = wakeup && (ring->used >= log->flush_size);
+	pthread_mutex_unlock(&ring->mutex);
+
+	if (wakeup) {
+		/* Only once when crossing flush_size, not for every line */
+		pthread_mutex_lock(&log->mutex);
+		log->wakeup = 1;
+		pthread_cond_signal(&log->cond);
+		pthread_mutex_unlock(&log->mutex);
+	}
+}
+
+
+/* Log thread: move the contents of a ring to log->batch.
+ * Returns the number of bytes. */
+static size_t
+access_log_collect(struct mg_access_log *log, struct mg_access_log_ring *ring)
+{
+	size_t used, part;
+
+	pthread_mutex_lock(&ring->mutex);
+	used = ring->used;
+	part = log->size - ring->head;
+	if (part > used) {
+		part = used;
+	}
+	memcpy(log->batch, ring->buf + ring->head, part);
+	memcpy(log->batch + part, ring->buf, used - part);
+	ring->head = 0;
+	ring->used = 0;
+	pthread_mutex_unlock(&ring->mutex);
+
+	return used;
+}
+
+
+/* Log thread: write the records in log->batch. The file of the last
+ * domain is kept open in fi, so the log file is opened once per write
+ * cycle, not once per line. Returns the number of failed writes. */
+static int
+access_log_write(struct mg_context *ctx,
+                 size_t total,
+                 struct mg_file *fi,
+                 const struct mg_domain_context **fi_dom)
+{
+	struct mg_access_log *log = ctx->access_log;
+	struct mg_access_log_record rec;
+	struct mg_connection fc;
+	size_t pos;
+	int errors = 0;
+
+	for (pos = 0; pos < total; pos += sizeof(rec) + rec.len) {
+		memcpy(&rec, log->batch + pos, sizeof(rec));
+
+		if (rec.dom != *fi_dom) {
+			if ((fi->access.fp != NULL) && (mg_fclose(&fi->access) != 0)) {
+				errors++;
+			}
+			fi->access.fp = NULL;
+			*fi_dom = rec.dom;
+
+			fake_connection(&fc, ctx);
+			fc.dom_ctx = (struct mg_domain_context *)rec.dom;
+			if (!mg_fopen(&fc,
+			              rec.dom->config[ACCESS_LOG_FILE],
+			              MG_FOPEN_MODE_APPEND,
+			              fi)) {
+				fi->access.fp = NULL;
+				mg_cry_internal(&fc,
+				                "Error writing log file %s",
+				                rec.dom->config[ACCESS_LOG_FILE]);
+				errors++;
+			}
+		}
+
+		if ((fi->access.fp != NULL)
+		    && (fwrite(log->batch + pos + sizeof(rec), 1, rec.len, fi->access.fp)
+		        != rec.len)) {
+			errors++;
+		}
+	}
+	return errors;
+}
+
+
+static void
+access_log_thread_run(struct mg_context *ctx)
+{
+	struct mg_access_log *log = ctx->access_log;
+	const struct mg_domain_context *fi_dom;
+	struct mg_file fi;
+	struct timespec abstime;
+	size_t total;
+	unsigned i;
+	int stop = 0, written, errors;
+
+	mg_set_thread_name("acclog");
+
+	pthread_mutex_lock(&log->mutex);
+	while (!stop) {
+		if (!log->wakeup && !log->stop) {
+			clock_gettime(CLOCK_REALTIME, &abstime);
+			abstime.tv_sec += (time_t)(log->flush_interval_ms / 1000);
+			abstime.tv_nsec += (long)(log->flush_interval_ms % 1000) * 1000000L;
+			if (abstime.tv_nsec >= 1000000000L) {
+				abstime.tv_sec++;
+				abstime.tv_nsec -= 1000000000L;
+			}
+			pthread_cond_timedwait(&log->cond, &log->mutex, &abstime);
+		}
+		log->wakeup = 0;
+		stop = log->stop;
+		pthread_mutex_unlock(&log->mutex);
+
+		/* Workers are stopped before log->stop is set, so the last cycle
+		 * writes all lines. */
+		fi.access.fp = NULL;
+		fi_dom = NULL;
+		written = 0;
+		errors = 0;
+		for (i = 0; i < log->num_rings; i++) {
+			total = access_log_collect(log, &log->rings[i]);
+			if (total > 0) {
+				errors += access_log_write(ctx, total, &fi, &fi_dom);
+				written = 1;
+			}
+		}
+		if ((fi.access.fp != NULL) && (mg_fclose(&fi.access) != 0)) {
+			errors++;
+		}
+
+		pthread_mutex_lock(&log->mutex);
+		log->flushes += written;
+		log->write_errors += errors;
+	}
+	pthread_mutex_unlock(&log->mutex);
+}
+
+
+#if defined(_WIN32)
+static unsigned __stdcall access_log_thread(void *thread_func_param)
+{
+	access_log_thread_run((struct mg_context *)thread_func_param);
+	return 0;
+}
+#else
+static void *
+access_log_thread(void *thread_func_param)
+{
+	access_log_thread_run((struct mg_context *)thread_func_param);
+	return NULL;
+}
+#endif /* _WIN32 */
+
+
+static void
+access_log_free(struct mg_access_log *log)
+{
+	unsigned i;
+
+	for (i = 0; i < log->num_rings; i++) {
+		if (log->rings[i].buf != NULL) {
+			(void)pthread_mutex_destroy(&log->rings[i].mutex);
+			mg_free(log->rings[i].buf);
+		}
+	}
+	mg_free(log->rings);
+	mg_free(log->batch);
+	mg_free(log);
+}
+
+
+static int
+access_log_init(struct mg_context *ctx)
+{
+	const char *size_str = ctx->dd.config[ACCESS_LOG_BUFFER_SIZE];
+	const char *flush_str = ctx->dd.config[ACCESS_LOG_FLUSH_SIZE];
+	const char *interval_str = ctx->dd.config[ACCESS_LOG_FLUSH_INTERVAL];
+	long size = (size_str ? strtol(size_str, NULL, 10) : 0);
+	long flush_size = (flush_str ? strtol(flush_str, NULL, 10) : 0);
+	long interval = (interval_str ? strtol(interval_str, NULL, 10) : 0);
+	struct mg_access_log *log;
+	unsigned i;
+
+	ctx->access_log = NULL;
+
+	if (size <= 0) {
+		/* Access log is written by the worker threads */
+		return 0;
+	}
+	if (size < ACCESS_LOG_MIN_BUFFER_SIZE) {
+		size = ACCESS_LOG_MIN_BUFFER_SIZE;
+	}
+	if (size > INT_MAX) {
+		size = INT_MAX;
+	}
+	if ((flush_size <= 0) || (flush_size > size)) {
+		flush_size = size / 2;
+	}
+	if (interval <= 0) {
+		interval = 1000;
+	}
+
+	log = (struct mg_access_log *)
+	    mg_calloc_ctx(1, sizeof(struct mg_access_log), ctx);
+	if (log == NULL) {
+		return -1;
+	}
+	log->size = (size_t)size;
+	log->flush_size = (size_t)flush_size;
+	log->flush_interval_ms = (unsigned)interval;
+	log->num_rings = ctx->cfg_worker_threads;
+	log->rings = (struct mg_access_log_ring *)
+	    mg_calloc_ctx(log->num_rings, sizeof(struct mg_access_log_ring), ctx);
+	log->batch = (char *)mg_malloc_ctx(log->size, ctx);
+	if ((log->rings == NULL) || (log->batch == NULL)) {
+		log->num_rings = 0;
+		access_log_free(log);
+		return -1;
+	}
+	for (i = 0; i < log->num_rings; i++) {
+		log->rings[i].buf = (char *)mg_malloc_ctx(log->size, ctx);
+		if (log->rings[i].buf == NULL) {
+			access_log_free(log);
+			return -1;
+		}
+		if (0 != pthread_mutex_init(&log->rings[i].mutex, NULL)) {
+			mg_free(log->rings[i].buf);
+			log->rings[i].buf = NULL;
+			access_log_free(log);
+			return -1;
+		}
+	}
+
+	if (0 != pthread_mutex_init(&log->mutex, NULL)) {
+		access_log_free(log);
+		return -1;
+	}
+	if (0 != pthread_cond_init(&log->cond, NULL)) {
+		(void)pthread_mutex_destroy(&log->mutex);
+		access_log_free(log);
+		return -1;
+	}
+
+	ctx->access_log = log;
+	if (mg_start_thread_with_id(access_log_thread, ctx, &log->threadid) != 0) {
+		ctx->access_log = NULL;
+		(void)pthread_cond_destroy(&log->cond);
+		(void)pthread_mutex_destroy(&log->mutex);
+		access_log_free(log);
+		return -1;
+	}
+
+	return 0;
+}
+
+
+/* Must be called after all worker threads have been joined. Writes all
+ * buffered lines. */
+static void
+access_log_exit(struct mg_context *ctx)
+{
+	struct mg_access_log *log = ctx->access_log;
+
+	if (log) {
+		pthread_mutex_lock(&log->mutex);
+		log->stop = 1;
+		pthread_cond_signal(&log->cond);
+		pthread_mutex_unlock(&log->mutex);
+		mg_join_thread(log->threadid);
+
+		(void)pthread_cond_destroy(&log->cond);
+		(void)pthread_mutex_destroy(&log->mutex);
+		access_log_free(log);
+		ctx->access_log = NULL;
+	}
+}
+
+
+/* End of access_log.inl */
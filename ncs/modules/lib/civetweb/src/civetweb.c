@@ -141,10 +141,19 @@ mg_static_assert(sizeof(void *) >= sizeof(int), "data type size check");
 #define ALTERNATIVE_QUEUE
 #endif
 
+/* The lock-free queue uses the per worker events of the alternative queue */
+#if defined(USE_LOCKFREE_QUEUE) && !defined(ALTERNATIVE_QUEUE)
+#error "USE_LOCKFREE_QUEUE cannot be combined with NO_ALTERNATIVE_QUEUE"
+#endif
+
 #if defined(NO_FILESYSTEMS) && !defined(NO_FILES)
 #error "Inconsistent build flags, NO_FILESYSTEMS requires NO_FILES"
 #endif
 
+#if defined(USE_EPOLL) && !defined(__linux__)
+#error "USE_EPOLL is only available for Linux"
+#endif
+
 /* DTL -- including winsock2.h works better if lean and mean */
 #if !defined(WIN32_LEAN_AND_MEAN)
 #define WIN32_LEAN_AND_MEAN
@@ -833,6 +842,10 @@ typedef unsigned short int in_port_t;
 #include <dlfcn.h>
 #endif
 
+#if defined(USE_WEBSOCKET) && defined(__SSE2__)
+#include <emmintrin.h> /* websocket unmasking */
+#endif
+
 #if defined(__MACH__)
 #define SSL_LIB "libssl.dylib"
 #define CRYPTO_LIB "libcrypto.dylib"
@@ -1255,6 +1268,51 @@ mg_atomic_dec(volatile int *addr)
 }
 
 
+/* Set *addr to newval if it is oldval. Returns nonzero if the value has
+ * been set. Implies a full memory barrier. */
+FUNCTION_MAY_BE_UNUSED
+static int
+mg_atomic_cas(volatile int *addr, int oldval, int newval)
+{
+	int ret;
+#if defined(_WIN32) && !defined(NO_ATOMICS)
+	ret = (InterlockedCompareExchange((volatile long *)addr,
+	                                  (long)newval,
+	                                  (long)oldval)
+	       == (long)oldval);
+#elif defined(__GNUC__)                                                        \
+    && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 0)))           \
+    && !defined(NO_ATOMICS)
+	ret = __sync_bool_compare_and_swap(addr, oldval, newval);
+#else
+	mg_global_lock();
+	ret = ((*addr) == oldval);
+	if (ret) {
+		(*addr) = newval;
+	}
+	mg_global_unlock();
+#endif
+	return ret;
+}
+
+
+FUNCTION_MAY_BE_UNUSED
+static void
+mg_memory_barrier(void)
+{
+#if defined(_WIN32) && !defined(NO_ATOMICS)
+	MemoryBarrier();
+#elif defined(__GNUC__)                                                        \
+    && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 0)))           \
+    && !defined(NO_ATOMICS)
+	__sync_synchronize();
+#else
+	mg_global_lock();
+	mg_global_unlock();
+#endif
+}
+
+
 #if defined(USE_SERVER_STATS)
 static int64_t
 mg_atomic_add(volatile int64_t *addr, int64_t value)
@@ -2340,6 +2398,13 @@ struct socket {
 	unsigned char ssl_redir; /* Is port supposed to redirect everything to SSL
 	                          * port */
 	unsigned char in_use;    /* 0: invalid, 1: valid, 2: free */
+#if defined(USE_EPOLL)
+	/* Keep-alive state of a connection handed over by the reactor */
+	unsigned char resumed; /* 0: new, 1: readable, 2: keep-alive timeout */
+	int handled_requests;
+	time_t conn_birth_time;
+	void *conn_data;
+#endif
 };
 
 
@@ -2366,10 +2431,16 @@ enum {
 #endif
 	THROTTLE,
 	ACCESS_LOG_FILE,
+	ACCESS_LOG_BUFFER_SIZE,
+	ACCESS_LOG_FLUSH_INTERVAL,
+	ACCESS_LOG_FLUSH_SIZE,
 	ERROR_LOG_FILE,
 	ENABLE_KEEP_ALIVE,
 	REQUEST_TIMEOUT,
 	KEEP_ALIVE_TIMEOUT,
+#if defined(USE_EPOLL)
+	MAX_IDLE_CONNECTIONS,
+#endif
 #if defined(USE_WEBSOCKET)
 	WEBSOCKET_TIMEOUT,
 	ENABLE_WEBSOCKET_PING_PONG,
@@ -2436,6 +2507,10 @@ enum {
 	ERROR_PAGES,
 #if !defined(NO_CACHING)
 	STATIC_FILE_MAX_AGE,
+#if !defined(_WIN32)
+	STATIC_FILE_CACHE_ENTRIES,
+	STATIC_FILE_CACHE_TTL,
+#endif
 #endif
 #if !defined(NO_SSL)
 	STRICT_HTTPS_MAX_AGE,
@@ -2471,10 +2546,16 @@ static const struct mg_option config_options[] = {
 #endif
     {"throttle", MG_CONFIG_TYPE_STRING_LIST, NULL},
     {"access_log_file", MG_CONFIG_TYPE_FILE, NULL},
+    {"access_log_buffer_size", MG_CONFIG_TYPE_NUMBER, "0"},
+    {"access_log_flush_interval_ms", MG_CONFIG_TYPE_NUMBER, "1000"},
+    {"access_log_flush_size", MG_CONFIG_TYPE_NUMBER, "0"},
     {"error_log_file", MG_CONFIG_TYPE_FILE, NULL},
     {"enable_keep_alive", MG_CONFIG_TYPE_BOOLEAN, "no"},
     {"request_timeout_ms", MG_CONFIG_TYPE_NUMBER, "30000"},
     {"keep_alive_timeout_ms", MG_CONFIG_TYPE_NUMBER, "500"},
+#if defined(USE_EPOLL)
+    {"max_idle_connections", MG_CONFIG_TYPE_NUMBER, "1000"},
+#endif
 #if defined(USE_WEBSOCKET)
     {"websocket_timeout_ms", MG_CONFIG_TYPE_NUMBER, NULL},
     {"enable_websocket_ping_pong", MG_CONFIG_TYPE_BOOLEAN, "no"},
@@ -2552,6 +2633,10 @@ static const struct mg_option config_options[] = {
     {"error_pages", MG_CONFIG_TYPE_DIRECTORY, NULL},
 #if !defined(NO_CACHING)
     {"static_file_max_age", MG_CONFIG_TYPE_NUMBER, "3600"},
+#if !defined(_WIN32)
+    {"static_file_cache_entries", MG_CONFIG_TYPE_NUMBER, "0"},
+    {"static_file_cache_ttl_ms", MG_CONFIG_TYPE_NUMBER, "5000"},
+#endif
 #endif
 #if !defined(NO_SSL)
     {"strict_transport_security_max_age", MG_CONFIG_TYPE_NUMBER, NULL},
@@ -2623,6 +2708,11 @@ struct mg_domain_context {
 	char *config[NUM_OPTIONS];        /* Civetweb configuration parameters */
 	struct mg_handler_info *handlers; /* linked list of uri handlers */
 
+	/* Compiled handlers for lookups without the context lock */
+	struct mg_router *volatile router; /* see router.inl */
+	volatile int router_epoch;         /* Selects the reader counter */
+	volatile int router_readers[2];    /* Readers in a lookup per epoch */
+
 	/* Server nonce */
 	uint64_t auth_nonce_mask;  /* Mask for all nonce values */
 	unsigned long nonce_count; /* Used nonces, used for authentication */
@@ -2675,7 +2765,11 @@ struct mg_context {
 
 /* Connection to thread dispatching */
 #if defined(ALTERNATIVE_QUEUE)
+#if defined(USE_LOCKFREE_QUEUE)
+	struct mg_sockqueue *sockqueue; /* Accepted sockets (sockqueue.inl) */
+#else
 	struct socket *client_socks;
+#endif
 	void **client_wait_events;
 #else
 	struct socket queue[MGSQLEN]; /* Accepted sockets */
@@ -2697,6 +2791,22 @@ struct mg_context {
 	time_t start_time; /* Server start time, used for authentication
 	                    * and for diagnstics. */
 
+#if defined(USE_EPOLL)
+	struct mg_reactor *reactor; /* Keep-alive reactor (reactor.inl) */
+#endif
+
+#if !defined(NO_CACHING) && !defined(_WIN32)
+	struct mg_file_cache *file_cache; /* Static file cache (file_cache.inl) */
+#endif
+
+#if defined(USE_WEBSOCKET)
+	struct mg_websocket_group *ws_groups; /* Broadcast groups */
+#endif
+
+#if !defined(MG_EXTERNAL_FUNCTION_log_access) && !defined(NO_FILESYSTEMS)
+	struct mg_access_log *access_log; /* Buffered access log (access_log.inl) */
+#endif
+
 #if defined(USE_TIMERS)
 	struct ttimers *timers;
 #endif
@@ -4982,6 +5092,14 @@ pthread_mutex_unlock(pthread_mutex_t *mutex)
 }
 
 
+FUNCTION_MAY_BE_UNUSED
+static int
+pthread_mutex_trylock(pthread_mutex_t *mutex)
+{
+	return TryEnterCriticalSection(&mutex->sec) ? 0 : EBUSY;
+}
+
+
 FUNCTION_MAY_BE_UNUSED
 static int
 pthread_cond_init(pthread_cond_t *cv, const void *unused)
@@ -9658,6 +9776,11 @@ fclose_on_exec(struct mg_file_access *filep, struct mg_connection *conn)
 #endif
 
 
+#if !defined(NO_CACHING) && !defined(_WIN32)
+#include "file_cache.inl"
+#endif
+
+
 #if !defined(NO_FILESYSTEMS)
 static void
 handle_static_file_request(struct mg_connection *conn,
@@ -9680,6 +9803,10 @@ handle_static_file_request(struct mg_connection *conn,
 	const char *cors_orig_cfg;
 	const char *cors1, *cors2, *cors3;
 	int is_head_request;
+#if !defined(NO_CACHING) && !defined(_WIN32)
+	struct mg_file_cache_entry *cached;
+	const struct mg_file_cache_variant *cached_file = NULL;
+#endif
 
 #if defined(USE_ZLIB)
 	/* Compression is allowed, unless there is a reason not to use compression.
@@ -9694,7 +9821,14 @@ handle_static_file_request(struct mg_connection *conn,
 
 	is_head_request = !strcmp(conn->request_info.request_method, "HEAD");
 
-	if (mime_type == NULL) {
+#if !defined(NO_CACHING) && !defined(_WIN32)
+	/* Use open files, MIME type and ".gz" lookup from the cache */
+	cached = file_cache_acquire(conn, path, &filep->stat);
+	if ((cached != NULL) && (mime_type == NULL)) {
+		mime_vec = cached->mime;
+	} else
+#endif
+	    if (mime_type == NULL) {
 		get_mime_type(conn, path, &mime_vec);
 	} else {
 		mime_vec.ptr = mime_type;
@@ -9705,6 +9839,11 @@ handle_static_file_request(struct mg_connection *conn,
 		                   500,
 		                   "Error: File size is too large to send\n%" INT64_FMT,
 		                   filep->stat.size);
+#if !defined(NO_CACHING) && !defined(_WIN32)
+		if (cached != NULL) {
+			file_cache_release(conn->phys_ctx, cached);
+		}
+#endif
 		return;
 	}
 	cl = (int64_t)filep->stat.size;
@@ -9746,33 +9885,69 @@ handle_static_file_request(struct mg_connection *conn,
 	           && (filep->stat.size >= MG_FILE_COMPRESSION_SIZE_LIMIT)) {
 		struct mg_file_stat file_stat;
 
-		mg_snprintf(conn, &truncated, gz_path, sizeof(gz_path), "%s.gz", path);
+#if !defined(NO_CACHING) && !defined(_WIN32)
+		if (cached != NULL) {
+			/* The cache already knows if there is a ".gz" file */
+			if (cached->gz.stat.is_gzipped) {
+				cached_file = &cached->gz;
+				filep->stat = cached_file->stat;
+				cl = (int64_t)filep->stat.size;
+				encoding = "Content-Encoding: gzip\r\n";
+#if defined(USE_ZLIB)
+				allow_on_the_fly_compression = 0;
+#endif
+			}
+		} else
+#endif
+		{
+			mg_snprintf(
+			    conn, &truncated, gz_path, sizeof(gz_path), "%s.gz", path);
 
-		if (!truncated && mg_stat(conn, gz_path, &file_stat)
-		    && !file_stat.is_directory) {
-			file_stat.is_gzipped = 1;
-			filep->stat = file_stat;
-			cl = (int64_t)filep->stat.size;
-			path = gz_path;
-			encoding = "Content-Encoding: gzip\r\n";
+			if (!truncated && mg_stat(conn, gz_path, &file_stat)
+			    && !file_stat.is_directory) {
+				file_stat.is_gzipped = 1;
+				filep->stat = file_stat;
+				cl = (int64_t)filep->stat.size;
+				path = gz_path;
+				encoding = "Content-Encoding: gzip\r\n";
 
 #if defined(USE_ZLIB)
-			/* File is already compressed. No "on the fly" compression. */
-			allow_on_the_fly_compression = 0;
+				/* File is already compressed. No "on the fly" compression. */
+				allow_on_the_fly_compression = 0;
 #endif
+			}
 		}
 	}
 
-	if (!mg_fopen(conn, path, MG_FOPEN_MODE_READ, filep)) {
-		mg_send_http_error(conn,
-		                   500,
-		                   "Error: Cannot open file\nfopen(%s): %s",
-		                   path,
-		                   strerror(ERRNO));
-		return;
+#if !defined(NO_CACHING) && !defined(_WIN32)
+	if ((cached != NULL) && (cached_file == NULL)) {
+		cached_file = &cached->plain;
+	}
+#if defined(USE_ZLIB)
+	if (allow_on_the_fly_compression) {
+		/* send_compressed_data reads from filep */
+		cached_file = NULL;
 	}
+#endif
+	if (cached_file == NULL)
+#endif
+	{
+		if (!mg_fopen(conn, path, MG_FOPEN_MODE_READ, filep)) {
+			mg_send_http_error(conn,
+			                   500,
+			                   "Error: Cannot open file\nfopen(%s): %s",
+			                   path,
+			                   strerror(ERRNO));
+#if !defined(NO_CACHING) && !defined(_WIN32)
+			if (cached != NULL) {
+				file_cache_release(conn->phys_ctx, cached);
+			}
+#endif
+			return;
+		}
 
-	fclose_on_exec(&filep->access, conn);
+		fclose_on_exec(&filep->access, conn);
+	}
 
 	/* If "Range" request was made: parse header, send only selected part
 	 * of the file. */
@@ -9790,6 +9965,11 @@ handle_static_file_request(struct mg_connection *conn,
 			    "Error: Range requests in gzipped files are not supported");
 			(void)mg_fclose(
 			    &filep->access); /* ignore error on read only file */
+#if !defined(NO_CACHING) && !defined(_WIN32)
+			if (cached != NULL) {
+				file_cache_release(conn->phys_ctx, cached);
+			}
+#endif
 			return;
 		}
 		conn->status_code = 206;
@@ -9841,7 +10021,14 @@ handle_static_file_request(struct mg_connection *conn,
 	 * http://www.w3.org/Protocols/rfc2616/rfc2616-sec3.html#sec3.3 */
 	gmt_time_string(date, sizeof(date), &curtime);
 	gmt_time_string(lm, sizeof(lm), &filep->stat.last_modified);
-	construct_etag(etag, sizeof(etag), &filep->stat);
+#if !defined(NO_CACHING) && !defined(_WIN32)
+	if (cached_file != NULL) {
+		memcpy(etag, cached_file->etag, sizeof(etag));
+	} else
+#endif
+	{
+		construct_etag(etag, sizeof(etag), &filep->stat);
+	}
 
 	/* Send header */
 	(void)mg_printf(conn,
@@ -9907,6 +10094,12 @@ handle_static_file_request(struct mg_connection *conn,
 			/* Compress and send */
 			send_compressed_data(conn, filep);
 		} else
+#endif
+#if !defined(NO_CACHING) && !defined(_WIN32)
+		    if (cached_file != NULL) {
+			/* Send from the cached file */
+			file_cache_send(conn, cached_file, r1, cl);
+		} else
 #endif
 		{
 			/* Send file directly */
@@ -9914,6 +10107,11 @@ handle_static_file_request(struct mg_connection *conn,
 		}
 	}
 	(void)mg_fclose(&filep->access); /* ignore error on read only file */
+#if !defined(NO_CACHING) && !defined(_WIN32)
+	if (cached != NULL) {
+		file_cache_release(conn->phys_ctx, cached);
+	}
+#endif
 }
 
 
@@ -12206,6 +12404,59 @@ send_websocket_handshake(struct mg_connection *conn, const char *websock_key)
 #endif
 
 
+#if !defined(MG_WEBSOCKET_ARENA_KEEP)
+/* Receive buffers for websocket frames that do not fit into the
+ * connection buffer are kept for the next frame up to this size. */
+#define MG_WEBSOCKET_ARENA_KEEP (256 * 1024)
+#endif
+
+
+/* Apply the 4 byte websocket mask to data, in place. After the first
+ * bytes up to an 8 byte boundary, the data is processed in blocks of
+ * 16 (SSE2) or 8 bytes. */
+static void
+unmask_data(unsigned char *data, size_t len, const unsigned char mask[4])
+{
+	unsigned char rot[4];
+	uint32_t m32;
+	uint64_t m64, w;
+	size_t i = 0;
+
+	while ((i < len) && (((uintptr_t)(data + i)) & 7)) {
+		data[i] ^= mask[i & 3];
+		i++;
+	}
+
+	/* Mask rotated to the first aligned byte. Blocks are a multiple of
+	 * 4 bytes, so the rotation stays the same. */
+	rot[0] = mask[i & 3];
+	rot[1] = mask[(i + 1) & 3];
+	rot[2] = mask[(i + 2) & 3];
+	rot[3] = mask[(i + 3) & 3];
+	memcpy(&m32, rot, sizeof(m32));
+	m64 = ((uint64_t)m32 << 32) | m32;
+
+#if defined(__SSE2__)
+	if (len - i >= 16) {
+		__m128i m128 = _mm_set1_epi32((int)m32);
+		for (; i + 16 <= len; i += 16) {
+			__m128i *p = (__m128i *)(void *)(data + i);
+			_mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), m128));
+		}
+	}
+#endif
+	for (; i + 8 <= len; i += 8) {
+		memcpy(&w, data + i, sizeof(w));
+		w ^= m64;
+		memcpy(data + i, &w, sizeof(w));
+	}
+
+	for (; i < len; i++) {
+		data[i] ^= mask[i & 3];
+	}
+}
+
+
 static void
 read_websocket(struct mg_connection *conn,
                mg_websocket_data_handler ws_data_handler,
@@ -12223,7 +12474,7 @@ read_websocket(struct mg_connection *conn,
 	 * len is the length of the current message
 	 * data_len is the length of the current message's data payload
 	 * header_len is the length of the current message's header */
-	size_t i, len, mask_len = 0, header_len, body_len;
+	size_t len, mask_len = 0, header_len, body_len;
 	uint64_t data_len = 0;
 
 	/* "The masking key is a 32-bit value chosen at random by the client."
@@ -12232,9 +12483,14 @@ read_websocket(struct mg_connection *conn,
 	unsigned char mask[4];
 
 	/* data points to the place where the message is stored when passed to
-	 * the websocket_data callback.  This is either mem on the stack, or a
-	 * dynamically allocated buffer if it is too large. */
-	unsigned char mem[4096];
+	 * the websocket_data callback. This is the message queue itself, if the
+	 * frame fits into the connection buffer, or the receive arena (kept for
+	 * the next frames) if the frame is too large. */
+	unsigned char *data;
+	unsigned char *arena = NULL;
+	size_t arena_size = 0;
+	size_t consumed;   /* Bytes to remove from the queue after the callback */
+	uint64_t queue_size = (uint64_t)(conn->buf_size - conn->request_len);
 	unsigned char mop; /* mask flag and opcode */
 
 
@@ -12298,23 +12554,11 @@ read_websocket(struct mg_connection *conn,
 			}
 		}
 
-		if ((header_len > 0) && (body_len >= header_len)) {
-			/* Allocate space to hold websocket payload */
-			unsigned char *data = mem;
-
-			if ((size_t)data_len > (size_t)sizeof(mem)) {
-				data = (unsigned char *)mg_malloc_ctx((size_t)data_len,
-				                                      conn->phys_ctx);
-				if (data == NULL) {
-					/* Allocation failed, exit the loop and then close the
-					 * connection */
-					mg_cry_internal(
-					    conn,
-					    "%s",
-					    "websocket out of memory; closing connection");
-					break;
-				}
-			}
+		/* Frames that fit into the connection buffer are processed when
+		 * they are complete, larger frames as soon as the header is there. */
+		if ((header_len > 0) && (body_len >= header_len)
+		    && ((data_len + (uint64_t)header_len <= (uint64_t)body_len)
+		        || (data_len + (uint64_t)header_len > queue_size))) {
 
 			/* Copy the mask before we shift the queue and destroy it */
 			if (mask_len > 0) {
@@ -12323,12 +12567,35 @@ read_websocket(struct mg_connection *conn,
 				memset(mask, 0, sizeof(mask));
 			}
 
-			/* Read frame payload from the first message in the queue into
-			 * data and advance the queue by moving the memory in place. */
+			mop = buf[0]; /* current mask and opcode */
+
 			DEBUG_ASSERT(body_len >= header_len);
 			if (data_len + (uint64_t)header_len > (uint64_t)body_len) {
-				mop = buf[0]; /* current mask and opcode */
-				/* Overflow case */
+				/* Overflow case: read frame payload into the arena */
+				if ((size_t)data_len > arena_size) {
+					/* Grow at least by a factor of 2, the old content is
+					 * not required */
+					size_t new_size = arena_size * 2;
+					if (new_size < (size_t)data_len) {
+						new_size = (size_t)data_len;
+					}
+					mg_free(arena);
+					arena_size = 0;
+					arena = (unsigned char *)mg_malloc_ctx(new_size,
+					                                       conn->phys_ctx);
+					if (arena == NULL) {
+						/* Allocation failed, exit the loop and then close
+						 * the connection */
+						mg_cry_internal(
+						    conn,
+						    "%s",
+						    "websocket out of memory; closing connection");
+						break;
+					}
+					arena_size = new_size;
+				}
+				data = arena;
+
 				len = body_len - header_len;
 				memcpy(data, buf + header_len, len);
 				error = 0;
@@ -12353,41 +12620,23 @@ read_websocket(struct mg_connection *conn,
 					    conn,
 					    "%s",
 					    "Websocket pull failed; closing connection");
-					if (data != mem) {
-						mg_free(data);
-					}
 					break;
 				}
 
 				conn->data_len = conn->request_len;
+				consumed = 0;
 
 			} else {
-
-				mop = buf[0]; /* current mask and opcode, overwritten by
-				               * memmove() */
-
-				/* Length of the message being read at the front of the
-				 * queue. Cast to 31 bit is OK, since we limited
-				 * data_len before. */
-				len = (size_t)data_len + header_len;
-
-				/* Copy the data payload into the data pointer for the
-				 * callback. Cast to 31 bit is OK, since we
-				 * limited data_len */
-				memcpy(data, buf + header_len, (size_t)data_len);
-
-				/* Move the queue forward len bytes */
-				memmove(buf, buf + len, body_len - len);
-
-				/* Mark the queue as advanced */
-				conn->data_len -= (int)len;
+				/* The complete frame is in the queue: use the payload in
+				 * place, and advance the queue after the callback. Cast to
+				 * 31 bit is OK, since the frame fits into the buffer. */
+				data = buf + header_len;
+				consumed = (size_t)data_len + header_len;
 			}
 
 			/* Apply mask if necessary */
 			if (mask_len > 0) {
-				for (i = 0; i < (size_t)data_len; i++) {
-					data[i] ^= mask[i & 3];
-				}
+				unmask_data(data, (size_t)data_len, mask);
 			}
 
 			exit_by_callback = 0;
@@ -12428,9 +12677,15 @@ read_websocket(struct mg_connection *conn,
 				}
 			}
 
-			/* It a buffer has been allocated, free it again */
-			if (data != mem) {
-				mg_free(data);
+			if (consumed > 0) {
+				/* Move the queue forward */
+				memmove(buf, buf + consumed, body_len - consumed);
+				conn->data_len -= (int)consumed;
+			} else if (arena_size > MG_WEBSOCKET_ARENA_KEEP) {
+				/* Do not keep very large buffers for idle connections */
+				mg_free(arena);
+				arena = NULL;
+				arena_size = 0;
 			}
 
 			if (exit_by_callback) {
@@ -12502,6 +12757,8 @@ read_websocket(struct mg_connection *conn,
 		}
 	}
 
+	mg_free(arena);
+
 	/* Leave data processing loop */
 	mg_set_thread_name("worker");
 	conn->in_websocket_handling = 0;
@@ -12511,16 +12768,11 @@ read_websocket(struct mg_connection *conn,
 }
 
 
-static int
-mg_websocket_write_exec(struct mg_connection *conn,
-                        int opcode,
-                        const char *data,
-                        size_t dataLen,
-                        uint32_t masking_key)
+/* Encode the header of an unmasked frame. Returns the header length. */
+static size_t
+websocket_frame_header(unsigned char header[14], int opcode, size_t dataLen)
 {
-	unsigned char header[14];
 	size_t headerLen;
-	int retval;
 
 #if defined(GCC_DIAGNOSTIC)
 /* Disable spurious conversion warning for GCC */
@@ -12555,6 +12807,23 @@ mg_websocket_write_exec(struct mg_connection *conn,
 		headerLen = 10;
 	}
 
+	return headerLen;
+}
+
+
+static int
+mg_websocket_write_exec(struct mg_connection *conn,
+                        int opcode,
+                        const char *data,
+                        size_t dataLen,
+                        uint32_t masking_key)
+{
+	unsigned char header[14];
+	size_t headerLen;
+	int retval;
+
+	headerLen = websocket_frame_header(header, opcode, dataLen);
+
 	if (masking_key) {
 		/* add mask */
 		header[1] |= 0x80;
@@ -12663,6 +12932,11 @@ mg_websocket_client_write(struct mg_connection *conn,
 }
 
 
+static int set_tcp_nodelay(SOCKET sock, int nodelay_on);
+
+#include "ws_broadcast.inl"
+
+
 static void
 handle_websocket_request(struct mg_connection *conn,
                          const char *path,
@@ -12869,6 +13143,7 @@ handle_websocket_request(struct mg_connection *conn,
 		read_websocket(conn, lua_websocket_data, conn->lua_websocket_state);
 #endif
 	}
+	ws_groups_leave_all(conn);
 
 	/* Step 8: Call the close handler */
 	if (ws_close_handler) {
@@ -13277,6 +13552,9 @@ handler_info_wait_unused(struct mg_handler_info *handler_info)
 }
 
 
+#include "router.inl"
+
+
 static void
 mg_set_handler_type(struct mg_context *phys_ctx,
                     struct mg_domain_context *dom_ctx,
@@ -13292,7 +13570,7 @@ mg_set_handler_type(struct mg_context *phys_ctx,
                     mg_authorization_handler auth_handler,
                     void *cbdata)
 {
-	struct mg_handler_info *tmp_rh, **lastref;
+	struct mg_handler_info *tmp_rh, *old_rh, **lastref;
 	size_t urilen = strlen(uri);
 
 	if (handler_type == WEBSOCKET_HANDLER) {
@@ -13353,108 +13631,104 @@ mg_set_handler_type(struct mg_context *phys_ctx,
 	mg_lock_context(phys_ctx);
 
 	/* first try to find an existing handler */
+	old_rh = NULL;
 	lastref = &(dom_ctx->handlers);
 	for (tmp_rh = dom_ctx->handlers; tmp_rh != NULL; tmp_rh = tmp_rh->next) {
 		if (tmp_rh->handler_type == handler_type) {
 			if ((urilen == tmp_rh->uri_len) && !strcmp(tmp_rh->uri, uri)) {
-				if (!is_delete_request) {
-					/* update existing handler */
-					if (handler_type == REQUEST_HANDLER) {
-						/* Wait for end of use before updating */
-						handler_info_wait_unused(tmp_rh);
-
-						/* Ok, the handler is no more use -> Update it */
-						tmp_rh->handler = handler;
-					} else if (handler_type == WEBSOCKET_HANDLER) {
-						tmp_rh->subprotocols = subprotocols;
-						tmp_rh->connect_handler = connect_handler;
-						tmp_rh->ready_handler = ready_handler;
-						tmp_rh->data_handler = data_handler;
-						tmp_rh->close_handler = close_handler;
-					} else { /* AUTH_HANDLER */
-						tmp_rh->auth_handler = auth_handler;
-					}
-					tmp_rh->cbdata = cbdata;
-				} else {
-					/* remove existing handler */
-					if (handler_type == REQUEST_HANDLER) {
-						/* Wait for end of use before removing */
-						handler_info_wait_unused(tmp_rh);
-
-						/* Ok, the handler is no more used -> Destroy resources
-						 */
-						pthread_cond_destroy(&tmp_rh->refcount_cond);
-						pthread_mutex_destroy(&tmp_rh->refcount_mutex);
-					}
-					*lastref = tmp_rh->next;
-					mg_free(tmp_rh->uri);
-					mg_free(tmp_rh);
-				}
-				mg_unlock_context(phys_ctx);
-				return;
+				old_rh = tmp_rh;
+				break;
 			}
 		}
 		lastref = &(tmp_rh->next);
 	}
 
 	if (is_delete_request) {
-		/* no handler to set, this was a remove request to a non-existing
-		 * handler */
-		mg_unlock_context(phys_ctx);
-		return;
-	}
-
-	tmp_rh =
-	    (struct mg_handler_info *)mg_calloc_ctx(1, sizeof(struct mg_handler_info),
-	                                            phys_ctx);
-	if (tmp_rh == NULL) {
-		mg_unlock_context(phys_ctx);
-		mg_cry_ctx_internal(phys_ctx,
-		                    "%s",
-		                    "Cannot create new request handler struct, OOM");
-		return;
-	}
-	tmp_rh->uri = mg_strdup_ctx(uri, phys_ctx);
-	if (!tmp_rh->uri) {
-		mg_unlock_context(phys_ctx);
-		mg_free(tmp_rh);
-		mg_cry_ctx_internal(phys_ctx,
-		                    "%s",
-		                    "Cannot create new request handler struct, OOM");
-		return;
-	}
-	tmp_rh->uri_len = urilen;
-	if (handler_type == REQUEST_HANDLER) {
-		/* Init refcount mutex and condition */
-		if (0 != pthread_mutex_init(&tmp_rh->refcount_mutex, NULL)) {
+		if (old_rh == NULL) {
+			/* no handler to set, this was a remove request to a
+			 * non-existing handler */
 			mg_unlock_context(phys_ctx);
-			mg_free(tmp_rh);
-			mg_cry_ctx_internal(phys_ctx, "%s", "Cannot init refcount mutex");
 			return;
 		}
-		if (0 != pthread_cond_init(&tmp_rh->refcount_cond, NULL)) {
+		/* remove existing handler */
+		*lastref = old_rh->next;
+	} else {
+		/* Handlers are used without the context lock (see router.inl),
+		 * so an existing handler is not modified, but replaced by a new
+		 * one at the same position in the list. */
+		tmp_rh = (struct mg_handler_info *)
+		    mg_calloc_ctx(1, sizeof(struct mg_handler_info), phys_ctx);
+		if (tmp_rh == NULL) {
+			mg_unlock_context(phys_ctx);
+			mg_cry_ctx_internal(phys_ctx,
+			                    "%s",
+			                    "Cannot create new request handler struct, OOM");
+			return;
+		}
+		tmp_rh->uri = mg_strdup_ctx(uri, phys_ctx);
+		if (!tmp_rh->uri) {
 			mg_unlock_context(phys_ctx);
-			pthread_mutex_destroy(&tmp_rh->refcount_mutex);
 			mg_free(tmp_rh);
-			mg_cry_ctx_internal(phys_ctx, "%s", "Cannot init refcount cond");
+			mg_cry_ctx_internal(phys_ctx,
+			                    "%s",
+			                    "Cannot create new request handler struct, OOM");
 			return;
 		}
-		tmp_rh->refcount = 0;
-		tmp_rh->handler = handler;
-	} else if (handler_type == WEBSOCKET_HANDLER) {
-		tmp_rh->subprotocols = subprotocols;
-		tmp_rh->connect_handler = connect_handler;
-		tmp_rh->ready_handler = ready_handler;
-		tmp_rh->data_handler = data_handler;
-		tmp_rh->close_handler = close_handler;
-	} else { /* AUTH_HANDLER */
-		tmp_rh->auth_handler = auth_handler;
+		tmp_rh->uri_len = urilen;
+		if (handler_type == REQUEST_HANDLER) {
+			/* Init refcount mutex and condition */
+			if (0 != pthread_mutex_init(&tmp_rh->refcount_mutex, NULL)) {
+				mg_unlock_context(phys_ctx);
+				mg_free(tmp_rh->uri);
+				mg_free(tmp_rh);
+				mg_cry_ctx_internal(phys_ctx,
+				                    "%s",
+				                    "Cannot init refcount mutex");
+				return;
+			}
+			if (0 != pthread_cond_init(&tmp_rh->refcount_cond, NULL)) {
+				mg_unlock_context(phys_ctx);
+				pthread_mutex_destroy(&tmp_rh->refcount_mutex);
+				mg_free(tmp_rh->uri);
+				mg_free(tmp_rh);
+				mg_cry_ctx_internal(phys_ctx, "%s", "Cannot init refcount cond");
+				return;
+			}
+			tmp_rh->refcount = 0;
+			tmp_rh->handler = handler;
+		} else if (handler_type == WEBSOCKET_HANDLER) {
+			tmp_rh->subprotocols = subprotocols;
+			tmp_rh->connect_handler = connect_handler;
+			tmp_rh->ready_handler = ready_handler;
+			tmp_rh->data_handler = data_handler;
+			tmp_rh->close_handler = close_handler;
+		} else { /* AUTH_HANDLER */
+			tmp_rh->auth_handler = auth_handler;
+		}
+		tmp_rh->cbdata = cbdata;
+		tmp_rh->handler_type = handler_type;
+		tmp_rh->next = (old_rh != NULL) ? old_rh->next : NULL;
+
+		*lastref = tmp_rh;
+	}
+
+	/* Make the new list visible to lookups. After this, the old handler
+	 * can only be used by requests that already found it. */
+	router_update(phys_ctx, dom_ctx);
+
+	if (old_rh != NULL) {
+		if (handler_type == REQUEST_HANDLER) {
+			/* Wait for end of use before removing */
+			handler_info_wait_unused(old_rh);
+
+			/* Ok, the handler is no more used -> Destroy resources */
+			pthread_cond_destroy(&old_rh->refcount_cond);
+			pthread_mutex_destroy(&old_rh->refcount_mutex);
+		}
+		mg_free(old_rh->uri);
+		mg_free(old_rh);
 	}
-	tmp_rh->cbdata = cbdata;
-	tmp_rh->handler_type = handler_type;
-	tmp_rh->next = NULL;
 
-	*lastref = tmp_rh;
 	mg_unlock_context(phys_ctx);
 }
 
@@ -13572,10 +13846,41 @@ get_request_handler(struct mg_connection *conn,
 		size_t urilen = strlen(uri);
 		struct mg_handler_info *tmp_rh;
 
+		struct mg_router *router;
+		int slot;
+
 		if (!conn || !conn->phys_ctx || !conn->dom_ctx) {
 			return 0;
 		}
 
+		/* Lookup in the compiled router, without the context lock */
+		slot = router_read_lock(conn->dom_ctx);
+		router = conn->dom_ctx->router;
+		if (router != NULL) {
+			tmp_rh = router_lookup(router, handler_type, uri, urilen);
+			if (tmp_rh != NULL) {
+				if (handler_type == WEBSOCKET_HANDLER) {
+					*subprotocols = tmp_rh->subprotocols;
+					*connect_handler = tmp_rh->connect_handler;
+					*ready_handler = tmp_rh->ready_handler;
+					*data_handler = tmp_rh->data_handler;
+					*close_handler = tmp_rh->close_handler;
+				} else if (handler_type == REQUEST_HANDLER) {
+					*handler = tmp_rh->handler;
+					/* Acquire handler and give it back */
+					handler_info_acquire(tmp_rh);
+					*handler_info = tmp_rh;
+				} else { /* AUTH_HANDLER */
+					*auth_handler = tmp_rh->auth_handler;
+				}
+				*cbdata = tmp_rh->cbdata;
+			}
+			router_read_unlock(conn->dom_ctx, slot);
+			return (tmp_rh != NULL);
+		}
+		router_read_unlock(conn->dom_ctx, slot);
+
+		/* No router (no handlers, or out of memory): search the list */
 		mg_lock_context(conn->phys_ctx);
 
 		/* first try for an exact match */
@@ -14843,10 +15148,13 @@ static void log_access(const struct mg_connection *conn);
 #include "external_log_access.inl"
 #elif !defined(NO_FILESYSTEMS)
 
+#include "access_log.inl"
+
 static void
 log_access(const struct mg_connection *conn)
 {
 	const struct mg_request_info *ri;
+	struct mg_access_log_ring *ring = NULL;
 	struct mg_file fi;
 	char date[64], src_addr[IP_ADDR_STR_LEN];
 	struct tm *tm;
@@ -14861,11 +15169,14 @@ log_access(const struct mg_connection *conn)
 	}
 
 	if (conn->dom_ctx->config[ACCESS_LOG_FILE] != NULL) {
-		if (mg_fopen(conn,
-		             conn->dom_ctx->config[ACCESS_LOG_FILE],
-		             MG_FOPEN_MODE_APPEND,
-		             &fi)
-		    == 0) {
+		/* A buffered log file is written by the log thread */
+		ring = access_log_ring(conn);
+		if ((ring != NULL)
+		    || (mg_fopen(conn,
+		                 conn->dom_ctx->config[ACCESS_LOG_FILE],
+		                 MG_FOPEN_MODE_APPEND,
+		                 &fi)
+		        == 0)) {
 			fi.access.fp = NULL;
 		}
 	} else {
@@ -14874,7 +15185,7 @@ log_access(const struct mg_connection *conn)
 
 	/* Log is written to a file and/or a callback. If both are not set,
 	 * executing the rest of the function is pointless. */
-	if ((fi.access.fp == NULL)
+	if ((fi.access.fp == NULL) && (ring == NULL)
 	    && (conn->phys_ctx->callbacks.log_access == NULL)) {
 		return;
 	}
@@ -14915,6 +15226,10 @@ log_access(const struct mg_connection *conn)
 		conn->phys_ctx->callbacks.log_access(conn, buf);
 	}
 
+	if (ring) {
+		access_log_append(conn, ring, buf);
+	}
+
 	if (fi.access.fp) {
 		int ok = 1;
 		flockfile(fi.access.fp);
@@ -17540,6 +17855,13 @@ init_connection(struct mg_connection *conn)
 }
 
 
+#if defined(USE_EPOLL)
+static void produce_socket(struct mg_context *ctx, const struct socket *sp);
+
+#include "reactor.inl"
+#endif
+
+
 /* Process a connection - may handle multiple requests
  * using the same connection.
  * Must be called with a valid connection (conn  and
@@ -17553,10 +17875,32 @@ process_new_connection(struct mg_connection *conn)
 	char ebuf[100];
 	const char *hostend;
 	int reqerr, uri_type;
+	int parked = 0;
+#if defined(USE_SERVER_STATS)
+	int mcon, handled_before;
+#endif
+
+#if defined(USE_EPOLL)
+	if (conn->client.resumed) {
+		/* Keep-alive connection handed back by the reactor */
+		if (!reactor_resume_connection(conn)) {
+			DEBUG_TRACE("Keep-alive timeout for %s",
+			            conn->request_info.remote_addr);
+			close_connection(conn);
+			return;
+		}
+	} else
+#endif
+	{
+		init_connection(conn);
+	}
 
 #if defined(USE_SERVER_STATS)
-	int mcon = mg_atomic_inc(&(conn->phys_ctx->active_connections));
-	mg_atomic_add(&(conn->phys_ctx->total_connections), 1);
+	handled_before = conn->handled_requests;
+	mcon = mg_atomic_inc(&(conn->phys_ctx->active_connections));
+	if (handled_before == 0) {
+		mg_atomic_add(&(conn->phys_ctx->total_connections), 1);
+	}
 	if (mcon > (conn->phys_ctx->max_connections)) {
 		/* could use atomic compare exchange, but this
 		 * seems overkill for statistics data */
@@ -17564,8 +17908,6 @@ process_new_connection(struct mg_connection *conn)
 	}
 #endif
 
-	init_connection(conn);
-
 	DEBUG_TRACE("Start processing connection from %s",
 	            conn->request_info.remote_addr);
 
@@ -17724,22 +18066,38 @@ process_new_connection(struct mg_connection *conn)
 
 		conn->handled_requests++;
 
+#if defined(USE_EPOLL)
+		/* Do not block this worker while the client is idle: let the
+		 * reactor wait for the next request. */
+		if (keep_alive && reactor_park_connection(conn)) {
+			parked = 1;
+			break;
+		}
+#endif
+
 	} while (keep_alive);
 
-	DEBUG_TRACE("Done processing connection from %s (%f sec)",
-	            conn->request_info.remote_addr,
-	            difftime(time(NULL), conn->conn_birth_time));
+	if (!parked) {
+		DEBUG_TRACE("Done processing connection from %s (%f sec)",
+		            conn->request_info.remote_addr,
+		            difftime(time(NULL), conn->conn_birth_time));
 
-	close_connection(conn);
+		close_connection(conn);
+	}
 
 #if defined(USE_SERVER_STATS)
-	mg_atomic_add(&(conn->phys_ctx->total_requests), conn->handled_requests);
+	mg_atomic_add(&(conn->phys_ctx->total_requests),
+	              conn->handled_requests - handled_before);
 	mg_atomic_dec(&(conn->phys_ctx->active_connections));
 #endif
 }
 
 
-#if defined(ALTERNATIVE_QUEUE)
+#if defined(USE_LOCKFREE_QUEUE)
+
+#include "sockqueue.inl"
+
+#elif defined(ALTERNATIVE_QUEUE)
 
 static void
 produce_socket(struct mg_context *ctx, const struct socket *sp)
@@ -18156,6 +18514,9 @@ accept_new_connection(const struct socket *listener, struct mg_context *ctx)
 		set_non_blocking_mode(so.sock);
 
 		so.in_use = 0;
+#if defined(USE_EPOLL)
+		so.resumed = 0;
+#endif
 		produce_socket(ctx, &so);
 	}
 }
@@ -18332,9 +18693,31 @@ free_context(struct mg_context *ctx)
 	/* All threads exited, no sync is needed. Destroy thread mutex and
 	 * condvars
 	 */
+#if !defined(MG_EXTERNAL_FUNCTION_log_access) && !defined(NO_FILESYSTEMS)
+	/* Write the remaining lines while the domains still exist */
+	access_log_exit(ctx);
+#endif
+
+#if defined(USE_EPOLL)
+	/* Must be stopped before the queue is destroyed */
+	reactor_exit(ctx);
+#endif
+
+#if !defined(NO_CACHING) && !defined(_WIN32)
+	file_cache_exit(ctx);
+#endif
+
+#if defined(USE_WEBSOCKET)
+	ws_groups_exit(ctx);
+#endif
+
 	(void)pthread_mutex_destroy(&ctx->thread_mutex);
 #if defined(ALTERNATIVE_QUEUE)
+#if defined(USE_LOCKFREE_QUEUE)
+	sockqueue_exit(ctx);
+#else
 	mg_free(ctx->client_socks);
+#endif
 	for (i = 0; (unsigned)i < ctx->cfg_worker_threads; i++) {
 		event_destroy(ctx->client_wait_events[i]);
 	}
@@ -18362,6 +18745,8 @@ free_context(struct mg_context *ctx)
 	}
 
 	/* Deallocate request handlers */
+	router_free(ctx->dd.router);
+	ctx->dd.router = NULL;
 	while (ctx->dd.handlers) {
 		tmp_rh = ctx->dd.handlers;
 		ctx->dd.handlers = tmp_rh->next;
@@ -18748,6 +19133,18 @@ mg_start(const struct mg_callbacks *callbacks,
 		return NULL;
 	}
 
+#if defined(USE_LOCKFREE_QUEUE)
+	if (sockqueue_init(ctx) != 0) {
+		mg_cry_ctx_internal(ctx,
+		                    "%s",
+		                    "Not enough memory for accepted socket queue");
+		mg_free(ctx->client_wait_events);
+		mg_free(ctx->worker_threadids);
+		free_context(ctx);
+		pthread_setspecific(sTlsKey, NULL);
+		return NULL;
+	}
+#else
 	ctx->client_socks =
 	    (struct socket *)mg_calloc_ctx(ctx->cfg_worker_threads,
 	                                   sizeof(ctx->client_socks[0]),
@@ -18762,6 +19159,7 @@ mg_start(const struct mg_callbacks *callbacks,
 		pthread_setspecific(sTlsKey, NULL);
 		return NULL;
 	}
+#endif
 
 	for (i = 0; (unsigned)i < ctx->cfg_worker_threads; i++) {
 		ctx->client_wait_events[i] = event_create();
@@ -18771,7 +19169,9 @@ mg_start(const struct mg_callbacks *callbacks,
 				i--;
 				event_destroy(ctx->client_wait_events[i]);
 			}
+#if !defined(USE_LOCKFREE_QUEUE)
 			mg_free(ctx->client_socks);
+#endif
 			mg_free(ctx->client_wait_events);
 			mg_free(ctx->worker_threadids);
 			free_context(ctx);
@@ -18791,6 +19191,33 @@ mg_start(const struct mg_callbacks *callbacks,
 	}
 #endif
 
+#if defined(USE_EPOLL)
+	if (reactor_init(ctx) != 0) {
+		mg_cry_ctx_internal(ctx, "%s", "Error creating keep-alive reactor");
+		free_context(ctx);
+		pthread_setspecific(sTlsKey, NULL);
+		return NULL;
+	}
+#endif
+
+#if !defined(NO_CACHING) && !defined(_WIN32)
+	if (file_cache_init(ctx) != 0) {
+		mg_cry_ctx_internal(ctx, "%s", "Error creating static file cache");
+		free_context(ctx);
+		pthread_setspecific(sTlsKey, NULL);
+		return NULL;
+	}
+#endif
+
+#if !defined(MG_EXTERNAL_FUNCTION_log_access) && !defined(NO_FILESYSTEMS)
+	if (access_log_init(ctx) != 0) {
+		mg_cry_ctx_internal(ctx, "%s", "Error creating access log buffers");
+		free_context(ctx);
+		pthread_setspecific(sTlsKey, NULL);
+		return NULL;
+	}
+#endif
+
 	/* Context has been created - init user libraries */
 	if (ctx->callbacks.init_context) {
 		ctx->callbacks.init_context(ctx);
@@ -18894,6 +19321,7 @@ mg_start_domain(struct mg_context *ctx, const char **options)
 	}
 
 	new_dom->handlers = NULL;
+	new_dom->router = NULL;
 	new_dom->next = NULL;
 	new_dom->nonce_count = 0;
 	new_dom->auth_nonce_mask =
@@ -19433,6 +19861,116 @@ mg_get_context_info(const struct mg_context *ctx, char *buffer, int buflen)
 		            eol);
 		context_info_length += mg_str_append(&buffer, end, block);
 
+#if defined(USE_EPOLL)
+		/* Keep-alive reactor information */
+		if (ctx->reactor) {
+			struct mg_reactor *reactor = ctx->reactor;
+
+			pthread_mutex_lock(&reactor->mutex);
+			mg_snprintf(NULL,
+			            NULL,
+			            block,
+			            sizeof(block),
+			            ",%s\"keepAliveReactor\" : {%s"
+			            "\"parked\" : %u,%s"
+			            "\"maxParked\" : %u,%s"
+			            "\"totalParked\" : %" INT64_FMT ",%s"
+			            "\"expired\" : %" INT64_FMT "%s"
+			            "}",
+			            eol,
+			            eol,
+			            reactor->parked_count,
+			            eol,
+			            reactor->parked_max,
+			            eol,
+			            reactor->total_parked,
+			            eol,
+			            reactor->total_expired,
+			            eol);
+			pthread_mutex_unlock(&reactor->mutex);
+			context_info_length += mg_str_append(&buffer, end, block);
+		}
+#endif
+
+#if !defined(NO_CACHING) && !defined(_WIN32)
+		/* Static file cache information */
+		if (ctx->file_cache) {
+			struct mg_file_cache *fc = ctx->file_cache;
+
+			pthread_mutex_lock(&fc->mutex);
+			mg_snprintf(NULL,
+			            NULL,
+			            block,
+			            sizeof(block),
+			            ",%s\"staticFileCache\" : {%s"
+			            "\"entries\" : %u,%s"
+			            "\"maxEntries\" : %u,%s"
+			            "\"hits\" : %" INT64_FMT ",%s"
+			            "\"misses\" : %" INT64_FMT ",%s"
+			            "\"evictions\" : %" INT64_FMT "%s"
+			            "}",
+			            eol,
+			            eol,
+			            fc->count,
+			            eol,
+			            fc->max_entries,
+			            eol,
+			            fc->hits,
+			            eol,
+			            fc->misses,
+			            eol,
+			            fc->evictions,
+			            eol);
+			pthread_mutex_unlock(&fc->mutex);
+			context_info_length += mg_str_append(&buffer, end, block);
+		}
+#endif
+
+#if !defined(MG_EXTERNAL_FUNCTION_log_access) && !defined(NO_FILESYSTEMS)
+		/* Buffered access log information */
+		if (ctx->access_log) {
+			struct mg_access_log *log = ctx->access_log;
+			int64_t records = 0, dropped = 0, flushes, write_errors;
+			unsigned i;
+
+			for (i = 0; i < log->num_rings; i++) {
+				pthread_mutex_lock(&log->rings[i].mutex);
+				records += log->rings[i].records;
+				dropped += log->rings[i].dropped;
+				pthread_mutex_unlock(&log->rings[i].mutex);
+			}
+			pthread_mutex_lock(&log->mutex);
+			flushes = log->flushes;
+			write_errors = log->write_errors;
+			pthread_mutex_unlock(&log->mutex);
+
+			mg_snprintf(NULL,
+			            NULL,
+			            block,
+			            sizeof(block),
+			            ",%s\"accessLog\" : {%s"
+			            "\"bufferSize\" : %lu,%s"
+			            "\"records\" : %" INT64_FMT ",%s"
+			            "\"dropped\" : %" INT64_FMT ",%s"
+			            "\"flushes\" : %" INT64_FMT ",%s"
+			            "\"writeErrors\" : %" INT64_FMT "%s"
+			            "}",
+			            eol,
+			            eol,
+			            (unsigned long)log->size,
+			            eol,
+			            records,
+			            eol,
+			            dropped,
+			            eol,
+			            flushes,
+			            eol,
+			            write_errors,
+			            eol);
+			context_info_length += mg_str_append(&buffer, end, block);
+		}
+#endif
+
 		/* Requests information */
 		mg_snprintf(NULL,
 		            NULL,
@@ -0,0 +1,491 @@
+/* This file is part of the CivetWeb web server.
+ * See https://github.com/civetweb/civetweb/
+ * (C) 2020 by the CivetWeb authors, MIT license.
+ */
+
+/* Static file cache (POSIX).
+ *
+ * handle_static_file_request() stats and opens every file it sends, probes
+ * for a precompressed "file.gz" and looks up the MIME type. With the
+ * "static_file_cache_entries" option, this information is kept in a
+ * bounded LRU cache keyed by file path and domain: the stat info, MIME
+ * type, ETag, and an open file descriptor (or a copy of the content for
+ * small files), both for the file and for its ".gz" variant.
+ *
+ * An entry is used as long as size and modification time match the stat
+ * done by interpret_uri() for the request, and for at most
+ * "static_file_cache_ttl_ms" (to notice a new or removed ".gz" variant or
+ * a replaced file with the same time stamp). Entries in use are reference
+ * counted, so an evicted entry is only closed after its last request.
+ *
+ * Small files are copied to memory instead of being mapped: a shared mapping
+ * of a file that is truncated while a request sends it raises SIGBUS. Larger
+ * files are read with pread() or sendfile(), which just stop early then.
+ */
+
+/* Files up to this size are copied to memory, larger files are sent
+ * from the open file descriptor. */
+#if !defined(MG_FILE_CACHE_COPY_LIMIT)
+#define MG_FILE_CACHE_COPY_LIMIT (256 * 1024)
+#endif
+
+
+struct mg_file_cache_variant {
+	struct mg_file_stat stat; /* size == 0 and fd == -1: not available */
+	int fd;                   /* Open file, -1 if copied */
+	char *data;               /* Copy of the whole file, or NULL */
+	char etag[64];
+};
+
+
+struct mg_file_cache_entry {
+	char *path;                           /* Key: file path ... */
+	const struct mg_domain_context *dom; /* ... and domain (MIME types) */
+	unsigned hash;
+	struct vec mime;                   /* MIME type of path */
+	struct mg_file_cache_variant plain; /* The file itself */
+	struct mg_file_cache_variant gz;    /* path.gz, if available */
+	double expires;                     /* file_cache_time() */
+	int refcount;                       /* Cache + requests using it */
+	struct mg_file_cache_entry *hnext;  /* Hash bucket list */
+	struct mg_file_cache_entry *prev;   /* LRU list, head = most recent */
+	struct mg_file_cache_entry *next;
+};
+
+
+struct mg_file_cache {
+	pthread_mutex_t mutex; /* Protects everything below */
+	struct mg_file_cache_entry **buckets;
+	unsigned bucket_mask;
+	unsigned count;
+	unsigned max_entries;
+	double ttl;
+	struct mg_file_cache_entry *head;
+	struct mg_file_cache_entry *tail;
+	int64_t hits;
+	int64_t misses;
+	int64_t evictions;
+};
+
+
+static double
+file_cache_time(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0E-9;
+}
+
+
+static unsigned
+file_cache_hash(const char *path, const struct mg_domain_context *dom)
+{
+	/* FNV-1a */
+	unsigned h = 2166136261u ^ (unsigned)(uintptr_t)dom;
+	while (*path) {
+		h ^= (unsigned char)*path++;
+		h *= 16777619u;
+	}
+	return h;
+}
+
+
+static void
+file_cache_close_variant(struct mg_file_cache_variant *v)
+{
+	if (v->data != NULL) {
+		mg_free(v->data);
+		v->data = NULL;
+	}
+	if (v->fd >= 0) {
+		(void)close(v->fd);
+		v->fd = -1;
+	}
+}
+
+
+static void
+file_cache_free_entry(struct mg_file_cache_entry *e)
+{
+	file_cache_close_variant(&e->plain);
+	file_cache_close_variant(&e->gz);
+	mg_free(e->path);
+	mg_free(e);
+}
+
+
+/* Open a file for the cache. Returns 0 if the file cannot be used. */
+static int
+file_cache_open_variant(const char *path, struct mg_file_cache_variant *v)
+{
+	struct stat st;
+
+	v->fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (v->fd < 0) {
+		return 0;
+	}
+	if ((fstat(v->fd, &st) != 0) || !S_ISREG(st.st_mode)) {
+		(void)close(v->fd);
+		v->fd = -1;
+		return 0;
+	}
+	v->stat.size = (uint64_t)st.st_size;
+	v->stat.last_modified = st.st_mtime;
+	v->stat.location = 1;
+	construct_etag(v->etag, sizeof(v->etag), &v->stat);
+
+	if ((st.st_size > 0) && (st.st_size <= MG_FILE_CACHE_COPY_LIMIT)) {
+		char *data = (char *)mg_malloc((size_t)st.st_size);
+		size_t len = 0;
+		ssize_t n = 1;
+
+		while ((data != NULL) && (len < (size_t)st.st_size) && (n > 0)) {
+			n = pread(v->fd, data + len, (size_t)st.st_size - len, (off_t)len);
+			if (n > 0) {
+				len += (size_t)n;
+			}
+		}
+		if ((data != NULL) && (len == (size_t)st.st_size)) {
+			v->data = data;
+			(void)close(v->fd);
+			v->fd = -1;
+		} else {
+			/* Out of memory, or truncated while reading: use the file */
+			mg_free(data);
+		}
+	}
+	return 1;
+}
+
+
+/* Must be called with the cache mutex locked. */
+static void
+file_cache_unlink(struct mg_file_cache *fc, struct mg_file_cache_entry *e)
+{
+	struct mg_file_cache_entry **pp = &fc->buckets[e->hash & fc->bucket_mask];
+
+	while (*pp != e) {
+		pp = &(*pp)->hnext;
+	}
+	*pp = e->hnext;
+
+	if (e->prev) {
+		e->prev->next = e->next;
+	} else {
+		fc->head = e->next;
+	}
+	if (e->next) {
+		e->next->prev = e->prev;
+	} else {
+		fc->tail = e->prev;
+	}
+	e->hnext = e->prev = e->next = NULL;
+	fc->count--;
+
+	/* Drop the reference of the cache */
+	if (--e->refcount == 0) {
+		file_cache_free_entry(e);
+	}
+}
+
+
+/* Must be called with the cache mutex locked. */
+static void
+file_cache_link(struct mg_file_cache *fc, struct mg_file_cache_entry *e)
+{
+	unsigned b = e->hash & fc->bucket_mask;
+
+	e->hnext = fc->buckets[b];
+	fc->buckets[b] = e;
+	e->prev = NULL;
+	e->next = fc->head;
+	if (fc->head) {
+		fc->head->prev = e;
+	} else {
+		fc->tail = e;
+	}
+	fc->head = e;
+	fc->count++;
+	e->refcount++;
+
+	while (fc->count > fc->max_entries) {
+		file_cache_unlink(fc, fc->tail);
+		fc->evictions++;
+	}
+}
+
+
+/* Must be called with the cache mutex locked. */
+static struct mg_file_cache_entry *
+file_cache_find(struct mg_file_cache *fc,
+                const char *path,
+                const struct mg_domain_context *dom,
+                unsigned hash)
+{
+	struct mg_file_cache_entry *e;
+
+	for (e = fc->buckets[hash & fc->bucket_mask]; e != NULL; e = e->hnext) {
+		if ((e->hash == hash) && (e->dom == dom) && !strcmp(e->path, path)) {
+			return e;
+		}
+	}
+	return NULL;
+}
+
+
+static struct mg_file_cache_entry *
+file_cache_create_entry(struct mg_connection *conn,
+                        const char *path,
+                        const struct mg_file_stat *filestat,
+                        unsigned hash)
+{
+	struct mg_file_cache_entry *e;
+	char gz_path[PATH_MAX];
+	int truncated;
+
+	e = (struct mg_file_cache_entry *)
+	    mg_calloc_ctx(1, sizeof(struct mg_file_cache_entry), conn->phys_ctx);
+	if (e == NULL) {
+		return NULL;
+	}
+	e->plain.fd = e->gz.fd = -1;
+	e->path = mg_strdup_ctx(path, conn->phys_ctx);
+	if ((e->path == NULL) || !file_cache_open_variant(path, &e->plain)
+	    || (e->plain.stat.size != filestat->size)
+	    || (e->plain.stat.last_modified != filestat->last_modified)) {
+		/* Not found, or modified since interpret_uri */
+		file_cache_free_entry(e);
+		return NULL;
+	}
+
+	if (e->plain.stat.size >= MG_FILE_COMPRESSION_SIZE_LIMIT) {
+		mg_snprintf(conn, &truncated, gz_path, sizeof(gz_path), "%s.gz", path);
+		if (!truncated && file_cache_open_variant(gz_path, &e->gz)) {
+			e->gz.stat.is_gzipped = 1;
+		}
+	}
+
+	get_mime_type(conn, path, &e->mime);
+	e->dom = conn->dom_ctx;
+	e->hash = hash;
+	e->expires = file_cache_time() + conn->phys_ctx->file_cache->ttl;
+	e->refcount = 1; /* for the caller */
+	return e;
+}
+
+
+/* Get a cache entry for the file path, found by interpret_uri() with
+ * filestat. Returns NULL if the cache is disabled or the file cannot be
+ * cached. A returned entry must be released by file_cache_release. */
+static struct mg_file_cache_entry *
+file_cache_acquire(struct mg_connection *conn,
+                   const char *path,
+                   const struct mg_file_stat *filestat)
+{
+	struct mg_file_cache *fc = conn->phys_ctx->file_cache;
+	struct mg_file_cache_entry *e, *existing;
+	unsigned hash;
+
+	if ((fc == NULL) || filestat->is_gzipped || filestat->is_directory) {
+		return NULL;
+	}
+	hash = file_cache_hash(path, conn->dom_ctx);
+
+	pthread_mutex_lock(&fc->mutex);
+	e = file_cache_find(fc, path, conn->dom_ctx, hash);
+	if (e != NULL) {
+		if ((e->plain.stat.size != filestat->size)
+		    || (e->plain.stat.last_modified != filestat->last_modified)
+		    || (file_cache_time() >= e->expires)) {
+			/* Modified or expired */
+			file_cache_unlink(fc, e);
+			e = NULL;
+		} else {
+			fc->hits++;
+			e->refcount++;
+			if (e != fc->head) {
+				/* Move to the head of the LRU list */
+				e->prev->next = e->next;
+				if (e->next) {
+					e->next->prev = e->prev;
+				} else {
+					fc->tail = e->prev;
+				}
+				e->prev = NULL;
+				e->next = fc->head;
+				fc->head->prev = e;
+				fc->head = e;
+			}
+		}
+	}
+	if (e == NULL) {
+		fc->misses++;
+	}
+	pthread_mutex_unlock(&fc->mutex);
+
+	if (e != NULL) {
+		return e;
+	}
+
+	/* Open the file without holding the lock */
+	e = file_cache_create_entry(conn, path, filestat, hash);
+	if (e == NULL) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&fc->mutex);
+	existing = file_cache_find(fc, path, conn->dom_ctx, hash);
+	if (existing != NULL) {
+		/* Another thread was faster: replace its entry by the new one */
+		file_cache_unlink(fc, existing);
+	}
+	file_cache_link(fc, e);
+	pthread_mutex_unlock(&fc->mutex);
+
+	return e;
+}
+
+
+static void
+file_cache_release(struct mg_context *ctx, struct mg_file_cache_entry *e)
+{
+	struct mg_file_cache *fc = ctx->file_cache;
+	int unused;
+
+	pthread_mutex_lock(&fc->mutex);
+	unused = (--e->refcount == 0);
+	pthread_mutex_unlock(&fc->mutex);
+
+	if (unused) {
+		/* Evicted while in use */
+		file_cache_free_entry(e);
+	}
+}
+
+
+/* Send len bytes of a cached file, like send_file_data. */
+static void
+file_cache_send(struct mg_connection *conn,
+                const struct mg_file_cache_variant *v,
+                int64_t offset,
+                int64_t len)
+{
+	char buf[MG_BUF_LEN];
+	int64_t size = (int64_t)v->stat.size;
+	ssize_t num_read;
+
+	offset = (offset < 0) ? 0 : ((offset > size) ? size : offset);
+	if (len > size - offset) {
+		len = size - offset;
+	}
+	if (len <= 0) {
+		return;
+	}
+
+	if (v->data != NULL) {
+		mg_write(conn, v->data + offset, (size_t)len);
+		return;
+	}
+
+#if defined(__linux__)
+	if ((conn->ssl == 0) && (conn->throttle == 0)
+	    && (!mg_strcasecmp(conn->dom_ctx->config[ALLOW_SENDFILE_CALL],
+	                       "yes"))) {
+		off_t sf_offs = (off_t)offset;
+		ssize_t sf_sent;
+
+		do {
+			size_t sf_tosend = (size_t)((len < 0x7FFFF000) ? len : 0x7FFFF000);
+			sf_sent = sendfile(conn->client.sock, v->fd, &sf_offs, sf_tosend);
+			if (sf_sent > 0) {
+				len -= sf_sent;
+			}
+		} while ((len > 0) && (sf_sent > 0));
+
+		if ((len == 0) || (sf_sent == 0)) {
+			return;
+		}
+		/* Error: continue with pread */
+		offset = (int64_t)sf_offs;
+	}
+#endif
+
+	while (len > 0) {
+		size_t to_read = (len < (int64_t)sizeof(buf)) ? (size_t)len : sizeof(buf);
+		num_read = pread(v->fd, buf, to_read, (off_t)offset);
+		if (num_read <= 0) {
+			break;
+		}
+		if (mg_write(conn, buf, (size_t)num_read) != (int)num_read) {
+			break;
+		}
+		offset += num_read;
+		len -= num_read;
+	}
+}
+
+
+static int
+file_cache_init(struct mg_context *ctx)
+{
+	const char *entries_cfg = ctx->dd.config[STATIC_FILE_CACHE_ENTRIES];
+	const char *ttl_cfg = ctx->dd.config[STATIC_FILE_CACHE_TTL];
+	long max_entries = (entries_cfg ? strtol(entries_cfg, NULL, 10) : 0);
+	struct mg_file_cache *fc;
+	unsigned buckets = 16;
+
+	ctx->file_cache = NULL;
+	if (max_entries <= 0) {
+		/* Cache disabled */
+		return 0;
+	}
+	if (max_entries > 1000000) {
+		max_entries = 1000000;
+	}
+	while (buckets < 2 * (unsigned)max_entries) {
+		buckets *= 2;
+	}
+
+	fc = (struct mg_file_cache *)mg_calloc_ctx(1, sizeof(*fc), ctx);
+	if (fc == NULL) {
+		return -1;
+	}
+	fc->buckets = (struct mg_file_cache_entry **)
+	    mg_calloc_ctx(buckets, sizeof(fc->buckets[0]), ctx);
+	if (fc->buckets == NULL) {
+		mg_free(fc);
+		return -1;
+	}
+	if (0 != pthread_mutex_init(&fc->mutex, NULL)) {
+		mg_free(fc->buckets);
+		mg_free(fc);
+		return -1;
+	}
+	fc->bucket_mask = buckets - 1;
+	fc->max_entries = (unsigned)max_entries;
+	fc->ttl = (ttl_cfg ? atof(ttl_cfg) : 0.0) / 1000.0;
+
+	ctx->file_cache = fc;
+	return 0;
+}
+
+
+/* Must be called after all worker threads have been joined. */
+static void
+file_cache_exit(struct mg_context *ctx)
+{
+	struct mg_file_cache *fc = ctx->file_cache;
+
+	if (fc != NULL) {
+		while (fc->head != NULL) {
+			file_cache_unlink(fc, fc->head);
+		}
+		(void)pthread_mutex_destroy(&fc->mutex);
+		mg_free(fc->buckets);
+		mg_free(fc);
+		ctx->file_cache = NULL;
+	}
+}
+
+
+/* End of file_cache.inl */
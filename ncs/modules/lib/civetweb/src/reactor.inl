@@ -0,0 +1,376 @@
+/* This file is part of the CivetWeb web server.
+ * See https://github.com/civetweb/civetweb/
+ * (C) 2020 by the CivetWeb authors, MIT license.
+ */
+
+/* Keep-alive reactor (Linux epoll).
+ *
+ * Without the reactor, a worker thread owns a connection for its whole
+ * keep-alive lifetime and blocks in get_request() while the client is
+ * idle. With the reactor, a worker that finished a request on a keep-alive
+ * connection "parks" the socket in an epoll set and returns to the queue.
+ * The reactor thread hands the socket back to a worker (using
+ * produce_socket(), like a newly accepted connection) once the next request
+ * is readable, or once the keep-alive timeout expired, so the connection
+ * can be closed by a worker (including the connection_close callback).
+ */
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#if !defined(REACTOR_MAX_EVENTS)
+#define REACTOR_MAX_EVENTS (64)
+#endif
+
+/* Poll interval of the reactor thread in milliseconds. This is the
+ * resolution of the keep-alive timeout and the latency for mg_stop. */
+#if !defined(REACTOR_POLL_INTERVAL_MS)
+#define REACTOR_POLL_INTERVAL_MS (100)
+#endif
+
+
+struct mg_parked_conn {
+	struct socket client; /* Socket including the keep-alive state */
+	double deadline;      /* Keep-alive timeout (reactor_getcurrenttime) */
+	struct mg_parked_conn *prev;
+	struct mg_parked_conn *next;
+};
+
+
+struct mg_reactor {
+	pthread_t threadid;          /* Reactor thread ID */
+	pthread_mutex_t mutex;       /* Protects the list of parked connections */
+	int epoll_fd;                /* epoll instance of all parked sockets */
+	int wake_fd;                 /* eventfd in epoll_fd, wakes up the thread */
+	struct mg_parked_conn *head; /* List of parked connections */
+	unsigned parked_count;       /* Current number of parked connections */
+	unsigned parked_max;         /* Limit from "max_idle_connections" */
+	int64_t total_parked;        /* Number of times a socket was parked */
+	int64_t total_expired;       /* Keep-alive timeouts while parked */
+};
+
+
+static double
+reactor_getcurrenttime(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0E-9;
+}
+
+
+/* Must be called with reactor->mutex locked. */
+static void
+reactor_unlink(struct mg_reactor *reactor, struct mg_parked_conn *pc)
+{
+	(void)epoll_ctl(reactor->epoll_fd, EPOLL_CTL_DEL, pc->client.sock, NULL);
+
+	if (pc->prev) {
+		pc->prev->next = pc->next;
+	} else {
+		reactor->head = pc->next;
+	}
+	if (pc->next) {
+		pc->next->prev = pc->prev;
+	}
+	pc->prev = pc->next = NULL;
+	reactor->parked_count--;
+}
+
+
+/* Called by a worker thread after a request on a keep-alive connection
+ * has been completed. Returns 1 if the reactor took over the socket,
+ * and 0 if the worker should continue with the keep-alive loop. */
+static int
+reactor_park_connection(struct mg_connection *conn)
+{
+	struct mg_context *ctx = conn->phys_ctx;
+	struct mg_reactor *reactor = ctx->reactor;
+	struct mg_parked_conn *pc;
+	struct epoll_event ev;
+	struct mg_pollfd pfd;
+	double keep_alive_timeout;
+
+	if ((reactor == NULL) || (ctx->stop_flag != 0) || conn->client.is_ssl
+	    || (conn->data_len != 0)) {
+		/* SSL connections hold state in conn->ssl, and buffered
+		 * (pipelined) data must be processed by this worker. */
+		return 0;
+	}
+
+	/* If the next request is already there, there is no point in a
+	 * round trip through the reactor. */
+	pfd.fd = conn->client.sock;
+	pfd.events = POLLIN;
+	pfd.revents = 0;
+	if (poll(&pfd, 1, 0) != 0) {
+		return 0;
+	}
+
+	keep_alive_timeout = 0.0;
+	if (conn->dom_ctx->config[KEEP_ALIVE_TIMEOUT]) {
+		keep_alive_timeout =
+		    atof(conn->dom_ctx->config[KEEP_ALIVE_TIMEOUT]) / 1000.0;
+	}
+
+	pc = (struct mg_parked_conn *)mg_calloc_ctx(1, sizeof(*pc), ctx);
+	if (pc == NULL) {
+		return 0;
+	}
+	pc->client = conn->client;
+	pc->client.resumed = 1;
+	pc->client.handled_requests = conn->handled_requests;
+	pc->client.conn_birth_time = conn->conn_birth_time;
+	pc->client.conn_data = conn->request_info.conn_data;
+	pc->deadline = reactor_getcurrenttime() + keep_alive_timeout;
+
+	memset(&ev, 0, sizeof(ev));
+	ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+	ev.data.ptr = pc;
+
+	pthread_mutex_lock(&reactor->mutex);
+	if ((reactor->parked_count >= reactor->parked_max)
+	    || (epoll_ctl(reactor->epoll_fd, EPOLL_CTL_ADD, pc->client.sock, &ev)
+	        != 0)) {
+		pthread_mutex_unlock(&reactor->mutex);
+		mg_free(pc);
+		return 0;
+	}
+	pc->next = reactor->head;
+	if (reactor->head) {
+		reactor->head->prev = pc;
+	}
+	reactor->head = pc;
+	reactor->parked_count++;
+	reactor->total_parked++;
+	/* pc may be resumed by the reactor thread as soon as the mutex is
+	 * unlocked, so it must not be accessed after this point. */
+	pthread_mutex_unlock(&reactor->mutex);
+
+	DEBUG_TRACE("parked socket %d", (int)conn->client.sock);
+
+	/* The socket and the user connection data now belong to the
+	 * reactor. */
+	conn->client.sock = INVALID_SOCKET;
+	mg_set_user_connection_data(conn, NULL);
+	if (conn->host) {
+		mg_free((void *)conn->host);
+		conn->host = NULL;
+	}
+
+	return 1;
+}
+
+
+/* Called by a worker thread instead of init_connection() for a socket
+ * received from the reactor. Returns 0 if the keep-alive timeout expired
+ * and the connection must be closed. */
+static int
+reactor_resume_connection(struct mg_connection *conn)
+{
+	conn->data_len = 0;
+	conn->handled_requests = conn->client.handled_requests;
+	conn->conn_birth_time = conn->client.conn_birth_time;
+	mg_set_user_connection_data(conn, conn->client.conn_data);
+
+#if defined(USE_SERVER_STATS)
+	conn->conn_state = 2; /* init */
+#endif
+
+	return (conn->client.resumed != 2);
+}
+
+
+static void
+reactor_thread_run(void *thread_func_param)
+{
+	struct mg_context *ctx = (struct mg_context *)thread_func_param;
+	struct mg_reactor *reactor = ctx->reactor;
+	struct epoll_event events[REACTOR_MAX_EVENTS];
+	struct mg_parked_conn *pc, *next, *expired;
+	struct socket so;
+	double now;
+	int i, n;
+
+	mg_set_thread_name("reactor");
+
+	if (ctx->callbacks.init_thread) {
+		/* Reactor thread: same thread type as the timer thread, it does
+		 * not call any request handlers. */
+		ctx->callbacks.init_thread(ctx, 2);
+	}
+
+	while (ctx->stop_flag == 0) {
+		n = epoll_wait(reactor->epoll_fd,
+		               events,
+		               REACTOR_MAX_EVENTS,
+		               REACTOR_POLL_INTERVAL_MS);
+
+		/* Readable (or closed by the peer): hand it to a worker. */
+		for (i = 0; i < n; i++) {
+			pc = (struct mg_parked_conn *)events[i].data.ptr;
+			if (pc == NULL) {
+				/* wake_fd: woken up by reactor_exit */
+				continue;
+			}
+
+			pthread_mutex_lock(&reactor->mutex);
+			reactor_unlink(reactor, pc);
+			pthread_mutex_unlock(&reactor->mutex);
+
+			so = pc->client;
+			mg_free(pc);
+			DEBUG_TRACE("resuming socket %d", (int)so.sock);
+			produce_socket(ctx, &so);
+		}
+
+		/* Collect connections with an expired keep-alive timeout. */
+		now = reactor_getcurrenttime();
+		expired = NULL;
+		pthread_mutex_lock(&reactor->mutex);
+		for (pc = reactor->head; pc != NULL; pc = next) {
+			next = pc->next;
+			if (pc->deadline <= now) {
+				reactor_unlink(reactor, pc);
+				pc->next = expired;
+				expired = pc;
+				reactor->total_expired++;
+			}
+		}
+		pthread_mutex_unlock(&reactor->mutex);
+
+		/* Let a worker close them (outside of the lock, since
+		 * produce_socket may block if all workers are busy). */
+		while (expired != NULL) {
+			pc = expired;
+			expired = pc->next;
+			so = pc->client;
+			so.resumed = 2;
+			mg_free(pc);
+			produce_socket(ctx, &so);
+		}
+	}
+}
+
+
+static void *
+reactor_thread(void *thread_func_param)
+{
+	struct sigaction sa;
+
+	/* Ignore SIGPIPE */
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = SIG_IGN;
+	sigaction(SIGPIPE, &sa, NULL);
+
+	reactor_thread_run(thread_func_param);
+	return NULL;
+}
+
+
+static int
+reactor_init(struct mg_context *ctx)
+{
+	const char *max_idle = ctx->dd.config[MAX_IDLE_CONNECTIONS];
+	long parked_max = (max_idle ? strtol(max_idle, NULL, 10) : 0);
+	struct epoll_event ev;
+
+	ctx->reactor = NULL;
+
+	if ((parked_max <= 0)
+	    || mg_strcasecmp(ctx->dd.config[ENABLE_KEEP_ALIVE], "yes")) {
+		/* Reactor not required */
+		return 0;
+	}
+
+	ctx->reactor =
+	    (struct mg_reactor *)mg_calloc_ctx(sizeof(struct mg_reactor), 1, ctx);
+	if (!ctx->reactor) {
+		return -1;
+	}
+	ctx->reactor->parked_max =
+	    (parked_max > INT_MAX) ? (unsigned)INT_MAX : (unsigned)parked_max;
+
+	ctx->reactor->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (ctx->reactor->epoll_fd < 0) {
+		mg_free(ctx->reactor);
+		ctx->reactor = NULL;
+		return -1;
+	}
+
+	memset(&ev, 0, sizeof(ev));
+	ev.events = EPOLLIN;
+	ev.data.ptr = NULL;
+	ctx->reactor->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if ((ctx->reactor->wake_fd < 0)
+	    || (0
+	        != epoll_ctl(ctx->reactor->epoll_fd,
+	                     EPOLL_CTL_ADD,
+	                     ctx->reactor->wake_fd,
+	                     &ev))) {
+		if (ctx->reactor->wake_fd >= 0) {
+			close(ctx->reactor->wake_fd);
+		}
+		close(ctx->reactor->epoll_fd);
+		mg_free(ctx->reactor);
+		ctx->reactor = NULL;
+		return -1;
+	}
+
+	if (0 != pthread_mutex_init(&ctx->reactor->mutex, NULL)) {
+		close(ctx->reactor->wake_fd);
+		close(ctx->reactor->epoll_fd);
+		mg_free(ctx->reactor);
+		ctx->reactor = NULL;
+		return -1;
+	}
+
+	if (mg_start_thread_with_id(reactor_thread, ctx, &ctx->reactor->threadid)
+	    != 0) {
+		(void)pthread_mutex_destroy(&ctx->reactor->mutex);
+		close(ctx->reactor->wake_fd);
+		close(ctx->reactor->epoll_fd);
+		mg_free(ctx->reactor);
+		ctx->reactor = NULL;
+		return -1;
+	}
+
+	return 0;
+}
+
+
+/* Must be called after all worker threads have been joined. */
+static void
+reactor_exit(struct mg_context *ctx)
+{
+	struct mg_parked_conn *pc;
+
+	if (ctx->reactor) {
+		/* If a later step of mg_start failed, nobody told the threads to
+		 * stop yet. Don't let the reactor sleep out its poll interval
+		 * either. */
+		if (ctx->stop_flag == 0) {
+			ctx->stop_flag = 1;
+		}
+		(void)eventfd_write(ctx->reactor->wake_fd, 1);
+		mg_join_thread(ctx->reactor->threadid);
+
+		/* Close all connections that are still parked. There is no
+		 * worker left, so the connection_close callback is not called
+		 * for them. */
+		while ((pc = ctx->reactor->head) != NULL) {
+			reactor_unlink(ctx->reactor, pc);
+			closesocket(pc->client.sock);
+			mg_free(pc);
+		}
+
+		(void)pthread_mutex_destroy(&ctx->reactor->mutex);
+		close(ctx->reactor->wake_fd);
+		close(ctx->reactor->epoll_fd);
+		mg_free(ctx->reactor);
+		ctx->reactor = NULL;
+	}
+}
+
+
+/* End of reactor.inl */
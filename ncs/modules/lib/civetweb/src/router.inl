@@ -0,0 +1,419 @@
+/* This file is part of the CivetWeb web server.
+ * See https://github.com/civetweb/civetweb/
+ * (C) 2020 by the CivetWeb authors, MIT license.
+ */
+
+/* Compiled request handler routing table.
+ *
+ * The list of handlers (dom_ctx->handlers) is compiled into a radix tree,
+ * keyed by the lower case URI of every handler, whenever a handler is
+ * added, replaced or removed. A lookup walks the tree along the request
+ * URI once, and finds the same handler as the three passes over the list
+ * in previous versions (exact match, match of "uri/...", match_prefix()
+ * pattern match; in list order within each pass).
+ *
+ * Lookups do not take the context lock: the router is immutable, and a
+ * new router replaces the old one in an RCU-like way. Readers announce
+ * themselves in one of two reader counters (selected by the epoch), the
+ * writer publishes the new router, switches the epoch and waits until
+ * there are no more readers in the old counter before the old router and
+ * old handlers are freed. Writers are serialized by the context lock.
+ */
+
+
+struct mg_router_entry {
+	struct mg_handler_info *info; /* Handler, immutable while in a router */
+	unsigned order;               /* Position in the list of handlers */
+	int is_pattern;               /* URI contains a '?', '*', '$' or '|' */
+};
+
+
+struct mg_router_node {
+	char *label;      /* Lower case key fragment from the parent */
+	size_t label_len; /* Length of label */
+	struct mg_router_node **children; /* Sorted by the first label char */
+	unsigned child_count;
+	struct mg_router_entry *entries; /* Handlers with the key of this node */
+	unsigned entry_count;
+};
+
+
+struct mg_router {
+	struct mg_router_node root;      /* Node for the empty key */
+	struct mg_router_entry *patterns; /* Pattern handlers in list order */
+	unsigned pattern_count;
+};
+
+
+static void
+router_free_node(struct mg_router_node *node)
+{
+	unsigned i;
+
+	for (i = 0; i < node->child_count; i++) {
+		router_free_node(node->children[i]);
+		mg_free(node->children[i]);
+	}
+	mg_free(node->children);
+	mg_free(node->entries);
+	mg_free(node->label);
+}
+
+
+static void
+router_free(struct mg_router *router)
+{
+	if (router) {
+		router_free_node(&router->root);
+		mg_free(router->patterns);
+		mg_free(router);
+	}
+}
+
+
+static int
+router_append_entry(struct mg_router_entry **entries,
+                    unsigned *count,
+                    const struct mg_router_entry *entry,
+                    struct mg_context *ctx)
+{
+	struct mg_router_entry *tmp;
+
+	(void)ctx; /* only used with MEMORY_DEBUGGING */
+
+	tmp = (struct mg_router_entry *)mg_realloc_ctx(
+	    *entries, (*count + 1) * sizeof(tmp[0]), ctx);
+	if (tmp == NULL) {
+		return 0;
+	}
+	tmp[*count] = *entry;
+	(*count)++;
+	*entries = tmp;
+	return 1;
+}
+
+
+/* Index of the child starting with c, or of the position where it must
+ * be inserted. */
+static unsigned
+router_child_index(const struct mg_router_node *node, unsigned char c)
+{
+	unsigned lo = 0, hi = node->child_count;
+
+	while (lo < hi) {
+		unsigned mid = (lo + hi) / 2;
+		if ((unsigned char)node->children[mid]->label[0] < c) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+
+static struct mg_router_node *
+router_new_node(const char *label, size_t label_len, struct mg_context *ctx)
+{
+	struct mg_router_node *node;
+
+	(void)ctx; /* only used with MEMORY_DEBUGGING */
+
+	node = (struct mg_router_node *)mg_calloc_ctx(1,
+	                                              sizeof(struct mg_router_node),
+	                                              ctx);
+	if (node == NULL) {
+		return NULL;
+	}
+	node->label = (char *)mg_malloc_ctx(label_len + 1, ctx);
+	if (node->label == NULL) {
+		mg_free(node);
+		return NULL;
+	}
+	memcpy(node->label, label, label_len);
+	node->label[label_len] = 0;
+	node->label_len = label_len;
+	return node;
+}
+
+
+static int
+router_insert_child(struct mg_router_node *node,
+                    unsigned idx,
+                    struct mg_router_node *child,
+                    struct mg_context *ctx)
+{
+	struct mg_router_node **tmp;
+
+	(void)ctx; /* only used with MEMORY_DEBUGGING */
+
+	tmp = (struct mg_router_node **)mg_realloc_ctx(
+	    node->children, (node->child_count + 1) * sizeof(tmp[0]), ctx);
+	if (tmp == NULL) {
+		return 0;
+	}
+	memmove(tmp + idx + 1,
+	        tmp + idx,
+	        (node->child_count - idx) * sizeof(tmp[0]));
+	tmp[idx] = child;
+	node->children = tmp;
+	node->child_count++;
+	return 1;
+}
+
+
+/* Insert entry with the lower case key. Returns 0 if out of memory. */
+static int
+router_insert(struct mg_router_node *node,
+              const char *key,
+              size_t len,
+              const struct mg_router_entry *entry,
+              struct mg_context *ctx)
+{
+	struct mg_router_node *child, *mid;
+	unsigned idx;
+	size_t common;
+
+	while (len > 0) {
+		idx = router_child_index(node, (unsigned char)key[0]);
+		if ((idx == node->child_count)
+		    || (node->children[idx]->label[0] != key[0])) {
+			/* New leaf */
+			child = router_new_node(key, len, ctx);
+			if (child == NULL) {
+				return 0;
+			}
+			if (!router_insert_child(node, idx, child, ctx)) {
+				router_free_node(child);
+				mg_free(child);
+				return 0;
+			}
+			node = child;
+			break;
+		}
+
+		child = node->children[idx];
+		for (common = 1; (common < len) && (common < child->label_len)
+		                 && (child->label[common] == key[common]);
+		     common++) {
+		}
+
+		if (common < child->label_len) {
+			/* Split the edge: node -> mid -> child */
+			mid = router_new_node(key, common, ctx);
+			if (mid == NULL) {
+				return 0;
+			}
+			mid->children = (struct mg_router_node **)mg_malloc_ctx(
+			    sizeof(mid->children[0]), ctx);
+			if (mid->children == NULL) {
+				router_free_node(mid);
+				mg_free(mid);
+				return 0;
+			}
+			memmove(child->label,
+			        child->label + common,
+			        child->label_len - common + 1);
+			child->label_len -= common;
+			mid->children[0] = child;
+			mid->child_count = 1;
+			node->children[idx] = mid;
+			child = mid;
+		}
+
+		node = child;
+		key += common;
+		len -= common;
+	}
+
+	return router_append_entry(&node->entries, &node->entry_count, entry, ctx);
+}
+
+
+static struct mg_router *
+router_build(struct mg_context *ctx, const struct mg_handler_info *handlers)
+{
+	struct mg_router *router;
+	const struct mg_handler_info *rh;
+	struct mg_router_entry entry;
+	char *key;
+	size_t i;
+	unsigned order = 0;
+
+	router = (struct mg_router *)mg_calloc_ctx(1, sizeof(*router), ctx);
+	if (router == NULL) {
+		return NULL;
+	}
+
+	for (rh = handlers; rh != NULL; rh = rh->next) {
+		entry.info = (struct mg_handler_info *)rh;
+		entry.order = order++;
+		entry.is_pattern = (strpbrk(rh->uri, "?*$|") != NULL);
+
+		key = (char *)mg_malloc_ctx(rh->uri_len + 1, ctx);
+		if (key == NULL) {
+			router_free(router);
+			return NULL;
+		}
+		for (i = 0; i < rh->uri_len; i++) {
+			key[i] = (char)lowercase(rh->uri + i);
+		}
+		key[rh->uri_len] = 0;
+
+		if (!router_insert(&router->root, key, rh->uri_len, &entry, ctx)
+		    || (entry.is_pattern
+		        && !router_append_entry(&router->patterns,
+		                                &router->pattern_count,
+		                                &entry,
+		                                ctx))) {
+			mg_free(key);
+			router_free(router);
+			return NULL;
+		}
+		mg_free(key);
+	}
+
+	return router;
+}
+
+
+static struct mg_handler_info *
+router_lookup(const struct mg_router *router,
+              int handler_type,
+              const char *uri,
+              size_t urilen)
+{
+	const struct mg_router_node *node = &router->root;
+	const struct mg_router_node *child;
+	const struct mg_router_entry *e, *partial = NULL, *prefix = NULL;
+	size_t depth = 0, k;
+	unsigned i;
+
+	for (;;) {
+		for (i = 0; i < node->entry_count; i++) {
+			e = &node->entries[i];
+			if (e->info->handler_type != handler_type) {
+				continue;
+			}
+			if (depth == urilen) {
+				/* There is only one handler per type and URI */
+				if (!memcmp(e->info->uri, uri, urilen)) {
+					return e->info;
+				}
+			} else if ((uri[depth] == '/')
+			           && !memcmp(e->info->uri, uri, depth)) {
+				/* Partial match: uri/something */
+				if ((partial == NULL) || (e->order < partial->order)) {
+					partial = e;
+				}
+			}
+			/* Case insensitive prefix, as match_prefix() would find */
+			if (!e->is_pattern && (depth > 0)
+			    && ((prefix == NULL) || (e->order < prefix->order))) {
+				prefix = e;
+			}
+		}
+
+		if (depth == urilen) {
+			break;
+		}
+		i = router_child_index(node, (unsigned char)lowercase(uri + depth));
+		if (i == node->child_count) {
+			break;
+		}
+		child = node->children[i];
+		if (child->label_len > urilen - depth) {
+			break;
+		}
+		for (k = 0; k < child->label_len; k++) {
+			if (child->label[k] != (char)lowercase(uri + depth + k)) {
+				break;
+			}
+		}
+		if (k < child->label_len) {
+			break;
+		}
+		depth += k;
+		node = child;
+	}
+
+	if (partial) {
+		return partial->info;
+	}
+
+	/* Patterns registered before the best prefix match take precedence */
+	for (i = 0; i < router->pattern_count; i++) {
+		e = &router->patterns[i];
+		if (prefix && (e->order > prefix->order)) {
+			break;
+		}
+		if ((e->info->handler_type == handler_type)
+		    && (match_prefix(e->info->uri, e->info->uri_len, uri) > 0)) {
+			return e->info;
+		}
+	}
+
+	return prefix ? prefix->info : NULL;
+}
+
+
+/* Enter a read side section. Returns the reader slot for
+ * router_read_unlock. */
+static int
+router_read_lock(struct mg_domain_context *dom_ctx)
+{
+	int epoch;
+
+	for (;;) {
+		epoch = dom_ctx->router_epoch;
+		mg_atomic_inc(&dom_ctx->router_readers[epoch & 1]);
+		if (dom_ctx->router_epoch == epoch) {
+			return epoch & 1;
+		}
+		/* A writer switched the epoch in the meantime */
+		mg_atomic_dec(&dom_ctx->router_readers[epoch & 1]);
+	}
+}
+
+
+static void
+router_read_unlock(struct mg_domain_context *dom_ctx, int slot)
+{
+	mg_atomic_dec(&dom_ctx->router_readers[slot]);
+}
+
+
+/* Compile the handler list and replace the router. Must be called with
+ * the context lock held. When this function returns, no reader uses the
+ * previous router or a handler that is no longer in the list. */
+static void
+router_update(struct mg_context *phys_ctx, struct mg_domain_context *dom_ctx)
+{
+	struct mg_router *old_router = dom_ctx->router;
+	struct mg_router *new_router = NULL;
+	int old_slot;
+
+	if (dom_ctx->handlers != NULL) {
+		new_router = router_build(phys_ctx, dom_ctx->handlers);
+		if (new_router == NULL) {
+			/* get_request_handler falls back to the list */
+			mg_cry_ctx_internal(phys_ctx,
+			                    "%s",
+			                    "Cannot build request handler router, OOM");
+		}
+	}
+
+	/* Publish the new router, then wait for readers of the old one */
+	mg_memory_barrier();
+	dom_ctx->router = new_router;
+	old_slot = dom_ctx->router_epoch & 1;
+	mg_atomic_inc(&dom_ctx->router_epoch);
+	while (dom_ctx->router_readers[old_slot] != 0) {
+		mg_sleep(1);
+	}
+
+	router_free(old_router);
+}
+
+
+/* End of router.inl */
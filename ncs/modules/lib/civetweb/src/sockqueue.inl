@@ -0,0 +1,261 @@
+/* This file is part of the CivetWeb web server.
+ * See https://github.com/civetweb/civetweb/
+ * (C) 2020 by the CivetWeb authors, MIT license.
+ */
+
+/* Lock-free queue of accepted sockets (USE_LOCKFREE_QUEUE).
+ *
+ * Bounded multi-producer/multi-consumer ring buffer (D. Vyukov's algorithm):
+ * every cell holds a sequence number, producers and consumers reserve a cell
+ * by a compare-and-swap of the enqueue/dequeue position, and the sequence
+ * number tells whether the cell is free or filled. No mutex is held while a
+ * socket is queued or dequeued.
+ *
+ * Idle workers sleep on their own event (client_wait_events, see the
+ * alternative queue). A worker marks itself idle before it checks the queue
+ * a last time, and a producer clears the mark of one idle worker before it
+ * signals its event, so no wakeup can be lost. Spurious wakeups are possible
+ * and handled by the consumer loop.
+ */
+
+#if !defined(MG_SOCKQUEUE_MIN_SIZE)
+#define MG_SOCKQUEUE_MIN_SIZE (64)
+#endif
+
+/* Keep the producer and consumer positions in different cache lines. */
+#if !defined(MG_CACHE_LINE_SIZE)
+#define MG_CACHE_LINE_SIZE (64)
+#endif
+
+
+struct mg_sockqueue_cell {
+	volatile int seq;
+	struct socket sock;
+};
+
+
+struct mg_sockqueue {
+	volatile int enqueue_pos;
+	char pad1[MG_CACHE_LINE_SIZE - sizeof(int)];
+	volatile int dequeue_pos;
+	char pad2[MG_CACHE_LINE_SIZE - sizeof(int)];
+	unsigned mask;                  /* Number of cells - 1 (power of 2) */
+	struct mg_sockqueue_cell *cells; /* Ring buffer */
+	volatile int *idle;              /* Per worker: 1 while waiting */
+	volatile int wake_hint;          /* Worker to try first for wakeup */
+};
+
+
+/* Positions and sequence numbers are compared as differences, so they may
+ * wrap around. */
+static int
+sockqueue_diff(int a, int b)
+{
+	return (int)((unsigned)a - (unsigned)b);
+}
+
+
+static int
+sockqueue_add(int a, unsigned b)
+{
+	return (int)((unsigned)a + b);
+}
+
+
+/* Returns 1 if the socket has been queued and 0 if the queue is full. */
+static int
+sockqueue_push(struct mg_sockqueue *q, const struct socket *sp)
+{
+	struct mg_sockqueue_cell *cell;
+	int pos = q->enqueue_pos;
+	int dif;
+
+	for (;;) {
+		cell = &q->cells[(unsigned)pos & q->mask];
+		dif = sockqueue_diff(cell->seq, pos);
+		mg_memory_barrier();
+		if (dif == 0) {
+			if (mg_atomic_cas(&q->enqueue_pos, pos, sockqueue_add(pos, 1))) {
+				break;
+			}
+		} else if (dif < 0) {
+			/* The cell still holds a socket from the previous round */
+			return 0;
+		}
+		pos = q->enqueue_pos;
+	}
+
+	cell->sock = *sp;
+	mg_memory_barrier();
+	cell->seq = sockqueue_add(pos, 1);
+	return 1;
+}
+
+
+/* Returns 1 if a socket has been dequeued and 0 if the queue is empty. */
+static int
+sockqueue_pop(struct mg_sockqueue *q, struct socket *sp)
+{
+	struct mg_sockqueue_cell *cell;
+	int pos = q->dequeue_pos;
+	int dif;
+
+	for (;;) {
+		cell = &q->cells[(unsigned)pos & q->mask];
+		dif = sockqueue_diff(cell->seq, sockqueue_add(pos, 1));
+		mg_memory_barrier();
+		if (dif == 0) {
+			if (mg_atomic_cas(&q->dequeue_pos, pos, sockqueue_add(pos, 1))) {
+				break;
+			}
+		} else if (dif < 0) {
+			/* The cell has not been filled yet */
+			return 0;
+		}
+		pos = q->dequeue_pos;
+	}
+
+	*sp = cell->sock;
+	mg_memory_barrier();
+	cell->seq = sockqueue_add(pos, q->mask + 1);
+	return 1;
+}
+
+
+/* Wake up one idle worker, if there is any. Busy workers will check the
+ * queue before they go idle. */
+static void
+sockqueue_wake_one(struct mg_context *ctx)
+{
+	struct mg_sockqueue *q = ctx->sockqueue;
+	unsigned n = ctx->cfg_worker_threads;
+	unsigned start = (unsigned)q->wake_hint;
+	unsigned i, w;
+
+	/* Order the queued socket before reading the idle flags. */
+	mg_memory_barrier();
+
+	for (i = 0; i < n; i++) {
+		w = (start + i) % n;
+		if (q->idle[w] && mg_atomic_cas(&q->idle[w], 1, 0)) {
+			q->wake_hint = (int)((w + 1) % n);
+			(void)event_signal(ctx->client_wait_events[w]);
+			return;
+		}
+	}
+}
+
+
+static void
+produce_socket(struct mg_context *ctx, const struct socket *sp)
+{
+	while (!ctx->stop_flag) {
+		if (sockqueue_push(ctx->sockqueue, sp)) {
+			DEBUG_TRACE("queued socket %d", sp->sock);
+			sockqueue_wake_one(ctx);
+			return;
+		}
+		/* queue is full */
+		mg_sleep(1);
+	}
+	/* must consume */
+	set_blocking_mode(sp->sock);
+	closesocket(sp->sock);
+}
+
+
+static int
+consume_socket(struct mg_context *ctx, struct socket *sp, int thread_index)
+{
+	struct mg_sockqueue *q = ctx->sockqueue;
+
+	while (!ctx->stop_flag) {
+		if (sockqueue_pop(q, sp)) {
+			DEBUG_TRACE("grabbed socket %d, going busy", sp->sock);
+			return 1;
+		}
+
+		/* Announce that this worker is going to sleep, then check the
+		 * queue again: a producer that queued a socket in the meantime
+		 * either sees the idle flag, or the socket is seen here. */
+		DEBUG_TRACE("%s", "going idle");
+		(void)mg_atomic_cas(&q->idle[thread_index], 0, 1);
+		if (sockqueue_pop(q, sp)) {
+			/* If a producer already cleared the flag, the event has been
+			 * signaled and the next wait returns immediately. */
+			(void)mg_atomic_cas(&q->idle[thread_index], 1, 0);
+			DEBUG_TRACE("grabbed socket %d, going busy", sp->sock);
+			return 1;
+		}
+
+		event_wait(ctx->client_wait_events[thread_index]);
+	}
+	return 0;
+}
+
+
+static int
+sockqueue_init(struct mg_context *ctx)
+{
+	struct mg_sockqueue *q;
+	unsigned size = MG_SOCKQUEUE_MIN_SIZE;
+	unsigned i;
+
+	/* At least MGSQLEN and one entry per worker, rounded up to a power
+	 * of 2. */
+	while ((size < MGSQLEN) || (size < ctx->cfg_worker_threads)) {
+		size *= 2;
+	}
+
+	q = (struct mg_sockqueue *)mg_calloc_ctx(1, sizeof(*q), ctx);
+	if (q == NULL) {
+		return -1;
+	}
+	q->cells = (struct mg_sockqueue_cell *)mg_calloc_ctx(size,
+	                                                     sizeof(q->cells[0]),
+	                                                     ctx);
+	q->idle = (volatile int *)mg_calloc_ctx(ctx->cfg_worker_threads,
+	                                        sizeof(q->idle[0]),
+	                                        ctx);
+	if ((q->cells == NULL) || (q->idle == NULL)) {
+		mg_free(q->cells);
+		mg_free((void *)q->idle);
+		mg_free(q);
+		return -1;
+	}
+
+	q->mask = size - 1;
+	for (i = 0; i < size; i++) {
+		q->cells[i].seq = (int)i;
+	}
+
+	ctx->sockqueue = q;
+	return 0;
+}
+
+
+/* Must be called after all producers and consumers have been stopped. */
+static void
+sockqueue_exit(struct mg_context *ctx)
+{
+	struct mg_sockqueue *q = ctx->sockqueue;
+	struct socket so;
+
+	if (q == NULL) {
+		return;
+	}
+
+	/* Close sockets that have been queued, but not consumed. */
+	while (sockqueue_pop(q, &so)) {
+		set_blocking_mode(so.sock);
+		closesocket(so.sock);
+	}
+
+	mg_free(q->cells);
+	mg_free((void *)q->idle);
+	mg_free(q);
+	ctx->sockqueue = NULL;
+}
+
+
+/* End of sockqueue.inl */
@@ -0,0 +1,676 @@
+/* This file is part of the CivetWeb web server.
+ * See https://github.com/civetweb/civetweb/
+ * (C) 2020 by the CivetWeb authors, MIT license.
+ */
+
+/* Websocket broadcast groups.
+ *
+ * mg_websocket_broadcast() encodes a frame once into a reference counted
+ * buffer and appends it to the outbound queue of every connection in the
+ * group. A writer thread per group sends the queued frames. Sockets of
+ * server connections are in non-blocking mode: a client that does not
+ * read its data just keeps its frames queued, while the writer continues
+ * with the other connections.
+ *
+ * While the writer has sent only a part of a frame, it keeps the lock of
+ * the connection (mg_lock_connection), so mg_websocket_write() calls of
+ * other threads cannot interleave. If another thread holds the lock, the
+ * writer tries again later instead of waiting. A connection that does not
+ * accept any data of a started frame within the websocket (or request)
+ * timeout is closed. TLS connections are written with SSL_write() on the
+ * non-blocking socket as well; a write that would block must be repeated
+ * with the same frame, so the connection lock is kept until it completes.
+ *
+ * The queue of every connection is limited in frames and bytes. If a new
+ * frame does not fit, the oldest frames that have not been started yet
+ * are dropped: slow clients get the most recent data, with gaps.
+ *
+ * Every frame is a complete message, so TCP_NODELAY is set for connections
+ * joining a group: otherwise the frames of the writer are held back until
+ * the client acknowledges the previous one.
+ *
+ * Connections must be joined from the ready handler or later. They leave
+ * all groups automatically when the websocket connection is closed. A group
+ * is looked up under the context lock, but left without holding it, so a
+ * slow writer of one group does not block the context for others. The
+ * memory of a group destroyed meanwhile is freed by the last of them.
+ */
+
+#if !defined(MG_WS_GROUP_RETRY_MS)
+/* Interval for connections that cannot be written at the moment */
+#define MG_WS_GROUP_RETRY_MS (10)
+#endif
+
+
+struct mg_ws_frame {
+	int refcount;        /* Protected by the group mutex */
+	size_t len;          /* Header and payload */
+	unsigned char *data; /* Follows the struct */
+};
+
+
+struct mg_ws_subscriber {
+	struct mg_connection *conn;
+	struct mg_ws_frame **queue; /* Ring buffer, max_frames entries */
+	unsigned head;
+	unsigned count;
+	size_t queued_bytes;
+	size_t offset;   /* Bytes of queue[head] that have been sent */
+	double stalled;  /* Time of the last progress of a started frame */
+	int conn_locked; /* The writer holds the connection lock */
+	int tls_retry;   /* SSL_write of queue[head] must be repeated */
+	int failed;      /* Write error: do not queue any more frames */
+	int leaving;     /* To be removed by the writer thread */
+	struct mg_ws_subscriber *next;
+};
+
+
+struct mg_websocket_group {
+	struct mg_context *ctx;
+	pthread_mutex_t mutex; /* Protects all members below */
+	pthread_cond_t cond;   /* Work for the writer, subscriber removed */
+	struct mg_ws_subscriber *subscribers;
+	unsigned max_frames;
+	size_t max_bytes;
+	double timeout; /* Seconds, see read_websocket */
+	int stop;
+	pthread_t writer;
+	struct mg_websocket_group *next; /* List in ctx, see ctx->nonce_mutex */
+	int users;     /* ws_groups_leave_all calls, protected by the ... */
+	int destroyed; /* ... context lock: free when users drops to 0 */
+};
+
+
+/* A frame has been started: it must be completed before other data is
+ * written to the connection. */
+#define ws_subscriber_started(sub) (((sub)->offset > 0) || (sub)->tls_retry)
+
+
+/* Must be called with the group mutex locked. */
+static void
+ws_frame_unref(struct mg_ws_frame *frame)
+{
+	if (--frame->refcount == 0) {
+		mg_free(frame);
+	}
+}
+
+
+/* Must be called with the group mutex locked. */
+static void
+ws_subscriber_pop(struct mg_websocket_group *group,
+                  struct mg_ws_subscriber *sub)
+{
+	struct mg_ws_frame *frame = sub->queue[sub->head];
+
+	sub->head = (sub->head + 1) % group->max_frames;
+	sub->count--;
+	sub->queued_bytes -= frame->len;
+	sub->offset = 0;
+	sub->tls_retry = 0;
+	ws_frame_unref(frame);
+}
+
+
+/* Must be called with the group mutex locked. Returns 1 if the frame has
+ * been queued. */
+static int
+ws_subscriber_push(struct mg_websocket_group *group,
+                   struct mg_ws_subscriber *sub,
+                   struct mg_ws_frame *frame)
+{
+	/* A frame that is being sent cannot be dropped */
+	unsigned keep = ws_subscriber_started(sub) ? 1 : 0;
+	struct mg_ws_frame *dropped;
+	unsigned pos;
+
+	while ((sub->count > keep)
+	       && ((sub->count >= group->max_frames)
+	           || (sub->queued_bytes + frame->len > group->max_bytes))) {
+		/* Drop the oldest frame that has not been started */
+		pos = (sub->head + keep) % group->max_frames;
+		dropped = sub->queue[pos];
+		if (keep) {
+			sub->queue[pos] = sub->queue[sub->head];
+		}
+		sub->head = (sub->head + 1) % group->max_frames;
+		sub->count--;
+		sub->queued_bytes -= dropped->len;
+		ws_frame_unref(dropped);
+	}
+	if (sub->count >= group->max_frames) {
+		/* Only the frame being sent is left, and max_frames is 1 */
+		return 0;
+	}
+
+	pos = (sub->head + sub->count) % group->max_frames;
+	sub->queue[pos] = frame;
+	sub->count++;
+	sub->queued_bytes += frame->len;
+	frame->refcount++;
+	return 1;
+}
+
+
+/* Must be called with the group mutex locked. Drops all frames except a
+ * partially sent one. */
+static void
+ws_subscriber_drop_queued(struct mg_websocket_group *group,
+                          struct mg_ws_subscriber *sub)
+{
+	unsigned keep = ws_subscriber_started(sub) ? 1 : 0;
+	struct mg_ws_frame *dropped;
+
+	while (sub->count > keep) {
+		sub->count--;
+		dropped = sub->queue[(sub->head + sub->count) % group->max_frames];
+		sub->queued_bytes -= dropped->len;
+		ws_frame_unref(dropped);
+	}
+}
+
+
+/* Must be called with the group mutex locked, by the writer thread. */
+static void
+ws_subscriber_free(struct mg_websocket_group *group,
+                   struct mg_ws_subscriber *sub)
+{
+	while (sub->count > 0) {
+		ws_subscriber_pop(group, sub);
+	}
+	if (sub->conn_locked) {
+		mg_unlock_connection(sub->conn);
+	}
+	mg_free(sub->queue);
+	mg_free(sub);
+}
+
+
+/* Must be called with the group mutex locked, by the writer thread.
+ * Returns 1 if data has been sent, 0 if the connection cannot be written
+ * at the moment. */
+static int
+ws_subscriber_send(struct mg_websocket_group *group,
+                   struct mg_ws_subscriber *sub)
+{
+	struct mg_connection *conn = sub->conn;
+	struct mg_ws_frame *frame;
+	int progress = 0;
+	int n, err;
+	double now;
+#if defined(_WIN32)
+	typedef int len_t;
+#else
+	typedef size_t len_t;
+#endif
+
+	if (!sub->conn_locked) {
+		if (pthread_mutex_trylock(&conn->mutex) != 0) {
+			/* Another thread writes to this connection */
+			return 0;
+		}
+		sub->conn_locked = 1;
+	}
+
+	while ((sub->count > 0) && !sub->failed) {
+		frame = sub->queue[sub->head];
+#if !defined(NO_SSL)
+		if (conn->ssl != NULL) {
+			/* Without partial writes, SSL_write sends all or nothing */
+			n = SSL_write(conn->ssl,
+			              frame->data + sub->offset,
+			              (int)(frame->len - sub->offset));
+			if (n <= 0) {
+				err = SSL_get_error(conn->ssl, n);
+				if ((err == SSL_ERROR_WANT_READ)
+				    || (err == SSL_ERROR_WANT_WRITE)) {
+					/* Socket buffer full: repeat with the same data */
+					sub->tls_retry = 1;
+					break;
+				}
+				sub->failed = 1;
+				break;
+			}
+		} else
+#endif
+		{
+			n = (int)send(conn->client.sock,
+			              (const char *)frame->data + sub->offset,
+			              (len_t)(frame->len - sub->offset),
+			              MSG_NOSIGNAL);
+		}
+		if (n > 0) {
+			conn->num_bytes_sent += n;
+			sub->offset += (size_t)n;
+			if (sub->offset == frame->len) {
+				ws_subscriber_pop(group, sub);
+			}
+			progress = 1;
+			continue;
+		}
+		err = (n < 0) ? ERRNO : 0;
+#if defined(_WIN32)
+		if ((n < 0) && (err == WSAEWOULDBLOCK)) {
+#else
+		if ((n < 0)
+		    && ((err == EAGAIN) || (err == EWOULDBLOCK) || (err == EINTR))) {
+#endif
+			/* Socket buffer full */
+			break;
+		}
+		/* Error or closed: the connection is closed by its worker */
+		sub->failed = 1;
+	}
+
+	if (ws_subscriber_started(sub) && !sub->failed) {
+		now = (double)mg_get_current_time_ns() / 1.0E9;
+		if (progress || (sub->stalled == 0.0)) {
+			sub->stalled = now;
+		} else if ((group->timeout > 0.0)
+		           && (now - sub->stalled > group->timeout)) {
+			/* The client does not read */
+			sub->failed = 1;
+		}
+	}
+
+	if (sub->failed) {
+		conn->must_close = 1;
+		while (sub->count > 0) {
+			ws_subscriber_pop(group, sub);
+		}
+	}
+
+	if (!ws_subscriber_started(sub)) {
+		/* Other threads may write again */
+		mg_unlock_connection(conn);
+		sub->conn_locked = 0;
+	}
+	return progress;
+}
+
+
+static void
+ws_group_writer_run(struct mg_websocket_group *group)
+{
+	struct mg_ws_subscriber *sub, **pp;
+	struct timespec abstime;
+	int progress, pending;
+
+	mg_set_thread_name("wsgroup");
+
+	pthread_mutex_lock(&group->mutex);
+	while (!group->stop) {
+		progress = 0;
+		pending = 0;
+		for (pp = &group->subscribers; (sub = *pp) != NULL;) {
+			if (sub->leaving) {
+				/* Complete a partially sent frame, the connection may stay
+				 * open after leaving the group */
+				ws_subscriber_drop_queued(group, sub);
+				if (ws_subscriber_started(sub) && !sub->failed) {
+					progress |= ws_subscriber_send(group, sub);
+				}
+				if (ws_subscriber_started(sub) && !sub->failed) {
+					pending = 1;
+					pp = &sub->next;
+					continue;
+				}
+				*pp = sub->next;
+				ws_subscriber_free(group, sub);
+				pthread_cond_broadcast(&group->cond);
+				continue;
+			}
+			if ((sub->count > 0) && !sub->failed) {
+				progress |= ws_subscriber_send(group, sub);
+				pending |= (sub->count > 0);
+			}
+			pp = &sub->next;
+		}
+
+		if (progress) {
+			continue;
+		}
+		if (pending) {
+			/* Only connections that cannot be written: try again later */
+			clock_gettime(CLOCK_REALTIME, &abstime);
+			abstime.tv_nsec += MG_WS_GROUP_RETRY_MS * 1000000L;
+			if (abstime.tv_nsec >= 1000000000L) {
+				abstime.tv_sec++;
+				abstime.tv_nsec -= 1000000000L;
+			}
+			pthread_cond_timedwait(&group->cond, &group->mutex, &abstime);
+		} else {
+			pthread_cond_wait(&group->cond, &group->mutex);
+		}
+	}
+
+	/* Connection locks must be released by this thread */
+	while ((sub = group->subscribers) != NULL) {
+		group->subscribers = sub->next;
+		ws_subscriber_free(group, sub);
+	}
+	pthread_mutex_unlock(&group->mutex);
+}
+
+
+#if defined(_WIN32)
+static unsigned __stdcall ws_group_writer(void *thread_func_param)
+{
+	ws_group_writer_run((struct mg_websocket_group *)thread_func_param);
+	return 0;
+}
+#else
+static void *
+ws_group_writer(void *thread_func_param)
+{
+#if !defined(__ZEPHYR__)
+	struct sigaction sa;
+
+	/* Ignore SIGPIPE */
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = SIG_IGN;
+	sigaction(SIGPIPE, &sa, NULL);
+#endif
+
+	ws_group_writer_run((struct mg_websocket_group *)thread_func_param);
+	return NULL;
+}
+#endif /* _WIN32 */
+
+
+struct mg_websocket_group *
+mg_websocket_group_create(struct mg_context *ctx,
+                          unsigned max_frames,
+                          size_t max_bytes)
+{
+	struct mg_websocket_group *group;
+
+	if ((ctx == NULL) || (ctx->context_type != CONTEXT_SERVER)) {
+		return NULL;
+	}
+	group = (struct mg_websocket_group *)
+	    mg_calloc_ctx(1, sizeof(struct mg_websocket_group), ctx);
+	if (group == NULL) {
+		return NULL;
+	}
+	group->ctx = ctx;
+	group->max_frames = (max_frames > 0) ? max_frames : 1;
+	group->max_bytes = max_bytes;
+	if (ctx->dd.config[WEBSOCKET_TIMEOUT]) {
+		group->timeout = atoi(ctx->dd.config[WEBSOCKET_TIMEOUT]) / 1000.0;
+	}
+	if ((group->timeout <= 0.0) && (ctx->dd.config[REQUEST_TIMEOUT])) {
+		group->timeout = atoi(ctx->dd.config[REQUEST_TIMEOUT]) / 1000.0;
+	}
+
+	if (0 != pthread_mutex_init(&group->mutex, NULL)) {
+		mg_free(group);
+		return NULL;
+	}
+	if (0 != pthread_cond_init(&group->cond, NULL)) {
+		pthread_mutex_destroy(&group->mutex);
+		mg_free(group);
+		return NULL;
+	}
+	if (mg_start_thread_with_id(ws_group_writer, group, &group->writer) != 0) {
+		pthread_cond_destroy(&group->cond);
+		pthread_mutex_destroy(&group->mutex);
+		mg_free(group);
+		return NULL;
+	}
+
+	mg_lock_context(ctx);
+	group->next = ctx->ws_groups;
+	ctx->ws_groups = group;
+	mg_unlock_context(ctx);
+
+	return group;
+}
+
+
+static void
+ws_group_stop(struct mg_websocket_group *group)
+{
+	pthread_mutex_lock(&group->mutex);
+	group->stop = 1;
+	pthread_cond_broadcast(&group->cond);
+	pthread_mutex_unlock(&group->mutex);
+
+	mg_join_thread(group->writer);
+}
+
+
+static void
+ws_group_free(struct mg_websocket_group *group)
+{
+	pthread_cond_destroy(&group->cond);
+	pthread_mutex_destroy(&group->mutex);
+	mg_free(group);
+}
+
+
+void
+mg_websocket_group_destroy(struct mg_websocket_group *group)
+{
+	struct mg_websocket_group **pp;
+	struct mg_context *ctx;
+	int unused;
+
+	if (group == NULL) {
+		return;
+	}
+	ctx = group->ctx;
+
+	mg_lock_context(ctx);
+	for (pp = &ctx->ws_groups; *pp != NULL; pp = &(*pp)->next) {
+		if (*pp == group) {
+			*pp = group->next;
+			break;
+		}
+	}
+	mg_unlock_context(ctx);
+
+	ws_group_stop(group);
+
+	mg_lock_context(ctx);
+	group->destroyed = 1;
+	unused = (group->users == 0);
+	mg_unlock_context(ctx);
+
+	if (unused) {
+		ws_group_free(group);
+	}
+}
+
+
+int
+mg_websocket_group_join(struct mg_websocket_group *group,
+                        struct mg_connection *conn)
+{
+	struct mg_ws_subscriber *sub;
+
+	if ((group == NULL) || (conn == NULL) || (conn->phys_ctx != group->ctx)) {
+		return -1;
+	}
+
+	sub = (struct mg_ws_subscriber *)
+	    mg_calloc_ctx(1, sizeof(struct mg_ws_subscriber), group->ctx);
+	if (sub == NULL) {
+		return -1;
+	}
+	sub->queue = (struct mg_ws_frame **)
+	    mg_calloc_ctx(group->max_frames, sizeof(sub->queue[0]), group->ctx);
+	if (sub->queue == NULL) {
+		mg_free(sub);
+		return -1;
+	}
+	sub->conn = conn;
+	(void)set_tcp_nodelay(conn->client.sock, 1);
+
+	pthread_mutex_lock(&group->mutex);
+	sub->next = group->subscribers;
+	group->subscribers = sub;
+	pthread_mutex_unlock(&group->mutex);
+
+	return 0;
+}
+
+
+int
+mg_websocket_group_leave(struct mg_websocket_group *group,
+                         struct mg_connection *conn)
+{
+	struct mg_ws_subscriber *sub;
+	int found = 0;
+
+	if ((group == NULL) || (conn == NULL)) {
+		return -1;
+	}
+
+	pthread_mutex_lock(&group->mutex);
+	for (sub = group->subscribers; sub != NULL; sub = sub->next) {
+		if ((sub->conn == conn) && !sub->leaving) {
+			sub->leaving = 1;
+			found = 1;
+		}
+	}
+	if (found) {
+		/* Wait until the writer thread removed it */
+		pthread_cond_broadcast(&group->cond);
+		for (;;) {
+			for (sub = group->subscribers; sub != NULL; sub = sub->next) {
+				if (sub->conn == conn) {
+					break;
+				}
+			}
+			if ((sub == NULL) || group->stop) {
+				break;
+			}
+			pthread_cond_wait(&group->cond, &group->mutex);
+		}
+	}
+	pthread_mutex_unlock(&group->mutex);
+
+	return found ? 0 : -1;
+}
+
+
+int
+mg_websocket_broadcast(struct mg_websocket_group *group,
+                       int opcode,
+                       const char *data,
+                       size_t data_len)
+{
+	struct mg_ws_frame *frame;
+	struct mg_ws_subscriber *sub;
+	unsigned char header[14];
+	size_t header_len;
+	int queued = 0;
+
+	if ((group == NULL) || ((data == NULL) && (data_len > 0))) {
+		return -1;
+	}
+
+	/* Encode the frame once for all connections */
+	header_len = websocket_frame_header(header, opcode, data_len);
+	frame = (struct mg_ws_frame *)mg_malloc_ctx(sizeof(struct mg_ws_frame)
+	                                                + header_len + data_len,
+	                                            group->ctx);
+	if (frame == NULL) {
+		return -1;
+	}
+	frame->refcount = 1; /* for this function */
+	frame->len = header_len + data_len;
+	frame->data = (unsigned char *)(frame + 1);
+	memcpy(frame->data, header, header_len);
+	if (data_len > 0) {
+		memcpy(frame->data + header_len, data, data_len);
+	}
+
+	pthread_mutex_lock(&group->mutex);
+	for (sub = group->subscribers; sub != NULL; sub = sub->next) {
+		if (!sub->failed && !sub->leaving) {
+			queued += ws_subscriber_push(group, sub, frame);
+		}
+	}
+	if (queued > 0) {
+		pthread_cond_broadcast(&group->cond);
+	}
+	ws_frame_unref(frame);
+	pthread_mutex_unlock(&group->mutex);
+
+	return queued;
+}
+
+
+/* Must be called with the context locked. Returns 1 if conn is a member
+ * of the group. */
+static int
+ws_group_is_member(struct mg_websocket_group *group,
+                   struct mg_connection *conn)
+{
+	struct mg_ws_subscriber *sub;
+
+	pthread_mutex_lock(&group->mutex);
+	for (sub = group->subscribers; sub != NULL; sub = sub->next) {
+		if ((sub->conn == conn) && !sub->leaving) {
+			break;
+		}
+	}
+	pthread_mutex_unlock(&group->mutex);
+	return (sub != NULL);
+}
+
+
+/* The websocket connection conn is closed: leave all groups. */
+static void
+ws_groups_leave_all(struct mg_connection *conn)
+{
+	struct mg_context *ctx = conn->phys_ctx;
+	struct mg_websocket_group *group;
+	int unused;
+
+	for (;;) {
+		/* Find a group with conn, and keep it from being freed */
+		mg_lock_context(ctx);
+		for (group = ctx->ws_groups; group != NULL; group = group->next) {
+			if (ws_group_is_member(group, conn)) {
+				group->users++;
+				break;
+			}
+		}
+		mg_unlock_context(ctx);
+
+		if (group == NULL) {
+			break;
+		}
+
+		/* Wait for the writer without holding the context lock */
+		(void)mg_websocket_group_leave(group, conn);
+
+		mg_lock_context(ctx);
+		unused = ((--group->users == 0) && group->destroyed);
+		mg_unlock_context(ctx);
+
+		if (unused) {
+			ws_group_free(group);
+		}
+	}
+}
+
+
+/* Must be called after all worker threads have been joined. */
+static void
+ws_groups_exit(struct mg_context *ctx)
+{
+	struct mg_websocket_group *group;
+
+	while ((group = ctx->ws_groups) != NULL) {
+		ctx->ws_groups = group->next;
+		ws_group_stop(group);
+		ws_group_free(group);
+	}
+}
+
+
+/* End of ws_broadcast.inl */
@@ -0,0 +1,181 @@
+/* Copyright (c) 2020 the Civetweb developers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for clock_gettime() */
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "bench.h"
+
+
+volatile int bench_stop = 0;
+
+
+double
+bench_now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1.0E9;
+}
+
+
+int
+bench_connect(int port)
+{
+	struct sockaddr_in sa;
+	int on = 1;
+	int sock = socket(AF_INET, SOCK_STREAM, 0);
+
+	if (sock < 0) {
+		return -1;
+	}
+	memset(&sa, 0, sizeof(sa));
+	sa.sin_family = AF_INET;
+	sa.sin_port = htons((uint16_t)port);
+	sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (connect(sock, (struct sockaddr *)&sa, sizeof(sa)) != 0) {
+		close(sock);
+		return -1;
+	}
+	(void)setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+	return sock;
+}
+
+
+int
+bench_connect_websocket(int port, const char *uri)
+{
+	char buf[1024];
+	int n, len = 0;
+	int sock = bench_connect(port);
+
+	if (sock < 0) {
+		return -1;
+	}
+	n = sprintf(buf,
+	            "GET %s HTTP/1.1\r\n"
+	            "Host: localhost\r\n"
+	            "Upgrade: websocket\r\n"
+	            "Connection: Upgrade\r\n"
+	            "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+	            "Sec-WebSocket-Version: 13\r\n\r\n",
+	            uri);
+	if (bench_send_all(sock, buf, (size_t)n) != 0) {
+		close(sock);
+		return -1;
+	}
+	/* Read the response header byte by byte, frames may follow */
+	buf[0] = 0;
+	while ((len < 4) || memcmp(buf + len - 4, "\r\n\r\n", 4)) {
+		if ((len >= (int)sizeof(buf) - 1)
+		    || (recv(sock, buf + len, 1, 0) != 1)) {
+			close(sock);
+			return -1;
+		}
+		len++;
+	}
+	buf[len] = 0;
+	if (strncmp(buf, "HTTP/1.1 101", 12)) {
+		close(sock);
+		return -1;
+	}
+	return sock;
+}
+
+
+int
+bench_send_all(int sock, const void *data, size_t len)
+{
+	const char *p = (const char *)data;
+	ssize_t n;
+
+	while (len > 0) {
+		n = send(sock, p, len, 0);
+		if (n <= 0) {
+			return -1;
+		}
+		p += n;
+		len -= (size_t)n;
+	}
+	return 0;
+}
+
+
+int
+bench_recv_all(int sock, void *data, size_t len)
+{
+	char *p = (char *)data;
+	ssize_t n;
+
+	while (len > 0) {
+		n = recv(sock, p, len, 0);
+		if (n <= 0) {
+			return -1;
+		}
+		p += n;
+		len -= (size_t)n;
+	}
+	return 0;
+}
+
+
+double
+bench_run_clients(void *clients,
+                  size_t size,
+                  int count,
+                  void *(*fn)(void *),
+                  int seconds,
+                  struct bench_client *total)
+{
+	struct bench_client *c;
+	double t0;
+	int i;
+
+	memset(total, 0, sizeof(*total));
+	bench_stop = 0;
+	t0 = bench_now();
+	for (i = 0; i < count; i++) {
+		c = (struct bench_client *)((char *)clients + (size_t)i * size);
+		c->seed = (unsigned)i + 1;
+		pthread_create(&c->thread, NULL, fn, c);
+	}
+	sleep((unsigned)seconds);
+	bench_stop = 1;
+	for (i = 0; i < count; i++) {
+		c = (struct bench_client *)((char *)clients + (size_t)i * size);
+		pthread_join(c->thread, NULL);
+		total->requests += c->requests;
+		total->errors += c->errors;
+	}
+	return bench_now() - t0;
+}
@@ -0,0 +1,80 @@
+/* Copyright (c) 2020 the Civetweb developers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/* Shared client side of the benchmarks bench_*.c (POSIX only).
+ *
+ * Every benchmark is a small program that starts a server with mg_start
+ * and runs client threads against it over loopback. This file has the
+ * parts they have in common: connecting, sending and receiving, and
+ * running client threads for a fixed time.
+ */
+
+#ifndef TEST_BENCH_H_
+#define TEST_BENCH_H_
+
+#include <pthread.h>
+#include <stddef.h>
+
+
+/* Result of one client thread. Benchmarks with more results put this
+ * struct first in their own client struct. */
+struct bench_client {
+	pthread_t thread;
+	unsigned seed;  /* For rand_r, set by bench_run_clients */
+	long requests;  /* Successful requests (or connections, frames) */
+	long errors;
+};
+
+
+/* Set when the client threads have to stop. */
+extern volatile int bench_stop;
+
+
+/* Monotonic time in seconds. */
+double bench_now(void);
+
+/* Connect to the loopback address with TCP_NODELAY set. Returns the
+ * socket, or -1 on error. */
+int bench_connect(int port);
+
+/* Connect and upgrade to a websocket connection. Only the response
+ * header is read, frames sent by the server right away are not lost.
+ * Returns the socket, or -1 on error. */
+int bench_connect_websocket(int port, const char *uri);
+
+/* Send or receive exactly len bytes. Return 0 on success, -1 if the
+ * connection is broken. */
+int bench_send_all(int sock, const void *data, size_t len);
+int bench_recv_all(int sock, void *data, size_t len);
+
+/* Run count client threads with fn for the given time. clients is an
+ * array of count elements of size bytes, each starting with a struct
+ * bench_client, which is passed to fn. The requests and errors of all
+ * clients are added to total. Returns the elapsed time in seconds. */
+double bench_run_clients(void *clients,
+                         size_t size,
+                         int count,
+                         void *(*fn)(void *),
+                         int seconds,
+                         struct bench_client *total);
+
+#endif /* TEST_BENCH_H_ */
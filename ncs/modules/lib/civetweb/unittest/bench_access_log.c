@@ -0,0 +1,249 @@
+/* This file is part of the CivetWeb web server benchmarks.
+ * (C) 2020 by the CivetWeb authors, MIT license, see bench.h.
+ */
+
+/* Access log throughput (POSIX only).
+ *
+ * Keep-alive clients request a small handler while every request is
+ * written to an access log file. With -b, the access log is buffered
+ * (access_log_buffer_size) and written by the log thread. After mg_stop,
+ * the lines in the log file are counted: every request must be logged,
+ * except the lines reported as dropped.
+ *
+ * Usage: bench_access_log [-b buffer_size] [-f flush_size]
+ *                         [-i flush_interval_ms] [-t threads] [-c clients]
+ *                         [-d seconds] [-l logfile] [-p port]
+ *
+ * Output: one line, e.g.:
+ * buffer=65536 workers=4 clients=4 seconds=5 requests=81234 logged=81234
+ * dropped=0 req_per_sec=16246.8
+ */
+
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for getopt() */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+
+#include "bench.h"
+#include "civetweb.h"
+
+
+static int port = 8092;
+
+
+static int
+hello_handler(struct mg_connection *conn, void *cbdata)
+{
+	(void)cbdata;
+	mg_printf(conn,
+	          "HTTP/1.1 200 OK\r\n"
+	          "Content-Type: text/plain\r\n"
+	          "Content-Length: 2\r\n"
+	          "Connection: keep-alive\r\n\r\nok");
+	return 200;
+}
+
+
+/* Send one request and read the answer.
+ * Returns 1 if ok, and -1 for a broken connection. */
+static int
+one_request(int sock)
+{
+	static const char req[] = "GET /hello?x=1 HTTP/1.1\r\n"
+	                          "Host: localhost\r\n"
+	                          "User-Agent: bench_access_log\r\n\r\n";
+	char buf[512];
+	const char *body;
+	int n, len = 0;
+
+	if (send(sock, req, sizeof(req) - 1, 0) != (int)sizeof(req) - 1) {
+		return -1;
+	}
+	for (;;) {
+		n = (int)recv(sock, buf + len, sizeof(buf) - 1 - (size_t)len, 0);
+		if (n <= 0) {
+			return -1;
+		}
+		len += n;
+		buf[len] = 0;
+		body = strstr(buf, "\r\n\r\n");
+		if (body && (strlen(body + 4) >= 2)) {
+			return 1;
+		}
+		if (len >= (int)sizeof(buf) - 1) {
+			return -1;
+		}
+	}
+}
+
+
+static void *
+client_thread(void *arg)
+{
+	struct bench_client *res = (struct bench_client *)arg;
+	int sock = bench_connect(port);
+
+	while (!bench_stop && (sock >= 0)) {
+		if (one_request(sock) > 0) {
+			res->requests++;
+		} else {
+			res->errors++;
+			close(sock);
+			sock = bench_connect(port);
+		}
+	}
+	if (sock >= 0) {
+		close(sock);
+	}
+	return NULL;
+}
+
+
+static long
+count_lines(const char *path)
+{
+	FILE *f = fopen(path, "r");
+	long lines = 0;
+	int c;
+
+	if (f == NULL) {
+		return -1;
+	}
+	while ((c = getc(f)) != EOF) {
+		lines += (c == '\n');
+	}
+	fclose(f);
+	return lines;
+}
+
+
+/* Read a number from the JSON of mg_get_context_info */
+static long
+info_value(const char *info, const char *key)
+{
+	const char *p = strstr(info, key);
+
+	if (p == NULL) {
+		return 0;
+	}
+	p = strchr(p, ':');
+	return p ? atol(p + 1) : 0;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+	int threads = 4, clients = 4, seconds = 5;
+	const char *buffer_size = "0", *flush_size = "0", *interval = "1000";
+	const char *logfile = "bench_access.log";
+	char threads_str[16], ports_str[32], info[2048];
+	const char *options[] = {"listening_ports",
+	                         ports_str,
+	                         "num_threads",
+	                         threads_str,
+	                         "enable_keep_alive",
+	                         "yes",
+	                         "access_log_file",
+	                         NULL,
+	                         "access_log_buffer_size",
+	                         NULL,
+	                         "access_log_flush_size",
+	                         NULL,
+	                         "access_log_flush_interval_ms",
+	                         NULL,
+	                         NULL};
+	struct bench_client *res, total;
+	struct mg_callbacks callbacks;
+	struct mg_context *ctx;
+	long dropped;
+	double elapsed;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "b:f:i:t:c:d:l:p:")) != -1) {
+		switch (opt) {
+		case 'b':
+			buffer_size = optarg;
+			break;
+		case 'f':
+			flush_size = optarg;
+			break;
+		case 'i':
+			interval = optarg;
+			break;
+		case 't':
+			threads = atoi(optarg);
+			break;
+		case 'c':
+			clients = atoi(optarg);
+			break;
+		case 'd':
+			seconds = atoi(optarg);
+			break;
+		case 'l':
+			logfile = optarg;
+			break;
+		case 'p':
+			port = atoi(optarg);
+			break;
+		default:
+			fprintf(stderr,
+			        "Usage: %s [-b buffer_size] [-f flush_size] "
+			        "[-i flush_interval_ms] [-t threads] [-c clients] "
+			        "[-d seconds] [-l logfile] [-p port]\n",
+			        argv[0]);
+			return 1;
+		}
+	}
+	if (clients < 1) {
+		clients = 1;
+	}
+
+	sprintf(threads_str, "%i", threads);
+	sprintf(ports_str, "127.0.0.1:%i", port);
+	options[7] = logfile;
+	options[9] = buffer_size;
+	options[11] = flush_size;
+	options[13] = interval;
+	remove(logfile);
+
+	mg_init_library(0);
+	memset(&callbacks, 0, sizeof(callbacks));
+	ctx = mg_start(&callbacks, NULL, options);
+	if (ctx == NULL) {
+		fprintf(stderr, "Cannot start server on port %i\n", port);
+		return 1;
+	}
+	mg_set_request_handler(ctx, "/hello", hello_handler, NULL);
+
+	res = (struct bench_client *)calloc((size_t)clients, sizeof(res[0]));
+	elapsed = bench_run_clients(
+	    res, sizeof(res[0]), clients, client_thread, seconds, &total);
+
+	info[0] = 0;
+	mg_get_context_info(ctx, info, (int)sizeof(info));
+	dropped = info_value(info, "\"dropped\"");
+	mg_stop(ctx);
+	mg_exit_library();
+
+	printf("buffer=%s workers=%i clients=%i seconds=%i requests=%li "
+	       "logged=%li dropped=%li errors=%li req_per_sec=%.1f\n",
+	       buffer_size,
+	       threads,
+	       clients,
+	       seconds,
+	       total.requests,
+	       count_lines(logfile),
+	       dropped,
+	       total.errors,
+	       (double)total.requests / elapsed);
+
+	free(res);
+	return 0;
+}
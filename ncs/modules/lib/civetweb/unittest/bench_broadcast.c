@@ -0,0 +1,332 @@
+/* This file is part of the CivetWeb web server benchmarks.
+ * (C) 2020 by the CivetWeb authors, MIT license, see bench.h.
+ */
+
+/* Websocket fan-out with slow clients (POSIX only).
+ *
+ * Fast clients read all frames, slow clients open a websocket connection
+ * but never read. The server sends frames of a fixed size at a fixed rate
+ * to all clients, either with mg_websocket_write in a loop over all
+ * connections (-m loop) or with one mg_websocket_broadcast call (-m group).
+ * Every frame carries its send time, the fast clients measure the delay.
+ * In loop mode, a connection is not used any more after a write error
+ * (request_timeout_ms).
+ *
+ * Usage: bench_broadcast [-m loop|group] [-c fast_clients]
+ *                        [-w slow_clients] [-n frames] [-r frames_per_sec]
+ *                        [-s frame_size] [-p port]
+ *
+ * Output: one line, e.g.:
+ * mode=group fast=8 slow=2 frames=2000 frame_size=4096 send_sec=4.00
+ * max_call_ms=0.1 received=16000 dropped=0 avg_delay_ms=0.2 max_delay_ms=3.1
+ */
+
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for getopt(), usleep() */
+#endif
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+
+#include "bench.h"
+#include "civetweb.h"
+
+
+#define MAX_CONNECTIONS (256)
+
+static int port = 8096;
+static int use_group = 1;
+static struct mg_websocket_group *group = NULL;
+static struct mg_connection *connections[MAX_CONNECTIONS];
+static int num_connections = 0;
+static pthread_mutex_t conn_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+struct fast_client {
+	struct bench_client c; /* c.requests: frames received */
+	int sock;
+	double delay_sum;
+	double delay_max;
+};
+
+
+static void
+ws_ready_handler(struct mg_connection *conn, void *cbdata)
+{
+	(void)cbdata;
+	if (use_group) {
+		mg_websocket_group_join(group, conn);
+	} else {
+		pthread_mutex_lock(&conn_mutex);
+		if (num_connections < MAX_CONNECTIONS) {
+			connections[num_connections++] = conn;
+		}
+		pthread_mutex_unlock(&conn_mutex);
+	}
+}
+
+
+static void
+ws_close_handler(const struct mg_connection *conn, void *cbdata)
+{
+	int i;
+
+	(void)cbdata;
+	pthread_mutex_lock(&conn_mutex);
+	for (i = 0; i < num_connections; i++) {
+		if (connections[i] == conn) {
+			connections[i] = connections[--num_connections];
+			break;
+		}
+	}
+	pthread_mutex_unlock(&conn_mutex);
+}
+
+
+/* Read frames until the connection is closed. The payload starts with
+ * the send time (double). */
+static void *
+fast_client_thread(void *arg)
+{
+	struct fast_client *res = (struct fast_client *)arg;
+	unsigned char hdr[10];
+	unsigned char *payload = NULL;
+	size_t len, payload_size = 0;
+	double sent, delay;
+	int i;
+
+	while (bench_recv_all(res->sock, hdr, 2) == 0) {
+		len = hdr[1] & 127;
+		if (len == 126) {
+			if (bench_recv_all(res->sock, hdr + 2, 2) != 0) {
+				break;
+			}
+			len = ((size_t)hdr[2] << 8) | hdr[3];
+		} else if (len == 127) {
+			if (bench_recv_all(res->sock, hdr + 2, 8) != 0) {
+				break;
+			}
+			len = 0;
+			for (i = 2; i < 10; i++) {
+				len = (len << 8) | hdr[i];
+			}
+		}
+		if (len > payload_size) {
+			free(payload);
+			payload = (unsigned char *)malloc(len);
+			payload_size = len;
+		}
+		if ((payload == NULL)
+		    || (bench_recv_all(res->sock, payload, len) != 0)) {
+			break;
+		}
+		if (((hdr[0] & 0xF) == MG_WEBSOCKET_OPCODE_BINARY)
+		    && (len >= sizeof(sent))) {
+			memcpy(&sent, payload, sizeof(sent));
+			delay = bench_now() - sent;
+			res->c.requests++;
+			res->delay_sum += delay;
+			if (delay > res->delay_max) {
+				res->delay_max = delay;
+			}
+		}
+	}
+	free(payload);
+	return NULL;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+	int fast = 8, slow = 2, frames = 2000, rate = 500;
+	size_t frame_size = 4096;
+	char threads_str[16], ports_str[32];
+	const char *options[] = {"listening_ports",
+	                         ports_str,
+	                         "num_threads",
+	                         threads_str,
+	                         "websocket_timeout_ms",
+	                         "2000",
+	                         "request_timeout_ms",
+	                         "2000",
+	                         NULL};
+	struct fast_client *res;
+	int *slow_socks;
+	struct mg_callbacks callbacks;
+	struct mg_context *ctx;
+	char *payload;
+	double t0, t_call, call_max = 0.0, send_time, delay_sum = 0.0,
+	                   delay_max = 0.0;
+	long received = 0;
+	int opt, i, f, expected;
+
+	while ((opt = getopt(argc, argv, "m:c:w:n:r:s:p:")) != -1) {
+		switch (opt) {
+		case 'm':
+			use_group = !strcmp(optarg, "group");
+			break;
+		case 'c':
+			fast = atoi(optarg);
+			break;
+		case 'w':
+			slow = atoi(optarg);
+			break;
+		case 'n':
+			frames = atoi(optarg);
+			break;
+		case 'r':
+			rate = atoi(optarg);
+			break;
+		case 's':
+			frame_size = (size_t)atol(optarg);
+			break;
+		case 'p':
+			port = atoi(optarg);
+			break;
+		default:
+			fprintf(stderr,
+			        "Usage: %s [-m loop|group] [-c fast_clients] "
+			        "[-w slow_clients] [-n frames] [-r frames_per_sec] "
+			        "[-s frame_size] [-p port]\n",
+			        argv[0]);
+			return 1;
+		}
+	}
+	if ((fast < 1) || (fast + slow > MAX_CONNECTIONS) || (rate < 1)) {
+		fprintf(stderr, "Invalid number of clients or rate\n");
+		return 1;
+	}
+	if (frame_size < sizeof(double)) {
+		frame_size = sizeof(double);
+	}
+
+	/* Every websocket connection occupies a worker thread */
+	sprintf(threads_str, "%i", fast + slow + 1);
+	sprintf(ports_str, "127.0.0.1:%i", port);
+
+	mg_init_library(0);
+	memset(&callbacks, 0, sizeof(callbacks));
+	ctx = mg_start(&callbacks, NULL, options);
+	if (ctx == NULL) {
+		fprintf(stderr, "Cannot start server on port %i\n", port);
+		return 1;
+	}
+	if (use_group) {
+		/* Up to 64 frames or 256 kB per connection */
+		group = mg_websocket_group_create(ctx, 64, 256 * 1024);
+	}
+	mg_set_websocket_handler(ctx,
+	                         "/ws",
+	                         NULL,
+	                         ws_ready_handler,
+	                         NULL,
+	                         ws_close_handler,
+	                         NULL);
+
+	res = (struct fast_client *)calloc((size_t)fast, sizeof(res[0]));
+	slow_socks = (int *)calloc((size_t)(slow + 1), sizeof(int));
+	payload = (char *)calloc(1, frame_size);
+	for (i = 0; i < fast; i++) {
+		res[i].sock = bench_connect_websocket(port, "/ws");
+		if (res[i].sock < 0) {
+			fprintf(stderr, "Cannot connect client\n");
+			return 1;
+		}
+		pthread_create(&res[i].c.thread, NULL, fast_client_thread, &res[i]);
+	}
+	for (i = 0; i < slow; i++) {
+		int small = 4096;
+		slow_socks[i] = bench_connect_websocket(port, "/ws");
+		if (slow_socks[i] >= 0) {
+			(void)setsockopt(slow_socks[i],
+			                 SOL_SOCKET,
+			                 SO_RCVBUF,
+			                 &small,
+			                 sizeof(small));
+		}
+	}
+	usleep(100000); /* Ready handlers */
+
+	t0 = bench_now();
+	for (f = 0; f < frames; f++) {
+		double due = t0 + (double)f / rate;
+		double now = bench_now();
+		if (due > now) {
+			usleep((useconds_t)((due - now) * 1.0E6));
+		}
+
+		t_call = bench_now();
+		memcpy(payload, &t_call, sizeof(t_call));
+		if (use_group) {
+			mg_websocket_broadcast(group,
+			                       MG_WEBSOCKET_OPCODE_BINARY,
+			                       payload,
+			                       frame_size);
+		} else {
+			pthread_mutex_lock(&conn_mutex);
+			for (i = 0; i < num_connections; i++) {
+				if (mg_websocket_write(connections[i],
+				                       MG_WEBSOCKET_OPCODE_BINARY,
+				                       payload,
+				                       frame_size)
+				    <= 0) {
+					/* Timeout: do not send to this client any more */
+					connections[i--] = connections[--num_connections];
+				}
+			}
+			pthread_mutex_unlock(&conn_mutex);
+		}
+		t_call = bench_now() - t_call;
+		if (t_call > call_max) {
+			call_max = t_call;
+		}
+	}
+	send_time = bench_now() - t0;
+	usleep(200000); /* Let the fast clients read the last frames */
+
+	for (i = 0; i < fast; i++) {
+		shutdown(res[i].sock, SHUT_RDWR);
+		pthread_join(res[i].c.thread, NULL);
+		close(res[i].sock);
+		received += res[i].c.requests;
+		delay_sum += res[i].delay_sum;
+		if (res[i].delay_max > delay_max) {
+			delay_max = res[i].delay_max;
+		}
+	}
+	for (i = 0; i < slow; i++) {
+		if (slow_socks[i] >= 0) {
+			close(slow_socks[i]);
+		}
+	}
+	expected = fast * frames;
+
+	printf("mode=%s fast=%i slow=%i frames=%i frame_size=%lu send_sec=%.2f "
+	       "max_call_ms=%.1f received=%li dropped=%li avg_delay_ms=%.1f "
+	       "max_delay_ms=%.1f\n",
+	       use_group ? "group" : "loop",
+	       fast,
+	       slow,
+	       frames,
+	       (unsigned long)frame_size,
+	       send_time,
+	       call_max * 1000.0,
+	       received,
+	       (long)expected - received,
+	       (received > 0) ? (delay_sum / (double)received * 1000.0) : 0.0,
+	       delay_max * 1000.0);
+
+	free(payload);
+	free(slow_socks);
+	free(res);
+	mg_websocket_group_destroy(group);
+	mg_stop(ctx);
+	mg_exit_library();
+	return 0;
+}
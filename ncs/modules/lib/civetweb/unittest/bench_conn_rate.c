@@ -0,0 +1,171 @@
+/* This file is part of the CivetWeb web server benchmarks.
+ * (C) 2020 by the CivetWeb authors, MIT license, see bench.h.
+ */
+
+/* Connection rate (POSIX only).
+ *
+ * Client threads open a new connection for every request
+ * ("Connection: close"), so every request passes through the queue of
+ * accepted sockets between the master thread and the worker threads.
+ * Build the library with and without USE_LOCKFREE_QUEUE to compare the
+ * queue implementations.
+ *
+ * Usage: bench_conn_rate [-t threads] [-c clients] [-d seconds] [-p port]
+ *
+ * Output: one line, e.g.:
+ * workers=8 clients=16 seconds=5 connections=81234
+ * errors=0 conn_per_sec=16246.8
+ */
+
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for getopt() */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+
+#include "bench.h"
+#include "civetweb.h"
+
+
+static const char request[] = "GET /ping HTTP/1.1\r\n"
+                              "Host: localhost\r\n"
+                              "Connection: close\r\n\r\n";
+
+static int port = 8090;
+
+
+static int
+ping_handler(struct mg_connection *conn, void *cbdata)
+{
+	(void)cbdata;
+	mg_printf(conn,
+	          "HTTP/1.1 200 OK\r\n"
+	          "Content-Type: text/plain\r\n"
+	          "Content-Length: 4\r\n"
+	          "Connection: close\r\n\r\n"
+	          "pong");
+	return 200;
+}
+
+
+/* Connect, send one request and read until the server closes. */
+static int
+one_connection(void)
+{
+	char buf[512];
+	int sock, n, len = 0;
+
+	sock = bench_connect(port);
+	if (sock < 0) {
+		return 0;
+	}
+	if (bench_send_all(sock, request, sizeof(request) - 1) != 0) {
+		close(sock);
+		return 0;
+	}
+	while ((n = (int)recv(sock, buf + len, sizeof(buf) - 1 - (size_t)len, 0))
+	       > 0) {
+		len += n;
+		if (len >= (int)sizeof(buf) - 1) {
+			break;
+		}
+	}
+	close(sock);
+	buf[len] = 0;
+	return (strstr(buf, "\r\n\r\npong") != NULL);
+}
+
+
+static void *
+client_thread(void *arg)
+{
+	struct bench_client *res = (struct bench_client *)arg;
+
+	while (!bench_stop) {
+		if (one_connection()) {
+			res->requests++;
+		} else {
+			res->errors++;
+		}
+	}
+	return NULL;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+	int threads = 8, clients = 16, seconds = 5;
+	char threads_str[16], ports_str[32];
+	const char *options[] = {"listening_ports",
+	                         ports_str,
+	                         "num_threads",
+	                         threads_str,
+	                         NULL};
+	struct bench_client *res, total;
+	struct mg_callbacks callbacks;
+	struct mg_context *ctx;
+	double elapsed;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "t:c:d:p:")) != -1) {
+		switch (opt) {
+		case 't':
+			threads = atoi(optarg);
+			break;
+		case 'c':
+			clients = atoi(optarg);
+			break;
+		case 'd':
+			seconds = atoi(optarg);
+			break;
+		case 'p':
+			port = atoi(optarg);
+			break;
+		default:
+			fprintf(stderr,
+			        "Usage: %s [-t threads] [-c clients] [-d seconds] "
+			        "[-p port]\n",
+			        argv[0]);
+			return 1;
+		}
+	}
+	if (clients < 1) {
+		clients = 1;
+	}
+
+	sprintf(threads_str, "%i", threads);
+	sprintf(ports_str, "127.0.0.1:%i", port);
+
+	mg_init_library(0);
+	memset(&callbacks, 0, sizeof(callbacks));
+	ctx = mg_start(&callbacks, NULL, options);
+	if (ctx == NULL) {
+		fprintf(stderr, "Cannot start server on port %i\n", port);
+		return 1;
+	}
+	mg_set_request_handler(ctx, "/ping", ping_handler, NULL);
+
+	res = (struct bench_client *)calloc((size_t)clients, sizeof(res[0]));
+	elapsed = bench_run_clients(
+	    res, sizeof(res[0]), clients, client_thread, seconds, &total);
+
+	printf("workers=%i clients=%i seconds=%i connections=%li "
+	       "errors=%li conn_per_sec=%.1f\n",
+	       threads,
+	       clients,
+	       seconds,
+	       total.requests,
+	       total.errors,
+	       (double)total.requests / elapsed);
+
+	free(res);
+	mg_stop(ctx);
+	mg_exit_library();
+	return 0;
+}
@@ -0,0 +1,248 @@
+/* This file is part of the CivetWeb web server benchmarks.
+ * (C) 2020 by the CivetWeb authors, MIT license, see bench.h.
+ */
+
+/* Idle keep-alive clients versus worker threads (POSIX only).
+ *
+ * For an increasing number of idle keep-alive clients, this program
+ * measures whether a new client still gets an answer, and how long it
+ * takes. Without the keep-alive reactor (USE_EPOLL), every idle client
+ * blocks one worker thread until keep_alive_timeout_ms expires, so new
+ * clients time out as soon as there are more idle clients than workers.
+ *
+ * Usage: bench_keep_alive [-t threads] [-c max_idle_clients]
+ *                         [-k keep_alive_timeout_ms] [-p port]
+ *
+ * One line per measurement is printed, e.g.:
+ * workers=4 idle=64 reactor=yes probe_ok=20/20 probe_avg_ms=0.21
+ * probe_max_ms=0.48 reuse_ok=64/64 reuse_ms=3.10
+ */
+
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for getopt() */
+#endif
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+
+#include "bench.h"
+#include "civetweb.h"
+
+
+#define PROBE_COUNT (20)
+#define PROBE_TIMEOUT_MS (2000)
+
+static const char request[] = "GET /ping HTTP/1.1\r\n"
+                              "Host: localhost\r\n"
+                              "Connection: keep-alive\r\n\r\n";
+
+
+static int
+ping_handler(struct mg_connection *conn, void *cbdata)
+{
+	(void)cbdata;
+	mg_printf(conn,
+	          "HTTP/1.1 200 OK\r\n"
+	          "Content-Type: text/plain\r\n"
+	          "Content-Length: 4\r\n"
+	          "Connection: keep-alive\r\n\r\n"
+	          "pong");
+	return 200;
+}
+
+
+/* Read one complete "pong" response. Returns 1 on success. */
+static int
+read_response(int sock, int timeout_ms)
+{
+	char buf[512];
+	int len = 0;
+	double deadline = bench_now() * 1000.0 + timeout_ms;
+
+	while (len < (int)sizeof(buf) - 1) {
+		struct pollfd pfd;
+		int remaining = (int)(deadline - bench_now() * 1000.0);
+		int n;
+
+		if (remaining <= 0) {
+			return 0;
+		}
+		pfd.fd = sock;
+		pfd.events = POLLIN;
+		if (poll(&pfd, 1, remaining) <= 0) {
+			return 0;
+		}
+		n = (int)recv(sock, buf + len, sizeof(buf) - 1 - (size_t)len, 0);
+		if (n <= 0) {
+			return 0;
+		}
+		len += n;
+		buf[len] = 0;
+		if (strstr(buf, "\r\n\r\npong") != NULL) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+
+static int
+do_request(int sock, int timeout_ms)
+{
+	if (bench_send_all(sock, request, sizeof(request) - 1) != 0) {
+		return 0;
+	}
+	return read_response(sock, timeout_ms);
+}
+
+
+static void
+measure(int port, int workers, int idle, int reactor)
+{
+	int *socks = (int *)calloc((size_t)(idle > 0 ? idle : 1), sizeof(int));
+	int i, connected = 0, probe_ok = 0, reuse_ok = 0;
+	double probe_sum = 0.0, probe_max = 0.0, t0;
+
+	/* Create idle keep-alive clients: one request each, then idle. */
+	for (i = 0; i < idle; i++) {
+		socks[i] = bench_connect(port);
+		if (socks[i] < 0) {
+			break;
+		}
+		connected++;
+		if (send(socks[i], request, sizeof(request) - 1, 0) <= 0) {
+			break;
+		}
+	}
+	for (i = 0; i < connected; i++) {
+		(void)read_response(socks[i], PROBE_TIMEOUT_MS);
+	}
+
+	/* Probe: new clients while the others are idle. */
+	for (i = 0; i < PROBE_COUNT; i++) {
+		int sock = bench_connect(port);
+		double t;
+
+		if (sock < 0) {
+			continue;
+		}
+		t = bench_now() * 1000.0;
+		if (do_request(sock, PROBE_TIMEOUT_MS)) {
+			t = bench_now() * 1000.0 - t;
+			probe_ok++;
+			probe_sum += t;
+			if (t > probe_max) {
+				probe_max = t;
+			}
+		}
+		close(sock);
+	}
+
+	/* All idle clients become active again at the same time. */
+	t0 = bench_now() * 1000.0;
+	for (i = 0; i < connected; i++) {
+		(void)send(socks[i], request, sizeof(request) - 1, 0);
+	}
+	for (i = 0; i < connected; i++) {
+		reuse_ok += read_response(socks[i], PROBE_TIMEOUT_MS);
+	}
+	t0 = bench_now() * 1000.0 - t0;
+
+	printf("workers=%i idle=%i reactor=%s probe_ok=%i/%i probe_avg_ms=%.2f "
+	       "probe_max_ms=%.2f reuse_ok=%i/%i reuse_ms=%.2f\n",
+	       workers,
+	       connected,
+	       reactor ? "yes" : "no",
+	       probe_ok,
+	       PROBE_COUNT,
+	       probe_ok ? probe_sum / probe_ok : 0.0,
+	       probe_max,
+	       reuse_ok,
+	       connected,
+	       t0);
+	fflush(stdout);
+
+	for (i = 0; i < connected; i++) {
+		close(socks[i]);
+	}
+	free(socks);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+	int threads = 4, max_idle = 256, keep_alive_ms = 10000, port = 8089;
+	char threads_str[16], keep_alive_str[16], ports_str[32];
+	const char *options[] = {"listening_ports",
+	                         ports_str,
+	                         "num_threads",
+	                         threads_str,
+	                         "enable_keep_alive",
+	                         "yes",
+	                         "keep_alive_timeout_ms",
+	                         keep_alive_str,
+	                         "request_timeout_ms",
+	                         "10000",
+	                         NULL};
+	const char *reactor_opt;
+	struct mg_callbacks callbacks;
+	struct mg_context *ctx;
+	int opt, idle, reactor;
+
+	while ((opt = getopt(argc, argv, "t:c:k:p:")) != -1) {
+		switch (opt) {
+		case 't':
+			threads = atoi(optarg);
+			break;
+		case 'c':
+			max_idle = atoi(optarg);
+			break;
+		case 'k':
+			keep_alive_ms = atoi(optarg);
+			break;
+		case 'p':
+			port = atoi(optarg);
+			break;
+		default:
+			fprintf(stderr,
+			        "Usage: %s [-t threads] [-c max_idle_clients] "
+			        "[-k keep_alive_timeout_ms] [-p port]\n",
+			        argv[0]);
+			return 1;
+		}
+	}
+
+	sprintf(threads_str, "%i", threads);
+	sprintf(keep_alive_str, "%i", keep_alive_ms);
+	sprintf(ports_str, "127.0.0.1:%i", port);
+
+	mg_init_library(0);
+	memset(&callbacks, 0, sizeof(callbacks));
+	ctx = mg_start(&callbacks, NULL, options);
+	if (ctx == NULL) {
+		fprintf(stderr, "Cannot start server on port %i\n", port);
+		return 1;
+	}
+	mg_set_request_handler(ctx, "/ping", ping_handler, NULL);
+
+	reactor_opt = mg_get_option(ctx, "max_idle_connections");
+	reactor = (reactor_opt != NULL) && (atoi(reactor_opt) > 0);
+
+	for (idle = 0; idle <= max_idle; idle = (idle ? idle * 2 : threads / 2)) {
+		measure(port, threads, idle, reactor);
+		if (idle == 0 && threads < 2) {
+			idle = 1;
+		}
+	}
+
+	mg_stop(ctx);
+	mg_exit_library();
+	return 0;
+}
@@ -0,0 +1,586 @@
+/* This file is part of the CivetWeb web server benchmarks.
+ * (C) 2020 by the CivetWeb authors, MIT license, see bench.h.
+ */
+
+/* Load generator and latency benchmark for the embedded server
+ * (POSIX only).
+ *
+ * Starts a server with mg_start (like examples/embedded_c) and runs one or
+ * all scenarios against it over loopback. Every client thread uses one
+ * connection and sends the next request when the previous answer is
+ * complete, so the latency of every request is measured:
+ *
+ *   keepalive: GET of a small text handler, keep-alive connections
+ *   static:    GET of static files (-z bytes) from a temporary
+ *              document_root
+ *   json:      POST of a small JSON object to a handler that reads it
+ *              and answers with a JSON object
+ *   ws:        websocket echo of masked text frames (-z bytes)
+ *
+ * Latencies are collected in a histogram per thread (buckets of about 3%),
+ * p50 and p99 are the lower bounds of the buckets.
+ *
+ * Usage: bench_load [-s keepalive|static|json|ws|all] [-c clients]
+ *                   [-t threads] [-d seconds] [-z size] [-p port]
+ *
+ * The exit code is 2 if a scenario had errors or no successful requests.
+ *
+ * Output: one line per scenario, e.g.:
+ * scenario=keepalive clients=4 workers=8 seconds=5 requests=201234
+ * errors=0 req_per_sec=40246.8 p50_us=92 p99_us=211 max_us=3120
+ */
+
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for getopt(), rand_r(), mkdtemp() */
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+
+#include "bench.h"
+#include "civetweb.h"
+
+
+enum { SC_KEEPALIVE, SC_STATIC, SC_JSON, SC_WS, NUM_SCENARIOS };
+
+static const char *const scenario_names[NUM_SCENARIOS] = {"keepalive",
+                                                          "static",
+                                                          "json",
+                                                          "ws"};
+
+#define NUM_STATIC_FILES (16)
+
+/* Histogram: values below 2 * HIST_SUB are exact, above that every power
+ * of two is divided in HIST_SUB buckets. */
+#define HIST_SUB (32)
+#define HIST_BUCKETS (HIST_SUB * 40)
+
+static int port = 8094;
+static size_t payload_size = 1024;
+
+
+struct load_client {
+	struct bench_client c;
+	int scenario;
+	uint64_t max_us;
+	uint64_t hist[HIST_BUCKETS];
+};
+
+
+static unsigned
+hist_index(uint64_t us)
+{
+	unsigned shift = 0;
+
+	while ((us >> shift) >= 2 * HIST_SUB) {
+		shift++;
+	}
+	if (shift >= HIST_BUCKETS / HIST_SUB - 1) {
+		return HIST_BUCKETS - 1;
+	}
+	return shift * HIST_SUB + (unsigned)(us >> shift);
+}
+
+
+static uint64_t
+hist_value(unsigned idx)
+{
+	unsigned shift;
+
+	if (idx < 2 * HIST_SUB) {
+		return idx;
+	}
+	shift = idx / HIST_SUB - 1;
+	return (uint64_t)(idx - shift * HIST_SUB) << shift;
+}
+
+
+static uint64_t
+hist_percentile(const uint64_t *hist, uint64_t count, double p)
+{
+	uint64_t sum = 0, limit = (uint64_t)((double)count * p);
+	unsigned i;
+
+	for (i = 0; i < HIST_BUCKETS; i++) {
+		sum += hist[i];
+		if ((sum > limit) || ((sum == count) && (sum > 0))) {
+			return hist_value(i);
+		}
+	}
+	return 0;
+}
+
+
+/* Server side */
+
+static int
+hello_handler(struct mg_connection *conn, void *cbdata)
+{
+	(void)cbdata;
+	mg_printf(conn,
+	          "HTTP/1.1 200 OK\r\n"
+	          "Content-Type: text/plain\r\n"
+	          "Content-Length: 6\r\n"
+	          "Connection: keep-alive\r\n\r\nHello\n");
+	return 200;
+}
+
+
+static int
+json_handler(struct mg_connection *conn, void *cbdata)
+{
+	char body[256], reply[128];
+	const char *id;
+	int len = 0, n;
+
+	(void)cbdata;
+	while ((n = mg_read(conn, body + len, sizeof(body) - 1 - (size_t)len))
+	       > 0) {
+		len += n;
+	}
+	body[len] = 0;
+	id = strstr(body, "\"id\":");
+	n = sprintf(reply,
+	            "{\"id\":%li,\"status\":\"ok\",\"length\":%i}",
+	            id ? atol(id + 5) : -1L,
+	            len);
+	mg_printf(conn,
+	          "HTTP/1.1 200 OK\r\n"
+	          "Content-Type: application/json\r\n"
+	          "Content-Length: %i\r\n"
+	          "Connection: keep-alive\r\n\r\n%s",
+	          n,
+	          reply);
+	return 200;
+}
+
+
+static int
+ws_echo_handler(struct mg_connection *conn,
+                int opcode,
+                char *data,
+                size_t len,
+                void *cbdata)
+{
+	(void)cbdata;
+	if ((opcode & 0xF) == MG_WEBSOCKET_OPCODE_TEXT) {
+		mg_websocket_write(conn, MG_WEBSOCKET_OPCODE_TEXT, data, len);
+	}
+	return 1;
+}
+
+
+/* Client side */
+
+/* Read one HTTP response with a Content-Length into buf. Returns the
+ * status code, or -1 for a broken connection. */
+static int
+read_response(int sock, char *buf, size_t bufsize, size_t *body_len)
+{
+	size_t len = 0, head_len, content_len;
+	const char *end, *cl;
+	ssize_t n;
+
+	for (;;) {
+		n = recv(sock, buf + len, bufsize - 1 - len, 0);
+		if (n <= 0) {
+			return -1;
+		}
+		len += (size_t)n;
+		buf[len] = 0;
+		if ((end = strstr(buf, "\r\n\r\n")) != NULL) {
+			break;
+		}
+		if (len >= bufsize - 1) {
+			return -1;
+		}
+	}
+	head_len = (size_t)(end + 4 - buf);
+	cl = strstr(buf, "Content-Length: ");
+	if ((cl == NULL) || (cl > end)) {
+		return -1;
+	}
+	content_len = (size_t)atol(cl + 16);
+	if (head_len + content_len > bufsize - 1) {
+		return -1;
+	}
+	if ((len < head_len + content_len)
+	    && (bench_recv_all(sock, buf + len, head_len + content_len - len) != 0)) {
+		return -1;
+	}
+	buf[head_len + content_len] = 0;
+	*body_len = content_len;
+	return atoi(buf + 9);
+}
+
+
+/* One request of an HTTP scenario. Returns 1 if ok, 0 for a wrong answer
+ * and -1 for a broken connection. */
+static int
+http_request(int sock, struct load_client *res, char *buf, size_t bufsize)
+{
+	char req[512], body[128];
+	size_t body_len;
+	int n, m, status;
+	long id;
+
+	switch (res->scenario) {
+	case SC_KEEPALIVE:
+		n = sprintf(req, "GET /hello HTTP/1.1\r\nHost: localhost\r\n\r\n");
+		break;
+	case SC_STATIC:
+		n = sprintf(req,
+		            "GET /file%u.bin HTTP/1.1\r\nHost: localhost\r\n\r\n",
+		            rand_r(&res->c.seed) % NUM_STATIC_FILES);
+		break;
+	default:
+		id = (long)rand_r(&res->c.seed);
+		m = sprintf(body,
+		            "{\"id\":%li,\"name\":\"sensor\",\"value\":21.5}",
+		            id);
+		n = sprintf(req,
+		            "POST /api/data HTTP/1.1\r\nHost: localhost\r\n"
+		            "Content-Type: application/json\r\n"
+		            "Content-Length: %i\r\n\r\n%s",
+		            m,
+		            body);
+		if ((bench_send_all(sock, req, (size_t)n) != 0)
+		    || (read_response(sock, buf, bufsize, &body_len) != 200)) {
+			return -1;
+		}
+		sprintf(req, "{\"id\":%li,", id);
+		return !strncmp(buf + strlen(buf) - body_len, req, strlen(req));
+	}
+
+	if (bench_send_all(sock, req, (size_t)n) != 0) {
+		return -1;
+	}
+	status = read_response(sock, buf, bufsize, &body_len);
+	if (status < 0) {
+		return -1;
+	}
+	return (status == 200)
+	       && (body_len == ((res->scenario == SC_STATIC) ? payload_size : 6));
+}
+
+
+/* One websocket echo. frame is a masked text frame of frame_len bytes
+ * with a payload of payload_size bytes. */
+static int
+ws_request(int sock, const unsigned char *frame, size_t frame_len, char *buf)
+{
+	unsigned char hdr[10];
+	size_t len;
+	int i;
+
+	if ((bench_send_all(sock, frame, frame_len) != 0)
+	    || (bench_recv_all(sock, hdr, 2) != 0)) {
+		return -1;
+	}
+	len = hdr[1] & 0x7F;
+	if (len == 126) {
+		if (bench_recv_all(sock, hdr + 2, 2) != 0) {
+			return -1;
+		}
+		len = ((size_t)hdr[2] << 8) | hdr[3];
+	} else if (len == 127) {
+		if (bench_recv_all(sock, hdr + 2, 8) != 0) {
+			return -1;
+		}
+		for (len = 0, i = 2; i < 10; i++) {
+			len = (len << 8) | hdr[i];
+		}
+	}
+	if ((hdr[0] != 0x81) || (len != payload_size)
+	    || (bench_recv_all(sock, buf, len) != 0)) {
+		return -1;
+	}
+	/* Payload byte i is 'a' + i % 26 */
+	return (len == 0)
+	       || ((buf[0] == 'a') && (buf[len - 1] == (char)('a' + (len - 1) % 26)));
+}
+
+
+static unsigned char *
+build_ws_frame(size_t *frame_len)
+{
+	static const unsigned char mask[4] = {0x37, 0xFA, 0x21, 0x3D};
+	size_t hdr = 2, i;
+	unsigned char *frame = (unsigned char *)malloc(payload_size + 14);
+
+	if (frame == NULL) {
+		return NULL;
+	}
+	frame[0] = 0x81; /* FIN, text */
+	if (payload_size < 126) {
+		frame[1] = (unsigned char)(0x80 | payload_size);
+	} else if (payload_size <= 0xFFFF) {
+		frame[1] = 0x80 | 126;
+		frame[2] = (unsigned char)(payload_size >> 8);
+		frame[3] = (unsigned char)payload_size;
+		hdr = 4;
+	} else {
+		frame[1] = 0x80 | 127;
+		for (i = 0; i < 8; i++) {
+			frame[2 + i] =
+			    (unsigned char)((uint64_t)payload_size >> (56 - 8 * i));
+		}
+		hdr = 10;
+	}
+	memcpy(frame + hdr, mask, 4);
+	hdr += 4;
+	for (i = 0; i < payload_size; i++) {
+		frame[hdr + i] = (unsigned char)(('a' + i % 26) ^ mask[i & 3]);
+	}
+	*frame_len = hdr + payload_size;
+	return frame;
+}
+
+
+static void *
+client_thread(void *arg)
+{
+	struct load_client *res = (struct load_client *)arg;
+	size_t bufsize = payload_size + 1024, frame_len = 0;
+	char *buf = (char *)malloc(bufsize);
+	unsigned char *frame = NULL;
+	uint64_t us;
+	double t0;
+	int sock, r;
+
+	if (res->scenario == SC_WS) {
+		frame = build_ws_frame(&frame_len);
+		sock = bench_connect_websocket(port, "/ws");
+	} else {
+		sock = bench_connect(port);
+	}
+
+	while (!bench_stop && (sock >= 0) && (buf != NULL)) {
+		t0 = bench_now();
+		if (res->scenario == SC_WS) {
+			r = (frame != NULL) ? ws_request(sock, frame, frame_len, buf) : -1;
+		} else {
+			r = http_request(sock, res, buf, bufsize);
+		}
+		us = (uint64_t)((bench_now() - t0) * 1.0E6);
+
+		if (r > 0) {
+			res->c.requests++;
+			res->hist[hist_index(us)]++;
+			if (us > res->max_us) {
+				res->max_us = us;
+			}
+		} else {
+			res->c.errors++;
+			if (r < 0) {
+				close(sock);
+				sock = (res->scenario == SC_WS) ? bench_connect_websocket(port, "/ws")
+				                                : bench_connect(port);
+			}
+		}
+	}
+	if (sock >= 0) {
+		close(sock);
+	}
+	free(frame);
+	free(buf);
+	return NULL;
+}
+
+
+/* Returns 0 if all requests were successful. */
+static int
+run_scenario(int scenario, int clients, int workers, int seconds)
+{
+	struct load_client *res;
+	struct bench_client total;
+	uint64_t hist[HIST_BUCKETS], count = 0, max_us = 0;
+	double elapsed;
+	int i;
+	unsigned j;
+
+	res = (struct load_client *)calloc((size_t)clients, sizeof(res[0]));
+	if (res == NULL) {
+		return -1;
+	}
+	for (i = 0; i < clients; i++) {
+		res[i].scenario = scenario;
+	}
+	elapsed = bench_run_clients(
+	    res, sizeof(res[0]), clients, client_thread, seconds, &total);
+	memset(hist, 0, sizeof(hist));
+	for (i = 0; i < clients; i++) {
+		for (j = 0; j < HIST_BUCKETS; j++) {
+			hist[j] += res[i].hist[j];
+		}
+		if (res[i].max_us > max_us) {
+			max_us = res[i].max_us;
+		}
+	}
+	count = (uint64_t)total.requests;
+
+	printf("scenario=%s clients=%i workers=%i seconds=%i requests=%li "
+	       "errors=%li req_per_sec=%.1f p50_us=%lu p99_us=%lu max_us=%lu\n",
+	       scenario_names[scenario],
+	       clients,
+	       workers,
+	       seconds,
+	       total.requests,
+	       total.errors,
+	       (double)total.requests / elapsed,
+	       (unsigned long)hist_percentile(hist, count, 0.50),
+	       (unsigned long)hist_percentile(hist, count, 0.99),
+	       (unsigned long)max_us);
+	fflush(stdout);
+	free(res);
+	return ((total.errors > 0) || (total.requests == 0)) ? -1 : 0;
+}
+
+
+/* Create the files of the static scenario. */
+static int
+create_static_files(const char *dir)
+{
+	char path[256];
+	char *data = (char *)malloc(payload_size + 1);
+	FILE *f;
+	int i;
+
+	if (data == NULL) {
+		return -1;
+	}
+	memset(data, 'x', payload_size);
+	for (i = 0; i < NUM_STATIC_FILES; i++) {
+		sprintf(path, "%s/file%i.bin", dir, i);
+		f = fopen(path, "wb");
+		if ((f == NULL)
+		    || (fwrite(data, 1, payload_size, f) != payload_size)) {
+			if (f) {
+				fclose(f);
+			}
+			free(data);
+			return -1;
+		}
+		fclose(f);
+	}
+	free(data);
+	return 0;
+}
+
+
+static void
+remove_static_files(const char *dir)
+{
+	char path[256];
+	int i;
+
+	for (i = 0; i < NUM_STATIC_FILES; i++) {
+		sprintf(path, "%s/file%i.bin", dir, i);
+		remove(path);
+	}
+	rmdir(dir);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+	int clients = 4, workers = 0, seconds = 5, scenario = -1, failed = 0;
+	char threads_str[16], ports_str[32];
+	char docroot[] = "/tmp/civetweb_bench_XXXXXX";
+	const char *options[] = {"listening_ports",
+	                         ports_str,
+	                         "num_threads",
+	                         threads_str,
+	                         "enable_keep_alive",
+	                         "yes",
+	                         "tcp_nodelay",
+	                         "1",
+	                         "document_root",
+	                         docroot,
+	                         NULL};
+	struct mg_callbacks callbacks;
+	struct mg_context *ctx;
+	int opt, i;
+
+	while ((opt = getopt(argc, argv, "s:c:t:d:z:p:")) != -1) {
+		switch (opt) {
+		case 's':
+			for (i = 0; i < NUM_SCENARIOS; i++) {
+				if (!strcmp(optarg, scenario_names[i])) {
+					scenario = i;
+				}
+			}
+			if ((scenario < 0) && strcmp(optarg, "all")) {
+				fprintf(stderr, "Unknown scenario %s\n", optarg);
+				return 1;
+			}
+			break;
+		case 'c':
+			clients = atoi(optarg);
+			break;
+		case 't':
+			workers = atoi(optarg);
+			break;
+		case 'd':
+			seconds = atoi(optarg);
+			break;
+		case 'z':
+			payload_size = (size_t)atol(optarg);
+			break;
+		case 'p':
+			port = atoi(optarg);
+			break;
+		default:
+			fprintf(stderr,
+			        "Usage: %s [-s keepalive|static|json|ws|all] "
+			        "[-c clients] [-t threads] [-d seconds] [-z size] "
+			        "[-p port]\n",
+			        argv[0]);
+			return 1;
+		}
+	}
+	if (clients < 1) {
+		clients = 1;
+	}
+	if (workers < 1) {
+		/* Every websocket connection occupies a worker thread */
+		workers = clients + 4;
+	}
+
+	if ((mkdtemp(docroot) == NULL) || (create_static_files(docroot) != 0)) {
+		fprintf(stderr, "Cannot create static files\n");
+		return 1;
+	}
+	sprintf(threads_str, "%i", workers);
+	sprintf(ports_str, "127.0.0.1:%i", port);
+
+	mg_init_library(MG_FEATURES_WEBSOCKET);
+	memset(&callbacks, 0, sizeof(callbacks));
+	ctx = mg_start(&callbacks, NULL, options);
+	if (ctx == NULL) {
+		fprintf(stderr, "Cannot start server on port %i\n", port);
+		remove_static_files(docroot);
+		return 1;
+	}
+	mg_set_request_handler(ctx, "/hello$", hello_handler, NULL);
+	mg_set_request_handler(ctx, "/api/data$", json_handler, NULL);
+	mg_set_websocket_handler(
+	    ctx, "/ws", NULL, NULL, ws_echo_handler, NULL, NULL);
+
+	for (i = 0; i < NUM_SCENARIOS; i++) {
+		if ((scenario < 0) || (scenario == i)) {
+			failed |= run_scenario(i, clients, workers, seconds);
+		}
+	}
+
+	mg_stop(ctx);
+	mg_exit_library();
+	remove_static_files(docroot);
+	return failed ? 2 : 0;
+}
@@ -0,0 +1,210 @@
+/* This file is part of the CivetWeb web server benchmarks.
+ * (C) 2020 by the CivetWeb authors, MIT license, see bench.h.
+ */
+
+/* Request handler routing with many handlers (POSIX only).
+ *
+ * Registers a device management like API with many request handlers
+ * ("/api/v1/dev<N>/status", "/api/v1/dev<N>/config", ...) and measures
+ * requests/s of keep-alive clients that request random handlers. The
+ * response of every handler contains its number, so wrong routing is
+ * counted as an error.
+ *
+ * Usage: bench_router [-n handlers] [-t threads] [-c clients]
+ *                     [-d seconds] [-p port]
+ *
+ * Output: one line, e.g.:
+ * handlers=200 workers=4 clients=4 seconds=5 requests=81234 errors=0
+ * req_per_sec=16246.8
+ */
+
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for getopt(), rand_r() */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+
+#include "bench.h"
+#include "civetweb.h"
+
+
+static const char *const subresources[] = {"status", "config", "log", "fw"};
+#define NUM_SUB (sizeof(subresources) / sizeof(subresources[0]))
+
+static int port = 8091;
+static int handlers = 200;
+
+
+static int
+numbered_handler(struct mg_connection *conn, void *cbdata)
+{
+	char body[16];
+	int len = sprintf(body, "%i", (int)(intptr_t)cbdata);
+
+	mg_printf(conn,
+	          "HTTP/1.1 200 OK\r\n"
+	          "Content-Type: text/plain\r\n"
+	          "Content-Length: %i\r\n"
+	          "Connection: keep-alive\r\n\r\n%s",
+	          len,
+	          body);
+	return 200;
+}
+
+
+/* Send one request for handler number id and check the answer.
+ * Returns 1 if ok, 0 for a wrong answer and -1 for a broken connection. */
+static int
+one_request(int sock, int id)
+{
+	char buf[512], expect[16];
+	const char *body;
+	int n, len = 0;
+
+	n = sprintf(buf,
+	            "GET /api/v1/dev%i/%s HTTP/1.1\r\nHost: localhost\r\n\r\n",
+	            id / (int)NUM_SUB,
+	            subresources[id % (int)NUM_SUB]);
+	if (send(sock, buf, (size_t)n, 0) != n) {
+		return -1;
+	}
+	for (;;) {
+		n = (int)recv(sock, buf + len, sizeof(buf) - 1 - (size_t)len, 0);
+		if (n <= 0) {
+			return -1;
+		}
+		len += n;
+		buf[len] = 0;
+		body = strstr(buf, "\r\n\r\n");
+		if (body && (strlen(body + 4) >= (size_t)sprintf(expect, "%i", id))) {
+			return !strcmp(body + 4, expect);
+		}
+		if (len >= (int)sizeof(buf) - 1) {
+			return -1;
+		}
+	}
+}
+
+
+static void *
+client_thread(void *arg)
+{
+	struct bench_client *res = (struct bench_client *)arg;
+	int sock = bench_connect(port);
+	int r;
+
+	while (!bench_stop && (sock >= 0)) {
+		r = one_request(sock,
+		                (int)((unsigned)rand_r(&res->seed) % (unsigned)handlers));
+		if (r > 0) {
+			res->requests++;
+		} else {
+			res->errors++;
+			if (r < 0) {
+				close(sock);
+				sock = bench_connect(port);
+			}
+		}
+	}
+	if (sock >= 0) {
+		close(sock);
+	}
+	return NULL;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+	int threads = 4, clients = 4, seconds = 5;
+	char threads_str[16], ports_str[32], uri[64];
+	const char *options[] = {"listening_ports",
+	                         ports_str,
+	                         "num_threads",
+	                         threads_str,
+	                         "enable_keep_alive",
+	                         "yes",
+	                         NULL};
+	struct bench_client *res, total;
+	struct mg_callbacks callbacks;
+	struct mg_context *ctx;
+	double elapsed;
+	int opt, i;
+
+	while ((opt = getopt(argc, argv, "n:t:c:d:p:")) != -1) {
+		switch (opt) {
+		case 'n':
+			handlers = atoi(optarg);
+			break;
+		case 't':
+			threads = atoi(optarg);
+			break;
+		case 'c':
+			clients = atoi(optarg);
+			break;
+		case 'd':
+			seconds = atoi(optarg);
+			break;
+		case 'p':
+			port = atoi(optarg);
+			break;
+		default:
+			fprintf(stderr,
+			        "Usage: %s [-n handlers] [-t threads] [-c clients] "
+			        "[-d seconds] [-p port]\n",
+			        argv[0]);
+			return 1;
+		}
+	}
+	if (handlers < 1) {
+		handlers = 1;
+	}
+	if (clients < 1) {
+		clients = 1;
+	}
+
+	sprintf(threads_str, "%i", threads);
+	sprintf(ports_str, "127.0.0.1:%i", port);
+
+	mg_init_library(0);
+	memset(&callbacks, 0, sizeof(callbacks));
+	ctx = mg_start(&callbacks, NULL, options);
+	if (ctx == NULL) {
+		fprintf(stderr, "Cannot start server on port %i\n", port);
+		return 1;
+	}
+	for (i = 0; i < handlers; i++) {
+		sprintf(uri,
+		        "/api/v1/dev%i/%s",
+		        i / (int)NUM_SUB,
+		        subresources[i % (int)NUM_SUB]);
+		mg_set_request_handler(ctx,
+		                       uri,
+		                       numbered_handler,
+		                       (void *)(intptr_t)i);
+	}
+
+	res = (struct bench_client *)calloc((size_t)clients, sizeof(res[0]));
+	elapsed = bench_run_clients(
+	    res, sizeof(res[0]), clients, client_thread, seconds, &total);
+
+	printf("handlers=%i workers=%i clients=%i seconds=%i requests=%li "
+	       "errors=%li req_per_sec=%.1f\n",
+	       handlers,
+	       threads,
+	       clients,
+	       seconds,
+	       total.requests,
+	       total.errors,
+	       (double)total.requests / elapsed);
+
+	free(res);
+	mg_stop(ctx);
+	mg_exit_library();
+	return 0;
+}
@@ -0,0 +1,297 @@
+/* This file is part of the CivetWeb web server benchmarks.
+ * (C) 2020 by the CivetWeb authors, MIT license, see bench.h.
+ */
+
+/* Static file serving (POSIX only).
+ *
+ * Creates a document root with small and medium sized files (the medium
+ * sized ones with a precompressed ".gz" variant) and measures requests/s
+ * of keep-alive clients that request random files with
+ * "Accept-Encoding: gzip". Every response body is checked against the
+ * expected size, so a wrong file or variant is counted as an error.
+ * Use -e to set static_file_cache_entries (0 = no cache).
+ *
+ * Usage: bench_static_files [-n files] [-e cache_entries] [-t threads]
+ *                           [-c clients] [-d seconds] [-p port]
+ *
+ * Output: one line, e.g.:
+ * files=100 cache_entries=256 workers=4 clients=4 seconds=5 requests=81234
+ * errors=0 req_per_sec=16246.8
+ */
+
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for getopt(), rand_r(), mkdtemp() */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+
+#include "bench.h"
+#include "civetweb.h"
+
+
+/* Files with an even number: 2 kB text. Odd number: 40 kB script and a
+ * 10 kB ".gz" file (the content does not matter, it is not unpacked). */
+#define SMALL_SIZE (2 * 1024)
+#define MEDIUM_SIZE (40 * 1024)
+#define GZ_SIZE (10 * 1024)
+
+static int port = 8092;
+static int files = 100;
+
+
+static int
+write_file(const char *path, size_t size, char fill)
+{
+	char buf[1024];
+	FILE *f = fopen(path, "wb");
+
+	if (f == NULL) {
+		return 0;
+	}
+	memset(buf, fill, sizeof(buf));
+	while (size > 0) {
+		size_t n = (size < sizeof(buf)) ? size : sizeof(buf);
+		if (fwrite(buf, 1, n, f) != n) {
+			fclose(f);
+			return 0;
+		}
+		size -= n;
+	}
+	return (fclose(f) == 0);
+}
+
+
+static int
+create_files(const char *dir)
+{
+	char path[256];
+	int i;
+
+	for (i = 0; i < files; i++) {
+		if (i & 1) {
+			sprintf(path, "%s/file%i.js", dir, i);
+			if (!write_file(path, MEDIUM_SIZE, 'm')) {
+				return 0;
+			}
+			strcat(path, ".gz");
+			if (!write_file(path, GZ_SIZE, 'z')) {
+				return 0;
+			}
+		} else {
+			sprintf(path, "%s/file%i.txt", dir, i);
+			if (!write_file(path, SMALL_SIZE, 's')) {
+				return 0;
+			}
+		}
+	}
+	return 1;
+}
+
+
+static void
+remove_files(const char *dir)
+{
+	char path[256];
+	int i;
+
+	for (i = 0; i < files; i++) {
+		if (i & 1) {
+			sprintf(path, "%s/file%i.js", dir, i);
+			(void)remove(path);
+			strcat(path, ".gz");
+		} else {
+			sprintf(path, "%s/file%i.txt", dir, i);
+		}
+		(void)remove(path);
+	}
+	(void)rmdir(dir);
+}
+
+
+/* Request file number id and read the complete response.
+ * Returns 1 if ok, 0 for a wrong answer and -1 for a broken connection. */
+static int
+one_request(int sock, int id)
+{
+	char buf[16 * 1024];
+	const char *hdr_end, *cl;
+	long expect = (id & 1) ? GZ_SIZE : SMALL_SIZE;
+	long content_length, body;
+	int n, len = 0, status_ok;
+
+	n = sprintf(buf,
+	            "GET /file%i.%s HTTP/1.1\r\nHost: localhost\r\n"
+	            "Accept-Encoding: gzip\r\n\r\n",
+	            id,
+	            (id & 1) ? "js" : "txt");
+	if (send(sock, buf, (size_t)n, 0) != n) {
+		return -1;
+	}
+
+	/* Header */
+	for (;;) {
+		n = (int)recv(sock, buf + len, sizeof(buf) - 1 - (size_t)len, 0);
+		if (n <= 0) {
+			return -1;
+		}
+		len += n;
+		buf[len] = 0;
+		hdr_end = strstr(buf, "\r\n\r\n");
+		if (hdr_end) {
+			break;
+		}
+		if (len >= (int)sizeof(buf) - 1) {
+			return -1;
+		}
+	}
+	cl = strstr(buf, "Content-Length: ");
+	if ((cl == NULL) || (cl > hdr_end)) {
+		return -1;
+	}
+	content_length = atol(cl + 16);
+	status_ok = !strncmp(buf, "HTTP/1.1 200 ", 13);
+
+	/* Body */
+	body = (long)(buf + len - (hdr_end + 4));
+	while (body < content_length) {
+		n = (int)recv(sock, buf, sizeof(buf), 0);
+		if (n <= 0) {
+			return -1;
+		}
+		body += n;
+	}
+	return status_ok && (body == content_length) && (content_length == expect);
+}
+
+
+static void *
+client_thread(void *arg)
+{
+	struct bench_client *res = (struct bench_client *)arg;
+	int sock = bench_connect(port);
+	int r;
+
+	while (!bench_stop && (sock >= 0)) {
+		r = one_request(sock,
+		                (int)((unsigned)rand_r(&res->seed) % (unsigned)files));
+		if (r > 0) {
+			res->requests++;
+		} else {
+			res->errors++;
+			if (r < 0) {
+				close(sock);
+				sock = bench_connect(port);
+			}
+		}
+	}
+	if (sock >= 0) {
+		close(sock);
+	}
+	return NULL;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+	int threads = 4, clients = 4, seconds = 5, entries = 256;
+	char threads_str[16], ports_str[32], entries_str[16];
+	char dir[] = "/tmp/bench_static_XXXXXX";
+	const char *options[] = {"listening_ports",
+	                         ports_str,
+	                         "num_threads",
+	                         threads_str,
+	                         "enable_keep_alive",
+	                         "yes",
+	                         "tcp_nodelay",
+	                         "1",
+	                         "document_root",
+	                         dir,
+	                         "static_file_cache_entries",
+	                         entries_str,
+	                         NULL};
+	struct bench_client *res, total;
+	struct mg_callbacks callbacks;
+	struct mg_context *ctx;
+	double elapsed;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "n:e:t:c:d:p:")) != -1) {
+		switch (opt) {
+		case 'n':
+			files = atoi(optarg);
+			break;
+		case 'e':
+			entries = atoi(optarg);
+			break;
+		case 't':
+			threads = atoi(optarg);
+			break;
+		case 'c':
+			clients = atoi(optarg);
+			break;
+		case 'd':
+			seconds = atoi(optarg);
+			break;
+		case 'p':
+			port = atoi(optarg);
+			break;
+		default:
+			fprintf(stderr,
+			        "Usage: %s [-n files] [-e cache_entries] [-t threads] "
+			        "[-c clients] [-d seconds] [-p port]\n",
+			        argv[0]);
+			return 1;
+		}
+	}
+	if (files < 1) {
+		files = 1;
+	}
+	if (clients < 1) {
+		clients = 1;
+	}
+
+	if ((mkdtemp(dir) == NULL) || !create_files(dir)) {
+		fprintf(stderr, "Cannot create files in %s\n", dir);
+		return 1;
+	}
+
+	sprintf(threads_str, "%i", threads);
+	sprintf(ports_str, "127.0.0.1:%i", port);
+	sprintf(entries_str, "%i", entries);
+
+	mg_init_library(0);
+	memset(&callbacks, 0, sizeof(callbacks));
+	ctx = mg_start(&callbacks, NULL, options);
+	if (ctx == NULL) {
+		fprintf(stderr, "Cannot start server on port %i\n", port);
+		remove_files(dir);
+		return 1;
+	}
+
+	res = (struct bench_client *)calloc((size_t)clients, sizeof(res[0]));
+	elapsed = bench_run_clients(
+	    res, sizeof(res[0]), clients, client_thread, seconds, &total);
+
+	printf("files=%i cache_entries=%i workers=%i clients=%i seconds=%i "
+	       "requests=%li errors=%li req_per_sec=%.1f\n",
+	       files,
+	       entries,
+	       threads,
+	       clients,
+	       seconds,
+	       total.requests,
+	       total.errors,
+	       (double)total.requests / elapsed);
+
+	free(res);
+	mg_stop(ctx);
+	mg_exit_library();
+	remove_files(dir);
+	return 0;
+}
@@ -0,0 +1,214 @@
+/* This file is part of the CivetWeb web server benchmarks.
+ * (C) 2020 by the CivetWeb authors, MIT license, see bench.h.
+ */
+
+/* Websocket receive throughput (POSIX only).
+ *
+ * Every client opens a websocket connection and sends masked binary
+ * frames of a fixed size as fast as possible. The server data handler
+ * checks the unmasked payload and counts frames and bytes, so the result
+ * shows the cost of frame parsing, unmasking and buffer handling for
+ * small (in the connection buffer) and large (-s > 16 kB) frames.
+ *
+ * Usage: bench_websocket [-s frame_size] [-c clients] [-d seconds]
+ *                        [-p port]
+ *
+ * Output: one line, e.g.:
+ * frame_size=1024 clients=4 seconds=5 frames=812340 errors=0
+ * frames_per_sec=162468.0 mbytes_per_sec=158.7
+ */
+
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for getopt() */
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+
+#include "bench.h"
+#include "civetweb.h"
+
+
+static int port = 8093;
+static size_t frame_size = 1024;
+static volatile long frames_received = 0;
+static volatile long payload_errors = 0;
+
+
+/* Payload byte i is (i & 0xFF) after unmasking */
+static int
+ws_data_handler(struct mg_connection *conn,
+                int opcode,
+                char *data,
+                size_t len,
+                void *cbdata)
+{
+	size_t i;
+
+	(void)conn;
+	(void)cbdata;
+	if ((opcode & 0xF) != MG_WEBSOCKET_OPCODE_BINARY) {
+		return 1;
+	}
+	if (len != frame_size) {
+		__sync_fetch_and_add(&payload_errors, 1);
+		return 1;
+	}
+	/* Check some bytes, including both ends */
+	for (i = 0; i < len; i += 61) {
+		if ((unsigned char)data[i] != (unsigned char)(i & 0xFF)) {
+			__sync_fetch_and_add(&payload_errors, 1);
+			return 1;
+		}
+	}
+	if ((len > 0) && ((unsigned char)data[len - 1] != ((len - 1) & 0xFF))) {
+		__sync_fetch_and_add(&payload_errors, 1);
+		return 1;
+	}
+	__sync_fetch_and_add(&frames_received, 1);
+	return 1;
+}
+
+
+/* Build one masked binary frame with the payload expected by
+ * ws_data_handler. */
+static unsigned char *
+build_frame(size_t *frame_len)
+{
+	static const unsigned char mask[4] = {0x37, 0xFA, 0x21, 0x3D};
+	size_t hdr = 2, i;
+	unsigned char *frame = (unsigned char *)malloc(frame_size + 14);
+
+	if (frame == NULL) {
+		return NULL;
+	}
+	frame[0] = 0x82; /* FIN, binary */
+	if (frame_size < 126) {
+		frame[1] = (unsigned char)(0x80 | frame_size);
+	} else if (frame_size <= 0xFFFF) {
+		frame[1] = 0x80 | 126;
+		frame[2] = (unsigned char)(frame_size >> 8);
+		frame[3] = (unsigned char)frame_size;
+		hdr = 4;
+	} else {
+		frame[1] = 0x80 | 127;
+		for (i = 0; i < 8; i++) {
+			frame[2 + i] = (unsigned char)((uint64_t)frame_size >> (56 - 8 * i));
+		}
+		hdr = 10;
+	}
+	memcpy(frame + hdr, mask, 4);
+	hdr += 4;
+	for (i = 0; i < frame_size; i++) {
+		frame[hdr + i] = (unsigned char)((i & 0xFF) ^ mask[i & 3]);
+	}
+	*frame_len = hdr + frame_size;
+	return frame;
+}
+
+
+static void *
+client_thread(void *arg)
+{
+	size_t frame_len = 0;
+	unsigned char *frame = build_frame(&frame_len);
+	int sock = bench_connect_websocket(port, "/ws");
+
+	(void)arg;
+	while (!bench_stop && (sock >= 0) && (frame != NULL)) {
+		if (bench_send_all(sock, frame, frame_len) != 0) {
+			close(sock);
+			sock = -1;
+		}
+	}
+	if (sock >= 0) {
+		close(sock);
+	}
+	free(frame);
+	return NULL;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+	int clients = 4, seconds = 5;
+	char threads_str[16], ports_str[32];
+	const char *options[] = {"listening_ports",
+	                         ports_str,
+	                         "num_threads",
+	                         threads_str,
+	                         NULL};
+	struct bench_client *res, total;
+	struct mg_callbacks callbacks;
+	struct mg_context *ctx;
+	long frames;
+	double elapsed;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "s:c:d:p:")) != -1) {
+		switch (opt) {
+		case 's':
+			frame_size = (size_t)atol(optarg);
+			break;
+		case 'c':
+			clients = atoi(optarg);
+			break;
+		case 'd':
+			seconds = atoi(optarg);
+			break;
+		case 'p':
+			port = atoi(optarg);
+			break;
+		default:
+			fprintf(stderr,
+			        "Usage: %s [-s frame_size] [-c clients] [-d seconds] "
+			        "[-p port]\n",
+			        argv[0]);
+			return 1;
+		}
+	}
+	if (clients < 1) {
+		clients = 1;
+	}
+
+	/* Every websocket connection occupies a worker thread */
+	sprintf(threads_str, "%i", clients + 1);
+	sprintf(ports_str, "127.0.0.1:%i", port);
+
+	mg_init_library(0);
+	memset(&callbacks, 0, sizeof(callbacks));
+	ctx = mg_start(&callbacks, NULL, options);
+	if (ctx == NULL) {
+		fprintf(stderr, "Cannot start server on port %i\n", port);
+		return 1;
+	}
+	mg_set_websocket_handler(
+	    ctx, "/ws", NULL, NULL, ws_data_handler, NULL, NULL);
+
+	/* Frames are counted by the server */
+	res = (struct bench_client *)calloc((size_t)clients, sizeof(res[0]));
+	elapsed = bench_run_clients(
+	    res, sizeof(res[0]), clients, client_thread, seconds, &total);
+	frames = frames_received;
+
+	printf("frame_size=%lu clients=%i seconds=%i frames=%li errors=%li "
+	       "frames_per_sec=%.1f mbytes_per_sec=%.1f\n",
+	       (unsigned long)frame_size,
+	       clients,
+	       seconds,
+	       frames,
+	       payload_errors,
+	       (double)frames / elapsed,
+	       (double)frames * (double)frame_size / elapsed / 1048576.0);
+
+	free(res);
+	mg_stop(ctx);
+	mg_exit_library();
+	return 0;
+}
@@ -761,7 +761,9 @@ START_TEST(test_mask_data)
 #if defined(USE_WEBSOCKET)
 	char in[1024];
 	char out[1024];
-	int i;
+	int i, offs, len;
+	static const unsigned char key[4] = {0x12, 0x34, 0x56, 0x78};
+	unsigned char expect;
 #endif
 
 	uint32_t mask = 0x61626364;
@@ -797,6 +799,22 @@ START_TEST(test_mask_data)
 	ck_assert_uint_eq((unsigned char)out[2], 2u ^ 2u);
 	ck_assert_uint_eq((unsigned char)out[3], 3u ^ 1u);
 	ck_assert_uint_eq((unsigned char)out[4], 4u ^ 4u);
+
+	/* In place unmasking: all alignments and lengths around the block
+	 * sizes, only the given range may change */
+	for (offs = 0; offs < 8; offs++) {
+		for (len = 0; len < 100; len++) {
+			memcpy(out, in, sizeof(out));
+			unmask_data((unsigned char *)out + offs, (size_t)len, key);
+			for (i = 0; i < 128; i++) {
+				expect = (unsigned char)in[i];
+				if ((i >= offs) && (i < offs + len)) {
+					expect ^= key[(i - offs) & 3];
+				}
+				ck_assert_uint_eq((unsigned char)out[i], expect);
+			}
+		}
+	}
 #endif
 }
 END_TEST
@@ -962,6 +980,12 @@ START_TEST(test_config_options)
 	ck_assert_str_eq("ssi_pattern", config_options[SSI_EXTENSIONS].name);
 	ck_assert_str_eq("throttle", config_options[THROTTLE].name);
 	ck_assert_str_eq("access_log_file", config_options[ACCESS_LOG_FILE].name);
+	ck_assert_str_eq("access_log_buffer_size",
+	                 config_options[ACCESS_LOG_BUFFER_SIZE].name);
+	ck_assert_str_eq("access_log_flush_interval_ms",
+	                 config_options[ACCESS_LOG_FLUSH_INTERVAL].name);
+	ck_assert_str_eq("access_log_flush_size",
+	                 config_options[ACCESS_LOG_FLUSH_SIZE].name);
 	ck_assert_str_eq("enable_directory_listing",
 	                 config_options[ENABLE_DIRECTORY_LISTING].name);
 	ck_assert_str_eq("error_log_file", config_options[ERROR_LOG_FILE].name);
@@ -987,6 +1011,10 @@ START_TEST(test_config_options)
 	                 config_options[REQUEST_TIMEOUT].name);
 	ck_assert_str_eq("keep_alive_timeout_ms",
 	                 config_options[KEEP_ALIVE_TIMEOUT].name);
+#if defined(USE_EPOLL)
+	ck_assert_str_eq("max_idle_connections",
+	                 config_options[MAX_IDLE_CONNECTIONS].name);
+#endif
 	ck_assert_str_eq("linger_timeout_ms", config_options[LINGER_TIMEOUT].name);
 	ck_assert_str_eq("max_connections", config_options[MAX_CONNECTIONS].name);
 	ck_assert_str_eq("ssl_verify_peer",
@@ -1042,6 +1070,12 @@ START_TEST(test_config_options)
 #if !defined(NO_CACHING)
 	ck_assert_str_eq("static_file_max_age",
 	                 config_options[STATIC_FILE_MAX_AGE].name);
+#if !defined(_WIN32)
+	ck_assert_str_eq("static_file_cache_entries",
+	                 config_options[STATIC_FILE_CACHE_ENTRIES].name);
+	ck_assert_str_eq("static_file_cache_ttl_ms",
+	                 config_options[STATIC_FILE_CACHE_TTL].name);
+#endif
 #endif
 #if !defined(NO_SSL)
 	ck_assert_str_eq("strict_transport_security_max_age",
@@ -1071,6 +1105,122 @@ START_TEST(test_config_options)
 END_TEST
 
 
+/* Handler search of previous versions: exact match, then "uri/..."
+ * match, then pattern match, each in list order. */
+static struct mg_handler_info *
+linear_handler_search(struct mg_handler_info *list,
+                      int handler_type,
+                      const char *uri)
+{
+	size_t urilen = strlen(uri);
+	struct mg_handler_info *rh;
+
+	for (rh = list; rh != NULL; rh = rh->next) {
+		if ((rh->handler_type == handler_type) && (urilen == rh->uri_len)
+		    && !strcmp(rh->uri, uri)) {
+			return rh;
+		}
+	}
+	for (rh = list; rh != NULL; rh = rh->next) {
+		if ((rh->handler_type == handler_type) && (rh->uri_len < urilen)
+		    && (uri[rh->uri_len] == '/')
+		    && (memcmp(rh->uri, uri, rh->uri_len) == 0)) {
+			return rh;
+		}
+	}
+	for (rh = list; rh != NULL; rh = rh->next) {
+		if ((rh->handler_type == handler_type)
+		    && (match_prefix(rh->uri, rh->uri_len, uri) > 0)) {
+			return rh;
+		}
+	}
+	return NULL;
+}
+
+
+START_TEST(test_request_handler_router)
+{
+	static const char *uris[] = {"/api/v1/devices",
+	                             "/api",
+	                             "/API/v1",
+	                             "/api/v1/devices/**.json$",
+	                             "/static",
+	                             "/Static/img",
+	                             "",
+	                             "/a?c",
+	                             "/x$",
+	                             "/other|/api/v2",
+	                             "/api/v1/dev",
+	                             "/",
+	                             "/ws",
+	                             "/api/v1"};
+	static const char *requests[] = {"/api/v1/devices",
+	                                 "/api/v1/devices/",
+	                                 "/api/v1/devices/7/state.json",
+	                                 "/api/v1/devicesx",
+	                                 "/API/V1/DEVICES",
+	                                 "/api/v1",
+	                                 "/api/v2/info",
+	                                 "/apix",
+	                                 "/static/img/a.png",
+	                                 "/Static/img/a.png",
+	                                 "/STATIC/IMG",
+	                                 "/abc",
+	                                 "/a?c",
+	                                 "/x",
+	                                 "/x$",
+	                                 "/xy",
+	                                 "/other/1",
+	                                 "/wsx",
+	                                 "/",
+	                                 "",
+	                                 "/nothing/here"};
+	struct mg_handler_info rh[sizeof(uris) / sizeof(uris[0])];
+	struct mg_router *router;
+	size_t i, j;
+	int t;
+
+	memset(rh, 0, sizeof(rh));
+	for (i = 0; i < sizeof(uris) / sizeof(uris[0]); i++) {
+		rh[i].uri = (char *)uris[i];
+		rh[i].uri_len = strlen(uris[i]);
+		rh[i].handler_type = (i % 4 == 3) ? AUTH_HANDLER : REQUEST_HANDLER;
+		rh[i].next = (i + 1 < sizeof(uris) / sizeof(uris[0])) ? &rh[i + 1]
+		                                                       : NULL;
+	}
+	rh[12].handler_type = WEBSOCKET_HANDLER;
+
+	router = router_build(NULL, rh);
+	ck_assert(router != NULL);
+
+	for (i = 0; i < sizeof(requests) / sizeof(requests[0]); i++) {
+		for (t = REQUEST_HANDLER; t <= AUTH_HANDLER; t++) {
+			ck_assert_ptr_eq(linear_handler_search(rh, t, requests[i]),
+			                 router_lookup(router,
+			                               t,
+			                               requests[i],
+			                               strlen(requests[i])));
+		}
+	}
+
+	/* Every prefix of every handler URI */
+	for (i = 0; i < sizeof(uris) / sizeof(uris[0]); i++) {
+		char buf[64];
+		for (j = 0; j <= strlen(uris[i]); j++) {
+			memcpy(buf, uris[i], j);
+			buf[j] = 0;
+			for (t = REQUEST_HANDLER; t <= AUTH_HANDLER; t++) {
+				ck_assert_ptr_eq(linear_handler_search(rh, t, buf),
+				                 router_lookup(router, t, buf, j));
+			}
+		}
+	}
+
+	router_free(router);
+}
+END_TEST
+
+
 #if !defined(REPLACE_CHECK_FOR_LOCAL_DEBUGGING)
 Suite *
 make_private_suite(void)
@@ -1093,6 +1243,7 @@ make_private_suite(void)
 	TCase *const tcase_parse_date_string = tcase_create("Date Parsing");
 	TCase *const tcase_sha1 = tcase_create("SHA1");
 	TCase *const tcase_config_options = tcase_create("Config Options");
+	TCase *const tcase_handler_router = tcase_create("Handler Router");
 
 	tcase_add_test(tcase_http_message, test_parse_http_message);
 	tcase_set_timeout(tcase_http_message, civetweb_min_test_timeout);
@@ -1159,6 +1310,10 @@ make_private_suite(void)
 	tcase_set_timeout(tcase_config_options, civetweb_min_test_timeout);
 	suite_add_tcase(suite, tcase_config_options);
 
+	tcase_add_test(tcase_handler_router, test_request_handler_router);
+	tcase_set_timeout(tcase_handler_router, civetweb_min_test_timeout);
+	suite_add_tcase(suite, tcase_handler_router);
+
 	return suite;
 }
 #endif
@@ -1183,6 +1338,7 @@ MAIN_PRIVATE(void)
 	test_parse_port_string(0);
 	test_parse_http_message(0);
 	test_sha1(0);
+	test_request_handler_router(0);
 
 #if defined(_WIN32)
 	WSACleanup();
@@ -42,6 +42,7 @@
 #define test_sleep(x) (Sleep((x)*1000))
 #else
 #include <unistd.h>
+#include <utime.h>
 #define test_sleep(x) (sleep(x))
 #endif
 
@@ -3545,6 +3546,107 @@ START_TEST(test_keep_alive)
 END_TEST
 
 
+static int
+keep_alive_idle_handler(struct mg_connection *conn, void *cbdata)
+{
+	(void)cbdata;
+
+	mg_printf(conn,
+	          "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n"
+	          "Connection: keep-alive\r\n\r\nok");
+	return 200;
+}
+
+
+/* A keep-alive connection idle after its first request is parked (in the
+ * keep-alive reactor, if there is one), the second request resumes it, and
+ * once idle for longer than keep_alive_timeout_ms the server closes it. */
+START_TEST(test_keep_alive_idle)
+{
+	struct mg_context *ctx;
+	const char *OPTIONS[] =
+	{ "listening_ports",
+	  "8081",
+	  "request_timeout_ms",
+	  "10000",
+	  "enable_keep_alive",
+	  "yes",
+	  "keep_alive_timeout_ms",
+	  "2000",
+#if defined(USE_EPOLL)
+	  "max_idle_connections",
+	  "10",
+#endif
+	  NULL };
+
+	struct mg_connection *client_conn;
+	char client_err[256];
+	char buf[8];
+	const struct mg_response_info *client_ri;
+	int client_res, i;
+#if defined(USE_EPOLL) && defined(USE_SERVER_STATS)
+	char info[2048];
+#endif
+
+	mark_point();
+
+	ctx = test_mg_start(NULL, NULL, OPTIONS);
+	ck_assert(ctx != NULL);
+	mg_set_request_handler(ctx, "/idle", keep_alive_idle_handler, NULL);
+
+	memset(client_err, 0, sizeof(client_err));
+	client_conn =
+	    mg_connect_client("127.0.0.1", 8081, 0, client_err, sizeof(client_err));
+	ck_assert_str_eq(client_err, "");
+	ck_assert(client_conn != NULL);
+
+	/* The same connection serves two requests, the second one after being
+	 * idle for a second. */
+	for (i = 0; i < 2; i++) {
+		if (i > 0) {
+			test_sleep(1);
+		}
+		mg_printf(client_conn,
+		          "GET /idle HTTP/1.1\r\nHost: "
+		          "localhost:8081\r\nConnection: keep-alive\r\n\r\n");
+		client_res =
+		    mg_get_response(client_conn, client_err, sizeof(client_err), 10000);
+		ck_assert_int_ge(client_res, 0);
+		ck_assert_str_eq(client_err, "");
+		client_ri = mg_get_response_info(client_conn);
+		ck_assert(client_ri != NULL);
+		ck_assert_int_eq(client_ri->status_code, 200);
+		memset(buf, 0, sizeof(buf));
+		client_res = (int)mg_read(client_conn, buf, sizeof(buf) - 1);
+		ck_assert_int_eq(client_res, 2);
+		ck_assert_str_eq(buf, "ok");
+	}
+
+	/* Idle for longer than the keep-alive timeout: the server closed the
+	 * connection, so there is no response to a third request. */
+	test_sleep(3);
+	mg_printf(client_conn,
+	          "GET /idle HTTP/1.1\r\nHost: "
+	          "localhost:8081\r\nConnection: keep-alive\r\n\r\n");
+	client_res =
+	    mg_get_response(client_conn, client_err, sizeof(client_err), 2000);
+	ck_assert_int_lt(client_res, 0);
+	mg_close_connection(client_conn);
+
+#if defined(USE_EPOLL) && defined(USE_SERVER_STATS)
+	/* Parked after each of the two requests, expired once. */
+	ck_assert_int_gt(mg_get_context_info(ctx, info, (int)sizeof(info)), 0);
+	ck_assert(strstr(info, "\"totalParked\" : 2") != NULL);
+	ck_assert(strstr(info, "\"expired\" : 1") != NULL);
+#endif
+
+	test_mg_stop(ctx);
+
+	mark_point();
+}
+END_TEST
+
+
 START_TEST(test_error_handling)
 {
 	struct mg_context *ctx;
@@ -4625,6 +4727,369 @@ END_TEST
 #endif
 
 
+#if !defined(NO_FILES) && !defined(NO_CACHING) && !defined(_WIN32)
+static void
+file_cache_write_file(const char *name, const char *content, size_t len)
+{
+	FILE *f = fopen(name, "wb");
+	ck_assert(f != NULL);
+	ck_assert_uint_eq(fwrite(content, 1, len, f), len);
+	fclose(f);
+}
+
+
+/* GET a file from the server started by test_static_file_cache. Returns the
+ * body length, the body is stored (zero terminated) in buf. */
+static int
+file_cache_get(const char *uri, int accept_gzip, char *buf, size_t buf_len)
+{
+	struct mg_connection *client;
+	char client_err[256];
+	const struct mg_response_info *client_ri;
+	const char *encoding = NULL;
+	int len = 0, r, i;
+
+	client = mg_download("127.0.0.1",
+	                     8080,
+	                     0,
+	                     client_err,
+	                     sizeof(client_err),
+	                     "GET /%s HTTP/1.0\r\n%s\r\n",
+	                     uri,
+	                     accept_gzip ? "Accept-Encoding: gzip\r\n" : "");
+	ck_assert(client != NULL);
+	ck_assert_str_eq(client_err, "");
+	client_ri = mg_get_response_info(client);
+	ck_assert(client_ri != NULL);
+	ck_assert_int_eq(client_ri->status_code, 200);
+
+	for (i = 0; i < client_ri->num_headers; i++) {
+		if (!mg_strcasecmp(client_ri->http_headers[i].name,
+		                   "Content-Encoding")) {
+			encoding = client_ri->http_headers[i].value;
+		}
+	}
+	if (accept_gzip == 2) {
+		/* Expect the ".gz" variant */
+		ck_assert_ptr_ne(encoding, NULL);
+		ck_assert_str_eq(encoding, "gzip");
+	} else {
+		ck_assert_ptr_eq(encoding, NULL);
+	}
+
+	while ((r = mg_read(client, buf + len, buf_len - 1 - (size_t)len)) > 0) {
+		len += r;
+	}
+	buf[len] = 0;
+	ck_assert_int_eq(len, (int)client_ri->content_length);
+	mg_close_connection(client);
+	return len;
+}
+
+
+START_TEST(test_static_file_cache)
+{
+	struct mg_context *ctx;
+	const char *OPTIONS[] = {"listening_ports",
+	                         "8080",
+	                         "document_root",
+	                         ".",
+	                         "static_file_cache_entries",
+	                         "2",
+	                         "static_file_cache_ttl_ms",
+	                         "60000",
+	                         NULL};
+	static char plain[2048], buf[4096];
+	struct stat st;
+	struct utimbuf ut;
+	int len;
+
+	mark_point();
+
+	memset(plain, 'p', sizeof(plain) - 1);
+	file_cache_write_file("fc_a.txt", "first", 5);
+	file_cache_write_file("fc_b.txt", "other", 5);
+	file_cache_write_file("fc_gz.txt", plain, sizeof(plain) - 1);
+	file_cache_write_file("fc_gz.txt.gz", "compressed", 10);
+
+	ctx = test_mg_start(NULL, NULL, OPTIONS);
+	ck_assert(ctx != NULL);
+
+	/* A modified file is opened again */
+	len = file_cache_get("fc_a.txt", 0, buf, sizeof(buf));
+	ck_assert_int_eq(len, 5);
+	ck_assert_str_eq(buf, "first");
+	file_cache_write_file("fc_a.txt", "second", 6);
+	len = file_cache_get("fc_a.txt", 0, buf, sizeof(buf));
+	ck_assert_int_eq(len, 6);
+	ck_assert_str_eq(buf, "second");
+
+	/* Same size, but a new modification time */
+	ck_assert_int_eq(stat("fc_a.txt", &st), 0);
+	file_cache_write_file("fc_a.txt", "third!", 6);
+	ut.actime = st.st_atime;
+	ut.modtime = st.st_mtime + 10;
+	ck_assert_int_eq(utime("fc_a.txt", &ut), 0);
+	len = file_cache_get("fc_a.txt", 0, buf, sizeof(buf));
+	ck_assert_int_eq(len, 6);
+	ck_assert_str_eq(buf, "third!");
+
+	/* Truncated after it has been cached */
+	ck_assert_int_eq(truncate("fc_a.txt", 0), 0);
+	len = file_cache_get("fc_a.txt", 0, buf, sizeof(buf));
+	ck_assert_int_eq(len, 0);
+
+	/* The ".gz" variant is used if the client accepts it ... */
+	len = file_cache_get("fc_gz.txt", 2, buf, sizeof(buf));
+	ck_assert_int_eq(len, 10);
+	ck_assert_str_eq(buf, "compressed");
+	len = file_cache_get("fc_gz.txt", 0, buf, sizeof(buf));
+	ck_assert_int_eq(len, (int)sizeof(plain) - 1);
+	ck_assert_str_eq(buf, plain);
+
+	/* ... and kept by the cache until the entry expires or is evicted */
+	(void)remove("fc_gz.txt.gz");
+	len = file_cache_get("fc_gz.txt", 2, buf, sizeof(buf));
+	ck_assert_int_eq(len, 10);
+	ck_assert_str_eq(buf, "compressed");
+
+	/* Two more files evict the least recently used entry (fc_gz.txt) */
+	len = file_cache_get("fc_a.txt", 0, buf, sizeof(buf));
+	ck_assert_int_eq(len, 0);
+	len = file_cache_get("fc_b.txt", 0, buf, sizeof(buf));
+	ck_assert_int_eq(len, 5);
+	ck_assert_str_eq(buf, "other");
+	len = file_cache_get("fc_gz.txt", 1, buf, sizeof(buf));
+	ck_assert_int_eq(len, (int)sizeof(plain) - 1);
+	ck_assert_str_eq(buf, plain);
+
+	test_mg_stop(ctx);
+	(void)remove("fc_a.txt");
+	(void)remove("fc_b.txt");
+	(void)remove("fc_gz.txt");
+
+	mark_point();
+}
+END_TEST
+
+#else
+
+START_TEST(test_static_file_cache)
+{
+	mark_point();
+}
+END_TEST
+
+#endif
+
+
+#if defined(USE_WEBSOCKET)
+static struct mg_websocket_group *ws_group_test_group;
+static volatile int ws_group_test_closed;
+
+
+static void
+ws_group_server_ready(struct mg_connection *conn, void *udata)
+{
+	(void)udata;
+
+	ck_assert_int_eq(mg_websocket_group_join(ws_group_test_group, conn), 0);
+
+	mg_lock_connection(conn);
+	mg_websocket_write(conn, MG_WEBSOCKET_OPCODE_TEXT, "joined", 6);
+	mg_unlock_connection(conn);
+}
+
+
+static int
+ws_group_server_data(struct mg_connection *conn,
+                     int bits,
+                     char *data,
+                     size_t data_len,
+                     void *udata)
+{
+	int r;
+
+	(void)udata;
+
+	if (((bits & 0x0f) == MG_WEBSOCKET_OPCODE_TEXT) && (data_len == 5)
+	    && !memcmp(data, "leave", 5)) {
+		r = mg_websocket_group_leave(ws_group_test_group, conn);
+		mg_lock_connection(conn);
+		mg_websocket_write(conn,
+		                   MG_WEBSOCKET_OPCODE_TEXT,
+		                   (r == 0) ? "left" : "not in group",
+		                   (r == 0) ? 4 : 12);
+		mg_unlock_connection(conn);
+	}
+	return 1;
+}
+
+
+static void
+ws_group_server_close(const struct mg_connection *conn, void *udata)
+{
+	(void)conn;
+	(void)udata;
+
+	/* Called after the connection left all groups */
+	ws_group_test_closed++;
+}
+
+
+struct ws_group_client {
+	char msg[16][16];
+	volatile int count;
+};
+
+
+static int
+ws_group_client_data(struct mg_connection *conn,
+                     int flags,
+                     char *data,
+                     size_t data_len,
+                     void *user_data)
+{
+	struct ws_group_client *client = (struct ws_group_client *)user_data;
+
+	(void)conn;
+
+	if (((flags & 0x0f) == MG_WEBSOCKET_OPCODE_TEXT) && (client->count < 16)
+	    && (data_len < sizeof(client->msg[0]))) {
+		memcpy(client->msg[client->count], data, data_len);
+		client->msg[client->count][data_len] = 0;
+		client->count++;
+	}
+	return 1;
+}
+
+
+static struct mg_connection *
+ws_group_connect(struct ws_group_client *client)
+{
+	struct mg_connection *conn;
+	char ebuf[256] = "";
+
+	memset(client, 0, sizeof(*client));
+	conn = mg_connect_websocket_client("127.0.0.1",
+	                                   8080,
+	                                   0,
+	                                   ebuf,
+	                                   sizeof(ebuf),
+	                                   "/wsgroup",
+	                                   NULL,
+	                                   ws_group_client_data,
+	                                   NULL,
+	                                   client);
+	ck_assert_str_eq(ebuf, "");
+	ck_assert(conn != NULL);
+	return conn;
+}
+
+
+/* Wait until a client received n messages, and check the last one */
+static void
+ws_group_wait(struct ws_group_client *client, int n, const char *msg)
+{
+	int i;
+
+	for (i = 0; (i < 30) && (client->count < n); i++) {
+		test_sleep(1);
+	}
+	ck_assert_int_eq(client->count, n);
+	ck_assert_str_eq(client->msg[n - 1], msg);
+}
+
+
+START_TEST(test_websocket_group)
+{
+	struct mg_context *ctx;
+	const char *OPTIONS[] = {"listening_ports", "8080", NULL};
+	static struct ws_group_client client1, client2, client3;
+	struct mg_connection *conn1, *conn2, *conn3;
+	int i, r;
+
+	mark_point();
+
+	ctx = test_mg_start(NULL, NULL, OPTIONS);
+	ck_assert(ctx != NULL);
+	ws_group_test_group = mg_websocket_group_create(ctx, 4, 4096);
+	ck_assert(ws_group_test_group != NULL);
+	mg_set_websocket_handler(ctx,
+	                         "/wsgroup",
+	                         NULL,
+	                         ws_group_server_ready,
+	                         ws_group_server_data,
+	                         ws_group_server_close,
+	                         NULL);
+
+	/* Join: both clients receive a broadcast */
+	conn1 = ws_group_connect(&client1);
+	conn2 = ws_group_connect(&client2);
+	ws_group_wait(&client1, 1, "joined");
+	ws_group_wait(&client2, 1, "joined");
+	r = mg_websocket_broadcast(ws_group_test_group,
+	                           MG_WEBSOCKET_OPCODE_TEXT,
+	                           "all",
+	                           3);
+	ck_assert_int_eq(r, 2);
+	ws_group_wait(&client1, 2, "all");
+	ws_group_wait(&client2, 2, "all");
+
+	/* Leave: only the second client receives the next broadcast */
+	mg_websocket_client_write(conn1, MG_WEBSOCKET_OPCODE_TEXT, "leave", 5);
+	ws_group_wait(&client1, 3, "left");
+	mg_websocket_client_write(conn1, MG_WEBSOCKET_OPCODE_TEXT, "leave", 5);
+	ws_group_wait(&client1, 4, "not in group");
+	r = mg_websocket_broadcast(ws_group_test_group,
+	                           MG_WEBSOCKET_OPCODE_TEXT,
+	                           "second",
+	                           6);
+	ck_assert_int_eq(r, 1);
+	ws_group_wait(&client2, 3, "second");
+	test_sleep(1);
+	ck_assert_int_eq(client1.count, 4);
+
+	/* Drop: a closed connection leaves the group by itself */
+	ws_group_test_closed = 0;
+	mg_close_connection(conn2);
+	for (i = 0; (i < 30) && !ws_group_test_closed; i++) {
+		test_sleep(1);
+	}
+	ck_assert_int_eq(ws_group_test_closed, 1);
+	r = mg_websocket_broadcast(ws_group_test_group,
+	                           MG_WEBSOCKET_OPCODE_TEXT,
+	                           "none",
+	                           4);
+	ck_assert_int_eq(r, 0);
+	test_sleep(1);
+	ck_assert_int_eq(client1.count, 4);
+
+	/* Destroy the group while a member is still connected */
+	conn3 = ws_group_connect(&client3);
+	ws_group_wait(&client3, 1, "joined");
+	mg_websocket_group_destroy(ws_group_test_group);
+	ws_group_test_group = NULL;
+	mg_close_connection(conn3);
+	mg_close_connection(conn1);
+
+	test_mg_stop(ctx);
+
+	mark_point();
+}
+END_TEST
+
+#else
+
+START_TEST(test_websocket_group)
+{
+	mark_point();
+}
+END_TEST
+
+#endif
+
+
 static void
 minimal_http_https_client_impl(const char *server,
                                uint16_t port,
@@ -4952,11 +5417,14 @@ make_public_server_suite(void)
 	TCase *const tcase_handle_form = tcase_create("Handle Form");
 	TCase *const tcase_http_auth = tcase_create("HTTP Authentication");
 	TCase *const tcase_keep_alive = tcase_create("HTTP Keep Alive");
+	TCase *const tcase_keep_alive_idle = tcase_create("HTTP Keep Alive Idle");
 	TCase *const tcase_error_handling = tcase_create("Error handling");
 	TCase *const tcase_error_log = tcase_create("Error logging");
 	TCase *const tcase_throttle = tcase_create("Limit speed");
 	TCase *const tcase_large_file = tcase_create("Large file");
 	TCase *const tcase_file_in_mem = tcase_create("File in memory");
+	TCase *const tcase_static_file_cache = tcase_create("Static file cache");
+	TCase *const tcase_websocket_group = tcase_create("Websocket groups");
 
 
 	tcase_add_test(tcase_checktestenv, test_the_test_environment);
@@ -5028,6 +5496,10 @@ make_public_server_suite(void)
 	tcase_set_timeout(tcase_keep_alive, civetweb_mid_server_test_timeout);
 	suite_add_tcase(suite, tcase_keep_alive);
 
+	tcase_add_test(tcase_keep_alive_idle, test_keep_alive_idle);
+	tcase_set_timeout(tcase_keep_alive_idle, civetweb_mid_server_test_timeout);
+	suite_add_tcase(suite, tcase_keep_alive_idle);
+
 	tcase_add_test(tcase_error_handling, test_error_handling);
 	tcase_set_timeout(tcase_error_handling, civetweb_mid_server_test_timeout);
 	suite_add_tcase(suite, tcase_error_handling);
@@ -5048,6 +5520,15 @@ make_public_server_suite(void)
 	tcase_set_timeout(tcase_file_in_mem, civetweb_mid_server_test_timeout);
 	suite_add_tcase(suite, tcase_file_in_mem);
 
+	tcase_add_test(tcase_static_file_cache, test_static_file_cache);
+	tcase_set_timeout(tcase_static_file_cache,
+	                  civetweb_mid_server_test_timeout);
+	suite_add_tcase(suite, tcase_static_file_cache);
+
+	tcase_add_test(tcase_websocket_group, test_websocket_group);
+	tcase_set_timeout(tcase_websocket_group, civetweb_mid_server_test_timeout);
+	suite_add_tcase(suite, tcase_websocket_group);
+
 	return suite;
 }
 #endif
@@ -5086,11 +5567,14 @@ MAIN_PUBLIC_SERVER(void)
 	test_handle_form(0);
 	test_http_auth(0);
 	test_keep_alive(0);
+	test_keep_alive_idle(0);
 	test_error_handling(0);
 	test_error_log_file(0);
 	test_throttle(0);
 	test_large_file(0);
 	test_file_in_memory(0);
+	test_static_file_cache(0);
+	test_websocket_group(0);
 
 	mg_exit_library();
 
@@ -0,0 +1,376 @@
+/*!
+ * \file      crypto-bench.c
+ *
+ * \brief     Measures the LoRaMacCrypto data frame throughput of the soft
+ *            secure element: uplinks secured and downlinks unsecured per
+ *            second.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2020 Semtech
+ *
+ * \endcode
+ *
+ * Usage: crypto-bench [-m messages] [-s payload size]
+ *
+ * The AES block cipher is checked against the FIPS-197 example vectors
+ * before the frames are timed.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "utilities.h"
+#include "LoRaMac.h"
+#include "LoRaMacCrypto.h"
+#include "LoRaMacSerializer.h"
+#include "secure-element.h"
+#include "aes.h"
+
+/*!
+ * Default number of frames secured and unsecured
+ */
+#define BENCH_DEFAULT_NB_MESSAGES                   200000
+
+/*!
+ * Default application payload size
+ */
+#define BENCH_DEFAULT_PAYLOAD_SIZE                  12
+
+/*!
+ * Largest application payload
+ */
+#define BENCH_MAX_PAYLOAD_SIZE                      222
+
+#define BENCH_DEV_ADDR                              0x26011234
+
+#define BENCH_APP_PORT                              2
+
+#define BENCH_FRAME_MAX_SIZE                        ( BENCH_MAX_PAYLOAD_SIZE + 13 )
+
+static uint8_t NwkSKey[16] = { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C };
+
+static uint8_t AppSKey[16] = { 0x3C, 0x4F, 0xCF, 0x09, 0x88, 0x15, 0xF7, 0xAB, 0xA6, 0xD2, 0xAE, 0x28, 0x16, 0x15, 0x7E, 0x2B };
+
+static uint32_t NbMessages = BENCH_DEFAULT_NB_MESSAGES;
+static uint8_t PayloadSize = BENCH_DEFAULT_PAYLOAD_SIZE;
+
+static uint8_t Payload[BENCH_MAX_PAYLOAD_SIZE];
+
+/*!
+ * Downlink frames, BENCH_FRAME_MAX_SIZE bytes each
+ */
+static uint8_t* Downlinks;
+static uint8_t DownlinkSize;
+
+static void* Instance;
+
+/*!
+ * FIPS-197 example vectors: Appendix B and Appendix C.1 to C.3
+ */
+static const struct
+{
+    uint8_t KeySize;
+    uint8_t Key[32];
+    uint8_t Plaintext[16];
+    uint8_t Ciphertext[16];
+} AesVectors[] =
+{
+    {
+        16,
+        { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C },
+        { 0x32, 0x43, 0xF6, 0xA8, 0x88, 0x5A, 0x30, 0x8D, 0x31, 0x31, 0x98, 0xA2, 0xE0, 0x37, 0x07, 0x34 },
+        { 0x39, 0x25, 0x84, 0x1D, 0x02, 0xDC, 0x09, 0xFB, 0xDC, 0x11, 0x85, 0x97, 0x19, 0x6A, 0x0B, 0x32 },
+    },
+    {
+        16,
+        { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F },
+        { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF },
+        { 0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30, 0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A },
+    },
+    {
+        24,
+        { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+          0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17 },
+        { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF },
+        { 0xDD, 0xA9, 0x7C, 0xA4, 0x86, 0x4C, 0xDF, 0xE0, 0x6E, 0xAF, 0x70, 0xA0, 0xEC, 0x0D, 0x71, 0x91 },
+    },
+    {
+        32,
+        { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+          0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F },
+        { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF },
+        { 0x8E, 0xA2, 0xB7, 0xCA, 0x51, 0x67, 0x45, 0xBF, 0xEA, 0xFC, 0x49, 0x90, 0x4B, 0x49, 0x60, 0x89 },
+    },
+};
+
+/*!
+ * \brief   Checks the AES implementation against the FIPS-197 vectors
+ */
+static bool CheckAesVectors( void )
+{
+    aes_context ctx;
+    uint8_t out[16];
+
+    for( uint8_t i = 0; i < sizeof( AesVectors ) / sizeof( AesVectors[0] ); i++ )
+    {
+        if( aes_set_key( AesVectors[i].Key, AesVectors[i].KeySize, &ctx ) != 0 )
+        {
+            return false;
+        }
+        aes_encrypt( AesVectors[i].Plaintext, out, &ctx );
+        if( memcmp( out, AesVectors[i].Ciphertext, sizeof( out ) ) != 0 )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool BenchInit( void )
+{
+    Version_t version = { .Fields.Major = 1, .Fields.Minor = 0, .Fields.Revision = 4 };
+
+    // Crypto and secure element contexts live in the selected instance
+    Instance = calloc( 1, LoRaMacInstanceGetSize( ) );
+    if( Instance == NULL )
+    {
+        return false;
+    }
+    LoRaMacInstanceSelect( Instance );
+
+    if( ( SecureElementInit( NULL ) != SECURE_ELEMENT_SUCCESS ) ||
+        ( LoRaMacCryptoInit( NULL ) != LORAMAC_CRYPTO_SUCCESS ) ||
+        ( LoRaMacCryptoSetLrWanVersion( version ) != LORAMAC_CRYPTO_SUCCESS ) )
+    {
+        return false;
+    }
+    // LoRaWAN 1.0.x uses the NwkSKey for all network session keys
+    LoRaMacCryptoSetKey( F_NWK_S_INT_KEY, NwkSKey );
+    LoRaMacCryptoSetKey( S_NWK_S_INT_KEY, NwkSKey );
+    LoRaMacCryptoSetKey( NWK_S_ENC_KEY, NwkSKey );
+    LoRaMacCryptoSetKey( APP_S_KEY, AppSKey );
+    return true;
+}
+
+/*!
+ * \brief   Builds a downlink as the network server would
+ */
+static bool BuildDownlink( uint32_t fCnt, uint8_t* frame )
+{
+    LoRaMacMessageData_t msg;
+    uint8_t payload[BENCH_MAX_PAYLOAD_SIZE + 16];
+    uint8_t aBlocks[BENCH_MAX_PAYLOAD_SIZE + 16];
+    uint8_t b0[16] = { 0x49 };
+    uint16_t blocksSize = ( PayloadSize + 15 ) & ~15;
+    uint32_t mic;
+
+    memset1( aBlocks, 0, blocksSize );
+    for( uint16_t i = 0; i < blocksSize; i += 16 )
+    {
+        aBlocks[i] = 0x01;
+        aBlocks[i + 5] = 1;
+        aBlocks[i + 6] = BENCH_DEV_ADDR & 0xFF;
+        aBlocks[i + 7] = ( BENCH_DEV_ADDR >> 8 ) & 0xFF;
+        aBlocks[i + 8] = ( BENCH_DEV_ADDR >> 16 ) & 0xFF;
+        aBlocks[i + 9] = ( BENCH_DEV_ADDR >> 24 ) & 0xFF;
+        aBlocks[i + 10] = fCnt & 0xFF;
+        aBlocks[i + 11] = ( fCnt >> 8 ) & 0xFF;
+        aBlocks[i + 12] = ( fCnt >> 16 ) & 0xFF;
+        aBlocks[i + 13] = ( fCnt >> 24 ) & 0xFF;
+        aBlocks[i + 15] = ( i / 16 ) + 1;
+    }
+    if( SecureElementAesEncrypt( aBlocks, blocksSize, APP_S_KEY, payload ) != SECURE_ELEMENT_SUCCESS )
+    {
+        return false;
+    }
+    for( uint16_t i = 0; i < PayloadSize; i++ )
+    {
+        payload[i] ^= Payload[i];
+    }
+
+    memset1( ( uint8_t* )&msg, 0, sizeof( msg ) );
+    msg.Buffer = frame;
+    msg.BufSize = BENCH_FRAME_MAX_SIZE;
+    msg.MHDR.Bits.MType = FRAME_TYPE_DATA_UNCONFIRMED_DOWN;
+    msg.FHDR.DevAddr = BENCH_DEV_ADDR;
+    msg.FHDR.FCnt = fCnt & 0xFFFF;
+    msg.FPort = BENCH_APP_PORT;
+    msg.FRMPayload = payload;
+    msg.FRMPayloadSize = PayloadSize;
+    if( LoRaMacSerializerData( &msg ) != LORAMAC_SERIALIZER_SUCCESS )
+    {
+        return false;
+    }
+
+    b0[5] = 1;
+    b0[6] = BENCH_DEV_ADDR & 0xFF;
+    b0[7] = ( BENCH_DEV_ADDR >> 8 ) & 0xFF;
+    b0[8] = ( BENCH_DEV_ADDR >> 16 ) & 0xFF;
+    b0[9] = ( BENCH_DEV_ADDR >> 24 ) & 0xFF;
+    b0[10] = fCnt & 0xFF;
+    b0[11] = ( fCnt >> 8 ) & 0xFF;
+    b0[12] = ( fCnt >> 16 ) & 0xFF;
+    b0[13] = ( fCnt >> 24 ) & 0xFF;
+    b0[15] = msg.BufSize - LORAMAC_MIC_FIELD_SIZE;
+    if( SecureElementComputeAesCmac( b0, frame, msg.BufSize - LORAMAC_MIC_FIELD_SIZE, S_NWK_S_INT_KEY, &mic ) != SECURE_ELEMENT_SUCCESS )
+    {
+        return false;
+    }
+    frame[msg.BufSize - 4] = mic & 0xFF;
+    frame[msg.BufSize - 3] = ( mic >> 8 ) & 0xFF;
+    frame[msg.BufSize - 2] = ( mic >> 16 ) & 0xFF;
+    frame[msg.BufSize - 1] = ( mic >> 24 ) & 0xFF;
+    DownlinkSize = msg.BufSize;
+    return true;
+}
+
+static double Seconds( const struct timespec* start, const struct timespec* end )
+{
+    return ( double )( end->tv_sec - start->tv_sec ) + ( ( double )( end->tv_nsec - start->tv_nsec ) / 1e9 );
+}
+
+/*!
+ * \brief   Secures NbMessages uplinks
+ *
+ * \retval  messages/s, 0 on error
+ */
+static double BenchSecure( void )
+{
+    LoRaMacMessageData_t msg;
+    uint8_t frame[BENCH_FRAME_MAX_SIZE];
+    uint8_t payload[BENCH_MAX_PAYLOAD_SIZE];
+    struct timespec start;
+    struct timespec end;
+
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    for( uint32_t fCnt = 1; fCnt <= NbMessages; fCnt++ )
+    {
+        memcpy1( payload, Payload, PayloadSize );
+        memset1( ( uint8_t* )&msg, 0, sizeof( msg ) );
+        msg.Buffer = frame;
+        msg.BufSize = sizeof( frame );
+        msg.MHDR.Bits.MType = FRAME_TYPE_DATA_UNCONFIRMED_UP;
+        msg.FHDR.DevAddr = BENCH_DEV_ADDR;
+        msg.FHDR.FCnt = fCnt & 0xFFFF;
+        msg.FPort = BENCH_APP_PORT;
+        msg.FRMPayload = payload;
+        msg.FRMPayloadSize = PayloadSize;
+        if( LoRaMacCryptoSecureMessage( fCnt, DR_5, 0, &msg ) != LORAMAC_CRYPTO_SUCCESS )
+        {
+            return 0;
+        }
+    }
+    clock_gettime( CLOCK_MONOTONIC, &end );
+    return NbMessages / Seconds( &start, &end );
+}
+
+/*!
+ * \brief   Unsecures NbMessages downlinks and checks the decrypted payloads
+ *
+ * \retval  messages/s, 0 on error
+ */
+static double BenchUnsecure( void )
+{
+    LoRaMacMessageData_t msg;
+    uint8_t payload[BENCH_MAX_PAYLOAD_SIZE];
+    struct timespec start;
+    struct timespec end;
+
+    for( uint32_t i = 0; i < NbMessages; i++ )
+    {
+        if( BuildDownlink( i + 1, &Downlinks[( size_t )i * BENCH_FRAME_MAX_SIZE] ) == false )
+        {
+            return 0;
+        }
+    }
+
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    for( uint32_t i = 0; i < NbMessages; i++ )
+    {
+        memset1( ( uint8_t* )&msg, 0, sizeof( msg ) );
+        msg.Buffer = &Downlinks[( size_t )i * BENCH_FRAME_MAX_SIZE];
+        msg.BufSize = DownlinkSize;
+        msg.FRMPayload = payload;
+        if( ( LoRaMacCryptoUnsecureMessage( UNICAST_DEV_ADDR, BENCH_DEV_ADDR, FCNT_DOWN, i + 1, &msg ) != LORAMAC_CRYPTO_SUCCESS ) ||
+            ( msg.FRMPayloadSize != PayloadSize ) || ( memcmp( payload, Payload, PayloadSize ) != 0 ) )
+        {
+            return 0;
+        }
+    }
+    clock_gettime( CLOCK_MONOTONIC, &end );
+    return NbMessages / Seconds( &start, &end );
+}
+
+int main( int argc, char* argv[] )
+{
+    double secureRate;
+    double unsecureRate;
+    int opt;
+
+    while( ( opt = getopt( argc, argv, "m:s:" ) ) != -1 )
+    {
+        switch( opt )
+        {
+            case 'm':
+                NbMessages = ( uint32_t )strtoul( optarg, NULL, 0 );
+                break;
+            case 's':
+                PayloadSize = ( uint8_t )MIN( strtoul( optarg, NULL, 0 ), BENCH_MAX_PAYLOAD_SIZE );
+                break;
+            default:
+                fprintf( stderr, "Usage: %s [-m messages] [-s payload size]\n", argv[0] );
+                return 1;
+        }
+    }
+    if( ( NbMessages == 0 ) || ( PayloadSize == 0 ) )
+    {
+        return 1;
+    }
+
+    Downlinks = malloc( ( size_t )NbMessages * BENCH_FRAME_MAX_SIZE );
+    if( Downlinks == NULL )
+    {
+        fprintf( stderr, "Out of memory\n" );
+        return 1;
+    }
+    for( uint16_t i = 0; i < sizeof( Payload ); i++ )
+    {
+        Payload[i] = ( uint8_t )i;
+    }
+
+    if( CheckAesVectors( ) == false )
+    {
+        free( Downlinks );
+        fprintf( stderr, "AES known answer test failed\n" );
+        return 2;
+    }
+    if( BenchInit( ) == false )
+    {
+        fprintf( stderr, "Crypto initialization failed\n" );
+        return 1;
+    }
+    secureRate = BenchSecure( );
+    unsecureRate = BenchUnsecure( );
+    free( Downlinks );
+    free( Instance );
+
+    printf( "messages           : %u, %u bytes payload\n", NbMessages, PayloadSize );
+    printf( "secure             : %.0f messages/s\n", secureRate );
+    printf( "unsecure           : %.0f messages/s\n", unsecureRate );
+
+    if( ( secureRate == 0 ) || ( unsecureRate == 0 ) )
+    {
+        fprintf( stderr, "Crypto error\n" );
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,732 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Runs N LoRaMac end-devices in one process on a shared event
+ *            loop. Every device joins and sends M unconfirmed uplinks, the
+ *            simulated network server checks every frame. Reports the
+ *            throughput of the stack.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2020 Semtech
+ *
+ * \endcode
+ *
+ * Usage: multi-device-sim [-n devices] [-u uplinks per device] [-s payload size] [-e]
+ *
+ * With -e device 0 persists its NVM contexts on every change, once with the
+ * block based nvmm module and once with the journal, and the EEPROM bytes
+ * written per uplink are reported for both.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "utilities.h"
+#include "rtc-board.h"
+#include "LoRaMac.h"
+#include "LoRaMacTest.h"
+#include "secure-element.h"
+#include "nvmm.h"
+#include "nvmm-journal.h"
+#include "sim.h"
+
+#ifndef ACTIVE_REGION
+
+#define ACTIVE_REGION LORAMAC_REGION_EU868
+
+#endif
+
+/*!
+ * Default number of simulated devices
+ */
+#define SIM_DEFAULT_NB_DEVICES                      1000
+
+/*!
+ * Default number of uplinks sent by each device after joining
+ */
+#define SIM_DEFAULT_NB_UPLINKS                      10
+
+/*!
+ * Default application payload size
+ */
+#define SIM_DEFAULT_PAYLOAD_SIZE                    12
+
+/*!
+ * Join attempts after which a device gives up
+ */
+#define SIM_MAX_JOIN_ATTEMPTS                       8
+
+/*!
+ * Datarate used for joins and uplinks, the fastest LoRa datarate of the region
+ */
+#define SIM_DATARATE                                ( ( ACTIVE_REGION == LORAMAC_REGION_US915 ) ? DR_4 : DR_5 )
+
+/*!
+ * Application port
+ */
+#define SIM_APP_PORT                                2
+
+/*!
+ * EEPROM areas of the NVM benchmark
+ */
+#define NVM_BENCH_NVMM_ADDR                         0x0000
+#define NVM_BENCH_NVMM_SIZE                         0x8000
+#define NVM_BENCH_JOURNAL_ADDR                      0x8000
+#define NVM_BENCH_JOURNAL_SIZE                      0x4000
+
+/*!
+ * Number of LoRaMac NVM context modules
+ */
+#define NVM_BENCH_NB_MODULES                        ( LORAMAC_NVMCTXMODULE_CONFIRM_QUEUE + 1 )
+
+/*!
+ * Application state of a device
+ */
+typedef enum eDeviceState
+{
+    DEVICE_STATE_JOIN,
+    DEVICE_STATE_JOINING,
+    DEVICE_STATE_SEND,
+    DEVICE_STATE_SENDING,
+    DEVICE_STATE_DONE,
+}DeviceState_t;
+
+typedef struct sDevice
+{
+    DeviceState_t State;
+    uint32_t UplinksLeft;
+    uint32_t JoinAttempts;
+    /*!
+     * Set while the device is queued for processing
+     */
+    bool Pending;
+}Device_t;
+
+typedef struct sSimStats
+{
+    uint32_t Joined;
+    uint32_t JoinFailures;
+    uint32_t Uplinks;
+    uint32_t UplinkErrors;
+    uint32_t RequestErrors;
+    uint64_t RadioEvents;
+    uint64_t TimerEvents;
+}SimStats_t;
+
+static Device_t* Devices;
+static uint32_t NbDevices = SIM_DEFAULT_NB_DEVICES;
+static uint32_t NbUplinks = SIM_DEFAULT_NB_UPLINKS;
+static uint8_t PayloadSize = SIM_DEFAULT_PAYLOAD_SIZE;
+static uint32_t DoneCount = 0;
+
+/*!
+ * LoRaMac instances of all devices
+ */
+static uint8_t* Instances;
+static size_t InstanceSize;
+
+/*!
+ * Devices waiting for LoRaMacProcess, FIFO of device indexes
+ */
+static uint32_t* PendingQueue;
+static uint32_t PendingHead = 0;
+static uint32_t PendingCount = 0;
+
+static uint8_t AppData[242];
+
+static SimStats_t Stats;
+
+/*!
+ * NVM benchmark state, only device 0 persists its contexts
+ */
+static bool NvmBenchEnabled = false;
+static uint8_t NvmBenchChanged = 0;
+static NvmmDataBlock_t NvmBenchNvmmBlocks[NVM_BENCH_NB_MODULES];
+static NvmmJournalBlock_t NvmBenchJournalBlocks[NVM_BENCH_NB_MODULES];
+static uint8_t* NvmBenchShadows[NVM_BENCH_NB_MODULES];
+static uint32_t NvmBenchInitBytes[2];
+
+static void* DeviceInstance( uint32_t id )
+{
+    return Instances + ( ( size_t )id * InstanceSize );
+}
+
+static uint32_t CurrentDeviceId( void )
+{
+    return SimDeviceId( LoRaMacInstanceGetSelected( ) );
+}
+
+static void DeviceSetPending( uint32_t id )
+{
+    if( Devices[id].Pending == false )
+    {
+        Devices[id].Pending = true;
+        PendingQueue[( PendingHead + PendingCount ) % NbDevices] = id;
+        PendingCount++;
+    }
+}
+
+static void DeviceSetDone( Device_t* dev )
+{
+    if( dev->State != DEVICE_STATE_DONE )
+    {
+        dev->State = DEVICE_STATE_DONE;
+        DoneCount++;
+    }
+}
+
+/*!
+ * \brief   MCPS-Confirm event function
+ */
+static void McpsConfirm( McpsConfirm_t *mcpsConfirm )
+{
+    Device_t* dev = &Devices[CurrentDeviceId( )];
+
+    if( mcpsConfirm->Status == LORAMAC_EVENT_INFO_STATUS_OK )
+    {
+        Stats.Uplinks++;
+    }
+    else
+    {
+        Stats.UplinkErrors++;
+    }
+    dev->UplinksLeft--;
+    if( dev->UplinksLeft > 0 )
+    {
+        dev->State = DEVICE_STATE_SEND;
+    }
+    else
+    {
+        DeviceSetDone( dev );
+    }
+}
+
+/*!
+ * \brief   MCPS-Indication event function
+ */
+static void McpsIndication( McpsIndication_t *mcpsIndication )
+{
+}
+
+/*!
+ * \brief   MLME-Confirm event function
+ */
+static void MlmeConfirm( MlmeConfirm_t *mlmeConfirm )
+{
+    Device_t* dev = &Devices[CurrentDeviceId( )];
+
+    if( mlmeConfirm->MlmeRequest != MLME_JOIN )
+    {
+        return;
+    }
+    if( mlmeConfirm->Status == LORAMAC_EVENT_INFO_STATUS_OK )
+    {
+        Stats.Joined++;
+        dev->State = ( dev->UplinksLeft > 0 ) ? DEVICE_STATE_SEND : DEVICE_STATE_DONE;
+        if( dev->State == DEVICE_STATE_DONE )
+        {
+            DoneCount++;
+        }
+    }
+    else
+    {
+        dev->State = DEVICE_STATE_JOIN;
+    }
+}
+
+/*!
+ * \brief   MLME-Indication event function
+ */
+static void MlmeIndication( MlmeIndication_t *mlmeIndication )
+{
+}
+
+/*!
+ * \brief   Queues the device whose instance raised the event
+ */
+static void OnMacProcessNotify( void )
+{
+    DeviceSetPending( CurrentDeviceId( ) );
+}
+
+/*!
+ * \brief   Records the changed contexts of device 0
+ */
+static void OnNvmContextChange( LoRaMacNvmCtxModule_t module )
+{
+    if( CurrentDeviceId( ) == 0 )
+    {
+        NvmBenchChanged |= 1 << module;
+    }
+}
+
+static LoRaMacPrimitives_t MacPrimitives =
+{
+    .MacMcpsConfirm = McpsConfirm,
+    .MacMcpsIndication = McpsIndication,
+    .MacMlmeConfirm = MlmeConfirm,
+    .MacMlmeIndication = MlmeIndication,
+};
+
+static LoRaMacCallback_t MacCallbacks =
+{
+    .GetBatteryLevel = NULL,
+    .GetTemperatureLevel = NULL,
+    .NvmContextChange = OnNvmContextChange,
+    .MacProcessNotify = OnMacProcessNotify,
+};
+
+/*!
+ * \brief   Returns the NVM contexts of the selected instance per module
+ */
+static void NvmBenchGetContexts( uint8_t* ctxs[NVM_BENCH_NB_MODULES], uint16_t sizes[NVM_BENCH_NB_MODULES] )
+{
+    MibRequestConfirm_t mibReq;
+    LoRaMacCtxs_t* contexts;
+
+    mibReq.Type = MIB_NVM_CTXS;
+    LoRaMacMibGetRequestConfirm( &mibReq );
+    contexts = mibReq.Param.Contexts;
+
+    ctxs[LORAMAC_NVMCTXMODULE_MAC] = contexts->MacNvmCtx;
+    sizes[LORAMAC_NVMCTXMODULE_MAC] = contexts->MacNvmCtxSize;
+    ctxs[LORAMAC_NVMCTXMODULE_REGION] = contexts->RegionNvmCtx;
+    sizes[LORAMAC_NVMCTXMODULE_REGION] = contexts->RegionNvmCtxSize;
+    ctxs[LORAMAC_NVMCTXMODULE_CRYPTO] = contexts->CryptoNvmCtx;
+    sizes[LORAMAC_NVMCTXMODULE_CRYPTO] = contexts->CryptoNvmCtxSize;
+    ctxs[LORAMAC_NVMCTXMODULE_SECURE_ELEMENT] = contexts->SecureElementNvmCtx;
+    sizes[LORAMAC_NVMCTXMODULE_SECURE_ELEMENT] = contexts->SecureElementNvmCtxSize;
+    ctxs[LORAMAC_NVMCTXMODULE_COMMANDS] = contexts->CommandsNvmCtx;
+    sizes[LORAMAC_NVMCTXMODULE_COMMANDS] = contexts->CommandsNvmCtxSize;
+    ctxs[LORAMAC_NVMCTXMODULE_CLASS_B] = contexts->ClassBNvmCtx;
+    sizes[LORAMAC_NVMCTXMODULE_CLASS_B] = contexts->ClassBNvmCtxSize;
+    ctxs[LORAMAC_NVMCTXMODULE_CONFIRM_QUEUE] = contexts->ConfirmQueueNvmCtx;
+    sizes[LORAMAC_NVMCTXMODULE_CONFIRM_QUEUE] = contexts->ConfirmQueueNvmCtxSize;
+}
+
+/*!
+ * \brief   The crypto context holds the frame counters, which must never be
+ *          restored to an older value
+ */
+static bool NvmBenchWriteThrough( uint8_t module )
+{
+    return module == LORAMAC_NVMCTXMODULE_CRYPTO;
+}
+
+/*!
+ * \brief   Declares the context blocks of device 0 in both NVM modules.
+ *          Device 0 must be selected.
+ */
+static bool NvmBenchInit( void )
+{
+    uint8_t* ctxs[NVM_BENCH_NB_MODULES];
+    uint16_t sizes[NVM_BENCH_NB_MODULES];
+    uint32_t maxWrites;
+
+    NvmBenchGetContexts( ctxs, sizes );
+    if( NvmmJournalInit( NVM_BENCH_JOURNAL_ADDR, NVM_BENCH_JOURNAL_SIZE ) != NVMM_JOURNAL_SUCCESS )
+    {
+        return false;
+    }
+    for( uint8_t i = 0; i < NVM_BENCH_NB_MODULES; i++ )
+    {
+        if( sizes[i] == 0 )
+        {
+            continue;
+        }
+        NvmmDeclare( &NvmBenchNvmmBlocks[i], sizes[i] );
+        NvmBenchShadows[i] = malloc( sizes[i] );
+        if( ( NvmBenchShadows[i] == NULL ) ||
+            ( NvmmJournalDeclare( &NvmBenchJournalBlocks[i], i, NvmBenchShadows[i], sizes[i],
+                                  NvmBenchWriteThrough( i ) ) != NVMM_JOURNAL_SUCCESS ) )
+        {
+            return false;
+        }
+    }
+    if( NvmmJournalRecover( ) != NVMM_JOURNAL_SUCCESS )
+    {
+        return false;
+    }
+    SimEepromGetWear( NVM_BENCH_NVMM_ADDR, NVM_BENCH_NVMM_SIZE, &NvmBenchInitBytes[0], &maxWrites );
+    SimEepromGetWear( NVM_BENCH_JOURNAL_ADDR, NVM_BENCH_JOURNAL_SIZE, &NvmBenchInitBytes[1], &maxWrites );
+    return true;
+}
+
+/*!
+ * \brief   Stores the changed contexts of device 0 in both NVM modules.
+ *          Device 0 must be selected.
+ */
+static void NvmBenchPersist( void )
+{
+    uint8_t* ctxs[NVM_BENCH_NB_MODULES];
+    uint16_t sizes[NVM_BENCH_NB_MODULES];
+
+    NvmBenchGetContexts( ctxs, sizes );
+    for( uint8_t i = 0; i < NVM_BENCH_NB_MODULES; i++ )
+    {
+        if( ( ( NvmBenchChanged & ( 1 << i ) ) != 0 ) && ( sizes[i] != 0 ) )
+        {
+            NvmmWrite( &NvmBenchNvmmBlocks[i], ctxs[i], sizes[i] );
+            NvmmJournalWrite( &NvmBenchJournalBlocks[i], ctxs[i], sizes[i] );
+        }
+    }
+    NvmBenchChanged = 0;
+    NvmmJournalProcess( );
+}
+
+/*!
+ * \brief   Flushes the journal, reports the EEPROM wear and checks that the
+ *          journal restores the current contexts of device 0
+ */
+static bool NvmBenchReport( void )
+{
+    uint8_t* ctxs[NVM_BENCH_NB_MODULES];
+    uint16_t sizes[NVM_BENCH_NB_MODULES];
+    NvmmJournalBlock_t blocks[NVM_BENCH_NB_MODULES];
+    NvmmJournalStats_t journalStats;
+    uint32_t bytes[2];
+    uint32_t maxWrites[2];
+    uint32_t uplinks = MAX( NbUplinks, 1 );
+    bool restored = true;
+    bool writtenThrough = true;
+
+    LoRaMacInstanceSelect( DeviceInstance( 0 ) );
+
+    // Write through blocks are stored without waiting for a flush
+    NvmBenchGetContexts( ctxs, sizes );
+    for( uint8_t i = 0; i < NVM_BENCH_NB_MODULES; i++ )
+    {
+        if( ( sizes[i] != 0 ) && ( NvmBenchWriteThrough( i ) == true ) &&
+            ( memcmp( NvmBenchJournalBlocks[i].Shadow, ctxs[i], sizes[i] ) != 0 ) )
+        {
+            writtenThrough = false;
+        }
+    }
+
+    NvmmJournalFlush( );
+    NvmmJournalGetStats( &journalStats );
+    SimEepromGetWear( NVM_BENCH_NVMM_ADDR, NVM_BENCH_NVMM_SIZE, &bytes[0], &maxWrites[0] );
+    SimEepromGetWear( NVM_BENCH_JOURNAL_ADDR, NVM_BENCH_JOURNAL_SIZE, &bytes[1], &maxWrites[1] );
+    bytes[0] -= NvmBenchInitBytes[0];
+    bytes[1] -= NvmBenchInitBytes[1];
+
+    // Some context changes are not notified, store all contexts like a
+    // shutdown would before checking the restored copies
+    for( uint8_t i = 0; i < NVM_BENCH_NB_MODULES; i++ )
+    {
+        if( sizes[i] != 0 )
+        {
+            NvmmJournalWrite( &NvmBenchJournalBlocks[i], ctxs[i], sizes[i] );
+        }
+    }
+    NvmmJournalFlush( );
+
+    // Reboot the journal on fresh copies
+    NvmmJournalInit( NVM_BENCH_JOURNAL_ADDR, NVM_BENCH_JOURNAL_SIZE );
+    for( uint8_t i = 0; i < NVM_BENCH_NB_MODULES; i++ )
+    {
+        if( sizes[i] != 0 )
+        {
+            memset1( NvmBenchShadows[i], 0, sizes[i] );
+            NvmmJournalDeclare( &blocks[i], i, NvmBenchShadows[i], sizes[i], NvmBenchWriteThrough( i ) );
+        }
+    }
+    NvmmJournalRecover( );
+    for( uint8_t i = 0; i < NVM_BENCH_NB_MODULES; i++ )
+    {
+        if( ( sizes[i] != 0 ) && ( blocks[i].Stored == true ) &&
+            ( memcmp( blocks[i].Shadow, ctxs[i], sizes[i] ) != 0 ) )
+        {
+            restored = false;
+        }
+        free( NvmBenchShadows[i] );
+    }
+
+    printf( "nvm, device 0      : %u uplinks\n", NbUplinks );
+    printf( "  nvmm             : %u bytes written, %u per uplink, %u writes on the most worn byte\n",
+            bytes[0], bytes[0] / uplinks, maxWrites[0] );
+    printf( "  journal          : %u bytes written, %u per uplink, %u writes on the most worn byte\n",
+            bytes[1], bytes[1] / uplinks, maxWrites[1] );
+    printf( "                     %u records, %u flushes, %u compactions, recovery %s\n",
+            journalStats.Records, journalStats.Flushes, journalStats.Compactions, ( restored == true ) ? "ok" : "MISMATCH" );
+    printf( "                     frame counters written through: %s\n", ( writtenThrough == true ) ? "ok" : "MISMATCH" );
+    return restored && writtenThrough;
+}
+
+static bool DeviceInit( uint32_t id )
+{
+    MibRequestConfirm_t mibReq;
+    uint8_t devEui[SE_EUI_SIZE] = { 0 };
+    uint8_t key[16];
+
+    LoRaMacInstanceSelect( DeviceInstance( id ) );
+    if( LoRaMacInitialization( &MacPrimitives, &MacCallbacks, ACTIVE_REGION ) != LORAMAC_STATUS_OK )
+    {
+        return false;
+    }
+
+    SimDeviceCredentials( id, devEui, key );
+
+    mibReq.Type = MIB_APP_KEY;
+    mibReq.Param.AppKey = key;
+    LoRaMacMibSetRequestConfirm( &mibReq );
+
+    mibReq.Type = MIB_NWK_KEY;
+    mibReq.Param.NwkKey = key;
+    LoRaMacMibSetRequestConfirm( &mibReq );
+
+    mibReq.Type = MIB_DEV_EUI;
+    mibReq.Param.DevEui = devEui;
+    LoRaMacMibSetRequestConfirm( &mibReq );
+
+    mibReq.Type = MIB_JOIN_EUI;
+    mibReq.Param.JoinEui = ( uint8_t* )SimJoinEui( );
+    LoRaMacMibSetRequestConfirm( &mibReq );
+
+    mibReq.Type = MIB_PUBLIC_NETWORK;
+    mibReq.Param.EnablePublicNetwork = true;
+    LoRaMacMibSetRequestConfirm( &mibReq );
+
+    mibReq.Type = MIB_ADR;
+    mibReq.Param.AdrEnable = false;
+    LoRaMacMibSetRequestConfirm( &mibReq );
+
+    LoRaMacTestSetDutyCycleOn( false );
+    LoRaMacStart( );
+
+    if( ( id == 0 ) && ( NvmBenchEnabled == true ) && ( NvmBenchInit( ) == false ) )
+    {
+        return false;
+    }
+
+    Devices[id].State = DEVICE_STATE_JOIN;
+    Devices[id].UplinksLeft = NbUplinks;
+    DeviceSetPending( id );
+    return true;
+}
+
+static void DeviceProcess( uint32_t id )
+{
+    Device_t* dev = &Devices[id];
+    LoRaMacStatus_t status;
+
+    LoRaMacInstanceSelect( DeviceInstance( id ) );
+    LoRaMacProcess( );
+
+    if( ( id == 0 ) && ( NvmBenchEnabled == true ) )
+    {
+        NvmBenchPersist( );
+    }
+
+    switch( dev->State )
+    {
+        case DEVICE_STATE_JOIN:
+        {
+            MlmeReq_t mlmeReq;
+
+            if( dev->JoinAttempts >= SIM_MAX_JOIN_ATTEMPTS )
+            {
+                Stats.JoinFailures++;
+                DeviceSetDone( dev );
+                break;
+            }
+            mlmeReq.Type = MLME_JOIN;
+            mlmeReq.Req.Join.Datarate = SIM_DATARATE;
+            status = LoRaMacMlmeRequest( &mlmeReq );
+            if( status == LORAMAC_STATUS_OK )
+            {
+                dev->JoinAttempts++;
+                dev->State = DEVICE_STATE_JOINING;
+            }
+            else if( status != LORAMAC_STATUS_BUSY )
+            {
+                Stats.RequestErrors++;
+                DeviceSetDone( dev );
+            }
+            break;
+        }
+        case DEVICE_STATE_SEND:
+        {
+            McpsReq_t mcpsReq;
+
+            mcpsReq.Type = MCPS_UNCONFIRMED;
+            mcpsReq.Req.Unconfirmed.fPort = SIM_APP_PORT;
+            mcpsReq.Req.Unconfirmed.fBuffer = AppData;
+            mcpsReq.Req.Unconfirmed.fBufferSize = PayloadSize;
+            mcpsReq.Req.Unconfirmed.Datarate = SIM_DATARATE;
+            status = LoRaMacMcpsRequest( &mcpsReq );
+            if( status == LORAMAC_STATUS_OK )
+            {
+                dev->State = DEVICE_STATE_SENDING;
+            }
+            else if( status != LORAMAC_STATUS_BUSY )
+            {
+                Stats.RequestErrors++;
+                DeviceSetDone( dev );
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+
+/*!
+ * \brief   Runs the event loop until every device is done or no event is
+ *          left.
+ */
+static void SimRun( void )
+{
+    while( true )
+    {
+        TimerTime_t radioTime;
+        TimerTime_t alarmTime;
+
+        while( PendingCount > 0 )
+        {
+            uint32_t id = PendingQueue[PendingHead];
+
+            PendingHead = ( PendingHead + 1 ) % NbDevices;
+            PendingCount--;
+            Devices[id].Pending = false;
+            DeviceProcess( id );
+        }
+        if( DoneCount == NbDevices )
+        {
+            break;
+        }
+
+        radioTime = SimRadioGetNextEventTime( );
+        alarmTime = SimClockGetAlarm( );
+        if( ( radioTime == SIM_TIME_NONE ) && ( alarmTime == SIM_TIME_NONE ) )
+        {
+            break;
+        }
+        if( alarmTime <= radioTime )
+        {
+            SimClockAdvance( MAX( alarmTime, SimClockGetTime( ) ) );
+            Stats.TimerEvents++;
+        }
+        else
+        {
+            SimClockAdvance( MAX( radioTime, SimClockGetTime( ) ) );
+            SimRadioProcessNextEvent( );
+            Stats.RadioEvents++;
+        }
+    }
+}
+
+static double Seconds( const struct timespec* start, const struct timespec* end )
+{
+    return ( double )( end->tv_sec - start->tv_sec ) + ( ( double )( end->tv_nsec - start->tv_nsec ) / 1e9 );
+}
+
+int main( int argc, char* argv[] )
+{
+    const SimServerStats_t* server;
+    struct timespec start;
+    struct timespec end;
+    bool nvmRestored = true;
+    double wall;
+    int opt;
+
+    while( ( opt = getopt( argc, argv, "n:u:s:e" ) ) != -1 )
+    {
+        switch( opt )
+        {
+            case 'n':
+                NbDevices = ( uint32_t )strtoul( optarg, NULL, 0 );
+                break;
+            case 'u':
+                NbUplinks = ( uint32_t )strtoul( optarg, NULL, 0 );
+                break;
+            case 'e':
+                NvmBenchEnabled = true;
+                break;
+            case 's':
+                PayloadSize = ( uint8_t )MIN( strtoul( optarg, NULL, 0 ), 51 );
+                break;
+            default:
+                fprintf( stderr, "Usage: %s [-n devices] [-u uplinks per device] [-s payload size] [-e]\n", argv[0] );
+                return 1;
+        }
+    }
+    if( NbDevices == 0 )
+    {
+        return 1;
+    }
+
+    InstanceSize = LoRaMacInstanceGetSize( );
+    Instances = calloc( NbDevices, InstanceSize );
+    Devices = calloc( NbDevices, sizeof( Device_t ) );
+    PendingQueue = calloc( NbDevices, sizeof( uint32_t ) );
+    if( ( Instances == NULL ) || ( Devices == NULL ) || ( PendingQueue == NULL ) ||
+        ( SimRadioInit( NbDevices, Instances, InstanceSize ) == false ) )
+    {
+        fprintf( stderr, "Out of memory\n" );
+        return 1;
+    }
+    for( uint32_t i = 0; i < sizeof( AppData ); i++ )
+    {
+        AppData[i] = ( uint8_t )i;
+    }
+
+    RtcInit( );
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    for( uint32_t id = 0; id < NbDevices; id++ )
+    {
+        if( DeviceInit( id ) == false )
+        {
+            fprintf( stderr, "Device %u: LoRaMacInitialization failed\n", id );
+            return 1;
+        }
+    }
+    SimRun( );
+    clock_gettime( CLOCK_MONOTONIC, &end );
+    wall = Seconds( &start, &end );
+    server = SimServerGetStats( );
+
+    printf( "devices            : %u\n", NbDevices );
+    printf( "uplinks per device : %u\n", NbUplinks );
+    printf( "instance size      : %u bytes\n", ( unsigned )InstanceSize );
+    printf( "joined             : %u (failed %u)\n", Stats.Joined, Stats.JoinFailures );
+    printf( "uplinks            : %u (errors %u, rejected requests %u)\n", Stats.Uplinks, Stats.UplinkErrors, Stats.RequestErrors );
+    printf( "network server     : %u join requests, %u join accepts, %u uplinks, %u errors\n",
+            server->JoinRequests, server->JoinAccepts, server->Uplinks, server->Errors );
+    printf( "events             : %llu radio, %llu timer\n",
+            ( unsigned long long )Stats.RadioEvents, ( unsigned long long )Stats.TimerEvents );
+    printf( "virtual time       : %.1f s\n", SimClockGetTime( ) / 1000.0 );
+    printf( "wall time          : %.3f s\n", wall );
+    printf( "throughput         : %.0f frames/s (%.0f uplinks/s)\n",
+            ( server->JoinRequests + server->Uplinks ) / wall, server->Uplinks / wall );
+
+    if( NvmBenchEnabled == true )
+    {
+        nvmRestored = NvmBenchReport( );
+    }
+
+    SimRadioDeInit( );
+    free( PendingQueue );
+    free( Devices );
+    free( Instances );
+
+    if( ( DoneCount != NbDevices ) || ( Stats.Joined != NbDevices ) || ( nvmRestored == false ) ||
+        ( server->Uplinks != ( NbDevices * NbUplinks ) ) )
+    {
+        fprintf( stderr, "Simulation incomplete: %u of %u devices done\n", DoneCount, NbDevices );
+        return 2;
+    }
+    return 0;
+}
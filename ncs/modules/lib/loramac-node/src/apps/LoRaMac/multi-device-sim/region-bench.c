@@ -0,0 +1,196 @@
+/*!
+ * \file      region-bench.c
+ *
+ * \brief     Measures the RegionNextChannel calls per second of the regions
+ *            built in the simulation, with all channels and with a single
+ *            sub-band enabled.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2020 Semtech
+ *
+ * \endcode
+ *
+ * Usage: region-bench [-c calls]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "utilities.h"
+#include "LoRaMac.h"
+#include "Region.h"
+
+/*!
+ * Default number of RegionNextChannel calls per configuration
+ */
+#define BENCH_DEFAULT_NB_CALLS                      1000000
+
+/*!
+ * Largest channels mask of the regions, in 16 bit words
+ */
+#define BENCH_CHANNELS_MASK_SIZE                    6
+
+/*!
+ * Largest number of channels of the regions
+ */
+#define BENCH_MAX_NB_CHANNELS                       ( BENCH_CHANNELS_MASK_SIZE * 16 )
+
+/*!
+ * Channel selection configuration
+ */
+typedef struct sBenchConfig
+{
+    const char* Name;
+    LoRaMacRegion_t Region;
+    int8_t Datarate;
+    /*!
+     * Channels mask applied with RegionChanMaskSet, all zero to keep the
+     * region default
+     */
+    uint16_t ChannelsMask[BENCH_CHANNELS_MASK_SIZE];
+}BenchConfig_t;
+
+static const BenchConfig_t Configs[] =
+{
+    { "EU868 default", LORAMAC_REGION_EU868, DR_5, { 0 } },
+    { "US915 all", LORAMAC_REGION_US915, DR_0, { 0 } },
+    { "US915 sub-band 2", LORAMAC_REGION_US915, DR_0, { 0xFF00, 0x0000, 0x0000, 0x0000, 0x0002, 0x0000 } },
+    { "AU915 all", LORAMAC_REGION_AU915, DR_2, { 0 } },
+    { "AU915 sub-band 2", LORAMAC_REGION_AU915, DR_2, { 0xFF00, 0x0000, 0x0000, 0x0000, 0x0002, 0x0000 } },
+    { "CN470 all", LORAMAC_REGION_CN470, DR_5, { 0 } },
+    { "CN470 sub-band 12", LORAMAC_REGION_CN470, DR_5, { 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFF00 } },
+};
+
+static uint32_t NbCalls = BENCH_DEFAULT_NB_CALLS;
+
+static double Seconds( const struct timespec* start, const struct timespec* end )
+{
+    return ( double )( end->tv_sec - start->tv_sec ) + ( ( double )( end->tv_nsec - start->tv_nsec ) / 1e9 );
+}
+
+/*!
+ * \brief   Runs NbCalls channel selections and checks that only the enabled
+ *          channels are selected, each of them at least once
+ *
+ * \param   [IN] config Channel selection configuration
+ * \param   [OUT] nbChannels Number of channels selected
+ *
+ * \retval  calls/s, 0 on error
+ */
+static double BenchRegion( const BenchConfig_t* config, uint8_t* nbChannels )
+{
+    InitDefaultsParams_t initDefaults = { .NvmCtx = NULL, .Type = INIT_TYPE_INIT };
+    NextChanParams_t nextChan = { .AggrTimeOff = 0, .LastAggrTx = 0, .Datarate = config->Datarate, .Joined = true, .DutyCycleEnabled = false };
+    GetPhyParams_t getPhy = { .Attribute = PHY_CHANNELS_MASK };
+    uint16_t channelsMask[BENCH_CHANNELS_MASK_SIZE];
+    uint32_t selected[BENCH_MAX_NB_CHANNELS] = { 0 };
+    struct timespec start;
+    struct timespec end;
+    TimerTime_t time;
+    TimerTime_t aggregatedTimeOff;
+    uint8_t channel;
+
+    RegionInitDefaults( config->Region, &initDefaults );
+    for( uint8_t i = 0; i < BENCH_CHANNELS_MASK_SIZE; i++ )
+    {
+        if( config->ChannelsMask[i] != 0 )
+        {
+            ChanMaskSetParams_t chanMaskSet = { .ChannelsMaskIn = ( uint16_t* )config->ChannelsMask, .ChannelsMaskType = CHANNELS_MASK };
+
+            RegionChanMaskSet( config->Region, &chanMaskSet );
+            break;
+        }
+    }
+    memcpy1( ( uint8_t* )channelsMask, ( uint8_t* )RegionGetPhyParam( config->Region, &getPhy ).ChannelsMask, sizeof( channelsMask ) );
+
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    for( uint32_t i = 0; i < NbCalls; i++ )
+    {
+        if( RegionNextChannel( config->Region, &nextChan, &channel, &time, &aggregatedTimeOff ) != LORAMAC_STATUS_OK )
+        {
+            return 0;
+        }
+        selected[channel]++;
+    }
+    clock_gettime( CLOCK_MONOTONIC, &end );
+
+    *nbChannels = 0;
+    for( uint8_t i = 0; i < BENCH_MAX_NB_CHANNELS; i++ )
+    {
+        bool enabled = ( channelsMask[i / 16] & ( 1 << ( i % 16 ) ) ) != 0;
+
+        if( ( selected[i] != 0 ) && ( enabled == false ) )
+        {
+            return 0;
+        }
+        if( selected[i] != 0 )
+        {
+            ( *nbChannels )++;
+        }
+    }
+    return NbCalls / Seconds( &start, &end );
+}
+
+int main( int argc, char* argv[] )
+{
+    void* instance;
+    int opt;
+    int status = 0;
+
+    while( ( opt = getopt( argc, argv, "c:" ) ) != -1 )
+    {
+        switch( opt )
+        {
+            case 'c':
+                NbCalls = ( uint32_t )strtoul( optarg, NULL, 0 );
+                break;
+            default:
+                fprintf( stderr, "Usage: %s [-c calls]\n", argv[0] );
+                return 1;
+        }
+    }
+    if( NbCalls == 0 )
+    {
+        return 1;
+    }
+
+    // The region contexts live in the selected instance
+    instance = calloc( 1, LoRaMacInstanceGetSize( ) );
+    if( instance == NULL )
+    {
+        fprintf( stderr, "Out of memory\n" );
+        return 1;
+    }
+    LoRaMacInstanceSelect( instance );
+    srand1( 1 );
+
+    printf( "calls              : %u per configuration\n", NbCalls );
+    for( uint8_t i = 0; i < ( sizeof( Configs ) / sizeof( Configs[0] ) ); i++ )
+    {
+        uint8_t nbChannels = 0;
+        double rate = 0;
+
+        if( RegionIsActive( Configs[i].Region ) == true )
+        {
+            rate = BenchRegion( &Configs[i], &nbChannels );
+        }
+        if( rate == 0 )
+        {
+            printf( "%-18s : error\n", Configs[i].Name );
+            status = 2;
+            continue;
+        }
+        printf( "%-18s : %.0f calls/s, %u channels used\n", Configs[i].Name, rate, nbChannels );
+    }
+    free( instance );
+    return status;
+}
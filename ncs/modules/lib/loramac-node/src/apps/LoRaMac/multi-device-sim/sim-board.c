@@ -0,0 +1,236 @@
+/*!
+ * \file      sim-board.c
+ *
+ * \brief     Board and RTC port running on a virtual clock
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2020 Semtech
+ *
+ * \endcode
+ */
+#include <stdlib.h>
+#include "utilities.h"
+#include "timer.h"
+#include "rtc-board.h"
+#include "eeprom-board.h"
+#include "sim.h"
+
+/*!
+ * One RTC tick is one millisecond of virtual time
+ */
+#define RTC_MIN_TIMEOUT                             1
+
+/*!
+ * Virtual time
+ */
+static TimerTime_t Now = 0;
+
+/*!
+ * Timer reference, see RtcSetTimerContext
+ */
+static uint32_t TimerContext = 0;
+
+/*!
+ * Alarm expiry time
+ */
+static TimerTime_t AlarmTime = SIM_TIME_NONE;
+
+/*!
+ * Backup registers
+ */
+static uint32_t BkupData0 = 0;
+static uint32_t BkupData1 = 0;
+
+/*!
+ * EEPROM content and number of writes of every byte
+ */
+static uint8_t Eeprom[SIM_EEPROM_SIZE];
+static uint32_t EepromWrites[SIM_EEPROM_SIZE];
+
+TimerTime_t SimClockGetTime( void )
+{
+    return Now;
+}
+
+TimerTime_t SimClockGetAlarm( void )
+{
+    return AlarmTime;
+}
+
+void SimClockAdvance( TimerTime_t time )
+{
+    Now = time;
+    if( ( AlarmTime != SIM_TIME_NONE ) && ( AlarmTime <= Now ) )
+    {
+        AlarmTime = SIM_TIME_NONE;
+        TimerIrqHandler( );
+    }
+}
+
+void SimEepromGetWear( uint16_t addr, uint32_t size, uint32_t* bytesWritten, uint32_t* maxWrites )
+{
+    *bytesWritten = 0;
+    *maxWrites = 0;
+    for( uint32_t i = addr; ( i < ( ( uint32_t )addr + size ) ) && ( i < SIM_EEPROM_SIZE ); i++ )
+    {
+        *bytesWritten += EepromWrites[i];
+        *maxWrites = MAX( *maxWrites, EepromWrites[i] );
+    }
+}
+
+void BoardCriticalSectionBegin( uint32_t *mask )
+{
+    *mask = 0;
+}
+
+void BoardCriticalSectionEnd( uint32_t *mask )
+{
+    ( void )mask;
+}
+
+uint32_t BoardGetRandomSeed( void )
+{
+    return ( uint32_t )rand( );
+}
+
+void RtcInit( void )
+{
+    Now = 0;
+    TimerContext = 0;
+    AlarmTime = SIM_TIME_NONE;
+}
+
+uint32_t RtcGetMinimumTimeout( void )
+{
+    return RTC_MIN_TIMEOUT;
+}
+
+uint32_t RtcMs2Tick( TimerTime_t milliseconds )
+{
+    return milliseconds;
+}
+
+TimerTime_t RtcTick2Ms( uint32_t tick )
+{
+    return tick;
+}
+
+void RtcDelayMs( TimerTime_t milliseconds )
+{
+    ( void )milliseconds;
+}
+
+void RtcSetMcuWakeUpTime( void )
+{
+}
+
+int16_t RtcGetMcuWakeUpTime( void )
+{
+    return 0;
+}
+
+void RtcSetAlarm( uint32_t timeout )
+{
+    RtcStartAlarm( timeout );
+}
+
+void RtcStopAlarm( void )
+{
+    AlarmTime = SIM_TIME_NONE;
+}
+
+void RtcStartAlarm( uint32_t timeout )
+{
+    AlarmTime = TimerContext + timeout;
+}
+
+uint32_t RtcSetTimerContext( void )
+{
+    TimerContext = Now;
+    return TimerContext;
+}
+
+uint32_t RtcGetTimerContext( void )
+{
+    return TimerContext;
+}
+
+uint32_t RtcGetCalendarTime( uint16_t *milliseconds )
+{
+    *milliseconds = Now % 1000;
+    return Now / 1000;
+}
+
+uint32_t RtcGetTimerValue( void )
+{
+    return Now;
+}
+
+uint32_t RtcGetTimerElapsedTime( void )
+{
+    return Now - TimerContext;
+}
+
+void RtcBkupWrite( uint32_t data0, uint32_t data1 )
+{
+    BkupData0 = data0;
+    BkupData1 = data1;
+}
+
+void RtcBkupRead( uint32_t* data0, uint32_t* data1 )
+{
+    *data0 = BkupData0;
+    *data1 = BkupData1;
+}
+
+void RtcProcess( void )
+{
+}
+
+TimerTime_t RtcTempCompensation( TimerTime_t period, float temperature )
+{
+    ( void )temperature;
+    return period;
+}
+
+uint8_t EepromMcuWriteBuffer( uint16_t addr, uint8_t *buffer, uint16_t size )
+{
+    if( ( ( uint32_t )addr + size ) > SIM_EEPROM_SIZE )
+    {
+        return FAIL;
+    }
+    for( uint16_t i = 0; i < size; i++ )
+    {
+        Eeprom[addr + i] = buffer[i];
+        EepromWrites[addr + i]++;
+    }
+    return SUCCESS;
+}
+
+uint8_t EepromMcuReadBuffer( uint16_t addr, uint8_t *buffer, uint16_t size )
+{
+    if( ( ( uint32_t )addr + size ) > SIM_EEPROM_SIZE )
+    {
+        return FAIL;
+    }
+    memcpy1( buffer, &Eeprom[addr], size );
+    return SUCCESS;
+}
+
+void EepromMcuSetDeviceAddr( uint8_t addr )
+{
+    ( void )addr;
+}
+
+uint8_t EepromMcuGetDeviceAddr( void )
+{
+    return 0;
+}
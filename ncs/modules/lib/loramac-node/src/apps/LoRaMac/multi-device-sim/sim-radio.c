@@ -0,0 +1,797 @@
+/*!
+ * \file      sim-radio.c
+ *
+ * \brief     Simulated radios of all end-devices and a minimal LoRaWAN 1.0.x
+ *            network server answering join requests and checking uplinks.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2020 Semtech
+ *
+ * \endcode
+ *
+ * \remark    The channel is ideal: every uplink reaches the network server
+ *            and every downlink reaches its device in the first receive
+ *            window. Frequencies are ignored.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "utilities.h"
+#include "radio.h"
+#include "aes.h"
+#include "cmac.h"
+#include "LoRaMac.h"
+#include "LoRaMacHeaderTypes.h"
+#include "secure-element.h"
+#include "sim.h"
+
+/*!
+ * Maximum LoRa frame size
+ */
+#define SIM_FRAME_MAX_SIZE                          255
+
+/*!
+ * Signal quality reported for every received downlink
+ */
+#define SIM_RX_RSSI                                 -60
+#define SIM_RX_SNR                                  10
+
+/*!
+ * Sizes of the handled LoRaWAN frames
+ */
+#define JOIN_REQUEST_SIZE                           23
+#define JOIN_ACCEPT_SIZE                            17
+#define UPLINK_MIN_SIZE                             12
+
+/*!
+ * Radio event scheduled for a device
+ */
+typedef enum eSimRadioEvent
+{
+    SIM_RADIO_EVENT_NONE = 0,
+    SIM_RADIO_EVENT_TX_DONE,
+    SIM_RADIO_EVENT_RX_DONE,
+    SIM_RADIO_EVENT_RX_TIMEOUT,
+}SimRadioEvent_t;
+
+/*!
+ * Modem parameters given by SetTxConfig/SetRxConfig
+ */
+typedef struct sSimModemConfig
+{
+    RadioModems_t Modem;
+    uint32_t Bandwidth;
+    uint32_t Datarate;
+    uint8_t Coderate;
+    uint16_t PreambleLen;
+    uint16_t SymbTimeout;
+    bool FixLen;
+    bool CrcOn;
+    bool RxContinuous;
+}SimModemConfig_t;
+
+/*!
+ * Radio and network server session of one end-device
+ */
+typedef struct sSimDevice
+{
+    /*!
+     * Radio callbacks given by the LoRaMac instance
+     */
+    RadioEvents_t* Events;
+    RadioState_t State;
+    SimModemConfig_t TxConfig;
+    SimModemConfig_t RxConfig;
+    /*!
+     * Pending radio event. Only the heap entry carrying EventSeq is valid.
+     */
+    SimRadioEvent_t Event;
+    uint32_t EventSeq;
+    uint8_t TxBuffer[SIM_FRAME_MAX_SIZE];
+    uint8_t TxSize;
+    uint8_t RxBuffer[SIM_FRAME_MAX_SIZE];
+    uint8_t RxSize;
+    /*!
+     * Downlink queued by the network server for the next receive window
+     */
+    uint8_t Downlink[SIM_FRAME_MAX_SIZE];
+    uint8_t DownlinkSize;
+    /*!
+     * Network server session
+     */
+    bool Joined;
+    uint32_t JoinNonce;
+    uint8_t NwkSKey[16];
+}SimDevice_t;
+
+/*!
+ * Entry of the radio event queue
+ */
+typedef struct sSimEvent
+{
+    TimerTime_t Time;
+    uint32_t Seq;
+    uint32_t Id;
+}SimEvent_t;
+
+static SimDevice_t* Devices = NULL;
+static uint32_t NbDevices = 0;
+static uint8_t* Instances = NULL;
+static size_t InstanceSize = 0;
+
+/*!
+ * Radio events of all devices, min-heap ordered by time
+ */
+static SimEvent_t* EventHeap = NULL;
+static size_t EventCount = 0;
+static size_t EventCapacity = 0;
+static uint32_t EventSeq = 0;
+
+static SimServerStats_t ServerStats;
+
+/*!
+ * Join EUI shared by all devices
+ */
+/*!
+ * The secure element copies SE_EUI_SIZE bytes, the EUI itself is 8 bytes
+ */
+static const uint8_t JoinEui[SE_EUI_SIZE] = { 0x70, 0xB3, 0xD5, 0x7E, 0xD0, 0x00, 0x00, 0x00 };
+
+static bool EventBefore( const SimEvent_t* a, const SimEvent_t* b )
+{
+    return ( a->Time < b->Time ) || ( ( a->Time == b->Time ) && ( a->Seq < b->Seq ) );
+}
+
+static bool EventPush( SimEvent_t event )
+{
+    size_t i;
+
+    if( EventCount == EventCapacity )
+    {
+        size_t capacity = ( EventCapacity == 0 ) ? 1024 : ( EventCapacity * 2 );
+        SimEvent_t* heap = realloc( EventHeap, capacity * sizeof( SimEvent_t ) );
+
+        if( heap == NULL )
+        {
+            return false;
+        }
+        EventHeap = heap;
+        EventCapacity = capacity;
+    }
+
+    i = EventCount++;
+    while( i > 0 )
+    {
+        size_t parent = ( i - 1 ) / 2;
+
+        if( EventBefore( &EventHeap[parent], &event ) == true )
+        {
+            break;
+        }
+        EventHeap[i] = EventHeap[parent];
+        i = parent;
+    }
+    EventHeap[i] = event;
+    return true;
+}
+
+static void EventPop( void )
+{
+    SimEvent_t last = EventHeap[--EventCount];
+    size_t i = 0;
+
+    while( true )
+    {
+        size_t child = ( 2 * i ) + 1;
+
+        if( child >= EventCount )
+        {
+            break;
+        }
+        if( ( ( child + 1 ) < EventCount ) && ( EventBefore( &EventHeap[child + 1], &EventHeap[child] ) == true ) )
+        {
+            child++;
+        }
+        if( EventBefore( &last, &EventHeap[child] ) == true )
+        {
+            break;
+        }
+        EventHeap[i] = EventHeap[child];
+        i = child;
+    }
+    if( EventCount > 0 )
+    {
+        EventHeap[i] = last;
+    }
+}
+
+static uint32_t DeviceIndex( SimDevice_t* dev )
+{
+    return ( uint32_t )( dev - Devices );
+}
+
+/*!
+ * Returns the device of the selected LoRaMac instance. The radio is only
+ * ever driven by the instance being processed.
+ */
+static SimDevice_t* CurrentDevice( void )
+{
+    return &Devices[SimDeviceId( LoRaMacInstanceGetSelected( ) )];
+}
+
+static void ScheduleEvent( SimDevice_t* dev, SimRadioEvent_t event, TimerTime_t delay )
+{
+    SimEvent_t entry;
+
+    dev->Event = event;
+    dev->EventSeq = ++EventSeq;
+
+    entry.Time = SimClockGetTime( ) + delay;
+    entry.Seq = dev->EventSeq;
+    entry.Id = DeviceIndex( dev );
+    if( EventPush( entry ) == false )
+    {
+        abort( );
+    }
+}
+
+static void CancelEvent( SimDevice_t* dev )
+{
+    dev->Event = SIM_RADIO_EVENT_NONE;
+    dev->EventSeq = 0;
+}
+
+static double SymbolTime( const SimModemConfig_t* cfg )
+{
+    if( cfg->Modem == MODEM_FSK )
+    {
+        // One byte
+        return 8000.0 / ( double )cfg->Datarate;
+    }
+    return ( double )( 1 << cfg->Datarate ) * 1000.0 / ( double )( 125000 << cfg->Bandwidth );
+}
+
+static uint32_t ComputeTimeOnAir( const SimModemConfig_t* cfg, uint8_t pktLen )
+{
+    double tSym = SymbolTime( cfg );
+    double toa;
+
+    if( cfg->Modem == MODEM_FSK )
+    {
+        // Preamble, sync word, length, payload and CRC
+        toa = ( cfg->PreambleLen + 3 + 1 + pktLen + ( ( cfg->CrcOn == true ) ? 2 : 0 ) ) * tSym;
+    }
+    else
+    {
+        int32_t sf = ( int32_t )cfg->Datarate;
+        int32_t de = ( tSym > 16.0 ) ? 1 : 0;
+        int32_t num = ( 8 * pktLen ) - ( 4 * sf ) + 28 + ( ( cfg->CrcOn == true ) ? 16 : 0 ) - ( ( cfg->FixLen == true ) ? 20 : 0 );
+        double nPayload = 8 + MAX( ceil( ( double )num / ( 4 * ( sf - ( 2 * de ) ) ) ) * ( cfg->Coderate + 4 ), 0 );
+
+        toa = ( cfg->PreambleLen + 4.25 + nPayload ) * tSym;
+    }
+    return ( uint32_t )ceil( toa );
+}
+
+static void ComputeMic( const uint8_t* key, const uint8_t* b0, const uint8_t* buffer, uint16_t size, uint8_t* mic )
+{
+    AES_CMAC_CTX cmacCtx;
+    uint8_t cmac[AES_CMAC_DIGEST_LENGTH];
+
+    AES_CMAC_Init( &cmacCtx );
+    AES_CMAC_SetKey( &cmacCtx, key );
+    if( b0 != NULL )
+    {
+        AES_CMAC_Update( &cmacCtx, b0, 16 );
+    }
+    AES_CMAC_Update( &cmacCtx, buffer, size );
+    AES_CMAC_Final( cmac, &cmacCtx );
+    memcpy1( mic, cmac, 4 );
+}
+
+/*!
+ * Answers a join request with a LoRaWAN 1.0.x join accept for the first
+ * receive window and derives the network session key.
+ */
+static void ServerHandleJoinRequest( const uint8_t* frame, uint8_t size )
+{
+    uint8_t devEui[8];
+    uint8_t key[16];
+    uint8_t mic[4];
+    uint8_t block[16] = { 0 };
+    aes_context aesCtx;
+    uint32_t id;
+    uint32_t devAddr;
+    SimDevice_t* dev;
+
+    if( size != JOIN_REQUEST_SIZE )
+    {
+        ServerStats.Errors++;
+        return;
+    }
+    // DevEUI is sent LSB first, the low 4 bytes hold the device index
+    id = ( uint32_t )frame[9] | ( ( uint32_t )frame[10] << 8 ) |
+         ( ( uint32_t )frame[11] << 16 ) | ( ( uint32_t )frame[12] << 24 );
+    if( id >= NbDevices )
+    {
+        ServerStats.Errors++;
+        return;
+    }
+    SimDeviceCredentials( id, devEui, key );
+    ComputeMic( key, NULL, frame, JOIN_REQUEST_SIZE - 4, mic );
+    if( memcmp( mic, &frame[JOIN_REQUEST_SIZE - 4], 4 ) != 0 )
+    {
+        ServerStats.Errors++;
+        return;
+    }
+    ServerStats.JoinRequests++;
+
+    dev = &Devices[id];
+    dev->JoinNonce++;
+    devAddr = id + 1;
+
+    // MHDR | JoinNonce | NetID | DevAddr | DLSettings | RxDelay | MIC
+    dev->Downlink[0] = FRAME_TYPE_JOIN_ACCEPT << 5;
+    dev->Downlink[1] = dev->JoinNonce & 0xFF;
+    dev->Downlink[2] = ( dev->JoinNonce >> 8 ) & 0xFF;
+    dev->Downlink[3] = ( dev->JoinNonce >> 16 ) & 0xFF;
+    dev->Downlink[4] = 0;
+    dev->Downlink[5] = 0;
+    dev->Downlink[6] = 0;
+    dev->Downlink[7] = devAddr & 0xFF;
+    dev->Downlink[8] = ( devAddr >> 8 ) & 0xFF;
+    dev->Downlink[9] = ( devAddr >> 16 ) & 0xFF;
+    dev->Downlink[10] = ( devAddr >> 24 ) & 0xFF;
+    dev->Downlink[11] = 0;
+    dev->Downlink[12] = 1;
+    ComputeMic( key, NULL, dev->Downlink, JOIN_ACCEPT_SIZE - 4, &dev->Downlink[JOIN_ACCEPT_SIZE - 4] );
+
+    // The network encrypts with AES decrypt, so that the device only needs AES encrypt
+    aes_set_key( key, 16, &aesCtx );
+    memcpy1( block, &dev->Downlink[1], 16 );
+    aes_decrypt( block, &dev->Downlink[1], &aesCtx );
+    dev->DownlinkSize = JOIN_ACCEPT_SIZE;
+
+    // NwkSKey = aes128_encrypt( NwkKey, 0x01 | JoinNonce | NetID | DevNonce | pad16 )
+    memset1( block, 0, sizeof( block ) );
+    block[0] = 0x01;
+    block[1] = dev->JoinNonce & 0xFF;
+    block[2] = ( dev->JoinNonce >> 8 ) & 0xFF;
+    block[3] = ( dev->JoinNonce >> 16 ) & 0xFF;
+    block[7] = frame[17];
+    block[8] = frame[18];
+    aes_encrypt( block, dev->NwkSKey, &aesCtx );
+    dev->Joined = true;
+
+    ServerStats.JoinAccepts++;
+}
+
+/*!
+ * Checks the MIC of a LoRaWAN 1.0.x data uplink
+ */
+static void ServerHandleUplink( const uint8_t* frame, uint8_t size )
+{
+    uint8_t b0[16] = { 0 };
+    uint8_t mic[4];
+    uint32_t devAddr;
+    uint32_t id;
+
+    if( size < UPLINK_MIN_SIZE )
+    {
+        ServerStats.Errors++;
+        return;
+    }
+    devAddr = ( uint32_t )frame[1] | ( ( uint32_t )frame[2] << 8 ) |
+              ( ( uint32_t )frame[3] << 16 ) | ( ( uint32_t )frame[4] << 24 );
+    id = devAddr - 1;
+    if( ( id >= NbDevices ) || ( Devices[id].Joined == false ) )
+    {
+        ServerStats.Errors++;
+        return;
+    }
+
+    // B0 = 0x49 | 4 x 0x00 | Dir | DevAddr | FCnt | 0x00 | len
+    b0[0] = 0x49;
+    memcpy1( &b0[6], &frame[1], 4 );
+    b0[10] = frame[6];
+    b0[11] = frame[7];
+    b0[15] = size - 4;
+    ComputeMic( Devices[id].NwkSKey, b0, frame, size - 4, mic );
+    if( memcmp( mic, &frame[size - 4], 4 ) != 0 )
+    {
+        ServerStats.Errors++;
+        return;
+    }
+    ServerStats.Uplinks++;
+}
+
+static void ServerReceive( const uint8_t* frame, uint8_t size )
+{
+    if( size == 0 )
+    {
+        return;
+    }
+    switch( frame[0] >> 5 )
+    {
+        case FRAME_TYPE_JOIN_REQ:
+        {
+            ServerHandleJoinRequest( frame, size );
+            break;
+        }
+        case FRAME_TYPE_DATA_UNCONFIRMED_UP:
+        case FRAME_TYPE_DATA_CONFIRMED_UP:
+        {
+            ServerHandleUplink( frame, size );
+            break;
+        }
+        default:
+        {
+            ServerStats.Errors++;
+            break;
+        }
+    }
+}
+
+/*
+ * Radio driver
+ */
+
+static void SimRadioInitEvents( RadioEvents_t *events )
+{
+    SimDevice_t* dev = CurrentDevice( );
+
+    dev->Events = events;
+    dev->State = RF_IDLE;
+    CancelEvent( dev );
+}
+
+static RadioState_t SimRadioGetStatus( void )
+{
+    return CurrentDevice( )->State;
+}
+
+static void SimRadioSetModem( RadioModems_t modem )
+{
+    SimDevice_t* dev = CurrentDevice( );
+
+    dev->TxConfig.Modem = modem;
+    dev->RxConfig.Modem = modem;
+}
+
+static void SimRadioSetChannel( uint32_t freq )
+{
+    ( void )freq;
+}
+
+static bool SimRadioIsChannelFree( RadioModems_t modem, uint32_t freq, int16_t rssiThresh, uint32_t maxCarrierSenseTime )
+{
+    return true;
+}
+
+static uint32_t SimRadioRandom( void )
+{
+    return ( uint32_t )rand( );
+}
+
+static void SimRadioSetRxConfig( RadioModems_t modem, uint32_t bandwidth,
+                                 uint32_t datarate, uint8_t coderate,
+                                 uint32_t bandwidthAfc, uint16_t preambleLen,
+                                 uint16_t symbTimeout, bool fixLen,
+                                 uint8_t payloadLen,
+                                 bool crcOn, bool freqHopOn, uint8_t hopPeriod,
+                                 bool iqInverted, bool rxContinuous )
+{
+    SimModemConfig_t* cfg = &CurrentDevice( )->RxConfig;
+
+    cfg->Modem = modem;
+    cfg->Bandwidth = bandwidth;
+    cfg->Datarate = datarate;
+    cfg->Coderate = coderate;
+    cfg->PreambleLen = preambleLen;
+    cfg->SymbTimeout = symbTimeout;
+    cfg->FixLen = fixLen;
+    cfg->CrcOn = crcOn;
+    cfg->RxContinuous = rxContinuous;
+}
+
+static void SimRadioSetTxConfig( RadioModems_t modem, int8_t power, uint32_t fdev,
+                                 uint32_t bandwidth, uint32_t datarate,
+                                 uint8_t coderate, uint16_t preambleLen,
+                                 bool fixLen, bool crcOn, bool freqHopOn,
+                                 uint8_t hopPeriod, bool iqInverted, uint32_t timeout )
+{
+    SimModemConfig_t* cfg = &CurrentDevice( )->TxConfig;
+
+    cfg->Modem = modem;
+    cfg->Bandwidth = bandwidth;
+    cfg->Datarate = datarate;
+    cfg->Coderate = coderate;
+    cfg->PreambleLen = preambleLen;
+    cfg->FixLen = fixLen;
+    cfg->CrcOn = crcOn;
+}
+
+static bool SimRadioCheckRfFrequency( uint32_t frequency )
+{
+    return true;
+}
+
+static uint32_t SimRadioTimeOnAir( RadioModems_t modem, uint8_t pktLen )
+{
+    return ComputeTimeOnAir( &CurrentDevice( )->TxConfig, pktLen );
+}
+
+static void SimRadioSend( uint8_t *buffer, uint8_t size )
+{
+    SimDevice_t* dev = CurrentDevice( );
+
+    memcpy1( dev->TxBuffer, buffer, size );
+    dev->TxSize = size;
+    dev->State = RF_TX_RUNNING;
+    ScheduleEvent( dev, SIM_RADIO_EVENT_TX_DONE, ComputeTimeOnAir( &dev->TxConfig, size ) );
+}
+
+static void SimRadioSleep( void )
+{
+    SimDevice_t* dev = CurrentDevice( );
+
+    // An ongoing transmission still completes
+    if( dev->State == RF_RX_RUNNING )
+    {
+        CancelEvent( dev );
+    }
+    if( dev->State != RF_TX_RUNNING )
+    {
+        dev->State = RF_IDLE;
+    }
+}
+
+static void SimRadioRx( uint32_t timeout )
+{
+    SimDevice_t* dev = CurrentDevice( );
+    const SimModemConfig_t* cfg = &dev->RxConfig;
+
+    dev->State = RF_RX_RUNNING;
+    if( dev->DownlinkSize != 0 )
+    {
+        memcpy1( dev->RxBuffer, dev->Downlink, dev->DownlinkSize );
+        dev->RxSize = dev->DownlinkSize;
+        dev->DownlinkSize = 0;
+        ScheduleEvent( dev, SIM_RADIO_EVENT_RX_DONE, ComputeTimeOnAir( cfg, dev->RxSize ) );
+    }
+    else if( cfg->RxContinuous == false )
+    {
+        uint32_t window = ( uint32_t )ceil( cfg->SymbTimeout * SymbolTime( cfg ) );
+
+        if( ( timeout != 0 ) && ( timeout < window ) )
+        {
+            window = timeout;
+        }
+        ScheduleEvent( dev, SIM_RADIO_EVENT_RX_TIMEOUT, MAX( window, 1 ) );
+    }
+    else
+    {
+        CancelEvent( dev );
+    }
+}
+
+static void SimRadioStartCad( void )
+{
+}
+
+static void SimRadioSetTxContinuousWave( uint32_t freq, int8_t power, uint16_t time )
+{
+    SimDevice_t* dev = CurrentDevice( );
+
+    dev->TxSize = 0;
+    dev->State = RF_TX_RUNNING;
+    ScheduleEvent( dev, SIM_RADIO_EVENT_TX_DONE, ( TimerTime_t )time * 1000 );
+}
+
+static int16_t SimRadioRssi( RadioModems_t modem )
+{
+    return SIM_RX_RSSI;
+}
+
+static void SimRadioWrite( uint16_t addr, uint8_t data )
+{
+}
+
+static uint8_t SimRadioRead( uint16_t addr )
+{
+    return 0;
+}
+
+static void SimRadioWriteBuffer( uint16_t addr, uint8_t *buffer, uint8_t size )
+{
+}
+
+static void SimRadioReadBuffer( uint16_t addr, uint8_t *buffer, uint8_t size )
+{
+}
+
+static void SimRadioSetMaxPayloadLength( RadioModems_t modem, uint8_t max )
+{
+}
+
+static void SimRadioSetPublicNetwork( bool enable )
+{
+}
+
+static uint32_t SimRadioGetWakeupTime( void )
+{
+    return 1;
+}
+
+static void SimRadioIrqProcess( void )
+{
+}
+
+static void SimRadioSetRxDutyCycle( uint32_t rxTime, uint32_t sleepTime )
+{
+}
+
+const struct Radio_s Radio =
+{
+    .Init = SimRadioInitEvents,
+    .GetStatus = SimRadioGetStatus,
+    .SetModem = SimRadioSetModem,
+    .SetChannel = SimRadioSetChannel,
+    .IsChannelFree = SimRadioIsChannelFree,
+    .Random = SimRadioRandom,
+    .SetRxConfig = SimRadioSetRxConfig,
+    .SetTxConfig = SimRadioSetTxConfig,
+    .CheckRfFrequency = SimRadioCheckRfFrequency,
+    .TimeOnAir = SimRadioTimeOnAir,
+    .Send = SimRadioSend,
+    .Sleep = SimRadioSleep,
+    .Standby = SimRadioSleep,
+    .Rx = SimRadioRx,
+    .StartCad = SimRadioStartCad,
+    .SetTxContinuousWave = SimRadioSetTxContinuousWave,
+    .Rssi = SimRadioRssi,
+    .Write = SimRadioWrite,
+    .Read = SimRadioRead,
+    .WriteBuffer = SimRadioWriteBuffer,
+    .ReadBuffer = SimRadioReadBuffer,
+    .SetMaxPayloadLength = SimRadioSetMaxPayloadLength,
+    .SetPublicNetwork = SimRadioSetPublicNetwork,
+    .GetWakeupTime = SimRadioGetWakeupTime,
+    .IrqProcess = SimRadioIrqProcess,
+    .RxBoosted = SimRadioRx,
+    .SetRxDutyCycle = SimRadioSetRxDutyCycle,
+};
+
+/*
+ * Simulation interface
+ */
+
+bool SimRadioInit( uint32_t nbDevices, uint8_t* instances, size_t instanceSize )
+{
+    Devices = calloc( nbDevices, sizeof( SimDevice_t ) );
+    if( Devices == NULL )
+    {
+        return false;
+    }
+    NbDevices = nbDevices;
+    Instances = instances;
+    InstanceSize = instanceSize;
+    memset1( ( uint8_t* )&ServerStats, 0, sizeof( ServerStats ) );
+    return true;
+}
+
+void SimRadioDeInit( void )
+{
+    free( Devices );
+    free( EventHeap );
+    Devices = NULL;
+    EventHeap = NULL;
+    EventCount = 0;
+    EventCapacity = 0;
+    NbDevices = 0;
+}
+
+uint32_t SimDeviceId( void* instance )
+{
+    return ( uint32_t )( ( ( uint8_t* )instance - Instances ) / InstanceSize );
+}
+
+void SimDeviceCredentials( uint32_t id, uint8_t devEui[8], uint8_t key[16] )
+{
+    devEui[0] = 0x00;
+    devEui[1] = 0x11;
+    devEui[2] = 0x22;
+    devEui[3] = 0x33;
+    devEui[4] = ( id >> 24 ) & 0xFF;
+    devEui[5] = ( id >> 16 ) & 0xFF;
+    devEui[6] = ( id >> 8 ) & 0xFF;
+    devEui[7] = id & 0xFF;
+
+    for( uint8_t i = 0; i < 16; i++ )
+    {
+        key[i] = ( uint8_t )( ( 0x2B + ( i * 0x11 ) ) ^ ( id >> ( 8 * ( i & 0x03 ) ) ) );
+    }
+}
+
+const uint8_t* SimJoinEui( void )
+{
+    return JoinEui;
+}
+
+TimerTime_t SimRadioGetNextEventTime( void )
+{
+    // Drop the entries of cancelled or replaced events
+    while( ( EventCount > 0 ) && ( Devices[EventHeap[0].Id].EventSeq != EventHeap[0].Seq ) )
+    {
+        EventPop( );
+    }
+    if( EventCount == 0 )
+    {
+        return SIM_TIME_NONE;
+    }
+    return EventHeap[0].Time;
+}
+
+void SimRadioProcessNextEvent( void )
+{
+    SimDevice_t* dev;
+    SimRadioEvent_t event;
+
+    if( SimRadioGetNextEventTime( ) == SIM_TIME_NONE )
+    {
+        return;
+    }
+    dev = &Devices[EventHeap[0].Id];
+    EventPop( );
+
+    event = dev->Event;
+    CancelEvent( dev );
+    dev->State = RF_IDLE;
+
+    LoRaMacInstanceSelect( Instances + ( ( size_t )DeviceIndex( dev ) * InstanceSize ) );
+    switch( event )
+    {
+        case SIM_RADIO_EVENT_TX_DONE:
+        {
+            ServerReceive( dev->TxBuffer, dev->TxSize );
+            if( ( dev->Events != NULL ) && ( dev->Events->TxDone != NULL ) )
+            {
+                dev->Events->TxDone( );
+            }
+            break;
+        }
+        case SIM_RADIO_EVENT_RX_DONE:
+        {
+            if( ( dev->Events != NULL ) && ( dev->Events->RxDone != NULL ) )
+            {
+                dev->Events->RxDone( dev->RxBuffer, dev->RxSize, SIM_RX_RSSI, SIM_RX_SNR );
+            }
+            break;
+        }
+        case SIM_RADIO_EVENT_RX_TIMEOUT:
+        {
+            if( ( dev->Events != NULL ) && ( dev->Events->RxTimeout != NULL ) )
+            {
+                dev->Events->RxTimeout( );
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+
+const SimServerStats_t* SimServerGetStats( void )
+{
+    return &ServerStats;
+}
@@ -0,0 +1,174 @@
+/*!
+ * \file      sim.h
+ *
+ * \brief     Host simulation of many LoRaMac end-devices sharing one process
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2020 Semtech
+ *
+ * \endcode
+ */
+#ifndef __SIM_H__
+#define __SIM_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "timer.h"
+
+/*!
+ * Value returned when no event is scheduled
+ */
+#define SIM_TIME_NONE                               UINT32_MAX
+
+/*!
+ * Network server statistics
+ */
+typedef struct sSimServerStats
+{
+    /*!
+     * Join requests received with a valid MIC
+     */
+    uint32_t JoinRequests;
+    /*!
+     * Join accepts sent
+     */
+    uint32_t JoinAccepts;
+    /*!
+     * Data uplinks received with a valid MIC
+     */
+    uint32_t Uplinks;
+    /*!
+     * Frames dropped because of an unknown device or a wrong MIC
+     */
+    uint32_t Errors;
+}SimServerStats_t;
+
+/*
+ * ============================================================================
+ * Virtual clock and EEPROM (sim-board.c)
+ * ============================================================================
+ */
+
+/*!
+ * \brief Returns the current virtual time
+ *
+ * \retval now Virtual time in milliseconds
+ */
+TimerTime_t SimClockGetTime( void );
+
+/*!
+ * \brief Returns the virtual time at which the RTC alarm expires
+ *
+ * \retval time Alarm time in milliseconds, SIM_TIME_NONE if not armed
+ */
+TimerTime_t SimClockGetAlarm( void );
+
+/*!
+ * \brief Advances the virtual time. Runs the timer IRQ handler if the RTC
+ *        alarm is reached.
+ *
+ * \param [IN] time Virtual time to advance to. Must not be in the past.
+ */
+void SimClockAdvance( TimerTime_t time );
+
+/*!
+ * Size of the simulated EEPROM
+ */
+#define SIM_EEPROM_SIZE                             0x10000
+
+/*!
+ * \brief Returns the wear of a simulated EEPROM area
+ *
+ * \param [IN]  addr         Area start address
+ * \param [IN]  size         Area size
+ * \param [OUT] bytesWritten Bytes written to the area
+ * \param [OUT] maxWrites    Highest number of writes of a single byte
+ */
+void SimEepromGetWear( uint16_t addr, uint32_t size, uint32_t* bytesWritten, uint32_t* maxWrites );
+
+/*
+ * ============================================================================
+ * Radio and network server (sim-radio.c)
+ * ============================================================================
+ */
+
+/*!
+ * \brief Initializes the simulated radios and the network server
+ *
+ * \param [IN] nbDevices    Number of end-devices
+ * \param [IN] instances    Memory holding the LoRaMac instances of all devices
+ * \param [IN] instanceSize Size of one instance, see LoRaMacInstanceGetSize
+ *
+ * \retval status true on success, false if out of memory
+ */
+bool SimRadioInit( uint32_t nbDevices, uint8_t* instances, size_t instanceSize );
+
+/*!
+ * \brief Frees the simulated radios
+ */
+void SimRadioDeInit( void );
+
+/*!
+ * \brief Returns the index of the device running the given LoRaMac instance
+ *
+ * \param [IN] instance LoRaMac instance, see LoRaMacInstanceGetSelected
+ *
+ * \retval id Device index
+ */
+uint32_t SimDeviceId( void* instance );
+
+/*!
+ * \brief Returns the credentials the network server knows a device by
+ *
+ * \param [IN]  id     Device index
+ * \param [OUT] devEui Device EUI
+ * \param [OUT] key    Root key, used as AppKey and NwkKey
+ */
+void SimDeviceCredentials( uint32_t id, uint8_t devEui[8], uint8_t key[16] );
+
+/*!
+ * \brief Returns the join EUI shared by all devices
+ *
+ * \retval joinEui Join EUI
+ */
+const uint8_t* SimJoinEui( void );
+
+/*!
+ * \brief Returns the virtual time of the next radio event
+ *
+ * \retval time Event time in milliseconds, SIM_TIME_NONE if none is pending
+ */
+TimerTime_t SimRadioGetNextEventTime( void );
+
+/*!
+ * \brief Delivers the next radio event to its device. The virtual time must
+ *        have been advanced to the event time.
+ */
+void SimRadioProcessNextEvent( void );
+
+/*!
+ * \brief Returns the network server statistics
+ *
+ * \retval stats Statistics
+ */
+const SimServerStats_t* SimServerGetStats( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SIM_H__
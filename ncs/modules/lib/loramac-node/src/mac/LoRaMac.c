@@ -340,23 +340,6 @@ typedef struct sLoRaMacCtx
     LoRaMacNvmCtx_t* NvmCtx;
 }LoRaMacCtx_t;
 
-/*
- * Module context.
- */
-static LoRaMacCtx_t MacCtx;
-
-/*
- * Non-volatile module context.
- */
-static LoRaMacNvmCtx_t NvmMacCtx;
-
-
-
-/*
- * List of module contexts.
- */
-LoRaMacCtxs_t Contexts;
-
 /*!
  * Defines the LoRaMac radio events status
  */
@@ -373,10 +356,104 @@ typedef union uLoRaMacRadioEvents
     }Events;
 }LoRaMacRadioEvents_t;
 
+/*!
+ * Structure used to store the radio Tx event data
+ */
+typedef struct sLoRaMacTxDoneParams
+{
+    TimerTime_t CurTime;
+}LoRaMacTxDoneParams_t;
+
+/*!
+ * Structure used to store the radio Rx event data
+ */
+typedef struct sLoRaMacRxDoneParams
+{
+    TimerTime_t LastRxDone;
+    uint8_t *Payload;
+    uint16_t Size;
+    int16_t Rssi;
+    int8_t Snr;
+}LoRaMacRxDoneParams_t;
+
+/*!
+ * LoRaMac state of one end-device. An instance memory block starts with this
+ * structure and is followed by the instance contexts of the sub modules, see
+ * LoRaMacInstanceSelect.
+ */
+typedef struct sLoRaMacInstanceCtx
+{
+    /*
+     * Module context.
+     */
+    LoRaMacCtx_t MacCtx;
+    /*
+     * Non-volatile module context.
+     */
+    LoRaMacNvmCtx_t NvmMacCtx;
+    /*
+     * List of module contexts.
+     */
+    LoRaMacCtxs_t Contexts;
+    /*
+     * LoRaMac radio events status
+     */
+    LoRaMacRadioEvents_t RadioEvents;
+    /*
+     * Radio Tx event data
+     */
+    LoRaMacTxDoneParams_t TxDoneParams;
+    /*
+     * Radio Rx event data
+     */
+    LoRaMacRxDoneParams_t RxDoneParams;
+}LoRaMacInstanceCtx_t;
+
+/*!
+ * Rounds the size of each part of an instance memory block up, so that every
+ * sub module context is suitably aligned.
+ */
+#define LORAMAC_INSTANCE_ALIGN( size )              ( ( ( size ) + 7 ) & ~( ( size_t )7 ) )
+
+/*
+ * State of the default instance, used until LoRaMacInstanceSelect is called.
+ */
+static LoRaMacInstanceCtx_t DefaultInstanceCtx;
+
+/*
+ * Selected instance memory block. NULL for the default instance.
+ */
+static void* SelectedInstance = NULL;
+
+/*
+ * Module context.
+ */
+static LoRaMacCtx_t* MacCtx = &DefaultInstanceCtx.MacCtx;
+
+/*
+ * Non-volatile module context.
+ */
+static LoRaMacNvmCtx_t* NvmMacCtx = &DefaultInstanceCtx.NvmMacCtx;
+
+/*
+ * List of module contexts.
+ */
+static LoRaMacCtxs_t* Contexts = &DefaultInstanceCtx.Contexts;
+
 /*!
  * LoRaMac radio events status
  */
-LoRaMacRadioEvents_t LoRaMacRadioEvents = { .Value = 0 };
+static LoRaMacRadioEvents_t* LoRaMacRadioEvents = &DefaultInstanceCtx.RadioEvents;
+
+/*!
+ * Radio Tx event data
+ */
+static LoRaMacTxDoneParams_t* TxDoneParams = &DefaultInstanceCtx.TxDoneParams;
+
+/*!
+ * Radio Rx event data
+ */
+static LoRaMacRxDoneParams_t* RxDoneParams = &DefaultInstanceCtx.RxDoneParams;
 
 /*!
  * \brief Function to be executed on Radio Tx Done event
@@ -770,94 +847,74 @@ static void LoRaMacHandleRequestEvents( void );
  */
 static void LoRaMacHandleIndicationEvents( void );
 
-/*!
- * Structure used to store the radio Tx event data
- */
-struct
-{
-    TimerTime_t CurTime;
-}TxDoneParams;
-
-/*!
- * Structure used to store the radio Rx event data
- */
-struct
-{
-    TimerTime_t LastRxDone;
-    uint8_t *Payload;
-    uint16_t Size;
-    int16_t Rssi;
-    int8_t Snr;
-}RxDoneParams;
-
 static void OnRadioTxDone( void )
 {
-    TxDoneParams.CurTime = TimerGetCurrentTime( );
-    MacCtx.LastTxSysTime = SysTimeGet( );
+    TxDoneParams->CurTime = TimerGetCurrentTime( );
+    MacCtx->LastTxSysTime = SysTimeGet( );
 
-    LoRaMacRadioEvents.Events.TxDone = 1;
+    LoRaMacRadioEvents->Events.TxDone = 1;
 
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
+    if( ( MacCtx->MacCallbacks != NULL ) && ( MacCtx->MacCallbacks->MacProcessNotify != NULL ) )
     {
-        MacCtx.MacCallbacks->MacProcessNotify( );
+        MacCtx->MacCallbacks->MacProcessNotify( );
     }
 }
 
 static void OnRadioRxDone( uint8_t *payload, uint16_t size, int16_t rssi, int8_t snr )
 {
-    RxDoneParams.LastRxDone = TimerGetCurrentTime( );
-    RxDoneParams.Payload = payload;
-    RxDoneParams.Size = size;
-    RxDoneParams.Rssi = rssi;
-    RxDoneParams.Snr = snr;
+    RxDoneParams->LastRxDone = TimerGetCurrentTime( );
+    RxDoneParams->Payload = payload;
+    RxDoneParams->Size = size;
+    RxDoneParams->Rssi = rssi;
+    RxDoneParams->Snr = snr;
 
-    LoRaMacRadioEvents.Events.RxDone = 1;
+    LoRaMacRadioEvents->Events.RxDone = 1;
 
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
+    if( ( MacCtx->MacCallbacks != NULL ) && ( MacCtx->MacCallbacks->MacProcessNotify != NULL ) )
     {
-        MacCtx.MacCallbacks->MacProcessNotify( );
+        MacCtx->MacCallbacks->MacProcessNotify( );
     }
 }
 
 static void OnRadioTxTimeout( void )
 {
-    LoRaMacRadioEvents.Events.TxTimeout = 1;
+    LoRaMacRadioEvents->Events.TxTimeout = 1;
 
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
+    if( ( MacCtx->MacCallbacks != NULL ) && ( MacCtx->MacCallbacks->MacProcessNotify != NULL ) )
     {
-        MacCtx.MacCallbacks->MacProcessNotify( );
+        MacCtx->MacCallbacks->MacProcessNotify( );
     }
 }
 
 static void OnRadioRxError( void )
 {
-    LoRaMacRadioEvents.Events.RxError = 1;
+    LoRaMacRadioEvents->Events.RxError = 1;
 
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
+    if( ( MacCtx->MacCallbacks != NULL ) && ( MacCtx->MacCallbacks->MacProcessNotify != NULL ) )
     {
-        MacCtx.MacCallbacks->MacProcessNotify( );
+        MacCtx->MacCallbacks->MacProcessNotify( );
     }
 }
 
 static void OnRadioRxTimeout( void )
 {
-    LoRaMacRadioEvents.Events.RxTimeout = 1;
+    LoRaMacRadioEvents->Events.RxTimeout = 1;
 
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
+    if( ( MacCtx->MacCallbacks != NULL ) && ( MacCtx->MacCallbacks->MacProcessNotify != NULL ) )
     {
-        MacCtx.MacCallbacks->MacProcessNotify( );
+        MacCtx->MacCallbacks->MacProcessNotify( );
     }
 }
 
 static void UpdateRxSlotIdleState( void )
 {
-    if( MacCtx.NvmCtx->DeviceClass != CLASS_C )
+    if( MacCtx->NvmCtx->DeviceClass != CLASS_C )
     {
-        MacCtx.RxSlot = RX_SLOT_NONE;
+        MacCtx->RxSlot = RX_SLOT_NONE;
     }
     else
     {
-        MacCtx.RxSlot = RX_SLOT_WIN_CLASS_C;
+        MacCtx->RxSlot = RX_SLOT_WIN_CLASS_C;
     }
 }
 
@@ -867,29 +924,29 @@ static void ProcessRadioTxDone( void )
     PhyParam_t phyParam;
     SetBandTxDoneParams_t txDone;
 
-    if( MacCtx.NvmCtx->DeviceClass != CLASS_C )
+    if( MacCtx->NvmCtx->DeviceClass != CLASS_C )
     {
         Radio.Sleep( );
     }
     // Setup timers
-    TimerSetValue( &MacCtx.RxWindowTimer1, MacCtx.RxWindow1Delay );
-    TimerStart( &MacCtx.RxWindowTimer1 );
-    TimerSetValue( &MacCtx.RxWindowTimer2, MacCtx.RxWindow2Delay );
-    TimerStart( &MacCtx.RxWindowTimer2 );
+    TimerSetValue( &MacCtx->RxWindowTimer1, MacCtx->RxWindow1Delay );
+    TimerStart( &MacCtx->RxWindowTimer1 );
+    TimerSetValue( &MacCtx->RxWindowTimer2, MacCtx->RxWindow2Delay );
+    TimerStart( &MacCtx->RxWindowTimer2 );
 
-    if( ( MacCtx.NvmCtx->DeviceClass == CLASS_C ) || ( MacCtx.NodeAckRequested == true ) )
+    if( ( MacCtx->NvmCtx->DeviceClass == CLASS_C ) || ( MacCtx->NodeAckRequested == true ) )
     {
         getPhy.Attribute = PHY_ACK_TIMEOUT;
-        phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-        TimerSetValue( &MacCtx.AckTimeoutTimer, MacCtx.RxWindow2Delay + phyParam.Value );
-        TimerStart( &MacCtx.AckTimeoutTimer );
+        phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+        TimerSetValue( &MacCtx->AckTimeoutTimer, MacCtx->RxWindow2Delay + phyParam.Value );
+        TimerStart( &MacCtx->AckTimeoutTimer );
     }
 
     // Store last Tx channel
-    MacCtx.NvmCtx->LastTxChannel = MacCtx.Channel;
+    MacCtx->NvmCtx->LastTxChannel = MacCtx->Channel;
     // Update last tx done time for the current channel
-    txDone.Channel = MacCtx.Channel;
-    if( MacCtx.NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
+    txDone.Channel = MacCtx->Channel;
+    if( MacCtx->NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
     {
         txDone.Joined  = false;
     }
@@ -897,28 +954,28 @@ static void ProcessRadioTxDone( void )
     {
         txDone.Joined  = true;
     }
-    txDone.LastTxDoneTime = TxDoneParams.CurTime;
-    RegionSetBandTxDone( MacCtx.NvmCtx->Region, &txDone );
+    txDone.LastTxDoneTime = TxDoneParams->CurTime;
+    RegionSetBandTxDone( MacCtx->NvmCtx->Region, &txDone );
     // Update Aggregated last tx done time
-    MacCtx.NvmCtx->LastTxDoneTime = TxDoneParams.CurTime;
+    MacCtx->NvmCtx->LastTxDoneTime = TxDoneParams->CurTime;
 
-    if( MacCtx.NodeAckRequested == false )
+    if( MacCtx->NodeAckRequested == false )
     {
-        MacCtx.McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_OK;
+        MacCtx->McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_OK;
     }
 }
 
 static void PrepareRxDoneAbort( void )
 {
-    MacCtx.MacState |= LORAMAC_RX_ABORT;
+    MacCtx->MacState |= LORAMAC_RX_ABORT;
 
-    if( MacCtx.NodeAckRequested == true )
+    if( MacCtx->NodeAckRequested == true )
     {
         OnAckTimeoutTimerEvent( NULL );
     }
 
-    MacCtx.MacFlags.Bits.McpsInd = 1;
-    MacCtx.MacFlags.Bits.MacDone = 1;
+    MacCtx->MacFlags.Bits.McpsInd = 1;
+    MacCtx->MacFlags.Bits.MacDone = 1;
 
     UpdateRxSlotIdleState( );
 }
@@ -933,59 +990,59 @@ static void ProcessRadioRxDone( void )
 
     LoRaMacMessageData_t macMsgData;
     LoRaMacMessageJoinAccept_t macMsgJoinAccept;
-    uint8_t *payload = RxDoneParams.Payload;
-    uint16_t size = RxDoneParams.Size;
-    int16_t rssi = RxDoneParams.Rssi;
-    int8_t snr = RxDoneParams.Snr;
+    uint8_t *payload = RxDoneParams->Payload;
+    uint16_t size = RxDoneParams->Size;
+    int16_t rssi = RxDoneParams->Rssi;
+    int8_t snr = RxDoneParams->Snr;
 
     uint8_t pktHeaderLen = 0;
 
     uint32_t downLinkCounter = 0;
-    uint32_t address = MacCtx.NvmCtx->DevAddr;
+    uint32_t address = MacCtx->NvmCtx->DevAddr;
     uint8_t multicast = 0;
     AddressIdentifier_t addrID = UNICAST_DEV_ADDR;
     FCntIdentifier_t fCntID;
 
-    MacCtx.McpsConfirm.AckReceived = false;
-    MacCtx.McpsIndication.Rssi = rssi;
-    MacCtx.McpsIndication.Snr = snr;
-    MacCtx.McpsIndication.RxSlot = MacCtx.RxSlot;
-    MacCtx.McpsIndication.Port = 0;
-    MacCtx.McpsIndication.Multicast = 0;
-    MacCtx.McpsIndication.FramePending = 0;
-    MacCtx.McpsIndication.Buffer = NULL;
-    MacCtx.McpsIndication.BufferSize = 0;
-    MacCtx.McpsIndication.RxData = false;
-    MacCtx.McpsIndication.AckReceived = false;
-    MacCtx.McpsIndication.DownLinkCounter = 0;
-    MacCtx.McpsIndication.McpsIndication = MCPS_UNCONFIRMED;
-    MacCtx.McpsIndication.DevAddress = 0;
-    MacCtx.McpsIndication.DeviceTimeAnsReceived = false;
+    MacCtx->McpsConfirm.AckReceived = false;
+    MacCtx->McpsIndication.Rssi = rssi;
+    MacCtx->McpsIndication.Snr = snr;
+    MacCtx->McpsIndication.RxSlot = MacCtx->RxSlot;
+    MacCtx->McpsIndication.Port = 0;
+    MacCtx->McpsIndication.Multicast = 0;
+    MacCtx->McpsIndication.FramePending = 0;
+    MacCtx->McpsIndication.Buffer = NULL;
+    MacCtx->McpsIndication.BufferSize = 0;
+    MacCtx->McpsIndication.RxData = false;
+    MacCtx->McpsIndication.AckReceived = false;
+    MacCtx->McpsIndication.DownLinkCounter = 0;
+    MacCtx->McpsIndication.McpsIndication = MCPS_UNCONFIRMED;
+    MacCtx->McpsIndication.DevAddress = 0;
+    MacCtx->McpsIndication.DeviceTimeAnsReceived = false;
 
     Radio.Sleep( );
-    TimerStop( &MacCtx.RxWindowTimer2 );
+    TimerStop( &MacCtx->RxWindowTimer2 );
 
     // This function must be called even if we are not in class b mode yet.
     if( LoRaMacClassBRxBeacon( payload, size ) == true )
     {
-        MacCtx.MlmeIndication.BeaconInfo.Rssi = rssi;
-        MacCtx.MlmeIndication.BeaconInfo.Snr = snr;
+        MacCtx->MlmeIndication.BeaconInfo.Rssi = rssi;
+        MacCtx->MlmeIndication.BeaconInfo.Snr = snr;
         return;
     }
     // Check if we expect a ping or a multicast slot.
-    if( MacCtx.NvmCtx->DeviceClass == CLASS_B )
+    if( MacCtx->NvmCtx->DeviceClass == CLASS_B )
     {
         if( LoRaMacClassBIsPingExpected( ) == true )
         {
             LoRaMacClassBSetPingSlotState( PINGSLOT_STATE_CALC_PING_OFFSET );
             LoRaMacClassBPingSlotTimerEvent( NULL );
-            MacCtx.McpsIndication.RxSlot = RX_SLOT_WIN_CLASS_B_PING_SLOT;
+            MacCtx->McpsIndication.RxSlot = RX_SLOT_WIN_CLASS_B_PING_SLOT;
         }
         else if( LoRaMacClassBIsMulticastExpected( ) == true )
         {
             LoRaMacClassBSetMulticastSlotState( PINGSLOT_STATE_CALC_PING_OFFSET );
             LoRaMacClassBMulticastSlotTimerEvent( NULL );
-            MacCtx.McpsIndication.RxSlot = RX_SLOT_WIN_CLASS_B_MULTICAST_SLOT;
+            MacCtx->McpsIndication.RxSlot = RX_SLOT_WIN_CLASS_B_MULTICAST_SLOT;
         }
     }
 
@@ -998,9 +1055,9 @@ static void ProcessRadioRxDone( void )
             macMsgJoinAccept.BufSize = size;
 
             // Abort in case if the device isn't joined yet and no rejoin request is ongoing.
-            if( MacCtx.NvmCtx->NetworkActivation != ACTIVATION_TYPE_NONE )
+            if( MacCtx->NvmCtx->NetworkActivation != ACTIVATION_TYPE_NONE )
             {
-                MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+                MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
                 PrepareRxDoneAbort( );
                 return;
             }
@@ -1009,37 +1066,37 @@ static void ProcessRadioRxDone( void )
             if( LORAMAC_CRYPTO_SUCCESS == macCryptoStatus )
             {
                 // Network ID
-                MacCtx.NvmCtx->NetID = ( uint32_t ) macMsgJoinAccept.NetID[0];
-                MacCtx.NvmCtx->NetID |= ( ( uint32_t ) macMsgJoinAccept.NetID[1] << 8 );
-                MacCtx.NvmCtx->NetID |= ( ( uint32_t ) macMsgJoinAccept.NetID[2] << 16 );
+                MacCtx->NvmCtx->NetID = ( uint32_t ) macMsgJoinAccept.NetID[0];
+                MacCtx->NvmCtx->NetID |= ( ( uint32_t ) macMsgJoinAccept.NetID[1] << 8 );
+                MacCtx->NvmCtx->NetID |= ( ( uint32_t ) macMsgJoinAccept.NetID[2] << 16 );
 
                 // Device Address
-                MacCtx.NvmCtx->DevAddr = macMsgJoinAccept.DevAddr;
+                MacCtx->NvmCtx->DevAddr = macMsgJoinAccept.DevAddr;
 
                 // DLSettings
-                MacCtx.NvmCtx->MacParams.Rx1DrOffset = macMsgJoinAccept.DLSettings.Bits.RX1DRoffset;
-                MacCtx.NvmCtx->MacParams.Rx2Channel.Datarate = macMsgJoinAccept.DLSettings.Bits.RX2DataRate;
-                MacCtx.NvmCtx->MacParams.RxCChannel.Datarate = macMsgJoinAccept.DLSettings.Bits.RX2DataRate;
+                MacCtx->NvmCtx->MacParams.Rx1DrOffset = macMsgJoinAccept.DLSettings.Bits.RX1DRoffset;
+                MacCtx->NvmCtx->MacParams.Rx2Channel.Datarate = macMsgJoinAccept.DLSettings.Bits.RX2DataRate;
+                MacCtx->NvmCtx->MacParams.RxCChannel.Datarate = macMsgJoinAccept.DLSettings.Bits.RX2DataRate;
 
                 // RxDelay
-                MacCtx.NvmCtx->MacParams.ReceiveDelay1 = macMsgJoinAccept.RxDelay;
-                if( MacCtx.NvmCtx->MacParams.ReceiveDelay1 == 0 )
+                MacCtx->NvmCtx->MacParams.ReceiveDelay1 = macMsgJoinAccept.RxDelay;
+                if( MacCtx->NvmCtx->MacParams.ReceiveDelay1 == 0 )
                 {
-                    MacCtx.NvmCtx->MacParams.ReceiveDelay1 = 1;
+                    MacCtx->NvmCtx->MacParams.ReceiveDelay1 = 1;
                 }
-                MacCtx.NvmCtx->MacParams.ReceiveDelay1 *= 1000;
-                MacCtx.NvmCtx->MacParams.ReceiveDelay2 = MacCtx.NvmCtx->MacParams.ReceiveDelay1 + 1000;
+                MacCtx->NvmCtx->MacParams.ReceiveDelay1 *= 1000;
+                MacCtx->NvmCtx->MacParams.ReceiveDelay2 = MacCtx->NvmCtx->MacParams.ReceiveDelay1 + 1000;
 
-                MacCtx.NvmCtx->Version.Fields.Minor = 0;
+                MacCtx->NvmCtx->Version.Fields.Minor = 0;
 
                 // Apply CF list
                 applyCFList.Payload = macMsgJoinAccept.CFList;
                 // Size of the regular payload is 12. Plus 1 byte MHDR and 4 bytes MIC
                 applyCFList.Size = size - 17;
 
-                RegionApplyCFList( MacCtx.NvmCtx->Region, &applyCFList );
+                RegionApplyCFList( MacCtx->NvmCtx->Region, &applyCFList );
 
-                MacCtx.NvmCtx->NetworkActivation = ACTIVATION_TYPE_OTAA;
+                MacCtx->NvmCtx->NetworkActivation = ACTIVATION_TYPE_OTAA;
 
                 // MLME handling
                 if( LoRaMacConfirmQueueIsCmdActive( MLME_JOIN ) == true )
@@ -1057,45 +1114,45 @@ static void ProcessRadioRxDone( void )
             }
             break;
         case FRAME_TYPE_DATA_CONFIRMED_DOWN:
-            MacCtx.McpsIndication.McpsIndication = MCPS_CONFIRMED;
+            MacCtx->McpsIndication.McpsIndication = MCPS_CONFIRMED;
             // Intentional fall through
         case FRAME_TYPE_DATA_UNCONFIRMED_DOWN:
             // Check if the received payload size is valid
-            getPhy.UplinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
-            getPhy.Datarate = MacCtx.McpsIndication.RxDatarate;
+            getPhy.UplinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
+            getPhy.Datarate = MacCtx->McpsIndication.RxDatarate;
             getPhy.Attribute = PHY_MAX_PAYLOAD;
 
             // Get the maximum payload length
-            if( MacCtx.NvmCtx->RepeaterSupport == true )
+            if( MacCtx->NvmCtx->RepeaterSupport == true )
             {
                 getPhy.Attribute = PHY_MAX_PAYLOAD_REPEATER;
             }
-            phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+            phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
             if( MAX( 0, ( int16_t )( ( int16_t ) size - ( int16_t ) LORA_MAC_FRMPAYLOAD_OVERHEAD ) ) > ( int16_t )phyParam.Value )
             {
-                MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+                MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
                 PrepareRxDoneAbort( );
                 return;
             }
             macMsgData.Buffer = payload;
             macMsgData.BufSize = size;
-            macMsgData.FRMPayload = MacCtx.RxPayload;
+            macMsgData.FRMPayload = MacCtx->RxPayload;
             macMsgData.FRMPayloadSize = LORAMAC_PHY_MAXPAYLOAD;
 
             if( LORAMAC_PARSER_SUCCESS != LoRaMacParserData( &macMsgData ) )
             {
-                MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+                MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
                 PrepareRxDoneAbort( );
                 return;
             }
 
             // Store device address
-            MacCtx.McpsIndication.DevAddress = macMsgData.FHDR.DevAddr;
+            MacCtx->McpsIndication.DevAddress = macMsgData.FHDR.DevAddr;
 
             FType_t fType;
             if( LORAMAC_STATUS_OK != DetermineFrameType( &macMsgData, &fType ) )
             {
-                MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+                MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
                 PrepareRxDoneAbort( );
                 return;
             }
@@ -1105,16 +1162,16 @@ static void ProcessRadioRxDone( void )
             downLinkCounter = 0;
             for( uint8_t i = 0; i < LORAMAC_MAX_MC_CTX; i++ )
             {
-                if( ( MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.Address == macMsgData.FHDR.DevAddr ) &&
-                    ( MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.IsEnabled == true ) )
+                if( ( MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.Address == macMsgData.FHDR.DevAddr ) &&
+                    ( MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.IsEnabled == true ) )
                 {
                     multicast = 1;
-                    addrID = MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.GroupID;
-                    downLinkCounter = *( MacCtx.NvmCtx->MulticastChannelList[i].DownLinkCounter );
-                    address = MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.Address;
-                    if( MacCtx.NvmCtx->DeviceClass == CLASS_C )
+                    addrID = MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.GroupID;
+                    downLinkCounter = *( MacCtx->NvmCtx->MulticastChannelList[i].DownLinkCounter );
+                    address = MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.Address;
+                    if( MacCtx->NvmCtx->DeviceClass == CLASS_C )
                     {
-                        MacCtx.McpsIndication.RxSlot = RX_SLOT_WIN_CLASS_C_MULTICAST;
+                        MacCtx->McpsIndication.RxSlot = RX_SLOT_WIN_CLASS_C_MULTICAST;
                     }
                     break;
                 }
@@ -1122,32 +1179,32 @@ static void ProcessRadioRxDone( void )
 
             // Get maximum allowed counter difference
             getPhy.Attribute = PHY_MAX_FCNT_GAP;
-            phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+            phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
 
             // Get downlink frame counter value
-            macCryptoStatus = GetFCntDown( addrID, fType, &macMsgData, MacCtx.NvmCtx->Version, phyParam.Value, &fCntID, &downLinkCounter );
+            macCryptoStatus = GetFCntDown( addrID, fType, &macMsgData, MacCtx->NvmCtx->Version, phyParam.Value, &fCntID, &downLinkCounter );
             if( macCryptoStatus != LORAMAC_CRYPTO_SUCCESS )
             {
                 if( macCryptoStatus == LORAMAC_CRYPTO_FAIL_FCNT_DUPLICATED )
                 {
                     // Catch the case of repeated downlink frame counter
-                    MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_DOWNLINK_REPEATED;
-                    if( ( MacCtx.NvmCtx->Version.Fields.Minor == 0 ) && ( macHdr.Bits.MType == FRAME_TYPE_DATA_CONFIRMED_DOWN ) && ( MacCtx.NvmCtx->LastRxMic == macMsgData.MIC ) )
+                    MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_DOWNLINK_REPEATED;
+                    if( ( MacCtx->NvmCtx->Version.Fields.Minor == 0 ) && ( macHdr.Bits.MType == FRAME_TYPE_DATA_CONFIRMED_DOWN ) && ( MacCtx->NvmCtx->LastRxMic == macMsgData.MIC ) )
                     {
-                        MacCtx.NvmCtx->SrvAckRequested = true;
+                        MacCtx->NvmCtx->SrvAckRequested = true;
                     }
                 }
                 else if( macCryptoStatus == LORAMAC_CRYPTO_FAIL_MAX_GAP_FCNT )
                 {
                     // Lost too many frames
-                    MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_DOWNLINK_TOO_MANY_FRAMES_LOSS;
+                    MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_DOWNLINK_TOO_MANY_FRAMES_LOSS;
                 }
                 else
                 {
                     // Other errors
-                    MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+                    MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
                 }
-                MacCtx.McpsIndication.DownLinkCounter = downLinkCounter;
+                MacCtx->McpsIndication.DownLinkCounter = downLinkCounter;
                 PrepareRxDoneAbort( );
                 return;
             }
@@ -1158,60 +1215,60 @@ static void ProcessRadioRxDone( void )
                 if( macCryptoStatus == LORAMAC_CRYPTO_FAIL_ADDRESS )
                 {
                     // We are not the destination of this frame.
-                    MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ADDRESS_FAIL;
+                    MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ADDRESS_FAIL;
                 }
                 else
                 {
                     // MIC calculation fail
-                    MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_MIC_FAIL;
+                    MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_MIC_FAIL;
                 }
                 PrepareRxDoneAbort( );
                 return;
             }
 
             // Frame is valid
-            MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_OK;
-            MacCtx.McpsIndication.Multicast = multicast;
-            MacCtx.McpsIndication.FramePending = macMsgData.FHDR.FCtrl.Bits.FPending;
-            MacCtx.McpsIndication.Buffer = NULL;
-            MacCtx.McpsIndication.BufferSize = 0;
-            MacCtx.McpsIndication.DownLinkCounter = downLinkCounter;
-            MacCtx.McpsIndication.AckReceived = macMsgData.FHDR.FCtrl.Bits.Ack;
+            MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_OK;
+            MacCtx->McpsIndication.Multicast = multicast;
+            MacCtx->McpsIndication.FramePending = macMsgData.FHDR.FCtrl.Bits.FPending;
+            MacCtx->McpsIndication.Buffer = NULL;
+            MacCtx->McpsIndication.BufferSize = 0;
+            MacCtx->McpsIndication.DownLinkCounter = downLinkCounter;
+            MacCtx->McpsIndication.AckReceived = macMsgData.FHDR.FCtrl.Bits.Ack;
 
-            MacCtx.McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_OK;
-            MacCtx.McpsConfirm.AckReceived = macMsgData.FHDR.FCtrl.Bits.Ack;
+            MacCtx->McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_OK;
+            MacCtx->McpsConfirm.AckReceived = macMsgData.FHDR.FCtrl.Bits.Ack;
 
             // Reset ADR ACK Counter only, when RX1 or RX2 slot
-            if( ( MacCtx.McpsIndication.RxSlot == RX_SLOT_WIN_1 ) ||
-                ( MacCtx.McpsIndication.RxSlot == RX_SLOT_WIN_2 ) )
+            if( ( MacCtx->McpsIndication.RxSlot == RX_SLOT_WIN_1 ) ||
+                ( MacCtx->McpsIndication.RxSlot == RX_SLOT_WIN_2 ) )
             {
-                MacCtx.NvmCtx->AdrAckCounter = 0;
+                MacCtx->NvmCtx->AdrAckCounter = 0;
             }
 
             // MCPS Indication and ack requested handling
             if( multicast == 1 )
             {
-                MacCtx.McpsIndication.McpsIndication = MCPS_MULTICAST;
+                MacCtx->McpsIndication.McpsIndication = MCPS_MULTICAST;
             }
             else
             {
                 if( macHdr.Bits.MType == FRAME_TYPE_DATA_CONFIRMED_DOWN )
                 {
-                    MacCtx.NvmCtx->SrvAckRequested = true;
-                    if( MacCtx.NvmCtx->Version.Fields.Minor == 0 )
+                    MacCtx->NvmCtx->SrvAckRequested = true;
+                    if( MacCtx->NvmCtx->Version.Fields.Minor == 0 )
                     {
-                        MacCtx.NvmCtx->LastRxMic = macMsgData.MIC;
+                        MacCtx->NvmCtx->LastRxMic = macMsgData.MIC;
                     }
-                    MacCtx.McpsIndication.McpsIndication = MCPS_CONFIRMED;
+                    MacCtx->McpsIndication.McpsIndication = MCPS_CONFIRMED;
                 }
                 else
                 {
-                    MacCtx.NvmCtx->SrvAckRequested = false;
-                    MacCtx.McpsIndication.McpsIndication = MCPS_UNCONFIRMED;
+                    MacCtx->NvmCtx->SrvAckRequested = false;
+                    MacCtx->McpsIndication.McpsIndication = MCPS_UNCONFIRMED;
                 }
             }
 
-            RemoveMacCommands( MacCtx.McpsIndication.RxSlot, macMsgData.FHDR.FCtrl, MacCtx.McpsConfirm.McpsRequest );
+            RemoveMacCommands( MacCtx->McpsIndication.RxSlot, macMsgData.FHDR.FCtrl, MacCtx->McpsConfirm.McpsRequest );
 
             switch( fType )
             {
@@ -1224,11 +1281,11 @@ static void ProcessRadioRxDone( void )
                     */
 
                     // Decode MAC commands in FOpts field
-                    ProcessMacCommands( macMsgData.FHDR.FOpts, 0, macMsgData.FHDR.FCtrl.Bits.FOptsLen, snr, MacCtx.McpsIndication.RxSlot );
-                    MacCtx.McpsIndication.Port = macMsgData.FPort;
-                    MacCtx.McpsIndication.Buffer = macMsgData.FRMPayload;
-                    MacCtx.McpsIndication.BufferSize = macMsgData.FRMPayloadSize;
-                    MacCtx.McpsIndication.RxData = true;
+                    ProcessMacCommands( macMsgData.FHDR.FOpts, 0, macMsgData.FHDR.FCtrl.Bits.FOptsLen, snr, MacCtx->McpsIndication.RxSlot );
+                    MacCtx->McpsIndication.Port = macMsgData.FPort;
+                    MacCtx->McpsIndication.Buffer = macMsgData.FRMPayload;
+                    MacCtx->McpsIndication.BufferSize = macMsgData.FRMPayloadSize;
+                    MacCtx->McpsIndication.RxData = true;
                     break;
                 }
                 case FRAME_TYPE_B:
@@ -1240,8 +1297,8 @@ static void ProcessRadioRxDone( void )
                     */
 
                     // Decode MAC commands in FOpts field
-                    ProcessMacCommands( macMsgData.FHDR.FOpts, 0, macMsgData.FHDR.FCtrl.Bits.FOptsLen, snr, MacCtx.McpsIndication.RxSlot );
-                    MacCtx.McpsIndication.Port = macMsgData.FPort;
+                    ProcessMacCommands( macMsgData.FHDR.FOpts, 0, macMsgData.FHDR.FCtrl.Bits.FOptsLen, snr, MacCtx->McpsIndication.RxSlot );
+                    MacCtx->McpsIndication.Port = macMsgData.FPort;
                     break;
                 }
                 case FRAME_TYPE_C:
@@ -1253,8 +1310,8 @@ static void ProcessRadioRxDone( void )
                     */
 
                     // Decode MAC commands in FRMPayload
-                    ProcessMacCommands( macMsgData.FRMPayload, 0, macMsgData.FRMPayloadSize, snr, MacCtx.McpsIndication.RxSlot );
-                    MacCtx.McpsIndication.Port = macMsgData.FPort;
+                    ProcessMacCommands( macMsgData.FRMPayload, 0, macMsgData.FRMPayloadSize, snr, MacCtx->McpsIndication.RxSlot );
+                    MacCtx->McpsIndication.Port = macMsgData.FPort;
                     break;
                 }
                 case FRAME_TYPE_D:
@@ -1266,81 +1323,81 @@ static void ProcessRadioRxDone( void )
                     */
 
                     // No MAC commands just application payload
-                    MacCtx.McpsIndication.Port = macMsgData.FPort;
-                    MacCtx.McpsIndication.Buffer = macMsgData.FRMPayload;
-                    MacCtx.McpsIndication.BufferSize = macMsgData.FRMPayloadSize;
-                    MacCtx.McpsIndication.RxData = true;
+                    MacCtx->McpsIndication.Port = macMsgData.FPort;
+                    MacCtx->McpsIndication.Buffer = macMsgData.FRMPayload;
+                    MacCtx->McpsIndication.BufferSize = macMsgData.FRMPayloadSize;
+                    MacCtx->McpsIndication.RxData = true;
                     break;
                 }
                 default:
-                    MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+                    MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
                     PrepareRxDoneAbort( );
                     break;
             }
 
             // Provide always an indication, skip the callback to the user application,
             // in case of a confirmed downlink retransmission.
-            MacCtx.MacFlags.Bits.McpsInd = 1;
+            MacCtx->MacFlags.Bits.McpsInd = 1;
 
             break;
         case FRAME_TYPE_PROPRIETARY:
-            memcpy1( MacCtx.RxPayload, &payload[pktHeaderLen], size - pktHeaderLen );
+            memcpy1( MacCtx->RxPayload, &payload[pktHeaderLen], size - pktHeaderLen );
 
-            MacCtx.McpsIndication.McpsIndication = MCPS_PROPRIETARY;
-            MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_OK;
-            MacCtx.McpsIndication.Buffer = MacCtx.RxPayload;
-            MacCtx.McpsIndication.BufferSize = size - pktHeaderLen;
+            MacCtx->McpsIndication.McpsIndication = MCPS_PROPRIETARY;
+            MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_OK;
+            MacCtx->McpsIndication.Buffer = MacCtx->RxPayload;
+            MacCtx->McpsIndication.BufferSize = size - pktHeaderLen;
 
-            MacCtx.MacFlags.Bits.McpsInd = 1;
+            MacCtx->MacFlags.Bits.McpsInd = 1;
             break;
         default:
-            MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+            MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
             PrepareRxDoneAbort( );
             break;
     }
 
     // Verify if we need to disable the AckTimeoutTimer
-    if( MacCtx.NodeAckRequested == true )
+    if( MacCtx->NodeAckRequested == true )
     {
-        if( MacCtx.McpsConfirm.AckReceived == true )
+        if( MacCtx->McpsConfirm.AckReceived == true )
         {
             OnAckTimeoutTimerEvent( NULL );
         }
     }
     else
     {
-        if( MacCtx.NvmCtx->DeviceClass == CLASS_C )
+        if( MacCtx->NvmCtx->DeviceClass == CLASS_C )
         {
             OnAckTimeoutTimerEvent( NULL );
         }
     }
-    MacCtx.MacFlags.Bits.MacDone = 1;
+    MacCtx->MacFlags.Bits.MacDone = 1;
 
     UpdateRxSlotIdleState( );
 }
 
 static void ProcessRadioTxTimeout( void )
 {
-    if( MacCtx.NvmCtx->DeviceClass != CLASS_C )
+    if( MacCtx->NvmCtx->DeviceClass != CLASS_C )
     {
         Radio.Sleep( );
     }
     UpdateRxSlotIdleState( );
 
-    MacCtx.McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_TX_TIMEOUT;
+    MacCtx->McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_TX_TIMEOUT;
     LoRaMacConfirmQueueSetStatusCmn( LORAMAC_EVENT_INFO_STATUS_TX_TIMEOUT );
-    if( MacCtx.NodeAckRequested == true )
+    if( MacCtx->NodeAckRequested == true )
     {
-        MacCtx.AckTimeoutRetry = true;
+        MacCtx->AckTimeoutRetry = true;
     }
-    MacCtx.MacFlags.Bits.MacDone = 1;
+    MacCtx->MacFlags.Bits.MacDone = 1;
 }
 
 static void HandleRadioRxErrorTimeout( LoRaMacEventInfoStatus_t rx1EventInfoStatus, LoRaMacEventInfoStatus_t rx2EventInfoStatus )
 {
     bool classBRx = false;
 
-    if( MacCtx.NvmCtx->DeviceClass != CLASS_C )
+    if( MacCtx->NvmCtx->DeviceClass != CLASS_C )
     {
         Radio.Sleep( );
     }
@@ -1351,7 +1408,7 @@ static void HandleRadioRxErrorTimeout( LoRaMacEventInfoStatus_t rx1EventInfoStat
         LoRaMacClassBBeaconTimerEvent( NULL );
         classBRx = true;
     }
-    if( MacCtx.NvmCtx->DeviceClass == CLASS_B )
+    if( MacCtx->NvmCtx->DeviceClass == CLASS_B )
     {
         if( LoRaMacClassBIsPingExpected( ) == true )
         {
@@ -1369,31 +1426,31 @@ static void HandleRadioRxErrorTimeout( LoRaMacEventInfoStatus_t rx1EventInfoStat
 
     if( classBRx == false )
     {
-        if( MacCtx.RxSlot == RX_SLOT_WIN_1 )
+        if( MacCtx->RxSlot == RX_SLOT_WIN_1 )
         {
-            if( MacCtx.NodeAckRequested == true )
+            if( MacCtx->NodeAckRequested == true )
             {
-                MacCtx.McpsConfirm.Status = rx1EventInfoStatus;
+                MacCtx->McpsConfirm.Status = rx1EventInfoStatus;
             }
             LoRaMacConfirmQueueSetStatusCmn( rx1EventInfoStatus );
 
-            if( TimerGetElapsedTime( MacCtx.NvmCtx->LastTxDoneTime ) >= MacCtx.RxWindow2Delay )
+            if( TimerGetElapsedTime( MacCtx->NvmCtx->LastTxDoneTime ) >= MacCtx->RxWindow2Delay )
             {
-                TimerStop( &MacCtx.RxWindowTimer2 );
-                MacCtx.MacFlags.Bits.MacDone = 1;
+                TimerStop( &MacCtx->RxWindowTimer2 );
+                MacCtx->MacFlags.Bits.MacDone = 1;
             }
         }
         else
         {
-            if( MacCtx.NodeAckRequested == true )
+            if( MacCtx->NodeAckRequested == true )
             {
-                MacCtx.McpsConfirm.Status = rx2EventInfoStatus;
+                MacCtx->McpsConfirm.Status = rx2EventInfoStatus;
             }
             LoRaMacConfirmQueueSetStatusCmn( rx2EventInfoStatus );
 
-            if( MacCtx.NvmCtx->DeviceClass != CLASS_C )
+            if( MacCtx->NvmCtx->DeviceClass != CLASS_C )
             {
-                MacCtx.MacFlags.Bits.MacDone = 1;
+                MacCtx->MacFlags.Bits.MacDone = 1;
             }
         }
     }
@@ -1416,8 +1473,8 @@ static void LoRaMacHandleIrqEvents( void )
     LoRaMacRadioEvents_t events;
 
     CRITICAL_SECTION_BEGIN( );
-    events = LoRaMacRadioEvents;
-    LoRaMacRadioEvents.Value = 0;
+    events = *LoRaMacRadioEvents;
+    LoRaMacRadioEvents->Value = 0;
     CRITICAL_SECTION_END( );
 
     if( events.Value != 0 )
@@ -1447,8 +1504,8 @@ static void LoRaMacHandleIrqEvents( void )
 
 bool LoRaMacIsBusy( void )
 {
-    if( ( MacCtx.MacState == LORAMAC_IDLE ) &&
-        ( MacCtx.AllowRequests == LORAMAC_REQUEST_HANDLING_ON ) )
+    if( ( MacCtx->MacState == LORAMAC_IDLE ) &&
+        ( MacCtx->AllowRequests == LORAMAC_REQUEST_HANDLING_ON ) )
     {
         return false;
     }
@@ -1458,25 +1515,25 @@ bool LoRaMacIsBusy( void )
 
 static void LoRaMacEnableRequests( LoRaMacRequestHandling_t requestState )
 {
-    MacCtx.AllowRequests = requestState;
+    MacCtx->AllowRequests = requestState;
 }
 
 static void LoRaMacHandleRequestEvents( void )
 {
     // Handle events
-    LoRaMacFlags_t reqEvents = MacCtx.MacFlags;
+    LoRaMacFlags_t reqEvents = MacCtx->MacFlags;
 
-    if( MacCtx.MacState == LORAMAC_IDLE )
+    if( MacCtx->MacState == LORAMAC_IDLE )
     {
         // Update event bits
-        if( MacCtx.MacFlags.Bits.McpsReq == 1 )
+        if( MacCtx->MacFlags.Bits.McpsReq == 1 )
         {
-            MacCtx.MacFlags.Bits.McpsReq = 0;
+            MacCtx->MacFlags.Bits.McpsReq = 0;
         }
 
-        if( MacCtx.MacFlags.Bits.MlmeReq == 1 )
+        if( MacCtx->MacFlags.Bits.MlmeReq == 1 )
         {
-            MacCtx.MacFlags.Bits.MlmeReq = 0;
+            MacCtx->MacFlags.Bits.MlmeReq = 0;
         }
 
         // Allow requests again
@@ -1485,15 +1542,15 @@ static void LoRaMacHandleRequestEvents( void )
         // Handle callbacks
         if( reqEvents.Bits.McpsReq == 1 )
         {
-            MacCtx.MacPrimitives->MacMcpsConfirm( &MacCtx.McpsConfirm );
+            MacCtx->MacPrimitives->MacMcpsConfirm( &MacCtx->McpsConfirm );
         }
 
         if( reqEvents.Bits.MlmeReq == 1 )
         {
-            LoRaMacConfirmQueueHandleCb( &MacCtx.MlmeConfirm );
+            LoRaMacConfirmQueueHandleCb( &MacCtx->MlmeConfirm );
             if( LoRaMacConfirmQueueGetCnt( ) > 0 )
             {
-                MacCtx.MacFlags.Bits.MlmeReq = 1;
+                MacCtx->MacFlags.Bits.MlmeReq = 1;
             }
         }
 
@@ -1501,14 +1558,14 @@ static void LoRaMacHandleRequestEvents( void )
         LoRaMacClassBResumeBeaconing( );
 
         // Procedure done. Reset variables.
-        MacCtx.MacFlags.Bits.MacDone = 0;
+        MacCtx->MacFlags.Bits.MacDone = 0;
     }
 }
 
 static void LoRaMacHandleScheduleUplinkEvent( void )
 {
     // Handle events
-    if( MacCtx.MacState == LORAMAC_IDLE )
+    if( MacCtx->MacState == LORAMAC_IDLE )
     {
         // Verify if sticky MAC commands are pending or not
         bool isStickyMacCommandPending = false;
@@ -1523,50 +1580,50 @@ static void LoRaMacHandleScheduleUplinkEvent( void )
 static void LoRaMacHandleIndicationEvents( void )
 {
     // Handle MLME indication
-    if( MacCtx.MacFlags.Bits.MlmeInd == 1 )
+    if( MacCtx->MacFlags.Bits.MlmeInd == 1 )
     {
-        MacCtx.MacFlags.Bits.MlmeInd = 0;
-        MacCtx.MacPrimitives->MacMlmeIndication( &MacCtx.MlmeIndication );
+        MacCtx->MacFlags.Bits.MlmeInd = 0;
+        MacCtx->MacPrimitives->MacMlmeIndication( &MacCtx->MlmeIndication );
     }
 
-    if( MacCtx.MacFlags.Bits.MlmeSchedUplinkInd == 1 )
+    if( MacCtx->MacFlags.Bits.MlmeSchedUplinkInd == 1 )
     {
         MlmeIndication_t schduleUplinkIndication;
         schduleUplinkIndication.MlmeIndication = MLME_SCHEDULE_UPLINK;
         schduleUplinkIndication.Status = LORAMAC_EVENT_INFO_STATUS_OK;
 
-        MacCtx.MacPrimitives->MacMlmeIndication( &schduleUplinkIndication );
-        MacCtx.MacFlags.Bits.MlmeSchedUplinkInd = 0;
+        MacCtx->MacPrimitives->MacMlmeIndication( &schduleUplinkIndication );
+        MacCtx->MacFlags.Bits.MlmeSchedUplinkInd = 0;
     }
 
     // Handle MCPS indication
-    if( MacCtx.MacFlags.Bits.McpsInd == 1 )
+    if( MacCtx->MacFlags.Bits.McpsInd == 1 )
     {
-        MacCtx.MacFlags.Bits.McpsInd = 0;
-        MacCtx.MacPrimitives->MacMcpsIndication( &MacCtx.McpsIndication );
+        MacCtx->MacFlags.Bits.McpsInd = 0;
+        MacCtx->MacPrimitives->MacMcpsIndication( &MacCtx->McpsIndication );
     }
 }
 
 static void LoRaMacHandleMcpsRequest( void )
 {
     // Handle MCPS uplinks
-    if( MacCtx.MacFlags.Bits.McpsReq == 1 )
+    if( MacCtx->MacFlags.Bits.McpsReq == 1 )
     {
         bool stopRetransmission = false;
         bool waitForRetransmission = false;
 
-        if( ( MacCtx.McpsConfirm.McpsRequest == MCPS_UNCONFIRMED ) ||
-            ( MacCtx.McpsConfirm.McpsRequest == MCPS_PROPRIETARY ) )
+        if( ( MacCtx->McpsConfirm.McpsRequest == MCPS_UNCONFIRMED ) ||
+            ( MacCtx->McpsConfirm.McpsRequest == MCPS_PROPRIETARY ) )
         {
             stopRetransmission = CheckRetransUnconfirmedUplink( );
         }
-        else if( MacCtx.McpsConfirm.McpsRequest == MCPS_CONFIRMED )
+        else if( MacCtx->McpsConfirm.McpsRequest == MCPS_CONFIRMED )
         {
-            if( MacCtx.AckTimeoutRetry == true )
+            if( MacCtx->AckTimeoutRetry == true )
             {
                 stopRetransmission = CheckRetransConfirmedUplink( );
 
-                if( MacCtx.NvmCtx->Version.Fields.Minor == 0 )
+                if( MacCtx->NvmCtx->Version.Fields.Minor == 0 )
                 {
                     if( stopRetransmission == false )
                     {
@@ -1586,15 +1643,15 @@ static void LoRaMacHandleMcpsRequest( void )
 
         if( stopRetransmission == true )
         {// Stop retransmission
-            TimerStop( &MacCtx.TxDelayedTimer );
-            MacCtx.MacState &= ~LORAMAC_TX_DELAYED;
+            TimerStop( &MacCtx->TxDelayedTimer );
+            MacCtx->MacState &= ~LORAMAC_TX_DELAYED;
             StopRetransmission( );
         }
         else if( waitForRetransmission == false )
         {// Arrange further retransmission
-            MacCtx.MacFlags.Bits.MacDone = 0;
+            MacCtx->MacFlags.Bits.MacDone = 0;
             // Reset the state of the AckTimeout
-            MacCtx.AckTimeoutRetry = false;
+            MacCtx->AckTimeoutRetry = false;
             // Sends the same frame again
             OnTxDelayedTimerEvent( NULL );
         }
@@ -1604,20 +1661,20 @@ static void LoRaMacHandleMcpsRequest( void )
 static void LoRaMacHandleMlmeRequest( void )
 {
     // Handle join request
-    if( MacCtx.MacFlags.Bits.MlmeReq == 1 )
+    if( MacCtx->MacFlags.Bits.MlmeReq == 1 )
     {
         if( ( LoRaMacConfirmQueueIsCmdActive( MLME_JOIN ) == true ) )
         {
             if( LoRaMacConfirmQueueGetStatus( MLME_JOIN ) == LORAMAC_EVENT_INFO_STATUS_OK )
             {// Node joined successfully
-                MacCtx.ChannelsNbTransCounter = 0;
+                MacCtx->ChannelsNbTransCounter = 0;
             }
-            MacCtx.MacState &= ~LORAMAC_TX_RUNNING;
+            MacCtx->MacState &= ~LORAMAC_TX_RUNNING;
         }
         else if( ( LoRaMacConfirmQueueIsCmdActive( MLME_TXCW ) == true ) ||
                  ( LoRaMacConfirmQueueIsCmdActive( MLME_TXCW_1 ) == true ) )
         {
-            MacCtx.MacState &= ~LORAMAC_TX_RUNNING;
+            MacCtx->MacState &= ~LORAMAC_TX_RUNNING;
         }
     }
 }
@@ -1625,11 +1682,11 @@ static void LoRaMacHandleMlmeRequest( void )
 static uint8_t LoRaMacCheckForBeaconAcquisition( void )
 {
     if( ( LoRaMacConfirmQueueIsCmdActive( MLME_BEACON_ACQUISITION ) == true ) &&
-        ( MacCtx.MacFlags.Bits.McpsReq == 0 ) )
+        ( MacCtx->MacFlags.Bits.McpsReq == 0 ) )
     {
-        if( MacCtx.MacFlags.Bits.MlmeReq == 1 )
+        if( MacCtx->MacFlags.Bits.MlmeReq == 1 )
         {
-            MacCtx.MacState &= ~LORAMAC_TX_RUNNING;
+            MacCtx->MacState &= ~LORAMAC_TX_RUNNING;
             return 0x01;
         }
     }
@@ -1639,10 +1696,10 @@ static uint8_t LoRaMacCheckForBeaconAcquisition( void )
 static void LoRaMacCheckForRxAbort( void )
 {
     // A error occurs during receiving
-    if( ( MacCtx.MacState & LORAMAC_RX_ABORT ) == LORAMAC_RX_ABORT )
+    if( ( MacCtx->MacState & LORAMAC_RX_ABORT ) == LORAMAC_RX_ABORT )
     {
-        MacCtx.MacState &= ~LORAMAC_RX_ABORT;
-        MacCtx.MacState &= ~LORAMAC_TX_RUNNING;
+        MacCtx->MacState &= ~LORAMAC_RX_ABORT;
+        MacCtx->MacState &= ~LORAMAC_TX_RUNNING;
     }
 }
 
@@ -1655,7 +1712,7 @@ void LoRaMacProcess( void )
     LoRaMacClassBProcess( );
 
     // MAC proceeded a state and is ready to check
-    if( MacCtx.MacFlags.Bits.MacDone == 1 )
+    if( MacCtx->MacFlags.Bits.MacDone == 1 )
     {
         LoRaMacEnableRequests( LORAMAC_REQUEST_HANDLING_OFF );
         LoRaMacCheckForRxAbort( );
@@ -1676,7 +1733,7 @@ void LoRaMacProcess( void )
         LoRaMacEnableRequests( LORAMAC_REQUEST_HANDLING_ON );
     }
     LoRaMacHandleIndicationEvents( );
-    if( MacCtx.RxSlot == RX_SLOT_WIN_CLASS_C )
+    if( MacCtx->RxSlot == RX_SLOT_WIN_CLASS_C )
     {
         OpenContinuousRxCWindow( );
     }
@@ -1684,8 +1741,12 @@ void LoRaMacProcess( void )
 
 static void OnTxDelayedTimerEvent( void* context )
 {
-    TimerStop( &MacCtx.TxDelayedTimer );
-    MacCtx.MacState &= ~LORAMAC_TX_DELAYED;
+    void* selected = LoRaMacInstanceGetSelected( );
+
+    LoRaMacInstanceSelect( context );
+
+    TimerStop( &MacCtx->TxDelayedTimer );
+    MacCtx->MacState &= ~LORAMAC_TX_DELAYED;
 
     // Schedule frame, allow delayed frame transmissions
     switch( ScheduleTx( true ) )
@@ -1698,62 +1759,81 @@ static void OnTxDelayedTimerEvent( void* context )
         default:
         {
             // Stop retransmission attempt
-            MacCtx.McpsConfirm.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-            MacCtx.McpsConfirm.NbRetries = MacCtx.AckTimeoutRetriesCounter;
-            MacCtx.McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_TX_DR_PAYLOAD_SIZE_ERROR;
+            MacCtx->McpsConfirm.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+            MacCtx->McpsConfirm.NbRetries = MacCtx->AckTimeoutRetriesCounter;
+            MacCtx->McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_TX_DR_PAYLOAD_SIZE_ERROR;
             LoRaMacConfirmQueueSetStatusCmn( LORAMAC_EVENT_INFO_STATUS_TX_DR_PAYLOAD_SIZE_ERROR );
             StopRetransmission( );
             break;
         }
     }
+
+    LoRaMacInstanceSelect( selected );
 }
 
 static void OnRxWindow1TimerEvent( void* context )
 {
-    MacCtx.RxWindow1Config.Channel = MacCtx.Channel;
-    MacCtx.RxWindow1Config.DrOffset = MacCtx.NvmCtx->MacParams.Rx1DrOffset;
-    MacCtx.RxWindow1Config.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
-    MacCtx.RxWindow1Config.RepeaterSupport = MacCtx.NvmCtx->RepeaterSupport;
-    MacCtx.RxWindow1Config.RxContinuous = false;
-    MacCtx.RxWindow1Config.RxSlot = RX_SLOT_WIN_1;
-
-    RxWindowSetup( &MacCtx.RxWindowTimer1, &MacCtx.RxWindow1Config );
+    void* selected = LoRaMacInstanceGetSelected( );
+
+    LoRaMacInstanceSelect( context );
+
+    MacCtx->RxWindow1Config.Channel = MacCtx->Channel;
+    MacCtx->RxWindow1Config.DrOffset = MacCtx->NvmCtx->MacParams.Rx1DrOffset;
+    MacCtx->RxWindow1Config.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
+    MacCtx->RxWindow1Config.RepeaterSupport = MacCtx->NvmCtx->RepeaterSupport;
+    MacCtx->RxWindow1Config.RxContinuous = false;
+    MacCtx->RxWindow1Config.RxSlot = RX_SLOT_WIN_1;
+
+    RxWindowSetup( &MacCtx->RxWindowTimer1, &MacCtx->RxWindow1Config );
+
+    LoRaMacInstanceSelect( selected );
 }
 
 static void OnRxWindow2TimerEvent( void* context )
 {
+    void* selected = LoRaMacInstanceGetSelected( );
+
+    LoRaMacInstanceSelect( context );
+
     // Check if we are processing Rx1 window.
     // If yes, we don't setup the Rx2 window.
-    if( MacCtx.RxSlot == RX_SLOT_WIN_1 )
+    if( MacCtx->RxSlot != RX_SLOT_WIN_1 )
     {
-        return;
+        MacCtx->RxWindow2Config.Channel = MacCtx->Channel;
+        MacCtx->RxWindow2Config.Frequency = MacCtx->NvmCtx->MacParams.Rx2Channel.Frequency;
+        MacCtx->RxWindow2Config.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
+        MacCtx->RxWindow2Config.RepeaterSupport = MacCtx->NvmCtx->RepeaterSupport;
+        MacCtx->RxWindow2Config.RxContinuous = false;
+        MacCtx->RxWindow2Config.RxSlot = RX_SLOT_WIN_2;
+
+        RxWindowSetup( &MacCtx->RxWindowTimer2, &MacCtx->RxWindow2Config );
     }
-    MacCtx.RxWindow2Config.Channel = MacCtx.Channel;
-    MacCtx.RxWindow2Config.Frequency = MacCtx.NvmCtx->MacParams.Rx2Channel.Frequency;
-    MacCtx.RxWindow2Config.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
-    MacCtx.RxWindow2Config.RepeaterSupport = MacCtx.NvmCtx->RepeaterSupport;
-    MacCtx.RxWindow2Config.RxContinuous = false;
-    MacCtx.RxWindow2Config.RxSlot = RX_SLOT_WIN_2;
 
-    RxWindowSetup( &MacCtx.RxWindowTimer2, &MacCtx.RxWindow2Config );
+    LoRaMacInstanceSelect( selected );
 }
 
 static void OnAckTimeoutTimerEvent( void* context )
 {
-    TimerStop( &MacCtx.AckTimeoutTimer );
+    void* selected = LoRaMacInstanceGetSelected( );
+
+    LoRaMacInstanceSelect( context );
+
+    TimerStop( &MacCtx->AckTimeoutTimer );
 
-    if( MacCtx.NodeAckRequested == true )
+    if( MacCtx->NodeAckRequested == true )
     {
-        MacCtx.AckTimeoutRetry = true;
+        MacCtx->AckTimeoutRetry = true;
     }
-    if( MacCtx.NvmCtx->DeviceClass == CLASS_C )
+    if( MacCtx->NvmCtx->DeviceClass == CLASS_C )
     {
-        MacCtx.MacFlags.Bits.MacDone = 1;
+        MacCtx->MacFlags.Bits.MacDone = 1;
     }
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
+    if( ( MacCtx->MacCallbacks != NULL ) && ( MacCtx->MacCallbacks->MacProcessNotify != NULL ) )
     {
-        MacCtx.MacCallbacks->MacProcessNotify( );
+        MacCtx->MacCallbacks->MacProcessNotify( );
     }
+
+    LoRaMacInstanceSelect( selected );
 }
 
 static LoRaMacCryptoStatus_t GetFCntDown( AddressIdentifier_t addrID, FType_t fType, LoRaMacMessageData_t* macMsg, Version_t lrWanVersion,
@@ -1808,51 +1888,51 @@ static LoRaMacStatus_t SwitchClass( DeviceClass_t deviceClass )
 {
     LoRaMacStatus_t status = LORAMAC_STATUS_PARAMETER_INVALID;
 
-    switch( MacCtx.NvmCtx->DeviceClass )
+    switch( MacCtx->NvmCtx->DeviceClass )
     {
         case CLASS_A:
         {
             if( deviceClass == CLASS_A )
             {
                 // Revert back RxC parameters
-                MacCtx.NvmCtx->MacParams.RxCChannel = MacCtx.NvmCtx->MacParams.Rx2Channel;
+                MacCtx->NvmCtx->MacParams.RxCChannel = MacCtx->NvmCtx->MacParams.Rx2Channel;
             }
             if( deviceClass == CLASS_B )
             {
                 status = LoRaMacClassBSwitchClass( deviceClass );
                 if( status == LORAMAC_STATUS_OK )
                 {
-                    MacCtx.NvmCtx->DeviceClass = deviceClass;
+                    MacCtx->NvmCtx->DeviceClass = deviceClass;
                 }
             }
 
             if( deviceClass == CLASS_C )
             {
-                MacCtx.NvmCtx->DeviceClass = deviceClass;
+                MacCtx->NvmCtx->DeviceClass = deviceClass;
 
-                MacCtx.RxWindowCConfig = MacCtx.RxWindow2Config;
-                MacCtx.RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
+                MacCtx->RxWindowCConfig = MacCtx->RxWindow2Config;
+                MacCtx->RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
 
                 for( int8_t i = 0; i < LORAMAC_MAX_MC_CTX; i++ )
                 {
-                    if( MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.IsEnabled == true )
+                    if( MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.IsEnabled == true )
                     // TODO: Check multicast channel device class.
                     {
-                        MacCtx.NvmCtx->MacParams.RxCChannel.Frequency = MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.RxParams.ClassC.Frequency;
-                        MacCtx.NvmCtx->MacParams.RxCChannel.Datarate = MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.RxParams.ClassC.Datarate;
-
-                        MacCtx.RxWindowCConfig.Channel = MacCtx.Channel;
-                        MacCtx.RxWindowCConfig.Frequency = MacCtx.NvmCtx->MacParams.RxCChannel.Frequency;
-                        MacCtx.RxWindowCConfig.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
-                        MacCtx.RxWindowCConfig.RepeaterSupport = MacCtx.NvmCtx->RepeaterSupport;
-                        MacCtx.RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C_MULTICAST;
-                        MacCtx.RxWindowCConfig.RxContinuous = true;
+                        MacCtx->NvmCtx->MacParams.RxCChannel.Frequency = MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.RxParams.ClassC.Frequency;
+                        MacCtx->NvmCtx->MacParams.RxCChannel.Datarate = MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.RxParams.ClassC.Datarate;
+
+                        MacCtx->RxWindowCConfig.Channel = MacCtx->Channel;
+                        MacCtx->RxWindowCConfig.Frequency = MacCtx->NvmCtx->MacParams.RxCChannel.Frequency;
+                        MacCtx->RxWindowCConfig.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
+                        MacCtx->RxWindowCConfig.RepeaterSupport = MacCtx->NvmCtx->RepeaterSupport;
+                        MacCtx->RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C_MULTICAST;
+                        MacCtx->RxWindowCConfig.RxContinuous = true;
                         break;
                     }
                 }
 
                 // Set the NodeAckRequested indicator to default
-                MacCtx.NodeAckRequested = false;
+                MacCtx->NodeAckRequested = false;
                 // Set the radio into sleep mode in case we are still in RX mode
                 Radio.Sleep( );
 
@@ -1867,7 +1947,7 @@ static LoRaMacStatus_t SwitchClass( DeviceClass_t deviceClass )
             status = LoRaMacClassBSwitchClass( deviceClass );
             if( status == LORAMAC_STATUS_OK )
             {
-                MacCtx.NvmCtx->DeviceClass = deviceClass;
+                MacCtx->NvmCtx->DeviceClass = deviceClass;
             }
             break;
         }
@@ -1875,7 +1955,7 @@ static LoRaMacStatus_t SwitchClass( DeviceClass_t deviceClass )
         {
             if( deviceClass == CLASS_A )
             {
-                MacCtx.NvmCtx->DeviceClass = deviceClass;
+                MacCtx->NvmCtx->DeviceClass = deviceClass;
 
                 // Set the radio into sleep to setup a defined state
                 Radio.Sleep( );
@@ -1895,16 +1975,16 @@ static uint8_t GetMaxAppPayloadWithoutFOptsLength( int8_t datarate )
     PhyParam_t phyParam;
 
     // Setup PHY request
-    getPhy.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
+    getPhy.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
     getPhy.Datarate = datarate;
     getPhy.Attribute = PHY_MAX_PAYLOAD;
 
     // Get the maximum payload length
-    if( MacCtx.NvmCtx->RepeaterSupport == true )
+    if( MacCtx->NvmCtx->RepeaterSupport == true )
     {
         getPhy.Attribute = PHY_MAX_PAYLOAD_REPEATER;
     }
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
 
     return phyParam.Value;
 }
@@ -1929,7 +2009,7 @@ static bool ValidatePayloadLength( uint8_t lenN, int8_t datarate, uint8_t fOptsL
 
 static void SetMlmeScheduleUplinkIndication( void )
 {
-    MacCtx.MacFlags.Bits.MlmeSchedUplinkInd = 1;
+    MacCtx->MacFlags.Bits.MlmeSchedUplinkInd = 1;
 }
 
 static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t commandsSize, int8_t snr, LoRaMacRxSlot_t rxSlot )
@@ -1948,8 +2028,8 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                 if( LoRaMacConfirmQueueIsCmdActive( MLME_LINK_CHECK ) == true )
                 {
                     LoRaMacConfirmQueueSetStatus( LORAMAC_EVENT_INFO_STATUS_OK, MLME_LINK_CHECK );
-                    MacCtx.MlmeConfirm.DemodMargin = payload[macIndex++];
-                    MacCtx.MlmeConfirm.NbGateways = payload[macIndex++];
+                    MacCtx->MlmeConfirm.DemodMargin = payload[macIndex++];
+                    MacCtx->MlmeConfirm.NbGateways = payload[macIndex++];
                 }
                 break;
             }
@@ -1968,22 +2048,22 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                     // Fill parameter structure
                     linkAdrReq.Payload = &payload[macIndex - 1];
                     linkAdrReq.PayloadSize = commandsSize - ( macIndex - 1 );
-                    linkAdrReq.AdrEnabled = MacCtx.NvmCtx->AdrCtrlOn;
-                    linkAdrReq.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
-                    linkAdrReq.CurrentDatarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-                    linkAdrReq.CurrentTxPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
-                    linkAdrReq.CurrentNbRep = MacCtx.NvmCtx->MacParams.ChannelsNbTrans;
-                    linkAdrReq.Version = MacCtx.NvmCtx->Version;
+                    linkAdrReq.AdrEnabled = MacCtx->NvmCtx->AdrCtrlOn;
+                    linkAdrReq.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
+                    linkAdrReq.CurrentDatarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+                    linkAdrReq.CurrentTxPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
+                    linkAdrReq.CurrentNbRep = MacCtx->NvmCtx->MacParams.ChannelsNbTrans;
+                    linkAdrReq.Version = MacCtx->NvmCtx->Version;
 
                     // Process the ADR requests
-                    status = RegionLinkAdrReq( MacCtx.NvmCtx->Region, &linkAdrReq, &linkAdrDatarate,
+                    status = RegionLinkAdrReq( MacCtx->NvmCtx->Region, &linkAdrReq, &linkAdrDatarate,
                                                &linkAdrTxPower, &linkAdrNbRep, &linkAdrNbBytesParsed );
 
                     if( ( status & 0x07 ) == 0x07 )
                     {
-                        MacCtx.NvmCtx->MacParams.ChannelsDatarate = linkAdrDatarate;
-                        MacCtx.NvmCtx->MacParams.ChannelsTxPower = linkAdrTxPower;
-                        MacCtx.NvmCtx->MacParams.ChannelsNbTrans = linkAdrNbRep;
+                        MacCtx->NvmCtx->MacParams.ChannelsDatarate = linkAdrDatarate;
+                        MacCtx->NvmCtx->MacParams.ChannelsTxPower = linkAdrTxPower;
+                        MacCtx->NvmCtx->MacParams.ChannelsNbTrans = linkAdrNbRep;
                     }
 
                     // Add the answers to the buffer
@@ -1998,8 +2078,8 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
             }
             case SRV_MAC_DUTY_CYCLE_REQ:
             {
-                MacCtx.NvmCtx->MaxDCycle = payload[macIndex++] & 0x0F;
-                MacCtx.NvmCtx->AggregatedDCycle = 1 << MacCtx.NvmCtx->MaxDCycle;
+                MacCtx->NvmCtx->MaxDCycle = payload[macIndex++] & 0x0F;
+                MacCtx->NvmCtx->AggregatedDCycle = 1 << MacCtx->NvmCtx->MaxDCycle;
                 LoRaMacCommandsAddCmd( MOTE_MAC_DUTY_CYCLE_ANS, macCmdPayload, 0 );
                 break;
             }
@@ -2018,15 +2098,15 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                 rxParamSetupReq.Frequency *= 100;
 
                 // Perform request on region
-                status = RegionRxParamSetupReq( MacCtx.NvmCtx->Region, &rxParamSetupReq );
+                status = RegionRxParamSetupReq( MacCtx->NvmCtx->Region, &rxParamSetupReq );
 
                 if( ( status & 0x07 ) == 0x07 )
                 {
-                    MacCtx.NvmCtx->MacParams.Rx2Channel.Datarate = rxParamSetupReq.Datarate;
-                    MacCtx.NvmCtx->MacParams.RxCChannel.Datarate = rxParamSetupReq.Datarate;
-                    MacCtx.NvmCtx->MacParams.Rx2Channel.Frequency = rxParamSetupReq.Frequency;
-                    MacCtx.NvmCtx->MacParams.RxCChannel.Frequency = rxParamSetupReq.Frequency;
-                    MacCtx.NvmCtx->MacParams.Rx1DrOffset = rxParamSetupReq.DrOffset;
+                    MacCtx->NvmCtx->MacParams.Rx2Channel.Datarate = rxParamSetupReq.Datarate;
+                    MacCtx->NvmCtx->MacParams.RxCChannel.Datarate = rxParamSetupReq.Datarate;
+                    MacCtx->NvmCtx->MacParams.Rx2Channel.Frequency = rxParamSetupReq.Frequency;
+                    MacCtx->NvmCtx->MacParams.RxCChannel.Frequency = rxParamSetupReq.Frequency;
+                    MacCtx->NvmCtx->MacParams.Rx1DrOffset = rxParamSetupReq.DrOffset;
                 }
                 macCmdPayload[0] = status;
                 LoRaMacCommandsAddCmd( MOTE_MAC_RX_PARAM_SETUP_ANS, macCmdPayload, 1 );
@@ -2037,9 +2117,9 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
             case SRV_MAC_DEV_STATUS_REQ:
             {
                 uint8_t batteryLevel = BAT_LEVEL_NO_MEASURE;
-                if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->GetBatteryLevel != NULL ) )
+                if( ( MacCtx->MacCallbacks != NULL ) && ( MacCtx->MacCallbacks->GetBatteryLevel != NULL ) )
                 {
-                    batteryLevel = MacCtx.MacCallbacks->GetBatteryLevel( );
+                    batteryLevel = MacCtx->MacCallbacks->GetBatteryLevel( );
                 }
                 macCmdPayload[0] = batteryLevel;
                 macCmdPayload[1] = ( uint8_t )( snr & 0x3F );
@@ -2062,7 +2142,7 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                 chParam.Rx1Frequency = 0;
                 chParam.DrRange.Value = payload[macIndex++];
 
-                status = RegionNewChannelReq( MacCtx.NvmCtx->Region, &newChannelReq );
+                status = RegionNewChannelReq( MacCtx->NvmCtx->Region, &newChannelReq );
 
                 macCmdPayload[0] = status;
                 LoRaMacCommandsAddCmd( MOTE_MAC_NEW_CHANNEL_ANS, macCmdPayload, 1 );
@@ -2076,8 +2156,8 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                 {
                     delay++;
                 }
-                MacCtx.NvmCtx->MacParams.ReceiveDelay1 = delay * 1000;
-                MacCtx.NvmCtx->MacParams.ReceiveDelay2 = MacCtx.NvmCtx->MacParams.ReceiveDelay1 + 1000;
+                MacCtx->NvmCtx->MacParams.ReceiveDelay1 = delay * 1000;
+                MacCtx->NvmCtx->MacParams.ReceiveDelay2 = MacCtx->NvmCtx->MacParams.ReceiveDelay1 + 1000;
                 LoRaMacCommandsAddCmd( MOTE_MAC_RX_TIMING_SETUP_ANS, macCmdPayload, 0 );
                 // Setup indication to inform the application
                 SetMlmeScheduleUplinkIndication( );
@@ -2104,17 +2184,17 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                 txParamSetupReq.MaxEirp = eirpDwellTime & 0x0F;
 
                 // Check the status for correctness
-                if( RegionTxParamSetupReq( MacCtx.NvmCtx->Region, &txParamSetupReq ) != -1 )
+                if( RegionTxParamSetupReq( MacCtx->NvmCtx->Region, &txParamSetupReq ) != -1 )
                 {
                     // Accept command
-                    MacCtx.NvmCtx->MacParams.UplinkDwellTime = txParamSetupReq.UplinkDwellTime;
-                    MacCtx.NvmCtx->MacParams.DownlinkDwellTime = txParamSetupReq.DownlinkDwellTime;
-                    MacCtx.NvmCtx->MacParams.MaxEirp = LoRaMacMaxEirpTable[txParamSetupReq.MaxEirp];
+                    MacCtx->NvmCtx->MacParams.UplinkDwellTime = txParamSetupReq.UplinkDwellTime;
+                    MacCtx->NvmCtx->MacParams.DownlinkDwellTime = txParamSetupReq.DownlinkDwellTime;
+                    MacCtx->NvmCtx->MacParams.MaxEirp = LoRaMacMaxEirpTable[txParamSetupReq.MaxEirp];
                     // Update the datarate in case of the new configuration limits it
                     getPhy.Attribute = PHY_MIN_TX_DR;
-                    getPhy.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
-                    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-                    MacCtx.NvmCtx->MacParams.ChannelsDatarate = MAX( MacCtx.NvmCtx->MacParams.ChannelsDatarate, ( int8_t )phyParam.Value );
+                    getPhy.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
+                    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+                    MacCtx->NvmCtx->MacParams.ChannelsDatarate = MAX( MacCtx->NvmCtx->MacParams.ChannelsDatarate, ( int8_t )phyParam.Value );
 
                     // Add command response
                     LoRaMacCommandsAddCmd( MOTE_MAC_TX_PARAM_SETUP_ANS, macCmdPayload, 0 );
@@ -2132,7 +2212,7 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                 dlChannelReq.Rx1Frequency |= ( uint32_t ) payload[macIndex++] << 16;
                 dlChannelReq.Rx1Frequency *= 100;
 
-                status = RegionDlChannelReq( MacCtx.NvmCtx->Region, &dlChannelReq );
+                status = RegionDlChannelReq( MacCtx->NvmCtx->Region, &dlChannelReq );
                 macCmdPayload[0] = status;
                 LoRaMacCommandsAddCmd( MOTE_MAC_DL_CHANNEL_ANS, macCmdPayload, 1 );
                 // Setup indication to inform the application
@@ -2162,19 +2242,19 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
 
                 // Compensate time difference between Tx Done time and now
                 sysTimeCurrent = SysTimeGet( );
-                sysTime = SysTimeAdd( sysTimeCurrent, SysTimeSub( sysTime, MacCtx.LastTxSysTime ) );
+                sysTime = SysTimeAdd( sysTimeCurrent, SysTimeSub( sysTime, MacCtx->LastTxSysTime ) );
 
                 // Apply the new system time.
                 SysTimeSet( sysTime );
                 LoRaMacClassBDeviceTimeAns( );
-                MacCtx.McpsIndication.DeviceTimeAnsReceived = true;
+                MacCtx->McpsIndication.DeviceTimeAnsReceived = true;
                 break;
             }
             case SRV_MAC_PING_SLOT_INFO_ANS:
             {
                 // According to the specification, it is not allowed to process this answer in
                 // a ping or multicast slot
-                if( ( MacCtx.RxSlot != RX_SLOT_WIN_CLASS_B_PING_SLOT ) && ( MacCtx.RxSlot != RX_SLOT_WIN_CLASS_B_MULTICAST_SLOT ) )
+                if( ( MacCtx->RxSlot != RX_SLOT_WIN_CLASS_B_PING_SLOT ) && ( MacCtx->RxSlot != RX_SLOT_WIN_CLASS_B_MULTICAST_SLOT ) )
                 {
                     LoRaMacClassBPingSlotInfoAns( );
                 }
@@ -2206,7 +2286,7 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                 beaconTimingDelay |= ( uint16_t )payload[macIndex++] << 8;
                 beaconTimingChannel = payload[macIndex++];
 
-                LoRaMacClassBBeaconTimingAns( beaconTimingDelay, beaconTimingChannel, RxDoneParams.LastRxDone );
+                LoRaMacClassBBeaconTimingAns( beaconTimingDelay, beaconTimingChannel, RxDoneParams->LastRxDone );
                 break;
             }
             case SRV_MAC_BEACON_FREQ_REQ:
@@ -2240,27 +2320,27 @@ LoRaMacStatus_t Send( LoRaMacHeader_t* macHdr, uint8_t fPort, void* fBuffer, uin
 {
     LoRaMacFrameCtrl_t fCtrl;
     LoRaMacStatus_t status = LORAMAC_STATUS_PARAMETER_INVALID;
-    int8_t datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    int8_t txPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
-    uint32_t adrAckCounter = MacCtx.NvmCtx->AdrAckCounter;
+    int8_t datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    int8_t txPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
+    uint32_t adrAckCounter = MacCtx->NvmCtx->AdrAckCounter;
     CalcNextAdrParams_t adrNext;
 
     // Check if we are joined
-    if( MacCtx.NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
+    if( MacCtx->NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
     {
         return LORAMAC_STATUS_NO_NETWORK_JOINED;
     }
-    if( MacCtx.NvmCtx->MaxDCycle == 0 )
+    if( MacCtx->NvmCtx->MaxDCycle == 0 )
     {
-        MacCtx.NvmCtx->AggregatedTimeOff = 0;
+        MacCtx->NvmCtx->AggregatedTimeOff = 0;
     }
 
     fCtrl.Value = 0;
     fCtrl.Bits.FOptsLen      = 0;
-    fCtrl.Bits.Adr           = MacCtx.NvmCtx->AdrCtrlOn;
+    fCtrl.Bits.Adr           = MacCtx->NvmCtx->AdrCtrlOn;
 
     // Check class b
-    if( MacCtx.NvmCtx->DeviceClass == CLASS_B )
+    if( MacCtx->NvmCtx->DeviceClass == CLASS_B )
     {
         fCtrl.Bits.FPending      = 1;
     }
@@ -2270,25 +2350,25 @@ LoRaMacStatus_t Send( LoRaMacHeader_t* macHdr, uint8_t fPort, void* fBuffer, uin
     }
 
     // Check server ack
-    if( MacCtx.NvmCtx->SrvAckRequested == true )
+    if( MacCtx->NvmCtx->SrvAckRequested == true )
     {
         fCtrl.Bits.Ack = 1;
     }
 
     // ADR next request
-    adrNext.Version = MacCtx.NvmCtx->Version;
+    adrNext.Version = MacCtx->NvmCtx->Version;
     adrNext.UpdateChanMask = true;
     adrNext.AdrEnabled = fCtrl.Bits.Adr;
-    adrNext.AdrAckCounter = MacCtx.NvmCtx->AdrAckCounter;
-    adrNext.AdrAckLimit = MacCtx.AdrAckLimit;
-    adrNext.AdrAckDelay = MacCtx.AdrAckDelay;
-    adrNext.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    adrNext.TxPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
-    adrNext.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
-    adrNext.Region = MacCtx.NvmCtx->Region;
+    adrNext.AdrAckCounter = MacCtx->NvmCtx->AdrAckCounter;
+    adrNext.AdrAckLimit = MacCtx->AdrAckLimit;
+    adrNext.AdrAckDelay = MacCtx->AdrAckDelay;
+    adrNext.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    adrNext.TxPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
+    adrNext.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
+    adrNext.Region = MacCtx->NvmCtx->Region;
 
-    fCtrl.Bits.AdrAckReq = LoRaMacAdrCalcNext( &adrNext, &MacCtx.NvmCtx->MacParams.ChannelsDatarate,
-                                               &MacCtx.NvmCtx->MacParams.ChannelsTxPower, &adrAckCounter );
+    fCtrl.Bits.AdrAckReq = LoRaMacAdrCalcNext( &adrNext, &MacCtx->NvmCtx->MacParams.ChannelsDatarate,
+                                               &MacCtx->NvmCtx->MacParams.ChannelsTxPower, &adrAckCounter );
 
     // Prepare the frame
     status = PrepareFrame( macHdr, &fCtrl, fPort, fBuffer, fBufferSize );
@@ -2305,14 +2385,14 @@ LoRaMacStatus_t Send( LoRaMacHeader_t* macHdr, uint8_t fPort, void* fBuffer, uin
     {
         // Bad case - restore
         // Store local variables
-        MacCtx.NvmCtx->MacParams.ChannelsDatarate = datarate;
-        MacCtx.NvmCtx->MacParams.ChannelsTxPower = txPower;
+        MacCtx->NvmCtx->MacParams.ChannelsDatarate = datarate;
+        MacCtx->NvmCtx->MacParams.ChannelsTxPower = txPower;
     }
     else
     {
         // Good case
-        MacCtx.NvmCtx->SrvAckRequested = false;
-        MacCtx.NvmCtx->AdrAckCounter = adrAckCounter;
+        MacCtx->NvmCtx->SrvAckRequested = false;
+        MacCtx->NvmCtx->AdrAckCounter = adrAckCounter;
         // Remove all none sticky MAC commands
         if( LoRaMacCommandsRemoveNoneStickyCmds( ) != LORAMAC_COMMANDS_SUCCESS )
         {
@@ -2336,15 +2416,15 @@ LoRaMacStatus_t SendReJoinReq( JoinReqIdentifier_t joinReqType )
         {
             SwitchClass( CLASS_A );
 
-            MacCtx.TxMsg.Type = LORAMAC_MSG_TYPE_JOIN_REQUEST;
-            MacCtx.TxMsg.Message.JoinReq.Buffer = MacCtx.PktBuffer;
-            MacCtx.TxMsg.Message.JoinReq.BufSize = LORAMAC_PHY_MAXPAYLOAD;
+            MacCtx->TxMsg.Type = LORAMAC_MSG_TYPE_JOIN_REQUEST;
+            MacCtx->TxMsg.Message.JoinReq.Buffer = MacCtx->PktBuffer;
+            MacCtx->TxMsg.Message.JoinReq.BufSize = LORAMAC_PHY_MAXPAYLOAD;
 
             macHdr.Bits.MType = FRAME_TYPE_JOIN_REQ;
-            MacCtx.TxMsg.Message.JoinReq.MHDR.Value = macHdr.Value;
+            MacCtx->TxMsg.Message.JoinReq.MHDR.Value = macHdr.Value;
 
-            memcpy1( MacCtx.TxMsg.Message.JoinReq.JoinEUI, SecureElementGetJoinEui( ), LORAMAC_JOIN_EUI_FIELD_SIZE );
-            memcpy1( MacCtx.TxMsg.Message.JoinReq.DevEUI, SecureElementGetDevEui( ), LORAMAC_DEV_EUI_FIELD_SIZE );
+            memcpy1( MacCtx->TxMsg.Message.JoinReq.JoinEUI, SecureElementGetJoinEui( ), LORAMAC_JOIN_EUI_FIELD_SIZE );
+            memcpy1( MacCtx->TxMsg.Message.JoinReq.DevEUI, SecureElementGetDevEui( ), LORAMAC_DEV_EUI_FIELD_SIZE );
 
             allowDelayedTx = false;
 
@@ -2367,7 +2447,7 @@ static LoRaMacStatus_t CheckForClassBCollision( void )
         return LORAMAC_STATUS_BUSY_BEACON_RESERVED_TIME;
     }
 
-    if( MacCtx.NvmCtx->DeviceClass == CLASS_B )
+    if( MacCtx->NvmCtx->DeviceClass == CLASS_B )
     {
         if( LoRaMacClassBIsPingExpected( ) == true )
         {
@@ -2397,12 +2477,12 @@ static LoRaMacStatus_t ScheduleTx( bool allowDelayedTx )
     }
 
     // Update back-off
-    CalculateBackOff( MacCtx.NvmCtx->LastTxChannel );
+    CalculateBackOff( MacCtx->NvmCtx->LastTxChannel );
 
-    nextChan.AggrTimeOff = MacCtx.NvmCtx->AggregatedTimeOff;
-    nextChan.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    nextChan.DutyCycleEnabled = MacCtx.NvmCtx->DutyCycleOn;
-    if( MacCtx.NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
+    nextChan.AggrTimeOff = MacCtx->NvmCtx->AggregatedTimeOff;
+    nextChan.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    nextChan.DutyCycleEnabled = MacCtx->NvmCtx->DutyCycleOn;
+    if( MacCtx->NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
     {
         nextChan.Joined = false;
     }
@@ -2410,10 +2490,10 @@ static LoRaMacStatus_t ScheduleTx( bool allowDelayedTx )
     {
         nextChan.Joined = true;
     }
-    nextChan.LastAggrTx = MacCtx.NvmCtx->LastTxDoneTime;
+    nextChan.LastAggrTx = MacCtx->NvmCtx->LastTxDoneTime;
 
     // Select channel
-    status = RegionNextChannel( MacCtx.NvmCtx->Region, &nextChan, &MacCtx.Channel, &dutyCycleTimeOff, &MacCtx.NvmCtx->AggregatedTimeOff );
+    status = RegionNextChannel( MacCtx->NvmCtx->Region, &nextChan, &MacCtx->Channel, &dutyCycleTimeOff, &MacCtx->NvmCtx->AggregatedTimeOff );
 
     if( status != LORAMAC_STATUS_OK )
     {
@@ -2424,9 +2504,9 @@ static LoRaMacStatus_t ScheduleTx( bool allowDelayedTx )
             // the MAC must retransmit a frame with the frame repetitions
             if( dutyCycleTimeOff != 0 )
             {// Send later - prepare timer
-                MacCtx.MacState |= LORAMAC_TX_DELAYED;
-                TimerSetValue( &MacCtx.TxDelayedTimer, dutyCycleTimeOff );
-                TimerStart( &MacCtx.TxDelayedTimer );
+                MacCtx->MacState |= LORAMAC_TX_DELAYED;
+                TimerSetValue( &MacCtx->TxDelayedTimer, dutyCycleTimeOff );
+                TimerStart( &MacCtx->TxDelayedTimer );
             }
             return LORAMAC_STATUS_OK;
         }
@@ -2437,22 +2517,22 @@ static LoRaMacStatus_t ScheduleTx( bool allowDelayedTx )
     }
 
     // Compute Rx1 windows parameters
-    RegionComputeRxWindowParameters( MacCtx.NvmCtx->Region,
-                                     RegionApplyDrOffset( MacCtx.NvmCtx->Region, MacCtx.NvmCtx->MacParams.DownlinkDwellTime, MacCtx.NvmCtx->MacParams.ChannelsDatarate, MacCtx.NvmCtx->MacParams.Rx1DrOffset ),
-                                     MacCtx.NvmCtx->MacParams.MinRxSymbols,
-                                     MacCtx.NvmCtx->MacParams.SystemMaxRxError,
-                                     &MacCtx.RxWindow1Config );
+    RegionComputeRxWindowParameters( MacCtx->NvmCtx->Region,
+                                     RegionApplyDrOffset( MacCtx->NvmCtx->Region, MacCtx->NvmCtx->MacParams.DownlinkDwellTime, MacCtx->NvmCtx->MacParams.ChannelsDatarate, MacCtx->NvmCtx->MacParams.Rx1DrOffset ),
+                                     MacCtx->NvmCtx->MacParams.MinRxSymbols,
+                                     MacCtx->NvmCtx->MacParams.SystemMaxRxError,
+                                     &MacCtx->RxWindow1Config );
     // Compute Rx2 windows parameters
-    RegionComputeRxWindowParameters( MacCtx.NvmCtx->Region,
-                                     MacCtx.NvmCtx->MacParams.Rx2Channel.Datarate,
-                                     MacCtx.NvmCtx->MacParams.MinRxSymbols,
-                                     MacCtx.NvmCtx->MacParams.SystemMaxRxError,
-                                     &MacCtx.RxWindow2Config );
+    RegionComputeRxWindowParameters( MacCtx->NvmCtx->Region,
+                                     MacCtx->NvmCtx->MacParams.Rx2Channel.Datarate,
+                                     MacCtx->NvmCtx->MacParams.MinRxSymbols,
+                                     MacCtx->NvmCtx->MacParams.SystemMaxRxError,
+                                     &MacCtx->RxWindow2Config );
 
-    if( MacCtx.NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
+    if( MacCtx->NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
     {
-        MacCtx.RxWindow1Delay = MacCtx.NvmCtx->MacParams.JoinAcceptDelay1 + MacCtx.RxWindow1Config.WindowOffset;
-        MacCtx.RxWindow2Delay = MacCtx.NvmCtx->MacParams.JoinAcceptDelay2 + MacCtx.RxWindow2Config.WindowOffset;
+        MacCtx->RxWindow1Delay = MacCtx->NvmCtx->MacParams.JoinAcceptDelay1 + MacCtx->RxWindow1Config.WindowOffset;
+        MacCtx->RxWindow2Delay = MacCtx->NvmCtx->MacParams.JoinAcceptDelay2 + MacCtx->RxWindow2Config.WindowOffset;
     }
     else
     {
@@ -2461,23 +2541,23 @@ static LoRaMacStatus_t ScheduleTx( bool allowDelayedTx )
             return LORAMAC_STATUS_MAC_COMMAD_ERROR;
         }
 
-        if( ValidatePayloadLength( MacCtx.AppDataSize, MacCtx.NvmCtx->MacParams.ChannelsDatarate, macCmdsSize ) == false )
+        if( ValidatePayloadLength( MacCtx->AppDataSize, MacCtx->NvmCtx->MacParams.ChannelsDatarate, macCmdsSize ) == false )
         {
             return LORAMAC_STATUS_LENGTH_ERROR;
         }
-        MacCtx.RxWindow1Delay = MacCtx.NvmCtx->MacParams.ReceiveDelay1 + MacCtx.RxWindow1Config.WindowOffset;
-        MacCtx.RxWindow2Delay = MacCtx.NvmCtx->MacParams.ReceiveDelay2 + MacCtx.RxWindow2Config.WindowOffset;
+        MacCtx->RxWindow1Delay = MacCtx->NvmCtx->MacParams.ReceiveDelay1 + MacCtx->RxWindow1Config.WindowOffset;
+        MacCtx->RxWindow2Delay = MacCtx->NvmCtx->MacParams.ReceiveDelay2 + MacCtx->RxWindow2Config.WindowOffset;
     }
 
     // Secure frame
-    LoRaMacStatus_t retval = SecureFrame( MacCtx.NvmCtx->MacParams.ChannelsDatarate, MacCtx.Channel );
+    LoRaMacStatus_t retval = SecureFrame( MacCtx->NvmCtx->MacParams.ChannelsDatarate, MacCtx->Channel );
     if( retval != LORAMAC_STATUS_OK )
     {
         return retval;
     }
 
     // Try to send now
-    return SendFrameOnChannel( MacCtx.Channel );
+    return SendFrameOnChannel( MacCtx->Channel );
 }
 
 static LoRaMacStatus_t SecureFrame( uint8_t txDr, uint8_t txCh )
@@ -2485,15 +2565,15 @@ static LoRaMacStatus_t SecureFrame( uint8_t txDr, uint8_t txCh )
     LoRaMacCryptoStatus_t macCryptoStatus = LORAMAC_CRYPTO_ERROR;
     uint32_t fCntUp = 0;
 
-    switch( MacCtx.TxMsg.Type )
+    switch( MacCtx->TxMsg.Type )
     {
         case LORAMAC_MSG_TYPE_JOIN_REQUEST:
-            macCryptoStatus = LoRaMacCryptoPrepareJoinRequest( &MacCtx.TxMsg.Message.JoinReq );
+            macCryptoStatus = LoRaMacCryptoPrepareJoinRequest( &MacCtx->TxMsg.Message.JoinReq );
             if( LORAMAC_CRYPTO_SUCCESS != macCryptoStatus )
             {
                 return LORAMAC_STATUS_CRYPTO_ERROR;
             }
-            MacCtx.PktBufferLen = MacCtx.TxMsg.Message.JoinReq.BufSize;
+            MacCtx->PktBufferLen = MacCtx->TxMsg.Message.JoinReq.BufSize;
             break;
         case LORAMAC_MSG_TYPE_DATA:
 
@@ -2502,17 +2582,17 @@ static LoRaMacStatus_t SecureFrame( uint8_t txDr, uint8_t txCh )
                 return LORAMAC_STATUS_FCNT_HANDLER_ERROR;
             }
 
-            if( ( MacCtx.ChannelsNbTransCounter >= 1 ) || ( MacCtx.AckTimeoutRetriesCounter > 1 ) )
+            if( ( MacCtx->ChannelsNbTransCounter >= 1 ) || ( MacCtx->AckTimeoutRetriesCounter > 1 ) )
             {
                 fCntUp -= 1;
             }
 
-            macCryptoStatus = LoRaMacCryptoSecureMessage( fCntUp, txDr, txCh, &MacCtx.TxMsg.Message.Data );
+            macCryptoStatus = LoRaMacCryptoSecureMessage( fCntUp, txDr, txCh, &MacCtx->TxMsg.Message.Data );
             if( LORAMAC_CRYPTO_SUCCESS != macCryptoStatus )
             {
                 return LORAMAC_STATUS_CRYPTO_ERROR;
             }
-            MacCtx.PktBufferLen = MacCtx.TxMsg.Message.Data.BufSize;
+            MacCtx->PktBufferLen = MacCtx->TxMsg.Message.Data.BufSize;
             break;
         case LORAMAC_MSG_TYPE_JOIN_ACCEPT:
         case LORAMAC_MSG_TYPE_UNDEF:
@@ -2526,7 +2606,7 @@ static void CalculateBackOff( uint8_t channel )
 {
     CalcBackOffParams_t calcBackOff;
 
-    if( MacCtx.NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
+    if( MacCtx->NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
     {
         calcBackOff.Joined = false;
     }
@@ -2534,22 +2614,22 @@ static void CalculateBackOff( uint8_t channel )
     {
         calcBackOff.Joined = true;
     }
-    calcBackOff.DutyCycleEnabled = MacCtx.NvmCtx->DutyCycleOn;
+    calcBackOff.DutyCycleEnabled = MacCtx->NvmCtx->DutyCycleOn;
     calcBackOff.Channel = channel;
-    calcBackOff.ElapsedTime = SysTimeSub( SysTimeGetMcuTime( ), MacCtx.NvmCtx->InitializationTime );
-    calcBackOff.TxTimeOnAir = MacCtx.TxTimeOnAir;
+    calcBackOff.ElapsedTime = SysTimeSub( SysTimeGetMcuTime( ), MacCtx->NvmCtx->InitializationTime );
+    calcBackOff.TxTimeOnAir = MacCtx->TxTimeOnAir;
     calcBackOff.LastTxIsJoinRequest = false;
-    if( ( MacCtx.MacFlags.Bits.MlmeReq == 1 ) && ( LoRaMacConfirmQueueIsCmdActive( MLME_JOIN ) == true ) )
+    if( ( MacCtx->MacFlags.Bits.MlmeReq == 1 ) && ( LoRaMacConfirmQueueIsCmdActive( MLME_JOIN ) == true ) )
     {
         calcBackOff.LastTxIsJoinRequest = true;
     }
 
     // Update regional back-off
-    RegionCalcBackOff( MacCtx.NvmCtx->Region, &calcBackOff );
+    RegionCalcBackOff( MacCtx->NvmCtx->Region, &calcBackOff );
 
     // Update aggregated time-off. This must be an assignment and no incremental
     // update as we do only calculate the time-off based on the last transmission
-    MacCtx.NvmCtx->AggregatedTimeOff = ( MacCtx.TxTimeOnAir * MacCtx.NvmCtx->AggregatedDCycle - MacCtx.TxTimeOnAir );
+    MacCtx->NvmCtx->AggregatedTimeOff = ( MacCtx->TxTimeOnAir * MacCtx->NvmCtx->AggregatedDCycle - MacCtx->TxTimeOnAir );
 }
 
 static void RemoveMacCommands( LoRaMacRxSlot_t rxSlot, LoRaMacFrameCtrl_t fCtrl, Mcps_t request )
@@ -2575,54 +2655,54 @@ static void RemoveMacCommands( LoRaMacRxSlot_t rxSlot, LoRaMacFrameCtrl_t fCtrl,
 
 static void ResetMacParameters( void )
 {
-    MacCtx.NvmCtx->NetworkActivation = ACTIVATION_TYPE_NONE;
+    MacCtx->NvmCtx->NetworkActivation = ACTIVATION_TYPE_NONE;
 
     // ADR counter
-    MacCtx.NvmCtx->AdrAckCounter = 0;
+    MacCtx->NvmCtx->AdrAckCounter = 0;
 
-    MacCtx.ChannelsNbTransCounter = 0;
-    MacCtx.AckTimeoutRetries = 1;
-    MacCtx.AckTimeoutRetriesCounter = 1;
-    MacCtx.AckTimeoutRetry = false;
+    MacCtx->ChannelsNbTransCounter = 0;
+    MacCtx->AckTimeoutRetries = 1;
+    MacCtx->AckTimeoutRetriesCounter = 1;
+    MacCtx->AckTimeoutRetry = false;
 
-    MacCtx.NvmCtx->MaxDCycle = 0;
-    MacCtx.NvmCtx->AggregatedDCycle = 1;
+    MacCtx->NvmCtx->MaxDCycle = 0;
+    MacCtx->NvmCtx->AggregatedDCycle = 1;
 
-    MacCtx.NvmCtx->MacParams.ChannelsTxPower = MacCtx.NvmCtx->MacParamsDefaults.ChannelsTxPower;
-    MacCtx.NvmCtx->MacParams.ChannelsDatarate = MacCtx.NvmCtx->MacParamsDefaults.ChannelsDatarate;
-    MacCtx.NvmCtx->MacParams.Rx1DrOffset = MacCtx.NvmCtx->MacParamsDefaults.Rx1DrOffset;
-    MacCtx.NvmCtx->MacParams.Rx2Channel = MacCtx.NvmCtx->MacParamsDefaults.Rx2Channel;
-    MacCtx.NvmCtx->MacParams.RxCChannel = MacCtx.NvmCtx->MacParamsDefaults.RxCChannel;
-    MacCtx.NvmCtx->MacParams.UplinkDwellTime = MacCtx.NvmCtx->MacParamsDefaults.UplinkDwellTime;
-    MacCtx.NvmCtx->MacParams.DownlinkDwellTime = MacCtx.NvmCtx->MacParamsDefaults.DownlinkDwellTime;
-    MacCtx.NvmCtx->MacParams.MaxEirp = MacCtx.NvmCtx->MacParamsDefaults.MaxEirp;
-    MacCtx.NvmCtx->MacParams.AntennaGain = MacCtx.NvmCtx->MacParamsDefaults.AntennaGain;
+    MacCtx->NvmCtx->MacParams.ChannelsTxPower = MacCtx->NvmCtx->MacParamsDefaults.ChannelsTxPower;
+    MacCtx->NvmCtx->MacParams.ChannelsDatarate = MacCtx->NvmCtx->MacParamsDefaults.ChannelsDatarate;
+    MacCtx->NvmCtx->MacParams.Rx1DrOffset = MacCtx->NvmCtx->MacParamsDefaults.Rx1DrOffset;
+    MacCtx->NvmCtx->MacParams.Rx2Channel = MacCtx->NvmCtx->MacParamsDefaults.Rx2Channel;
+    MacCtx->NvmCtx->MacParams.RxCChannel = MacCtx->NvmCtx->MacParamsDefaults.RxCChannel;
+    MacCtx->NvmCtx->MacParams.UplinkDwellTime = MacCtx->NvmCtx->MacParamsDefaults.UplinkDwellTime;
+    MacCtx->NvmCtx->MacParams.DownlinkDwellTime = MacCtx->NvmCtx->MacParamsDefaults.DownlinkDwellTime;
+    MacCtx->NvmCtx->MacParams.MaxEirp = MacCtx->NvmCtx->MacParamsDefaults.MaxEirp;
+    MacCtx->NvmCtx->MacParams.AntennaGain = MacCtx->NvmCtx->MacParamsDefaults.AntennaGain;
 
-    MacCtx.NodeAckRequested = false;
-    MacCtx.NvmCtx->SrvAckRequested = false;
+    MacCtx->NodeAckRequested = false;
+    MacCtx->NvmCtx->SrvAckRequested = false;
 
     // Reset to application defaults
     InitDefaultsParams_t params;
     params.Type = INIT_TYPE_RESTORE_DEFAULT_CHANNELS;
     params.NvmCtx = NULL;
-    RegionInitDefaults( MacCtx.NvmCtx->Region, &params );
+    RegionInitDefaults( MacCtx->NvmCtx->Region, &params );
 
     // Initialize channel index.
-    MacCtx.Channel = 0;
-    MacCtx.NvmCtx->LastTxChannel = MacCtx.Channel;
+    MacCtx->Channel = 0;
+    MacCtx->NvmCtx->LastTxChannel = MacCtx->Channel;
 
     // Initialize Rx2 config parameters.
-    MacCtx.RxWindow2Config.Channel = MacCtx.Channel;
-    MacCtx.RxWindow2Config.Frequency = MacCtx.NvmCtx->MacParams.Rx2Channel.Frequency;
-    MacCtx.RxWindow2Config.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
-    MacCtx.RxWindow2Config.RepeaterSupport = MacCtx.NvmCtx->RepeaterSupport;
-    MacCtx.RxWindow2Config.RxContinuous = false;
-    MacCtx.RxWindow2Config.RxSlot = RX_SLOT_WIN_2;
+    MacCtx->RxWindow2Config.Channel = MacCtx->Channel;
+    MacCtx->RxWindow2Config.Frequency = MacCtx->NvmCtx->MacParams.Rx2Channel.Frequency;
+    MacCtx->RxWindow2Config.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
+    MacCtx->RxWindow2Config.RepeaterSupport = MacCtx->NvmCtx->RepeaterSupport;
+    MacCtx->RxWindow2Config.RxContinuous = false;
+    MacCtx->RxWindow2Config.RxSlot = RX_SLOT_WIN_2;
 
     // Initialize RxC config parameters.
-    MacCtx.RxWindowCConfig = MacCtx.RxWindow2Config;
-    MacCtx.RxWindowCConfig.RxContinuous = true;
-    MacCtx.RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
+    MacCtx->RxWindowCConfig = MacCtx->RxWindow2Config;
+    MacCtx->RxWindowCConfig.RxContinuous = true;
+    MacCtx->RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
 
 }
 
@@ -2639,39 +2719,39 @@ static void RxWindowSetup( TimerEvent_t* rxTimer, RxConfigParams_t* rxConfig )
     // Ensure the radio is Idle
     Radio.Standby( );
 
-    if( RegionRxConfig( MacCtx.NvmCtx->Region, rxConfig, ( int8_t* )&MacCtx.McpsIndication.RxDatarate ) == true )
+    if( RegionRxConfig( MacCtx->NvmCtx->Region, rxConfig, ( int8_t* )&MacCtx->McpsIndication.RxDatarate ) == true )
     {
-        Radio.Rx( MacCtx.NvmCtx->MacParams.MaxRxWindow );
-        MacCtx.RxSlot = rxConfig->RxSlot;
+        Radio.Rx( MacCtx->NvmCtx->MacParams.MaxRxWindow );
+        MacCtx->RxSlot = rxConfig->RxSlot;
     }
 }
 
 static void OpenContinuousRxCWindow( void )
 {
     // Compute RxC windows parameters
-    RegionComputeRxWindowParameters( MacCtx.NvmCtx->Region,
-                                     MacCtx.NvmCtx->MacParams.RxCChannel.Datarate,
-                                     MacCtx.NvmCtx->MacParams.MinRxSymbols,
-                                     MacCtx.NvmCtx->MacParams.SystemMaxRxError,
-                                     &MacCtx.RxWindowCConfig );
+    RegionComputeRxWindowParameters( MacCtx->NvmCtx->Region,
+                                     MacCtx->NvmCtx->MacParams.RxCChannel.Datarate,
+                                     MacCtx->NvmCtx->MacParams.MinRxSymbols,
+                                     MacCtx->NvmCtx->MacParams.SystemMaxRxError,
+                                     &MacCtx->RxWindowCConfig );
 
-    MacCtx.RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
+    MacCtx->RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
     // Setup continuous listening
-    MacCtx.RxWindowCConfig.RxContinuous = true;
+    MacCtx->RxWindowCConfig.RxContinuous = true;
 
     // At this point the Radio should be idle.
     // Thus, there is no need to set the radio in standby mode.
-    if( RegionRxConfig( MacCtx.NvmCtx->Region, &MacCtx.RxWindowCConfig, ( int8_t* )&MacCtx.McpsIndication.RxDatarate ) == true )
+    if( RegionRxConfig( MacCtx->NvmCtx->Region, &MacCtx->RxWindowCConfig, ( int8_t* )&MacCtx->McpsIndication.RxDatarate ) == true )
     {
         Radio.Rx( 0 ); // Continuous mode
-        MacCtx.RxSlot = MacCtx.RxWindowCConfig.RxSlot;
+        MacCtx->RxSlot = MacCtx->RxWindowCConfig.RxSlot;
     }
 }
 
 LoRaMacStatus_t PrepareFrame( LoRaMacHeader_t* macHdr, LoRaMacFrameCtrl_t* fCtrl, uint8_t fPort, void* fBuffer, uint16_t fBufferSize )
 {
-    MacCtx.PktBufferLen = 0;
-    MacCtx.NodeAckRequested = false;
+    MacCtx->PktBufferLen = 0;
+    MacCtx->NodeAckRequested = false;
     uint32_t fCntUp = 0;
     size_t macCmdsSize = 0;
     uint8_t availableSize = 0;
@@ -2681,36 +2761,36 @@ LoRaMacStatus_t PrepareFrame( LoRaMacHeader_t* macHdr, LoRaMacFrameCtrl_t* fCtrl
         fBufferSize = 0;
     }
 
-    memcpy1( MacCtx.AppData, ( uint8_t* ) fBuffer, fBufferSize );
-    MacCtx.AppDataSize = fBufferSize;
-    MacCtx.PktBuffer[0] = macHdr->Value;
+    memcpy1( MacCtx->AppData, ( uint8_t* ) fBuffer, fBufferSize );
+    MacCtx->AppDataSize = fBufferSize;
+    MacCtx->PktBuffer[0] = macHdr->Value;
 
     switch( macHdr->Bits.MType )
     {
         case FRAME_TYPE_DATA_CONFIRMED_UP:
-            MacCtx.NodeAckRequested = true;
+            MacCtx->NodeAckRequested = true;
             // Intentional fall through
         case FRAME_TYPE_DATA_UNCONFIRMED_UP:
-            MacCtx.TxMsg.Type = LORAMAC_MSG_TYPE_DATA;
-            MacCtx.TxMsg.Message.Data.Buffer = MacCtx.PktBuffer;
-            MacCtx.TxMsg.Message.Data.BufSize = LORAMAC_PHY_MAXPAYLOAD;
-            MacCtx.TxMsg.Message.Data.MHDR.Value = macHdr->Value;
-            MacCtx.TxMsg.Message.Data.FPort = fPort;
-            MacCtx.TxMsg.Message.Data.FHDR.DevAddr = MacCtx.NvmCtx->DevAddr;
-            MacCtx.TxMsg.Message.Data.FHDR.FCtrl.Value = fCtrl->Value;
-            MacCtx.TxMsg.Message.Data.FRMPayloadSize = MacCtx.AppDataSize;
-            MacCtx.TxMsg.Message.Data.FRMPayload = MacCtx.AppData;
+            MacCtx->TxMsg.Type = LORAMAC_MSG_TYPE_DATA;
+            MacCtx->TxMsg.Message.Data.Buffer = MacCtx->PktBuffer;
+            MacCtx->TxMsg.Message.Data.BufSize = LORAMAC_PHY_MAXPAYLOAD;
+            MacCtx->TxMsg.Message.Data.MHDR.Value = macHdr->Value;
+            MacCtx->TxMsg.Message.Data.FPort = fPort;
+            MacCtx->TxMsg.Message.Data.FHDR.DevAddr = MacCtx->NvmCtx->DevAddr;
+            MacCtx->TxMsg.Message.Data.FHDR.FCtrl.Value = fCtrl->Value;
+            MacCtx->TxMsg.Message.Data.FRMPayloadSize = MacCtx->AppDataSize;
+            MacCtx->TxMsg.Message.Data.FRMPayload = MacCtx->AppData;
 
             if( LORAMAC_CRYPTO_SUCCESS != LoRaMacCryptoGetFCntUp( &fCntUp ) )
             {
                 return LORAMAC_STATUS_FCNT_HANDLER_ERROR;
             }
-            MacCtx.TxMsg.Message.Data.FHDR.FCnt = ( uint16_t )fCntUp;
+            MacCtx->TxMsg.Message.Data.FHDR.FCnt = ( uint16_t )fCntUp;
 
             // Reset confirm parameters
-            MacCtx.McpsConfirm.NbRetries = 0;
-            MacCtx.McpsConfirm.AckReceived = false;
-            MacCtx.McpsConfirm.UpLinkCounter = fCntUp;
+            MacCtx->McpsConfirm.NbRetries = 0;
+            MacCtx->McpsConfirm.AckReceived = false;
+            MacCtx->McpsConfirm.UpLinkCounter = fCntUp;
 
             // Handle the MAC commands if there are any available
             if( LoRaMacCommandsGetSizeSerializedCmds( &macCmdsSize ) != LORAMAC_COMMANDS_SUCCESS )
@@ -2720,24 +2800,24 @@ LoRaMacStatus_t PrepareFrame( LoRaMacHeader_t* macHdr, LoRaMacFrameCtrl_t* fCtrl
 
             if( macCmdsSize > 0 )
             {
-                availableSize = GetMaxAppPayloadWithoutFOptsLength( MacCtx.NvmCtx->MacParams.ChannelsDatarate );
+                availableSize = GetMaxAppPayloadWithoutFOptsLength( MacCtx->NvmCtx->MacParams.ChannelsDatarate );
 
                 // There is application payload available and the MAC commands fit into FOpts field.
-                if( ( MacCtx.AppDataSize > 0 ) && ( macCmdsSize <= LORA_MAC_COMMAND_MAX_FOPTS_LENGTH ) )
+                if( ( MacCtx->AppDataSize > 0 ) && ( macCmdsSize <= LORA_MAC_COMMAND_MAX_FOPTS_LENGTH ) )
                 {
-                    if( LoRaMacCommandsSerializeCmds( LORA_MAC_COMMAND_MAX_FOPTS_LENGTH, &macCmdsSize, MacCtx.TxMsg.Message.Data.FHDR.FOpts ) != LORAMAC_COMMANDS_SUCCESS )
+                    if( LoRaMacCommandsSerializeCmds( LORA_MAC_COMMAND_MAX_FOPTS_LENGTH, &macCmdsSize, MacCtx->TxMsg.Message.Data.FHDR.FOpts ) != LORAMAC_COMMANDS_SUCCESS )
                     {
                         return LORAMAC_STATUS_MAC_COMMAD_ERROR;
                     }
                     fCtrl->Bits.FOptsLen = macCmdsSize;
                     // Update FCtrl field with new value of FOptionsLength
-                    MacCtx.TxMsg.Message.Data.FHDR.FCtrl.Value = fCtrl->Value;
+                    MacCtx->TxMsg.Message.Data.FHDR.FCtrl.Value = fCtrl->Value;
                 }
                 // There is application payload available but the MAC commands does NOT fit into FOpts field.
-                else if( ( MacCtx.AppDataSize > 0 ) && ( macCmdsSize > LORA_MAC_COMMAND_MAX_FOPTS_LENGTH ) )
+                else if( ( MacCtx->AppDataSize > 0 ) && ( macCmdsSize > LORA_MAC_COMMAND_MAX_FOPTS_LENGTH ) )
                 {
 
-                    if( LoRaMacCommandsSerializeCmds( availableSize, &macCmdsSize, MacCtx.NvmCtx->MacCommandsBuffer ) != LORAMAC_COMMANDS_SUCCESS )
+                    if( LoRaMacCommandsSerializeCmds( availableSize, &macCmdsSize, MacCtx->NvmCtx->MacCommandsBuffer ) != LORAMAC_COMMANDS_SUCCESS )
                     {
                         return LORAMAC_STATUS_MAC_COMMAD_ERROR;
                     }
@@ -2746,24 +2826,24 @@ LoRaMacStatus_t PrepareFrame( LoRaMacHeader_t* macHdr, LoRaMacFrameCtrl_t* fCtrl
                 // No application payload available therefore add all mac commands to the FRMPayload.
                 else
                 {
-                    if( LoRaMacCommandsSerializeCmds( availableSize, &macCmdsSize, MacCtx.NvmCtx->MacCommandsBuffer ) != LORAMAC_COMMANDS_SUCCESS )
+                    if( LoRaMacCommandsSerializeCmds( availableSize, &macCmdsSize, MacCtx->NvmCtx->MacCommandsBuffer ) != LORAMAC_COMMANDS_SUCCESS )
                     {
                         return LORAMAC_STATUS_MAC_COMMAD_ERROR;
                     }
                     // Force FPort to be zero
-                    MacCtx.TxMsg.Message.Data.FPort = 0;
+                    MacCtx->TxMsg.Message.Data.FPort = 0;
 
-                    MacCtx.TxMsg.Message.Data.FRMPayload = MacCtx.NvmCtx->MacCommandsBuffer;
-                    MacCtx.TxMsg.Message.Data.FRMPayloadSize = macCmdsSize;
+                    MacCtx->TxMsg.Message.Data.FRMPayload = MacCtx->NvmCtx->MacCommandsBuffer;
+                    MacCtx->TxMsg.Message.Data.FRMPayloadSize = macCmdsSize;
                 }
             }
 
             break;
         case FRAME_TYPE_PROPRIETARY:
-            if( ( fBuffer != NULL ) && ( MacCtx.AppDataSize > 0 ) )
+            if( ( fBuffer != NULL ) && ( MacCtx->AppDataSize > 0 ) )
             {
-                memcpy1( MacCtx.PktBuffer + LORAMAC_MHDR_FIELD_SIZE, ( uint8_t* ) fBuffer, MacCtx.AppDataSize );
-                MacCtx.PktBufferLen = LORAMAC_MHDR_FIELD_SIZE + MacCtx.AppDataSize;
+                memcpy1( MacCtx->PktBuffer + LORAMAC_MHDR_FIELD_SIZE, ( uint8_t* ) fBuffer, MacCtx->AppDataSize );
+                MacCtx->PktBufferLen = LORAMAC_MHDR_FIELD_SIZE + MacCtx->AppDataSize;
             }
             break;
         default:
@@ -2779,28 +2859,28 @@ LoRaMacStatus_t SendFrameOnChannel( uint8_t channel )
     int8_t txPower = 0;
 
     txConfig.Channel = channel;
-    txConfig.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    txConfig.TxPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
-    txConfig.MaxEirp = MacCtx.NvmCtx->MacParams.MaxEirp;
-    txConfig.AntennaGain = MacCtx.NvmCtx->MacParams.AntennaGain;
-    txConfig.PktLen = MacCtx.PktBufferLen;
+    txConfig.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    txConfig.TxPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
+    txConfig.MaxEirp = MacCtx->NvmCtx->MacParams.MaxEirp;
+    txConfig.AntennaGain = MacCtx->NvmCtx->MacParams.AntennaGain;
+    txConfig.PktLen = MacCtx->PktBufferLen;
 
-    RegionTxConfig( MacCtx.NvmCtx->Region, &txConfig, &txPower, &MacCtx.TxTimeOnAir );
+    RegionTxConfig( MacCtx->NvmCtx->Region, &txConfig, &txPower, &MacCtx->TxTimeOnAir );
 
-    MacCtx.McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
-    MacCtx.McpsConfirm.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    MacCtx.McpsConfirm.TxPower = txPower;
-    MacCtx.McpsConfirm.Channel = channel;
+    MacCtx->McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+    MacCtx->McpsConfirm.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    MacCtx->McpsConfirm.TxPower = txPower;
+    MacCtx->McpsConfirm.Channel = channel;
 
     // Store the time on air
-    MacCtx.McpsConfirm.TxTimeOnAir = MacCtx.TxTimeOnAir;
-    MacCtx.MlmeConfirm.TxTimeOnAir = MacCtx.TxTimeOnAir;
+    MacCtx->McpsConfirm.TxTimeOnAir = MacCtx->TxTimeOnAir;
+    MacCtx->MlmeConfirm.TxTimeOnAir = MacCtx->TxTimeOnAir;
 
     if( LoRaMacClassBIsBeaconModeActive( ) == true )
     {
         // Currently, the Time-On-Air can only be computed when the radio is configured with
         // the TX configuration
-        TimerTime_t collisionTime = LoRaMacClassBIsUplinkCollision( MacCtx.TxTimeOnAir );
+        TimerTime_t collisionTime = LoRaMacClassBIsUplinkCollision( MacCtx->TxTimeOnAir );
 
         if( collisionTime > 0 )
         {
@@ -2808,7 +2888,7 @@ LoRaMacStatus_t SendFrameOnChannel( uint8_t channel )
         }
     }
 
-    if( MacCtx.NvmCtx->DeviceClass == CLASS_B )
+    if( MacCtx->NvmCtx->DeviceClass == CLASS_B )
     {
         // Stop slots for class b
         LoRaMacClassBStopRxSlots( );
@@ -2816,14 +2896,14 @@ LoRaMacStatus_t SendFrameOnChannel( uint8_t channel )
 
     LoRaMacClassBHaltBeaconing( );
 
-    MacCtx.MacState |= LORAMAC_TX_RUNNING;
-    if( MacCtx.NodeAckRequested == false )
+    MacCtx->MacState |= LORAMAC_TX_RUNNING;
+    if( MacCtx->NodeAckRequested == false )
     {
-        MacCtx.ChannelsNbTransCounter++;
+        MacCtx->ChannelsNbTransCounter++;
     }
 
     // Send now
-    Radio.Send( MacCtx.PktBuffer, MacCtx.PktBufferLen );
+    Radio.Send( MacCtx->PktBuffer, MacCtx->PktBufferLen );
 
     return LORAMAC_STATUS_OK;
 }
@@ -2832,16 +2912,16 @@ LoRaMacStatus_t SetTxContinuousWave( uint16_t timeout )
 {
     ContinuousWaveParams_t continuousWave;
 
-    continuousWave.Channel = MacCtx.Channel;
-    continuousWave.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    continuousWave.TxPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
-    continuousWave.MaxEirp = MacCtx.NvmCtx->MacParams.MaxEirp;
-    continuousWave.AntennaGain = MacCtx.NvmCtx->MacParams.AntennaGain;
+    continuousWave.Channel = MacCtx->Channel;
+    continuousWave.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    continuousWave.TxPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
+    continuousWave.MaxEirp = MacCtx->NvmCtx->MacParams.MaxEirp;
+    continuousWave.AntennaGain = MacCtx->NvmCtx->MacParams.AntennaGain;
     continuousWave.Timeout = timeout;
 
-    RegionSetContinuousWave( MacCtx.NvmCtx->Region, &continuousWave );
+    RegionSetContinuousWave( MacCtx->NvmCtx->Region, &continuousWave );
 
-    MacCtx.MacState |= LORAMAC_TX_RUNNING;
+    MacCtx->MacState |= LORAMAC_TX_RUNNING;
 
     return LORAMAC_STATUS_OK;
 }
@@ -2850,24 +2930,24 @@ LoRaMacStatus_t SetTxContinuousWave1( uint16_t timeout, uint32_t frequency, uint
 {
     Radio.SetTxContinuousWave( frequency, power, timeout );
 
-    MacCtx.MacState |= LORAMAC_TX_RUNNING;
+    MacCtx->MacState |= LORAMAC_TX_RUNNING;
 
     return LORAMAC_STATUS_OK;
 }
 
 LoRaMacCtxs_t* GetCtxs( void )
 {
-    Contexts.MacNvmCtx = &NvmMacCtx;
-    Contexts.MacNvmCtxSize = sizeof( NvmMacCtx );
-    Contexts.CryptoNvmCtx = LoRaMacCryptoGetNvmCtx( &Contexts.CryptoNvmCtxSize );
+    Contexts->MacNvmCtx = NvmMacCtx;
+    Contexts->MacNvmCtxSize = sizeof( LoRaMacNvmCtx_t );
+    Contexts->CryptoNvmCtx = LoRaMacCryptoGetNvmCtx( &Contexts->CryptoNvmCtxSize );
     GetNvmCtxParams_t params ={ 0 };
-    Contexts.RegionNvmCtx = RegionGetNvmCtx( MacCtx.NvmCtx->Region, &params );
-    Contexts.RegionNvmCtxSize = params.nvmCtxSize;
-    Contexts.SecureElementNvmCtx = SecureElementGetNvmCtx( &Contexts.SecureElementNvmCtxSize );
-    Contexts.CommandsNvmCtx = LoRaMacCommandsGetNvmCtx( &Contexts.CommandsNvmCtxSize );
-    Contexts.ClassBNvmCtx = LoRaMacClassBGetNvmCtx( &Contexts.ClassBNvmCtxSize );
-    Contexts.ConfirmQueueNvmCtx = LoRaMacConfirmQueueGetNvmCtx( &Contexts.ConfirmQueueNvmCtxSize );
-    return &Contexts;
+    Contexts->RegionNvmCtx = RegionGetNvmCtx( MacCtx->NvmCtx->Region, &params );
+    Contexts->RegionNvmCtxSize = params.nvmCtxSize;
+    Contexts->SecureElementNvmCtx = SecureElementGetNvmCtx( &Contexts->SecureElementNvmCtxSize );
+    Contexts->CommandsNvmCtx = LoRaMacCommandsGetNvmCtx( &Contexts->CommandsNvmCtxSize );
+    Contexts->ClassBNvmCtx = LoRaMacClassBGetNvmCtx( &Contexts->ClassBNvmCtxSize );
+    Contexts->ConfirmQueueNvmCtx = LoRaMacConfirmQueueGetNvmCtx( &Contexts->ConfirmQueueNvmCtxSize );
+    return Contexts;
 }
 
 LoRaMacStatus_t RestoreCtxs( LoRaMacCtxs_t* contexts )
@@ -2876,28 +2956,28 @@ LoRaMacStatus_t RestoreCtxs( LoRaMacCtxs_t* contexts )
     {
         return LORAMAC_STATUS_PARAMETER_INVALID;
     }
-    if( MacCtx.MacState != LORAMAC_STOPPED )
+    if( MacCtx->MacState != LORAMAC_STOPPED )
     {
         return LORAMAC_STATUS_BUSY;
     }
 
     if( contexts->MacNvmCtx != NULL )
     {
-        memcpy1( ( uint8_t* ) &NvmMacCtx, ( uint8_t* ) contexts->MacNvmCtx, contexts->MacNvmCtxSize );
+        memcpy1( ( uint8_t* ) NvmMacCtx, ( uint8_t* ) contexts->MacNvmCtx, contexts->MacNvmCtxSize );
     }
 
     InitDefaultsParams_t params;
     params.Type = INIT_TYPE_RESTORE_CTX;
     params.NvmCtx = contexts->RegionNvmCtx;
-    RegionInitDefaults( MacCtx.NvmCtx->Region, &params );
+    RegionInitDefaults( MacCtx->NvmCtx->Region, &params );
 
     // Initialize RxC config parameters.
-    MacCtx.RxWindowCConfig.Channel = MacCtx.Channel;
-    MacCtx.RxWindowCConfig.Frequency = MacCtx.NvmCtx->MacParams.RxCChannel.Frequency;
-    MacCtx.RxWindowCConfig.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
-    MacCtx.RxWindowCConfig.RepeaterSupport = MacCtx.NvmCtx->RepeaterSupport;
-    MacCtx.RxWindowCConfig.RxContinuous = true;
-    MacCtx.RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
+    MacCtx->RxWindowCConfig.Channel = MacCtx->Channel;
+    MacCtx->RxWindowCConfig.Frequency = MacCtx->NvmCtx->MacParams.RxCChannel.Frequency;
+    MacCtx->RxWindowCConfig.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
+    MacCtx->RxWindowCConfig.RepeaterSupport = MacCtx->NvmCtx->RepeaterSupport;
+    MacCtx->RxWindowCConfig.RxContinuous = true;
+    MacCtx->RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
 
     if( SecureElementRestoreNvmCtx( contexts->SecureElementNvmCtx ) != SECURE_ELEMENT_SUCCESS )
     {
@@ -2982,21 +3062,21 @@ LoRaMacStatus_t DetermineFrameType( LoRaMacMessageData_t* macMsg, FType_t* fType
 static bool CheckRetransUnconfirmedUplink( void )
 {
     // Unconfirmed uplink, when all retransmissions are done.
-    if( MacCtx.ChannelsNbTransCounter >=
-        MacCtx.NvmCtx->MacParams.ChannelsNbTrans )
+    if( MacCtx->ChannelsNbTransCounter >=
+        MacCtx->NvmCtx->MacParams.ChannelsNbTrans )
     {
         return true;
     }
-    else if( MacCtx.MacFlags.Bits.McpsInd == 1 )
+    else if( MacCtx->MacFlags.Bits.McpsInd == 1 )
     {
         // For Class A stop in each case
-        if( MacCtx.NvmCtx->DeviceClass == CLASS_A )
+        if( MacCtx->NvmCtx->DeviceClass == CLASS_A )
         {
             return true;
         }
         else
         {// For Class B & C stop only if the frame was received in RX1 window
-            if( MacCtx.McpsIndication.RxSlot == RX_SLOT_WIN_1 )
+            if( MacCtx->McpsIndication.RxSlot == RX_SLOT_WIN_1 )
             {
                 return true;
             }
@@ -3008,14 +3088,14 @@ static bool CheckRetransUnconfirmedUplink( void )
 static bool CheckRetransConfirmedUplink( void )
 {
     // Confirmed uplink, when all retransmissions ( tries to get a ack ) are done.
-    if( MacCtx.AckTimeoutRetriesCounter >=
-        MacCtx.AckTimeoutRetries )
+    if( MacCtx->AckTimeoutRetriesCounter >=
+        MacCtx->AckTimeoutRetries )
     {
         return true;
     }
-    else if( MacCtx.MacFlags.Bits.McpsInd == 1 )
+    else if( MacCtx->MacFlags.Bits.McpsInd == 1 )
     {
-        if( MacCtx.McpsConfirm.AckReceived == true )
+        if( MacCtx->McpsConfirm.AckReceived == true )
         {
             return true;
         }
@@ -3025,64 +3105,64 @@ static bool CheckRetransConfirmedUplink( void )
 
 static bool StopRetransmission( void )
 {
-    if( ( MacCtx.MacFlags.Bits.McpsInd == 0 ) ||
-        ( ( MacCtx.McpsIndication.RxSlot != RX_SLOT_WIN_1 ) &&
-          ( MacCtx.McpsIndication.RxSlot != RX_SLOT_WIN_2 ) ) )
+    if( ( MacCtx->MacFlags.Bits.McpsInd == 0 ) ||
+        ( ( MacCtx->McpsIndication.RxSlot != RX_SLOT_WIN_1 ) &&
+          ( MacCtx->McpsIndication.RxSlot != RX_SLOT_WIN_2 ) ) )
     {   // Maximum repetitions without downlink. Increase ADR Ack counter.
         // Only process the case when the MAC did not receive a downlink.
-        if( MacCtx.NvmCtx->AdrCtrlOn == true )
+        if( MacCtx->NvmCtx->AdrCtrlOn == true )
         {
-            MacCtx.NvmCtx->AdrAckCounter++;
+            MacCtx->NvmCtx->AdrAckCounter++;
         }
     }
 
-    MacCtx.ChannelsNbTransCounter = 0;
-    MacCtx.NodeAckRequested = false;
-    MacCtx.AckTimeoutRetry = false;
-    MacCtx.MacState &= ~LORAMAC_TX_RUNNING;
+    MacCtx->ChannelsNbTransCounter = 0;
+    MacCtx->NodeAckRequested = false;
+    MacCtx->AckTimeoutRetry = false;
+    MacCtx->MacState &= ~LORAMAC_TX_RUNNING;
 
     return true;
 }
 
 static void AckTimeoutRetriesProcess( void )
 {
-    if( MacCtx.AckTimeoutRetriesCounter < MacCtx.AckTimeoutRetries )
+    if( MacCtx->AckTimeoutRetriesCounter < MacCtx->AckTimeoutRetries )
     {
-        MacCtx.AckTimeoutRetriesCounter++;
-        if( ( MacCtx.AckTimeoutRetriesCounter % 2 ) == 1 )
+        MacCtx->AckTimeoutRetriesCounter++;
+        if( ( MacCtx->AckTimeoutRetriesCounter % 2 ) == 1 )
         {
             GetPhyParams_t getPhy;
             PhyParam_t phyParam;
 
             getPhy.Attribute = PHY_NEXT_LOWER_TX_DR;
-            getPhy.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
-            getPhy.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-            phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-            MacCtx.NvmCtx->MacParams.ChannelsDatarate = phyParam.Value;
+            getPhy.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
+            getPhy.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+            phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+            MacCtx->NvmCtx->MacParams.ChannelsDatarate = phyParam.Value;
         }
     }
 }
 
 static void AckTimeoutRetriesFinalize( void )
 {
-    if( MacCtx.McpsConfirm.AckReceived == false )
+    if( MacCtx->McpsConfirm.AckReceived == false )
     {
         InitDefaultsParams_t params;
         params.Type = INIT_TYPE_RESTORE_DEFAULT_CHANNELS;
-        params.NvmCtx = Contexts.RegionNvmCtx;
-        RegionInitDefaults( MacCtx.NvmCtx->Region, &params );
+        params.NvmCtx = Contexts->RegionNvmCtx;
+        RegionInitDefaults( MacCtx->NvmCtx->Region, &params );
 
-        MacCtx.NodeAckRequested = false;
-        MacCtx.McpsConfirm.AckReceived = false;
+        MacCtx->NodeAckRequested = false;
+        MacCtx->McpsConfirm.AckReceived = false;
     }
-    MacCtx.McpsConfirm.NbRetries = MacCtx.AckTimeoutRetriesCounter;
+    MacCtx->McpsConfirm.NbRetries = MacCtx->AckTimeoutRetriesCounter;
 }
 
 static void CallNvmCtxCallback( LoRaMacNvmCtxModule_t module )
 {
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->NvmContextChange != NULL ) )
+    if( ( MacCtx->MacCallbacks != NULL ) && ( MacCtx->MacCallbacks->NvmContextChange != NULL ) )
     {
-        MacCtx.MacCallbacks->NvmContextChange( module );
+        MacCtx->MacCallbacks->NvmContextChange( module );
     }
 }
 
@@ -3123,14 +3203,80 @@ static void EventConfirmQueueNvmCtxChanged( void )
 
 static uint8_t IsRequestPending( void )
 {
-    if( ( MacCtx.MacFlags.Bits.MlmeReq == 1 ) ||
-        ( MacCtx.MacFlags.Bits.McpsReq == 1 ) )
+    if( ( MacCtx->MacFlags.Bits.MlmeReq == 1 ) ||
+        ( MacCtx->MacFlags.Bits.McpsReq == 1 ) )
     {
         return 1;
     }
     return 0;
 }
 
+/*!
+ * \brief Returns the next part of an instance memory block
+ *
+ * \param [IN/OUT] block - Current position in the block, NULL for the default instance
+ * \param [IN]     size  - Size of the part
+ *
+ * \retval Start of the part, NULL for the default instance
+ */
+static void* NextInstanceCtx( uint8_t** block, size_t size )
+{
+    void* ctx = *block;
+
+    if( *block != NULL )
+    {
+        *block += LORAMAC_INSTANCE_ALIGN( size );
+    }
+    return ctx;
+}
+
+size_t LoRaMacInstanceGetSize( void )
+{
+    return LORAMAC_INSTANCE_ALIGN( sizeof( LoRaMacInstanceCtx_t ) ) +
+           LORAMAC_INSTANCE_ALIGN( LoRaMacCryptoGetInstanceCtxSize( ) ) +
+           LORAMAC_INSTANCE_ALIGN( LoRaMacCommandsGetInstanceCtxSize( ) ) +
+           LORAMAC_INSTANCE_ALIGN( LoRaMacConfirmQueueGetInstanceCtxSize( ) ) +
+           LORAMAC_INSTANCE_ALIGN( LoRaMacClassBGetInstanceCtxSize( ) ) +
+           LORAMAC_INSTANCE_ALIGN( RegionGetInstanceCtxSize( ) ) +
+           LORAMAC_INSTANCE_ALIGN( SecureElementGetInstanceCtxSize( ) );
+}
+
+void LoRaMacInstanceSelect( void* instance )
+{
+    uint8_t* block = ( uint8_t* )instance;
+    LoRaMacInstanceCtx_t* ctx;
+
+    if( instance == SelectedInstance )
+    {
+        return;
+    }
+    SelectedInstance = instance;
+
+    // The part order must match LoRaMacInstanceGetSize
+    ctx = NextInstanceCtx( &block, sizeof( LoRaMacInstanceCtx_t ) );
+    if( ctx == NULL )
+    {
+        ctx = &DefaultInstanceCtx;
+    }
+    MacCtx = &ctx->MacCtx;
+    NvmMacCtx = &ctx->NvmMacCtx;
+    Contexts = &ctx->Contexts;
+    LoRaMacRadioEvents = &ctx->RadioEvents;
+    TxDoneParams = &ctx->TxDoneParams;
+    RxDoneParams = &ctx->RxDoneParams;
+
+    LoRaMacCryptoSetInstanceCtx( NextInstanceCtx( &block, LoRaMacCryptoGetInstanceCtxSize( ) ) );
+    LoRaMacCommandsSetInstanceCtx( NextInstanceCtx( &block, LoRaMacCommandsGetInstanceCtxSize( ) ) );
+    LoRaMacConfirmQueueSetInstanceCtx( NextInstanceCtx( &block, LoRaMacConfirmQueueGetInstanceCtxSize( ) ) );
+    LoRaMacClassBSetInstanceCtx( NextInstanceCtx( &block, LoRaMacClassBGetInstanceCtxSize( ) ) );
+    RegionSetInstanceCtx( NextInstanceCtx( &block, RegionGetInstanceCtxSize( ) ) );
+    SecureElementSetInstanceCtx( NextInstanceCtx( &block, SecureElementGetInstanceCtxSize( ) ) );
+}
+
+void* LoRaMacInstanceGetSelected( void )
+{
+    return SelectedInstance;
+}
 
 LoRaMacStatus_t LoRaMacInitialization( LoRaMacPrimitives_t* primitives, LoRaMacCallback_t* callbacks, LoRaMacRegion_t region )
 {
@@ -3162,143 +3308,149 @@ LoRaMacStatus_t LoRaMacInitialization( LoRaMacPrimitives_t* primitives, LoRaMacC
     LoRaMacConfirmQueueInit( primitives, EventConfirmQueueNvmCtxChanged );
 
     // Initialize the module context with zeros
-    memset1( ( uint8_t* ) &NvmMacCtx, 0x00, sizeof( LoRaMacNvmCtx_t ) );
-    memset1( ( uint8_t* ) &MacCtx, 0x00, sizeof( LoRaMacCtx_t ) );
-    MacCtx.NvmCtx = &NvmMacCtx;
+    memset1( ( uint8_t* ) NvmMacCtx, 0x00, sizeof( LoRaMacNvmCtx_t ) );
+    memset1( ( uint8_t* ) MacCtx, 0x00, sizeof( LoRaMacCtx_t ) );
+    MacCtx->NvmCtx = NvmMacCtx;
 
     // Set non zero variables to its default value
-    MacCtx.AckTimeoutRetriesCounter = 1;
-    MacCtx.AckTimeoutRetries = 1;
-    MacCtx.NvmCtx->Region = region;
-    MacCtx.NvmCtx->DeviceClass = CLASS_A;
-    MacCtx.NvmCtx->RepeaterSupport = false;
+    MacCtx->AckTimeoutRetriesCounter = 1;
+    MacCtx->AckTimeoutRetries = 1;
+    MacCtx->NvmCtx->Region = region;
+    MacCtx->NvmCtx->DeviceClass = CLASS_A;
+    MacCtx->NvmCtx->RepeaterSupport = false;
 
     Version_t lrWanVersion;
     lrWanVersion.Fields.Major    = 1;
     lrWanVersion.Fields.Minor    = 0;
     lrWanVersion.Fields.Revision = 3;
     lrWanVersion.Fields.Rfu      = 0;
-    MacCtx.NvmCtx->Version = lrWanVersion;
+    MacCtx->NvmCtx->Version = lrWanVersion;
 
     // Reset to defaults
     getPhy.Attribute = PHY_DUTY_CYCLE;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->DutyCycleOn = ( bool ) phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->DutyCycleOn = ( bool ) phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_TX_POWER;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.ChannelsTxPower = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.ChannelsTxPower = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_TX_DR;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.ChannelsDatarate = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.ChannelsDatarate = phyParam.Value;
 
     getPhy.Attribute = PHY_MAX_RX_WINDOW;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.MaxRxWindow = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.MaxRxWindow = phyParam.Value;
 
     getPhy.Attribute = PHY_RECEIVE_DELAY1;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.ReceiveDelay1 = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.ReceiveDelay1 = phyParam.Value;
 
     getPhy.Attribute = PHY_RECEIVE_DELAY2;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.ReceiveDelay2 = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.ReceiveDelay2 = phyParam.Value;
 
     getPhy.Attribute = PHY_JOIN_ACCEPT_DELAY1;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.JoinAcceptDelay1 = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.JoinAcceptDelay1 = phyParam.Value;
 
     getPhy.Attribute = PHY_JOIN_ACCEPT_DELAY2;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.JoinAcceptDelay2 = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.JoinAcceptDelay2 = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_DR1_OFFSET;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.Rx1DrOffset = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.Rx1DrOffset = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_RX2_FREQUENCY;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.Rx2Channel.Frequency = phyParam.Value;
-    MacCtx.NvmCtx->MacParamsDefaults.RxCChannel.Frequency = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.Rx2Channel.Frequency = phyParam.Value;
+    MacCtx->NvmCtx->MacParamsDefaults.RxCChannel.Frequency = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_RX2_DR;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.Rx2Channel.Datarate = phyParam.Value;
-    MacCtx.NvmCtx->MacParamsDefaults.RxCChannel.Datarate = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.Rx2Channel.Datarate = phyParam.Value;
+    MacCtx->NvmCtx->MacParamsDefaults.RxCChannel.Datarate = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_UPLINK_DWELL_TIME;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.UplinkDwellTime = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.UplinkDwellTime = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_DOWNLINK_DWELL_TIME;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.DownlinkDwellTime = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.DownlinkDwellTime = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_MAX_EIRP;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.MaxEirp = phyParam.fValue;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.MaxEirp = phyParam.fValue;
 
     getPhy.Attribute = PHY_DEF_ANTENNA_GAIN;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.AntennaGain = phyParam.fValue;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.AntennaGain = phyParam.fValue;
 
     getPhy.Attribute = PHY_DEF_ADR_ACK_LIMIT;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.AdrAckLimit = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->AdrAckLimit = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_ADR_ACK_DELAY;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.AdrAckDelay = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->AdrAckDelay = phyParam.Value;
 
     // Init parameters which are not set in function ResetMacParameters
-    MacCtx.NvmCtx->MacParamsDefaults.ChannelsNbTrans = 1;
-    MacCtx.NvmCtx->MacParamsDefaults.SystemMaxRxError = 10;
-    MacCtx.NvmCtx->MacParamsDefaults.MinRxSymbols = 6;
-
-    MacCtx.NvmCtx->MacParams.SystemMaxRxError = MacCtx.NvmCtx->MacParamsDefaults.SystemMaxRxError;
-    MacCtx.NvmCtx->MacParams.MinRxSymbols = MacCtx.NvmCtx->MacParamsDefaults.MinRxSymbols;
-    MacCtx.NvmCtx->MacParams.MaxRxWindow = MacCtx.NvmCtx->MacParamsDefaults.MaxRxWindow;
-    MacCtx.NvmCtx->MacParams.ReceiveDelay1 = MacCtx.NvmCtx->MacParamsDefaults.ReceiveDelay1;
-    MacCtx.NvmCtx->MacParams.ReceiveDelay2 = MacCtx.NvmCtx->MacParamsDefaults.ReceiveDelay2;
-    MacCtx.NvmCtx->MacParams.JoinAcceptDelay1 = MacCtx.NvmCtx->MacParamsDefaults.JoinAcceptDelay1;
-    MacCtx.NvmCtx->MacParams.JoinAcceptDelay2 = MacCtx.NvmCtx->MacParamsDefaults.JoinAcceptDelay2;
-    MacCtx.NvmCtx->MacParams.ChannelsNbTrans = MacCtx.NvmCtx->MacParamsDefaults.ChannelsNbTrans;
+    MacCtx->NvmCtx->MacParamsDefaults.ChannelsNbTrans = 1;
+    MacCtx->NvmCtx->MacParamsDefaults.SystemMaxRxError = 10;
+    MacCtx->NvmCtx->MacParamsDefaults.MinRxSymbols = 6;
+
+    MacCtx->NvmCtx->MacParams.SystemMaxRxError = MacCtx->NvmCtx->MacParamsDefaults.SystemMaxRxError;
+    MacCtx->NvmCtx->MacParams.MinRxSymbols = MacCtx->NvmCtx->MacParamsDefaults.MinRxSymbols;
+    MacCtx->NvmCtx->MacParams.MaxRxWindow = MacCtx->NvmCtx->MacParamsDefaults.MaxRxWindow;
+    MacCtx->NvmCtx->MacParams.ReceiveDelay1 = MacCtx->NvmCtx->MacParamsDefaults.ReceiveDelay1;
+    MacCtx->NvmCtx->MacParams.ReceiveDelay2 = MacCtx->NvmCtx->MacParamsDefaults.ReceiveDelay2;
+    MacCtx->NvmCtx->MacParams.JoinAcceptDelay1 = MacCtx->NvmCtx->MacParamsDefaults.JoinAcceptDelay1;
+    MacCtx->NvmCtx->MacParams.JoinAcceptDelay2 = MacCtx->NvmCtx->MacParamsDefaults.JoinAcceptDelay2;
+    MacCtx->NvmCtx->MacParams.ChannelsNbTrans = MacCtx->NvmCtx->MacParamsDefaults.ChannelsNbTrans;
 
     ResetMacParameters( );
 
-    MacCtx.NvmCtx->PublicNetwork = true;
+    MacCtx->NvmCtx->PublicNetwork = true;
 
-    MacCtx.MacPrimitives = primitives;
-    MacCtx.MacCallbacks = callbacks;
-    MacCtx.MacFlags.Value = 0;
-    MacCtx.MacState = LORAMAC_STOPPED;
+    MacCtx->MacPrimitives = primitives;
+    MacCtx->MacCallbacks = callbacks;
+    MacCtx->MacFlags.Value = 0;
+    MacCtx->MacState = LORAMAC_STOPPED;
 
     // Reset duty cycle times
-    MacCtx.NvmCtx->LastTxDoneTime = 0;
-    MacCtx.NvmCtx->AggregatedTimeOff = 0;
+    MacCtx->NvmCtx->LastTxDoneTime = 0;
+    MacCtx->NvmCtx->AggregatedTimeOff = 0;
 
     // Initialize timers
-    TimerInit( &MacCtx.TxDelayedTimer, OnTxDelayedTimerEvent );
-    TimerInit( &MacCtx.RxWindowTimer1, OnRxWindow1TimerEvent );
-    TimerInit( &MacCtx.RxWindowTimer2, OnRxWindow2TimerEvent );
-    TimerInit( &MacCtx.AckTimeoutTimer, OnAckTimeoutTimerEvent );
+    TimerInit( &MacCtx->TxDelayedTimer, OnTxDelayedTimerEvent );
+    TimerInit( &MacCtx->RxWindowTimer1, OnRxWindow1TimerEvent );
+    TimerInit( &MacCtx->RxWindowTimer2, OnRxWindow2TimerEvent );
+    TimerInit( &MacCtx->AckTimeoutTimer, OnAckTimeoutTimerEvent );
+
+    // Timer events run the instance which started the timer
+    TimerSetContext( &MacCtx->TxDelayedTimer, SelectedInstance );
+    TimerSetContext( &MacCtx->RxWindowTimer1, SelectedInstance );
+    TimerSetContext( &MacCtx->RxWindowTimer2, SelectedInstance );
+    TimerSetContext( &MacCtx->AckTimeoutTimer, SelectedInstance );
 
     // Store the current initialization time
-    MacCtx.NvmCtx->InitializationTime = SysTimeGetMcuTime( );
+    MacCtx->NvmCtx->InitializationTime = SysTimeGetMcuTime( );
 
     // Initialize Radio driver
-    MacCtx.RadioEvents.TxDone = OnRadioTxDone;
-    MacCtx.RadioEvents.RxDone = OnRadioRxDone;
-    MacCtx.RadioEvents.RxError = OnRadioRxError;
-    MacCtx.RadioEvents.TxTimeout = OnRadioTxTimeout;
-    MacCtx.RadioEvents.RxTimeout = OnRadioRxTimeout;
-    Radio.Init( &MacCtx.RadioEvents );
+    MacCtx->RadioEvents.TxDone = OnRadioTxDone;
+    MacCtx->RadioEvents.RxDone = OnRadioRxDone;
+    MacCtx->RadioEvents.RxError = OnRadioRxError;
+    MacCtx->RadioEvents.TxTimeout = OnRadioTxTimeout;
+    MacCtx->RadioEvents.RxTimeout = OnRadioRxTimeout;
+    Radio.Init( &MacCtx->RadioEvents );
 
     InitDefaultsParams_t params;
     params.Type = INIT_TYPE_INIT;
     params.NvmCtx = NULL;
-    RegionInitDefaults( MacCtx.NvmCtx->Region, &params );
+    RegionInitDefaults( MacCtx->NvmCtx->Region, &params );
 
     // Initialize the Secure Element driver
     if( SecureElementInit( EventSecureElementNvmCtxChanged ) != SECURE_ELEMENT_SUCCESS )
@@ -3319,7 +3471,7 @@ LoRaMacStatus_t LoRaMacInitialization( LoRaMacPrimitives_t* primitives, LoRaMacC
     }
 
     // Set multicast downlink counter reference
-    if( LoRaMacCryptoSetMulticastReference( MacCtx.NvmCtx->MulticastChannelList ) != LORAMAC_CRYPTO_SUCCESS )
+    if( LoRaMacCryptoSetMulticastReference( MacCtx->NvmCtx->MulticastChannelList ) != LORAMAC_CRYPTO_SUCCESS )
     {
         return LORAMAC_STATUS_CRYPTO_ERROR;
     }
@@ -3327,7 +3479,7 @@ LoRaMacStatus_t LoRaMacInitialization( LoRaMacPrimitives_t* primitives, LoRaMacC
     // Random seed initialization
     srand1( Radio.Random( ) );
 
-    Radio.SetPublicNetwork( MacCtx.NvmCtx->PublicNetwork );
+    Radio.SetPublicNetwork( MacCtx->NvmCtx->PublicNetwork );
     Radio.Sleep( );
 
     // Initialize class b
@@ -3341,14 +3493,14 @@ LoRaMacStatus_t LoRaMacInitialization( LoRaMacPrimitives_t* primitives, LoRaMacC
     }
 
     // Must all be static. Don't use local references.
-    classBParams.MlmeIndication = &MacCtx.MlmeIndication;
-    classBParams.McpsIndication = &MacCtx.McpsIndication;
-    classBParams.MlmeConfirm = &MacCtx.MlmeConfirm;
-    classBParams.LoRaMacFlags = &MacCtx.MacFlags;
-    classBParams.LoRaMacDevAddr = &MacCtx.NvmCtx->DevAddr;
-    classBParams.LoRaMacRegion = &MacCtx.NvmCtx->Region;
-    classBParams.LoRaMacParams = &MacCtx.NvmCtx->MacParams;
-    classBParams.MulticastChannels = &MacCtx.NvmCtx->MulticastChannelList[0];
+    classBParams.MlmeIndication = &MacCtx->MlmeIndication;
+    classBParams.McpsIndication = &MacCtx->McpsIndication;
+    classBParams.MlmeConfirm = &MacCtx->MlmeConfirm;
+    classBParams.LoRaMacFlags = &MacCtx->MacFlags;
+    classBParams.LoRaMacDevAddr = &MacCtx->NvmCtx->DevAddr;
+    classBParams.LoRaMacRegion = &MacCtx->NvmCtx->Region;
+    classBParams.LoRaMacParams = &MacCtx->NvmCtx->MacParams;
+    classBParams.MulticastChannels = &MacCtx->NvmCtx->MulticastChannelList[0];
 
     LoRaMacClassBInit( &classBParams, &classBCallbacks, &EventClassBNvmCtxChanged );
 
@@ -3359,7 +3511,7 @@ LoRaMacStatus_t LoRaMacInitialization( LoRaMacPrimitives_t* primitives, LoRaMacC
 
 LoRaMacStatus_t LoRaMacStart( void )
 {
-    MacCtx.MacState = LORAMAC_IDLE;
+    MacCtx->MacState = LORAMAC_IDLE;
     return LORAMAC_STATUS_OK;
 }
 
@@ -3367,10 +3519,10 @@ LoRaMacStatus_t LoRaMacStop( void )
 {
     if( LoRaMacIsBusy( ) == false )
     {
-        MacCtx.MacState = LORAMAC_STOPPED;
+        MacCtx->MacState = LORAMAC_STOPPED;
         return LORAMAC_STATUS_OK;
     }
-    else if(  MacCtx.MacState == LORAMAC_STOPPED )
+    else if(  MacCtx->MacState == LORAMAC_STOPPED )
     {
         return LORAMAC_STATUS_OK;
     }
@@ -3380,9 +3532,9 @@ LoRaMacStatus_t LoRaMacStop( void )
 LoRaMacStatus_t LoRaMacQueryTxPossible( uint8_t size, LoRaMacTxInfo_t* txInfo )
 {
     CalcNextAdrParams_t adrNext;
-    uint32_t adrAckCounter = MacCtx.NvmCtx->AdrAckCounter;
-    int8_t datarate = MacCtx.NvmCtx->MacParamsDefaults.ChannelsDatarate;
-    int8_t txPower = MacCtx.NvmCtx->MacParamsDefaults.ChannelsTxPower;
+    uint32_t adrAckCounter = MacCtx->NvmCtx->AdrAckCounter;
+    int8_t datarate = MacCtx->NvmCtx->MacParamsDefaults.ChannelsDatarate;
+    int8_t txPower = MacCtx->NvmCtx->MacParamsDefaults.ChannelsTxPower;
     size_t macCmdsSize = 0;
 
     if( txInfo == NULL )
@@ -3391,16 +3543,16 @@ LoRaMacStatus_t LoRaMacQueryTxPossible( uint8_t size, LoRaMacTxInfo_t* txInfo )
     }
 
     // Setup ADR request
-    adrNext.Version = MacCtx.NvmCtx->Version;
+    adrNext.Version = MacCtx->NvmCtx->Version;
     adrNext.UpdateChanMask = false;
-    adrNext.AdrEnabled = MacCtx.NvmCtx->AdrCtrlOn;
-    adrNext.AdrAckCounter = MacCtx.NvmCtx->AdrAckCounter;
-    adrNext.AdrAckLimit = MacCtx.AdrAckLimit;
-    adrNext.AdrAckDelay = MacCtx.AdrAckDelay;
-    adrNext.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    adrNext.TxPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
-    adrNext.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
-    adrNext.Region = MacCtx.NvmCtx->Region;
+    adrNext.AdrEnabled = MacCtx->NvmCtx->AdrCtrlOn;
+    adrNext.AdrAckCounter = MacCtx->NvmCtx->AdrAckCounter;
+    adrNext.AdrAckLimit = MacCtx->AdrAckLimit;
+    adrNext.AdrAckDelay = MacCtx->AdrAckDelay;
+    adrNext.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    adrNext.TxPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
+    adrNext.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
+    adrNext.Region = MacCtx->NvmCtx->Region;
 
     // We call the function for information purposes only. We don't want to
     // apply the datarate, the tx power and the ADR ack counter.
@@ -3450,12 +3602,12 @@ LoRaMacStatus_t LoRaMacMibGetRequestConfirm( MibRequestConfirm_t* mibGet )
     {
         case MIB_DEVICE_CLASS:
         {
-            mibGet->Param.Class = MacCtx.NvmCtx->DeviceClass;
+            mibGet->Param.Class = MacCtx->NvmCtx->DeviceClass;
             break;
         }
         case MIB_NETWORK_ACTIVATION:
         {
-            mibGet->Param.NetworkActivation = MacCtx.NvmCtx->NetworkActivation;
+            mibGet->Param.NetworkActivation = MacCtx->NvmCtx->NetworkActivation;
             break;
         }
         case MIB_DEV_EUI:
@@ -3470,61 +3622,61 @@ LoRaMacStatus_t LoRaMacMibGetRequestConfirm( MibRequestConfirm_t* mibGet )
         }
         case MIB_ADR:
         {
-            mibGet->Param.AdrEnable = MacCtx.NvmCtx->AdrCtrlOn;
+            mibGet->Param.AdrEnable = MacCtx->NvmCtx->AdrCtrlOn;
             break;
         }
         case MIB_NET_ID:
         {
-            mibGet->Param.NetID = MacCtx.NvmCtx->NetID;
+            mibGet->Param.NetID = MacCtx->NvmCtx->NetID;
             break;
         }
         case MIB_DEV_ADDR:
         {
-            mibGet->Param.DevAddr = MacCtx.NvmCtx->DevAddr;
+            mibGet->Param.DevAddr = MacCtx->NvmCtx->DevAddr;
             break;
         }
         case MIB_PUBLIC_NETWORK:
         {
-            mibGet->Param.EnablePublicNetwork = MacCtx.NvmCtx->PublicNetwork;
+            mibGet->Param.EnablePublicNetwork = MacCtx->NvmCtx->PublicNetwork;
             break;
         }
         case MIB_REPEATER_SUPPORT:
         {
-            mibGet->Param.EnableRepeaterSupport = MacCtx.NvmCtx->RepeaterSupport;
+            mibGet->Param.EnableRepeaterSupport = MacCtx->NvmCtx->RepeaterSupport;
             break;
         }
         case MIB_CHANNELS:
         {
             getPhy.Attribute = PHY_CHANNELS;
-            phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+            phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
 
             mibGet->Param.ChannelList = phyParam.Channels;
             break;
         }
         case MIB_RX2_CHANNEL:
         {
-            mibGet->Param.Rx2Channel = MacCtx.NvmCtx->MacParams.Rx2Channel;
+            mibGet->Param.Rx2Channel = MacCtx->NvmCtx->MacParams.Rx2Channel;
             break;
         }
         case MIB_RX2_DEFAULT_CHANNEL:
         {
-            mibGet->Param.Rx2Channel = MacCtx.NvmCtx->MacParamsDefaults.Rx2Channel;
+            mibGet->Param.Rx2Channel = MacCtx->NvmCtx->MacParamsDefaults.Rx2Channel;
             break;
         }
         case MIB_RXC_CHANNEL:
         {
-            mibGet->Param.RxCChannel = MacCtx.NvmCtx->MacParams.RxCChannel;
+            mibGet->Param.RxCChannel = MacCtx->NvmCtx->MacParams.RxCChannel;
             break;
         }
         case MIB_RXC_DEFAULT_CHANNEL:
         {
-            mibGet->Param.RxCChannel = MacCtx.NvmCtx->MacParamsDefaults.RxCChannel;
+            mibGet->Param.RxCChannel = MacCtx->NvmCtx->MacParamsDefaults.RxCChannel;
             break;
         }
         case MIB_CHANNELS_DEFAULT_MASK:
         {
             getPhy.Attribute = PHY_CHANNELS_DEFAULT_MASK;
-            phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+            phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
 
             mibGet->Param.ChannelsDefaultMask = phyParam.ChannelsMask;
             break;
@@ -3532,74 +3684,74 @@ LoRaMacStatus_t LoRaMacMibGetRequestConfirm( MibRequestConfirm_t* mibGet )
         case MIB_CHANNELS_MASK:
         {
             getPhy.Attribute = PHY_CHANNELS_MASK;
-            phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+            phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
 
             mibGet->Param.ChannelsMask = phyParam.ChannelsMask;
             break;
         }
         case MIB_CHANNELS_NB_TRANS:
         {
-            mibGet->Param.ChannelsNbTrans = MacCtx.NvmCtx->MacParams.ChannelsNbTrans;
+            mibGet->Param.ChannelsNbTrans = MacCtx->NvmCtx->MacParams.ChannelsNbTrans;
             break;
         }
         case MIB_MAX_RX_WINDOW_DURATION:
         {
-            mibGet->Param.MaxRxWindow = MacCtx.NvmCtx->MacParams.MaxRxWindow;
+            mibGet->Param.MaxRxWindow = MacCtx->NvmCtx->MacParams.MaxRxWindow;
             break;
         }
         case MIB_RECEIVE_DELAY_1:
         {
-            mibGet->Param.ReceiveDelay1 = MacCtx.NvmCtx->MacParams.ReceiveDelay1;
+            mibGet->Param.ReceiveDelay1 = MacCtx->NvmCtx->MacParams.ReceiveDelay1;
             break;
         }
         case MIB_RECEIVE_DELAY_2:
         {
-            mibGet->Param.ReceiveDelay2 = MacCtx.NvmCtx->MacParams.ReceiveDelay2;
+            mibGet->Param.ReceiveDelay2 = MacCtx->NvmCtx->MacParams.ReceiveDelay2;
             break;
         }
         case MIB_JOIN_ACCEPT_DELAY_1:
         {
-            mibGet->Param.JoinAcceptDelay1 = MacCtx.NvmCtx->MacParams.JoinAcceptDelay1;
+            mibGet->Param.JoinAcceptDelay1 = MacCtx->NvmCtx->MacParams.JoinAcceptDelay1;
             break;
         }
         case MIB_JOIN_ACCEPT_DELAY_2:
         {
-            mibGet->Param.JoinAcceptDelay2 = MacCtx.NvmCtx->MacParams.JoinAcceptDelay2;
+            mibGet->Param.JoinAcceptDelay2 = MacCtx->NvmCtx->MacParams.JoinAcceptDelay2;
             break;
         }
         case MIB_CHANNELS_DEFAULT_DATARATE:
         {
-            mibGet->Param.ChannelsDefaultDatarate = MacCtx.NvmCtx->MacParamsDefaults.ChannelsDatarate;
+            mibGet->Param.ChannelsDefaultDatarate = MacCtx->NvmCtx->MacParamsDefaults.ChannelsDatarate;
             break;
         }
         case MIB_CHANNELS_DATARATE:
         {
-            mibGet->Param.ChannelsDatarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
+            mibGet->Param.ChannelsDatarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
             break;
         }
         case MIB_CHANNELS_DEFAULT_TX_POWER:
         {
-            mibGet->Param.ChannelsDefaultTxPower = MacCtx.NvmCtx->MacParamsDefaults.ChannelsTxPower;
+            mibGet->Param.ChannelsDefaultTxPower = MacCtx->NvmCtx->MacParamsDefaults.ChannelsTxPower;
             break;
         }
         case MIB_CHANNELS_TX_POWER:
         {
-            mibGet->Param.ChannelsTxPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
+            mibGet->Param.ChannelsTxPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
             break;
         }
         case MIB_SYSTEM_MAX_RX_ERROR:
         {
-            mibGet->Param.SystemMaxRxError = MacCtx.NvmCtx->MacParams.SystemMaxRxError;
+            mibGet->Param.SystemMaxRxError = MacCtx->NvmCtx->MacParams.SystemMaxRxError;
             break;
         }
         case MIB_MIN_RX_SYMBOLS:
         {
-            mibGet->Param.MinRxSymbols = MacCtx.NvmCtx->MacParams.MinRxSymbols;
+            mibGet->Param.MinRxSymbols = MacCtx->NvmCtx->MacParams.MinRxSymbols;
             break;
         }
         case MIB_ANTENNA_GAIN:
         {
-            mibGet->Param.AntennaGain = MacCtx.NvmCtx->MacParams.AntennaGain;
+            mibGet->Param.AntennaGain = MacCtx->NvmCtx->MacParams.AntennaGain;
             break;
         }
         case MIB_NVM_CTXS:
@@ -3609,7 +3761,7 @@ LoRaMacStatus_t LoRaMacMibGetRequestConfirm( MibRequestConfirm_t* mibGet )
         }
         case MIB_DEFAULT_ANTENNA_GAIN:
         {
-            mibGet->Param.DefaultAntennaGain = MacCtx.NvmCtx->MacParamsDefaults.AntennaGain;
+            mibGet->Param.DefaultAntennaGain = MacCtx->NvmCtx->MacParamsDefaults.AntennaGain;
             break;
         }
         default:
@@ -3631,7 +3783,7 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
     {
         return LORAMAC_STATUS_PARAMETER_INVALID;
     }
-    if( ( MacCtx.MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
+    if( ( MacCtx->MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
     {
         return LORAMAC_STATUS_BUSY;
     }
@@ -3647,7 +3799,7 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         {
             if( mibSet->Param.NetworkActivation != ACTIVATION_TYPE_OTAA  )
             {
-                MacCtx.NvmCtx->NetworkActivation = mibSet->Param.NetworkActivation;
+                MacCtx->NvmCtx->NetworkActivation = mibSet->Param.NetworkActivation;
             }
             else
             {   // Do not allow to set ACTIVATION_TYPE_OTAA since the MAC will set it automatically after a successful join process.
@@ -3673,17 +3825,17 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         }
         case MIB_ADR:
         {
-            MacCtx.NvmCtx->AdrCtrlOn = mibSet->Param.AdrEnable;
+            MacCtx->NvmCtx->AdrCtrlOn = mibSet->Param.AdrEnable;
             break;
         }
         case MIB_NET_ID:
         {
-            MacCtx.NvmCtx->NetID = mibSet->Param.NetID;
+            MacCtx->NvmCtx->NetID = mibSet->Param.NetID;
             break;
         }
         case MIB_DEV_ADDR:
         {
-            MacCtx.NvmCtx->DevAddr = mibSet->Param.DevAddr;
+            MacCtx->NvmCtx->DevAddr = mibSet->Param.DevAddr;
             break;
         }
         case MIB_GEN_APP_KEY:
@@ -4018,23 +4170,23 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         }
         case MIB_PUBLIC_NETWORK:
         {
-            MacCtx.NvmCtx->PublicNetwork = mibSet->Param.EnablePublicNetwork;
-            Radio.SetPublicNetwork( MacCtx.NvmCtx->PublicNetwork );
+            MacCtx->NvmCtx->PublicNetwork = mibSet->Param.EnablePublicNetwork;
+            Radio.SetPublicNetwork( MacCtx->NvmCtx->PublicNetwork );
             break;
         }
         case MIB_REPEATER_SUPPORT:
         {
-            MacCtx.NvmCtx->RepeaterSupport = mibSet->Param.EnableRepeaterSupport;
+            MacCtx->NvmCtx->RepeaterSupport = mibSet->Param.EnableRepeaterSupport;
             break;
         }
         case MIB_RX2_CHANNEL:
         {
             verify.DatarateParams.Datarate = mibSet->Param.Rx2Channel.Datarate;
-            verify.DatarateParams.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
+            verify.DatarateParams.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_RX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_RX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParams.Rx2Channel = mibSet->Param.Rx2Channel;
+                MacCtx->NvmCtx->MacParams.Rx2Channel = mibSet->Param.Rx2Channel;
             }
             else
             {
@@ -4045,11 +4197,11 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         case MIB_RX2_DEFAULT_CHANNEL:
         {
             verify.DatarateParams.Datarate = mibSet->Param.Rx2Channel.Datarate;
-            verify.DatarateParams.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
+            verify.DatarateParams.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_RX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_RX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParamsDefaults.Rx2Channel = mibSet->Param.Rx2DefaultChannel;
+                MacCtx->NvmCtx->MacParamsDefaults.Rx2Channel = mibSet->Param.Rx2DefaultChannel;
             }
             else
             {
@@ -4060,13 +4212,13 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         case MIB_RXC_CHANNEL:
         {
             verify.DatarateParams.Datarate = mibSet->Param.RxCChannel.Datarate;
-            verify.DatarateParams.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
+            verify.DatarateParams.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_RX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_RX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParams.RxCChannel = mibSet->Param.RxCChannel;
+                MacCtx->NvmCtx->MacParams.RxCChannel = mibSet->Param.RxCChannel;
 
-                if( ( MacCtx.NvmCtx->DeviceClass == CLASS_C ) && ( MacCtx.NvmCtx->NetworkActivation != ACTIVATION_TYPE_NONE ) )
+                if( ( MacCtx->NvmCtx->DeviceClass == CLASS_C ) && ( MacCtx->NvmCtx->NetworkActivation != ACTIVATION_TYPE_NONE ) )
                 {
                     // We can only compute the RX window parameters directly, if we are already
                     // in class c mode and joined. We cannot setup an RX window in case of any other
@@ -4086,11 +4238,11 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         case MIB_RXC_DEFAULT_CHANNEL:
         {
             verify.DatarateParams.Datarate = mibSet->Param.RxCChannel.Datarate;
-            verify.DatarateParams.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
+            verify.DatarateParams.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_RX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_RX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParamsDefaults.RxCChannel = mibSet->Param.RxCDefaultChannel;
+                MacCtx->NvmCtx->MacParamsDefaults.RxCChannel = mibSet->Param.RxCDefaultChannel;
             }
             else
             {
@@ -4103,7 +4255,7 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
             chanMaskSet.ChannelsMaskIn = mibSet->Param.ChannelsDefaultMask;
             chanMaskSet.ChannelsMaskType = CHANNELS_DEFAULT_MASK;
 
-            if( RegionChanMaskSet( MacCtx.NvmCtx->Region, &chanMaskSet ) == false )
+            if( RegionChanMaskSet( MacCtx->NvmCtx->Region, &chanMaskSet ) == false )
             {
                 status = LORAMAC_STATUS_PARAMETER_INVALID;
             }
@@ -4114,7 +4266,7 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
             chanMaskSet.ChannelsMaskIn = mibSet->Param.ChannelsMask;
             chanMaskSet.ChannelsMaskType = CHANNELS_MASK;
 
-            if( RegionChanMaskSet( MacCtx.NvmCtx->Region, &chanMaskSet ) == false )
+            if( RegionChanMaskSet( MacCtx->NvmCtx->Region, &chanMaskSet ) == false )
             {
                 status = LORAMAC_STATUS_PARAMETER_INVALID;
             }
@@ -4125,7 +4277,7 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
             if( ( mibSet->Param.ChannelsNbTrans >= 1 ) &&
                 ( mibSet->Param.ChannelsNbTrans <= 15 ) )
             {
-                MacCtx.NvmCtx->MacParams.ChannelsNbTrans = mibSet->Param.ChannelsNbTrans;
+                MacCtx->NvmCtx->MacParams.ChannelsNbTrans = mibSet->Param.ChannelsNbTrans;
             }
             else
             {
@@ -4135,36 +4287,36 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         }
         case MIB_MAX_RX_WINDOW_DURATION:
         {
-            MacCtx.NvmCtx->MacParams.MaxRxWindow = mibSet->Param.MaxRxWindow;
+            MacCtx->NvmCtx->MacParams.MaxRxWindow = mibSet->Param.MaxRxWindow;
             break;
         }
         case MIB_RECEIVE_DELAY_1:
         {
-            MacCtx.NvmCtx->MacParams.ReceiveDelay1 = mibSet->Param.ReceiveDelay1;
+            MacCtx->NvmCtx->MacParams.ReceiveDelay1 = mibSet->Param.ReceiveDelay1;
             break;
         }
         case MIB_RECEIVE_DELAY_2:
         {
-            MacCtx.NvmCtx->MacParams.ReceiveDelay2 = mibSet->Param.ReceiveDelay2;
+            MacCtx->NvmCtx->MacParams.ReceiveDelay2 = mibSet->Param.ReceiveDelay2;
             break;
         }
         case MIB_JOIN_ACCEPT_DELAY_1:
         {
-            MacCtx.NvmCtx->MacParams.JoinAcceptDelay1 = mibSet->Param.JoinAcceptDelay1;
+            MacCtx->NvmCtx->MacParams.JoinAcceptDelay1 = mibSet->Param.JoinAcceptDelay1;
             break;
         }
         case MIB_JOIN_ACCEPT_DELAY_2:
         {
-            MacCtx.NvmCtx->MacParams.JoinAcceptDelay2 = mibSet->Param.JoinAcceptDelay2;
+            MacCtx->NvmCtx->MacParams.JoinAcceptDelay2 = mibSet->Param.JoinAcceptDelay2;
             break;
         }
         case MIB_CHANNELS_DEFAULT_DATARATE:
         {
             verify.DatarateParams.Datarate = mibSet->Param.ChannelsDefaultDatarate;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_DEF_TX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_DEF_TX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParamsDefaults.ChannelsDatarate = verify.DatarateParams.Datarate;
+                MacCtx->NvmCtx->MacParamsDefaults.ChannelsDatarate = verify.DatarateParams.Datarate;
             }
             else
             {
@@ -4175,11 +4327,11 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         case MIB_CHANNELS_DATARATE:
         {
             verify.DatarateParams.Datarate = mibSet->Param.ChannelsDatarate;
-            verify.DatarateParams.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
+            verify.DatarateParams.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_TX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_TX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParams.ChannelsDatarate = verify.DatarateParams.Datarate;
+                MacCtx->NvmCtx->MacParams.ChannelsDatarate = verify.DatarateParams.Datarate;
             }
             else
             {
@@ -4191,9 +4343,9 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         {
             verify.TxPower = mibSet->Param.ChannelsDefaultTxPower;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_DEF_TX_POWER ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_DEF_TX_POWER ) == true )
             {
-                MacCtx.NvmCtx->MacParamsDefaults.ChannelsTxPower = verify.TxPower;
+                MacCtx->NvmCtx->MacParamsDefaults.ChannelsTxPower = verify.TxPower;
             }
             else
             {
@@ -4205,9 +4357,9 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         {
             verify.TxPower = mibSet->Param.ChannelsTxPower;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_TX_POWER ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_TX_POWER ) == true )
             {
-                MacCtx.NvmCtx->MacParams.ChannelsTxPower = verify.TxPower;
+                MacCtx->NvmCtx->MacParams.ChannelsTxPower = verify.TxPower;
             }
             else
             {
@@ -4217,22 +4369,22 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         }
         case MIB_SYSTEM_MAX_RX_ERROR:
         {
-            MacCtx.NvmCtx->MacParams.SystemMaxRxError = MacCtx.NvmCtx->MacParamsDefaults.SystemMaxRxError = mibSet->Param.SystemMaxRxError;
+            MacCtx->NvmCtx->MacParams.SystemMaxRxError = MacCtx->NvmCtx->MacParamsDefaults.SystemMaxRxError = mibSet->Param.SystemMaxRxError;
             break;
         }
         case MIB_MIN_RX_SYMBOLS:
         {
-            MacCtx.NvmCtx->MacParams.MinRxSymbols = MacCtx.NvmCtx->MacParamsDefaults.MinRxSymbols = mibSet->Param.MinRxSymbols;
+            MacCtx->NvmCtx->MacParams.MinRxSymbols = MacCtx->NvmCtx->MacParamsDefaults.MinRxSymbols = mibSet->Param.MinRxSymbols;
             break;
         }
         case MIB_ANTENNA_GAIN:
         {
-            MacCtx.NvmCtx->MacParams.AntennaGain = mibSet->Param.AntennaGain;
+            MacCtx->NvmCtx->MacParams.AntennaGain = mibSet->Param.AntennaGain;
             break;
         }
         case MIB_DEFAULT_ANTENNA_GAIN:
         {
-            MacCtx.NvmCtx->MacParamsDefaults.AntennaGain = mibSet->Param.DefaultAntennaGain;
+            MacCtx->NvmCtx->MacParamsDefaults.AntennaGain = mibSet->Param.DefaultAntennaGain;
             break;
         }
         case MIB_NVM_CTXS:
@@ -4251,7 +4403,7 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         {
             if( mibSet->Param.AbpLrWanVersion.Fields.Minor <= 1 )
             {
-                MacCtx.NvmCtx->Version = mibSet->Param.AbpLrWanVersion;
+                MacCtx->NvmCtx->Version = mibSet->Param.AbpLrWanVersion;
 
                 if( LORAMAC_CRYPTO_SUCCESS != LoRaMacCryptoSetLrWanVersion( mibSet->Param.AbpLrWanVersion ) )
                 {
@@ -4280,9 +4432,9 @@ LoRaMacStatus_t LoRaMacChannelAdd( uint8_t id, ChannelParams_t params )
     ChannelAddParams_t channelAdd;
 
     // Validate if the MAC is in a correct state
-    if( ( MacCtx.MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
+    if( ( MacCtx->MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
     {
-        if( ( MacCtx.MacState & LORAMAC_TX_CONFIG ) != LORAMAC_TX_CONFIG )
+        if( ( MacCtx->MacState & LORAMAC_TX_CONFIG ) != LORAMAC_TX_CONFIG )
         {
             return LORAMAC_STATUS_BUSY;
         }
@@ -4292,16 +4444,16 @@ LoRaMacStatus_t LoRaMacChannelAdd( uint8_t id, ChannelParams_t params )
     channelAdd.ChannelId = id;
 
     EventRegionNvmCtxChanged( );
-    return RegionChannelAdd( MacCtx.NvmCtx->Region, &channelAdd );
+    return RegionChannelAdd( MacCtx->NvmCtx->Region, &channelAdd );
 }
 
 LoRaMacStatus_t LoRaMacChannelRemove( uint8_t id )
 {
     ChannelRemoveParams_t channelRemove;
 
-    if( ( MacCtx.MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
+    if( ( MacCtx->MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
     {
-        if( ( MacCtx.MacState & LORAMAC_TX_CONFIG ) != LORAMAC_TX_CONFIG )
+        if( ( MacCtx->MacState & LORAMAC_TX_CONFIG ) != LORAMAC_TX_CONFIG )
         {
             return LORAMAC_STATUS_BUSY;
         }
@@ -4309,7 +4461,7 @@ LoRaMacStatus_t LoRaMacChannelRemove( uint8_t id )
 
     channelRemove.ChannelId = id;
 
-    if( RegionChannelsRemove( MacCtx.NvmCtx->Region, &channelRemove ) == false )
+    if( RegionChannelsRemove( MacCtx->NvmCtx->Region, &channelRemove ) == false )
     {
         return LORAMAC_STATUS_PARAMETER_INVALID;
     }
@@ -4320,7 +4472,7 @@ LoRaMacStatus_t LoRaMacChannelRemove( uint8_t id )
 
 LoRaMacStatus_t LoRaMacMcChannelSetup( McChannelParams_t *channel )
 {
-    if( ( MacCtx.MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
+    if( ( MacCtx->MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
     {
         return LORAMAC_STATUS_BUSY;
     }
@@ -4330,7 +4482,7 @@ LoRaMacStatus_t LoRaMacMcChannelSetup( McChannelParams_t *channel )
         return LORAMAC_STATUS_MC_GROUP_UNDEFINED;
     }
 
-    MacCtx.NvmCtx->MulticastChannelList[channel->GroupID].ChannelParams = *channel;
+    MacCtx->NvmCtx->MulticastChannelList[channel->GroupID].ChannelParams = *channel;
 
     const KeyIdentifier_t mcKeys[LORAMAC_MAX_MC_CTX] = { MC_KEY_0, MC_KEY_1, MC_KEY_2, MC_KEY_3 };
     if( LoRaMacCryptoSetKey( mcKeys[channel->GroupID], channel->McKeyE ) != LORAMAC_CRYPTO_SUCCESS )
@@ -4346,11 +4498,11 @@ LoRaMacStatus_t LoRaMacMcChannelSetup( McChannelParams_t *channel )
     if( channel->Class == CLASS_B )
     {
         // Calculate class b parameters
-        LoRaMacClassBSetMulticastPeriodicity( &MacCtx.NvmCtx->MulticastChannelList[channel->GroupID] );
+        LoRaMacClassBSetMulticastPeriodicity( &MacCtx->NvmCtx->MulticastChannelList[channel->GroupID] );
     }
 
     // Reset multicast channel downlink counter to initial value.
-    *MacCtx.NvmCtx->MulticastChannelList[channel->GroupID].DownLinkCounter = FCNT_DOWN_INITAL_VALUE;
+    *MacCtx->NvmCtx->MulticastChannelList[channel->GroupID].DownLinkCounter = FCNT_DOWN_INITAL_VALUE;
 
     EventMacNvmCtxChanged( );
     EventRegionNvmCtxChanged( );
@@ -4359,13 +4511,13 @@ LoRaMacStatus_t LoRaMacMcChannelSetup( McChannelParams_t *channel )
 
 LoRaMacStatus_t LoRaMacMcChannelDelete( AddressIdentifier_t groupID )
 {
-    if( ( MacCtx.MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
+    if( ( MacCtx->MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
     {
         return LORAMAC_STATUS_BUSY;
     }
 
     if( ( groupID >= LORAMAC_MAX_MC_CTX ) || 
-        ( MacCtx.NvmCtx->MulticastChannelList[groupID].ChannelParams.IsEnabled == false ) )
+        ( MacCtx->NvmCtx->MulticastChannelList[groupID].ChannelParams.IsEnabled == false ) )
     {
         return LORAMAC_STATUS_MC_GROUP_UNDEFINED;
     }
@@ -4375,7 +4527,7 @@ LoRaMacStatus_t LoRaMacMcChannelDelete( AddressIdentifier_t groupID )
     // Set all channel fields with 0
     memset1( ( uint8_t* )&channel, 0, sizeof( McChannelParams_t ) );
 
-    MacCtx.NvmCtx->MulticastChannelList[groupID].ChannelParams = channel;
+    MacCtx->NvmCtx->MulticastChannelList[groupID].ChannelParams = channel;
 
     EventMacNvmCtxChanged( );
     EventRegionNvmCtxChanged( );
@@ -4386,7 +4538,7 @@ uint8_t LoRaMacMcChannelGetGroupId( uint32_t mcAddress )
 {
     for( uint8_t i = 0; i < LORAMAC_MAX_MC_CTX; i++ )
     {
-        if( mcAddress == MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.Address )
+        if( mcAddress == MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.Address )
         {
             return i;
         }
@@ -4398,19 +4550,19 @@ LoRaMacStatus_t LoRaMacMcChannelSetupRxParams( AddressIdentifier_t groupID, McRx
 {
    *status = 0x1C + ( groupID & 0x03 );
 
-    if( ( MacCtx.MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
+    if( ( MacCtx->MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
     {
         return LORAMAC_STATUS_BUSY;
     }
 
-    DeviceClass_t devClass = MacCtx.NvmCtx->MulticastChannelList[groupID].ChannelParams.Class;
+    DeviceClass_t devClass = MacCtx->NvmCtx->MulticastChannelList[groupID].ChannelParams.Class;
     if( ( devClass == CLASS_A ) || ( devClass > CLASS_C ) )
     {
         return LORAMAC_STATUS_PARAMETER_INVALID;
     }
 
     if( ( groupID >= LORAMAC_MAX_MC_CTX ) || 
-        ( MacCtx.NvmCtx->MulticastChannelList[groupID].ChannelParams.IsEnabled == false ) )
+        ( MacCtx->NvmCtx->MulticastChannelList[groupID].ChannelParams.IsEnabled == false ) )
     {
         return LORAMAC_STATUS_MC_GROUP_UNDEFINED;
     }
@@ -4426,9 +4578,9 @@ LoRaMacStatus_t LoRaMacMcChannelSetupRxParams( AddressIdentifier_t groupID, McRx
     {
         verify.DatarateParams.Datarate = rxParams->ClassC.Datarate;
     }
-    verify.DatarateParams.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
+    verify.DatarateParams.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
 
-    if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_RX_DR ) == true )
+    if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_RX_DR ) == true )
     {
         *status &= 0xFB; // datarate OK
     }
@@ -4442,7 +4594,7 @@ LoRaMacStatus_t LoRaMacMcChannelSetupRxParams( AddressIdentifier_t groupID, McRx
     {
         verify.Frequency = rxParams->ClassC.Frequency;
     }
-    if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_FREQUENCY ) == true )
+    if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_FREQUENCY ) == true )
     {
         *status &= 0xF7; // frequency OK
     }
@@ -4450,7 +4602,7 @@ LoRaMacStatus_t LoRaMacMcChannelSetupRxParams( AddressIdentifier_t groupID, McRx
     if( *status == ( groupID & 0x03 ) )
     {
         // Apply parameters
-        MacCtx.NvmCtx->MulticastChannelList[groupID].ChannelParams.RxParams = *rxParams;
+        MacCtx->NvmCtx->MulticastChannelList[groupID].ChannelParams.RxParams = *rxParams;
     }
 
     EventMacNvmCtxChanged( );
@@ -4479,11 +4631,11 @@ LoRaMacStatus_t LoRaMacMlmeRequest( MlmeReq_t* mlmeRequest )
 
     if( LoRaMacConfirmQueueGetCnt( ) == 0 )
     {
-        memset1( ( uint8_t* ) &MacCtx.MlmeConfirm, 0, sizeof( MacCtx.MlmeConfirm ) );
+        memset1( ( uint8_t* ) &MacCtx->MlmeConfirm, 0, sizeof( MacCtx->MlmeConfirm ) );
     }
-    MacCtx.MlmeConfirm.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+    MacCtx->MlmeConfirm.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
 
-    MacCtx.MacFlags.Bits.MlmeReq = 1;
+    MacCtx->MacFlags.Bits.MlmeReq = 1;
     queueElement.Request = mlmeRequest->Type;
     queueElement.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
     queueElement.RestrictCommonReadyToHandle = false;
@@ -4492,14 +4644,14 @@ LoRaMacStatus_t LoRaMacMlmeRequest( MlmeReq_t* mlmeRequest )
     {
         case MLME_JOIN:
         {
-            if( ( MacCtx.MacState & LORAMAC_TX_DELAYED ) == LORAMAC_TX_DELAYED )
+            if( ( MacCtx->MacState & LORAMAC_TX_DELAYED ) == LORAMAC_TX_DELAYED )
             {
                 return LORAMAC_STATUS_BUSY;
             }
 
             ResetMacParameters( );
 
-            MacCtx.NvmCtx->MacParams.ChannelsDatarate = RegionAlternateDr( MacCtx.NvmCtx->Region, mlmeRequest->Req.Join.Datarate, ALTERNATE_DR );
+            MacCtx->NvmCtx->MacParams.ChannelsDatarate = RegionAlternateDr( MacCtx->NvmCtx->Region, mlmeRequest->Req.Join.Datarate, ALTERNATE_DR );
 
             queueElement.Status = LORAMAC_EVENT_INFO_STATUS_JOIN_FAIL;
 
@@ -4508,7 +4660,7 @@ LoRaMacStatus_t LoRaMacMlmeRequest( MlmeReq_t* mlmeRequest )
             if( status != LORAMAC_STATUS_OK )
             {
                 // Revert back the previous datarate ( mainly used for US915 like regions )
-                MacCtx.NvmCtx->MacParams.ChannelsDatarate = RegionAlternateDr( MacCtx.NvmCtx->Region, mlmeRequest->Req.Join.Datarate, ALTERNATE_DR_RESTORE );
+                MacCtx->NvmCtx->MacParams.ChannelsDatarate = RegionAlternateDr( MacCtx->NvmCtx->Region, mlmeRequest->Req.Join.Datarate, ALTERNATE_DR_RESTORE );
             }
             break;
         }
@@ -4545,7 +4697,7 @@ LoRaMacStatus_t LoRaMacMlmeRequest( MlmeReq_t* mlmeRequest )
         }
         case MLME_PING_SLOT_INFO:
         {
-            if( MacCtx.NvmCtx->DeviceClass == CLASS_A )
+            if( MacCtx->NvmCtx->DeviceClass == CLASS_A )
             {
                 uint8_t value = mlmeRequest->Req.PingSlotInfo.PingSlot.Value;
 
@@ -4597,8 +4749,8 @@ LoRaMacStatus_t LoRaMacMlmeRequest( MlmeReq_t* mlmeRequest )
     {
         if( LoRaMacConfirmQueueGetCnt( ) == 0 )
         {
-            MacCtx.NodeAckRequested = false;
-            MacCtx.MacFlags.Bits.MlmeReq = 0;
+            MacCtx->NodeAckRequested = false;
+            MacCtx->MacFlags.Bits.MlmeReq = 0;
         }
     }
     else
@@ -4632,18 +4784,18 @@ LoRaMacStatus_t LoRaMacMcpsRequest( McpsReq_t* mcpsRequest )
     }
 
     macHdr.Value = 0;
-    memset1( ( uint8_t* ) &MacCtx.McpsConfirm, 0, sizeof( MacCtx.McpsConfirm ) );
-    MacCtx.McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+    memset1( ( uint8_t* ) &MacCtx->McpsConfirm, 0, sizeof( MacCtx->McpsConfirm ) );
+    MacCtx->McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
 
     // AckTimeoutRetriesCounter must be reset every time a new request (unconfirmed or confirmed) is performed.
-    MacCtx.AckTimeoutRetriesCounter = 1;
+    MacCtx->AckTimeoutRetriesCounter = 1;
 
     switch( mcpsRequest->Type )
     {
         case MCPS_UNCONFIRMED:
         {
             readyToSend = true;
-            MacCtx.AckTimeoutRetries = 1;
+            MacCtx->AckTimeoutRetries = 1;
 
             macHdr.Bits.MType = FRAME_TYPE_DATA_UNCONFIRMED_UP;
             fPort = mcpsRequest->Req.Unconfirmed.fPort;
@@ -4655,7 +4807,7 @@ LoRaMacStatus_t LoRaMacMcpsRequest( McpsReq_t* mcpsRequest )
         case MCPS_CONFIRMED:
         {
             readyToSend = true;
-            MacCtx.AckTimeoutRetries = MIN( mcpsRequest->Req.Confirmed.NbTrials, MAX_ACK_RETRIES );
+            MacCtx->AckTimeoutRetries = MIN( mcpsRequest->Req.Confirmed.NbTrials, MAX_ACK_RETRIES );
 
             macHdr.Bits.MType = FRAME_TYPE_DATA_CONFIRMED_UP;
             fPort = mcpsRequest->Req.Confirmed.fPort;
@@ -4667,7 +4819,7 @@ LoRaMacStatus_t LoRaMacMcpsRequest( McpsReq_t* mcpsRequest )
         case MCPS_PROPRIETARY:
         {
             readyToSend = true;
-            MacCtx.AckTimeoutRetries = 1;
+            MacCtx->AckTimeoutRetries = 1;
 
             macHdr.Bits.MType = FRAME_TYPE_PROPRIETARY;
             fBuffer = mcpsRequest->Req.Proprietary.fBuffer;
@@ -4681,22 +4833,22 @@ LoRaMacStatus_t LoRaMacMcpsRequest( McpsReq_t* mcpsRequest )
 
     // Get the minimum possible datarate
     getPhy.Attribute = PHY_MIN_TX_DR;
-    getPhy.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+    getPhy.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
     // Apply the minimum possible datarate.
     // Some regions have limitations for the minimum datarate.
     datarate = MAX( datarate, ( int8_t )phyParam.Value );
 
     if( readyToSend == true )
     {
-        if( MacCtx.NvmCtx->AdrCtrlOn == false )
+        if( MacCtx->NvmCtx->AdrCtrlOn == false )
         {
             verify.DatarateParams.Datarate = datarate;
-            verify.DatarateParams.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
+            verify.DatarateParams.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_TX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_TX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParams.ChannelsDatarate = verify.DatarateParams.Datarate;
+                MacCtx->NvmCtx->MacParams.ChannelsDatarate = verify.DatarateParams.Datarate;
             }
             else
             {
@@ -4707,12 +4859,12 @@ LoRaMacStatus_t LoRaMacMcpsRequest( McpsReq_t* mcpsRequest )
         status = Send( &macHdr, fPort, fBuffer, fBufferSize );
         if( status == LORAMAC_STATUS_OK )
         {
-            MacCtx.McpsConfirm.McpsRequest = mcpsRequest->Type;
-            MacCtx.MacFlags.Bits.McpsReq = 1;
+            MacCtx->McpsConfirm.McpsRequest = mcpsRequest->Type;
+            MacCtx->MacFlags.Bits.McpsReq = 1;
         }
         else
         {
-            MacCtx.NodeAckRequested = false;
+            MacCtx->NodeAckRequested = false;
         }
     }
 
@@ -4726,8 +4878,8 @@ void LoRaMacTestSetDutyCycleOn( bool enable )
 
     verify.DutyCycle = enable;
 
-    if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_DUTY_CYCLE ) == true )
+    if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_DUTY_CYCLE ) == true )
     {
-        MacCtx.NvmCtx->DutyCycleOn = enable;
+        MacCtx->NvmCtx->DutyCycleOn = enable;
     }
 }
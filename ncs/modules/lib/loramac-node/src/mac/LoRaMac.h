@@ -2405,6 +2405,43 @@ typedef struct sLoRaMacCallback
  */
 static const uint8_t LoRaMacMaxEirpTable[] = { 8, 10, 12, 13, 14, 16, 18, 20, 21, 24, 26, 27, 29, 30, 33, 36 };
 
+/*!
+ * \brief   Returns the size of the memory block holding the complete stack
+ *          state of one end-device: MAC, crypto, MAC commands, confirm queue,
+ *          class B, region and secure element.
+ *
+ * \retval  Size of an instance memory block in bytes.
+ */
+size_t LoRaMacInstanceGetSize( void );
+
+/*!
+ * \brief   Selects the end-device instance the LoRaMAC layer operates on
+ *
+ * \details Allows one process to run several end-devices, e.g. to simulate
+ *          them on a host. Every LoRaMac API call, radio event and
+ *          LoRaMacProcess call applies to the selected instance. Timers
+ *          started by an instance select it while their handler runs and
+ *          restore the previous selection before returning.
+ *          A newly selected block must be initialized with
+ *          \ref LoRaMacInitialization before any other call.
+ *
+ * \remark  Instances share one execution context. The radio and timer events
+ *          of an instance must not preempt the processing of another one.
+ *
+ * \param   [IN] instance   - Zero initialized and 8 byte aligned memory block
+ *                            of \ref LoRaMacInstanceGetSize bytes.
+ *                            NULL selects the built-in default instance.
+ */
+void LoRaMacInstanceSelect( void* instance );
+
+/*!
+ * \brief   Returns the selected instance
+ *
+ * \retval  Memory block given to \ref LoRaMacInstanceSelect, NULL for the
+ *          default instance.
+ */
+void* LoRaMacInstanceGetSelected( void );
+
 /*!
  * \brief   LoRaMAC layer initialization
  *
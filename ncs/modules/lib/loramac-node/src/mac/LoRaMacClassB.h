@@ -314,6 +314,23 @@ bool LoRaMacClassBRestoreNvmCtx( void* classBNvmCtx );
  */
 void* LoRaMacClassBGetNvmCtx( size_t* classBNvmCtxSize );
 
+/*!
+ * Returns the size of the memory block holding the class B state of one
+ * LoRaMac instance.
+ *
+ * \retval                         - Size of the instance context in bytes
+ */
+size_t LoRaMacClassBGetInstanceCtxSize( void );
+
+/*!
+ * Selects the memory block the class B operates on. Called by
+ * LoRaMacInstanceSelect.
+ *
+ * \param[IN]     instanceCtx      - Zero initialized block of GetInstanceCtxSize bytes.
+ *                                   NULL selects the default instance.
+ */
+void LoRaMacClassBSetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief Set the state of the beacon state machine
  *
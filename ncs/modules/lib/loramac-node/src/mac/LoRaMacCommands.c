@@ -72,10 +72,15 @@ typedef struct sLoRaMacCommandsCtx
  */
 static LoRaMacCommandsNvmEvent CommandsNvmCtxChanged;
 
+/*!
+ * Non-volatile module context of the default LoRaMac instance.
+ */
+static LoRaMacCommandsCtx_t DefaultNvmCtx;
+
 /*!
  * Non-volatile module context.
  */
-static LoRaMacCommandsCtx_t NvmCtx;
+static LoRaMacCommandsCtx_t* NvmCtx = &DefaultNvmCtx;
 
 /* Memory management functions */
 
@@ -108,7 +113,7 @@ static MacCommand_t* MallocNewMacCommandSlot( void )
 {
     uint8_t itr = 0;
 
-    while( IsSlotFree( ( const MacCommand_t* )&NvmCtx.MacCommandSlots[itr] ) == false )
+    while( IsSlotFree( ( const MacCommand_t* )&NvmCtx->MacCommandSlots[itr] ) == false )
     {
         itr++;
         if( itr == NUM_OF_MAC_COMMANDS )
@@ -117,7 +122,7 @@ static MacCommand_t* MallocNewMacCommandSlot( void )
         }
     }
 
-    return &NvmCtx.MacCommandSlots[itr];
+    return &NvmCtx->MacCommandSlots[itr];
 }
 
 /*!
@@ -301,9 +306,9 @@ static void NvmCtxCallback( void )
 LoRaMacCommandStatus_t LoRaMacCommandsInit( LoRaMacCommandsNvmEvent commandsNvmCtxChanged )
 {
     // Initialize with default
-    memset1( ( uint8_t* )&NvmCtx, 0, sizeof( NvmCtx ) );
+    memset1( ( uint8_t* )NvmCtx, 0, sizeof( LoRaMacCommandsCtx_t ) );
 
-    LinkedListInit( &NvmCtx.MacCommandList );
+    LinkedListInit( &NvmCtx->MacCommandList );
 
     // Assign callback
     CommandsNvmCtxChanged = commandsNvmCtxChanged;
@@ -316,7 +321,7 @@ LoRaMacCommandStatus_t LoRaMacCommandsRestoreNvmCtx( void* commandsNvmCtx )
     // Restore module context
     if( commandsNvmCtx != NULL )
     {
-        memcpy1( ( uint8_t* )&NvmCtx, ( uint8_t* )commandsNvmCtx, sizeof( NvmCtx ) );
+        memcpy1( ( uint8_t* )NvmCtx, ( uint8_t* )commandsNvmCtx, sizeof( LoRaMacCommandsCtx_t ) );
         return LORAMAC_COMMANDS_SUCCESS;
     }
     else
@@ -327,8 +332,25 @@ LoRaMacCommandStatus_t LoRaMacCommandsRestoreNvmCtx( void* commandsNvmCtx )
 
 void* LoRaMacCommandsGetNvmCtx( size_t* commandsNvmCtxSize )
 {
-    *commandsNvmCtxSize = sizeof( NvmCtx );
-    return &NvmCtx;
+    *commandsNvmCtxSize = sizeof( LoRaMacCommandsCtx_t );
+    return NvmCtx;
+}
+
+size_t LoRaMacCommandsGetInstanceCtxSize( void )
+{
+    return sizeof( LoRaMacCommandsCtx_t );
+}
+
+void LoRaMacCommandsSetInstanceCtx( void* instanceCtx )
+{
+    if( instanceCtx != NULL )
+    {
+        NvmCtx = ( LoRaMacCommandsCtx_t* ) instanceCtx;
+    }
+    else
+    {
+        NvmCtx = &DefaultNvmCtx;
+    }
 }
 
 LoRaMacCommandStatus_t LoRaMacCommandsAddCmd( uint8_t cid, uint8_t* payload, size_t payloadSize )
@@ -348,7 +370,7 @@ LoRaMacCommandStatus_t LoRaMacCommandsAddCmd( uint8_t cid, uint8_t* payload, siz
     }
 
     // Add it to the list of Mac commands
-    if( LinkedListAdd( &NvmCtx.MacCommandList, newCmd ) == false )
+    if( LinkedListAdd( &NvmCtx->MacCommandList, newCmd ) == false )
     {
         return LORAMAC_COMMANDS_ERROR;
     }
@@ -359,7 +381,7 @@ LoRaMacCommandStatus_t LoRaMacCommandsAddCmd( uint8_t cid, uint8_t* payload, siz
     memcpy1( ( uint8_t* )newCmd->Payload, payload, payloadSize );
     newCmd->IsSticky = IsSticky( cid );
 
-    NvmCtx.SerializedCmdsSize += ( CID_FIELD_SIZE + payloadSize );
+    NvmCtx->SerializedCmdsSize += ( CID_FIELD_SIZE + payloadSize );
 
     NvmCtxCallback( );
 
@@ -374,12 +396,12 @@ LoRaMacCommandStatus_t LoRaMacCommandsRemoveCmd( MacCommand_t* macCmd )
     }
 
     // Remove the Mac command element from MacCommandList
-    if( LinkedListRemove( &NvmCtx.MacCommandList, macCmd ) == false )
+    if( LinkedListRemove( &NvmCtx->MacCommandList, macCmd ) == false )
     {
         return LORAMAC_COMMANDS_ERROR_CMD_NOT_FOUND;
     }
 
-    NvmCtx.SerializedCmdsSize -= ( CID_FIELD_SIZE + macCmd->PayloadSize );
+    NvmCtx->SerializedCmdsSize -= ( CID_FIELD_SIZE + macCmd->PayloadSize );
 
     // Free the MacCommand Slot
     if( FreeMacCommandSlot( macCmd ) == false )
@@ -397,7 +419,7 @@ LoRaMacCommandStatus_t LoRaMacCommandsGetCmd( uint8_t cid, MacCommand_t** macCmd
     MacCommand_t* curElement;
 
     // Start at the head of the list
-    curElement = NvmCtx.MacCommandList.First;
+    curElement = NvmCtx->MacCommandList.First;
 
     // Loop through all elements until we find the element with the given CID
     while( ( curElement != NULL ) && ( curElement->CID != cid ) )
@@ -422,7 +444,7 @@ LoRaMacCommandStatus_t LoRaMacCommandsRemoveNoneStickyCmds( void )
     MacCommand_t* nexElement;
 
     // Start at the head of the list
-    curElement = NvmCtx.MacCommandList.First;
+    curElement = NvmCtx->MacCommandList.First;
 
     // Loop through all elements
     while( curElement != NULL )
@@ -450,7 +472,7 @@ LoRaMacCommandStatus_t LoRaMacCommandsRemoveStickyAnsCmds( void )
     MacCommand_t* nexElement;
 
     // Start at the head of the list
-    curElement = NvmCtx.MacCommandList.First;
+    curElement = NvmCtx->MacCommandList.First;
 
     // Loop through all elements
     while( curElement != NULL )
@@ -474,13 +496,13 @@ LoRaMacCommandStatus_t LoRaMacCommandsGetSizeSerializedCmds( size_t* size )
     {
         return LORAMAC_COMMANDS_ERROR_NPE;
     }
-    *size = NvmCtx.SerializedCmdsSize;
+    *size = NvmCtx->SerializedCmdsSize;
     return LORAMAC_COMMANDS_SUCCESS;
 }
 
 LoRaMacCommandStatus_t LoRaMacCommandsSerializeCmds( size_t availableSize, size_t* effectiveSize, uint8_t* buffer )
 {
-    MacCommand_t* curElement = NvmCtx.MacCommandList.First;
+    MacCommand_t* curElement = NvmCtx->MacCommandList.First;
     MacCommand_t* nextElement;
     uint8_t itr = 0;
 
@@ -528,7 +550,7 @@ LoRaMacCommandStatus_t LoRaMacCommandsStickyCmdsPending( bool* cmdsPending )
         return LORAMAC_COMMANDS_ERROR_NPE;
     }
     MacCommand_t* curElement;
-    curElement = NvmCtx.MacCommandList.First;
+    curElement = NvmCtx->MacCommandList.First;
 
     *cmdsPending = false;
 
@@ -144,6 +144,23 @@ LoRaMacCommandStatus_t LoRaMacCommandsRestoreNvmCtx( void* commandsNvmCtx );
  */
 void* LoRaMacCommandsGetNvmCtx( size_t* commandsNvmCtxSize );
 
+/*!
+ * Returns the size of the memory block holding the MAC commands module state of one
+ * LoRaMac instance.
+ *
+ * \retval                         - Size of the instance context in bytes
+ */
+size_t LoRaMacCommandsGetInstanceCtxSize( void );
+
+/*!
+ * Selects the memory block the MAC commands module operates on. Called by
+ * LoRaMacInstanceSelect.
+ *
+ * \param[IN]     instanceCtx      - Zero initialized block of GetInstanceCtxSize bytes.
+ *                                   NULL selects the default instance.
+ */
+void LoRaMacCommandsSetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief Adds a new MAC command to be sent.
  *
@@ -73,22 +73,42 @@ typedef struct sLoRaMacConfirmQueueCtx
     LoRaMacConfirmQueueNvmCtx_t* ConfirmQueueNvmCtx;
 } LoRaMacConfirmQueueCtx_t;
 
+/*
+ * Module state of one LoRaMac instance.
+ */
+typedef struct sLoRaMacConfirmQueueInstanceCtx
+{
+    /*
+     * Module context.
+     */
+    LoRaMacConfirmQueueCtx_t Ctx;
+    /*
+     * Non-volatile module context.
+     */
+    LoRaMacConfirmQueueNvmCtx_t NvmCtx;
+}LoRaMacConfirmQueueInstanceCtx_t;
+
+/*
+ * Module state of the default LoRaMac instance.
+ */
+static LoRaMacConfirmQueueInstanceCtx_t DefaultInstanceCtx;
+
 /*
  * Non-volatile module context.
  */
-static LoRaMacConfirmQueueNvmCtx_t ConfirmQueueNvmCtx;
+static LoRaMacConfirmQueueNvmCtx_t* ConfirmQueueNvmCtx = &DefaultInstanceCtx.NvmCtx;
 
 /*
  * Module context.
  */
-static LoRaMacConfirmQueueCtx_t ConfirmQueueCtx;
+static LoRaMacConfirmQueueCtx_t* ConfirmQueueCtx = &DefaultInstanceCtx.Ctx;
 
 static MlmeConfirmQueue_t* IncreaseBufferPointer( MlmeConfirmQueue_t* bufferPointer )
 {
-    if( bufferPointer == &ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue[LORA_MAC_MLME_CONFIRM_QUEUE_LEN - 1] )
+    if( bufferPointer == &ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue[LORA_MAC_MLME_CONFIRM_QUEUE_LEN - 1] )
     {
         // Reset to the first element
-        bufferPointer = ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue;
+        bufferPointer = ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue;
     }
     else
     {
@@ -100,10 +120,10 @@ static MlmeConfirmQueue_t* IncreaseBufferPointer( MlmeConfirmQueue_t* bufferPoin
 
 static MlmeConfirmQueue_t* DecreaseBufferPointer( MlmeConfirmQueue_t* bufferPointer )
 {
-    if( bufferPointer == ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue )
+    if( bufferPointer == ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue )
     {
         // Reset to the last element
-        bufferPointer = &ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue[LORA_MAC_MLME_CONFIRM_QUEUE_LEN - 1];
+        bufferPointer = &ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue[LORA_MAC_MLME_CONFIRM_QUEUE_LEN - 1];
     }
     else
     {
@@ -133,25 +153,25 @@ static MlmeConfirmQueue_t* GetElement( Mlme_t request, MlmeConfirmQueue_t* buffe
 
 void LoRaMacConfirmQueueInit( LoRaMacPrimitives_t* primitives, LoRaMacConfirmQueueNvmEvent confirmQueueNvmCtxChanged )
 {
-    ConfirmQueueCtx.Primitives = primitives;
+    ConfirmQueueCtx->Primitives = primitives;
 
     // Assign nvm context
-    ConfirmQueueCtx.ConfirmQueueNvmCtx = &ConfirmQueueNvmCtx;
+    ConfirmQueueCtx->ConfirmQueueNvmCtx = ConfirmQueueNvmCtx;
 
     // Init counter
-    ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt = 0;
+    ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt = 0;
 
     // Init buffer
-    ConfirmQueueCtx.BufferStart = ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue;
-    ConfirmQueueCtx.BufferEnd = ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue;
+    ConfirmQueueCtx->BufferStart = ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue;
+    ConfirmQueueCtx->BufferEnd = ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue;
 
-    memset1( ( uint8_t* )ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue, 0xFF, sizeof( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue ) );
+    memset1( ( uint8_t* )ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue, 0xFF, sizeof( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue ) );
 
     // Common status
-    ConfirmQueueCtx.ConfirmQueueNvmCtx->CommonStatus = LORAMAC_EVENT_INFO_STATUS_ERROR;
+    ConfirmQueueCtx->ConfirmQueueNvmCtx->CommonStatus = LORAMAC_EVENT_INFO_STATUS_ERROR;
 
     // Assign callback
-    ConfirmQueueCtx.LoRaMacConfirmQueueNvmEvent = confirmQueueNvmCtxChanged;
+    ConfirmQueueCtx->LoRaMacConfirmQueueNvmEvent = confirmQueueNvmCtxChanged;
 }
 
 bool LoRaMacConfirmQueueRestoreNvmCtx( void* confirmQueueNvmCtx )
@@ -159,7 +179,7 @@ bool LoRaMacConfirmQueueRestoreNvmCtx( void* confirmQueueNvmCtx )
     // Restore module context
     if( confirmQueueNvmCtx != NULL )
     {
-        memcpy1( ( uint8_t* )&ConfirmQueueNvmCtx, ( uint8_t* ) confirmQueueNvmCtx, sizeof( ConfirmQueueNvmCtx ) );
+        memcpy1( ( uint8_t* )ConfirmQueueNvmCtx, ( uint8_t* ) confirmQueueNvmCtx, sizeof( LoRaMacConfirmQueueNvmCtx_t ) );
         return true;
     }
     else
@@ -170,57 +190,74 @@ bool LoRaMacConfirmQueueRestoreNvmCtx( void* confirmQueueNvmCtx )
 
 void* LoRaMacConfirmQueueGetNvmCtx( size_t* confirmQueueNvmCtxSize )
 {
-    *confirmQueueNvmCtxSize = sizeof( ConfirmQueueNvmCtx );
-    return &ConfirmQueueNvmCtx;
+    *confirmQueueNvmCtxSize = sizeof( LoRaMacConfirmQueueNvmCtx_t );
+    return ConfirmQueueNvmCtx;
+}
+
+size_t LoRaMacConfirmQueueGetInstanceCtxSize( void )
+{
+    return sizeof( LoRaMacConfirmQueueInstanceCtx_t );
+}
+
+void LoRaMacConfirmQueueSetInstanceCtx( void* instanceCtx )
+{
+    LoRaMacConfirmQueueInstanceCtx_t* ctx = ( LoRaMacConfirmQueueInstanceCtx_t* ) instanceCtx;
+
+    if( ctx == NULL )
+    {
+        ctx = &DefaultInstanceCtx;
+    }
+    ConfirmQueueCtx = &ctx->Ctx;
+    ConfirmQueueNvmCtx = &ctx->NvmCtx;
 }
 
 bool LoRaMacConfirmQueueAdd( MlmeConfirmQueue_t* mlmeConfirm )
 {
-    if( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt >= LORA_MAC_MLME_CONFIRM_QUEUE_LEN )
+    if( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt >= LORA_MAC_MLME_CONFIRM_QUEUE_LEN )
     {
         // Protect the buffer against overwrites
         return false;
     }
 
     // Add the element to the ring buffer
-    ConfirmQueueCtx.BufferEnd->Request = mlmeConfirm->Request;
-    ConfirmQueueCtx.BufferEnd->Status = mlmeConfirm->Status;
-    ConfirmQueueCtx.BufferEnd->RestrictCommonReadyToHandle = mlmeConfirm->RestrictCommonReadyToHandle;
-    ConfirmQueueCtx.BufferEnd->ReadyToHandle = false;
+    ConfirmQueueCtx->BufferEnd->Request = mlmeConfirm->Request;
+    ConfirmQueueCtx->BufferEnd->Status = mlmeConfirm->Status;
+    ConfirmQueueCtx->BufferEnd->RestrictCommonReadyToHandle = mlmeConfirm->RestrictCommonReadyToHandle;
+    ConfirmQueueCtx->BufferEnd->ReadyToHandle = false;
     // Increase counter
-    ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt++;
+    ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt++;
     // Update end pointer
-    ConfirmQueueCtx.BufferEnd = IncreaseBufferPointer( ConfirmQueueCtx.BufferEnd );
+    ConfirmQueueCtx->BufferEnd = IncreaseBufferPointer( ConfirmQueueCtx->BufferEnd );
 
     return true;
 }
 
 bool LoRaMacConfirmQueueRemoveLast( void )
 {
-    if( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt == 0 )
+    if( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt == 0 )
     {
         return false;
     }
 
     // Increase counter
-    ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt--;
+    ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt--;
     // Update start pointer
-    ConfirmQueueCtx.BufferEnd = DecreaseBufferPointer( ConfirmQueueCtx.BufferEnd );
+    ConfirmQueueCtx->BufferEnd = DecreaseBufferPointer( ConfirmQueueCtx->BufferEnd );
 
     return true;
 }
 
 bool LoRaMacConfirmQueueRemoveFirst( void )
 {
-    if( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt == 0 )
+    if( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt == 0 )
     {
         return false;
     }
 
     // Increase counter
-    ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt--;
+    ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt--;
     // Update start pointer
-    ConfirmQueueCtx.BufferStart = IncreaseBufferPointer( ConfirmQueueCtx.BufferStart );
+    ConfirmQueueCtx->BufferStart = IncreaseBufferPointer( ConfirmQueueCtx->BufferStart );
 
     return true;
 }
@@ -229,9 +266,9 @@ void LoRaMacConfirmQueueSetStatus( LoRaMacEventInfoStatus_t status, Mlme_t reque
 {
     MlmeConfirmQueue_t* element = NULL;
 
-    if( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt > 0 )
+    if( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt > 0 )
     {
-        element = GetElement( request, ConfirmQueueCtx.BufferStart, ConfirmQueueCtx.BufferEnd );
+        element = GetElement( request, ConfirmQueueCtx->BufferStart, ConfirmQueueCtx->BufferEnd );
         if( element != NULL )
         {
             element->Status = status;
@@ -244,9 +281,9 @@ LoRaMacEventInfoStatus_t LoRaMacConfirmQueueGetStatus( Mlme_t request )
 {
     MlmeConfirmQueue_t* element = NULL;
 
-    if( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt > 0 )
+    if( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt > 0 )
     {
-        element = GetElement( request, ConfirmQueueCtx.BufferStart, ConfirmQueueCtx.BufferEnd );
+        element = GetElement( request, ConfirmQueueCtx->BufferStart, ConfirmQueueCtx->BufferEnd );
         if( element != NULL )
         {
             return element->Status;
@@ -257,11 +294,11 @@ LoRaMacEventInfoStatus_t LoRaMacConfirmQueueGetStatus( Mlme_t request )
 
 void LoRaMacConfirmQueueSetStatusCmn( LoRaMacEventInfoStatus_t status )
 {
-    MlmeConfirmQueue_t* element = ConfirmQueueCtx.BufferStart;
+    MlmeConfirmQueue_t* element = ConfirmQueueCtx->BufferStart;
 
-    ConfirmQueueCtx.ConfirmQueueNvmCtx->CommonStatus = status;
+    ConfirmQueueCtx->ConfirmQueueNvmCtx->CommonStatus = status;
 
-    if( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt > 0 )
+    if( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt > 0 )
     {
         do
         {
@@ -273,18 +310,18 @@ void LoRaMacConfirmQueueSetStatusCmn( LoRaMacEventInfoStatus_t status )
                 element->ReadyToHandle = true;
             }
             element = IncreaseBufferPointer( element );
-        }while( element != ConfirmQueueCtx.BufferEnd );
+        }while( element != ConfirmQueueCtx->BufferEnd );
     }
 }
 
 LoRaMacEventInfoStatus_t LoRaMacConfirmQueueGetStatusCmn( void )
 {
-    return ConfirmQueueCtx.ConfirmQueueNvmCtx->CommonStatus;
+    return ConfirmQueueCtx->ConfirmQueueNvmCtx->CommonStatus;
 }
 
 bool LoRaMacConfirmQueueIsCmdActive( Mlme_t request )
 {
-    if( GetElement( request, ConfirmQueueCtx.BufferStart, ConfirmQueueCtx.BufferEnd ) != NULL )
+    if( GetElement( request, ConfirmQueueCtx->BufferStart, ConfirmQueueCtx->BufferEnd ) != NULL )
     {
         return true;
     }
@@ -293,26 +330,26 @@ bool LoRaMacConfirmQueueIsCmdActive( Mlme_t request )
 
 void LoRaMacConfirmQueueHandleCb( MlmeConfirm_t* mlmeConfirm )
 {
-    uint8_t nbElements = ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt;
+    uint8_t nbElements = ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt;
     bool readyToHandle = false;
     MlmeConfirmQueue_t mlmeConfirmToStore;
 
     for( uint8_t i = 0; i < nbElements; i++ )
     {
-        mlmeConfirm->MlmeRequest = ConfirmQueueCtx.BufferStart->Request;
-        mlmeConfirm->Status = ConfirmQueueCtx.BufferStart->Status;
-        readyToHandle = ConfirmQueueCtx.BufferStart->ReadyToHandle;
+        mlmeConfirm->MlmeRequest = ConfirmQueueCtx->BufferStart->Request;
+        mlmeConfirm->Status = ConfirmQueueCtx->BufferStart->Status;
+        readyToHandle = ConfirmQueueCtx->BufferStart->ReadyToHandle;
 
         if( readyToHandle == true )
         {
-            ConfirmQueueCtx.Primitives->MacMlmeConfirm( mlmeConfirm );
+            ConfirmQueueCtx->Primitives->MacMlmeConfirm( mlmeConfirm );
         }
         else
         {
             // The request is not processed yet. Store the state.
-            mlmeConfirmToStore.Request = ConfirmQueueCtx.BufferStart->Request;
-            mlmeConfirmToStore.Status = ConfirmQueueCtx.BufferStart->Status;
-            mlmeConfirmToStore.RestrictCommonReadyToHandle = ConfirmQueueCtx.BufferStart->RestrictCommonReadyToHandle;
+            mlmeConfirmToStore.Request = ConfirmQueueCtx->BufferStart->Request;
+            mlmeConfirmToStore.Status = ConfirmQueueCtx->BufferStart->Status;
+            mlmeConfirmToStore.RestrictCommonReadyToHandle = ConfirmQueueCtx->BufferStart->RestrictCommonReadyToHandle;
         }
 
         // Increase the pointer afterwards to prevent overwrites
@@ -328,12 +365,12 @@ void LoRaMacConfirmQueueHandleCb( MlmeConfirm_t* mlmeConfirm )
 
 uint8_t LoRaMacConfirmQueueGetCnt( void )
 {
-    return ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt;
+    return ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt;
 }
 
 bool LoRaMacConfirmQueueIsFull( void )
 {
-    if( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt >= LORA_MAC_MLME_CONFIRM_QUEUE_LEN )
+    if( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt >= LORA_MAC_MLME_CONFIRM_QUEUE_LEN )
     {
         return true;
     }
@@ -112,6 +112,23 @@ bool LoRaMacConfirmQueueRestoreNvmCtx( void* confirmQueueNvmCtx );
  */
 void* LoRaMacConfirmQueueGetNvmCtx( size_t* confirmQueueNvmCtxSize );
 
+/*!
+ * Returns the size of the memory block holding the MLME confirm queue state of one
+ * LoRaMac instance.
+ *
+ * \retval                         - Size of the instance context in bytes
+ */
+size_t LoRaMacConfirmQueueGetInstanceCtxSize( void );
+
+/*!
+ * Selects the memory block the MLME confirm queue operates on. Called by
+ * LoRaMacInstanceSelect.
+ *
+ * \param[IN]     instanceCtx      - Zero initialized block of GetInstanceCtxSize bytes.
+ *                                   NULL selects the default instance.
+ */
+void LoRaMacConfirmQueueSetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief   Adds an element to the confirm queue.
  *
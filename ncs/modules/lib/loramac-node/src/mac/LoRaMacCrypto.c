@@ -225,15 +225,35 @@ typedef struct sKeyAddr
     KeyIdentifier_t RootKey;
 }KeyAddr_t;
 
+/*
+ * Crypto module state of one LoRaMac instance
+ */
+typedef struct sLoRaMacCryptoInstanceCtx
+{
+    /*
+     * Crypto module context
+     */
+    LoRaMacCryptoCtx_t Ctx;
+    /*
+     * Non volatile module context
+     */
+    LoRaMacCryptoNvmCtx_t NvmCtx;
+}LoRaMacCryptoInstanceCtx_t;
+
+/*
+ * Crypto module state of the default LoRaMac instance.
+ */
+static LoRaMacCryptoInstanceCtx_t DefaultInstanceCtx;
+
 /*
  *Crypto module context.
  */
-static LoRaMacCryptoCtx_t CryptoCtx;
+static LoRaMacCryptoCtx_t* CryptoCtx = &DefaultInstanceCtx.Ctx;
 
 /*
  * Non volatile module context.
  */
-static LoRaMacCryptoNvmCtx_t NvmCryptoCtx;
+static LoRaMacCryptoNvmCtx_t* NvmCryptoCtx = &DefaultInstanceCtx.NvmCtx;
 
 /*
  * Key-Address list
@@ -333,7 +353,7 @@ static LoRaMacCryptoStatus_t FOptsEncrypt( uint16_t size, uint32_t address, uint
 
     aBlock[0] = 0x01;
 
-    if( CryptoCtx.NvmCtx->LrWanVersion.Value > 0x01010000 )
+    if( CryptoCtx->NvmCtx->LrWanVersion.Value > 0x01010000 )
     {
         // Introduced in LoRaWAN 1.1.1 specification
         switch( fCntID )
@@ -370,7 +390,7 @@ static LoRaMacCryptoStatus_t FOptsEncrypt( uint16_t size, uint32_t address, uint
     aBlock[12] = ( frameCounter >> 16 ) & 0xFF;
     aBlock[13] = ( frameCounter >> 24 ) & 0xFF;
 
-    if( CryptoCtx.NvmCtx->LrWanVersion.Value > 0x01010000 )
+    if( CryptoCtx->NvmCtx->LrWanVersion.Value > 0x01010000 )
     {
         // Introduced in LoRaWAN 1.1.1 specification
         aBlock[15] = 0x01;
@@ -418,7 +438,7 @@ static LoRaMacCryptoStatus_t PrepareB0( uint16_t msgLen, KeyIdentifier_t keyID,
         // confFCnt contains the frame counter value modulo 2^16 of the "confirmed" uplink or downlink frame that is being acknowledged
         uint16_t confFCnt = 0;
 
-        confFCnt = ( uint16_t )( CryptoCtx.NvmCtx->FCntList.FCntUp % 65536 );
+        confFCnt = ( uint16_t )( CryptoCtx->NvmCtx->FCntList.FCntUp % 65536 );
 
         b0[1] = confFCnt & 0xFF;
         b0[2] = ( confFCnt >> 8 ) & 0xFF;
@@ -563,7 +583,7 @@ static LoRaMacCryptoStatus_t PrepareB1( uint16_t msgLen, KeyIdentifier_t keyID,
     if( isAck == true )
     {
         // confFCnt contains the frame counter value modulo 2^16 of the "confirmed" uplink frame that is being acknowledged
-        uint16_t confFCnt = ( uint16_t )( *CryptoCtx.NvmCtx->LastDownFCnt % 65536 );
+        uint16_t confFCnt = ( uint16_t )( *CryptoCtx->NvmCtx->LastDownFCnt % 65536 );
         b1[1] = confFCnt & 0xFF;
         b1[2] = ( confFCnt >> 8 ) & 0xFF;
     }
@@ -690,7 +710,7 @@ static LoRaMacCryptoStatus_t DeriveSessionKey10x( KeyIdentifier_t keyID, uint8_t
     memcpy1( compBase + 4, netID, 3 );
     memcpy1( compBase + 7, devNonce, 2 );
 
-    if( SecureElementDeriveAndStoreKey( CryptoCtx.NvmCtx->LrWanVersion, compBase, NWK_KEY, keyID ) != SECURE_ELEMENT_SUCCESS )
+    if( SecureElementDeriveAndStoreKey( CryptoCtx->NvmCtx->LrWanVersion, compBase, NWK_KEY, keyID ) != SECURE_ELEMENT_SUCCESS )
     {
         return LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC;
     }
@@ -741,7 +761,7 @@ static LoRaMacCryptoStatus_t DeriveSessionKey11x( KeyIdentifier_t keyID, uint8_t
     memcpyr( compBase + 4, joinEUI, 8 );
     memcpy1( compBase + 12, devNonce, 2 );
 
-    if( SecureElementDeriveAndStoreKey( CryptoCtx.NvmCtx->LrWanVersion, compBase, rootKeyId, keyID ) != SECURE_ELEMENT_SUCCESS )
+    if( SecureElementDeriveAndStoreKey( CryptoCtx->NvmCtx->LrWanVersion, compBase, rootKeyId, keyID ) != SECURE_ELEMENT_SUCCESS )
     {
         return LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC;
     }
@@ -779,7 +799,7 @@ static LoRaMacCryptoStatus_t DeriveLifeTimeSessionKey( KeyIdentifier_t keyID, ui
 
     memcpyr( compBase + 1, devEUI, 8 );
 
-    if( SecureElementDeriveAndStoreKey( CryptoCtx.NvmCtx->LrWanVersion, compBase, NWK_KEY, keyID ) != SECURE_ELEMENT_SUCCESS )
+    if( SecureElementDeriveAndStoreKey( CryptoCtx->NvmCtx->LrWanVersion, compBase, NWK_KEY, keyID ) != SECURE_ELEMENT_SUCCESS )
     {
         return LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC;
     }
@@ -805,28 +825,28 @@ static LoRaMacCryptoStatus_t GetLastFcntDown( FCntIdentifier_t fCntID, uint32_t*
     switch( fCntID )
     {
         case N_FCNT_DOWN:
-            *lastDown = CryptoCtx.NvmCtx->FCntList.NFCntDown;
-            CryptoCtx.NvmCtx->LastDownFCnt = &CryptoCtx.NvmCtx->FCntList.NFCntDown;
+            *lastDown = CryptoCtx->NvmCtx->FCntList.NFCntDown;
+            CryptoCtx->NvmCtx->LastDownFCnt = &CryptoCtx->NvmCtx->FCntList.NFCntDown;
             break;
         case A_FCNT_DOWN:
-            *lastDown = CryptoCtx.NvmCtx->FCntList.AFCntDown;
-            CryptoCtx.NvmCtx->LastDownFCnt = &CryptoCtx.NvmCtx->FCntList.AFCntDown;
+            *lastDown = CryptoCtx->NvmCtx->FCntList.AFCntDown;
+            CryptoCtx->NvmCtx->LastDownFCnt = &CryptoCtx->NvmCtx->FCntList.AFCntDown;
             break;
         case FCNT_DOWN:
-            *lastDown = CryptoCtx.NvmCtx->FCntList.FCntDown;
-            CryptoCtx.NvmCtx->LastDownFCnt = &CryptoCtx.NvmCtx->FCntList.FCntDown;
+            *lastDown = CryptoCtx->NvmCtx->FCntList.FCntDown;
+            CryptoCtx->NvmCtx->LastDownFCnt = &CryptoCtx->NvmCtx->FCntList.FCntDown;
             break;
         case MC_FCNT_DOWN_0:
-            *lastDown = CryptoCtx.NvmCtx->FCntList.McFCntDown0;
+            *lastDown = CryptoCtx->NvmCtx->FCntList.McFCntDown0;
             break;
         case MC_FCNT_DOWN_1:
-            *lastDown = CryptoCtx.NvmCtx->FCntList.McFCntDown1;
+            *lastDown = CryptoCtx->NvmCtx->FCntList.McFCntDown1;
             break;
         case MC_FCNT_DOWN_2:
-            *lastDown = CryptoCtx.NvmCtx->FCntList.McFCntDown2;
+            *lastDown = CryptoCtx->NvmCtx->FCntList.McFCntDown2;
             break;
         case MC_FCNT_DOWN_3:
-            *lastDown = CryptoCtx.NvmCtx->FCntList.McFCntDown3;
+            *lastDown = CryptoCtx->NvmCtx->FCntList.McFCntDown3;
             break;
         default:
             return LORAMAC_CRYPTO_FAIL_FCNT_ID;
@@ -874,30 +894,30 @@ static void UpdateFCntDown( FCntIdentifier_t fCntID, uint32_t currentDown )
     switch( fCntID )
     {
         case N_FCNT_DOWN:
-            CryptoCtx.NvmCtx->FCntList.NFCntDown = currentDown;
+            CryptoCtx->NvmCtx->FCntList.NFCntDown = currentDown;
             break;
         case A_FCNT_DOWN:
-            CryptoCtx.NvmCtx->FCntList.AFCntDown = currentDown;
+            CryptoCtx->NvmCtx->FCntList.AFCntDown = currentDown;
             break;
         case FCNT_DOWN:
-            CryptoCtx.NvmCtx->FCntList.FCntDown = currentDown;
+            CryptoCtx->NvmCtx->FCntList.FCntDown = currentDown;
             break;
         case MC_FCNT_DOWN_0:
-            CryptoCtx.NvmCtx->FCntList.McFCntDown0 = currentDown;
+            CryptoCtx->NvmCtx->FCntList.McFCntDown0 = currentDown;
             break;
         case MC_FCNT_DOWN_1:
-            CryptoCtx.NvmCtx->FCntList.McFCntDown1 = currentDown;
+            CryptoCtx->NvmCtx->FCntList.McFCntDown1 = currentDown;
             break;
         case MC_FCNT_DOWN_2:
-            CryptoCtx.NvmCtx->FCntList.McFCntDown2 = currentDown;
+            CryptoCtx->NvmCtx->FCntList.McFCntDown2 = currentDown;
             break;
         case MC_FCNT_DOWN_3:
-            CryptoCtx.NvmCtx->FCntList.McFCntDown3 = currentDown;
+            CryptoCtx->NvmCtx->FCntList.McFCntDown3 = currentDown;
             break;
         default:
             break;
     }
-    CryptoCtx.EventCryptoNvmCtxChanged( );
+    CryptoCtx->EventCryptoNvmCtxChanged( );
 }
 
 /*!
@@ -906,18 +926,18 @@ static void UpdateFCntDown( FCntIdentifier_t fCntID, uint32_t currentDown )
 static void ResetFCnts( void )
 {
 
-    CryptoCtx.NvmCtx->FCntList.FCntUp = 0;
-    CryptoCtx.NvmCtx->FCntList.NFCntDown = FCNT_DOWN_INITAL_VALUE;
-    CryptoCtx.NvmCtx->FCntList.AFCntDown = FCNT_DOWN_INITAL_VALUE;
-    CryptoCtx.NvmCtx->FCntList.FCntDown = FCNT_DOWN_INITAL_VALUE;
-    CryptoCtx.NvmCtx->LastDownFCnt = &CryptoCtx.NvmCtx->FCntList.FCntDown;
+    CryptoCtx->NvmCtx->FCntList.FCntUp = 0;
+    CryptoCtx->NvmCtx->FCntList.NFCntDown = FCNT_DOWN_INITAL_VALUE;
+    CryptoCtx->NvmCtx->FCntList.AFCntDown = FCNT_DOWN_INITAL_VALUE;
+    CryptoCtx->NvmCtx->FCntList.FCntDown = FCNT_DOWN_INITAL_VALUE;
+    CryptoCtx->NvmCtx->LastDownFCnt = &CryptoCtx->NvmCtx->FCntList.FCntDown;
 
-    CryptoCtx.NvmCtx->FCntList.McFCntDown0 = FCNT_DOWN_INITAL_VALUE;
-    CryptoCtx.NvmCtx->FCntList.McFCntDown1 = FCNT_DOWN_INITAL_VALUE;
-    CryptoCtx.NvmCtx->FCntList.McFCntDown2 = FCNT_DOWN_INITAL_VALUE;
-    CryptoCtx.NvmCtx->FCntList.McFCntDown3 = FCNT_DOWN_INITAL_VALUE;
+    CryptoCtx->NvmCtx->FCntList.McFCntDown0 = FCNT_DOWN_INITAL_VALUE;
+    CryptoCtx->NvmCtx->FCntList.McFCntDown1 = FCNT_DOWN_INITAL_VALUE;
+    CryptoCtx->NvmCtx->FCntList.McFCntDown2 = FCNT_DOWN_INITAL_VALUE;
+    CryptoCtx->NvmCtx->FCntList.McFCntDown3 = FCNT_DOWN_INITAL_VALUE;
 
-    CryptoCtx.EventCryptoNvmCtxChanged( );
+    CryptoCtx->EventCryptoNvmCtxChanged( );
 }
 
 /*
@@ -935,26 +955,26 @@ static void DummyCB( void )
 LoRaMacCryptoStatus_t LoRaMacCryptoInit( LoRaMacCryptoNvmEvent cryptoNvmCtxChanged )
 {
     // Assign non volatile context
-    CryptoCtx.NvmCtx = &NvmCryptoCtx;
+    CryptoCtx->NvmCtx = NvmCryptoCtx;
 
     // Assign callback
     if( cryptoNvmCtxChanged != 0 )
     {
-        CryptoCtx.EventCryptoNvmCtxChanged = cryptoNvmCtxChanged;
+        CryptoCtx->EventCryptoNvmCtxChanged = cryptoNvmCtxChanged;
     }
     else
     {
-        CryptoCtx.EventCryptoNvmCtxChanged = DummyCB;
+        CryptoCtx->EventCryptoNvmCtxChanged = DummyCB;
     }
 
     // Initialize with default
-    memset1( (uint8_t*) CryptoCtx.NvmCtx, 0, sizeof( LoRaMacCryptoNvmCtx_t ) );
+    memset1( (uint8_t*) CryptoCtx->NvmCtx, 0, sizeof( LoRaMacCryptoNvmCtx_t ) );
 
     // Set default LoRaWAN version
-    CryptoCtx.NvmCtx->LrWanVersion.Fields.Major = 1;
-    CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor = 1;
-    CryptoCtx.NvmCtx->LrWanVersion.Fields.Revision = 1;
-    CryptoCtx.NvmCtx->LrWanVersion.Fields.Rfu = 0;
+    CryptoCtx->NvmCtx->LrWanVersion.Fields.Major = 1;
+    CryptoCtx->NvmCtx->LrWanVersion.Fields.Minor = 1;
+    CryptoCtx->NvmCtx->LrWanVersion.Fields.Revision = 1;
+    CryptoCtx->NvmCtx->LrWanVersion.Fields.Rfu = 0;
 
     // Reset frame counters
     ResetFCnts( );
@@ -964,7 +984,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoInit( LoRaMacCryptoNvmEvent cryptoNvmCtxChang
 
 LoRaMacCryptoStatus_t LoRaMacCryptoSetLrWanVersion( Version_t version )
 {
-    CryptoCtx.NvmCtx->LrWanVersion = version;
+    CryptoCtx->NvmCtx->LrWanVersion = version;
     return LORAMAC_CRYPTO_SUCCESS;
 }
 
@@ -973,7 +993,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoRestoreNvmCtx( void* cryptoNvmCtx )
     // Restore module context
     if( cryptoNvmCtx != 0 )
     {
-        memcpy1( ( uint8_t* ) &NvmCryptoCtx, ( uint8_t* ) cryptoNvmCtx, CRYPTO_NVM_CTX_SIZE );
+        memcpy1( ( uint8_t* ) NvmCryptoCtx, ( uint8_t* ) cryptoNvmCtx, CRYPTO_NVM_CTX_SIZE );
         return LORAMAC_CRYPTO_SUCCESS;
     }
     else
@@ -985,7 +1005,24 @@ LoRaMacCryptoStatus_t LoRaMacCryptoRestoreNvmCtx( void* cryptoNvmCtx )
 void* LoRaMacCryptoGetNvmCtx( size_t* cryptoNvmCtxSize )
 {
     *cryptoNvmCtxSize = CRYPTO_NVM_CTX_SIZE;
-    return &NvmCryptoCtx;
+    return NvmCryptoCtx;
+}
+
+size_t LoRaMacCryptoGetInstanceCtxSize( void )
+{
+    return sizeof( LoRaMacCryptoInstanceCtx_t );
+}
+
+void LoRaMacCryptoSetInstanceCtx( void* instanceCtx )
+{
+    LoRaMacCryptoInstanceCtx_t* ctx = ( LoRaMacCryptoInstanceCtx_t* ) instanceCtx;
+
+    if( ctx == NULL )
+    {
+        ctx = &DefaultInstanceCtx;
+    }
+    CryptoCtx = &ctx->Ctx;
+    NvmCryptoCtx = &ctx->NvmCtx;
 }
 
 LoRaMacCryptoStatus_t LoRaMacCryptoGetFCntUp( uint32_t* currentUp )
@@ -995,7 +1032,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoGetFCntUp( uint32_t* currentUp )
         return LORAMAC_CRYPTO_ERROR_NPE;
     }
 
-    *currentUp = CryptoCtx.NvmCtx->FCntList.FCntUp + 1;
+    *currentUp = CryptoCtx->NvmCtx->FCntList.FCntUp + 1;
 
     return LORAMAC_CRYPTO_SUCCESS;
 }
@@ -1044,7 +1081,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoGetFCntDown( FCntIdentifier_t fCntID, uint16_
 
 
     // For LoRaWAN 1.0.X only, check maxFCntGap
-    if( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 0 )
+    if( CryptoCtx->NvmCtx->LrWanVersion.Fields.Minor == 0 )
     {
         if( ( ( int64_t )*currentDown - ( int64_t )lastDown ) >= maxFCntGap )
         {
@@ -1062,10 +1099,10 @@ LoRaMacCryptoStatus_t LoRaMacCryptoSetMulticastReference( MulticastCtx_t* multic
         return LORAMAC_CRYPTO_ERROR_NPE;
     }
 
-    multicastList[0].DownLinkCounter = &CryptoCtx.NvmCtx->FCntList.McFCntDown0;
-    multicastList[1].DownLinkCounter = &CryptoCtx.NvmCtx->FCntList.McFCntDown1;
-    multicastList[2].DownLinkCounter = &CryptoCtx.NvmCtx->FCntList.McFCntDown2;
-    multicastList[3].DownLinkCounter = &CryptoCtx.NvmCtx->FCntList.McFCntDown3;
+    multicastList[0].DownLinkCounter = &CryptoCtx->NvmCtx->FCntList.McFCntDown0;
+    multicastList[1].DownLinkCounter = &CryptoCtx->NvmCtx->FCntList.McFCntDown1;
+    multicastList[2].DownLinkCounter = &CryptoCtx->NvmCtx->FCntList.McFCntDown2;
+    multicastList[3].DownLinkCounter = &CryptoCtx->NvmCtx->FCntList.McFCntDown3;
 
     return LORAMAC_CRYPTO_SUCCESS;
 }
@@ -1103,12 +1140,12 @@ LoRaMacCryptoStatus_t LoRaMacCryptoPrepareJoinRequest( LoRaMacMessageJoinRequest
 #if ( USE_RANDOM_DEV_NONCE == 1 )
     uint32_t devNonce = 0;
     SecureElementRandomNumber( &devNonce );
-    CryptoCtx.NvmCtx->DevNonce = devNonce;
+    CryptoCtx->NvmCtx->DevNonce = devNonce;
 #else
-    CryptoCtx.NvmCtx->DevNonce++;
+    CryptoCtx->NvmCtx->DevNonce++;
 #endif
-    CryptoCtx.EventCryptoNvmCtxChanged( );
-    macMsg->DevNonce = CryptoCtx.NvmCtx->DevNonce;
+    CryptoCtx->EventCryptoNvmCtxChanged( );
+    macMsg->DevNonce = CryptoCtx->NvmCtx->DevNonce;
 
 #if( USE_LRWAN_1_1_X_CRYPTO == 1 )
     // Derive lifetime session keys
@@ -1151,7 +1188,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoPrepareReJoinType1( LoRaMacMessageReJoinType1
     }
 
     // Check for RJcount1 overflow
-    if( CryptoCtx.NvmCtx->RJcount1 == 65535 )
+    if( CryptoCtx->NvmCtx->RJcount1 == 65535 )
     {
         return LORAMAC_CRYPTO_ERROR_RJCOUNT1_OVERFLOW;
     }
@@ -1176,8 +1213,8 @@ LoRaMacCryptoStatus_t LoRaMacCryptoPrepareReJoinType1( LoRaMacMessageReJoinType1
     }
 
     // Increment RJcount1
-    CryptoCtx.NvmCtx->RJcount1++;
-    CryptoCtx.EventCryptoNvmCtxChanged( );
+    CryptoCtx->NvmCtx->RJcount1++;
+    CryptoCtx->EventCryptoNvmCtxChanged( );
 
     return LORAMAC_CRYPTO_SUCCESS;
 }
@@ -1190,7 +1227,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoPrepareReJoinType0or2( LoRaMacMessageReJoinTy
     }
 
     // Check for RJcount0 overflow
-    if( CryptoCtx.RJcount0 == 65535 )
+    if( CryptoCtx->RJcount0 == 65535 )
     {
         return LORAMAC_CRYPTO_FAIL_RJCOUNT0_OVERFLOW;
     }
@@ -1215,7 +1252,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoPrepareReJoinType0or2( LoRaMacMessageReJoinTy
     }
 
     // Increment RJcount0
-    CryptoCtx.RJcount0++;
+    CryptoCtx->RJcount0++;
 
     return LORAMAC_CRYPTO_SUCCESS;
 }
@@ -1232,7 +1269,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoHandleJoinAccept( JoinReqIdentifier_t joinReq
     KeyIdentifier_t encryptionKeyID;
     uint8_t micComputationOffset = 0;
 #if( USE_LRWAN_1_1_X_CRYPTO == 1 )
-    uint8_t* devNonceForKeyDerivation = ( uint8_t* ) &CryptoCtx.NvmCtx->DevNonce;
+    uint8_t* devNonceForKeyDerivation = ( uint8_t* ) &CryptoCtx->NvmCtx->DevNonce;
 #endif
 
     // Determine decryption key and DevNonce for key derivation
@@ -1249,11 +1286,11 @@ LoRaMacCryptoStatus_t LoRaMacCryptoHandleJoinAccept( JoinReqIdentifier_t joinReq
         // If Join-accept is a reply to a rejoin, the RJcount(0 or 1) replaces DevNonce in the key derivation process.
         if( ( joinReqType == REJOIN_REQ_0 ) || ( joinReqType == REJOIN_REQ_2 ) )
         {
-            devNonceForKeyDerivation = ( uint8_t* ) &CryptoCtx.RJcount0;
+            devNonceForKeyDerivation = ( uint8_t* ) &CryptoCtx->RJcount0;
         }
         else
         {
-            devNonceForKeyDerivation = ( uint8_t* ) &CryptoCtx.NvmCtx->RJcount1;
+            devNonceForKeyDerivation = ( uint8_t* ) &CryptoCtx->NvmCtx->RJcount1;
         }
     }
 #endif
@@ -1277,17 +1314,17 @@ LoRaMacCryptoStatus_t LoRaMacCryptoHandleJoinAccept( JoinReqIdentifier_t joinReq
     // Is it a LoRaWAN 1.1.0 or later ?
     if( macMsg->DLSettings.Bits.OptNeg == 1 )
     {
-        CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor = 1;
+        CryptoCtx->NvmCtx->LrWanVersion.Fields.Minor = 1;
         micComputationKeyID = J_S_INT_KEY;
     }
     else
     {
-        CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor = 0;
+        CryptoCtx->NvmCtx->LrWanVersion.Fields.Minor = 0;
         micComputationKeyID = NWK_KEY;
     }
 
     // Verify mic
-    if( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 0 )
+    if( CryptoCtx->NvmCtx->LrWanVersion.Fields.Minor == 0 )
     {
         // For legacy mode :
         //   cmac = aes128_cmac(NwkKey, MHDR |  JoinNonce | NetID | DevAddr | DLSettings | RxDelay | CFList | CFListType)
@@ -1308,8 +1345,8 @@ LoRaMacCryptoStatus_t LoRaMacCryptoHandleJoinAccept( JoinReqIdentifier_t joinReq
         memcpyr( &procBuffer[bufItr], joinEUI, LORAMAC_JOIN_EUI_FIELD_SIZE );
         bufItr += LORAMAC_JOIN_EUI_FIELD_SIZE;
 
-        procBuffer[bufItr++] = CryptoCtx.NvmCtx->DevNonce & 0xFF;
-        procBuffer[bufItr++] = ( CryptoCtx.NvmCtx->DevNonce >> 8 ) & 0xFF;
+        procBuffer[bufItr++] = CryptoCtx->NvmCtx->DevNonce & 0xFF;
+        procBuffer[bufItr++] = ( CryptoCtx->NvmCtx->DevNonce >> 8 ) & 0xFF;
 
         procBuffer[bufItr++] = macMsg->MHDR.Value;
 
@@ -1324,10 +1361,10 @@ LoRaMacCryptoStatus_t LoRaMacCryptoHandleJoinAccept( JoinReqIdentifier_t joinReq
         currentJoinNonce |= ( ( uint32_t ) macMsg->JoinNonce[1] << 8 );
         currentJoinNonce |= ( ( uint32_t ) macMsg->JoinNonce[2] << 16 );
 
-        if( currentJoinNonce > CryptoCtx.NvmCtx->JoinNonce )
+        if( currentJoinNonce > CryptoCtx->NvmCtx->JoinNonce )
         {
-            CryptoCtx.NvmCtx->JoinNonce = currentJoinNonce;
-            CryptoCtx.EventCryptoNvmCtxChanged( );
+            CryptoCtx->NvmCtx->JoinNonce = currentJoinNonce;
+            CryptoCtx->EventCryptoNvmCtxChanged( );
         }
         else
         {
@@ -1337,7 +1374,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoHandleJoinAccept( JoinReqIdentifier_t joinReq
 
     // Derive session keys
 #if( USE_LRWAN_1_1_X_CRYPTO == 1 )
-    if( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 1 )
+    if( CryptoCtx->NvmCtx->LrWanVersion.Fields.Minor == 1 )
     {
         // Derive lifetime keys
         retval = LoRaMacCryptoDeriveMcRootKey( APP_KEY );
@@ -1392,25 +1429,25 @@ LoRaMacCryptoStatus_t LoRaMacCryptoHandleJoinAccept( JoinReqIdentifier_t joinReq
             return retval;
         }
 
-        retval = DeriveSessionKey10x( APP_S_KEY, macMsg->JoinNonce, macMsg->NetID, ( uint8_t* ) &CryptoCtx.NvmCtx->DevNonce );
+        retval = DeriveSessionKey10x( APP_S_KEY, macMsg->JoinNonce, macMsg->NetID, ( uint8_t* ) &CryptoCtx->NvmCtx->DevNonce );
         if( retval != LORAMAC_CRYPTO_SUCCESS )
         {
             return retval;
         }
 
-        retval = DeriveSessionKey10x( NWK_S_ENC_KEY, macMsg->JoinNonce, macMsg->NetID, ( uint8_t* ) &CryptoCtx.NvmCtx->DevNonce );
+        retval = DeriveSessionKey10x( NWK_S_ENC_KEY, macMsg->JoinNonce, macMsg->NetID, ( uint8_t* ) &CryptoCtx->NvmCtx->DevNonce );
         if( retval != LORAMAC_CRYPTO_SUCCESS )
         {
             return retval;
         }
 
-        retval = DeriveSessionKey10x( F_NWK_S_INT_KEY, macMsg->JoinNonce, macMsg->NetID, ( uint8_t* ) &CryptoCtx.NvmCtx->DevNonce );
+        retval = DeriveSessionKey10x( F_NWK_S_INT_KEY, macMsg->JoinNonce, macMsg->NetID, ( uint8_t* ) &CryptoCtx->NvmCtx->DevNonce );
         if( retval != LORAMAC_CRYPTO_SUCCESS )
         {
             return retval;
         }
 
-        retval = DeriveSessionKey10x( S_NWK_S_INT_KEY, macMsg->JoinNonce, macMsg->NetID, ( uint8_t* ) &CryptoCtx.NvmCtx->DevNonce );
+        retval = DeriveSessionKey10x( S_NWK_S_INT_KEY, macMsg->JoinNonce, macMsg->NetID, ( uint8_t* ) &CryptoCtx->NvmCtx->DevNonce );
         if( retval != LORAMAC_CRYPTO_SUCCESS )
         {
             return retval;
@@ -1418,12 +1455,12 @@ LoRaMacCryptoStatus_t LoRaMacCryptoHandleJoinAccept( JoinReqIdentifier_t joinReq
     }
 
     // Join-Accept is successfully processed, reset frame counters
-    CryptoCtx.RJcount0 = 0;
-    CryptoCtx.NvmCtx->FCntList.FCntUp = 0;
-    CryptoCtx.NvmCtx->FCntList.FCntDown = FCNT_DOWN_INITAL_VALUE;
-    CryptoCtx.NvmCtx->FCntList.NFCntDown = FCNT_DOWN_INITAL_VALUE;
-    CryptoCtx.NvmCtx->FCntList.AFCntDown = FCNT_DOWN_INITAL_VALUE;
-    CryptoCtx.EventCryptoNvmCtxChanged( );
+    CryptoCtx->RJcount0 = 0;
+    CryptoCtx->NvmCtx->FCntList.FCntUp = 0;
+    CryptoCtx->NvmCtx->FCntList.FCntDown = FCNT_DOWN_INITAL_VALUE;
+    CryptoCtx->NvmCtx->FCntList.NFCntDown = FCNT_DOWN_INITAL_VALUE;
+    CryptoCtx->NvmCtx->FCntList.AFCntDown = FCNT_DOWN_INITAL_VALUE;
+    CryptoCtx->EventCryptoNvmCtxChanged( );
 
     return LORAMAC_CRYPTO_SUCCESS;
 }
@@ -1438,7 +1475,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoSecureMessage( uint32_t fCntUp, uint8_t txDr,
         return LORAMAC_CRYPTO_ERROR_NPE;
     }
 
-    if( fCntUp < CryptoCtx.NvmCtx->FCntList.FCntUp )
+    if( fCntUp < CryptoCtx->NvmCtx->FCntList.FCntUp )
     {
         return LORAMAC_CRYPTO_FAIL_FCNT_SMALLER;
     }
@@ -1450,7 +1487,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoSecureMessage( uint32_t fCntUp, uint8_t txDr,
         payloadDecryptionKeyID = NWK_S_ENC_KEY;
     }
 
-    if( fCntUp > CryptoCtx.NvmCtx->FCntList.FCntUp )
+    if( fCntUp > CryptoCtx->NvmCtx->FCntList.FCntUp )
     {
         retval = PayloadEncrypt( macMsg->FRMPayload, macMsg->FRMPayloadSize, payloadDecryptionKeyID, macMsg->FHDR.DevAddr, UPLINK, fCntUp );
         if( retval != LORAMAC_CRYPTO_SUCCESS )
@@ -1459,7 +1496,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoSecureMessage( uint32_t fCntUp, uint8_t txDr,
         }
 
 #if( USE_LRWAN_1_1_X_CRYPTO == 1 )
-        if( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 1 )
+        if( CryptoCtx->NvmCtx->LrWanVersion.Fields.Minor == 1 )
         {
             // Encrypt FOpts
             retval = FOptsEncrypt( macMsg->FHDR.FCtrl.Bits.FOptsLen, macMsg->FHDR.DevAddr, UPLINK, FCNT_UP, fCntUp, macMsg->FHDR.FOpts );
@@ -1470,8 +1507,8 @@ LoRaMacCryptoStatus_t LoRaMacCryptoSecureMessage( uint32_t fCntUp, uint8_t txDr,
         }
 #endif
     }
-    CryptoCtx.NvmCtx->FCntList.FCntUp = fCntUp;
-    CryptoCtx.EventCryptoNvmCtxChanged( );
+    CryptoCtx->NvmCtx->FCntList.FCntUp = fCntUp;
+    CryptoCtx->EventCryptoNvmCtxChanged( );
 
     // Serialize message
     if( LoRaMacSerializerData( macMsg ) != LORAMAC_SERIALIZER_SUCCESS )
@@ -1481,7 +1518,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoSecureMessage( uint32_t fCntUp, uint8_t txDr,
 
     // Compute mic
 #if( USE_LRWAN_1_1_X_CRYPTO == 1 )
-    if( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 1 )
+    if( CryptoCtx->NvmCtx->LrWanVersion.Fields.Minor == 1 )
     {
         uint32_t cmacS = 0;
         uint32_t cmacF = 0;
@@ -1563,7 +1600,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoUnsecureMessage( AddressIdentifier_t addrID,
 
     // Compute mic
     bool isAck = macMsg->FHDR.FCtrl.Bits.Ack;
-    if( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 0 )
+    if( CryptoCtx->NvmCtx->LrWanVersion.Fields.Minor == 0 )
     {
         // In legacy mode the IsAck parameter is forced to be false since the ConfFCnt field is not used.
         isAck = false;
@@ -1589,7 +1626,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoUnsecureMessage( AddressIdentifier_t addrID,
     }
 
 #if( USE_LRWAN_1_1_X_CRYPTO == 1 )
-    if( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 1 )
+    if( CryptoCtx->NvmCtx->LrWanVersion.Fields.Minor == 1 )
     {
         // Decrypt FOpts
         retval = FOptsEncrypt( macMsg->FHDR.FCtrl.Bits.FOptsLen, address, DOWNLINK, fCntID, fCntDown, macMsg->FHDR.FOpts );
@@ -1608,18 +1645,18 @@ LoRaMacCryptoStatus_t LoRaMacCryptoUnsecureMessage( AddressIdentifier_t addrID,
 LoRaMacCryptoStatus_t LoRaMacCryptoDeriveMcRootKey( KeyIdentifier_t keyID )
 {
     // Prevent other keys than GenAppKey for LoRaWAN 1.0.x or AppKey for LoRaWAN 1.1 or later
-    if( ( ( keyID == APP_KEY ) && ( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 0 ) ) ||
-        ( ( keyID == GEN_APP_KEY ) && ( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 1 ) ) )
+    if( ( ( keyID == APP_KEY ) && ( CryptoCtx->NvmCtx->LrWanVersion.Fields.Minor == 0 ) ) ||
+        ( ( keyID == GEN_APP_KEY ) && ( CryptoCtx->NvmCtx->LrWanVersion.Fields.Minor == 1 ) ) )
     {
         return LORAMAC_CRYPTO_ERROR_INVALID_KEY_ID;
     }
     uint8_t compBase[16] = { 0 };
 
-    if( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 1 )
+    if( CryptoCtx->NvmCtx->LrWanVersion.Fields.Minor == 1 )
     {
         compBase[0] = 0x20;
     }
-    if( SecureElementDeriveAndStoreKey( CryptoCtx.NvmCtx->LrWanVersion, compBase, keyID, MC_ROOT_KEY ) != SECURE_ELEMENT_SUCCESS )
+    if( SecureElementDeriveAndStoreKey( CryptoCtx->NvmCtx->LrWanVersion, compBase, keyID, MC_ROOT_KEY ) != SECURE_ELEMENT_SUCCESS )
     {
         return LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC;
     }
@@ -1636,7 +1673,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoDeriveMcKEKey( KeyIdentifier_t keyID )
     }
     uint8_t compBase[16] = { 0 };
 
-    if( SecureElementDeriveAndStoreKey( CryptoCtx.NvmCtx->LrWanVersion, compBase, keyID, MC_KE_KEY ) != SECURE_ELEMENT_SUCCESS )
+    if( SecureElementDeriveAndStoreKey( CryptoCtx->NvmCtx->LrWanVersion, compBase, keyID, MC_KE_KEY ) != SECURE_ELEMENT_SUCCESS )
     {
         return LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC;
     }
@@ -1679,12 +1716,12 @@ LoRaMacCryptoStatus_t LoRaMacCryptoDeriveMcSessionKeyPair( AddressIdentifier_t a
     compBaseNwkS[3] = ( mcAddr >> 16 ) & 0xFF;
     compBaseNwkS[4] = ( mcAddr >> 24 ) & 0xFF;
 
-    if( SecureElementDeriveAndStoreKey( CryptoCtx.NvmCtx->LrWanVersion, compBaseAppS, curItem->RootKey, curItem->AppSkey ) != SECURE_ELEMENT_SUCCESS )
+    if( SecureElementDeriveAndStoreKey( CryptoCtx->NvmCtx->LrWanVersion, compBaseAppS, curItem->RootKey, curItem->AppSkey ) != SECURE_ELEMENT_SUCCESS )
     {
         return LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC;
     }
 
-    if( SecureElementDeriveAndStoreKey( CryptoCtx.NvmCtx->LrWanVersion, compBaseNwkS, curItem->RootKey, curItem->NwkSkey ) != SECURE_ELEMENT_SUCCESS )
+    if( SecureElementDeriveAndStoreKey( CryptoCtx->NvmCtx->LrWanVersion, compBaseNwkS, curItem->RootKey, curItem->NwkSkey ) != SECURE_ELEMENT_SUCCESS )
     {
         return LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC;
     }
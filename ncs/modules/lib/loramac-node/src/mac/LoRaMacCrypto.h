@@ -186,6 +186,23 @@ LoRaMacCryptoStatus_t LoRaMacCryptoRestoreNvmCtx( void* cryptoNvmCtx );
  */
 void* LoRaMacCryptoGetNvmCtx( size_t* cryptoNvmCtxSize );
 
+/*!
+ * Returns the size of the memory block holding the crypto module state of one
+ * LoRaMac instance.
+ *
+ * \retval                         - Size of the instance context in bytes
+ */
+size_t LoRaMacCryptoGetInstanceCtxSize( void );
+
+/*!
+ * Selects the memory block the crypto module operates on. Called by
+ * LoRaMacInstanceSelect.
+ *
+ * \param[IN]     instanceCtx      - Zero initialized block of GetInstanceCtxSize bytes.
+ *                                   NULL selects the default instance.
+ */
+void LoRaMacCryptoSetInstanceCtx( void* instanceCtx );
+
 /*!
  * Returns updated fCntID downlink counter value.
  *
@@ -58,6 +58,8 @@
 #define AS923_SET_CONTINUOUS_WAVE( )               AS923_CASE { RegionAS923SetContinuousWave( continuousWave ); break; }
 #define AS923_APPLY_DR_OFFSET( )                   AS923_CASE { return RegionAS923ApplyDrOffset( downlinkDwellTime, dr, drOffset ); }
 #define AS923_RX_BEACON_SETUP( )                   AS923_CASE { RegionAS923RxBeaconSetup( rxBeaconSetup, outDr ); break; }
+#define AS923_GET_INSTANCE_CTX_SIZE( )             size = MAX( size, RegionAS923GetInstanceCtxSize( ) );
+#define AS923_SET_INSTANCE_CTX( )                  RegionAS923SetInstanceCtx( instanceCtx );
 #else
 #define AS923_IS_ACTIVE( )
 #define AS923_GET_PHY_PARAM( )
@@ -83,6 +85,8 @@
 #define AS923_SET_CONTINUOUS_WAVE( )
 #define AS923_APPLY_DR_OFFSET( )
 #define AS923_RX_BEACON_SETUP( )
+#define AS923_GET_INSTANCE_CTX_SIZE( )
+#define AS923_SET_INSTANCE_CTX( )
 #endif
 
 #ifdef REGION_AU915
@@ -112,6 +116,8 @@
 #define AU915_SET_CONTINUOUS_WAVE( )               AU915_CASE { RegionAU915SetContinuousWave( continuousWave ); break; }
 #define AU915_APPLY_DR_OFFSET( )                   AU915_CASE { return RegionAU915ApplyDrOffset( downlinkDwellTime, dr, drOffset ); }
 #define AU915_RX_BEACON_SETUP( )                   AU915_CASE { RegionAU915RxBeaconSetup( rxBeaconSetup, outDr ); break; }
+#define AU915_GET_INSTANCE_CTX_SIZE( )             size = MAX( size, RegionAU915GetInstanceCtxSize( ) );
+#define AU915_SET_INSTANCE_CTX( )                  RegionAU915SetInstanceCtx( instanceCtx );
 #else
 #define AU915_IS_ACTIVE( )
 #define AU915_GET_PHY_PARAM( )
@@ -137,6 +143,8 @@
 #define AU915_SET_CONTINUOUS_WAVE( )
 #define AU915_APPLY_DR_OFFSET( )
 #define AU915_RX_BEACON_SETUP( )
+#define AU915_GET_INSTANCE_CTX_SIZE( )
+#define AU915_SET_INSTANCE_CTX( )
 #endif
 
 #ifdef REGION_CN470
@@ -166,6 +174,8 @@
 #define CN470_SET_CONTINUOUS_WAVE( )               CN470_CASE { RegionCN470SetContinuousWave( continuousWave ); break; }
 #define CN470_APPLY_DR_OFFSET( )                   CN470_CASE { return RegionCN470ApplyDrOffset( downlinkDwellTime, dr, drOffset ); }
 #define CN470_RX_BEACON_SETUP( )                   CN470_CASE { RegionCN470RxBeaconSetup( rxBeaconSetup, outDr ); break; }
+#define CN470_GET_INSTANCE_CTX_SIZE( )             size = MAX( size, RegionCN470GetInstanceCtxSize( ) );
+#define CN470_SET_INSTANCE_CTX( )                  RegionCN470SetInstanceCtx( instanceCtx );
 #else
 #define CN470_IS_ACTIVE( )
 #define CN470_GET_PHY_PARAM( )
@@ -191,6 +201,8 @@
 #define CN470_SET_CONTINUOUS_WAVE( )
 #define CN470_APPLY_DR_OFFSET( )
 #define CN470_RX_BEACON_SETUP( )
+#define CN470_GET_INSTANCE_CTX_SIZE( )
+#define CN470_SET_INSTANCE_CTX( )
 #endif
 
 #ifdef REGION_CN779
@@ -220,6 +232,8 @@
 #define CN779_SET_CONTINUOUS_WAVE( )               CN779_CASE { RegionCN779SetContinuousWave( continuousWave ); break; }
 #define CN779_APPLY_DR_OFFSET( )                   CN779_CASE { return RegionCN779ApplyDrOffset( downlinkDwellTime, dr, drOffset ); }
 #define CN779_RX_BEACON_SETUP( )                   CN779_CASE { RegionCN779RxBeaconSetup( rxBeaconSetup, outDr ); break; }
+#define CN779_GET_INSTANCE_CTX_SIZE( )             size = MAX( size, RegionCN779GetInstanceCtxSize( ) );
+#define CN779_SET_INSTANCE_CTX( )                  RegionCN779SetInstanceCtx( instanceCtx );
 #else
 #define CN779_IS_ACTIVE( )
 #define CN779_GET_PHY_PARAM( )
@@ -245,6 +259,8 @@
 #define CN779_SET_CONTINUOUS_WAVE( )
 #define CN779_APPLY_DR_OFFSET( )
 #define CN779_RX_BEACON_SETUP( )
+#define CN779_GET_INSTANCE_CTX_SIZE( )
+#define CN779_SET_INSTANCE_CTX( )
 #endif
 
 #ifdef REGION_EU433
@@ -274,6 +290,8 @@
 #define EU433_SET_CONTINUOUS_WAVE( )               EU433_CASE { RegionEU433SetContinuousWave( continuousWave ); break; }
 #define EU433_APPLY_DR_OFFSET( )                   EU433_CASE { return RegionEU433ApplyDrOffset( downlinkDwellTime, dr, drOffset ); }
 #define EU433_RX_BEACON_SETUP( )                   EU433_CASE { RegionEU433RxBeaconSetup( rxBeaconSetup, outDr ); break; }
+#define EU433_GET_INSTANCE_CTX_SIZE( )             size = MAX( size, RegionEU433GetInstanceCtxSize( ) );
+#define EU433_SET_INSTANCE_CTX( )                  RegionEU433SetInstanceCtx( instanceCtx );
 #else
 #define EU433_IS_ACTIVE( )
 #define EU433_GET_PHY_PARAM( )
@@ -299,6 +317,8 @@
 #define EU433_SET_CONTINUOUS_WAVE( )
 #define EU433_APPLY_DR_OFFSET( )
 #define EU433_RX_BEACON_SETUP( )
+#define EU433_GET_INSTANCE_CTX_SIZE( )
+#define EU433_SET_INSTANCE_CTX( )
 #endif
 
 #ifdef REGION_EU868
@@ -328,6 +348,8 @@
 #define EU868_SET_CONTINUOUS_WAVE( )               EU868_CASE { RegionEU868SetContinuousWave( continuousWave ); break; }
 #define EU868_APPLY_DR_OFFSET( )                   EU868_CASE { return RegionEU868ApplyDrOffset( downlinkDwellTime, dr, drOffset ); }
 #define EU868_RX_BEACON_SETUP( )                   EU868_CASE { RegionEU868RxBeaconSetup( rxBeaconSetup, outDr ); break; }
+#define EU868_GET_INSTANCE_CTX_SIZE( )             size = MAX( size, RegionEU868GetInstanceCtxSize( ) );
+#define EU868_SET_INSTANCE_CTX( )                  RegionEU868SetInstanceCtx( instanceCtx );
 #else
 #define EU868_IS_ACTIVE( )
 #define EU868_GET_PHY_PARAM( )
@@ -353,6 +375,8 @@
 #define EU868_SET_CONTINUOUS_WAVE( )
 #define EU868_APPLY_DR_OFFSET( )
 #define EU868_RX_BEACON_SETUP( )
+#define EU868_GET_INSTANCE_CTX_SIZE( )
+#define EU868_SET_INSTANCE_CTX( )
 #endif
 
 #ifdef REGION_KR920
@@ -382,6 +406,8 @@
 #define KR920_SET_CONTINUOUS_WAVE( )               KR920_CASE { RegionKR920SetContinuousWave( continuousWave ); break; }
 #define KR920_APPLY_DR_OFFSET( )                   KR920_CASE { return RegionKR920ApplyDrOffset( downlinkDwellTime, dr, drOffset ); }
 #define KR920_RX_BEACON_SETUP( )                   KR920_CASE { RegionKR920RxBeaconSetup( rxBeaconSetup, outDr ); break; }
+#define KR920_GET_INSTANCE_CTX_SIZE( )             size = MAX( size, RegionKR920GetInstanceCtxSize( ) );
+#define KR920_SET_INSTANCE_CTX( )                  RegionKR920SetInstanceCtx( instanceCtx );
 #else
 #define KR920_IS_ACTIVE( )
 #define KR920_GET_PHY_PARAM( )
@@ -407,6 +433,8 @@
 #define KR920_SET_CONTINUOUS_WAVE( )
 #define KR920_APPLY_DR_OFFSET( )
 #define KR920_RX_BEACON_SETUP( )
+#define KR920_GET_INSTANCE_CTX_SIZE( )
+#define KR920_SET_INSTANCE_CTX( )
 #endif
 
 #ifdef REGION_IN865
@@ -436,6 +464,8 @@
 #define IN865_SET_CONTINUOUS_WAVE( )               IN865_CASE { RegionIN865SetContinuousWave( continuousWave ); break; }
 #define IN865_APPLY_DR_OFFSET( )                   IN865_CASE { return RegionIN865ApplyDrOffset( downlinkDwellTime, dr, drOffset ); }
 #define IN865_RX_BEACON_SETUP( )                   IN865_CASE { RegionIN865RxBeaconSetup( rxBeaconSetup, outDr ); break; }
+#define IN865_GET_INSTANCE_CTX_SIZE( )             size = MAX( size, RegionIN865GetInstanceCtxSize( ) );
+#define IN865_SET_INSTANCE_CTX( )                  RegionIN865SetInstanceCtx( instanceCtx );
 #else
 #define IN865_IS_ACTIVE( )
 #define IN865_GET_PHY_PARAM( )
@@ -461,6 +491,8 @@
 #define IN865_SET_CONTINUOUS_WAVE( )
 #define IN865_APPLY_DR_OFFSET( )
 #define IN865_RX_BEACON_SETUP( )
+#define IN865_GET_INSTANCE_CTX_SIZE( )
+#define IN865_SET_INSTANCE_CTX( )
 #endif
 
 #ifdef REGION_US915
@@ -490,6 +522,8 @@
 #define US915_SET_CONTINUOUS_WAVE( )               US915_CASE { RegionUS915SetContinuousWave( continuousWave ); break; }
 #define US915_APPLY_DR_OFFSET( )                   US915_CASE { return RegionUS915ApplyDrOffset( downlinkDwellTime, dr, drOffset ); }
 #define US915_RX_BEACON_SETUP( )                   US915_CASE { RegionUS915RxBeaconSetup( rxBeaconSetup, outDr ); break; }
+#define US915_GET_INSTANCE_CTX_SIZE( )             size = MAX( size, RegionUS915GetInstanceCtxSize( ) );
+#define US915_SET_INSTANCE_CTX( )                  RegionUS915SetInstanceCtx( instanceCtx );
 #else
 #define US915_IS_ACTIVE( )
 #define US915_GET_PHY_PARAM( )
@@ -515,6 +549,8 @@
 #define US915_SET_CONTINUOUS_WAVE( )
 #define US915_APPLY_DR_OFFSET( )
 #define US915_RX_BEACON_SETUP( )
+#define US915_GET_INSTANCE_CTX_SIZE( )
+#define US915_SET_INSTANCE_CTX( )
 #endif
 
 #ifdef REGION_RU864
@@ -544,6 +580,8 @@
 #define RU864_SET_CONTINUOUS_WAVE( )               RU864_CASE { RegionRU864SetContinuousWave( continuousWave ); break; }
 #define RU864_APPLY_DR_OFFSET( )                   RU864_CASE { return RegionRU864ApplyDrOffset( downlinkDwellTime, dr, drOffset ); }
 #define RU864_RX_BEACON_SETUP( )                   RU864_CASE { RegionRU864RxBeaconSetup( rxBeaconSetup, outDr ); break; }
+#define RU864_GET_INSTANCE_CTX_SIZE( )             size = MAX( size, RegionRU864GetInstanceCtxSize( ) );
+#define RU864_SET_INSTANCE_CTX( )                  RegionRU864SetInstanceCtx( instanceCtx );
 #else
 #define RU864_IS_ACTIVE( )
 #define RU864_GET_PHY_PARAM( )
@@ -569,6 +607,8 @@
 #define RU864_SET_CONTINUOUS_WAVE( )
 #define RU864_APPLY_DR_OFFSET( )
 #define RU864_RX_BEACON_SETUP( )
+#define RU864_GET_INSTANCE_CTX_SIZE( )
+#define RU864_SET_INSTANCE_CTX( )
 #endif
 
 bool RegionIsActive( LoRaMacRegion_t region )
@@ -677,6 +717,38 @@ void* RegionGetNvmCtx( LoRaMacRegion_t region, GetNvmCtxParams_t* params )
     }
 }
 
+size_t RegionGetInstanceCtxSize( void )
+{
+    size_t size = 0;
+
+    AS923_GET_INSTANCE_CTX_SIZE( );
+    AU915_GET_INSTANCE_CTX_SIZE( );
+    CN470_GET_INSTANCE_CTX_SIZE( );
+    CN779_GET_INSTANCE_CTX_SIZE( );
+    EU433_GET_INSTANCE_CTX_SIZE( );
+    EU868_GET_INSTANCE_CTX_SIZE( );
+    KR920_GET_INSTANCE_CTX_SIZE( );
+    IN865_GET_INSTANCE_CTX_SIZE( );
+    US915_GET_INSTANCE_CTX_SIZE( );
+    RU864_GET_INSTANCE_CTX_SIZE( );
+
+    return size;
+}
+
+void RegionSetInstanceCtx( void* instanceCtx )
+{
+    AS923_SET_INSTANCE_CTX( );
+    AU915_SET_INSTANCE_CTX( );
+    CN470_SET_INSTANCE_CTX( );
+    CN779_SET_INSTANCE_CTX( );
+    EU433_SET_INSTANCE_CTX( );
+    EU868_SET_INSTANCE_CTX( );
+    KR920_SET_INSTANCE_CTX( );
+    IN865_SET_INSTANCE_CTX( );
+    US915_SET_INSTANCE_CTX( );
+    RU864_SET_INSTANCE_CTX( );
+}
+
 bool RegionVerify( LoRaMacRegion_t region, VerifyParams_t* verify, PhyAttribute_t phyAttribute )
 {
     switch( region )
@@ -1415,6 +1415,24 @@ void RegionInitDefaults( LoRaMacRegion_t region, InitDefaultsParams_t* params );
  */
 void* RegionGetNvmCtx( LoRaMacRegion_t region, GetNvmCtxParams_t* params );
 
+/*!
+ * \brief Returns the size of the region context of one LoRaMac instance.
+ *        All regions compiled in share the same block, as an instance
+ *        only ever runs one region at a time.
+ *
+ * \retval     Size of the instance context in bytes.
+ */
+size_t RegionGetInstanceCtxSize( void );
+
+/*!
+ * \brief Selects the region context all compiled in regions operate on.
+ *        Called by LoRaMacInstanceSelect.
+ *
+ * \param [IN] instanceCtx Zero initialized block of RegionGetInstanceCtxSize
+ *                         bytes. NULL selects the default instance.
+ */
+void RegionSetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief Verifies a parameter.
  *
@@ -357,6 +357,21 @@ void RegionAS923InitDefaults( InitDefaultsParams_t* params );
  */
 void* RegionAS923GetNvmCtx( GetNvmCtxParams_t* params );
 
+/*!
+ * \brief Returns the size of the region context of one LoRaMac instance.
+ *
+ * \retval      Size of the instance context in bytes.
+ */
+size_t RegionAS923GetInstanceCtxSize( void );
+
+/*!
+ * \brief Selects the region context the module operates on.
+ *
+ * \param [IN] instanceCtx Zero initialized block of RegionAS923GetInstanceCtxSize
+ *                         bytes. NULL selects the default instance.
+ */
+void RegionAS923SetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief Verifies a parameter.
  *
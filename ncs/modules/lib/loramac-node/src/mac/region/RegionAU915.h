@@ -351,6 +351,21 @@ void RegionAU915InitDefaults( InitDefaultsParams_t* params );
  */
 void* RegionAU915GetNvmCtx( GetNvmCtxParams_t* params );
 
+/*!
+ * \brief Returns the size of the region context of one LoRaMac instance.
+ *
+ * \retval      Size of the instance context in bytes.
+ */
+size_t RegionAU915GetInstanceCtxSize( void );
+
+/*!
+ * \brief Selects the region context the module operates on.
+ *
+ * \param [IN] instanceCtx Zero initialized block of RegionAU915GetInstanceCtxSize
+ *                         bytes. NULL selects the default instance.
+ */
+void RegionAU915SetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief Verifies a parameter.
  *
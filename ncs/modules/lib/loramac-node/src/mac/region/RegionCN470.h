@@ -305,6 +305,21 @@ void RegionCN470InitDefaults( InitDefaultsParams_t* params );
  */
 void* RegionCN470GetNvmCtx( GetNvmCtxParams_t* params );
 
+/*!
+ * \brief Returns the size of the region context of one LoRaMac instance.
+ *
+ * \retval      Size of the instance context in bytes.
+ */
+size_t RegionCN470GetInstanceCtxSize( void );
+
+/*!
+ * \brief Selects the region context the module operates on.
+ *
+ * \param [IN] instanceCtx Zero initialized block of RegionCN470GetInstanceCtxSize
+ *                         bytes. NULL selects the default instance.
+ */
+void RegionCN470SetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief Verifies a parameter.
  *
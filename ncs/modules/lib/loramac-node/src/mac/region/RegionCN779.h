@@ -319,6 +319,21 @@ void RegionCN779InitDefaults( InitDefaultsParams_t* params );
  */
 void* RegionCN779GetNvmCtx( GetNvmCtxParams_t* params );
 
+/*!
+ * \brief Returns the size of the region context of one LoRaMac instance.
+ *
+ * \retval      Size of the instance context in bytes.
+ */
+size_t RegionCN779GetInstanceCtxSize( void );
+
+/*!
+ * \brief Selects the region context the module operates on.
+ *
+ * \param [IN] instanceCtx Zero initialized block of RegionCN779GetInstanceCtxSize
+ *                         bytes. NULL selects the default instance.
+ */
+void RegionCN779SetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief Verifies a parameter.
  *
@@ -37,18 +37,33 @@
 #define BACKOFF_DC_10_HOURS     1000
 #define BACKOFF_DC_24_HOURS     10000
 
-static uint8_t CountChannels( uint16_t mask, uint8_t nbBits )
+/*!
+ * Bit index of the lowest set bit of a 32 bit value with a single bit set,
+ * indexed by the de Bruijn sequence 0x077CB531 multiplied by that value.
+ */
+static const uint8_t DeBruijnBitIndex[32] =
 {
-    uint8_t nbActiveBits = 0;
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+};
 
-    for( uint8_t j = 0; j < nbBits; j++ )
-    {
-        if( ( mask & ( 1 << j ) ) == ( 1 << j ) )
-        {
-            nbActiveBits++;
-        }
-    }
-    return nbActiveBits;
+static uint8_t CountChannels( uint16_t mask )
+{
+    // Adds the bits in parallel, 2, 4, 8 then 16 bits at a time
+    mask = mask - ( ( mask >> 1 ) & 0x5555 );
+    mask = ( mask & 0x3333 ) + ( ( mask >> 2 ) & 0x3333 );
+    mask = ( mask + ( mask >> 4 ) ) & 0x0F0F;
+    return ( uint8_t )( ( mask + ( mask >> 8 ) ) & 0x1F );
+}
+
+/*!
+ * \brief Returns the index of the lowest enabled channel, mask must not be 0
+ */
+static uint8_t FirstChannel( uint16_t mask )
+{
+    uint32_t lowest = mask & ( ~( uint32_t )mask + 1 );
+
+    return DeBruijnBitIndex[( uint32_t )( lowest * 0x077CB531UL ) >> 27];
 }
 
 uint16_t RegionCommonGetJoinDc( SysTime_t elapsedTime )
@@ -79,16 +94,15 @@ bool RegionCommonChanVerifyDr( uint8_t nbChannels, uint16_t* channelsMask, int8_
 
     for( uint8_t i = 0, k = 0; i < nbChannels; i += 16, k++ )
     {
-        for( uint8_t j = 0; j < 16; j++ )
-        {
-            if( ( ( channelsMask[k] & ( 1 << j ) ) != 0 ) )
-            {// Check datarate validity for enabled channels
-                if( RegionCommonValueInRange( dr, ( channels[i + j].DrRange.Fields.Min & 0x0F ),
-                                                  ( channels[i + j].DrRange.Fields.Max & 0x0F ) ) == 1 )
-                {
-                    // At least 1 channel has been found we can return OK.
-                    return true;
-                }
+        for( uint16_t mask = channelsMask[k]; mask != 0; mask &= mask - 1 )
+        {// Check datarate validity for enabled channels
+            uint8_t j = FirstChannel( mask );
+
+            if( RegionCommonValueInRange( dr, ( channels[i + j].DrRange.Fields.Min & 0x0F ),
+                                              ( channels[i + j].DrRange.Fields.Max & 0x0F ) ) == 1 )
+            {
+                // At least 1 channel has been found we can return OK.
+                return true;
             }
         }
     }
@@ -130,12 +144,151 @@ uint8_t RegionCommonCountChannels( uint16_t* channelsMask, uint8_t startIdx, uin
 
     for( uint8_t i = startIdx; i < stopIdx; i++ )
     {
-        nbChannels += CountChannels( channelsMask[i], 16 );
+        nbChannels += CountChannels( channelsMask[i] );
     }
 
     return nbChannels;
 }
 
+/*!
+ * \brief Returns the index of the n-th enabled channel of a mask word, the
+ *        mask must have more than index channels enabled
+ */
+static uint8_t SelectChannel( uint16_t mask, uint8_t index )
+{
+    // Drop the lower enabled channels of the word
+    for( ; index > 0; index-- )
+    {
+        mask &= mask - 1;
+    }
+    return FirstChannel( mask );
+}
+
+uint8_t RegionCommonChanMaskSelect( uint16_t* channelsMask, uint8_t channelsMaskSize, uint8_t index )
+{
+    if( channelsMaskSize == 1 )
+    { // A single word holds all enabled channels, no need to count them
+        return SelectChannel( channelsMask[0], index );
+    }
+
+    for( uint8_t k = 0; k < channelsMaskSize; k++ )
+    {
+        uint8_t nbChannels = CountChannels( channelsMask[k] );
+
+        if( index >= nbChannels )
+        {
+            index -= nbChannels;
+            continue;
+        }
+        return ( k * 16 ) + SelectChannel( channelsMask[k], index );
+    }
+    return 0;
+}
+
+/*!
+ * \brief Counts the enabled channels of regions with up to 16 channels. The
+ *        few enabled channels check the time off of their band directly.
+ */
+static uint8_t CountNbOfEnabledChannelsSingleWord( RegionCommonCountNbOfEnabledChannelsParams_t* countChannelsParams, uint16_t* enabledChannels, uint8_t* nbRestrictedChannels )
+{
+    ChannelParams_t* channels = countChannelsParams->Channels;
+    uint16_t mask = countChannelsParams->ChannelsMask[0];
+    uint16_t enabled = 0;
+    uint8_t nbEnabledChannels = 0;
+    uint8_t nbRestricted = 0;
+
+    if( ( countChannelsParams->Joined == false ) && ( countChannelsParams->JoinChannels != 0 ) )
+    {
+        mask &= countChannelsParams->JoinChannels;
+    }
+
+    for( ; mask != 0; mask &= mask - 1 )
+    {
+        uint8_t j = FirstChannel( mask );
+
+        if( channels[j].Frequency == 0 )
+        { // Check if the channel is enabled
+            continue;
+        }
+        if( RegionCommonValueInRange( countChannelsParams->Datarate, channels[j].DrRange.Fields.Min,
+                                      channels[j].DrRange.Fields.Max ) == false )
+        { // Check if the current channel selection supports the given datarate
+            continue;
+        }
+        if( countChannelsParams->Bands[channels[j].Band].TimeOff > 0 )
+        { // Check if the band is available for transmission
+            nbRestricted++;
+            continue;
+        }
+        enabled |= 1 << j;
+        nbEnabledChannels++;
+    }
+    enabledChannels[0] = enabled;
+
+    *nbRestrictedChannels = nbRestricted;
+    return nbEnabledChannels;
+}
+
+uint8_t RegionCommonCountNbOfEnabledChannels( RegionCommonCountNbOfEnabledChannelsParams_t* countChannelsParams, uint16_t* enabledChannels, uint8_t* nbRestrictedChannels )
+{
+    ChannelParams_t* channels = countChannelsParams->Channels;
+    uint32_t restrictedBands = 0;
+    uint8_t nbEnabledChannels = 0;
+    uint8_t nbRestricted = 0;
+
+    if( countChannelsParams->MaxNbChannels <= 16 )
+    {
+        return CountNbOfEnabledChannelsSingleWord( countChannelsParams, enabledChannels, nbRestrictedChannels );
+    }
+
+    // Evaluate the band time off once, not once per channel
+    for( uint8_t i = 0; i < countChannelsParams->MaxNbBands; i++ )
+    {
+        if( countChannelsParams->Bands[i].TimeOff > 0 )
+        {
+            restrictedBands |= 1UL << i;
+        }
+    }
+
+    for( uint8_t i = 0, k = 0; i < countChannelsParams->MaxNbChannels; i += 16, k++ )
+    {
+        uint16_t mask = countChannelsParams->ChannelsMask[k];
+        uint16_t enabled = 0;
+
+        if( ( countChannelsParams->Joined == false ) && ( countChannelsParams->JoinChannels != 0 ) )
+        {
+            mask &= countChannelsParams->JoinChannels;
+        }
+
+        // Visit the channels of the mask only
+        for( ; mask != 0; mask &= mask - 1 )
+        {
+            uint8_t j = FirstChannel( mask );
+
+            if( channels[i + j].Frequency == 0 )
+            { // Check if the channel is enabled
+                continue;
+            }
+            if( RegionCommonValueInRange( countChannelsParams->Datarate, channels[i + j].DrRange.Fields.Min,
+                                          channels[i + j].DrRange.Fields.Max ) == false )
+            { // Check if the current channel selection supports the given datarate
+                continue;
+            }
+            if( ( restrictedBands & ( 1UL << channels[i + j].Band ) ) != 0 )
+            { // Check if the band is available for transmission
+                nbRestricted++;
+                continue;
+            }
+            enabled |= 1 << j;
+            nbEnabledChannels++;
+        }
+        enabledChannels[k] = enabled;
+    }
+
+    *nbRestrictedChannels = nbRestricted;
+    return nbEnabledChannels;
+}
+
 void RegionCommonChanMaskCopy( uint16_t* channelsMaskDest, uint16_t* channelsMaskSrc, uint8_t len )
 {
     if( ( channelsMaskDest != NULL ) && ( channelsMaskSrc != NULL ) )
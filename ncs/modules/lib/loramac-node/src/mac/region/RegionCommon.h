@@ -45,6 +45,43 @@ extern "C"
 #include "LoRaMacTypes.h"
 #include "region/Region.h"
 
+typedef struct sRegionCommonCountNbOfEnabledChannelsParams
+{
+    /*!
+     * Set to true, if the node has already joined a network, otherwise false.
+     */
+    bool Joined;
+    /*!
+     * Datarate of the transmission.
+     */
+    int8_t Datarate;
+    /*!
+     * Channels mask of the region.
+     */
+    uint16_t* ChannelsMask;
+    /*!
+     * Channels of the region.
+     */
+    ChannelParams_t* Channels;
+    /*!
+     * Bands of the region.
+     */
+    Band_t* Bands;
+    /*!
+     * Maximum number of channels of the region.
+     */
+    uint8_t MaxNbChannels;
+    /*!
+     * Number of bands of the region, at most 32.
+     */
+    uint8_t MaxNbBands;
+    /*!
+     * Channels of each 16 bit word of the mask which may be used before
+     * the join, 0 for no restriction.
+     */
+    uint16_t JoinChannels;
+}RegionCommonCountNbOfEnabledChannelsParams_t;
+
 typedef struct sRegionCommonLinkAdrParams
 {
     /*!
@@ -278,6 +315,37 @@ bool RegionCommonChanDisable( uint16_t* channelsMask, uint8_t id, uint8_t maxCha
  */
 uint8_t RegionCommonCountChannels( uint16_t* channelsMask, uint8_t startIdx, uint8_t stopIdx );
 
+/*!
+ * \brief Returns the channel at a given position among the channels enabled
+ *        in a channels mask. This is a generic function and valid for all
+ *        regions.
+ *
+ * \param [IN] channelsMask The channels mask.
+ *
+ * \param [IN] channelsMaskSize Size of the channels mask in 16 bit words.
+ *
+ * \param [IN] index Position of the channel, lower than the number of
+ *                   enabled channels.
+ *
+ * \retval Returns the channel id.
+ */
+uint8_t RegionCommonChanMaskSelect( uint16_t* channelsMask, uint8_t channelsMaskSize, uint8_t index );
+
+/*!
+ * \brief Builds the set of channels available for the next transmission.
+ *        This is a generic function and valid for all regions.
+ *
+ * \param [IN] countChannelsParams Parameters of the channel search.
+ *
+ * \param [OUT] enabledChannels Channels mask of the available channels, as
+ *                              many words as the region channels mask.
+ *
+ * \param [OUT] nbRestrictedChannels Number of channels of a band in time off.
+ *
+ * \retval Returns the number of available channels.
+ */
+uint8_t RegionCommonCountNbOfEnabledChannels( RegionCommonCountNbOfEnabledChannelsParams_t* countChannelsParams, uint16_t* enabledChannels, uint8_t* nbRestrictedChannels );
+
 /*!
  * \brief Copy a channels mask.
  *        This is a generic function and valid for all regions.
@@ -320,6 +320,21 @@ void RegionEU433InitDefaults( InitDefaultsParams_t* params );
  */
 void* RegionEU433GetNvmCtx( GetNvmCtxParams_t* params );
 
+/*!
+ * \brief Returns the size of the region context of one LoRaMac instance.
+ *
+ * \retval      Size of the instance context in bytes.
+ */
+size_t RegionEU433GetInstanceCtxSize( void );
+
+/*!
+ * \brief Selects the region context the module operates on.
+ *
+ * \param [IN] instanceCtx Zero initialized block of RegionEU433GetInstanceCtxSize
+ *                         bytes. NULL selects the default instance.
+ */
+void RegionEU433SetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief Verifies a parameter.
  *
@@ -347,6 +347,21 @@ void RegionEU868InitDefaults( InitDefaultsParams_t* params );
  */
 void* RegionEU868GetNvmCtx( GetNvmCtxParams_t* params );
 
+/*!
+ * \brief Returns the size of the region context of one LoRaMac instance.
+ *
+ * \retval      Size of the instance context in bytes.
+ */
+size_t RegionEU868GetInstanceCtxSize( void );
+
+/*!
+ * \brief Selects the region context the module operates on.
+ *
+ * \param [IN] instanceCtx Zero initialized block of RegionEU868GetInstanceCtxSize
+ *                         bytes. NULL selects the default instance.
+ */
+void RegionEU868SetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief Verifies a parameter.
  *
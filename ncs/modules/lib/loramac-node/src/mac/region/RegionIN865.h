@@ -322,6 +322,21 @@ void RegionIN865InitDefaults( InitDefaultsParams_t* params );
  */
 void* RegionIN865GetNvmCtx( GetNvmCtxParams_t* params );
 
+/*!
+ * \brief Returns the size of the region context of one LoRaMac instance.
+ *
+ * \retval      Size of the instance context in bytes.
+ */
+size_t RegionIN865GetInstanceCtxSize( void );
+
+/*!
+ * \brief Selects the region context the module operates on.
+ *
+ * \param [IN] instanceCtx Zero initialized block of RegionIN865GetInstanceCtxSize
+ *                         bytes. NULL selects the default instance.
+ */
+void RegionIN865SetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief Verifies a parameter.
  *
@@ -332,6 +332,21 @@ void RegionKR920InitDefaults( InitDefaultsParams_t* params );
  */
 void* RegionKR920GetNvmCtx( GetNvmCtxParams_t* params );
 
+/*!
+ * \brief Returns the size of the region context of one LoRaMac instance.
+ *
+ * \retval      Size of the instance context in bytes.
+ */
+size_t RegionKR920GetInstanceCtxSize( void );
+
+/*!
+ * \brief Selects the region context the module operates on.
+ *
+ * \param [IN] instanceCtx Zero initialized block of RegionKR920GetInstanceCtxSize
+ *                         bytes. NULL selects the default instance.
+ */
+void RegionKR920SetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief Verifies a parameter.
  *
@@ -305,6 +305,21 @@ void RegionRU864InitDefaults( InitDefaultsParams_t* params );
  */
 void* RegionRU864GetNvmCtx( GetNvmCtxParams_t* params );
 
+/*!
+ * \brief Returns the size of the region context of one LoRaMac instance.
+ *
+ * \retval      Size of the instance context in bytes.
+ */
+size_t RegionRU864GetInstanceCtxSize( void );
+
+/*!
+ * \brief Selects the region context the module operates on.
+ *
+ * \param [IN] instanceCtx Zero initialized block of RegionRU864GetInstanceCtxSize
+ *                         bytes. NULL selects the default instance.
+ */
+void RegionRU864SetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief Verifies a parameter.
  *
@@ -312,6 +312,21 @@ void RegionUS915InitDefaults( InitDefaultsParams_t* params );
  */
 void* RegionUS915GetNvmCtx( GetNvmCtxParams_t* params );
 
+/*!
+ * \brief Returns the size of the region context of one LoRaMac instance.
+ *
+ * \retval      Size of the instance context in bytes.
+ */
+size_t RegionUS915GetInstanceCtxSize( void );
+
+/*!
+ * \brief Selects the region context the module operates on.
+ *
+ * \param [IN] instanceCtx Zero initialized block of RegionUS915GetInstanceCtxSize
+ *                         bytes. NULL selects the default instance.
+ */
+void RegionUS915SetInstanceCtx( void* instanceCtx );
+
 /*!
  * \brief Verifies a parameter.
  *
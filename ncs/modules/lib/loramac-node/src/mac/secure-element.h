@@ -115,6 +115,23 @@ SecureElementStatus_t SecureElementRestoreNvmCtx( void* seNvmCtx );
  */
 void* SecureElementGetNvmCtx( size_t* seNvmCtxSize );
 
+/*!
+ * Returns the size of the memory block holding the state of one secure
+ * element instance.
+ *
+ * \retval                        - Size of the instance context in bytes
+ */
+size_t SecureElementGetInstanceCtxSize( void );
+
+/*!
+ * Selects the memory block the secure element operates on. Used by
+ * LoRaMacInstanceSelect.
+ *
+ * \param[IN]     instanceCtx     - Instance context of GetInstanceCtxSize bytes.
+ *                                  NULL selects the default instance.
+ */
+void SecureElementSetInstanceCtx( void* instanceCtx );
+
 /*!
  * Sets a key
  *
@@ -55,6 +55,14 @@
 #  define USE_TABLES
 #endif
 
+/* define to encrypt with one 32-bit table (1 kbyte) combining the S box and
+   mix columns, which processes a whole column per table lookup. Not used on
+   M0/M0+ cores or when AES_BYTE_ORIENTED is defined */
+#if defined( USE_TABLES ) && !defined( AES_BYTE_ORIENTED ) && \
+    !defined( __ARM_ARCH_6M__ )
+#  define USE_T_TABLE
+#endif
+
 /*  On Intel Core 2 duo VERSION_1 is faster */
 
 /* alternative versions (test for performance on your system) */
@@ -197,8 +205,10 @@ static const uint8_t sbox[256]  =  sb_data(f1);
 static const uint8_t isbox[256] = isb_data(f1);
 #endif
 
+#if !defined( USE_T_TABLE ) || defined( AES_ENC_128_OTFK ) || defined( AES_ENC_256_OTFK )
 static const uint8_t gfm2_sbox[256] = sb_data(f2);
 static const uint8_t gfm3_sbox[256] = sb_data(f3);
+#endif
 
 #if defined( AES_DEC_PREKEYED )
 static const uint8_t gfmul_9[256] = mm_data(f9);
@@ -373,6 +383,11 @@ static void xor_block( void *d, const void *s )
 #endif
 }
 
+/* only used by the byte oriented rounds, decryption and on the fly keying */
+#if !defined( USE_T_TABLE ) || defined( AES_DEC_PREKEYED ) || \
+    defined( AES_ENC_128_OTFK ) || defined( AES_DEC_128_OTFK ) || \
+    defined( AES_ENC_256_OTFK ) || defined( AES_DEC_256_OTFK )
+
 static void copy_and_key( void *d, const void *s, const void *k )
 {
 #if defined( HAVE_UINT_32T )
@@ -408,6 +423,10 @@ static void add_round_key( uint8_t d[N_BLOCK], const uint8_t k[N_BLOCK] )
     xor_block(d, k);
 }
 
+#endif
+
+#if !defined( USE_T_TABLE ) || defined( AES_ENC_128_OTFK ) || defined( AES_ENC_256_OTFK )
+
 static void shift_sub_rows( uint8_t st[N_BLOCK] )
 {   uint8_t tt;
 
@@ -424,6 +443,8 @@ static void shift_sub_rows( uint8_t st[N_BLOCK] )
     st[ 7] = s_box(st[ 3]); st[ 3] = s_box( tt );
 }
 
+#endif
+
 #if defined( AES_DEC_PREKEYED )
 
 static void inv_shift_sub_rows( uint8_t st[N_BLOCK] )
@@ -444,6 +465,8 @@ static void inv_shift_sub_rows( uint8_t st[N_BLOCK] )
 
 #endif
 
+#if !defined( USE_T_TABLE ) || defined( AES_ENC_128_OTFK ) || defined( AES_ENC_256_OTFK )
+
 #if defined( VERSION_1 )
   static void mix_sub_columns( uint8_t dt[N_BLOCK] )
   { uint8_t st[N_BLOCK];
@@ -473,6 +496,8 @@ static void inv_shift_sub_rows( uint8_t st[N_BLOCK] )
     dt[15] = gfm3_sb(st[12]) ^ s_box(st[1]) ^ s_box(st[6]) ^ gfm2_sb(st[11]);
   }
 
+#endif
+
 #if defined( AES_DEC_PREKEYED )
 
 #if defined( VERSION_1 )
@@ -506,6 +531,70 @@ static void inv_shift_sub_rows( uint8_t st[N_BLOCK] )
 
 #endif
 
+#if defined( AES_ENC_PREKEYED ) && defined( USE_T_TABLE )
+
+/*  The columns of the state are held in 32-bit words with row 0 in the low
+    byte. A table entry holds the mix columns contribution of an S box output
+    in row 0, the other rows use the entry rotated by 8, 16 and 24 bits */
+
+#define t_box_w(x)  ( (uint32_t)f2(x) | ((uint32_t)(x) << 8) | \
+                      ((uint32_t)(x) << 16) | ((uint32_t)f3(x) << 24) )
+
+static const uint32_t t_box[256] = sb_data(t_box_w);
+
+#define rot_8(x)    (((x) << 8) | ((x) >> 24))
+#define rot_16(x)   (((x) << 16) | ((x) >> 16))
+#define rot_24(x)   (((x) << 24) | ((x) >> 8))
+
+#define word_in(p)  ( (uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | \
+                      ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24) )
+
+#define word_out(p, w)  { (p)[0] = (uint8_t)(w); (p)[1] = (uint8_t)((w) >> 8); \
+                          (p)[2] = (uint8_t)((w) >> 16); (p)[3] = (uint8_t)((w) >> 24); }
+
+/*  Column of a full round, shift rows takes row r from column c + r */
+#define t_round(a, b, c, d) \
+    ( t_box[(a) & 0xff] ^ rot_8(t_box[((b) >> 8) & 0xff]) ^ \
+      rot_16(t_box[((c) >> 16) & 0xff]) ^ rot_24(t_box[(d) >> 24]) )
+
+/*  Column of the last round, which has no mix columns */
+#define t_last_round(a, b, c, d) \
+    ( (uint32_t)s_box((a) & 0xff) | ((uint32_t)s_box(((b) >> 8) & 0xff) << 8) | \
+      ((uint32_t)s_box(((c) >> 16) & 0xff) << 16) | ((uint32_t)s_box((d) >> 24) << 24) )
+
+static void t_box_encrypt( const uint8_t in[N_BLOCK], uint8_t out[N_BLOCK], const aes_context ctx[1] )
+{   uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+    const uint8_t *k = ctx->ksch;
+    uint8_t r;
+
+    s0 = word_in(in     ) ^ word_in(k     );
+    s1 = word_in(in +  4) ^ word_in(k +  4);
+    s2 = word_in(in +  8) ^ word_in(k +  8);
+    s3 = word_in(in + 12) ^ word_in(k + 12);
+
+    for( r = 1 ; r < ctx->rnd ; ++r )
+    {
+        k += N_BLOCK;
+        t0 = t_round(s0, s1, s2, s3) ^ word_in(k     );
+        t1 = t_round(s1, s2, s3, s0) ^ word_in(k +  4);
+        t2 = t_round(s2, s3, s0, s1) ^ word_in(k +  8);
+        t3 = t_round(s3, s0, s1, s2) ^ word_in(k + 12);
+        s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+    }
+
+    k += N_BLOCK;
+    t0 = t_last_round(s0, s1, s2, s3) ^ word_in(k     );
+    t1 = t_last_round(s1, s2, s3, s0) ^ word_in(k +  4);
+    t2 = t_last_round(s2, s3, s0, s1) ^ word_in(k +  8);
+    t3 = t_last_round(s3, s0, s1, s2) ^ word_in(k + 12);
+    word_out(out     , t0);
+    word_out(out +  4, t1);
+    word_out(out +  8, t2);
+    word_out(out + 12, t3);
+}
+
+#endif
+
 #if defined( AES_ENC_PREKEYED ) || defined( AES_DEC_PREKEYED )
 
 /*  Set the cipher key for the pre-keyed version */
@@ -569,6 +658,9 @@ return_type aes_encrypt( const uint8_t in[N_BLOCK], uint8_t  out[N_BLOCK], const
 {
     if( ctx->rnd )
     {
+#if defined( USE_T_TABLE )
+        t_box_encrypt( in, out, ctx );
+#else
         uint8_t s1[N_BLOCK], r;
         copy_and_key( s1, in, ctx->ksch );
 
@@ -586,6 +678,7 @@ return_type aes_encrypt( const uint8_t in[N_BLOCK], uint8_t  out[N_BLOCK], const
 #endif
         shift_sub_rows( s1 );
         copy_and_key( out, s1, ctx->ksch + r * N_BLOCK );
+#endif
     }
     else
         return ( uint8_t )-1;
@@ -32,6 +32,26 @@ Maintainer: Miguel Luis ( Semtech ), Gregory Cristian ( Semtech ),
 #define NUM_OF_KEYS      24
 #define KEY_SIZE         16
 
+/*!
+ * Number of keys whose AES key schedule and CMAC subkeys are kept. A LoRaWAN
+ * 1.0.x data frame uses 3 keys, a LoRaWAN 1.1.x data frame up to 4.
+ */
+#ifndef SOFT_SE_KEY_CACHE_SIZE
+#define SOFT_SE_KEY_CACHE_SIZE      4
+#endif
+
+/*!
+ * Layout of the CMAC computation context before the CMAC subkeys were added to
+ * it, keeps the layout of the non volatile context
+ */
+typedef struct sAesCmacCtxReserved
+{
+    aes_context rijndael;
+    uint8_t X[16];
+    uint8_t M_last[16];
+    uint32_t M_n;
+}AesCmacCtxReserved_t;
+
 /*!
  * Identifier value pair type for Keys
  */
@@ -61,13 +81,13 @@ typedef struct sSecureElementNvCtx
      */
     uint8_t JoinEui[SE_EUI_SIZE];
     /*
-     * AES computation context variable
+     * Reserved, was the AES computation context variable
      */
     aes_context AesContext;
     /*
-     * CMAC computation context variable
+     * Reserved, was the CMAC computation context variable
      */
-    AES_CMAC_CTX AesCmacCtx[1];
+    AesCmacCtxReserved_t AesCmacCtx[1];
     /*
      * Key List
      */
@@ -75,9 +95,62 @@ typedef struct sSecureElementNvCtx
 }SecureElementNvCtx_t;
 
 /*
- * Module context
+ * Precomputed key material of a recently used key
+ */
+typedef struct sKeyCacheEntry
+{
+    /*
+     * Key identifier
+     */
+    KeyIdentifier_t KeyID;
+    /*
+     * Set when the entry holds the current value of the key
+     */
+    bool Valid;
+    /*
+     * Value of KeyCacheTime at the last use, 0 if not valid
+     */
+    uint32_t LastUse;
+    /*
+     * AES key schedule and CMAC subkeys. The AES encryption uses the key
+     * schedule of the CMAC context.
+     */
+    AES_CMAC_CTX CmacCtx;
+}KeyCacheEntry_t;
+
+/*
+ * Secure Element module context of a LoRaMac instance
+ */
+typedef struct sSecureElementInstanceCtx
+{
+    /*
+     * Non volatile context
+     */
+    SecureElementNvCtx_t NvmCtx;
+    /*
+     * Key cache, least recently used entry replaced first
+     */
+    KeyCacheEntry_t KeyCache[SOFT_SE_KEY_CACHE_SIZE];
+    /*
+     * Incremented on each key cache lookup
+     */
+    uint32_t KeyCacheTime;
+}SecureElementInstanceCtx_t;
+
+/*
+ * Module context of the default LoRaMac instance
+ */
+static SecureElementInstanceCtx_t DefaultInstanceCtx;
+
+/*
+ * Module context of the selected LoRaMac instance
+ */
+static SecureElementInstanceCtx_t* SeCtx = &DefaultInstanceCtx;
+
+/*
+ * Non volatile context of the selected LoRaMac instance
  */
-static SecureElementNvCtx_t SeNvmCtx;
+static SecureElementNvCtx_t* SeNvmCtx = &DefaultInstanceCtx.NvmCtx;
 
 static SecureElementNvmEvent SeNvmCtxChanged;
 
@@ -98,15 +171,82 @@ SecureElementStatus_t GetKeyByID( KeyIdentifier_t keyID, Key_t** keyItem )
 {
     for( uint8_t i = 0; i < NUM_OF_KEYS; i++ )
     {
-        if( SeNvmCtx.KeyList[i].KeyID == keyID )
+        if( SeNvmCtx->KeyList[i].KeyID == keyID )
         {
-            *keyItem = &( SeNvmCtx.KeyList[i] );
+            *keyItem = &( SeNvmCtx->KeyList[i] );
             return SECURE_ELEMENT_SUCCESS;
         }
     }
     return SECURE_ELEMENT_ERROR_INVALID_KEY_ID;
 }
 
+/*
+ * Drops the cached key material of a key.
+ *
+ * \param[IN]  keyID          - Key identifier
+ */
+static void InvalidateKeyCache( KeyIdentifier_t keyID )
+{
+    for( uint8_t i = 0; i < SOFT_SE_KEY_CACHE_SIZE; i++ )
+    {
+        if( SeCtx->KeyCache[i].KeyID == keyID )
+        {
+            memset1( ( uint8_t* )&SeCtx->KeyCache[i], 0, sizeof( KeyCacheEntry_t ) );
+        }
+    }
+}
+
+/*
+ * Drops the cached key material of all keys.
+ */
+static void ClearKeyCache( void )
+{
+    memset1( ( uint8_t* )SeCtx->KeyCache, 0, sizeof( SeCtx->KeyCache ) );
+}
+
+/*
+ * Gets the AES key schedule and CMAC subkeys of a key, computes them if the
+ * key is not cached.
+ *
+ * \param[IN]  keyID          - Key identifier
+ * \param[OUT] cmacCtx        - CMAC context set with the key
+ * \retval                    - Status of the operation
+ */
+static SecureElementStatus_t GetKeyCtx( KeyIdentifier_t keyID, AES_CMAC_CTX** cmacCtx )
+{
+    KeyCacheEntry_t* entry = &SeCtx->KeyCache[0];
+    Key_t* keyItem;
+
+    SeCtx->KeyCacheTime++;
+    for( uint8_t i = 0; i < SOFT_SE_KEY_CACHE_SIZE; i++ )
+    {
+        if( ( SeCtx->KeyCache[i].Valid == true ) && ( SeCtx->KeyCache[i].KeyID == keyID ) )
+        {
+            SeCtx->KeyCache[i].LastUse = SeCtx->KeyCacheTime;
+            *cmacCtx = &SeCtx->KeyCache[i].CmacCtx;
+            return SECURE_ELEMENT_SUCCESS;
+        }
+        if( SeCtx->KeyCache[i].LastUse < entry->LastUse )
+        {
+            entry = &SeCtx->KeyCache[i];
+        }
+    }
+
+    SecureElementStatus_t retval = GetKeyByID( keyID, &keyItem );
+    if( retval != SECURE_ELEMENT_SUCCESS )
+    {
+        return retval;
+    }
+
+    AES_CMAC_Init( &entry->CmacCtx );
+    AES_CMAC_SetKey( &entry->CmacCtx, keyItem->KeyValue );
+    entry->KeyID = keyID;
+    entry->Valid = true;
+    entry->LastUse = SeCtx->KeyCacheTime;
+    *cmacCtx = &entry->CmacCtx;
+    return SECURE_ELEMENT_SUCCESS;
+}
+
 /*
  * Dummy callback in case if the user provides NULL function pointer
  */
@@ -136,23 +276,21 @@ static SecureElementStatus_t ComputeCmac( uint8_t *micBxBuffer, uint8_t *buffer,
 
     uint8_t Cmac[16];
 
-    AES_CMAC_Init( SeNvmCtx.AesCmacCtx );
-
-    Key_t* keyItem;
-    SecureElementStatus_t retval = GetKeyByID( keyID, &keyItem );
+    AES_CMAC_CTX* cmacCtx;
+    SecureElementStatus_t retval = GetKeyCtx( keyID, &cmacCtx );
 
     if( retval == SECURE_ELEMENT_SUCCESS )
     {
-        AES_CMAC_SetKey( SeNvmCtx.AesCmacCtx, keyItem->KeyValue );
+        AES_CMAC_Restart( cmacCtx );
 
         if( micBxBuffer != NULL )
         {
-            AES_CMAC_Update( SeNvmCtx.AesCmacCtx, micBxBuffer, 16 );
+            AES_CMAC_Update( cmacCtx, micBxBuffer, 16 );
         }
 
-        AES_CMAC_Update( SeNvmCtx.AesCmacCtx, buffer, size );
+        AES_CMAC_Update( cmacCtx, buffer, size );
 
-        AES_CMAC_Final( Cmac, SeNvmCtx.AesCmacCtx );
+        AES_CMAC_Final( Cmac, cmacCtx );
 
         // Bring into the required format
         *cmac = ( uint32_t )( ( uint32_t ) Cmac[3] << 24 | ( uint32_t ) Cmac[2] << 16 | ( uint32_t ) Cmac[1] << 8 | ( uint32_t ) Cmac[0] );
@@ -171,36 +309,38 @@ SecureElementStatus_t SecureElementInit( SecureElementNvmEvent seNvmCtxChanged )
     uint8_t zeroKey[16] = { 0 };
 
     // Initialize with defaults
-    SeNvmCtx.KeyList[itr++].KeyID = APP_KEY;
-    SeNvmCtx.KeyList[itr++].KeyID = GEN_APP_KEY;
-    SeNvmCtx.KeyList[itr++].KeyID = NWK_KEY;
-    SeNvmCtx.KeyList[itr++].KeyID = J_S_INT_KEY;
-    SeNvmCtx.KeyList[itr++].KeyID = J_S_ENC_KEY;
-    SeNvmCtx.KeyList[itr++].KeyID = F_NWK_S_INT_KEY;
-    SeNvmCtx.KeyList[itr++].KeyID = S_NWK_S_INT_KEY;
-    SeNvmCtx.KeyList[itr++].KeyID = NWK_S_ENC_KEY;
-    SeNvmCtx.KeyList[itr++].KeyID = APP_S_KEY;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_ROOT_KEY;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_KE_KEY;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_KEY_0;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_APP_S_KEY_0;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_NWK_S_KEY_0;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_KEY_1;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_APP_S_KEY_1;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_NWK_S_KEY_1;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_KEY_2;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_APP_S_KEY_2;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_NWK_S_KEY_2;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_KEY_3;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_APP_S_KEY_3;
-    SeNvmCtx.KeyList[itr++].KeyID = MC_NWK_S_KEY_3;
-    SeNvmCtx.KeyList[itr].KeyID = SLOT_RAND_ZERO_KEY;
+    SeNvmCtx->KeyList[itr++].KeyID = APP_KEY;
+    SeNvmCtx->KeyList[itr++].KeyID = GEN_APP_KEY;
+    SeNvmCtx->KeyList[itr++].KeyID = NWK_KEY;
+    SeNvmCtx->KeyList[itr++].KeyID = J_S_INT_KEY;
+    SeNvmCtx->KeyList[itr++].KeyID = J_S_ENC_KEY;
+    SeNvmCtx->KeyList[itr++].KeyID = F_NWK_S_INT_KEY;
+    SeNvmCtx->KeyList[itr++].KeyID = S_NWK_S_INT_KEY;
+    SeNvmCtx->KeyList[itr++].KeyID = NWK_S_ENC_KEY;
+    SeNvmCtx->KeyList[itr++].KeyID = APP_S_KEY;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_ROOT_KEY;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_KE_KEY;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_KEY_0;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_APP_S_KEY_0;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_NWK_S_KEY_0;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_KEY_1;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_APP_S_KEY_1;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_NWK_S_KEY_1;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_KEY_2;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_APP_S_KEY_2;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_NWK_S_KEY_2;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_KEY_3;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_APP_S_KEY_3;
+    SeNvmCtx->KeyList[itr++].KeyID = MC_NWK_S_KEY_3;
+    SeNvmCtx->KeyList[itr].KeyID = SLOT_RAND_ZERO_KEY;
 
     // Set standard keys
-    memcpy1( SeNvmCtx.KeyList[itr].KeyValue, zeroKey, KEY_SIZE );
+    memcpy1( SeNvmCtx->KeyList[itr].KeyValue, zeroKey, KEY_SIZE );
 
-    memset1( SeNvmCtx.DevEui, 0, SE_EUI_SIZE );
-    memset1( SeNvmCtx.JoinEui, 0, SE_EUI_SIZE );
+    memset1( SeNvmCtx->DevEui, 0, SE_EUI_SIZE );
+    memset1( SeNvmCtx->JoinEui, 0, SE_EUI_SIZE );
+
+    ClearKeyCache( );
 
     // Assign callback
     if( seNvmCtxChanged != 0 )
@@ -220,7 +360,8 @@ SecureElementStatus_t SecureElementRestoreNvmCtx( void* seNvmCtx )
     // Restore nvm context
     if( seNvmCtx != 0 )
     {
-        memcpy1( ( uint8_t* ) &SeNvmCtx, ( uint8_t* ) seNvmCtx, sizeof( SeNvmCtx ) );
+        memcpy1( ( uint8_t* ) SeNvmCtx, ( uint8_t* ) seNvmCtx, sizeof( SecureElementNvCtx_t ) );
+        ClearKeyCache( );
         return SECURE_ELEMENT_SUCCESS;
     }
     else
@@ -231,8 +372,26 @@ SecureElementStatus_t SecureElementRestoreNvmCtx( void* seNvmCtx )
 
 void* SecureElementGetNvmCtx( size_t* seNvmCtxSize )
 {
-    *seNvmCtxSize = sizeof( SeNvmCtx );
-    return &SeNvmCtx;
+    *seNvmCtxSize = sizeof( SecureElementNvCtx_t );
+    return SeNvmCtx;
+}
+
+size_t SecureElementGetInstanceCtxSize( void )
+{
+    return sizeof( SecureElementInstanceCtx_t );
+}
+
+void SecureElementSetInstanceCtx( void* instanceCtx )
+{
+    if( instanceCtx != NULL )
+    {
+        SeCtx = ( SecureElementInstanceCtx_t* ) instanceCtx;
+    }
+    else
+    {
+        SeCtx = &DefaultInstanceCtx;
+    }
+    SeNvmCtx = &SeCtx->NvmCtx;
 }
 
 SecureElementStatus_t SecureElementSetKey( KeyIdentifier_t keyID, uint8_t* key )
@@ -244,7 +403,7 @@ SecureElementStatus_t SecureElementSetKey( KeyIdentifier_t keyID, uint8_t* key )
 
     for( uint8_t i = 0; i < NUM_OF_KEYS; i++ )
     {
-        if( SeNvmCtx.KeyList[i].KeyID == keyID )
+        if( SeNvmCtx->KeyList[i].KeyID == keyID )
         {
             if( ( keyID == MC_KEY_0 ) || ( keyID == MC_KEY_1 ) || ( keyID == MC_KEY_2 ) || ( keyID == MC_KEY_3 ) )
             {  // Decrypt the key if its a Mckey
@@ -253,14 +412,16 @@ SecureElementStatus_t SecureElementSetKey( KeyIdentifier_t keyID, uint8_t* key )
 
                 retval = SecureElementAesEncrypt( key, 16, MC_KE_KEY, decryptedKey );
 
-                memcpy1( SeNvmCtx.KeyList[i].KeyValue, decryptedKey, KEY_SIZE );
+                memcpy1( SeNvmCtx->KeyList[i].KeyValue, decryptedKey, KEY_SIZE );
+                InvalidateKeyCache( keyID );
                 SeNvmCtxChanged( );
 
                 return retval;
             }
             else
             {
-                memcpy1( SeNvmCtx.KeyList[i].KeyValue, key, KEY_SIZE );
+                memcpy1( SeNvmCtx->KeyList[i].KeyValue, key, KEY_SIZE );
+                InvalidateKeyCache( keyID );
                 SeNvmCtxChanged( );
                 return SECURE_ELEMENT_SUCCESS;
             }
@@ -317,20 +478,16 @@ SecureElementStatus_t SecureElementAesEncrypt( uint8_t* buffer, uint16_t size, K
         return SECURE_ELEMENT_ERROR_BUF_SIZE;
     }
 
-    memset1( SeNvmCtx.AesContext.ksch, '\0', 240 );
-
-    Key_t* pItem;
-    SecureElementStatus_t retval = GetKeyByID( keyID, &pItem );
+    AES_CMAC_CTX* cmacCtx;
+    SecureElementStatus_t retval = GetKeyCtx( keyID, &cmacCtx );
 
     if( retval == SECURE_ELEMENT_SUCCESS )
     {
-        aes_set_key( pItem->KeyValue, 16, &SeNvmCtx.AesContext );
-
-        uint8_t block = 0;
+        uint16_t block = 0;
 
         while( size != 0 )
         {
-            aes_encrypt( &buffer[block], &encBuffer[block], &SeNvmCtx.AesContext );
+            aes_encrypt( &buffer[block], &encBuffer[block], &cmacCtx->rijndael );
             block = block + 16;
             size = size - 16;
         }
@@ -390,14 +547,14 @@ SecureElementStatus_t SecureElementSetDevEui( uint8_t* devEui )
     {
         return SECURE_ELEMENT_ERROR_NPE;
     }
-    memcpy1( SeNvmCtx.DevEui, devEui, SE_EUI_SIZE );
+    memcpy1( SeNvmCtx->DevEui, devEui, SE_EUI_SIZE );
     SeNvmCtxChanged( );
     return SECURE_ELEMENT_SUCCESS;
 }
 
 uint8_t* SecureElementGetDevEui( void )
 {
-    return SeNvmCtx.DevEui;
+    return SeNvmCtx->DevEui;
 }
 
 SecureElementStatus_t SecureElementSetJoinEui( uint8_t* joinEui )
@@ -406,12 +563,12 @@ SecureElementStatus_t SecureElementSetJoinEui( uint8_t* joinEui )
     {
         return SECURE_ELEMENT_ERROR_NPE;
     }
-    memcpy1( SeNvmCtx.JoinEui, joinEui, SE_EUI_SIZE );
+    memcpy1( SeNvmCtx->JoinEui, joinEui, SE_EUI_SIZE );
     SeNvmCtxChanged( );
     return SECURE_ELEMENT_SUCCESS;
 }
 
 uint8_t* SecureElementGetJoinEui( void )
 {
-    return SeNvmCtx.JoinEui;
+    return SeNvmCtx->JoinEui;
 }
@@ -0,0 +1,573 @@
+/*!
+ * \file      nvmm-journal.c
+ *
+ * \brief     Journaled none volatile memory management implementation
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2020 Semtech
+ *
+ * \endcode
+ */
+#include <stddef.h>
+#include "utilities.h"
+#include "eeprom.h"
+#include "timer.h"
+#include "nvmm-journal.h"
+
+/*
+ * Bank layout
+ *
+ *  | Magic(4) | Seq(4) | Crc(2) | Record | Record | ...
+ *
+ * Record layout, the CRC covers the bank sequence number, the header and the
+ * data so that records left over from a previous use of the bank are invalid
+ *
+ *  | Id(1) | Size(1) | Offset(2) | Data(Size) | Crc(2) |
+ */
+#define NVMM_JOURNAL_MAGIC                          0x4C4A4D4E
+
+#define BANK_HEADER_SIZE                            10
+
+#define RECORD_HEADER_SIZE                          4
+
+#define RECORD_CRC_SIZE                             2
+
+#define RECORD_OVERHEAD                             ( RECORD_HEADER_SIZE + RECORD_CRC_SIZE )
+
+#define RECORD_MAX_DATA                             255
+
+#define BLOCK_ID_NONE                               0xFF
+
+typedef struct sNvmmJournalCtx
+{
+    /*!
+     * EEPROM address of the first bank
+     */
+    uint16_t Addr;
+    /*!
+     * Size of one bank
+     */
+    uint16_t BankSize;
+    /*!
+     * Bank the records are appended to
+     */
+    uint8_t ActiveBank;
+    /*!
+     * Sequence number of the active bank
+     */
+    uint32_t Seq;
+    /*!
+     * Offset of the next record in the active bank
+     */
+    uint16_t WritePos;
+    /*!
+     * Offset of the first record following the last snapshot
+     */
+    uint16_t SnapshotEnd;
+    /*!
+     * Set while blocks are waiting to be flushed
+     */
+    bool IsPending;
+    /*!
+     * Time of the first write since the last flush
+     */
+    TimerTime_t PendingTime;
+    NvmmJournalBlock_t* Blocks[NVMM_JOURNAL_MAX_BLOCKS];
+    uint8_t NbBlocks;
+    NvmmJournalStats_t Stats;
+}NvmmJournalCtx_t;
+
+static NvmmJournalCtx_t Ctx;
+
+static uint16_t Crc16( uint16_t crc, const uint8_t* data, uint16_t size )
+{
+    for( uint16_t i = 0; i < size; i++ )
+    {
+        crc ^= ( uint16_t )data[i] << 8;
+        for( uint8_t j = 0; j < 8; j++ )
+        {
+            crc = ( crc & 0x8000 ) ? ( ( crc << 1 ) ^ 0x1021 ) : ( crc << 1 );
+        }
+    }
+    return crc;
+}
+
+static void PutUint32( uint8_t* buffer, uint32_t value )
+{
+    buffer[0] = value & 0xFF;
+    buffer[1] = ( value >> 8 ) & 0xFF;
+    buffer[2] = ( value >> 16 ) & 0xFF;
+    buffer[3] = ( value >> 24 ) & 0xFF;
+}
+
+static uint32_t GetUint32( const uint8_t* buffer )
+{
+    return ( uint32_t )buffer[0] | ( ( uint32_t )buffer[1] << 8 ) |
+           ( ( uint32_t )buffer[2] << 16 ) | ( ( uint32_t )buffer[3] << 24 );
+}
+
+static uint16_t BankAddr( uint8_t bank )
+{
+    return Ctx.Addr + ( bank * Ctx.BankSize );
+}
+
+static uint16_t RecordCrc( uint32_t seq, const uint8_t* record, uint16_t size )
+{
+    uint8_t seqBuffer[4];
+
+    PutUint32( seqBuffer, seq );
+    return Crc16( Crc16( 0xFFFF, seqBuffer, sizeof( seqBuffer ) ), record, size );
+}
+
+/*!
+ * \brief Returns the bank space taken by a snapshot of a block
+ */
+static uint32_t SnapshotSize( uint16_t size )
+{
+    return size + ( ( ( uint32_t )size + RECORD_MAX_DATA - 1 ) / RECORD_MAX_DATA ) * RECORD_OVERHEAD;
+}
+
+static bool WriteEeprom( uint16_t addr, uint8_t* data, uint16_t size )
+{
+    Ctx.Stats.BytesWritten += size;
+    return EepromWriteBuffer( addr, data, size ) == SUCCESS;
+}
+
+static NvmmJournalBlock_t* FindBlock( uint8_t id )
+{
+    for( uint8_t i = 0; i < Ctx.NbBlocks; i++ )
+    {
+        if( Ctx.Blocks[i]->Id == id )
+        {
+            return Ctx.Blocks[i];
+        }
+    }
+    return NULL;
+}
+
+static bool WriteBankHeader( uint8_t bank, uint32_t seq )
+{
+    uint8_t header[BANK_HEADER_SIZE];
+    uint16_t crc;
+
+    PutUint32( &header[0], NVMM_JOURNAL_MAGIC );
+    PutUint32( &header[4], seq );
+    crc = Crc16( 0xFFFF, header, 8 );
+    header[8] = crc & 0xFF;
+    header[9] = ( crc >> 8 ) & 0xFF;
+    return WriteEeprom( BankAddr( bank ), header, sizeof( header ) );
+}
+
+static bool ReadBankHeader( uint8_t bank, uint32_t* seq )
+{
+    uint8_t header[BANK_HEADER_SIZE];
+
+    if( EepromReadBuffer( BankAddr( bank ), header, sizeof( header ) ) != SUCCESS )
+    {
+        return false;
+    }
+    if( ( GetUint32( &header[0] ) != NVMM_JOURNAL_MAGIC ) ||
+        ( Crc16( 0xFFFF, header, 8 ) != ( header[8] | ( header[9] << 8 ) ) ) )
+    {
+        return false;
+    }
+    *seq = GetUint32( &header[4] );
+    return true;
+}
+
+/*!
+ * \brief Appends one record. The record is written with a single EEPROM write.
+ *
+ * \retval status false if the record does not fit in the bank or the write failed
+ */
+static bool AppendRecord( uint8_t bank, uint32_t seq, uint16_t* pos, uint8_t id,
+                          uint16_t offset, const uint8_t* data, uint8_t size )
+{
+    uint8_t record[RECORD_OVERHEAD + RECORD_MAX_DATA];
+    uint16_t recordSize = RECORD_OVERHEAD + size;
+    uint16_t crc;
+
+    if( ( *pos + recordSize ) > Ctx.BankSize )
+    {
+        return false;
+    }
+    record[0] = id;
+    record[1] = size;
+    record[2] = offset & 0xFF;
+    record[3] = ( offset >> 8 ) & 0xFF;
+    memcpy1( &record[RECORD_HEADER_SIZE], data, size );
+    crc = RecordCrc( seq, record, RECORD_HEADER_SIZE + size );
+    record[RECORD_HEADER_SIZE + size] = crc & 0xFF;
+    record[RECORD_HEADER_SIZE + size + 1] = ( crc >> 8 ) & 0xFF;
+
+    if( WriteEeprom( BankAddr( bank ) + *pos, record, recordSize ) == false )
+    {
+        return false;
+    }
+    *pos += recordSize;
+    Ctx.Stats.Records++;
+    return true;
+}
+
+/*!
+ * \brief Appends the whole block. The chunks are written from the end of the
+ *        block, the record at offset 0 marks the block as stored on recovery.
+ */
+static bool AppendSnapshot( uint8_t bank, uint32_t seq, uint16_t* pos, uint8_t id,
+                            const uint8_t* data, uint16_t size )
+{
+    uint16_t end = size;
+
+    while( end > 0 )
+    {
+        uint16_t start = ( end > RECORD_MAX_DATA ) ? ( end - RECORD_MAX_DATA ) : 0;
+
+        if( AppendRecord( bank, seq, pos, id, start, &data[start], end - start ) == false )
+        {
+            return false;
+        }
+        end = start;
+    }
+    return true;
+}
+
+/*!
+ * \brief Appends the changes of one block to the active bank and updates its
+ *        copy with every appended record.
+ */
+static NvmmJournalStatus_t FlushBlock( NvmmJournalBlock_t* block )
+{
+    const uint8_t* data = block->Pending;
+    uint16_t i = 0;
+
+    if( block->Stored == false )
+    {
+        if( AppendSnapshot( Ctx.ActiveBank, Ctx.Seq, &Ctx.WritePos, block->Id, data, block->Size ) == false )
+        {
+            return NVMM_JOURNAL_ERROR_FULL;
+        }
+        memcpy1( block->Shadow, data, block->Size );
+        block->Stored = true;
+        block->Pending = NULL;
+        return NVMM_JOURNAL_SUCCESS;
+    }
+
+    while( i < block->Size )
+    {
+        uint16_t start;
+        uint16_t end;
+
+        if( data[i] == block->Shadow[i] )
+        {
+            i++;
+            continue;
+        }
+
+        // Extend the range over unchanged gaps shorter than a record overhead
+        start = i;
+        end = i + 1;
+        for( uint16_t j = i + 1; ( j < block->Size ) && ( ( j - start ) < RECORD_MAX_DATA ); j++ )
+        {
+            if( data[j] != block->Shadow[j] )
+            {
+                end = j + 1;
+            }
+            else if( ( j - end ) >= RECORD_OVERHEAD )
+            {
+                break;
+            }
+        }
+
+        if( AppendRecord( Ctx.ActiveBank, Ctx.Seq, &Ctx.WritePos, block->Id, start, &data[start], end - start ) == false )
+        {
+            return NVMM_JOURNAL_ERROR_FULL;
+        }
+        memcpy1( &block->Shadow[start], &data[start], end - start );
+        i = end;
+    }
+    block->Pending = NULL;
+    return NVMM_JOURNAL_SUCCESS;
+}
+
+/*!
+ * \brief Writes a snapshot of the stored blocks to the inactive bank and
+ *        makes it the active bank
+ */
+static NvmmJournalStatus_t Compact( void )
+{
+    uint8_t bank = Ctx.ActiveBank ^ 1;
+    uint32_t seq = Ctx.Seq + 1;
+    uint16_t pos = BANK_HEADER_SIZE;
+
+    for( uint8_t i = 0; i < Ctx.NbBlocks; i++ )
+    {
+        NvmmJournalBlock_t* block = Ctx.Blocks[i];
+
+        if( ( block->Stored == true ) &&
+            ( AppendSnapshot( bank, seq, &pos, block->Id, block->Shadow, block->Size ) == false ) )
+        {
+            return NVMM_JOURNAL_ERROR_FULL;
+        }
+    }
+
+    // The header is written last, the previous bank stays valid until then
+    if( WriteBankHeader( bank, seq ) == false )
+    {
+        return NVMM_JOURNAL_ERROR;
+    }
+    Ctx.ActiveBank = bank;
+    Ctx.Seq = seq;
+    Ctx.WritePos = pos;
+    Ctx.SnapshotEnd = pos;
+    Ctx.Stats.Compactions++;
+    return NVMM_JOURNAL_SUCCESS;
+}
+
+/*!
+ * \brief Replays the records of a bank into the block copies
+ */
+static void Replay( uint8_t bank, uint32_t seq )
+{
+    uint8_t record[RECORD_OVERHEAD + RECORD_MAX_DATA];
+    uint16_t pos = BANK_HEADER_SIZE;
+
+    while( ( pos + RECORD_OVERHEAD ) <= Ctx.BankSize )
+    {
+        NvmmJournalBlock_t* block;
+        uint16_t offset;
+        uint16_t crc;
+        uint8_t size;
+
+        if( EepromReadBuffer( BankAddr( bank ) + pos, record, RECORD_HEADER_SIZE ) != SUCCESS )
+        {
+            break;
+        }
+        size = record[1];
+        if( ( record[0] == BLOCK_ID_NONE ) || ( ( pos + RECORD_OVERHEAD + size ) > Ctx.BankSize ) )
+        {
+            break;
+        }
+        if( EepromReadBuffer( BankAddr( bank ) + pos + RECORD_HEADER_SIZE, &record[RECORD_HEADER_SIZE],
+                              size + RECORD_CRC_SIZE ) != SUCCESS )
+        {
+            break;
+        }
+        crc = record[RECORD_HEADER_SIZE + size] | ( record[RECORD_HEADER_SIZE + size + 1] << 8 );
+        if( RecordCrc( seq, record, RECORD_HEADER_SIZE + size ) != crc )
+        {
+            // End of the journal or torn write
+            break;
+        }
+
+        offset = record[2] | ( record[3] << 8 );
+        block = FindBlock( record[0] );
+        if( ( block != NULL ) && ( ( offset + size ) <= block->Size ) )
+        {
+            memcpy1( &block->Shadow[offset], &record[RECORD_HEADER_SIZE], size );
+            if( offset == 0 )
+            {
+                block->Stored = true;
+            }
+        }
+        pos += RECORD_OVERHEAD + size;
+    }
+    Ctx.WritePos = pos;
+}
+
+/*
+ * API functions
+ */
+
+NvmmJournalStatus_t NvmmJournalInit( uint16_t addr, uint16_t size )
+{
+    if( ( size / 2 ) < ( BANK_HEADER_SIZE + RECORD_OVERHEAD ) )
+    {
+        return NVMM_JOURNAL_ERROR_SIZE;
+    }
+    memset1( ( uint8_t* )&Ctx, 0, sizeof( Ctx ) );
+    Ctx.Addr = addr;
+    Ctx.BankSize = size / 2;
+    return NVMM_JOURNAL_SUCCESS;
+}
+
+NvmmJournalStatus_t NvmmJournalDeclare( NvmmJournalBlock_t* block, uint8_t id, uint8_t* shadow, uint16_t size,
+                                        bool writeThrough )
+{
+    uint32_t snapshots = SnapshotSize( size );
+    uint32_t largest = SnapshotSize( size );
+
+    if( ( block == NULL ) || ( shadow == NULL ) )
+    {
+        return NVMM_JOURNAL_ERROR_NPE;
+    }
+    if( ( id == BLOCK_ID_NONE ) || ( FindBlock( id ) != NULL ) || ( Ctx.NbBlocks >= NVMM_JOURNAL_MAX_BLOCKS ) )
+    {
+        return NVMM_JOURNAL_ERROR;
+    }
+    // A compaction must leave room for the changes of any one block,
+    // otherwise a flush could compact over and over without ever fitting
+    for( uint8_t i = 0; i < Ctx.NbBlocks; i++ )
+    {
+        snapshots += SnapshotSize( Ctx.Blocks[i]->Size );
+        largest = MAX( largest, SnapshotSize( Ctx.Blocks[i]->Size ) );
+    }
+    if( ( BANK_HEADER_SIZE + snapshots + largest ) > Ctx.BankSize )
+    {
+        return NVMM_JOURNAL_ERROR_SIZE;
+    }
+    block->Shadow = shadow;
+    block->Size = size;
+    block->Id = id;
+    block->Stored = false;
+    block->WriteThrough = writeThrough;
+    block->Pending = NULL;
+    memset1( shadow, 0, size );
+    Ctx.Blocks[Ctx.NbBlocks++] = block;
+    return NVMM_JOURNAL_SUCCESS;
+}
+
+NvmmJournalStatus_t NvmmJournalRecover( void )
+{
+    uint32_t seq[2];
+    bool valid[2];
+
+    valid[0] = ReadBankHeader( 0, &seq[0] );
+    valid[1] = ReadBankHeader( 1, &seq[1] );
+
+    if( ( valid[0] == false ) && ( valid[1] == false ) )
+    {
+        // First boot, format the first bank
+        Ctx.ActiveBank = 0;
+        Ctx.Seq = 1;
+        Ctx.WritePos = BANK_HEADER_SIZE;
+        Ctx.SnapshotEnd = BANK_HEADER_SIZE;
+        return ( WriteBankHeader( 0, Ctx.Seq ) == true ) ? NVMM_JOURNAL_SUCCESS : NVMM_JOURNAL_ERROR;
+    }
+
+    if( ( valid[0] == true ) && ( ( valid[1] == false ) || ( ( int32_t )( seq[0] - seq[1] ) > 0 ) ) )
+    {
+        Ctx.ActiveBank = 0;
+    }
+    else
+    {
+        Ctx.ActiveBank = 1;
+    }
+    Ctx.Seq = seq[Ctx.ActiveBank];
+    Replay( Ctx.ActiveBank, Ctx.Seq );
+    Ctx.SnapshotEnd = Ctx.WritePos;
+    return NVMM_JOURNAL_SUCCESS;
+}
+
+NvmmJournalStatus_t NvmmJournalRead( NvmmJournalBlock_t* block, void* dst, uint16_t size )
+{
+    if( ( block == NULL ) || ( dst == NULL ) )
+    {
+        return NVMM_JOURNAL_ERROR_NPE;
+    }
+    if( size > block->Size )
+    {
+        return NVMM_JOURNAL_ERROR_SIZE;
+    }
+    if( block->Stored == false )
+    {
+        return NVMM_JOURNAL_EMPTY;
+    }
+    memcpy1( ( uint8_t* )dst, block->Shadow, size );
+    return NVMM_JOURNAL_SUCCESS;
+}
+
+NvmmJournalStatus_t NvmmJournalWrite( NvmmJournalBlock_t* block, const void* src, uint16_t size )
+{
+    if( ( block == NULL ) || ( src == NULL ) )
+    {
+        return NVMM_JOURNAL_ERROR_NPE;
+    }
+    if( size != block->Size )
+    {
+        return NVMM_JOURNAL_ERROR_SIZE;
+    }
+    block->Pending = ( const uint8_t* )src;
+    if( Ctx.IsPending == false )
+    {
+        Ctx.IsPending = true;
+        Ctx.PendingTime = TimerGetCurrentTime( );
+    }
+    if( block->WriteThrough == true )
+    {
+        return NvmmJournalFlush( );
+    }
+    return NVMM_JOURNAL_SUCCESS;
+}
+
+NvmmJournalStatus_t NvmmJournalFlush( void )
+{
+    NvmmJournalStatus_t status = NVMM_JOURNAL_SUCCESS;
+    uint32_t records = Ctx.Stats.Records;
+
+    CRITICAL_SECTION_BEGIN( );
+    for( uint8_t i = 0; ( i < Ctx.NbBlocks ) && ( status == NVMM_JOURNAL_SUCCESS ); i++ )
+    {
+        NvmmJournalBlock_t* block = Ctx.Blocks[i];
+
+        if( block->Pending == NULL )
+        {
+            continue;
+        }
+        status = FlushBlock( block );
+        // A bank holding nothing but the last snapshot would not get any
+        // emptier by compacting again
+        if( ( status == NVMM_JOURNAL_ERROR_FULL ) && ( Ctx.WritePos > Ctx.SnapshotEnd ) )
+        {
+            // The records appended so far are in the copies, the snapshot
+            // carries them over and the rest of the block goes after it
+            status = Compact( );
+            if( status == NVMM_JOURNAL_SUCCESS )
+            {
+                status = FlushBlock( block );
+            }
+        }
+    }
+    if( status == NVMM_JOURNAL_SUCCESS )
+    {
+        Ctx.IsPending = false;
+    }
+    if( Ctx.Stats.Records != records )
+    {
+        Ctx.Stats.Flushes++;
+    }
+    CRITICAL_SECTION_END( );
+    return status;
+}
+
+NvmmJournalStatus_t NvmmJournalProcess( void )
+{
+    NvmmJournalStatus_t status = NVMM_JOURNAL_SUCCESS;
+
+    // TimerGetElapsedTime returns 0 for a write at time 0
+    if( ( Ctx.IsPending == true ) && ( ( TimerGetCurrentTime( ) - Ctx.PendingTime ) >= NVMM_JOURNAL_COALESCE_WINDOW ) )
+    {
+        status = NvmmJournalFlush( );
+    }
+    // Compact ahead of time so that flushes rarely have to
+    if( ( status == NVMM_JOURNAL_SUCCESS ) && ( Ctx.WritePos > Ctx.SnapshotEnd ) &&
+        ( ( ( uint32_t )Ctx.WritePos * 100 ) >= ( ( uint32_t )Ctx.BankSize * NVMM_JOURNAL_COMPACT_THRESHOLD ) ) )
+    {
+        CRITICAL_SECTION_BEGIN( );
+        status = Compact( );
+        CRITICAL_SECTION_END( );
+    }
+    return status;
+}
+
+void NvmmJournalGetStats( NvmmJournalStats_t* stats )
+{
+    *stats = Ctx.Stats;
+}
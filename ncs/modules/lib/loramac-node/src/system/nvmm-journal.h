@@ -0,0 +1,243 @@
+/*!
+ * \file      nvmm-journal.h
+ *
+ * \brief     Journaled none volatile memory management module
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2020 Semtech
+ *
+ * \endcode
+ *
+ * The journal keeps a RAM copy of every declared data block as it is stored
+ * in the EEPROM. Writing a block only marks it as changed. When the block is
+ * flushed the journal compares the block with its copy and appends the
+ * changed byte ranges as log records. A frame counter increment therefore
+ * costs one short record instead of a rewrite of the whole context.
+ *
+ * The EEPROM area is split in two banks. The records are appended to the
+ * active bank, which spreads the writes over the whole bank. When the active
+ * bank fills up, the journal compacts: it writes a snapshot of all blocks to
+ * the other bank and then commits the bank header with a higher sequence
+ * number. On boot the bank with the highest valid sequence number is replayed
+ * until the first record with a bad CRC, so a power loss during an append or
+ * a compaction loses at most the changes that were not flushed yet.
+ *
+ * Writes are coalesced during NVMM_JOURNAL_COALESCE_WINDOW. Changes in the
+ * window are lost on a reset, call NvmmJournalFlush before entering a state
+ * the device may not wake up from. Blocks declared as write through are
+ * flushed by every NvmmJournalWrite instead: declare the blocks holding frame
+ * counters that way, a counter restored to an older value would reuse frame
+ * counters after a reset.
+ */
+#ifndef __NVMM_JOURNAL_H__
+#define __NVMM_JOURNAL_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*!
+ * Maximum number of data blocks
+ */
+#define NVMM_JOURNAL_MAX_BLOCKS                     8
+
+/*!
+ * Time in milliseconds during which writes are coalesced before
+ * NvmmJournalProcess flushes them
+ */
+#ifndef NVMM_JOURNAL_COALESCE_WINDOW
+#define NVMM_JOURNAL_COALESCE_WINDOW                5000
+#endif
+
+/*!
+ * NvmmJournalProcess compacts once the active bank is filled above this
+ * percentage
+ */
+#ifndef NVMM_JOURNAL_COMPACT_THRESHOLD
+#define NVMM_JOURNAL_COMPACT_THRESHOLD              75
+#endif
+
+/*!
+ * Journal Status
+ */
+typedef enum eNvmmJournalStatus
+{
+    /*!
+     * No error occurred
+     */
+    NVMM_JOURNAL_SUCCESS = 0,
+    /*!
+     * The data block has never been stored
+     */
+    NVMM_JOURNAL_EMPTY,
+    /*!
+     * Size does not fit
+     */
+    NVMM_JOURNAL_ERROR_SIZE,
+    /*!
+     * Null pointer exception
+     */
+    NVMM_JOURNAL_ERROR_NPE,
+    /*!
+     * The pending changes do not fit in a bank
+     */
+    NVMM_JOURNAL_ERROR_FULL,
+    /*!
+     * Undefined Error occurred
+     */
+    NVMM_JOURNAL_ERROR,
+}NvmmJournalStatus_t;
+
+/*!
+ * Journal data block handle
+ */
+typedef struct sNvmmJournalBlock
+{
+    /*!
+     * Copy of the block as stored in the EEPROM
+     */
+    uint8_t* Shadow;
+    /*!
+     * Block size
+     */
+    uint16_t Size;
+    /*!
+     * Block identifier, stored in the records
+     */
+    uint8_t Id;
+    /*!
+     * Set once the block is stored
+     */
+    bool Stored;
+    /*!
+     * Flushed by NvmmJournalWrite instead of after the coalesce window
+     */
+    bool WriteThrough;
+    /*!
+     * Data to be flushed, NULL if the block did not change
+     */
+    const uint8_t* Pending;
+}NvmmJournalBlock_t;
+
+/*!
+ * Journal statistics
+ */
+typedef struct sNvmmJournalStats
+{
+    /*!
+     * Bytes written to the EEPROM
+     */
+    uint32_t BytesWritten;
+    /*!
+     * Records appended, snapshots included
+     */
+    uint32_t Records;
+    /*!
+     * Flushes which wrote at least one record
+     */
+    uint32_t Flushes;
+    /*!
+     * Compactions
+     */
+    uint32_t Compactions;
+}NvmmJournalStats_t;
+
+/*!
+ * \brief Initializes the journal
+ *
+ * \param [IN] addr EEPROM address of the journal area
+ * \param [IN] size Size of the journal area, holds two banks
+ *
+ * \retval status Status of the operation
+ */
+NvmmJournalStatus_t NvmmJournalInit( uint16_t addr, uint16_t size );
+
+/*!
+ * \brief Declares a data block. All blocks must be declared before
+ *        NvmmJournalRecover is called.
+ *
+ * \param [IN] block        Data block handle
+ * \param [IN] id           Block identifier, unique and lower than 0xFF
+ * \param [IN] shadow       Memory for the copy of the block, size bytes
+ * \param [IN] size         Block size
+ * \param [IN] writeThrough Flush the block on every write, for blocks
+ *                          holding frame counters
+ *
+ * \retval status NVMM_JOURNAL_ERROR_SIZE if a bank cannot hold a snapshot of
+ *                all declared blocks followed by a rewrite of the largest one
+ */
+NvmmJournalStatus_t NvmmJournalDeclare( NvmmJournalBlock_t* block, uint8_t id, uint8_t* shadow, uint16_t size,
+                                        bool writeThrough );
+
+/*!
+ * \brief Restores the declared blocks from the EEPROM. Formats the journal
+ *        area if it holds no valid bank.
+ *
+ * \retval status Status of the operation
+ */
+NvmmJournalStatus_t NvmmJournalRecover( void );
+
+/*!
+ * \brief Reads a data block as stored in the EEPROM
+ *
+ * \param [IN]  block Data block handle
+ * \param [OUT] dst   Destination
+ * \param [IN]  size  Number of bytes to read
+ *
+ * \retval status NVMM_JOURNAL_EMPTY if the block has never been stored
+ */
+NvmmJournalStatus_t NvmmJournalRead( NvmmJournalBlock_t* block, void* dst, uint16_t size );
+
+/*!
+ * \brief Marks a data block as changed. The data is read when the journal
+ *        is flushed, src must stay valid until then. Flushes the journal if
+ *        the block is write through.
+ *
+ * \param [IN] block Data block handle
+ * \param [IN] src   Current block data
+ * \param [IN] size  Size of the data, must be the block size
+ *
+ * \retval status Status of the operation
+ */
+NvmmJournalStatus_t NvmmJournalWrite( NvmmJournalBlock_t* block, const void* src, uint16_t size );
+
+/*!
+ * \brief Appends the changes of all written blocks to the EEPROM
+ *
+ * \retval status Status of the operation
+ */
+NvmmJournalStatus_t NvmmJournalFlush( void );
+
+/*!
+ * \brief Flushes the written blocks once the coalesce window has elapsed and
+ *        compacts the journal once the active bank is above the threshold.
+ *        To be called from the application main loop.
+ *
+ * \retval status Status of the operation
+ */
+NvmmJournalStatus_t NvmmJournalProcess( void );
+
+/*!
+ * \brief Returns the journal statistics
+ *
+ * \param [OUT] stats Statistics
+ */
+void NvmmJournalGetStats( NvmmJournalStats_t* stats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NVMM_JOURNAL_H__
@@ -178,6 +178,7 @@ LOCAL_SRC_FILES                                          := \
     src/core/coap/coap_message.cpp                          \
     src/core/coap/coap_secure.cpp                           \
     src/core/common/crc16.cpp                               \
+    src/core/common/deferred_log.cpp                        \
     src/core/common/instance.cpp                            \
     src/core/common/logging.cpp                             \
     src/core/common/message.cpp                             \
@@ -252,6 +253,7 @@ LOCAL_SRC_FILES                                          := \
     src/core/thread/mle_router.cpp                          \
     src/core/thread/mle_types.cpp                           \
     src/core/thread/network_data.cpp                        \
+    src/core/thread/network_data_change_set.cpp             \
     src/core/thread/network_data_leader.cpp                 \
     src/core/thread/network_data_leader_ftd.cpp             \
     src/core/thread/network_data_local.cpp                  \
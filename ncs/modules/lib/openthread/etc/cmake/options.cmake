@@ -146,6 +146,11 @@ if(OT_LINK_RAW)
     list(APPEND OT_PRIVATE_DEFINES "OPENTHREAD_CONFIG_LINK_RAW_ENABLE=1")
 endif()
 
+option(OT_LOG_DEFERRED "enable deferred (binary) log mode")
+if(OT_LOG_DEFERRED)
+    list(APPEND OT_PRIVATE_DEFINES "OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE=1")
+endif()
+
 option(OT_LOG_LEVEL_DYNAMIC "enable dynamic log level control")
 if(OT_LOG_LEVEL_DYNAMIC)
     list(APPEND OT_PRIVATE_DEFINES "OPENTHREAD_CONFIG_LOG_LEVEL_DYNAMIC_ENABLE=1")
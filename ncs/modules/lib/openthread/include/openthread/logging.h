@@ -76,6 +76,32 @@ otLogLevel otLoggingGetLevel(void);
  */
 otError otLoggingSetLevel(otLogLevel aLogLevel);
 
+/**
+ * This function reads (and removes) pending records from the deferred (binary) log buffer.
+ *
+ * Only complete records are copied. The records are decoded on a host with `tools/log-decoder/ot_log_decoder.py`
+ * using the string table from the `ot_log_fmt` section of the firmware image.
+ *
+ * @note This function requires `OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE=1`.
+ *
+ * @param[out] aBuffer   A pointer to a buffer to copy the records into.
+ * @param[in]  aLength   The size of @p aBuffer in bytes.
+ *
+ * @returns The number of bytes copied into @p aBuffer.
+ *
+ */
+uint16_t otLoggingDeferredRead(uint8_t *aBuffer, uint16_t aLength);
+
+/**
+ * This function returns the number of deferred log records dropped because the log buffer was full.
+ *
+ * @note This function requires `OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE=1`.
+ *
+ * @returns The number of dropped records.
+ *
+ */
+uint32_t otLoggingDeferredGetDroppedCount(void);
+
 /**
  * @}
  *
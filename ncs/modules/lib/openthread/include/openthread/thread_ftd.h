@@ -691,6 +691,46 @@ typedef void (*otNeighborTableCallback)(otNeighborTableEvent aEvent, const otNei
  */
 void otThreadRegisterNeighborTableCallback(otInstance *aInstance, otNeighborTableCallback aCallback);
 
+/**
+ * This structure represents the counters of the queue of Route TLVs received in MLE Advertisements.
+ *
+ */
+typedef struct otMleRouteUpdateCounters
+{
+    /**
+     * Number of Route TLVs from received MLE Advertisements queued for a route table update.
+     *
+     */
+    uint16_t mQueued;
+
+    /**
+     * Number of queued Route TLVs replaced by a newer Route TLV from the same router before being applied.
+     *
+     * Each of them is a route table update that was avoided.
+     *
+     */
+    uint16_t mCoalesced;
+
+    /**
+     * Number of times queued Route TLVs were applied to the route table.
+     *
+     */
+    uint16_t mTableUpdates;
+} otMleRouteUpdateCounters;
+
+/**
+ * This function gets the counters of the queue of Route TLVs received in MLE Advertisements.
+ *
+ * The counters remain zero when the queue is disabled (`OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE` is 0). They
+ * are reset by `otThreadResetMleCounters()`.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ *
+ * @returns A pointer to the route update counters.
+ *
+ */
+const otMleRouteUpdateCounters *otThreadGetMleRouteUpdateCounters(otInstance *aInstance);
+
 /**
  * @}
  *
@@ -1155,6 +1155,16 @@ void Interpreter::ProcessCounters(uint8_t aArgsLength, char *aArgs[])
             mServer->OutputFormat("Better Partition Attach Attempts: %d\r\n",
                                   mleCounters->mBetterPartitionAttachAttempts);
             mServer->OutputFormat("Parent Changes: %d\r\n", mleCounters->mParentChanges);
+
+#if OPENTHREAD_FTD
+            {
+                const otMleRouteUpdateCounters *routeUpdateCounters = otThreadGetMleRouteUpdateCounters(mInstance);
+
+                mServer->OutputFormat("Route Updates Queued: %d\r\n", routeUpdateCounters->mQueued);
+                mServer->OutputFormat("Route Updates Coalesced: %d\r\n", routeUpdateCounters->mCoalesced);
+                mServer->OutputFormat("Route Table Updates: %d\r\n", routeUpdateCounters->mTableUpdates);
+            }
+#endif
         }
         else if ((aArgsLength == 2) && (strcmp(aArgs[0], "reset") == 0))
         {
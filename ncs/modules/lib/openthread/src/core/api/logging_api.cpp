@@ -34,6 +34,7 @@
 #include "openthread-core-config.h"
 
 #include <openthread/logging.h>
+#include "common/deferred_log.hpp"
 #include "common/instance.hpp"
 #include "common/locator-getters.hpp"
 
@@ -65,3 +66,15 @@ otError otLoggingSetLevel(otLogLevel aLogLevel)
     return error;
 }
 #endif
+
+#if OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE
+uint16_t otLoggingDeferredRead(uint8_t *aBuffer, uint16_t aLength)
+{
+    return DeferredLog::Get().Read(aBuffer, aLength);
+}
+
+uint32_t otLoggingDeferredGetDroppedCount(void)
+{
+    return DeferredLog::Get().GetDroppedCount();
+}
+#endif
@@ -460,6 +460,9 @@ void otThreadResetMleCounters(otInstance *aInstance)
     Instance &instance = *static_cast<Instance *>(aInstance);
 
     instance.Get<Mle::MleRouter>().ResetCounters();
+#if OPENTHREAD_FTD
+    instance.Get<Mle::MleRouter>().ResetRouteUpdateCounters();
+#endif
 }
 
 void otThreadRegisterParentResponseCallback(otInstance *                   aInstance,
@@ -377,4 +377,11 @@ void otThreadRegisterNeighborTableCallback(otInstance *aInstance, otNeighborTabl
     instance.Get<Mle::MleRouter>().RegisterNeighborTableChangedCallback(aCallback);
 }
 
+const otMleRouteUpdateCounters *otThreadGetMleRouteUpdateCounters(otInstance *aInstance)
+{
+    Instance &instance = *static_cast<Instance *>(aInstance);
+
+    return &instance.Get<Mle::MleRouter>().GetRouteUpdateCounters();
+}
+
 #endif // OPENTHREAD_FTD
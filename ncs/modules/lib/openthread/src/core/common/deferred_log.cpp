@@ -0,0 +1,377 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the deferred (binary) log buffer.
+ */
+
+#include "deferred_log.hpp"
+
+#include <string.h>
+
+#include <openthread/platform/alarm-milli.h>
+
+#include "common/encoding.hpp"
+
+using ot::Encoding::LittleEndian::WriteUint16;
+using ot::Encoding::LittleEndian::WriteUint32;
+
+/*
+ * The linker defines `__start_<section>` for every output section whose name is a valid C identifier. It is declared
+ * weak so that images without any deferred log statement still link.
+ */
+extern "C" const char __start_ot_log_fmt[] __attribute__((weak));
+
+namespace ot {
+
+#if OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE
+static DeferredLog sDeferredLog;
+
+DeferredLog &DeferredLog::Get(void)
+{
+    return sDeferredLog;
+}
+#endif
+
+void DeferredLog::Reset(void)
+{
+    mHead         = 0;
+    mTail         = 0;
+    mDroppedCount = 0;
+}
+
+uint32_t DeferredLog::GetFormatId(const char *aFormat)
+{
+    uintptr_t start = reinterpret_cast<uintptr_t>(__start_ot_log_fmt);
+
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(aFormat) - start);
+}
+
+void DeferredLog::Log(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat, va_list aArgs)
+{
+    uint8_t record[kMaxRecordSize];
+    Writer  writer(record + kHeaderSize, kMaxRecordSize - kHeaderSize);
+
+    EncodeArgs(writer, aFormat, aArgs);
+    Commit(record, writer, kTypeLog, aLogLevel, aLogRegion, GetFormatId(aFormat));
+}
+
+void DeferredLog::Dump(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aId, const void *aBuf, size_t aLength)
+{
+    uint8_t record[kMaxRecordSize];
+    Writer  writer(record + kHeaderSize, kMaxRecordSize - kHeaderSize);
+    uint8_t length[sizeof(uint16_t)];
+
+    WriteUint16(static_cast<uint16_t>(aLength), length);
+    writer.AppendBytes(length, sizeof(length));
+    writer.AppendString(aId);
+    writer.AppendBytes(aBuf, aLength);
+    Commit(record, writer, kTypeDump, aLogLevel, aLogRegion, 0);
+}
+
+void DeferredLog::Commit(uint8_t *     aRecord,
+                         const Writer &aWriter,
+                         RecordType    aType,
+                         otLogLevel    aLogLevel,
+                         otLogRegion   aLogRegion,
+                         uint32_t      aFormatId)
+{
+    uint16_t length = static_cast<uint16_t>(aWriter.GetCur() - aRecord);
+    uint32_t tail   = mTail;
+    uint32_t offset = tail & (kBufferSize - 1);
+    uint8_t  flags  = static_cast<uint8_t>((aType << kFlagsTypeShift) | (aLogLevel & kFlagsLevelMask));
+
+    if (aWriter.IsTruncated())
+    {
+        flags |= kFlagTruncated;
+    }
+
+    aRecord[0] = flags;
+    aRecord[1] = static_cast<uint8_t>(aLogRegion);
+    WriteUint16(length - kHeaderSize, &aRecord[2]);
+    WriteUint32(otPlatAlarmMilliGetNow(), &aRecord[4]);
+    WriteUint32(aFormatId, &aRecord[8]);
+
+    if (kBufferSize - (tail - mHead) < length)
+    {
+        mDroppedCount++;
+        return;
+    }
+
+    if (offset + length <= kBufferSize)
+    {
+        memcpy(&mBuffer[offset], aRecord, length);
+    }
+    else
+    {
+        uint16_t first = static_cast<uint16_t>(kBufferSize - offset);
+
+        memcpy(&mBuffer[offset], aRecord, first);
+        memcpy(&mBuffer[0], aRecord + first, length - first);
+    }
+
+    // Publish the record only after its bytes are in place.
+    __sync_synchronize();
+    mTail = tail + length;
+}
+
+uint16_t DeferredLog::Read(uint8_t *aBuffer, uint16_t aLength)
+{
+    uint32_t tail = mTail;
+    uint32_t head = mHead;
+    uint16_t read = 0;
+
+    __sync_synchronize();
+
+    while (tail - head >= kHeaderSize)
+    {
+        uint8_t  lengthBytes[sizeof(uint16_t)];
+        uint16_t length;
+
+        lengthBytes[0] = mBuffer[(head + 2) & (kBufferSize - 1)];
+        lengthBytes[1] = mBuffer[(head + 3) & (kBufferSize - 1)];
+        length         = kHeaderSize + Encoding::LittleEndian::ReadUint16(lengthBytes);
+
+        if (aLength - read < length)
+        {
+            break;
+        }
+
+        for (uint16_t i = 0; i < length; i++)
+        {
+            aBuffer[read++] = mBuffer[(head + i) & (kBufferSize - 1)];
+        }
+
+        head += length;
+    }
+
+    // Release the space only after the record bytes have been copied out.
+    __sync_synchronize();
+    mHead = head;
+
+    return read;
+}
+
+void DeferredLog::EncodeArgs(Writer &aWriter, const char *aFormat, va_list aArgs)
+{
+    for (const char *cur = aFormat; *cur != '\0'; cur++)
+    {
+        LengthModifier length = kLengthNone;
+
+        if (*cur != '%')
+        {
+            continue;
+        }
+
+        cur++;
+
+        if (*cur == '%')
+        {
+            continue;
+        }
+
+        while (*cur != '\0' && strchr("-+ #0", *cur) != NULL)
+        {
+            cur++;
+        }
+
+        // Width and precision given as `*` are passed as `int` arguments.
+        while ((*cur >= '0' && *cur <= '9') || *cur == '.' || *cur == '*')
+        {
+            if (*cur == '*')
+            {
+                aWriter.AppendUint32(static_cast<uint32_t>(va_arg(aArgs, int)));
+            }
+
+            cur++;
+        }
+
+        switch (*cur)
+        {
+        case 'h':
+            cur += (cur[1] == 'h') ? 2 : 1;
+            break;
+
+        case 'l':
+            length = (cur[1] == 'l') ? kLengthLongLong : kLengthLong;
+            cur += (cur[1] == 'l') ? 2 : 1;
+            break;
+
+        case 'j':
+            length = kLengthIntMax;
+            cur++;
+            break;
+
+        case 'z':
+            length = kLengthSize;
+            cur++;
+            break;
+
+        case 't':
+            length = kLengthPtrDiff;
+            cur++;
+            break;
+
+        case 'L':
+            length = kLengthLongDouble;
+            cur++;
+            break;
+
+        default:
+            break;
+        }
+
+        switch (*cur)
+        {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+            switch (length)
+            {
+            case kLengthLong:
+                aWriter.AppendUint64(static_cast<uint64_t>(va_arg(aArgs, long)));
+                break;
+
+            case kLengthLongLong:
+                aWriter.AppendUint64(static_cast<uint64_t>(va_arg(aArgs, int64_t)));
+                break;
+
+            case kLengthIntMax:
+                aWriter.AppendUint64(static_cast<uint64_t>(va_arg(aArgs, intmax_t)));
+                break;
+
+            case kLengthSize:
+                aWriter.AppendUint64(static_cast<uint64_t>(va_arg(aArgs, size_t)));
+                break;
+
+            case kLengthPtrDiff:
+                aWriter.AppendUint64(static_cast<uint64_t>(va_arg(aArgs, ptrdiff_t)));
+                break;
+
+            default:
+                aWriter.AppendUint32(static_cast<uint32_t>(va_arg(aArgs, int)));
+                break;
+            }
+
+            break;
+
+        case 'c':
+            aWriter.AppendUint32(static_cast<uint32_t>(va_arg(aArgs, int)));
+            break;
+
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+        {
+            double   value = (length == kLengthLongDouble) ? static_cast<double>(va_arg(aArgs, long double))
+                                                          : va_arg(aArgs, double);
+            uint64_t bits;
+
+            memcpy(&bits, &value, sizeof(bits));
+            aWriter.AppendUint64(bits);
+            break;
+        }
+
+        case 'p':
+            aWriter.AppendUint64(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(va_arg(aArgs, void *))));
+            break;
+
+        case 's':
+            aWriter.AppendString(va_arg(aArgs, const char *));
+            break;
+
+        case '\0':
+            return;
+
+        default:
+            // Unsupported conversion (e.g. `%n`), no argument is consumed.
+            break;
+        }
+    }
+}
+
+void DeferredLog::Writer::AppendUint32(uint32_t aValue)
+{
+    uint8_t buf[sizeof(uint32_t)];
+
+    WriteUint32(aValue, buf);
+    AppendBytes(buf, sizeof(buf));
+}
+
+void DeferredLog::Writer::AppendUint64(uint64_t aValue)
+{
+    AppendUint32(static_cast<uint32_t>(aValue));
+    AppendUint32(static_cast<uint32_t>(aValue >> 32));
+}
+
+void DeferredLog::Writer::AppendBytes(const void *aBuf, size_t aLength)
+{
+    size_t length = aLength;
+
+    if (length > static_cast<size_t>(mEnd - mCur))
+    {
+        length     = static_cast<size_t>(mEnd - mCur);
+        mTruncated = true;
+    }
+
+    memcpy(mCur, aBuf, length);
+    mCur += length;
+}
+
+void DeferredLog::Writer::AppendString(const char *aString)
+{
+    const char *string = (aString != NULL) ? aString : "(null)";
+    size_t      length = strlen(string);
+
+    if (mCur == mEnd)
+    {
+        mTruncated = true;
+        return;
+    }
+
+    if (length >= static_cast<size_t>(mEnd - mCur))
+    {
+        length     = static_cast<size_t>(mEnd - mCur) - 1;
+        mTruncated = true;
+    }
+
+    memcpy(mCur, string, length);
+    mCur += length;
+    *mCur++ = '\0';
+}
+
+} // namespace ot
@@ -0,0 +1,227 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the deferred (binary) log buffer.
+ */
+
+#ifndef DEFERRED_LOG_HPP_
+#define DEFERRED_LOG_HPP_
+
+#include "openthread-core-config.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <openthread/platform/logging.h>
+
+#include "utils/static_assert.hpp"
+
+namespace ot {
+
+/**
+ * This class implements a deferred (binary) log buffer.
+ *
+ * Instead of formatting a log line at the call site, the format string is identified by its offset within the
+ * `ot_log_fmt` linker section (the build-time string table) and the raw arguments are appended to a lock-free
+ * single-producer/single-consumer ring buffer. The records are later drained with `Read()` and rendered on a host
+ * by `tools/log-decoder/ot_log_decoder.py`.
+ *
+ * Each record starts with a `kHeaderSize` bytes header (all multi-byte fields little-endian):
+ *
+ *   | Offset | Size | Field                                                                 |
+ *   |--------|------|-----------------------------------------------------------------------|
+ *   | 0      | 1    | Flags: bits 0-2 log level, bit 3 truncated, bits 4-7 record type      |
+ *   | 1      | 1    | Log region                                                            |
+ *   | 2      | 2    | Payload length (excluding the header)                                 |
+ *   | 4      | 4    | Timestamp in milliseconds                                             |
+ *   | 8      | 4    | Format string identifier (offset in the string table), zero for dumps |
+ *
+ * A `kTypeLog` payload holds the arguments in format string order: integers of `int` size (and `%c`, `*` width
+ * and precision) as 4 bytes, `l`/`ll`/`j`/`z`/`t` integers and `%p` as 8 bytes, floating point values as 8 bytes
+ * IEEE-754 doubles and `%s` strings as NUL-terminated copies.
+ *
+ * A `kTypeDump` payload holds the original dump length (2 bytes), the NUL-terminated dump identifier and the dumped
+ * bytes.
+ *
+ */
+class DeferredLog
+{
+public:
+    enum
+    {
+        kHeaderSize    = 12,                                             ///< Size of a record header.
+        kBufferSize    = OPENTHREAD_CONFIG_LOG_DEFERRED_BUFFER_SIZE,     ///< Size of the ring buffer.
+        kMaxRecordSize = OPENTHREAD_CONFIG_LOG_DEFERRED_MAX_RECORD_SIZE, ///< Maximum size of a record.
+    };
+
+    /**
+     * This enumeration defines the record types.
+     *
+     */
+    enum RecordType
+    {
+        kTypeLog  = 0, ///< A log line (format identifier and arguments).
+        kTypeDump = 1, ///< A memory dump.
+    };
+
+    enum
+    {
+        kFlagsLevelMask = 0x07, ///< Log level bits in the flags field.
+        kFlagTruncated  = 0x08, ///< The payload was truncated to fit `kMaxRecordSize`.
+        kFlagsTypeShift = 4,    ///< Shift of the record type in the flags field.
+    };
+
+    /**
+     * This static method returns the deferred log buffer used by the OpenThread log macros.
+     *
+     * @note This method requires `OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE`.
+     *
+     * @returns A reference to the deferred log buffer.
+     *
+     */
+    static DeferredLog &Get(void);
+
+    /**
+     * This method resets the ring buffer, discarding all pending records and the dropped records counter.
+     *
+     */
+    void Reset(void);
+
+    /**
+     * This method appends a log record to the ring buffer.
+     *
+     * @param[in]  aLogLevel   The log level.
+     * @param[in]  aLogRegion  The log region.
+     * @param[in]  aFormat     A pointer to the format string (located in the `ot_log_fmt` section).
+     * @param[in]  aArgs       Arguments for the format specification.
+     *
+     */
+    void Log(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat, va_list aArgs);
+
+    /**
+     * This method appends a memory dump record to the ring buffer.
+     *
+     * @param[in]  aLogLevel   The log level.
+     * @param[in]  aLogRegion  The log region.
+     * @param[in]  aId         A pointer to a NULL-terminated string that identifies the dump.
+     * @param[in]  aBuf        A pointer to the buffer.
+     * @param[in]  aLength     Number of bytes in the buffer.
+     *
+     */
+    void Dump(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aId, const void *aBuf, size_t aLength);
+
+    /**
+     * This method reads (and removes) as many complete records as fit in a given buffer.
+     *
+     * This method may be called from a different context than the one adding records (e.g. a UART drain task), as
+     * long as there is a single reader.
+     *
+     * @param[out] aBuffer  A pointer to the output buffer.
+     * @param[in]  aLength  The size of @p aBuffer in bytes.
+     *
+     * @returns The number of bytes written to @p aBuffer.
+     *
+     */
+    uint16_t Read(uint8_t *aBuffer, uint16_t aLength);
+
+    /**
+     * This method returns the number of records dropped because the ring buffer was full.
+     *
+     * @returns The number of dropped records.
+     *
+     */
+    uint32_t GetDroppedCount(void) const { return mDroppedCount; }
+
+    /**
+     * This static method returns the identifier of a format string placed in the `ot_log_fmt` section.
+     *
+     * @param[in]  aFormat  A pointer to the format string.
+     *
+     * @returns The offset of @p aFormat within the string table.
+     *
+     */
+    static uint32_t GetFormatId(const char *aFormat);
+
+private:
+    OT_STATIC_ASSERT((kBufferSize & (kBufferSize - 1)) == 0, "deferred log buffer size must be a power of two");
+    OT_STATIC_ASSERT(kMaxRecordSize > kHeaderSize && kMaxRecordSize <= kBufferSize, "invalid deferred record size");
+
+    enum LengthModifier
+    {
+        kLengthNone,
+        kLengthLong,
+        kLengthLongLong,
+        kLengthIntMax,
+        kLengthSize,
+        kLengthPtrDiff,
+        kLengthLongDouble,
+    };
+
+    class Writer
+    {
+    public:
+        Writer(uint8_t *aBuffer, uint16_t aLength)
+            : mCur(aBuffer)
+            , mEnd(aBuffer + aLength)
+            , mTruncated(false)
+        {
+        }
+
+        void     AppendUint32(uint32_t aValue);
+        void     AppendUint64(uint64_t aValue);
+        void     AppendBytes(const void *aBuf, size_t aLength);
+        void     AppendString(const char *aString);
+        uint8_t *GetCur(void) const { return mCur; }
+        bool     IsTruncated(void) const { return mTruncated; }
+
+    private:
+        uint8_t *mCur;
+        uint8_t *mEnd;
+        bool     mTruncated;
+    };
+
+    static void EncodeArgs(Writer &aWriter, const char *aFormat, va_list aArgs);
+    void        Commit(uint8_t *     aRecord,
+                       const Writer &aWriter,
+                       RecordType    aType,
+                       otLogLevel    aLogLevel,
+                       otLogRegion   aLogRegion,
+                       uint32_t      aFormatId);
+
+    uint8_t           mBuffer[kBufferSize];
+    volatile uint32_t mHead; // Read index (free running), only updated by the reader.
+    volatile uint32_t mTail; // Write index (free running), only updated by the writer.
+    uint32_t          mDroppedCount;
+};
+
+} // namespace ot
+
+#endif // DEFERRED_LOG_HPP_
@@ -33,6 +33,7 @@
 
 #include "logging.hpp"
 
+#include "common/deferred_log.hpp"
 #include "common/instance.hpp"
 
 /*
@@ -50,7 +51,34 @@
 extern "C" {
 #endif
 
-#if OPENTHREAD_CONFIG_LOG_PKT_DUMP == 1
+#if OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE
+void otLogDeferred(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat, ...)
+{
+    va_list args;
+
+    va_start(args, aFormat);
+    ot::DeferredLog::Get().Log(aLogLevel, aLogRegion, aFormat, args);
+    va_end(args);
+}
+
+void otDumpDeferred(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aId, const void *aBuf, size_t aLength)
+{
+    ot::DeferredLog::Get().Dump(aLogLevel, aLogRegion, aId, aBuf, aLength);
+}
+#endif // OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE
+
+#if OPENTHREAD_CONFIG_LOG_PKT_DUMP == 1 && OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE
+void otDump(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aId, const void *aBuf, const size_t aLength)
+{
+    // The dump is recorded as raw bytes, the host decoder renders the hex dump lines.
+#if OPENTHREAD_CONFIG_LOG_LEVEL_DYNAMIC_ENABLE
+    if (otLoggingGetLevel() >= aLogLevel)
+#endif
+    {
+        otDumpDeferred(aLogLevel, aLogRegion, aId, aBuf, aLength);
+    }
+}
+#elif OPENTHREAD_CONFIG_LOG_PKT_DUMP == 1
 /**
  * This static method outputs a line of the memory dump.
  *
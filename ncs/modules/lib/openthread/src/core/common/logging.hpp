@@ -1912,6 +1912,49 @@ const char *otLogLevelToPrefixString(otLogLevel aLogLevel);
 
 #endif // OPENTHREAD_CONFIG_LOG_LEVEL_DYNAMIC_ENABLE
 
+#if OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE
+
+#if !defined(__GNUC__) || !defined(__ELF__)
+#error "OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE requires a GCC-compatible toolchain producing ELF images"
+#endif
+
+/**
+ * This function queues a log record in the deferred (binary) log buffer.
+ *
+ * @param[in]  aLogLevel   The log level.
+ * @param[in]  aLogRegion  The log region.
+ * @param[in]  aFormat     A pointer to the format string, located in the `ot_log_fmt` section.
+ * @param[in]  ...         Arguments for the format specification.
+ *
+ */
+void otLogDeferred(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat, ...);
+
+/**
+ * This function queues a memory dump record in the deferred (binary) log buffer.
+ *
+ * @param[in]  aLogLevel   The log level.
+ * @param[in]  aLogRegion  The log region.
+ * @param[in]  aId         A pointer to a NULL-terminated string that identifies the dump.
+ * @param[in]  aBuf        A pointer to the buffer.
+ * @param[in]  aLength     Number of bytes in the buffer.
+ *
+ */
+void otDumpDeferred(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aId, const void *aBuf, size_t aLength);
+
+/**
+ * In deferred log mode the format string literal is moved to the `ot_log_fmt` section (the build-time string table
+ * used by the host decoder) and only its identifier and the raw arguments are recorded.
+ *
+ */
+#define _otPlatLog(aLogLevel, aRegion, aFormat, ...)                                       \
+    do                                                                                     \
+    {                                                                                      \
+        static const char _otLogFormat[] __attribute__((section("ot_log_fmt"))) = aFormat; \
+        otLogDeferred(aLogLevel, aRegion, _otLogFormat, __VA_ARGS__);                      \
+    } while (false)
+
+#else // OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE
+
 /**
  * `OPENTHREAD_CONFIG_PLAT_LOG_FUNCTION` is a configuration parameter (see `config/logging.h`) which specifies the
  * function/macro to be used for logging in OpenThread. By default it is set to `otPlatLog()`.
@@ -1919,6 +1962,8 @@ const char *otLogLevelToPrefixString(otLogLevel aLogLevel);
  */
 #define _otPlatLog(aLogLevel, aRegion, ...) OPENTHREAD_CONFIG_PLAT_LOG_FUNCTION(aLogLevel, aRegion, __VA_ARGS__)
 
+#endif // OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE
+
 #ifdef __cplusplus
 }
 #endif
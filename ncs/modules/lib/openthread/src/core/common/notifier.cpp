@@ -37,6 +37,7 @@
 #include "common/debug.hpp"
 #include "common/locator-getters.hpp"
 #include "common/logging.hpp"
+#include "thread/network_data_leader.hpp"
 
 namespace ot {
 
@@ -150,6 +151,11 @@ void Notifier::HandleStateChanged(void)
 
     LogChangedFlags(flags);
 
+    if (flags & OT_CHANGED_THREAD_NETDATA)
+    {
+        Get<NetworkData::Leader>().UpdateChangeSet();
+    }
+
     for (Callback *callback = mCallbacks.GetHead(); callback != NULL; callback = callback->GetNext())
     {
         callback->Invoke(flags);
@@ -309,6 +309,44 @@
 #define OPENTHREAD_CONFIG_LOG_SRC_DST_IP_ADDRESSES 1
 #endif
 
+/**
+ * @def OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE
+ *
+ * Define as 1 to enable the deferred (binary) log mode.
+ *
+ * In this mode log statements do not format their arguments. The format string is placed in the `ot_log_fmt` linker
+ * section and only its identifier and the raw arguments are queued in a ring buffer, drained using
+ * `otLoggingDeferredRead()` and decoded on a host with `tools/log-decoder/ot_log_decoder.py`.
+ *
+ * This mode requires a GCC-compatible toolchain producing ELF images. Custom linker scripts must keep the
+ * `ot_log_fmt` section.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE
+#define OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE 0
+#endif
+
+/**
+ * @def OPENTHREAD_CONFIG_LOG_DEFERRED_BUFFER_SIZE
+ *
+ * The size (in bytes) of the deferred log ring buffer. Must be a power of two.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_LOG_DEFERRED_BUFFER_SIZE
+#define OPENTHREAD_CONFIG_LOG_DEFERRED_BUFFER_SIZE 1024
+#endif
+
+/**
+ * @def OPENTHREAD_CONFIG_LOG_DEFERRED_MAX_RECORD_SIZE
+ *
+ * The maximum size (in bytes) of a single deferred log record, including its 12 bytes header. Longer records (e.g.
+ * large memory dumps) are truncated.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_LOG_DEFERRED_MAX_RECORD_SIZE
+#define OPENTHREAD_CONFIG_LOG_DEFERRED_MAX_RECORD_SIZE 160
+#endif
+
 /**
  * @def OPENTHREAD_CONFIG_PLAT_LOG_FUNCTION
  *
@@ -240,4 +240,22 @@
 #define OPENTHREAD_CONFIG_MLE_INFORM_PREVIOUS_PARENT_ON_REATTACH 0
 #endif
 
+/**
+ * @def OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE
+ *
+ * The maximum number of Route TLVs from received MLE Advertisements which are queued and applied to the route table
+ * together from a tasklet.
+ *
+ * A Route TLV replaces a queued Route TLV from the same router, and all queued Route TLVs are applied in a single pass
+ * over the route table. The queue is cleared on role and partition changes. When the queue is full, the queued Route
+ * TLVs are applied immediately. Each entry uses
+ * about 75 bytes of RAM.
+ *
+ * Define as 0 to apply every Route TLV as soon as the MLE Advertisement is received.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE
+#define OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE 4
+#endif
+
 #endif // CONFIG_MLE_H_
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes compile-time configurations for Network Data.
+ *
+ */
+
+#ifndef CONFIG_NETWORK_DATA_H_
+#define CONFIG_NETWORK_DATA_H_
+
+/**
+ * @def OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE
+ *
+ * Define as 1 to track which Network Data entries (on-mesh prefixes, external routes, contexts, services and
+ * commissioning data) changed between two Network Data versions.
+ *
+ * When enabled, `OT_CHANGED_THREAD_NETDATA` consumers only process the entry types which actually changed. When
+ * disabled, every type is always reported as changed.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE
+#define OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE 1
+#endif
+
+/**
+ * @def OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_MAX_ENTRIES
+ *
+ * The maximum number of Network Data entries tracked by the change set. Each entry uses 4 bytes of RAM. If the
+ * Network Data contains more entries, every type is reported as changed.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_MAX_ENTRIES
+#define OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_MAX_ENTRIES 64
+#endif
+
+#endif // CONFIG_NETWORK_DATA_H_
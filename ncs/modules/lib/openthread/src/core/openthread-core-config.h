@@ -71,6 +71,7 @@
 #include "config/logging.h"
 #include "config/mac.h"
 #include "config/mle.h"
+#include "config/network_data.h"
 #include "config/parent_search.h"
 #include "config/platform.h"
 #include "config/sntp_client.h"
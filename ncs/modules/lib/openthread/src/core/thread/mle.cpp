@@ -1597,20 +1597,45 @@ void Mle::HandleStateChanged(otChangedFlags aFlags)
                 ScheduleMessageTransmissionTimer();
             }
         }
+    }
+
+    if ((aFlags & (OT_CHANGED_THREAD_NETDATA | OT_CHANGED_THREAD_ROLE)) != 0)
+    {
+        // A role change may have reset the state derived from the Network Data (e.g. the Backbone Router state on
+        // detach), which is then updated whatever the change set says.
+        const NetworkData::ChangeSet &changeSet   = Get<NetworkData::Leader>().GetChangeSet();
+        bool                          roleChanged = (aFlags & OT_CHANGED_THREAD_ROLE) != 0;
+
+        OT_UNUSED_VARIABLE(changeSet);
+        OT_UNUSED_VARIABLE(roleChanged);
 
 #if (OPENTHREAD_CONFIG_THREAD_VERSION >= OT_THREAD_VERSION_1_2)
-        Get<BackboneRouter::Leader>().Update();
+        if (roleChanged || changeSet.HasChanged(NetworkData::ChangeSet::kService) ||
+            changeSet.HasChanged(NetworkData::ChangeSet::kOnMeshPrefix))
+        {
+            Get<BackboneRouter::Leader>().Update();
+        }
 #endif
 #if OPENTHREAD_CONFIG_TMF_NETDATA_SERVICE_ENABLE
-        this->UpdateServiceAlocs();
+        if (roleChanged || changeSet.HasChanged(NetworkData::ChangeSet::kService))
+        {
+            this->UpdateServiceAlocs();
+        }
 #endif
 
 #if OPENTHREAD_CONFIG_DHCP6_SERVER_ENABLE
-        Get<Dhcp6::Dhcp6Server>().UpdateService();
+        if (roleChanged || changeSet.HasChanged(NetworkData::ChangeSet::kOnMeshPrefix) ||
+            changeSet.HasChanged(NetworkData::ChangeSet::kContext))
+        {
+            Get<Dhcp6::Dhcp6Server>().UpdateService();
+        }
 #endif // OPENTHREAD_CONFIG_DHCP6_SERVER_ENABLE
 
 #if OPENTHREAD_CONFIG_DHCP6_CLIENT_ENABLE
-        Get<Dhcp6::Dhcp6Client>().UpdateAddresses();
+        if (roleChanged || changeSet.HasChanged(NetworkData::ChangeSet::kOnMeshPrefix))
+        {
+            Get<Dhcp6::Dhcp6Client>().UpdateAddresses();
+        }
 #endif // OPENTHREAD_CONFIG_DHCP6_CLIENT_ENABLE
     }
 
@@ -60,6 +60,10 @@ MleRouter::MleRouter(Instance &aInstance)
     : Mle(aInstance)
     , mAdvertiseTimer(aInstance, &MleRouter::HandleAdvertiseTimer, NULL, this)
     , mStateUpdateTimer(aInstance, &MleRouter::HandleStateUpdateTimer, this)
+#if OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+    , mRouteUpdates()
+    , mRouteUpdateTask(aInstance, &MleRouter::HandleRouteUpdateTask, this)
+#endif
     , mAddressSolicit(OT_URI_PATH_ADDRESS_SOLICIT, &MleRouter::HandleAddressSolicit, this)
     , mAddressRelease(OT_URI_PATH_ADDRESS_RELEASE, &MleRouter::HandleAddressRelease, this)
     , mChildTable(aInstance)
@@ -103,6 +107,7 @@ void MleRouter::HandlePartitionChange(void)
     Get<AddressResolver>().Clear();
     Get<Coap::Coap>().AbortTransaction(&MleRouter::HandleAddressSolicitResponse, this);
     mRouterTable.Clear();
+    ClearRouteUpdates();
 }
 
 bool MleRouter::IsRouterEligible(void) const
@@ -227,6 +232,7 @@ void MleRouter::HandleDetachStart(void)
     mRouterTable.ClearNeighbors();
     StopLeader();
     mStateUpdateTimer.Stop();
+    ClearRouteUpdates();
 }
 
 otError MleRouter::HandleChildStart(AttachMode aMode)
@@ -239,6 +245,7 @@ otError MleRouter::HandleChildStart(AttachMode aMode)
     mRouterSelectionJitterTimeout = 1 + Random::NonCrypto::GetUint8InRange(0, mRouterSelectionJitter);
 
     StopLeader();
+    ClearRouteUpdates();
     mStateUpdateTimer.Start(kStateUpdatePeriod);
 
     if (mRouterEligible)
@@ -313,6 +320,7 @@ exit:
 void MleRouter::SetStateRouter(uint16_t aRloc16)
 {
     SetRloc16(aRloc16);
+    ClearRouteUpdates();
 
     SetRole(kRoleRouter);
     SetAttachState(kAttachStateIdle);
@@ -342,6 +350,7 @@ void MleRouter::SetStateRouter(uint16_t aRloc16)
 void MleRouter::SetStateLeader(uint16_t aRloc16)
 {
     SetRloc16(aRloc16);
+    ClearRouteUpdates();
 
     SetRole(kRoleLeader);
     SetAttachState(kAttachStateIdle);
@@ -965,7 +974,11 @@ otError MleRouter::HandleLinkAccept(const Message &         aMessage,
         {
             VerifyOrExit(route.IsValid(), error = OT_ERROR_PARSE);
             SuccessOrExit(error = ProcessRouteTlv(route));
-            UpdateRoutes(route, routerId);
+
+            if (UpdateRoutes(route, routerId))
+            {
+                LogRouteTable();
+            }
         }
 
         // update routing table
@@ -1080,6 +1093,11 @@ otError MleRouter::ProcessRouteTlv(const RouteTlv &aRoute)
 {
     otError error = OT_ERROR_NONE;
 
+#if OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+    // Queued Route TLVs were validated against the current Router ID Set, apply them before it changes.
+    ProcessRouteUpdates();
+#endif
+
     mRouterTable.UpdateRouterIdSet(aRoute.GetRouterIdSequence(), aRoute.GetRouterIdMask());
 
     if (IsRouter() && !mRouterTable.IsAllocated(mRouterId))
@@ -1419,7 +1437,14 @@ otError MleRouter::HandleAdvertisement(const Message &         aMessage,
         break;
     }
 
-    UpdateRoutes(route, routerId);
+#if OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+    QueueRouteUpdate(route, routerId);
+#else
+    if (UpdateRoutes(route, routerId))
+    {
+        LogRouteTable();
+    }
+#endif
 
 exit:
     if (aNeighbor && aNeighbor->GetRloc16() != sourceAddress)
@@ -1431,7 +1456,163 @@ exit:
     return error;
 }
 
-void MleRouter::UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId)
+void MleRouter::ClearRouteUpdates(void)
+{
+#if OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+    // Queued Route TLVs refer to Router IDs of the previous role or partition.
+    mRouteUpdates.Clear();
+#endif
+}
+
+const otMleRouteUpdateCounters &MleRouter::GetRouteUpdateCounters(void) const
+{
+#if OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+    return mRouteUpdates.GetCounters();
+#else
+    static const otMleRouteUpdateCounters kNoCounters = {0, 0, 0};
+
+    return kNoCounters;
+#endif
+}
+
+void MleRouter::ResetRouteUpdateCounters(void)
+{
+#if OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+    mRouteUpdates.ResetCounters();
+#endif
+}
+
+#if OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+RouteUpdateQueue::RouteUpdateQueue(void)
+    : mLength(0)
+{
+    ResetCounters();
+}
+
+otError RouteUpdateQueue::Add(const RouteTlv &aRoute, uint8_t aRouterId)
+{
+    otError error = OT_ERROR_NONE;
+    Entry * entry = NULL;
+
+    for (uint8_t i = 0; i < mLength; i++)
+    {
+        if (mEntries[i].mRouterId == aRouterId)
+        {
+            // The newer Route TLV from the same router supersedes the queued one.
+            entry = &mEntries[i];
+            mCounters.mCoalesced++;
+            break;
+        }
+    }
+
+    if (entry == NULL)
+    {
+        VerifyOrExit(mLength < OT_ARRAY_LENGTH(mEntries), error = OT_ERROR_NO_BUFS);
+
+        entry            = &mEntries[mLength++];
+        entry->mRouterId = aRouterId;
+    }
+
+    memcpy(&entry->mRoute, &aRoute, sizeof(RouteTlv));
+    mCounters.mQueued++;
+
+exit:
+    return error;
+}
+
+void RouteUpdateQueue::MarkApplied(void)
+{
+    mCounters.mTableUpdates++;
+    mLength = 0;
+}
+
+void MleRouter::QueueRouteUpdate(const RouteTlv &aRoute, uint8_t aRouterId)
+{
+    if (mRouteUpdates.Add(aRoute, aRouterId) == OT_ERROR_NO_BUFS)
+    {
+        // Applying the queued Route TLVs empties the queue.
+        ProcessRouteUpdates();
+        mRouteUpdates.Add(aRoute, aRouterId);
+    }
+
+    mRouteUpdateTask.Post();
+}
+
+void MleRouter::HandleRouteUpdateTask(Tasklet &aTasklet)
+{
+    aTasklet.GetOwner<MleRouter>().ProcessRouteUpdates();
+}
+
+void MleRouter::ProcessRouteUpdates(void)
+{
+    Router *neighbors[OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE];
+    uint8_t routeCounts[OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE];
+    bool    resetAdvInterval = false;
+    bool    changed          = false;
+
+    VerifyOrExit(mRouteUpdates.GetLength() > 0, OT_NOOP);
+
+    // The queue is cleared on role and partition changes, this only guards against a stale tasklet.
+    VerifyOrExit(IsRouterOrLeader(), mRouteUpdates.Clear());
+
+    // update link quality out to each neighbor first, so all route costs are compared with current link costs
+    for (uint8_t i = 0; i < mRouteUpdates.GetLength(); i++)
+    {
+        const RouteUpdateQueue::Entry &update = mRouteUpdates.GetEntry(i);
+
+        neighbors[i]   = mRouterTable.GetRouter(update.mRouterId);
+        routeCounts[i] = 0;
+
+        if (neighbors[i] != NULL && UpdateLinkQualityOut(update.mRoute, *neighbors[i], resetAdvInterval))
+        {
+            changed = true;
+        }
+    }
+
+    // update routes in a single pass over the route table
+    for (uint8_t routerId = 0; routerId <= kMaxRouterId; routerId++)
+    {
+        Router *router = mRouterTable.GetRouter(routerId);
+
+        for (uint8_t i = 0; i < mRouteUpdates.GetLength(); i++)
+        {
+            const RouteUpdateQueue::Entry &update = mRouteUpdates.GetEntry(i);
+
+            if (!update.mRoute.IsRouterIdSet(routerId))
+            {
+                continue;
+            }
+
+            if (neighbors[i] != NULL && router != NULL && router->GetRloc16() != GetRloc16() &&
+                router != neighbors[i] &&
+                UpdateRoute(*router, *neighbors[i], update.mRouterId, update.mRoute.GetRouteCost(routeCounts[i]),
+                            resetAdvInterval))
+            {
+                changed = true;
+            }
+
+            routeCounts[i]++;
+        }
+    }
+
+    mRouteUpdates.MarkApplied();
+
+    if (resetAdvInterval)
+    {
+        ResetAdvertiseInterval();
+    }
+
+    if (changed)
+    {
+        LogRouteTable();
+    }
+
+exit:
+    return;
+}
+#endif // OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+
+bool MleRouter::UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId)
 {
     Router *neighbor;
     bool    resetAdvInterval = false;
@@ -1447,9 +1628,6 @@ void MleRouter::UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId)
     for (uint8_t routerId = 0, routeCount = 0; routerId <= kMaxRouterId; routerId++)
     {
         Router *router;
-        Router *nextHop;
-        uint8_t oldNextHop;
-        uint8_t cost;
 
         if (!aRoute.IsRouterIdSet(routerId))
         {
@@ -1458,74 +1636,82 @@ void MleRouter::UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId)
 
         router = mRouterTable.GetRouter(routerId);
 
-        if (router == NULL || router->GetRloc16() == GetRloc16() || router == neighbor)
+        if (router != NULL && router->GetRloc16() != GetRloc16() && router != neighbor &&
+            UpdateRoute(*router, *neighbor, aRouterId, aRoute.GetRouteCost(routeCount), resetAdvInterval))
         {
-            routeCount++;
-            continue;
+            changed = true;
         }
 
-        oldNextHop = router->GetNextHop();
-        nextHop    = mRouterTable.GetRouter(oldNextHop);
+        routeCount++;
+    }
 
-        cost = aRoute.GetRouteCost(routeCount);
+    if (resetAdvInterval)
+    {
+        ResetAdvertiseInterval();
+    }
 
-        if (cost == 0)
-        {
-            cost = kMaxRouteCost;
-        }
+exit:
+    return changed;
+}
 
-        if (nextHop == NULL || nextHop == neighbor)
-        {
-            // route has no next hop or next hop is neighbor (sender)
+bool MleRouter::UpdateRoute(Router &aRouter, Router &aNeighbor, uint8_t aNeighborId, uint8_t aCost,
+                            bool &aResetAdvInterval)
+{
+    bool    changed = false;
+    Router *nextHop = mRouterTable.GetRouter(aRouter.GetNextHop());
 
-            if (cost + mRouterTable.GetLinkCost(*neighbor) < kMaxRouteCost)
-            {
-                if (nextHop == NULL && mRouterTable.GetLinkCost(*router) >= kMaxRouteCost)
-                {
-                    resetAdvInterval = true;
-                }
+    if (aCost == 0)
+    {
+        aCost = kMaxRouteCost;
+    }
 
-                router->SetNextHop(aRouterId);
-                router->SetCost(cost);
-                changed = true;
-            }
-            else if (nextHop == neighbor)
-            {
-                if (mRouterTable.GetLinkCost(*router) >= kMaxRouteCost)
-                {
-                    resetAdvInterval = true;
-                }
+    if (nextHop == NULL || nextHop == &aNeighbor)
+    {
+        // route has no next hop or next hop is neighbor (sender)
 
-                router->SetNextHop(kInvalidRouterId);
-                router->SetCost(0);
-                router->SetLastHeard(TimerMilli::GetNow());
-                changed = true;
+        if (aCost + mRouterTable.GetLinkCost(aNeighbor) < kMaxRouteCost)
+        {
+            if (nextHop == NULL && mRouterTable.GetLinkCost(aRouter) >= kMaxRouteCost)
+            {
+                aResetAdvInterval = true;
             }
+
+            aRouter.SetNextHop(aNeighborId);
+            aRouter.SetCost(aCost);
+            changed = true;
         }
-        else
+        else if (nextHop == &aNeighbor)
         {
-            uint8_t curCost = router->GetCost() + mRouterTable.GetLinkCost(*nextHop);
-            uint8_t newCost = cost + mRouterTable.GetLinkCost(*neighbor);
-
-            if (newCost < curCost)
+            if (mRouterTable.GetLinkCost(aRouter) >= kMaxRouteCost)
             {
-                router->SetNextHop(aRouterId);
-                router->SetCost(cost);
-                changed = true;
+                aResetAdvInterval = true;
             }
-        }
 
-        routeCount++;
+            aRouter.SetNextHop(kInvalidRouterId);
+            aRouter.SetCost(0);
+            aRouter.SetLastHeard(TimerMilli::GetNow());
+            changed = true;
+        }
     }
-
-    if (resetAdvInterval)
+    else
     {
-        ResetAdvertiseInterval();
+        uint8_t curCost = aRouter.GetCost() + mRouterTable.GetLinkCost(*nextHop);
+        uint8_t newCost = aCost + mRouterTable.GetLinkCost(aNeighbor);
+
+        if (newCost < curCost)
+        {
+            aRouter.SetNextHop(aNeighborId);
+            aRouter.SetCost(aCost);
+            changed = true;
+        }
     }
 
-#if (OPENTHREAD_CONFIG_LOG_MLE && (OPENTHREAD_CONFIG_LOG_LEVEL >= OT_LOG_LEVEL_INFO))
+    return changed;
+}
 
-    VerifyOrExit(changed, OT_NOOP);
+void MleRouter::LogRouteTable(void)
+{
+#if (OPENTHREAD_CONFIG_LOG_MLE && (OPENTHREAD_CONFIG_LOG_LEVEL >= OT_LOG_LEVEL_INFO))
     otLogInfoMle("Route table updated");
 
     for (RouterTable::Iterator iter(GetInstance()); !iter.IsDone(); iter++)
@@ -1538,13 +1724,7 @@ void MleRouter::UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId)
                      router.GetLinkQualityOut(),
                      router.GetRloc16() == GetRloc16() ? "device" : (router.IsStateValid() ? "yes" : "no"));
     }
-
-#else
-    OT_UNUSED_VARIABLE(changed);
 #endif
-
-exit:
-    return;
 }
 
 bool MleRouter::UpdateLinkQualityOut(const RouteTlv &aRoute, Router &aNeighbor, bool &aResetAdvInterval)
@@ -40,6 +40,7 @@
 
 #include "coap/coap.hpp"
 #include "coap/coap_message.hpp"
+#include "common/tasklet.hpp"
 #include "common/timer.hpp"
 #include "common/trickle_timer.hpp"
 #include "mac/mac_types.hpp"
@@ -67,6 +68,93 @@ namespace Mle {
 
 #if OPENTHREAD_FTD
 
+#if OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+/**
+ * This class implements the queue of Route TLVs received in MLE Advertisements and not yet applied to the route table.
+ *
+ */
+class RouteUpdateQueue
+{
+public:
+    /**
+     * This structure represents a queued Route TLV.
+     *
+     */
+    struct Entry
+    {
+        RouteTlv mRoute;    ///< The Route TLV.
+        uint8_t  mRouterId; ///< The Router ID of the router that sent the Route TLV.
+    };
+
+    /**
+     * This constructor initializes the queue.
+     *
+     */
+    RouteUpdateQueue(void);
+
+    /**
+     * This method queues a Route TLV, replacing the Route TLV already queued from the same router.
+     *
+     * @param[in]  aRoute     A reference to the Route TLV.
+     * @param[in]  aRouterId  The Router ID of the router that sent the Route TLV.
+     *
+     * @retval OT_ERROR_NONE     Successfully queued the Route TLV.
+     * @retval OT_ERROR_NO_BUFS  The queue is full and holds no Route TLV from @p aRouterId.
+     *
+     */
+    otError Add(const RouteTlv &aRoute, uint8_t aRouterId);
+
+    /**
+     * This method returns the number of queued Route TLVs.
+     *
+     * @returns The number of queued Route TLVs.
+     *
+     */
+    uint8_t GetLength(void) const { return mLength; }
+
+    /**
+     * This method returns a queued Route TLV.
+     *
+     * @param[in]  aIndex  The index of the entry, less than `GetLength()`.
+     *
+     * @returns A reference to the entry.
+     *
+     */
+    const Entry &GetEntry(uint8_t aIndex) const { return mEntries[aIndex]; }
+
+    /**
+     * This method drops all queued Route TLVs without applying them.
+     *
+     */
+    void Clear(void) { mLength = 0; }
+
+    /**
+     * This method empties the queue after its Route TLVs were applied to the route table.
+     *
+     */
+    void MarkApplied(void);
+
+    /**
+     * This method returns the route update counters.
+     *
+     * @returns A reference to the route update counters.
+     *
+     */
+    const otMleRouteUpdateCounters &GetCounters(void) const { return mCounters; }
+
+    /**
+     * This method resets the route update counters.
+     *
+     */
+    void ResetCounters(void) { memset(&mCounters, 0, sizeof(mCounters)); }
+
+private:
+    Entry                    mEntries[OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE];
+    uint8_t                  mLength;
+    otMleRouteUpdateCounters mCounters;
+};
+#endif // OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+
 /**
  * This class implements MLE functionality required by the Thread Router and Leader roles.
  *
@@ -708,6 +796,20 @@ public:
     otError SetMaxChildIpAddresses(uint8_t aMaxIpAddresses);
 #endif
 
+    /**
+     * This method returns the counters of the queue of Route TLVs received in MLE Advertisements.
+     *
+     * @returns A reference to the route update counters.
+     *
+     */
+    const otMleRouteUpdateCounters &GetRouteUpdateCounters(void) const;
+
+    /**
+     * This method resets the counters of the queue of Route TLVs received in MLE Advertisements.
+     *
+     */
+    void ResetRouteUpdateCounters(void);
+
 private:
     enum
     {
@@ -788,8 +890,16 @@ private:
     void    StopLeader(void);
     void    SynchronizeChildNetworkData(void);
     otError UpdateChildAddresses(const Message &aMessage, uint16_t aOffset, Child &aChild);
-    void    UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId);
+    bool    UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId);
+    bool    UpdateRoute(Router &aRouter, Router &aNeighbor, uint8_t aNeighborId, uint8_t aCost, bool &aResetAdvInterval);
     bool    UpdateLinkQualityOut(const RouteTlv &aRoute, Router &aNeighbor, bool &aResetAdvInterval);
+    void    LogRouteTable(void);
+    void    ClearRouteUpdates(void);
+#if OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+    void        QueueRouteUpdate(const RouteTlv &aRoute, uint8_t aRouterId);
+    void        ProcessRouteUpdates(void);
+    static void HandleRouteUpdateTask(Tasklet &aTasklet);
+#endif
 
     static void HandleAddressSolicitResponse(void *               aContext,
                                              otMessage *          aMessage,
@@ -820,6 +930,11 @@ private:
     TrickleTimer mAdvertiseTimer;
     TimerMilli   mStateUpdateTimer;
 
+#if OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+    RouteUpdateQueue mRouteUpdates;
+    Tasklet          mRouteUpdateTask;
+#endif
+
     Coap::Resource mAddressSolicit;
     Coap::Resource mAddressRelease;
 
@@ -0,0 +1,279 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements tracking of changes between Thread Network Data versions.
+ */
+
+#include "network_data_change_set.hpp"
+
+#include <string.h>
+
+#include "common/code_utils.hpp"
+
+namespace ot {
+namespace NetworkData {
+
+#if OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE
+
+ChangeSet::ChangeSet(void)
+    : mNumEntries(0)
+    , mVersion(0)
+    , mOverflow(false)
+    , mAllChanged(false)
+{
+    memset(mAdded, 0, sizeof(mAdded));
+    memset(mRemoved, 0, sizeof(mRemoved));
+}
+
+void ChangeSet::Update(const uint8_t *aTlvs, uint8_t aLength, uint8_t aVersion)
+{
+    uint32_t              digests[kMaxEntries];
+    Collector             collector(digests, kMaxEntries);
+    const NetworkDataTlv *cur = reinterpret_cast<const NetworkDataTlv *>(aTlvs);
+    const NetworkDataTlv *end = reinterpret_cast<const NetworkDataTlv *>(aTlvs + aLength);
+    uint8_t               oldIndex;
+    uint8_t               newIndex;
+    bool                  changed = false;
+
+    while (cur + 1 <= end && cur->GetNext() <= end)
+    {
+        switch (cur->GetType())
+        {
+        case NetworkDataTlv::kTypePrefix:
+            CollectPrefix(*static_cast<const PrefixTlv *>(cur), collector);
+            break;
+
+        case NetworkDataTlv::kTypeService:
+            CollectService(*static_cast<const ServiceTlv *>(cur), collector);
+            break;
+
+        case NetworkDataTlv::kTypeCommissioningData:
+            collector.Add(kCommissioningData, Digest(cur, cur->GetSize(), kFnvOffsetBasis));
+            break;
+
+        default:
+            break;
+        }
+
+        cur = cur->GetNext();
+    }
+
+    memset(mAdded, 0, sizeof(mAdded));
+    memset(mRemoved, 0, sizeof(mRemoved));
+
+    Sort(digests, collector.GetNumEntries());
+
+    // Both digest arrays are sorted, so a single merge pass finds the entries present in only one of them.
+    oldIndex = 0;
+    newIndex = 0;
+
+    while (oldIndex < mNumEntries || newIndex < collector.GetNumEntries())
+    {
+        if (newIndex == collector.GetNumEntries() ||
+            (oldIndex < mNumEntries && mDigests[oldIndex] < digests[newIndex]))
+        {
+            mRemoved[GetEntryType(mDigests[oldIndex++])]++;
+            changed = true;
+        }
+        else if (oldIndex == mNumEntries || digests[newIndex] < mDigests[oldIndex])
+        {
+            mAdded[GetEntryType(digests[newIndex++])]++;
+            changed = true;
+        }
+        else
+        {
+            oldIndex++;
+            newIndex++;
+        }
+    }
+
+    // When either snapshot is incomplete the merge result is unreliable, and when the version changed but no digest
+    // did, a modified entry kept its digest. Every type is then reported as changed.
+    mAllChanged = mOverflow || collector.IsOverflow() || (!changed && aVersion != mVersion);
+    mOverflow   = collector.IsOverflow();
+    mVersion    = aVersion;
+    mNumEntries = collector.GetNumEntries();
+    memcpy(mDigests, digests, mNumEntries * sizeof(uint32_t));
+}
+
+void ChangeSet::CollectPrefix(const PrefixTlv &aPrefix, Collector &aCollector)
+{
+    const NetworkDataTlv *cur = aPrefix.GetSubTlvs();
+    const NetworkDataTlv *end = aPrefix.GetNext();
+    uint32_t              prefixDigest;
+
+    VerifyOrExit(aPrefix.IsValid(), OT_NOOP);
+
+    // The prefix digest covers the Domain ID, the Prefix Length and the Prefix, i.e. everything up to the sub-TLVs.
+    prefixDigest = Digest(aPrefix.GetValue(),
+                          static_cast<uint16_t>(reinterpret_cast<const uint8_t *>(cur) - aPrefix.GetValue()),
+                          kFnvOffsetBasis);
+
+    while (cur + 1 <= end && cur->GetNext() <= end)
+    {
+        uint8_t  stable = cur->IsStable() ? 1 : 0;
+        uint32_t digest = Digest(&stable, sizeof(stable), prefixDigest);
+
+        switch (cur->GetType())
+        {
+        case NetworkDataTlv::kTypeBorderRouter:
+        {
+            const BorderRouterTlv *borderRouter = static_cast<const BorderRouterTlv *>(cur);
+
+            for (uint8_t i = 0; i < borderRouter->GetNumEntries(); i++)
+            {
+                const BorderRouterEntry *entry = borderRouter->GetEntry(i);
+
+                aCollector.Add(kOnMeshPrefix, Digest(entry, sizeof(*entry), digest));
+            }
+
+            break;
+        }
+
+        case NetworkDataTlv::kTypeHasRoute:
+        {
+            const HasRouteTlv *hasRoute = static_cast<const HasRouteTlv *>(cur);
+
+            for (uint8_t i = 0; i < hasRoute->GetNumEntries(); i++)
+            {
+                const HasRouteEntry *entry = hasRoute->GetEntry(i);
+
+                aCollector.Add(kExternalRoute, Digest(entry, sizeof(*entry), digest));
+            }
+
+            break;
+        }
+
+        case NetworkDataTlv::kTypeContext:
+            aCollector.Add(kContext, Digest(cur->GetValue(), cur->GetLength(), digest));
+            break;
+
+        default:
+            break;
+        }
+
+        cur = cur->GetNext();
+    }
+
+exit:
+    return;
+}
+
+void ChangeSet::CollectService(const ServiceTlv &aService, Collector &aCollector)
+{
+    const NetworkDataTlv *cur = aService.GetSubTlvs();
+    const NetworkDataTlv *end = aService.GetNext();
+    uint32_t              serviceDigest;
+
+    VerifyOrExit(cur <= end, OT_NOOP);
+
+    // The service digest covers the Service ID, the Enterprise Number and the Service Data, i.e. everything up to the
+    // sub-TLVs.
+    serviceDigest = Digest(aService.GetValue(),
+                           static_cast<uint16_t>(reinterpret_cast<const uint8_t *>(cur) - aService.GetValue()),
+                           kFnvOffsetBasis);
+
+    while (cur + 1 <= end && cur->GetNext() <= end)
+    {
+        if (cur->GetType() == NetworkDataTlv::kTypeServer)
+        {
+            uint8_t stable = cur->IsStable() ? 1 : 0;
+
+            aCollector.Add(kService, Digest(cur->GetValue(), cur->GetLength(),
+                                            Digest(&stable, sizeof(stable), serviceDigest)));
+        }
+
+        cur = cur->GetNext();
+    }
+
+exit:
+    return;
+}
+
+uint32_t ChangeSet::Digest(const void *aData, uint16_t aLength, uint32_t aDigest)
+{
+    // 32-bit FNV-1a.
+    const uint8_t *data = static_cast<const uint8_t *>(aData);
+
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        aDigest ^= data[i];
+        aDigest *= kFnvPrime;
+    }
+
+    return aDigest;
+}
+
+void ChangeSet::Sort(uint32_t *aDigests, uint8_t aNumEntries)
+{
+    // Insertion sort, the Network Data is small and mostly ordered by the Leader.
+    for (uint8_t i = 1; i < aNumEntries; i++)
+    {
+        uint32_t digest = aDigests[i];
+        uint8_t  j      = i;
+
+        for (; j > 0 && aDigests[j - 1] > digest; j--)
+        {
+            aDigests[j] = aDigests[j - 1];
+        }
+
+        aDigests[j] = digest;
+    }
+}
+
+void ChangeSet::Collector::Add(EntryType aType, uint32_t aDigest)
+{
+    if (mNumEntries < mMaxEntries)
+    {
+        mDigests[mNumEntries++] = (aDigest & ~static_cast<uint32_t>(kTypeMask)) | aType;
+    }
+    else
+    {
+        mOverflow = true;
+    }
+}
+
+#else // OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE
+
+ChangeSet::ChangeSet(void)
+{
+}
+
+void ChangeSet::Update(const uint8_t *aTlvs, uint8_t aLength, uint8_t aVersion)
+{
+    OT_UNUSED_VARIABLE(aTlvs);
+    OT_UNUSED_VARIABLE(aLength);
+    OT_UNUSED_VARIABLE(aVersion);
+}
+
+#endif // OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE
+
+} // namespace NetworkData
+} // namespace ot
@@ -0,0 +1,208 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for tracking changes between Thread Network Data versions.
+ */
+
+#ifndef NETWORK_DATA_CHANGE_SET_HPP_
+#define NETWORK_DATA_CHANGE_SET_HPP_
+
+#include "openthread-core-config.h"
+
+#include <stdint.h>
+
+#include "thread/network_data_tlvs.hpp"
+
+namespace ot {
+namespace NetworkData {
+
+/**
+ * @addtogroup core-netdata-core
+ *
+ * @{
+ *
+ */
+
+/**
+ * This class tracks which Network Data entries were added or removed between two Network Data versions.
+ *
+ * Each leaf entry (a Border Router entry of an on-mesh prefix, a Has Route entry of an external route, a Context TLV,
+ * a Server TLV of a service or the Commissioning Data TLV) is reduced to a 32-bit digest. The digests of the previous
+ * version are kept sorted, so that computing the change set is a single merge over the two digest arrays and no copy
+ * of the previous Network Data is needed.
+ *
+ * A modified entry is reported as one removed and one added entry of the same type. Should the digests of a modified
+ * entry collide, the Network Data version still tells that something changed: a new version that the digests do not
+ * account for is reported as a change of every type.
+ *
+ */
+class ChangeSet
+{
+public:
+    /**
+     * Network Data entry types tracked by the change set.
+     *
+     */
+    enum EntryType
+    {
+        kOnMeshPrefix      = 0, ///< On-mesh prefix (Border Router entry).
+        kExternalRoute     = 1, ///< External route (Has Route entry).
+        kContext           = 2, ///< 6LoWPAN Context.
+        kService           = 3, ///< Service (Server TLV).
+        kCommissioningData = 4, ///< Commissioning Data.
+        kNumEntryTypes     = 5, ///< Number of entry types.
+    };
+
+    /**
+     * This constructor initializes the change set as if the previous Network Data was empty.
+     *
+     */
+    ChangeSet(void);
+
+    /**
+     * This method computes the change set between the previously recorded Network Data and @p aTlvs, and then records
+     * @p aTlvs as the new reference.
+     *
+     * @param[in]  aTlvs     A pointer to the Network Data TLVs.
+     * @param[in]  aLength   The length of the Network Data TLVs in bytes.
+     * @param[in]  aVersion  The Network Data version of @p aTlvs.
+     *
+     */
+    void Update(const uint8_t *aTlvs, uint8_t aLength, uint8_t aVersion);
+
+    /**
+     * This method indicates whether any entry of a given type was added or removed by the last `Update()`.
+     *
+     * When the change set feature is disabled, or the Network Data had more entries than could be tracked, this
+     * method always returns TRUE.
+     *
+     * @param[in]  aType  The entry type.
+     *
+     * @retval TRUE   If an entry of type @p aType changed.
+     * @retval FALSE  If no entry of type @p aType changed.
+     *
+     */
+    bool HasChanged(EntryType aType) const
+    {
+#if OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE
+        return (mAdded[aType] != 0) || (mRemoved[aType] != 0) || mAllChanged;
+#else
+        OT_UNUSED_VARIABLE(aType);
+        return true;
+#endif
+    }
+
+#if OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE
+    /**
+     * This method returns the number of entries of a given type added by the last `Update()`.
+     *
+     * @param[in]  aType  The entry type.
+     *
+     * @returns The number of added entries.
+     *
+     */
+    uint8_t GetAddedCount(EntryType aType) const { return mAdded[aType]; }
+
+    /**
+     * This method returns the number of entries of a given type removed by the last `Update()`.
+     *
+     * @param[in]  aType  The entry type.
+     *
+     * @returns The number of removed entries.
+     *
+     */
+    uint8_t GetRemovedCount(EntryType aType) const { return mRemoved[aType]; }
+
+    /**
+     * This method returns the number of entries recorded by the last `Update()`.
+     *
+     * @returns The number of recorded entries.
+     *
+     */
+    uint8_t GetNumEntries(void) const { return mNumEntries; }
+
+private:
+    enum
+    {
+        kMaxEntries = OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_MAX_ENTRIES,
+        kTypeMask   = 0x7,
+    };
+
+    OT_STATIC_ASSERT(kNumEntryTypes <= kTypeMask + 1, "EntryType does not fit in the digest type bits");
+
+    class Collector
+    {
+    public:
+        Collector(uint32_t *aDigests, uint8_t aMaxEntries)
+            : mDigests(aDigests)
+            , mMaxEntries(aMaxEntries)
+            , mNumEntries(0)
+            , mOverflow(false)
+        {
+        }
+
+        void    Add(EntryType aType, uint32_t aDigest);
+        uint8_t GetNumEntries(void) const { return mNumEntries; }
+        bool    IsOverflow(void) const { return mOverflow; }
+
+    private:
+        uint32_t *mDigests;
+        uint8_t   mMaxEntries;
+        uint8_t   mNumEntries;
+        bool      mOverflow;
+    };
+
+    static void      CollectPrefix(const PrefixTlv &aPrefix, Collector &aCollector);
+    static void      CollectService(const ServiceTlv &aService, Collector &aCollector);
+    static uint32_t  Digest(const void *aData, uint16_t aLength, uint32_t aDigest);
+    static void      Sort(uint32_t *aDigests, uint8_t aNumEntries);
+    static EntryType GetEntryType(uint32_t aDigest) { return static_cast<EntryType>(aDigest & kTypeMask); }
+
+    static const uint32_t kFnvOffsetBasis = 2166136261u;
+    static const uint32_t kFnvPrime       = 16777619u;
+
+    uint32_t mDigests[kMaxEntries];
+    uint8_t  mNumEntries;
+    uint8_t  mVersion;
+    bool     mOverflow;
+    bool     mAllChanged;
+    uint8_t  mAdded[kNumEntryTypes];
+    uint8_t  mRemoved[kNumEntryTypes];
+#endif // OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE
+};
+
+/**
+ * @}
+ */
+
+} // namespace NetworkData
+} // namespace ot
+
+#endif // NETWORK_DATA_CHANGE_SET_HPP_
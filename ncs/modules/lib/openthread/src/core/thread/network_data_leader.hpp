@@ -47,6 +47,7 @@
 #include "net/ip6_address.hpp"
 #include "thread/mle_router.hpp"
 #include "thread/network_data.hpp"
+#include "thread/network_data_change_set.hpp"
 
 namespace ot {
 
@@ -289,6 +290,24 @@ public:
     otError GetBackboneRouterPrimary(BackboneRouter::BackboneRouterConfig &aConfig) const;
 #endif
 
+    /**
+     * This method records the current Thread Network Data in the change set and computes which entries changed since
+     * the previous call.
+     *
+     * The Notifier calls this method once before invoking the `OT_CHANGED_THREAD_NETDATA` callbacks, so all callbacks
+     * observe the same change set.
+     *
+     */
+    void UpdateChangeSet(void) { mChangeSet.Update(mTlvs, mLength, mVersion); }
+
+    /**
+     * This method returns the change set computed by the last call to `UpdateChangeSet()`.
+     *
+     * @returns A reference to the change set.
+     *
+     */
+    const ChangeSet &GetChangeSet(void) const { return mChangeSet; }
+
 protected:
     uint8_t mStableVersion;
     uint8_t mVersion;
@@ -303,6 +322,8 @@ private:
                                 uint8_t *           aPrefixMatch,
                                 uint16_t *          aRloc16) const;
     otError DefaultRouteLookup(const PrefixTlv &aPrefix, uint16_t *aRloc16) const;
+
+    ChangeSet mChangeSet;
 };
 
 /**
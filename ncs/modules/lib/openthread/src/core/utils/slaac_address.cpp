@@ -110,7 +110,8 @@ void Slaac::HandleStateChanged(otChangedFlags aFlags)
 
     VerifyOrExit(mEnabled, OT_NOOP);
 
-    if (aFlags & OT_CHANGED_THREAD_NETDATA)
+    if ((aFlags & OT_CHANGED_THREAD_NETDATA) &&
+        Get<NetworkData::Leader>().GetChangeSet().HasChanged(NetworkData::ChangeSet::kOnMeshPrefix))
     {
         mode |= kModeAdd | kModeRemove;
     }
@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+#
+#  Copyright (c) 2020, The OpenThread Authors.
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#  1. Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#  3. Neither the name of the copyright holder nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+#  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#  POSSIBILITY OF SUCH DAMAGE.
+#
+
+"""Run thread-cert tests in parallel.
+
+Each worker owns a distinct PORT_OFFSET, so the simulated nodes, the sniffer and
+the node settings files (tmp/<PORT_OFFSET>_*) of concurrently running tests
+never collide. Tests are handed out longest-first when a previous timing report
+is available, which keeps the tail of the run short.
+
+Usage:
+    run_cert_suite.py [-j JOBS] [--timeout SEC] [--report FILE] TEST...
+"""
+
+import argparse
+import json
+import os
+import queue
+import signal
+import subprocess
+import sys
+import threading
+import time
+
+COLOR_PASS = '\033[1;32m'
+COLOR_FAIL = '\033[1;31m'
+COLOR_NONE = '\033[0m'
+
+# Offset 0 is left to tests run directly from a shell.
+FIRST_PORT_OFFSET = 1
+
+
+class Result(object):
+    """Outcome and cost of a single test script."""
+
+    def __init__(self, script, port_offset):
+        self.script = script
+        self.port_offset = port_offset
+        self.passed = False
+        self.timed_out = False
+        self.returncode = None
+        self.wall_time = 0.0
+        self.cpu_time = 0.0
+        self.log = ''
+
+    @property
+    def name(self):
+        return os.path.splitext(os.path.basename(self.script))[0]
+
+    def to_dict(self):
+        return {
+            'script': self.script,
+            'passed': self.passed,
+            'timed_out': self.timed_out,
+            'returncode': self.returncode,
+            'port_offset': self.port_offset,
+            'wall_time': round(self.wall_time, 3),
+            'cpu_time': round(self.cpu_time, 3),
+        }
+
+
+def run_test(script, port_offset, timeout, log_dir):
+    """Runs one test script with its own PORT_OFFSET and TEST_NAME.
+
+    CPU time is taken from wait4(), so it covers the test process and every
+    simulated node process it reaped.
+    """
+    result = Result(script, port_offset)
+    result.log = os.path.join(log_dir, result.name + '.log')
+
+    env = dict(os.environ)
+    env['PORT_OFFSET'] = str(port_offset)
+    env['TEST_NAME'] = result.name
+    env['PYTHONUNBUFFERED'] = '1'
+
+    with open(result.log, 'wb') as log:
+        start = time.time()
+        proc = subprocess.Popen([script], stdout=log, stderr=subprocess.STDOUT, env=env, start_new_session=True)
+
+        timer = None
+        if timeout:
+
+            def on_timeout():
+                result.timed_out = True
+                try:
+                    os.killpg(proc.pid, signal.SIGKILL)
+                except ProcessLookupError:
+                    pass
+
+            timer = threading.Timer(timeout, on_timeout)
+            timer.start()
+
+        _, status, rusage = os.wait4(proc.pid, 0)
+        result.wall_time = time.time() - start
+
+        if timer:
+            timer.cancel()
+
+    # Reap anything the test left behind in its session.
+    try:
+        os.killpg(proc.pid, signal.SIGKILL)
+    except ProcessLookupError:
+        pass
+
+    proc.returncode = os.waitstatus_to_exitcode(status) if hasattr(os, 'waitstatus_to_exitcode') else (status >> 8)
+    result.returncode = proc.returncode
+    result.cpu_time = rusage.ru_utime + rusage.ru_stime
+    result.passed = (result.returncode == 0 and not result.timed_out)
+
+    return result
+
+
+def load_previous_times(report):
+    try:
+        with open(report) as f:
+            return {r['script']: r['wall_time'] for r in json.load(f)['results']}
+    except (OSError, ValueError, KeyError):
+        return {}
+
+
+def print_slowest(results, count):
+    slowest = sorted(results, key=lambda r: r.wall_time, reverse=True)[:count]
+
+    print('==================================')
+    print('   Slowest %d tests' % len(slowest))
+    print('==================================')
+    print('%10s %10s  %s' % ('wall(s)', 'cpu(s)', 'test'))
+    for r in slowest:
+        print('%10.2f %10.2f  %s' % (r.wall_time, r.cpu_time, r.script))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Run thread-cert tests in parallel.')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1, help='number of tests run at once')
+    parser.add_argument('--timeout', type=float, default=0, help='per-test timeout in seconds, 0 for none')
+    parser.add_argument('--log-dir', default='cert-logs', help='directory for per-test logs')
+    parser.add_argument('--report', default='cert-report.json', help='JSON file with per-test times and results')
+    parser.add_argument('--slowest', type=int, default=10, help='number of slowest tests to report')
+    parser.add_argument('--fail-log', default='fail.log', help='file collecting the logs of failed tests')
+    parser.add_argument('tests', nargs='+', help='test scripts to run')
+    args = parser.parse_args()
+
+    os.makedirs(args.log_dir, exist_ok=True)
+    os.makedirs('tmp', exist_ok=True)
+
+    # Longest tests first, based on the previous report, so the run does not end on a single slow test.
+    previous = load_previous_times(args.report)
+    tests = sorted(args.tests, key=lambda t: previous.get(t, float('inf')), reverse=True)
+
+    jobs = max(1, min(args.jobs, len(tests)))
+    pending = queue.Queue()
+    for test in tests:
+        pending.put(test)
+
+    results = []
+    lock = threading.Lock()
+
+    def worker(port_offset):
+        while True:
+            try:
+                script = pending.get_nowait()
+            except queue.Empty:
+                return
+
+            result = run_test(script, port_offset, args.timeout, args.log_dir)
+
+            with lock:
+                results.append(result)
+                status = (COLOR_PASS + 'PASS') if result.passed else (COLOR_FAIL + 'FAIL')
+                note = ' (timeout)' if result.timed_out else ''
+                print('%s%s %s%s [%.1fs wall, %.1fs cpu]' %
+                      (status, COLOR_NONE, script, note, result.wall_time, result.cpu_time))
+                sys.stdout.flush()
+
+    start = time.time()
+    threads = [threading.Thread(target=worker, args=(FIRST_PORT_OFFSET + i,)) for i in range(jobs)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    wall_time = time.time() - start
+
+    failed = [r for r in results if not r.passed]
+    cpu_time = sum(r.cpu_time for r in results)
+
+    with open(args.fail_log, 'w') as fail_log:
+        for r in sorted(failed, key=lambda r: r.script):
+            fail_log.write('==============================\n')
+            fail_log.write('!!! FAIL:%s\n' % r.script)
+            fail_log.write('==============================\n')
+            with open(r.log, errors='replace') as log:
+                fail_log.write(log.read())
+
+    with open(args.report, 'w') as report:
+        json.dump(
+            {
+                'jobs': jobs,
+                'wall_time': round(wall_time, 3),
+                'cpu_time': round(cpu_time, 3),
+                'results': [r.to_dict() for r in sorted(results, key=lambda r: r.script)],
+            },
+            report,
+            indent=2)
+
+    print_slowest(results, args.slowest)
+
+    print('==================================')
+    print('         Test Summary')
+    print('==================================')
+    print('# TOTAL: %d' % len(results))
+    print('# PASS: %d' % (len(results) - len(failed)))
+    print('# FAIL: %d' % len(failed))
+    print('# JOBS: %d' % jobs)
+    print('# WALL TIME: %.1fs' % wall_time)
+    print('# CPU TIME: %.1fs' % cpu_time)
+
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
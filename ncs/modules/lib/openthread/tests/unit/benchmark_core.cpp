@@ -0,0 +1,701 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements micro-benchmarks for the core data path.
+ *
+ *   Each benchmark is reported as a single JSON object per line on stdout so that results can be collected and
+ *   compared by scripts, e.g.
+ *
+ *     {"benchmark":"lowpan.compress","iterations":200000,"total_ns":41234567,"ns_per_op":206.17}
+ *
+ *   Usage: benchmark-core [-n <iterations>] [<name-filter>]
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "test_platform.h"
+#include "test_util.h"
+
+#include "common/code_utils.hpp"
+#include "common/instance.hpp"
+#include "common/message.hpp"
+#include "common/timer.hpp"
+#include "mac/mac_frame.hpp"
+#include "net/ip6_headers.hpp"
+#include "net/udp6.hpp"
+#include "thread/lowpan.hpp"
+#include "thread/network_data_change_set.hpp"
+
+using namespace ot;
+
+namespace {
+
+enum
+{
+    kDefaultIterations = 100000,
+    kNumTimers         = 32,
+    kSmallPayloadSize  = 32,   ///< Representative single-frame UDP payload (e.g. CoAP).
+    kLargePayloadSize  = 1232, ///< UDP payload that fills an IPv6 minimum MTU datagram.
+    kMaxFragments      = 16,
+};
+
+typedef void (*BenchmarkFunc)(uint32_t aIterations);
+
+struct Benchmark
+{
+    const char *  mName;
+    BenchmarkFunc mFunc;
+    uint32_t      mIterationsDivisor; ///< Scales the iteration count down for the slower benchmarks.
+};
+
+ot::Instance *   sInstance;
+const char *     sFilter     = NULL;
+uint32_t         sIterations = kDefaultIterations;
+Mac::ExtAddress  sExtSource;
+Mac::ExtAddress  sExtDest;
+Mac::Address     sMacSource;
+Mac::Address     sMacDest;
+volatile uint8_t sSink; // Prevents the compiler from discarding otherwise unused results.
+
+const uint8_t kAesKey[] = {0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+                           0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf};
+
+uint64_t GetNowNs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+}
+
+void Report(const char *aName, uint32_t aIterations, uint64_t aTotalNs)
+{
+    printf("{\"benchmark\":\"%s\",\"iterations\":%u,\"total_ns\":%llu,\"ns_per_op\":%.2f}\n", aName, aIterations,
+           static_cast<unsigned long long>(aTotalNs), static_cast<double>(aTotalNs) / aIterations);
+    fflush(stdout);
+}
+
+/**
+ * This function builds a link-local IPv6/UDP datagram between `sExtSource` and `sExtDest` with a payload of a given
+ * size, i.e. the best case for header compression.
+ *
+ */
+Message *NewUdpMessage(uint16_t aPayloadLength)
+{
+    Message *      message = sInstance->Get<MessagePool>().New(Message::kTypeIp6, 0);
+    Ip6::Header    ip6Header;
+    Ip6::UdpHeader udpHeader;
+    uint8_t        payload[kLargePayloadSize];
+
+    VerifyOrQuit(message != NULL, "Message::New() failed");
+    VerifyOrQuit(aPayloadLength <= sizeof(payload), "payload too long");
+
+    ip6Header.Init();
+    ip6Header.SetPayloadLength(sizeof(udpHeader) + aPayloadLength);
+    ip6Header.SetNextHeader(Ip6::kProtoUdp);
+    ip6Header.SetHopLimit(64);
+    ip6Header.GetSource().SetToLinkLocalAddress(sExtSource);
+    ip6Header.GetDestination().SetToLinkLocalAddress(sExtDest);
+
+    udpHeader.SetSourcePort(5683);
+    udpHeader.SetDestinationPort(5683);
+    udpHeader.SetLength(sizeof(udpHeader) + aPayloadLength);
+    udpHeader.SetChecksum(0x1234);
+
+    for (uint16_t i = 0; i < aPayloadLength; i++)
+    {
+        payload[i] = static_cast<uint8_t>(i);
+    }
+
+    SuccessOrQuit(message->Append(&ip6Header, sizeof(ip6Header)), "Message::Append() failed");
+    SuccessOrQuit(message->Append(&udpHeader, sizeof(udpHeader)), "Message::Append() failed");
+    SuccessOrQuit(message->Append(payload, aPayloadLength), "Message::Append() failed");
+
+    return message;
+}
+
+void InitDataFrame(Mac::TxFrame &aFrame, uint8_t *aPsdu, bool aSecure)
+{
+    uint16_t fcf = Mac::Frame::kFcfFrameData | Mac::Frame::kFcfPanidCompression | Mac::Frame::kFcfFrameVersion2006 |
+                   Mac::Frame::kFcfDstAddrExt | Mac::Frame::kFcfSrcAddrExt | Mac::Frame::kFcfAckRequest;
+    uint8_t secCtl = Mac::Frame::kSecNone;
+
+    if (aSecure)
+    {
+        fcf |= Mac::Frame::kFcfSecurityEnabled;
+        secCtl = Mac::Frame::kSecEncMic32 | Mac::Frame::kKeyIdMode1;
+    }
+
+    aFrame.mPsdu   = aPsdu;
+    aFrame.mLength = 0;
+
+    aFrame.InitMacHeader(fcf, secCtl);
+    aFrame.SetSequence(0x5a);
+    aFrame.SetDstPanId(0xface);
+    aFrame.SetDstAddr(sExtDest);
+    aFrame.SetSrcAddr(sExtSource);
+
+    if (aSecure)
+    {
+        aFrame.SetFrameCounter(1);
+        aFrame.SetKeyId(1);
+    }
+}
+
+void BenchmarkLowpanCompress(uint32_t aIterations)
+{
+    Message *message = NewUdpMessage(kSmallPayloadSize);
+    uint8_t  buf[Mac::Frame::kMtu];
+    uint64_t start;
+
+    start = GetNowNs();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        Lowpan::BufferWriter buffer(buf, sizeof(buf));
+
+        message->SetOffset(0);
+        SuccessOrQuit(sInstance->Get<Lowpan::Lowpan>().Compress(*message, sMacSource, sMacDest, buffer),
+                      "Lowpan::Compress() failed");
+    }
+
+    Report("lowpan.compress", aIterations, GetNowNs() - start);
+
+    sSink = buf[0];
+    message->Free();
+}
+
+void BenchmarkLowpanDecompress(uint32_t aIterations)
+{
+    Message *            message = NewUdpMessage(kSmallPayloadSize);
+    uint8_t              buf[Mac::Frame::kMtu];
+    Lowpan::BufferWriter buffer(buf, sizeof(buf));
+    uint16_t             length;
+    uint64_t             start;
+
+    SuccessOrQuit(sInstance->Get<Lowpan::Lowpan>().Compress(*message, sMacSource, sMacDest, buffer),
+                  "Lowpan::Compress() failed");
+    length = static_cast<uint16_t>(buffer.GetWritePointer() - buf);
+
+    start = GetNowNs();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        message->SetOffset(0);
+        SuccessOrQuit(message->SetLength(0), "Message::SetLength() failed");
+        VerifyOrQuit(sInstance->Get<Lowpan::Lowpan>().Decompress(*message, sMacSource, sMacDest, buf, length, 0) > 0,
+                     "Lowpan::Decompress() failed");
+    }
+
+    Report("lowpan.decompress", aIterations, GetNowNs() - start);
+
+    message->Free();
+}
+
+void BenchmarkMacFrameBuild(uint32_t aIterations)
+{
+    uint8_t      psdu[Mac::Frame::kMtu];
+    Mac::TxFrame frame;
+    uint64_t     start;
+
+    start = GetNowNs();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        InitDataFrame(frame, psdu, /* aSecure */ false);
+        frame.SetPayloadLength(kSmallPayloadSize);
+    }
+
+    Report("mac.frame_build", aIterations, GetNowNs() - start);
+
+    sSink = psdu[0];
+}
+
+void BenchmarkMacFrameParse(uint32_t aIterations)
+{
+    uint8_t      psdu[Mac::Frame::kMtu];
+    Mac::TxFrame frame;
+    Mac::Address src;
+    Mac::Address dst;
+    Mac::PanId   panId;
+    uint64_t     start;
+
+    InitDataFrame(frame, psdu, /* aSecure */ true);
+    frame.SetPayloadLength(kSmallPayloadSize);
+
+    start = GetNowNs();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        SuccessOrQuit(frame.ValidatePsdu(), "Frame::ValidatePsdu() failed");
+        SuccessOrQuit(frame.GetSrcAddr(src), "Frame::GetSrcAddr() failed");
+        SuccessOrQuit(frame.GetDstAddr(dst), "Frame::GetDstAddr() failed");
+        SuccessOrQuit(frame.GetDstPanId(panId), "Frame::GetDstPanId() failed");
+        sSink = frame.GetPayload()[0];
+    }
+
+    Report("mac.frame_parse", aIterations, GetNowNs() - start);
+}
+
+void BenchmarkMacAesCcm(uint32_t aIterations)
+{
+    uint8_t      psdu[Mac::Frame::kMtu];
+    Mac::TxFrame frame;
+    uint64_t     start;
+
+    InitDataFrame(frame, psdu, /* aSecure */ true);
+    frame.SetPayloadLength(frame.GetMaxPayloadLength());
+    memset(frame.GetPayload(), 0xa5, frame.GetPayloadLength());
+    frame.SetAesKey(kAesKey);
+
+    start = GetNowNs();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        frame.SetFrameCounter(i);
+        frame.ProcessTransmitAesCcm(sExtSource);
+    }
+
+    Report("mac.aes_ccm_max_frame", aIterations, GetNowNs() - start);
+
+    sSink = frame.GetFooter()[0];
+}
+
+void BenchmarkMessageAppendRead(uint32_t aIterations)
+{
+    uint8_t  buf[kLargePayloadSize];
+    uint64_t start;
+
+    memset(buf, 0x5a, sizeof(buf));
+
+    start = GetNowNs();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        Message *message = sInstance->Get<MessagePool>().New(Message::kTypeIp6, 0);
+
+        VerifyOrQuit(message != NULL, "Message::New() failed");
+        SuccessOrQuit(message->Append(buf, sizeof(buf)), "Message::Append() failed");
+        VerifyOrQuit(message->Read(0, sizeof(buf), buf) == sizeof(buf), "Message::Read() failed");
+        message->Free();
+    }
+
+    Report("message.append_read_1232", aIterations, GetNowNs() - start);
+}
+
+void BenchmarkMessageClone(uint32_t aIterations)
+{
+    Message *message = NewUdpMessage(kLargePayloadSize);
+    uint64_t start;
+
+    start = GetNowNs();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        Message *clone = message->Clone();
+
+        VerifyOrQuit(clone != NULL, "Message::Clone() failed");
+        clone->Free();
+    }
+
+    Report("message.clone_1280", aIterations, GetNowNs() - start);
+
+    message->Free();
+}
+
+class BenchmarkTimer : public TimerMilli
+{
+public:
+    BenchmarkTimer(Instance &aInstance)
+        : TimerMilli(aInstance, BenchmarkTimer::HandleTimerFired, NULL)
+    {
+    }
+
+    static void HandleTimerFired(Timer &) {}
+};
+
+void BenchmarkTimerStartStop(uint32_t aIterations)
+{
+    BenchmarkTimer *timers[kNumTimers];
+    uint64_t        start;
+
+    for (uint8_t i = 0; i < kNumTimers; i++)
+    {
+        timers[i] = new BenchmarkTimer(*sInstance);
+    }
+
+    start = GetNowNs();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        // Interleave durations so that insertions land throughout the sorted timer list.
+        for (uint8_t j = 0; j < kNumTimers; j++)
+        {
+            timers[j]->Start(1000 + ((j * 7u) % kNumTimers) * 100);
+        }
+
+        for (uint8_t j = 0; j < kNumTimers; j++)
+        {
+            timers[j]->Stop();
+        }
+    }
+
+    Report("timer.start_stop_x32", aIterations, GetNowNs() - start);
+
+    for (uint8_t i = 0; i < kNumTimers; i++)
+    {
+        delete timers[i];
+    }
+}
+
+struct FragmentedFrames
+{
+    uint8_t  mPsdu[kMaxFragments][Mac::Frame::kMtu];
+    uint16_t mLength[kMaxFragments];
+    uint8_t  mNumFrames;
+};
+
+/**
+ * This function splits an IPv6 message into 802.15.4 frames following the same steps as
+ * `MeshForwarder::PrepareDataFrame()` (compress, prepend FRAG1/FRAGN header, copy 8-octet aligned payload chunk).
+ *
+ */
+void FragmentMessage(Message &aMessage, FragmentedFrames &aFrames, uint16_t aTag)
+{
+    Mac::TxFrame frame;
+    uint16_t     nextOffset;
+
+    aFrames.mNumFrames = 0;
+    aMessage.SetOffset(0);
+
+    // First fragment: compressed IPv6 header, FRAG1 header and as much payload as fits.
+    {
+        uint8_t *              payload;
+        uint16_t               maxPayload;
+        uint16_t               hcLength;
+        uint16_t               payloadLength;
+        Lowpan::FragmentHeader fragmentHeader;
+
+        InitDataFrame(frame, aFrames.mPsdu[0], /* aSecure */ true);
+        payload    = frame.GetPayload();
+        maxPayload = frame.GetMaxPayloadLength();
+
+        {
+            Lowpan::BufferWriter buffer(payload + Lowpan::FragmentHeader::kFirstFragmentHeaderSize,
+                                        maxPayload - Lowpan::FragmentHeader::kFirstFragmentHeaderSize);
+
+            SuccessOrQuit(sInstance->Get<Lowpan::Lowpan>().Compress(aMessage, sMacSource, sMacDest, buffer),
+                          "Lowpan::Compress() failed");
+            hcLength = static_cast<uint16_t>(buffer.GetWritePointer() - payload) -
+                       Lowpan::FragmentHeader::kFirstFragmentHeaderSize;
+        }
+
+        fragmentHeader.InitFirstFragment(aMessage.GetLength(), aTag);
+        fragmentHeader.WriteTo(payload);
+
+        payloadLength = (maxPayload - Lowpan::FragmentHeader::kFirstFragmentHeaderSize - hcLength) & ~0x7;
+        aMessage.Read(aMessage.GetOffset(), payloadLength,
+                      payload + Lowpan::FragmentHeader::kFirstFragmentHeaderSize + hcLength);
+
+        frame.SetPayloadLength(Lowpan::FragmentHeader::kFirstFragmentHeaderSize + hcLength + payloadLength);
+        aFrames.mLength[0] = frame.GetLength();
+        aFrames.mNumFrames = 1;
+        nextOffset         = aMessage.GetOffset() + payloadLength;
+    }
+
+    // Subsequent fragments: FRAGN header and payload.
+    while (nextOffset < aMessage.GetLength())
+    {
+        uint8_t *              payload;
+        uint16_t               headerLength;
+        uint16_t               payloadLength;
+        Lowpan::FragmentHeader fragmentHeader;
+
+        VerifyOrQuit(aFrames.mNumFrames < kMaxFragments, "too many fragments");
+
+        InitDataFrame(frame, aFrames.mPsdu[aFrames.mNumFrames], /* aSecure */ true);
+        payload = frame.GetPayload();
+
+        fragmentHeader.Init(aMessage.GetLength(), aTag, nextOffset);
+        headerLength = fragmentHeader.WriteTo(payload);
+
+        payloadLength = (frame.GetMaxPayloadLength() - headerLength) & ~0x7;
+
+        if (payloadLength > aMessage.GetLength() - nextOffset)
+        {
+            payloadLength = aMessage.GetLength() - nextOffset;
+        }
+
+        aMessage.Read(nextOffset, payloadLength, payload + headerLength);
+
+        frame.SetPayloadLength(headerLength + payloadLength);
+        aFrames.mLength[aFrames.mNumFrames++] = frame.GetLength();
+        nextOffset += payloadLength;
+    }
+
+    aMessage.SetOffset(0);
+}
+
+/**
+ * This function reassembles frames produced by `FragmentMessage()` following the same steps as
+ * `MeshForwarder::HandleFragment()` and `MeshForwarder::FrameToMessage()`.
+ *
+ */
+Message *ReassembleMessage(const FragmentedFrames &aFrames)
+{
+    Message *message = NULL;
+
+    for (uint8_t i = 0; i < aFrames.mNumFrames; i++)
+    {
+        Mac::RxFrame           frame;
+        Lowpan::FragmentHeader fragmentHeader;
+        const uint8_t *        payload;
+        uint16_t               payloadLength;
+        uint16_t               headerLength;
+
+        frame.mPsdu   = const_cast<uint8_t *>(aFrames.mPsdu[i]);
+        frame.mLength = aFrames.mLength[i];
+        SuccessOrQuit(frame.ValidatePsdu(), "Frame::ValidatePsdu() failed");
+
+        payload       = frame.GetPayload();
+        payloadLength = frame.GetPayloadLength();
+
+        SuccessOrQuit(fragmentHeader.ParseFrom(payload, payloadLength, headerLength),
+                      "FragmentHeader::ParseFrom() failed");
+        payload += headerLength;
+        payloadLength -= headerLength;
+
+        if (fragmentHeader.GetDatagramOffset() == 0)
+        {
+            int hcLength;
+
+            message = sInstance->Get<MessagePool>().New(Message::kTypeIp6, 0);
+            VerifyOrQuit(message != NULL, "Message::New() failed");
+
+            hcLength = sInstance->Get<Lowpan::Lowpan>().Decompress(*message, sMacSource, sMacDest, payload,
+                                                                   payloadLength, fragmentHeader.GetDatagramSize());
+            VerifyOrQuit(hcLength > 0, "Lowpan::Decompress() failed");
+            payload += hcLength;
+            payloadLength -= static_cast<uint16_t>(hcLength);
+
+            SuccessOrQuit(message->SetLength(message->GetLength() + payloadLength), "Message::SetLength() failed");
+            message->Write(message->GetOffset(), payloadLength, payload);
+            message->MoveOffset(payloadLength);
+
+            VerifyOrQuit(fragmentHeader.GetDatagramSize() >= message->GetLength(), "invalid datagram size");
+            SuccessOrQuit(message->SetLength(fragmentHeader.GetDatagramSize()), "Message::SetLength() failed");
+            message->SetDatagramTag(fragmentHeader.GetDatagramTag());
+        }
+        else
+        {
+            VerifyOrQuit(message != NULL && message->GetOffset() == fragmentHeader.GetDatagramOffset() &&
+                             message->GetDatagramTag() == fragmentHeader.GetDatagramTag(),
+                         "unexpected fragment");
+
+            message->Write(message->GetOffset(), payloadLength, payload);
+            message->MoveOffset(payloadLength);
+        }
+    }
+
+    VerifyOrQuit(message != NULL && message->GetOffset() == message->GetLength(), "reassembly incomplete");
+
+    return message;
+}
+
+void BenchmarkFragment(uint32_t aIterations)
+{
+    Message *         message = NewUdpMessage(kLargePayloadSize);
+    FragmentedFrames *frames  = new FragmentedFrames;
+    uint64_t          start;
+
+    start = GetNowNs();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        FragmentMessage(*message, *frames, static_cast<uint16_t>(i) | 1);
+    }
+
+    Report("mesh.fragment_1280", aIterations, GetNowNs() - start);
+
+    delete frames;
+    message->Free();
+}
+
+void BenchmarkReassemble(uint32_t aIterations)
+{
+    Message *         message = NewUdpMessage(kLargePayloadSize);
+    FragmentedFrames *frames  = new FragmentedFrames;
+    uint64_t          start;
+
+    FragmentMessage(*message, *frames, 1);
+
+    {
+        // Sanity check the round trip once before timing it.
+        Message *reassembled = ReassembleMessage(*frames);
+        uint8_t  expected[Mac::Frame::kMtu];
+        uint8_t  actual[Mac::Frame::kMtu];
+
+        VerifyOrQuit(reassembled->GetLength() == message->GetLength(), "reassembled length mismatch");
+
+        for (uint16_t offset = 0; offset < message->GetLength(); offset += sizeof(expected))
+        {
+            uint16_t length = message->Read(offset, sizeof(expected), expected);
+
+            VerifyOrQuit(reassembled->Read(offset, length, actual) == length, "Message::Read() failed");
+            VerifyOrQuit(memcmp(expected, actual, length) == 0, "reassembled content mismatch");
+        }
+
+        reassembled->Free();
+    }
+
+    start = GetNowNs();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        ReassembleMessage(*frames)->Free();
+    }
+
+    Report("mesh.reassemble_1280", aIterations, GetNowNs() - start);
+
+    delete frames;
+    message->Free();
+}
+
+#if OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE
+void BenchmarkNetDataChangeSet(uint32_t aIterations)
+{
+    enum
+    {
+        kPrefixSize  = 17, // Prefix TLV with a /64 prefix and a Has Route TLV with one entry.
+        kMaxPrefixes = NetworkData::NetworkData::kMaxSize / kPrefixSize,
+    };
+
+    uint8_t networkData[NetworkData::NetworkData::kMaxSize];
+
+    for (uint8_t i = 0; i < kMaxPrefixes; i++)
+    {
+        const uint8_t prefix[kPrefixSize] = {0x02, 0x0F, 0x00, 0x40, 0xFD, 0x00, 0xAB, 0xBA, 0xCD,
+                                             0xDC, 0x00, i,    0x00, 0x03, 0x10, 0x00, 0x00};
+
+        memcpy(&networkData[i * kPrefixSize], prefix, kPrefixSize);
+    }
+
+    // One report per Network Data size, from a single prefix up to full Network Data.
+    for (uint8_t numPrefixes = 1; numPrefixes <= kMaxPrefixes; numPrefixes++)
+    {
+        uint8_t                length = numPrefixes * kPrefixSize;
+        NetworkData::ChangeSet changeSet;
+        char                   name[40];
+        uint64_t               start;
+
+        start = GetNowNs();
+
+        for (uint32_t i = 0; i < aIterations; i++)
+        {
+            // Alternate the Has Route preference of the last prefix so that each update has a non-empty delta.
+            networkData[length - 1] = (i & 1) ? 0x40 : 0x00;
+            changeSet.Update(networkData, length, static_cast<uint8_t>(i));
+        }
+
+        snprintf(name, sizeof(name), "netdata.change_set_%u", numPrefixes);
+        Report(name, aIterations, GetNowNs() - start);
+
+        networkData[length - 1] = 0x00;
+        sSink = changeSet.GetAddedCount(NetworkData::ChangeSet::kExternalRoute);
+    }
+}
+#endif
+
+const Benchmark kBenchmarks[] = {
+    {"lowpan.compress", BenchmarkLowpanCompress, 1},
+    {"lowpan.decompress", BenchmarkLowpanDecompress, 1},
+    {"mac.frame_build", BenchmarkMacFrameBuild, 1},
+    {"mac.frame_parse", BenchmarkMacFrameParse, 1},
+    {"mac.aes_ccm_max_frame", BenchmarkMacAesCcm, 10},
+    {"message.append_read_1232", BenchmarkMessageAppendRead, 10},
+    {"message.clone_1280", BenchmarkMessageClone, 10},
+    {"timer.start_stop_x32", BenchmarkTimerStartStop, 10},
+    {"mesh.fragment_1280", BenchmarkFragment, 10},
+    {"mesh.reassemble_1280", BenchmarkReassemble, 10},
+#if OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE
+    {"netdata.change_set", BenchmarkNetDataChangeSet, 10},
+#endif
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+        {
+            sIterations = static_cast<uint32_t>(strtoul(argv[++i], NULL, 0));
+        }
+        else if (argv[i][0] != '-')
+        {
+            sFilter = argv[i];
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [-n <iterations>] [<name-filter>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    sInstance = testInitInstance();
+    VerifyOrQuit(sInstance != NULL, "NULL instance");
+
+    sExtSource.GenerateRandom();
+    sExtDest.GenerateRandom();
+    sMacSource.SetExtended(sExtSource);
+    sMacDest.SetExtended(sExtDest);
+
+    for (unsigned i = 0; i < OT_ARRAY_LENGTH(kBenchmarks); i++)
+    {
+        uint32_t iterations = sIterations / kBenchmarks[i].mIterationsDivisor;
+
+        if (sFilter != NULL && strstr(kBenchmarks[i].mName, sFilter) == NULL)
+        {
+            continue;
+        }
+
+        kBenchmarks[i].mFunc(iterations > 0 ? iterations : 1);
+    }
+
+    testFreeInstance(sInstance);
+
+    return 0;
+}
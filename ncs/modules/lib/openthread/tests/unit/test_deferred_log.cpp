@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_platform.h"
+
+#include <stdarg.h>
+#include <string.h>
+
+#include <openthread/config.h>
+
+#include "test_util.h"
+#include "common/deferred_log.hpp"
+#include "common/encoding.hpp"
+
+namespace ot {
+
+using Encoding::LittleEndian::ReadUint16;
+using Encoding::LittleEndian::ReadUint32;
+
+static DeferredLog sLog;
+
+static void Log(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat, ...)
+{
+    va_list args;
+
+    va_start(args, aFormat);
+    sLog.Log(aLogLevel, aLogRegion, aFormat, args);
+    va_end(args);
+}
+
+void TestDeferredLogRecord(void)
+{
+    static const char kFormat[] = "rloc16:0x%04x, ext:%s, count:%lu, %c%%, rssi:%d";
+    uint8_t           buf[DeferredLog::kMaxRecordSize];
+    uint16_t          length;
+    const uint8_t *   payload = &buf[DeferredLog::kHeaderSize];
+
+    printf("\nTest 1: Log record encoding\n");
+
+    sLog.Reset();
+    Log(OT_LOG_LEVEL_INFO, OT_LOG_REGION_MLE, kFormat, 0xfc00, "abc", static_cast<unsigned long>(7), 'x', -20);
+
+    length = sLog.Read(buf, sizeof(buf));
+    VerifyOrQuit(length == DeferredLog::kHeaderSize + 4 + 4 + 8 + 4 + 4, "Read() returned wrong length");
+    VerifyOrQuit(sLog.Read(buf, sizeof(buf)) == 0, "Read() did not consume the record");
+
+    VerifyOrQuit((buf[0] & DeferredLog::kFlagsLevelMask) == OT_LOG_LEVEL_INFO, "level mismatch");
+    VerifyOrQuit((buf[0] >> DeferredLog::kFlagsTypeShift) == DeferredLog::kTypeLog, "type mismatch");
+    VerifyOrQuit((buf[0] & DeferredLog::kFlagTruncated) == 0, "unexpected truncation");
+    VerifyOrQuit(buf[1] == OT_LOG_REGION_MLE, "region mismatch");
+    VerifyOrQuit(ReadUint16(&buf[2]) == 24, "payload length mismatch");
+    VerifyOrQuit(ReadUint32(&buf[8]) == DeferredLog::GetFormatId(kFormat), "format id mismatch");
+
+    VerifyOrQuit(ReadUint32(&payload[0]) == 0xfc00, "%x argument mismatch");
+    VerifyOrQuit(memcmp(&payload[4], "abc", sizeof("abc")) == 0, "%s argument mismatch");
+    VerifyOrQuit(ReadUint32(&payload[8]) == 7 && ReadUint32(&payload[12]) == 0, "%lu argument mismatch");
+    VerifyOrQuit(ReadUint32(&payload[16]) == 'x', "%c argument mismatch");
+    VerifyOrQuit(static_cast<int32_t>(ReadUint32(&payload[20])) == -20, "%d argument mismatch");
+
+    printf(" -- PASS\n");
+}
+
+void TestDeferredLogDump(void)
+{
+    uint8_t  data[300];
+    uint8_t  buf[DeferredLog::kMaxRecordSize];
+    uint16_t length;
+
+    printf("\nTest 2: Dump record encoding and truncation\n");
+
+    for (uint16_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+
+    sLog.Reset();
+    sLog.Dump(OT_LOG_LEVEL_DEBG, OT_LOG_REGION_MAC, "RecvFrame", data, 16);
+    length = sLog.Read(buf, sizeof(buf));
+
+    VerifyOrQuit(length == DeferredLog::kHeaderSize + 2 + sizeof("RecvFrame") + 16, "dump length mismatch");
+    VerifyOrQuit((buf[0] >> DeferredLog::kFlagsTypeShift) == DeferredLog::kTypeDump, "type mismatch");
+    VerifyOrQuit(ReadUint16(&buf[DeferredLog::kHeaderSize]) == 16, "dump original length mismatch");
+    VerifyOrQuit(memcmp(&buf[DeferredLog::kHeaderSize + 2], "RecvFrame", sizeof("RecvFrame")) == 0, "dump id mismatch");
+    VerifyOrQuit(memcmp(&buf[length - 16], data, 16) == 0, "dump data mismatch");
+
+    sLog.Dump(OT_LOG_LEVEL_DEBG, OT_LOG_REGION_MAC, "RecvFrame", data, sizeof(data));
+    length = sLog.Read(buf, sizeof(buf));
+
+    VerifyOrQuit(length == DeferredLog::kMaxRecordSize, "truncated dump length mismatch");
+    VerifyOrQuit(buf[0] & DeferredLog::kFlagTruncated, "truncated flag not set");
+    VerifyOrQuit(ReadUint16(&buf[DeferredLog::kHeaderSize]) == sizeof(data), "dump original length mismatch");
+
+    printf(" -- PASS\n");
+}
+
+void TestDeferredLogWrapAndDrop(void)
+{
+    uint8_t  buf[DeferredLog::kBufferSize];
+    uint16_t recordLength = DeferredLog::kHeaderSize + sizeof(uint32_t);
+    uint32_t written      = 0;
+    uint32_t read         = 0;
+
+    printf("\nTest 3: Ring buffer wrap-around and drop counter\n");
+
+    sLog.Reset();
+
+    // Fill the buffer until a record is dropped, `written` counts the stored records.
+    while (true)
+    {
+        Log(OT_LOG_LEVEL_NOTE, OT_LOG_REGION_CORE, "value:%u", written);
+
+        if (sLog.GetDroppedCount() != 0)
+        {
+            break;
+        }
+
+        written++;
+    }
+
+    VerifyOrQuit(written * recordLength <= DeferredLog::kBufferSize, "buffer overfilled");
+    VerifyOrQuit((written + 1) * recordLength > DeferredLog::kBufferSize, "record dropped too early");
+
+    // Read a partial amount, then keep writing across the end of the buffer.
+    for (uint32_t round = 0; round < 4 * DeferredLog::kBufferSize / recordLength; round++)
+    {
+        uint16_t length = sLog.Read(buf, recordLength + 1);
+
+        VerifyOrQuit(length == recordLength, "Read() returned wrong length");
+        VerifyOrQuit(ReadUint32(&buf[DeferredLog::kHeaderSize]) == read, "records out of order");
+        read++;
+
+        Log(OT_LOG_LEVEL_NOTE, OT_LOG_REGION_CORE, "value:%u", written);
+        written++;
+    }
+
+    VerifyOrQuit(sLog.GetDroppedCount() == 1, "unexpected drop count");
+
+    printf(" -- PASS\n");
+}
+
+} // namespace ot
+
+int main(void)
+{
+    ot::TestDeferredLogRecord();
+    ot::TestDeferredLogDump();
+    ot::TestDeferredLogWrapAndDrop();
+    printf("\nAll tests passed.\n");
+    return 0;
+}
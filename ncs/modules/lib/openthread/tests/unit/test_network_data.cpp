@@ -30,6 +30,7 @@
 
 #include "common/code_utils.hpp"
 #include "common/instance.hpp"
+#include "thread/network_data_change_set.hpp"
 #include "thread/network_data_local.hpp"
 
 #include "test_platform.h"
@@ -172,12 +173,125 @@ void TestNetworkDataIterator(void)
     testFreeInstance(instance);
 }
 
+#if OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE
+
+static void VerifyChangeSet(const ChangeSet &aChangeSet, const uint8_t *aAdded, const uint8_t *aRemoved)
+{
+    for (uint8_t i = 0; i < ChangeSet::kNumEntryTypes; i++)
+    {
+        ChangeSet::EntryType type = static_cast<ChangeSet::EntryType>(i);
+
+        printf("\n  type:%d, added:%d, removed:%d", i, aChangeSet.GetAddedCount(type),
+               aChangeSet.GetRemovedCount(type));
+        VerifyOrQuit(aChangeSet.GetAddedCount(type) == aAdded[i], "ChangeSet added count does not match expectation");
+        VerifyOrQuit(aChangeSet.GetRemovedCount(type) == aRemoved[i],
+                     "ChangeSet removed count does not match expectation");
+        VerifyOrQuit(aChangeSet.HasChanged(type) == (aAdded[i] != 0 || aRemoved[i] != 0),
+                     "ChangeSet::HasChanged() does not match expectation");
+    }
+}
+
+void TestNetworkDataChangeSet(void)
+{
+    // Commissioning Data, a /64 prefix with a Context TLV, two Has Route TLVs and a Border Router TLV, a second /64
+    // prefix with a Has Route TLV, and a /32 prefix with a Has Route TLV of two entries.
+    const uint8_t kNetworkData[] = {
+        0x08, 0x04, 0x0B, 0x02, 0x00, 0x00, 0x03, 0x1E, 0x00, 0x40, 0xFD, 0x00, 0x12, 0x34, 0x56, 0x78, 0x00, 0x00,
+        0x07, 0x02, 0x11, 0x40, 0x00, 0x03, 0x10, 0x00, 0x40, 0x01, 0x03, 0x54, 0x00, 0x00, 0x05, 0x04, 0x54, 0x00,
+        0x31, 0x00, 0x02, 0x0F, 0x00, 0x40, 0xFD, 0x00, 0xAB, 0xBA, 0xCD, 0xDC, 0x00, 0x00, 0x00, 0x03, 0x10, 0x00,
+        0x00, 0x03, 0x0E, 0x00, 0x20, 0xFD, 0x00, 0xAB, 0xBA, 0x01, 0x06, 0x54, 0x00, 0x00, 0x04, 0x00, 0x00};
+
+    const uint8_t kNone[ChangeSet::kNumEntryTypes]     = {0, 0, 0, 0, 0};
+    const uint8_t kAll[ChangeSet::kNumEntryTypes]      = {1, 5, 1, 0, 1};
+    const uint8_t kOnMesh[ChangeSet::kNumEntryTypes]   = {1, 0, 0, 0, 0};
+    const uint8_t kCommData[ChangeSet::kNumEntryTypes] = {0, 0, 0, 0, 1};
+
+    ChangeSet changeSet;
+    uint8_t   networkData[sizeof(kNetworkData)];
+
+    printf("\nTest #3: Network data change set");
+    printf("\n-------------------------------------------------");
+
+    changeSet.Update(kNetworkData, sizeof(kNetworkData), 1);
+    VerifyChangeSet(changeSet, kAll, kNone);
+    VerifyOrQuit(changeSet.GetNumEntries() == 8, "ChangeSet::GetNumEntries() failed");
+
+    changeSet.Update(kNetworkData, sizeof(kNetworkData), 1);
+    VerifyChangeSet(changeSet, kNone, kNone);
+
+    // Change the flags of the Border Router entry (P_on_mesh cleared).
+    memcpy(networkData, kNetworkData, sizeof(networkData));
+    networkData[36] = 0x30;
+    changeSet.Update(networkData, sizeof(networkData), 2);
+    VerifyChangeSet(changeSet, kOnMesh, kOnMesh);
+
+    // Change the Commissioning Data back and forth.
+    networkData[36] = 0x31;
+    changeSet.Update(networkData, sizeof(networkData), 3);
+    networkData[3] = 0x03;
+    changeSet.Update(networkData, sizeof(networkData), 4);
+    VerifyChangeSet(changeSet, kCommData, kCommData);
+
+    // A new version with unchanged digests, as with a digest collision, reports every type as changed.
+    changeSet.Update(networkData, sizeof(networkData), 5);
+
+    for (uint8_t i = 0; i < ChangeSet::kNumEntryTypes; i++)
+    {
+        VerifyOrQuit(changeSet.HasChanged(static_cast<ChangeSet::EntryType>(i)),
+                     "ChangeSet::HasChanged() missed a new version");
+    }
+
+    changeSet.Update(NULL, 0, 6);
+    VerifyChangeSet(changeSet, kNone, kAll);
+    VerifyOrQuit(changeSet.GetNumEntries() == 0, "ChangeSet::GetNumEntries() failed");
+}
+
+void TestNetworkDataChangeSetFull(void)
+{
+    enum
+    {
+        kPrefixSize  = 17, // Prefix TLV with a /64 prefix and a Has Route TLV with one entry.
+        kMaxPrefixes = NetworkData::kMaxSize / kPrefixSize,
+    };
+
+    uint8_t   networkData[NetworkData::kMaxSize];
+    uint8_t   length = kMaxPrefixes * kPrefixSize;
+    ChangeSet changeSet;
+
+    printf("\nTest #4: Network data change set with full network data");
+    printf("\n-------------------------------------------------");
+
+    for (uint8_t i = 0; i < kMaxPrefixes; i++)
+    {
+        const uint8_t prefix[kPrefixSize] = {0x02, 0x0F, 0x00, 0x40, 0xFD, 0x00, 0xAB, 0xBA, 0xCD,
+                                             0xDC, 0x00, i,    0x00, 0x03, 0x10, 0x00, 0x00};
+
+        memcpy(&networkData[i * kPrefixSize], prefix, kPrefixSize);
+    }
+
+    changeSet.Update(networkData, length, 1);
+    VerifyOrQuit(changeSet.GetAddedCount(ChangeSet::kExternalRoute) == kMaxPrefixes, "ChangeSet::Update() failed");
+
+    // Change the Has Route preference of the last prefix.
+    networkData[length - 1] = 0x40;
+    changeSet.Update(networkData, length, 2);
+    VerifyOrQuit(changeSet.GetAddedCount(ChangeSet::kExternalRoute) == 1, "ChangeSet::Update() failed");
+    VerifyOrQuit(changeSet.GetRemovedCount(ChangeSet::kExternalRoute) == 1, "ChangeSet::Update() failed");
+    VerifyOrQuit(!changeSet.HasChanged(ChangeSet::kOnMeshPrefix), "ChangeSet::Update() failed");
+}
+
+#endif // OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE
+
 } // namespace NetworkData
 } // namespace ot
 
 int main(void)
 {
     ot::NetworkData::TestNetworkDataIterator();
+#if OPENTHREAD_CONFIG_NETDATA_CHANGE_SET_ENABLE
+    ot::NetworkData::TestNetworkDataChangeSet();
+    ot::NetworkData::TestNetworkDataChangeSetFull();
+#endif
 
     printf("\nAll tests passed\n");
     return 0;
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_platform.h"
+
+#include <openthread/config.h>
+
+#include "test_util.h"
+#include "common/code_utils.hpp"
+#include "thread/mle_router.hpp"
+
+namespace ot {
+
+#if OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+
+enum
+{
+    kQueueSize = OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE,
+};
+
+static void PrepareRouteTlv(Mle::RouteTlv &aRoute, uint8_t aSequence)
+{
+    aRoute.Init();
+    aRoute.SetRouterIdSequence(aSequence);
+    aRoute.SetRouteDataLength(0);
+}
+
+static void VerifyCounters(const Mle::RouteUpdateQueue &aQueue,
+                           uint16_t                     aQueued,
+                           uint16_t                     aCoalesced,
+                           uint16_t                     aTableUpdates)
+{
+    const otMleRouteUpdateCounters &counters = aQueue.GetCounters();
+
+    VerifyOrQuit(counters.mQueued == aQueued, "mQueued is incorrect");
+    VerifyOrQuit(counters.mCoalesced == aCoalesced, "mCoalesced is incorrect");
+    VerifyOrQuit(counters.mTableUpdates == aTableUpdates, "mTableUpdates is incorrect");
+}
+
+void TestRouteUpdateQueue(void)
+{
+    Mle::RouteUpdateQueue queue;
+    Mle::RouteTlv         route;
+
+    //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    printf("Test two Route TLVs from one router");
+
+    VerifyOrQuit(queue.GetLength() == 0, "queue is not empty after init");
+    VerifyCounters(queue, 0, 0, 0);
+
+    PrepareRouteTlv(route, 10);
+    SuccessOrQuit(queue.Add(route, 1), "Add() failed");
+    PrepareRouteTlv(route, 11);
+    SuccessOrQuit(queue.Add(route, 1), "Add() failed");
+
+    VerifyOrQuit(queue.GetLength() == 1, "two Route TLVs from one router were not coalesced");
+    VerifyOrQuit(queue.GetEntry(0).mRouterId == 1, "entry has an incorrect Router ID");
+    VerifyOrQuit(queue.GetEntry(0).mRoute.GetRouterIdSequence() == 11, "entry does not hold the newer Route TLV");
+    VerifyCounters(queue, 2, 1, 0);
+
+    queue.MarkApplied();
+    VerifyOrQuit(queue.GetLength() == 0, "queue is not empty after MarkApplied()");
+    VerifyCounters(queue, 2, 1, 1);
+
+    printf(" -- PASS\n");
+
+    //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    printf("Test full queue");
+
+    queue.ResetCounters();
+    VerifyCounters(queue, 0, 0, 0);
+
+    for (uint8_t routerId = 0; routerId < kQueueSize; routerId++)
+    {
+        PrepareRouteTlv(route, routerId);
+        SuccessOrQuit(queue.Add(route, routerId), "Add() failed");
+    }
+
+    VerifyOrQuit(queue.GetLength() == kQueueSize, "queue length is incorrect");
+
+    PrepareRouteTlv(route, 20);
+    VerifyOrQuit(queue.Add(route, kQueueSize) == OT_ERROR_NO_BUFS, "Add() did not fail when queue was full");
+    SuccessOrQuit(queue.Add(route, 0), "Add() failed to replace a queued Route TLV in a full queue");
+
+    VerifyOrQuit(queue.GetLength() == kQueueSize, "queue length is incorrect");
+    VerifyOrQuit(queue.GetEntry(0).mRoute.GetRouterIdSequence() == 20, "entry does not hold the newer Route TLV");
+    VerifyCounters(queue, kQueueSize + 1, 1, 0);
+
+    queue.Clear();
+    VerifyOrQuit(queue.GetLength() == 0, "queue is not empty after Clear()");
+    VerifyCounters(queue, kQueueSize + 1, 1, 0);
+
+    printf(" -- PASS\n");
+}
+
+#endif // OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+
+} // namespace ot
+
+int main(void)
+{
+#if OPENTHREAD_CONFIG_MLE_ROUTE_UPDATE_QUEUE_SIZE > 0
+    ot::TestRouteUpdateQueue();
+#endif
+    printf("\nAll tests passed.\n");
+    return 0;
+}
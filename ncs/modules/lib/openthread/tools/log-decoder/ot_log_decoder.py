@@ -0,0 +1,263 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020, The OpenThread Authors.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+# 3. Neither the name of the copyright holder nor the
+#    names of its contributors may be used to endorse or promote products
+#    derived from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+"""Decoder for OpenThread deferred (binary) log records.
+
+The firmware (built with OPENTHREAD_CONFIG_LOG_DEFERRED_ENABLE) records each
+log statement as a format string identifier plus its raw arguments, see
+src/core/common/deferred_log.hpp for the record layout. The identifier is the
+offset of the format string within the `ot_log_fmt` section of the firmware
+image, which this tool uses as string table.
+"""
+
+import argparse
+import os
+import re
+import struct
+import subprocess
+import sys
+import tempfile
+
+HEADER = struct.Struct('<BBHII')
+
+TYPE_LOG = 0
+TYPE_DUMP = 1
+
+FLAGS_LEVEL_MASK = 0x07
+FLAG_TRUNCATED = 0x08
+FLAGS_TYPE_SHIFT = 4
+
+LEVEL_NAMES = ['NONE', 'CRIT', 'WARN', 'NOTE', 'INFO', 'DEBG']
+
+CONVERSION_RE = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t|L)?([diouxXcsfFeEgGaAp%n])')
+
+WIDE_LENGTHS = ('l', 'll', 'j', 'z', 't')
+
+
+class StringTable(object):
+    """The `ot_log_fmt` section content indexed by offset."""
+
+    def __init__(self, blob):
+        self._blob = blob
+
+    @classmethod
+    def from_elf(cls, elf_path, objcopy='objcopy'):
+        with tempfile.NamedTemporaryFile(suffix='.bin', delete=False) as tmp:
+            tmp_path = tmp.name
+        try:
+            subprocess.check_call(
+                [objcopy, '-O', 'binary', '--only-section=ot_log_fmt', elf_path, tmp_path])
+            with open(tmp_path, 'rb') as f:
+                return cls(f.read())
+        finally:
+            os.unlink(tmp_path)
+
+    def get(self, offset):
+        if offset >= len(self._blob):
+            return None
+        end = self._blob.find(b'\0', offset)
+        if end < 0:
+            end = len(self._blob)
+        return self._blob[offset:end].decode('utf-8', 'replace')
+
+
+class Reader(object):
+    """Sequential reader over a record payload."""
+
+    def __init__(self, data, offset=0):
+        self._data = data
+        self._offset = offset
+
+    def _take(self, fmt):
+        size = struct.calcsize(fmt)
+        if self._offset + size > len(self._data):
+            raise EOFError
+        value = struct.unpack_from(fmt, self._data, self._offset)[0]
+        self._offset += size
+        return value
+
+    def int32(self, signed):
+        return self._take('<i' if signed else '<I')
+
+    def int64(self, signed):
+        return self._take('<q' if signed else '<Q')
+
+    def double(self):
+        return self._take('<d')
+
+    def string(self):
+        end = self._data.find(b'\0', self._offset)
+        if end < 0:
+            raise EOFError
+        value = self._data[self._offset:end].decode('utf-8', 'replace')
+        self._offset = end + 1
+        return value
+
+    def remaining(self):
+        return self._data[self._offset:]
+
+
+def format_log(fmt, payload):
+    """Renders `fmt` with the arguments encoded in `payload`."""
+    reader = Reader(payload)
+    out = []
+    pos = 0
+
+    for match in CONVERSION_RE.finditer(fmt):
+        out.append(fmt[pos:match.start()])
+        pos = match.end()
+        flags, width, precision, length, conv = match.groups()
+
+        if conv == '%':
+            out.append('%')
+            continue
+
+        try:
+            if width == '*':
+                width = str(reader.int32(True))
+            if precision == '*':
+                precision = str(reader.int32(True))
+
+            spec = '%' + flags + (width or '') + ('.' + precision if precision is not None else '')
+
+            if conv in 'diouxX':
+                signed = conv in 'di'
+                if length in WIDE_LENGTHS:
+                    value = reader.int64(signed)
+                else:
+                    value = reader.int32(signed)
+                    if length == 'h':
+                        value = struct.unpack('<h' if signed else '<H', struct.pack('<i', value)[:2])[0]
+                    elif length == 'hh':
+                        value = struct.unpack('<b' if signed else '<B', struct.pack('<i', value)[:1])[0]
+                out.append((spec + (conv if conv != 'u' else 'd')) % value)
+            elif conv == 'c':
+                out.append((spec + 'c') % chr(reader.int32(False) & 0xff))
+            elif conv in 'fFeEgGaA':
+                value = reader.double()
+                out.append(value.hex() if conv in 'aA' else (spec + conv) % value)
+            elif conv == 'p':
+                out.append('0x%x' % reader.int64(False))
+            elif conv == 's':
+                out.append((spec + 's') % reader.string())
+        except EOFError:
+            out.append('<truncated>')
+            return ''.join(out)
+
+    out.append(fmt[pos:])
+    return ''.join(out)
+
+
+def format_dump(payload):
+    """Renders a memory dump the same way as `otDump()`."""
+    length = struct.unpack_from('<H', payload)[0]
+    reader = Reader(payload, 2)
+    ident = reader.string()
+    data = reader.remaining()
+    width = 72
+    lines = []
+
+    lines.append('=' * ((width - len(ident)) // 2 - 5) + '[%s len=%03u]' % (ident, length) + '=' *
+                 ((width - len(ident)) // 2 - 4))
+
+    for offset in range(0, len(data), 16):
+        chunk = bytearray(data[offset:offset + 16])
+        line = '|'
+        for i in range(16):
+            line += ' %02X' % chunk[i] if i < len(chunk) else ' ..'
+            if (i + 1) % 8 == 0:
+                line += ' |'
+        line += ' '
+        for i in range(16):
+            c = chunk[i] & 0x7f if i < len(chunk) else 0
+            line += chr(c) if i < len(chunk) and 0x20 <= c < 0x7f else '.'
+        lines.append(line)
+
+    if len(data) < length:
+        lines.append('<truncated, %u of %u bytes recorded>' % (len(data), length))
+
+    lines.append('-' * width)
+    return lines
+
+
+def decode(stream, strings):
+    """Yields decoded log lines from a stream of records."""
+    while True:
+        header = stream.read(HEADER.size)
+        if len(header) < HEADER.size:
+            return
+
+        flags, region, length, timestamp, format_id = HEADER.unpack(header)
+        payload = stream.read(length)
+        level = flags & FLAGS_LEVEL_MASK
+        record_type = flags >> FLAGS_TYPE_SHIFT
+        prefix = '[%010u] ' % timestamp
+
+        if record_type == TYPE_DUMP:
+            for line in format_dump(payload):
+                yield prefix + line
+            continue
+
+        fmt = strings.get(format_id)
+        if fmt is None:
+            yield prefix + '<unknown format id 0x%08x, level %s, region %u>' % (
+                format_id, LEVEL_NAMES[level] if level < len(LEVEL_NAMES) else level, region)
+            continue
+
+        line = format_log(fmt, payload).rstrip('\r\n')
+        if flags & FLAG_TRUNCATED:
+            line += ' <truncated>'
+        yield prefix + line
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode OpenThread deferred (binary) log records.')
+    table = parser.add_mutually_exclusive_group(required=True)
+    table.add_argument('--elf', help='firmware ELF image the records were produced by')
+    table.add_argument('--string-table', help='raw `ot_log_fmt` section (objcopy -O binary --only-section=ot_log_fmt)')
+    parser.add_argument('--objcopy', default='objcopy', help='objcopy executable matching the target toolchain')
+    parser.add_argument('input', nargs='?', help='file with the records read by otLoggingDeferredRead() (default stdin)')
+    args = parser.parse_args()
+
+    if args.elf:
+        strings = StringTable.from_elf(args.elf, args.objcopy)
+    else:
+        with open(args.string_table, 'rb') as f:
+            strings = StringTable(f.read())
+
+    stream = open(args.input, 'rb') if args.input else getattr(sys.stdin, 'buffer', sys.stdin)
+
+    try:
+        for line in decode(stream, strings):
+            print(line)
+    finally:
+        if args.input:
+            stream.close()
+
+
+if __name__ == '__main__':
+    main()